@@ -0,0 +1,100 @@
+/**
+ * @file JobSystem.h
+ * @brief 任务系统定义
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+
+namespace PLE {
+
+/**
+ * @brief 任务系统类
+ *
+ * 维护一组常驻工作线程，提供异步任务提交和并行循环。
+ * ParallelFor的调用线程会参与执行批次，因此在工作线程内嵌套调用也不会死锁。
+ * 未初始化时所有任务都在调用线程上串行执行。
+ */
+class PLE_API JobSystem {
+public:
+    /**
+     * @brief 获取任务系统实例
+     * @return 任务系统实例
+     */
+    static JobSystem& GetInstance();
+
+    /**
+     * @brief 初始化任务系统
+     * @param workerCount 工作线程数量，0表示使用硬件线程数减一
+     * @return 是否成功初始化
+     */
+    bool Initialize(uint32_t workerCount = 0);
+
+    /**
+     * @brief 关闭任务系统，等待已提交的任务执行完毕
+     */
+    void Shutdown();
+
+    /**
+     * @brief 任务系统是否已初始化
+     * @return 是否已初始化
+     */
+    bool IsInitialized() const { return m_Initialized; }
+
+    /**
+     * @brief 获取工作线程数量
+     * @return 工作线程数量
+     */
+    uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+
+    /**
+     * @brief 获取参与并行执行的线程数量（工作线程加调用线程）
+     * @return 并行度
+     */
+    uint32_t GetConcurrency() const { return GetWorkerCount() + 1; }
+
+    /**
+     * @brief 提交异步任务
+     * @param job 任务函数
+     * @return 任务完成的future
+     */
+    std::future<void> Submit(std::function<void()> job);
+
+    /**
+     * @brief 并行循环
+     * @param count 元素数量
+     * @param batchSize 每个批次的元素数量
+     * @param func 批次处理函数，参数为[begin, end)区间
+     */
+    void ParallelFor(uint32_t count, uint32_t batchSize, const std::function<void(uint32_t begin, uint32_t end)>& func);
+
+private:
+    JobSystem() = default;
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void WorkerLoop();
+    void Enqueue(std::function<void()> job);
+
+    bool m_Initialized = false;
+    bool m_Stopping = false;
+    std::vector<std::thread> m_Workers;
+    std::deque<std::function<void()>> m_Queue;
+    std::mutex m_QueueMutex;
+    std::condition_variable m_QueueCondition;
+};
+
+} // namespace PLE
@@ -0,0 +1,175 @@
+/**
+ * @file Crowd.h
+ * @brief 人群模拟（ORCA局部避让）定义
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Vector.h"
+#include "../Scene/SpatialHashGrid.h"
+
+namespace PLE {
+
+/**
+ * @brief 人群代理ID
+ */
+using CrowdAgentId = uint32_t;
+
+/**
+ * @brief 无效的人群代理ID
+ */
+constexpr CrowdAgentId CROWD_INVALID_AGENT = 0xFFFFFFFF;
+
+/**
+ * @brief 人群代理参数
+ */
+struct CrowdAgentParams {
+    float radius = 0.5f;          // 碰撞半径
+    float maxSpeed = 3.5f;        // 最大速度
+    float neighborDist = 5.0f;    // 邻居搜索距离
+    uint32_t maxNeighbors = 10;   // 参与避让的最大邻居数
+    float timeHorizon = 2.0f;     // 避让的预测时间（秒）
+};
+
+/**
+ * @brief 人群配置
+ */
+struct CrowdConfig {
+    uint32_t batchSize = 64;      // 并行求解时每批处理的代理数量
+    float arrivalDistance = 0.1f; // 距目标小于该距离时视为到达
+};
+
+/**
+ * @brief 人群模拟
+ *
+ * 每帧先重建XZ平面的空间哈希网格，再以批次并行地为每个代理
+ * 收集最近邻居、构造ORCA半平面并用增量线性规划求解无碰撞速度，
+ * 最后统一积分位置。求解阶段只读上一帧状态、写入独立的新速度数组，
+ * 因此结果与批次划分和线程数无关。避让在XZ平面上进行，Y坐标保持不变。
+ */
+class PLE_API Crowd {
+public:
+    /**
+     * @brief 构造函数
+     * @param config 人群配置
+     */
+    Crowd(const CrowdConfig& config = CrowdConfig());
+
+    /**
+     * @brief 添加代理
+     * @param position 初始位置
+     * @param params 代理参数
+     * @return 代理ID
+     */
+    CrowdAgentId AddAgent(const Vector3& position, const CrowdAgentParams& params = CrowdAgentParams());
+
+    /**
+     * @brief 移除代理
+     * @param id 代理ID
+     */
+    void RemoveAgent(CrowdAgentId id);
+
+    /**
+     * @brief 设置代理的移动目标，代理以最大速度朝目标移动
+     * @param id 代理ID
+     * @param target 目标位置
+     */
+    void SetAgentTarget(CrowdAgentId id, const Vector3& target);
+
+    /**
+     * @brief 直接设置代理的期望速度（例如来自流场或路径跟随），会清除移动目标
+     * @param id 代理ID
+     * @param velocity XZ平面上的期望速度
+     */
+    void SetAgentPreferredVelocity(CrowdAgentId id, const Vector2& velocity);
+
+    /**
+     * @brief 停止代理（清除目标和期望速度）
+     * @param id 代理ID
+     */
+    void StopAgent(CrowdAgentId id);
+
+    /**
+     * @brief 修改代理参数
+     * @param id 代理ID
+     * @param params 代理参数
+     */
+    void SetAgentParams(CrowdAgentId id, const CrowdAgentParams& params);
+
+    /**
+     * @brief 强制设置代理位置
+     * @param id 代理ID
+     * @param position 位置
+     */
+    void SetAgentPosition(CrowdAgentId id, const Vector3& position);
+
+    /**
+     * @brief 获取代理位置
+     */
+    Vector3 GetAgentPosition(CrowdAgentId id) const;
+
+    /**
+     * @brief 获取代理当前速度
+     */
+    Vector3 GetAgentVelocity(CrowdAgentId id) const;
+
+    /**
+     * @brief 检查代理是否存在
+     */
+    bool IsValidAgent(CrowdAgentId id) const;
+
+    /**
+     * @brief 获取代理数量
+     */
+    uint32_t GetAgentCount() const { return static_cast<uint32_t>(m_Positions.size()); }
+
+    /**
+     * @brief 推进模拟
+     * @param deltaTime 帧时间间隔（秒）
+     */
+    void Update(float deltaTime);
+
+private:
+    enum class SteeringMode : uint8_t {
+        None,
+        Target,
+        Velocity
+    };
+
+    struct OrcaLine {
+        Vector2 point;
+        Vector2 direction;
+    };
+
+    void BuildSpatialHash();
+    void ComputePreferredVelocity(uint32_t index, float deltaTime);
+    void FindNeighbors(uint32_t index, std::vector<std::pair<float, uint32_t>>& neighbors) const;
+    void ComputeNewVelocity(uint32_t index, float deltaTime, std::vector<std::pair<float, uint32_t>>& neighbors, std::vector<OrcaLine>& lines);
+
+    static bool LinearProgram1(const std::vector<OrcaLine>& lines, size_t lineNo, float radius, const Vector2& optVelocity, bool directionOpt, Vector2& result);
+    static size_t LinearProgram2(const std::vector<OrcaLine>& lines, float radius, const Vector2& optVelocity, bool directionOpt, Vector2& result);
+    static void LinearProgram3(const std::vector<OrcaLine>& lines, size_t beginLine, float radius, Vector2& result);
+
+    CrowdConfig m_Config;
+
+    // 代理数据（紧凑存储，移除时与末尾交换）
+    std::vector<Vector3> m_Positions;
+    std::vector<Vector2> m_Velocities;
+    std::vector<Vector2> m_NewVelocities;
+    std::vector<Vector2> m_PreferredVelocities;
+    std::vector<Vector3> m_Targets;
+    std::vector<SteeringMode> m_Steering;
+    std::vector<CrowdAgentParams> m_Params;
+    std::vector<CrowdAgentId> m_IndexToId;
+    std::vector<uint32_t> m_IdToIndex;
+    std::vector<CrowdAgentId> m_FreeIds;
+
+    // 邻居查询网格
+    SpatialHashGrid m_Grid;
+};
+
+} // namespace PLE
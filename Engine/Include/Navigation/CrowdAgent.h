@@ -0,0 +1,82 @@
+/**
+ * @file CrowdAgent.h
+ * @brief 人群代理组件定义
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "../PhantomLightEngine.h"
+#include "../Scene/Scene.h"
+#include "Crowd.h"
+
+namespace PLE {
+
+/**
+ * @brief 人群代理组件
+ *
+ * 将实体绑定到人群模拟中的一个代理：初始化时以实体的世界位置加入人群，
+ * 每帧把模拟得到的位置写回变换组件，销毁时从人群中移除。
+ * 人群本身的Update由游戏逻辑在更新实体之前统一调用一次。
+ */
+class PLE_API CrowdAgent : public Component {
+public:
+    /**
+     * @brief 构造函数
+     * @param entity 所属实体
+     * @param crowd 所属人群
+     * @param params 代理参数
+     */
+    CrowdAgent(std::shared_ptr<Entity> entity, std::shared_ptr<Crowd> crowd, const CrowdAgentParams& params = CrowdAgentParams());
+
+    /**
+     * @brief 初始化组件，将代理加入人群
+     */
+    void Initialize() override;
+
+    /**
+     * @brief 更新组件，同步代理位置到变换组件
+     * @param deltaTime 帧时间间隔（秒）
+     */
+    void Update(float deltaTime) override;
+
+    /**
+     * @brief 销毁组件，将代理从人群中移除
+     */
+    void Destroy() override;
+
+    /**
+     * @brief 设置移动目标
+     * @param target 目标位置
+     */
+    void SetTarget(const Vector3& target);
+
+    /**
+     * @brief 设置期望速度
+     * @param velocity XZ平面上的期望速度
+     */
+    void SetPreferredVelocity(const Vector2& velocity);
+
+    /**
+     * @brief 停止移动
+     */
+    void Stop();
+
+    /**
+     * @brief 获取当前速度
+     */
+    Vector3 GetVelocity() const;
+
+    /**
+     * @brief 获取代理ID
+     */
+    CrowdAgentId GetAgentId() const { return m_AgentId; }
+
+private:
+    std::shared_ptr<Crowd> m_Crowd;
+    CrowdAgentParams m_Params;
+    CrowdAgentId m_AgentId = CROWD_INVALID_AGENT;
+};
+
+} // namespace PLE
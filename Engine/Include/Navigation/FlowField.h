@@ -0,0 +1,146 @@
+/**
+ * @file FlowField.h
+ * @brief 流场导航定义
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Vector.h"
+
+namespace PLE {
+
+// 前向声明
+class NavMesh;
+
+/**
+ * @brief 流场
+ *
+ * 对共享同一目标的大量单位，只需为目标计算一次积分场（到目标的代价）
+ * 和方向场，之后每个单位以O(1)的代价采样移动方向。
+ * 积分场使用逐行波前扫描求解：行间传播以SIMD一次处理4个格子，
+ * 行内传播为标量扫描，重复直至收敛（结果等价于8邻域Dijkstra）。
+ * 代价变化后调用Update()，只重置受影响的下游格子再重新收敛。
+ */
+class PLE_API FlowField {
+public:
+    /**
+     * @brief 不可通行格子的代价
+     */
+    static constexpr uint8_t BLOCKED_COST = 255;
+
+    /**
+     * @brief 构造函数
+     * @param width X方向格子数
+     * @param height Z方向格子数
+     * @param cellSize 格子尺寸
+     * @param origin 网格原点（最小角）的世界坐标
+     */
+    FlowField(int width, int height, float cellSize, const Vector3& origin);
+
+    /**
+     * @brief 获取X方向格子数
+     */
+    int GetWidth() const { return m_Width; }
+
+    /**
+     * @brief 获取Z方向格子数
+     */
+    int GetHeight() const { return m_Height; }
+
+    /**
+     * @brief 获取格子尺寸
+     */
+    float GetCellSize() const { return m_CellSize; }
+
+    /**
+     * @brief 设置格子代价（1-254，255表示不可通行）
+     *
+     * 若流场已计算，变化会被记录并在下次Update()中增量处理。
+     */
+    void SetCost(int x, int z, uint8_t cost);
+
+    /**
+     * @brief 获取格子代价
+     */
+    uint8_t GetCost(int x, int z) const { return m_Costs[static_cast<size_t>(z) * m_Width + x]; }
+
+    /**
+     * @brief 用导航网格的可行走区域填充代价场
+     *
+     * 被多边形覆盖的格子代价为1，其余不可通行。多层区域会投影到同一平面。
+     * @param navMesh 导航网格
+     */
+    void FillCostsFromNavMesh(const NavMesh& navMesh);
+
+    /**
+     * @brief 设置单个目标点
+     * @param goal 目标世界坐标
+     */
+    void SetGoal(const Vector3& goal);
+
+    /**
+     * @brief 设置多个目标点，单位会流向最近的目标
+     * @param goals 目标世界坐标列表
+     */
+    void SetGoals(const std::vector<Vector3>& goals);
+
+    /**
+     * @brief 完整计算积分场和方向场
+     */
+    void Compute();
+
+    /**
+     * @brief 根据SetCost记录的变化增量更新流场；尚未计算或目标变化时执行完整计算
+     */
+    void Update();
+
+    /**
+     * @brief 采样移动方向
+     * @param position 世界坐标
+     * @return XZ平面上的单位方向（x, z），位于目标、不可达或越界时返回零向量
+     */
+    Vector2 Sample(const Vector3& position) const;
+
+    /**
+     * @brief 获取格子到目标的积分代价，不可达时返回无穷大
+     */
+    float GetIntegration(int x, int z) const;
+
+    /**
+     * @brief 世界坐标转换为格子坐标
+     * @return 是否位于网格内
+     */
+    bool WorldToCell(const Vector3& position, int& x, int& z) const;
+
+private:
+    size_t PaddedIndex(int x, int z) const { return static_cast<size_t>(z + 1) * m_Stride + static_cast<size_t>(x + 1); }
+
+    void ResetIntegration();
+    void Propagate();
+    bool SweepRows(bool forward);
+    bool SweepColumns(int z);
+    void InvalidateDownstream();
+    void BuildDirections();
+
+    int m_Width;
+    int m_Height;
+    float m_CellSize;
+    Vector3 m_Origin;
+    size_t m_Stride;
+
+    std::vector<uint8_t> m_Costs;            // 用户代价场
+    std::vector<float> m_StepCosts;          // 带一圈不可通行边界的浮点代价，不可通行为无穷大
+    std::vector<float> m_Integration;        // 带边界的积分场
+    std::vector<uint8_t> m_Directions;       // 方向索引，0-7为8邻域，0xFF表示无方向
+    std::vector<int> m_GoalCells;            // 目标格子（未填充坐标的线性索引）
+    std::vector<int> m_ChangedCells;         // 代价上升的格子
+    bool m_Computed = false;
+    bool m_GoalsDirty = true;
+    bool m_CostsDecreased = false;
+};
+
+} // namespace PLE
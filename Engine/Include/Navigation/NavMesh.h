@@ -0,0 +1,200 @@
+/**
+ * @file NavMesh.h
+ * @brief 导航网格定义
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Vector.h"
+
+namespace PLE {
+
+/**
+ * @brief 导航网格构建配置
+ *
+ * 体素尺寸以世界单位表示，智能体参数在构建时换算为体素数量。
+ */
+struct NavMeshConfig {
+    Vector3 boundsMin = Vector3(-256.0f, -64.0f, -256.0f);  // 导航网格世界包围盒最小点
+    Vector3 boundsMax = Vector3(256.0f, 64.0f, 256.0f);     // 导航网格世界包围盒最大点
+    float cellSize = 0.3f;               // XZ平面体素尺寸
+    float cellHeight = 0.2f;             // Y方向体素尺寸
+    float walkableSlopeAngle = 45.0f;    // 可行走最大坡度（角度）
+    float walkableHeight = 2.0f;         // 智能体高度
+    float walkableClimb = 0.9f;          // 可跨越的最大台阶高度
+    float walkableRadius = 0.6f;         // 智能体半径，用于腐蚀可行走区域
+    int tileSize = 48;                   // 每个tile的体素列数（单边）
+    float maxContourError = 1.3f;        // 轮廓简化的最大误差
+};
+
+/**
+ * @brief 多边形引用，高32位为tile索引，低32位为多边形索引
+ */
+using NavPolyRef = uint64_t;
+
+/**
+ * @brief 无效多边形引用
+ */
+constexpr NavPolyRef NAV_INVALID_POLY_REF = ~0ull;
+
+/**
+ * @brief 组合多边形引用
+ * @param tileIndex tile索引
+ * @param polyIndex 多边形索引
+ * @return 多边形引用
+ */
+inline NavPolyRef MakeNavPolyRef(uint32_t tileIndex, uint32_t polyIndex) {
+    return (static_cast<NavPolyRef>(tileIndex) << 32) | polyIndex;
+}
+
+/**
+ * @brief 从多边形引用中取出tile索引
+ */
+inline uint32_t GetNavPolyTile(NavPolyRef ref) { return static_cast<uint32_t>(ref >> 32); }
+
+/**
+ * @brief 从多边形引用中取出多边形索引
+ */
+inline uint32_t GetNavPolyIndex(NavPolyRef ref) { return static_cast<uint32_t>(ref & 0xffffffffull); }
+
+/**
+ * @brief 多边形之间的连接
+ *
+ * portalLeft/portalRight为共享边上的重叠线段，沿离开当前多边形的方向看去分居左右。
+ */
+struct NavPolyLink {
+    NavPolyRef neighbor = NAV_INVALID_POLY_REF;
+    uint8_t edge = 0;        // 所在边：0(-X) 1(+Z) 2(+X) 3(-Z)
+    Vector3 portalLeft;
+    Vector3 portalRight;
+};
+
+/**
+ * @brief 导航多边形
+ *
+ * 多边形为体素网格上轴对齐的凸四边形，使用全局体素坐标描述范围（max不包含）。
+ * 顶点顺序：(minX,minZ) (minX,maxZ) (maxX,maxZ) (maxX,minZ)，边i连接顶点i和i+1。
+ */
+struct NavPoly {
+    int32_t minX = 0;
+    int32_t minZ = 0;
+    int32_t maxX = 0;
+    int32_t maxZ = 0;
+    uint32_t region = 0;
+    std::array<Vector3, 4> vertices;
+    Vector3 center;
+    std::vector<NavPolyLink> links;
+};
+
+/**
+ * @brief 区域轮廓（简化后的世界坐标折线，首尾相连）
+ */
+struct NavContour {
+    uint32_t region = 0;
+    std::vector<Vector3> vertices;
+};
+
+/**
+ * @brief 导航网格tile
+ */
+struct NavMeshTile {
+    int x = 0;
+    int z = 0;
+    uint32_t revision = 0;   // 每次重建递增，供路径缓存等判断数据是否过期
+    Vector3 boundsMin;
+    Vector3 boundsMax;
+    std::vector<NavPoly> polys;
+    std::vector<NavContour> contours;
+};
+
+/**
+ * @brief 导航网格类
+ *
+ * 由NavMeshBuilder生成和增量更新。查询接口不加锁，
+ * 调用方需要保证查询与NavMeshBuilder::Rebuild不并发执行。
+ */
+class PLE_API NavMesh {
+public:
+    /**
+     * @brief 构造函数
+     * @param config 构建配置
+     */
+    NavMesh(const NavMeshConfig& config);
+
+    /**
+     * @brief 获取构建配置
+     * @return 构建配置
+     */
+    const NavMeshConfig& GetConfig() const { return m_Config; }
+
+    /**
+     * @brief 获取X方向tile数量
+     */
+    int GetTileCountX() const { return m_TileCountX; }
+
+    /**
+     * @brief 获取Z方向tile数量
+     */
+    int GetTileCountZ() const { return m_TileCountZ; }
+
+    /**
+     * @brief 获取tile总数
+     */
+    uint32_t GetTileCount() const { return static_cast<uint32_t>(m_Tiles.size()); }
+
+    /**
+     * @brief 根据tile坐标计算tile索引
+     * @return tile索引，越界时返回UINT32_MAX
+     */
+    uint32_t GetTileIndex(int x, int z) const;
+
+    /**
+     * @brief 获取tile
+     * @param index tile索引
+     * @return tile引用
+     */
+    const NavMeshTile& GetTile(uint32_t index) const { return m_Tiles[index]; }
+
+    /**
+     * @brief 计算世界坐标所在的tile坐标
+     * @return 是否位于导航网格范围内
+     */
+    bool WorldToTile(const Vector3& position, int& tileX, int& tileZ) const;
+
+    /**
+     * @brief 获取多边形
+     * @param ref 多边形引用
+     * @return 多边形指针，引用无效时返回nullptr
+     */
+    const NavPoly* GetPoly(NavPolyRef ref) const;
+
+    /**
+     * @brief 查找最近的多边形
+     * @param position 查询位置
+     * @param extents 查询半尺寸
+     * @param nearestPoint 输出多边形上的最近点，可为nullptr
+     * @return 多边形引用，未找到时返回NAV_INVALID_POLY_REF
+     */
+    NavPolyRef FindNearestPoly(const Vector3& position, const Vector3& extents, Vector3* nearestPoint = nullptr) const;
+
+    /**
+     * @brief 计算多边形上离给定点最近的点
+     */
+    static Vector3 ClosestPointOnPoly(const NavPoly& poly, const Vector3& position);
+
+private:
+    friend class NavMeshBuilder;
+
+    NavMeshConfig m_Config;
+    int m_TileCountX = 0;
+    int m_TileCountZ = 0;
+    std::vector<NavMeshTile> m_Tiles;
+};
+
+} // namespace PLE
@@ -0,0 +1,127 @@
+/**
+ * @file NavMeshBuilder.h
+ * @brief 导航网格构建器定义
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Vector.h"
+#include "NavMesh.h"
+
+namespace PLE {
+
+/**
+ * @brief 导航几何体句柄
+ */
+using NavGeometryHandle = uint32_t;
+
+/**
+ * @brief 无效导航几何体句柄
+ */
+constexpr NavGeometryHandle NAV_INVALID_GEOMETRY = ~0u;
+
+/**
+ * @brief 导航网格构建器
+ *
+ * 将静态场景几何体按tile体素化，每个tile独立完成
+ * 体素化 -> 可行走过滤 -> 紧凑高度场 -> 腐蚀 -> 区域 -> 轮廓 -> 多边形，
+ * 不同tile在任务系统中并行构建。几何体变化时只重建其包围盒覆盖的tile。
+ */
+class PLE_API NavMeshBuilder {
+public:
+    /**
+     * @brief 构造函数
+     * @param config 构建配置
+     */
+    NavMeshBuilder(const NavMeshConfig& config);
+
+    /**
+     * @brief 获取构建配置
+     * @return 构建配置
+     */
+    const NavMeshConfig& GetConfig() const { return m_Config; }
+
+    /**
+     * @brief 添加静态几何体
+     * @param vertices 世界空间顶点
+     * @param indices 三角形索引
+     * @return 几何体句柄
+     */
+    NavGeometryHandle AddGeometry(const std::vector<Vector3>& vertices, const std::vector<uint32_t>& indices);
+
+    /**
+     * @brief 更新几何体，新旧包围盒覆盖的tile都会被标记为需要重建
+     * @param handle 几何体句柄
+     * @param vertices 世界空间顶点
+     * @param indices 三角形索引
+     * @return 是否成功更新
+     */
+    bool UpdateGeometry(NavGeometryHandle handle, const std::vector<Vector3>& vertices, const std::vector<uint32_t>& indices);
+
+    /**
+     * @brief 移除几何体
+     * @param handle 几何体句柄
+     * @return 是否成功移除
+     */
+    bool RemoveGeometry(NavGeometryHandle handle);
+
+    /**
+     * @brief 将与包围盒相交的tile标记为需要重建
+     * @param boundsMin 包围盒最小点
+     * @param boundsMax 包围盒最大点
+     */
+    void MarkDirty(const Vector3& boundsMin, const Vector3& boundsMax);
+
+    /**
+     * @brief 是否存在需要重建的tile
+     */
+    bool HasDirtyTiles() const { return !m_DirtyTiles.empty(); }
+
+    /**
+     * @brief 完整构建导航网格
+     * @return 导航网格
+     */
+    std::shared_ptr<NavMesh> Build();
+
+    /**
+     * @brief 只重建被标记的tile
+     * @return 本次重建的tile索引
+     */
+    std::vector<uint32_t> Rebuild();
+
+    /**
+     * @brief 获取当前导航网格
+     * @return 导航网格，尚未构建时返回nullptr
+     */
+    std::shared_ptr<NavMesh> GetNavMesh() const { return m_NavMesh; }
+
+private:
+    struct Geometry {
+        std::vector<Vector3> vertices;
+        std::vector<uint32_t> indices;
+        Vector3 boundsMin;
+        Vector3 boundsMax;
+        bool alive = false;
+    };
+
+    void BuildTiles(const std::vector<uint32_t>& tileIndices);
+    void BuildTile(int tileX, int tileZ, NavMeshTile& tile) const;
+    void ConnectTiles(const std::vector<uint32_t>& tileIndices);
+    static void ComputeBounds(Geometry& geometry);
+
+    NavMeshConfig m_Config;
+    int m_TileCountX = 0;
+    int m_TileCountZ = 0;
+    std::vector<Geometry> m_Geometries;
+    std::vector<NavGeometryHandle> m_FreeHandles;
+    std::vector<uint32_t> m_DirtyTiles;
+    std::vector<uint8_t> m_DirtyFlags;
+    std::shared_ptr<NavMesh> m_NavMesh;
+};
+
+} // namespace PLE
@@ -0,0 +1,239 @@
+/**
+ * @file PathfindingService.h
+ * @brief 批量寻路服务定义
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Vector.h"
+#include "NavMesh.h"
+
+namespace PLE {
+
+// 前向声明
+class NavMeshBuilder;
+
+/**
+ * @brief 路径请求ID
+ */
+using PathRequestId = uint64_t;
+
+/**
+ * @brief 寻路结果状态
+ */
+enum class PathStatus {
+    Success = 0,
+    InvalidStart,
+    InvalidGoal,
+    NoPath,
+    Cancelled
+};
+
+/**
+ * @brief 寻路结果
+ */
+struct PathResult {
+    PathStatus status = PathStatus::NoPath;
+    std::vector<Vector3> waypoints;      // 拉直后的路径点，包含起点和终点
+    std::vector<NavPolyRef> corridor;    // 经过的多边形序列
+    bool fromCache = false;
+};
+
+/**
+ * @brief 寻路完成回调，在PathfindingService::Update的调用线程上执行
+ */
+using PathCallback = std::function<void(PathRequestId, const PathResult&)>;
+
+/**
+ * @brief 寻路服务配置
+ */
+struct PathfindingConfig {
+    uint32_t workerCount = 0;                          // 工作线程数，0表示硬件线程数减一
+    uint32_t batchSize = 32;                           // 工作线程每次取出的请求数量
+    size_t cacheCapacity = 8192;                       // 路径缓存容量（条目数）
+    Vector3 queryExtents = Vector3(2.0f, 4.0f, 2.0f);  // 起终点吸附到导航网格的查询半尺寸
+};
+
+/**
+ * @brief 寻路服务统计
+ */
+struct PathfindingStats {
+    uint64_t requests = 0;
+    uint64_t solved = 0;
+    uint64_t cacheHits = 0;
+    uint64_t failed = 0;
+};
+
+/**
+ * @brief 批量寻路服务
+ *
+ * 请求进入队列后由工作线程批量求解。搜索使用分层A*：
+ * 导航网格的每个tile作为一个簇，跨tile相连的多边形作为入口节点，
+ * 簇内入口之间的代价预先计算；查询时先在抽象图上搜索，再在簇内细化为多边形走廊，
+ * 最后用漏斗算法拉直。起终点多边形相同的查询命中LRU缓存时跳过搜索。
+ */
+class PLE_API PathfindingService {
+public:
+    /**
+     * @brief 构造函数
+     * @param navMesh 导航网格
+     * @param config 服务配置
+     */
+    PathfindingService(std::shared_ptr<NavMesh> navMesh, const PathfindingConfig& config = PathfindingConfig());
+
+    /**
+     * @brief 析构函数
+     */
+    ~PathfindingService();
+
+    /**
+     * @brief 初始化服务，构建抽象图并启动工作线程
+     * @return 是否成功初始化
+     */
+    bool Initialize();
+
+    /**
+     * @brief 关闭服务，未完成的请求以Cancelled状态结束
+     */
+    void Shutdown();
+
+    /**
+     * @brief 提交寻路请求
+     * @param start 起点
+     * @param goal 终点
+     * @param callback 完成回调，可为空
+     * @return 请求ID
+     */
+    PathRequestId RequestPath(const Vector3& start, const Vector3& goal, PathCallback callback = nullptr);
+
+    /**
+     * @brief 提交寻路请求并返回future
+     * @param start 起点
+     * @param goal 终点
+     * @return 寻路结果的future
+     */
+    std::future<PathResult> RequestPathAsync(const Vector3& start, const Vector3& goal);
+
+    /**
+     * @brief 在调用线程上同步寻路
+     * @param start 起点
+     * @param goal 终点
+     * @return 寻路结果
+     */
+    PathResult FindPath(const Vector3& start, const Vector3& goal);
+
+    /**
+     * @brief 派发已完成请求的回调，通常每帧在主线程调用一次
+     * @return 本次派发的回调数量
+     */
+    uint32_t Update();
+
+    /**
+     * @brief 通过构建器增量重建导航网格，并刷新受影响簇的抽象图
+     *
+     * 重建期间会阻塞工作线程的搜索，完成后清空路径缓存。
+     * @param builder 导航网格构建器，其导航网格必须与本服务使用的是同一个
+     */
+    void RebuildNavMesh(NavMeshBuilder& builder);
+
+    /**
+     * @brief 获取排队中的请求数量
+     */
+    size_t GetPendingCount() const;
+
+    /**
+     * @brief 获取统计信息
+     */
+    PathfindingStats GetStats() const;
+
+private:
+    struct Request {
+        PathRequestId id = 0;
+        Vector3 start;
+        Vector3 goal;
+        PathCallback callback;
+        std::shared_ptr<std::promise<PathResult>> promise;
+    };
+
+    struct Completed {
+        PathRequestId id;
+        PathCallback callback;
+        PathResult result;
+    };
+
+    /**
+     * @brief 簇（tile）的抽象图数据
+     */
+    struct Cluster {
+        std::vector<uint32_t> entrances;        // 入口多边形索引
+        std::vector<int32_t> entranceOfPoly;    // 多边形索引 -> 入口序号，-1表示非入口
+        std::vector<float> costs;               // 入口之间的代价矩阵（行优先）
+    };
+
+    struct CacheEntry {
+        NavPolyRef startRef;
+        NavPolyRef goalRef;
+        std::vector<NavPolyRef> corridor;
+    };
+
+    struct CacheShard {
+        std::mutex mutex;
+        std::list<std::pair<uint64_t, CacheEntry>> lru;
+        std::unordered_map<uint64_t, std::list<std::pair<uint64_t, CacheEntry>>::iterator> entries;
+    };
+
+    struct SearchContext;
+
+    void WorkerLoop();
+    PathResult Solve(const Vector3& start, const Vector3& goal, SearchContext& context);
+    bool FindCorridor(NavPolyRef startRef, NavPolyRef goalRef, SearchContext& context, std::vector<NavPolyRef>& corridor) const;
+    bool ClusterSearch(uint32_t tileIndex, uint32_t startPoly, uint32_t goalPoly, SearchContext& context) const;
+    void AppendClusterPath(uint32_t tileIndex, uint32_t goalPoly, const SearchContext& context, std::vector<NavPolyRef>& corridor) const;
+    void BuildCluster(uint32_t tileIndex, SearchContext& context);
+    void StringPull(const Vector3& start, const Vector3& goal, const std::vector<NavPolyRef>& corridor, std::vector<Vector3>& waypoints) const;
+
+    bool LookupCache(NavPolyRef startRef, NavPolyRef goalRef, std::vector<NavPolyRef>& corridor);
+    void StoreCache(NavPolyRef startRef, NavPolyRef goalRef, const std::vector<NavPolyRef>& corridor);
+
+    std::shared_ptr<NavMesh> m_NavMesh;
+    PathfindingConfig m_Config;
+    bool m_Initialized = false;
+
+    mutable std::shared_mutex m_GraphMutex;
+    std::vector<Cluster> m_Clusters;
+
+    mutable std::mutex m_QueueMutex;
+    std::condition_variable m_QueueCondition;
+    std::deque<Request> m_Queue;
+    bool m_Stopping = false;
+    std::vector<std::thread> m_Workers;
+
+    std::mutex m_CompletedMutex;
+    std::vector<Completed> m_Completed;
+
+    static constexpr uint32_t CACHE_SHARD_COUNT = 16;
+    CacheShard m_CacheShards[CACHE_SHARD_COUNT];
+
+    std::atomic<PathRequestId> m_NextRequestId{1};
+    std::atomic<uint64_t> m_RequestCount{0};
+    std::atomic<uint64_t> m_SolvedCount{0};
+    std::atomic<uint64_t> m_CacheHitCount{0};
+    std::atomic<uint64_t> m_FailedCount{0};
+};
+
+} // namespace PLE
@@ -32,6 +32,11 @@
     #error "不支持的编译器"
 #endif
 
+// SIMD指令集检测
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define PLE_SIMD_SSE2
+#endif
+
 // API导出宏
 #ifdef PLE_PLATFORM_WINDOWS
     #ifdef PLE_BUILD_DLL
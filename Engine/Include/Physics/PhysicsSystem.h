@@ -26,7 +26,7 @@ struct PhysicsConfig {
     float fixedTimeStep = 1.0f / 60.0f;
     int maxSubSteps = 10;
     bool enableCCD = true;
-    bool enableDebugDraw = false;
+    bool enableDebugDraw = false;   // 向DebugDraw提交碰撞体等调试图形（仅调试构建）
 };
 
 /**
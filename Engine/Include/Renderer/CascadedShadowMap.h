@@ -0,0 +1,173 @@
+/**
+ * @file CascadedShadowMap.h
+ * @brief 方向光级联阴影贴图定义
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Vector.h"
+#include "../Math/Matrix4.h"
+
+namespace PLE {
+
+// 前向声明
+class RenderSystem;
+class RenderTarget;
+class Mesh;
+class Material;
+class Camera;
+class Light;
+
+/**
+ * @brief 阴影投射体
+ */
+struct ShadowCaster {
+    uint64_t id = 0;                        // 稳定的标识（例如实体ID），用于判断级联缓存是否失效
+    Vector3 boundsMin;                      // 世界空间包围盒
+    Vector3 boundsMax;
+    std::shared_ptr<Mesh> mesh;
+    std::shared_ptr<Material> material;     // 为nullptr时使用Render传入的默认材质
+    Matrix4 transform;
+};
+
+/**
+ * @brief 级联阴影配置
+ */
+struct CascadedShadowConfig {
+    uint32_t cascadeCount = 4;          // 级联数量，最多MaxCascades个
+    int resolution = 1024;              // 每个级联阴影贴图的边长
+    float shadowDistance = 150.0f;      // 阴影覆盖的最远距离（与相机远裁剪面取较小值）
+    float splitLambda = 0.75f;          // 分割方案：0为均匀分割，1为对数分割
+    bool cacheCascades = true;          // 级联矩阵和投射体都没有变化时复用上次的阴影贴图
+};
+
+/**
+ * @brief 单个级联
+ */
+struct ShadowCascade {
+    Matrix4 view;                       // 光源视图矩阵（只有旋转，所有级联共用）
+    Matrix4 projection;                 // 正交投影矩阵
+    Matrix4 viewProjection;
+    float splitNear = 0.0f;             // 覆盖的相机视图深度范围
+    float splitFar = 0.0f;
+    float texelSize = 0.0f;             // 一个阴影贴图纹素对应的世界尺寸，用于计算深度偏移
+    std::vector<uint32_t> casters;      // 与该级联相交的投射体索引
+    bool needsRender = true;            // 本帧是否需要重新渲染
+};
+
+/**
+ * @brief 级联阴影统计（每次Update重置）
+ */
+struct CascadedShadowStats {
+    uint32_t casters = 0;               // 输入的投射体数量
+    uint32_t casterDraws = 0;           // 所有需要渲染的级联中投射体绘制次数之和
+    uint32_t renderedCascades = 0;      // 需要重新渲染的级联数量
+    uint32_t cachedCascades = 0;        // 复用缓存的级联数量
+};
+
+/**
+ * @brief 方向光级联阴影贴图
+ *
+ * 把相机视锥体按对数和均匀分割的混合方案切成若干段，每段用包围球拟合正交投影：
+ * 包围球半径只取决于视场角和分割距离，相机旋转时投影大小不变；
+ * 球心在光源空间中对齐到纹素网格，相机平移时阴影边缘不会闪烁。
+ *
+ * 投射体按包围盒逐级联剔除：光源空间的XY范围与级联正方形相交，
+ * 并且不完全位于接收范围之后即保留；近平面向光源方向推到最远的投射体为止，
+ * 级联之外的物体也能投下阴影。近远平面对齐到半径的1/8，避免深度范围随相机连续抖动。
+ *
+ * 级联的投影矩阵和投射体集合（ID与变换）的哈希与上次渲染时相同时跳过该级联，
+ * 远处的级联通常只在物体移动或相机移动超过一个纹素时才重新渲染。
+ *
+ * 阴影贴图使用RenderSystem的渲染目标：投射体材质需要把深度编码到RGBA8颜色中，
+ * 接收方在着色器中解码后比较。阴影贴图在多帧之间保留，可以通过
+ * RenderGraph::ImportRenderTarget导入渲染图供后续Pass采样。
+ */
+class PLE_API CascadedShadowMap {
+public:
+    static constexpr uint32_t MaxCascades = 8;
+
+    explicit CascadedShadowMap(const CascadedShadowConfig& config = CascadedShadowConfig());
+    ~CascadedShadowMap();
+
+    /**
+     * @brief 计算级联并剔除投射体
+     * @param cameraView 相机视图矩阵（行向量约定）
+     * @param fovY 相机垂直视场角（弧度）
+     * @param aspectRatio 相机宽高比
+     * @param nearZ 相机近裁剪面
+     * @param farZ 相机远裁剪面
+     * @param lightDirection 光线照射方向（世界空间）
+     * @param casters 投射体
+     * @param count 投射体数量
+     */
+    void Update(const Matrix4& cameraView, float fovY, float aspectRatio, float nearZ, float farZ,
+                const Vector3& lightDirection, const ShadowCaster* casters, uint32_t count);
+
+    /**
+     * @brief 使用相机和光源组件计算级联并剔除投射体
+     */
+    void Update(const Camera& camera, const Light& light, const std::vector<ShadowCaster>& casters);
+
+    /**
+     * @brief 渲染需要更新的级联
+     *
+     * 渲染结束后当前渲染目标重置为默认帧缓冲。
+     * @param renderSystem 渲染系统
+     * @param casterMaterial 投射体没有指定材质时使用的材质
+     * @return 是否成功（阴影贴图创建失败时返回false）
+     */
+    bool Render(RenderSystem& renderSystem, std::shared_ptr<Material> casterMaterial);
+
+    /**
+     * @brief 使所有级联的缓存失效，下一次Render全部重新渲染
+     */
+    void Invalidate();
+
+    /**
+     * @brief 获取级联数量
+     */
+    uint32_t GetCascadeCount() const { return static_cast<uint32_t>(m_Cascades.size()); }
+
+    /**
+     * @brief 获取级联
+     */
+    const ShadowCascade& GetCascade(uint32_t index) const { return m_Cascades[index]; }
+
+    /**
+     * @brief 获取级联的阴影贴图，尚未渲染时返回nullptr
+     */
+    std::shared_ptr<RenderTarget> GetShadowTarget(uint32_t index) const;
+
+    /**
+     * @brief 获取统计
+     */
+    const CascadedShadowStats& GetStats() const { return m_Stats; }
+
+private:
+    /**
+     * @brief 投射体在光源空间中的包围盒
+     */
+    struct CasterBounds {
+        float min[3];
+        float max[3];
+    };
+
+    uint64_t ComputeCascadeHash(const ShadowCascade& cascade) const;
+
+    CascadedShadowConfig m_Config;
+    std::vector<ShadowCascade> m_Cascades;
+    std::vector<uint64_t> m_CascadeHashes;      // 本帧的级联哈希
+    std::vector<uint64_t> m_RenderedHashes;     // 阴影贴图当前内容对应的级联哈希
+    std::vector<std::shared_ptr<RenderTarget>> m_Targets;
+    std::vector<ShadowCaster> m_Casters;
+    std::vector<CasterBounds> m_CasterBounds;
+    CascadedShadowStats m_Stats;
+};
+
+} // namespace PLE
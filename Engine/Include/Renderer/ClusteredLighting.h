@@ -0,0 +1,224 @@
+/**
+ * @file ClusteredLighting.h
+ * @brief 分簇前向渲染的CPU光源剔除定义
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Matrix4.h"
+
+namespace PLE {
+
+// 前向声明
+class Camera;
+class Light;
+
+/**
+ * @brief 上传到GPU的光源数据（std430布局，64字节）
+ *
+ * 位置和方向为世界空间。聚光灯的角度衰减为
+ * saturate(dot(-L, direction) * spotScale + spotOffset)，点光源的spotScale为0、spotOffset为1。
+ */
+struct ClusterLightData {
+    float position[3];
+    float range;
+    float color[3];
+    float intensity;
+    float direction[3];
+    uint32_t type;          // LightType
+    float spotScale;
+    float spotOffset;
+    float padding[2];
+};
+
+static_assert(sizeof(ClusterLightData) == 64, "ClusterLightData必须与着色器中的std430结构一致");
+
+/**
+ * @brief 簇对应的光源索引范围
+ */
+struct LightClusterRange {
+    uint32_t offset;        // 在光源索引列表中的起始位置
+    uint32_t count;         // 光源数量
+};
+
+/**
+ * @brief 分簇配置
+ */
+struct ClusteredLightingConfig {
+    uint32_t clustersX = 16;        // 屏幕水平方向的簇数量
+    uint32_t clustersY = 9;         // 屏幕垂直方向的簇数量
+    uint32_t clustersZ = 24;        // 深度方向的切片数量（按指数分布）
+};
+
+/**
+ * @brief 分簇统计（每次Build重置）
+ */
+struct ClusteredLightingStats {
+    uint32_t lights = 0;                // 输入的光源数量
+    uint32_t directionalLights = 0;     // 不参与分簇、对所有像素生效的方向光数量
+    uint32_t visibleLights = 0;         // 至少分配到一个簇的光源数量
+    uint32_t lightIndices = 0;          // 光源索引列表的总长度
+    uint32_t maxLightsPerCluster = 0;   // 单个簇的最大光源数量
+};
+
+/**
+ * @brief 分簇前向渲染的光源分配
+ *
+ * 把相机视锥体划分为X×Y×Z个簇（屏幕上均匀分块，深度上从近平面到远平面按指数切片），
+ * 在视图空间中为每个簇计算包围盒，再用点光源和聚光灯的包围球与之求交。
+ * 深度切片分给任务系统并行处理，每个切片内SSE2一次测试4个簇；
+ * 聚光灯使用锥体的最小包围球，窄锥比以range为半径的球紧得多。
+ *
+ * 输出是紧凑的列表，可以直接上传为着色器存储缓冲：
+ * GetClusters()按 (z * Y + y) * X + x 排列，每个簇给出在GetLightIndices()中的范围，
+ * 索引指向GetLights()。方向光不分簇，其索引单独由GetDirectionalLightIndices()给出。
+ *
+ * 着色器中定位簇：
+ * @code
+ * uint x = uint(uv.x * clustersX);    // uv为[0, 1]的屏幕坐标，y = 0对应NDC的-1
+ * uint y = uint(uv.y * clustersY);
+ * uint z = uint(max(log(viewDepth) * sliceScale + sliceBias, 0.0));
+ * @endcode
+ * 其中viewDepth为视图空间中到相机的正向深度，sliceScale、sliceBias取自GetSliceScale/GetSliceBias。
+ */
+class PLE_API ClusteredLightCuller {
+public:
+    explicit ClusteredLightCuller(const ClusteredLightingConfig& config = ClusteredLightingConfig());
+    ~ClusteredLightCuller();
+
+    /**
+     * @brief 把光源分配到簇
+     * @param view 视图矩阵（行向量约定）
+     * @param projection 投影矩阵，支持透视和正交
+     * @param nearZ 近裁剪面
+     * @param farZ 远裁剪面
+     * @param lights 光源数据
+     * @param count 光源数量
+     */
+    void Build(const Matrix4& view, const Matrix4& projection, float nearZ, float farZ,
+               const ClusterLightData* lights, uint32_t count);
+
+    /**
+     * @brief 从场景组件收集光源并分配到簇，跳过未启用的光源
+     * @param camera 相机
+     * @param lights 光源组件
+     */
+    void Build(const Camera& camera, const std::vector<std::shared_ptr<Light>>& lights);
+
+    /**
+     * @brief 把光源组件转换为GPU光源数据
+     */
+    static ClusterLightData PackLight(const Light& light);
+
+    /**
+     * @brief 获取配置
+     */
+    const ClusteredLightingConfig& GetConfig() const { return m_Config; }
+
+    /**
+     * @brief 获取簇的总数量
+     */
+    uint32_t GetClusterCount() const { return m_Config.clustersX * m_Config.clustersY * m_Config.clustersZ; }
+
+    /**
+     * @brief 获取簇的线性索引
+     */
+    uint32_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t z) const {
+        return (z * m_Config.clustersY + y) * m_Config.clustersX + x;
+    }
+
+    /**
+     * @brief 获取视图空间深度所在的切片，超出远平面时返回clustersZ
+     */
+    uint32_t GetSliceForDepth(float viewDepth) const;
+
+    /**
+     * @brief 切片公式 slice = log(depth) * scale + bias 中的scale
+     */
+    float GetSliceScale() const { return m_SliceScale; }
+
+    /**
+     * @brief 切片公式 slice = log(depth) * scale + bias 中的bias
+     */
+    float GetSliceBias() const { return m_SliceBias; }
+
+    /**
+     * @brief 获取所有簇的光源范围
+     */
+    const std::vector<LightClusterRange>& GetClusters() const { return m_Clusters; }
+
+    /**
+     * @brief 获取紧凑的光源索引列表
+     */
+    const std::vector<uint32_t>& GetLightIndices() const { return m_LightIndices; }
+
+    /**
+     * @brief 获取方向光的索引
+     */
+    const std::vector<uint32_t>& GetDirectionalLightIndices() const { return m_DirectionalIndices; }
+
+    /**
+     * @brief 获取本次分配使用的光源数据（与输入顺序一致）
+     */
+    const std::vector<ClusterLightData>& GetLights() const { return m_Lights; }
+
+    /**
+     * @brief 获取统计
+     */
+    const ClusteredLightingStats& GetStats() const { return m_Stats; }
+
+private:
+    /**
+     * @brief 视图空间中的光源包围球
+     */
+    struct LightSphere {
+        float center[3];
+        float radius;
+        uint32_t index;
+        uint32_t firstSlice;
+        uint32_t lastSlice;
+    };
+
+    /**
+     * @brief 一个深度切片的簇包围盒（SoA，按4对齐）与分配结果
+     */
+    struct Slice {
+        std::vector<float> minX;
+        std::vector<float> maxX;
+        std::vector<float> minY;
+        std::vector<float> maxY;
+        float nearDepth = 0.0f;
+        float farDepth = 0.0f;
+        std::vector<uint32_t> hitClusters;  // 命中的簇在切片内的序号
+        std::vector<uint32_t> hitLights;    // 与hitClusters一一对应的光源索引
+        std::vector<uint32_t> indices;
+        std::vector<LightClusterRange> ranges;
+    };
+
+    void UpdateClusterBounds(const Matrix4& projection, float nearZ, float farZ);
+    void AssignSlice(uint32_t z);
+
+    ClusteredLightingConfig m_Config;
+    uint32_t m_TilesPerSlice = 0;
+    uint32_t m_PaddedTiles = 0;
+    Matrix4 m_BoundsProjection;
+    float m_BoundsNear = 0.0f;
+    float m_BoundsFar = 0.0f;
+    float m_SliceScale = 0.0f;
+    float m_SliceBias = 0.0f;
+
+    std::vector<Slice> m_Slices;
+    std::vector<LightSphere> m_Spheres;
+    std::vector<ClusterLightData> m_Lights;
+    std::vector<LightClusterRange> m_Clusters;
+    std::vector<uint32_t> m_LightIndices;
+    std::vector<uint32_t> m_DirectionalIndices;
+    ClusteredLightingStats m_Stats;
+};
+
+} // namespace PLE
@@ -0,0 +1,176 @@
+/**
+ * @file DebugDraw.h
+ * @brief 调试绘制：线段、包围盒、球体和文字，每帧合并为一次线段绘制
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Vector.h"
+#include "../Math/Matrix4.h"
+#include "RenderResources.h"
+
+// 调试构建中启用，发布构建中所有调用都是空的内联函数；定义PLE_DISABLE_DEBUG_DRAW可以在调试构建中也关闭
+#if defined(PLE_DEBUG) && !defined(PLE_DISABLE_DEBUG_DRAW)
+    #define PLE_DEBUG_DRAW_ENABLED
+#endif
+
+namespace PLE {
+
+// 前向声明
+class RenderSystem;
+
+/**
+ * @brief 调试线段顶点（16字节）
+ *
+ * 属性位置：0 = position（vec3），1 = color（vec4，Unorm8x4）。
+ */
+struct DebugVertex {
+    float x;
+    float y;
+    float z;
+    uint32_t color;             // RGBA8颜色，R在最低字节
+};
+
+/**
+ * @brief 调试绘制
+ *
+ * 任何线程都可以调用绘制函数：每个线程第一次调用时注册自己的缓冲区，
+ * 之后只写入自己的缓冲区（只有Flush时才会与渲染线程竞争同一把锁）。
+ * 渲染线程每帧调用一次Flush，把所有线程的线段合并到一个瞬态网格，
+ * 以一次线段列表绘制提交，然后清空缓冲区。
+ *
+ * 球体展开为三个大圆，文字用内置的笔画字体展开为线段，
+ * 朝向由SetTextBasis设置（通常每帧传入相机的右方向和上方向）。
+ * 着色器由调用者提供，顶点属性见DebugVertex。
+ *
+ * SetEnabled是运行时开关，关闭后绘制函数立即返回；物理系统按
+ * PhysicsConfig::enableDebugDraw决定是否提交碰撞体等调试图形。
+ * 发布构建中（PLE_DEBUG_DRAW_ENABLED未定义）整个类没有实现，调用被编译器消除。
+ */
+class PLE_API DebugDraw {
+public:
+    /**
+     * @brief 获取调试绘制实例
+     */
+    static DebugDraw& GetInstance();
+
+    /**
+     * @brief 调试线段的顶点布局
+     */
+    static const VertexLayout& GetVertexLayout();
+
+#ifdef PLE_DEBUG_DRAW_ENABLED
+    /**
+     * @brief 启用或禁用调试绘制
+     */
+    void SetEnabled(bool enabled) { m_Enabled.store(enabled, std::memory_order_relaxed); }
+
+    /**
+     * @brief 是否启用
+     */
+    bool IsEnabled() const { return m_Enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 线段
+     * @param color RGBA8颜色，R在最低字节
+     */
+    void Line(const Vector3& from, const Vector3& to, uint32_t color);
+
+    /**
+     * @brief 轴对齐包围盒
+     */
+    void Box(const Vector3& min, const Vector3& max, uint32_t color);
+
+    /**
+     * @brief 有向包围盒
+     * @param transform 包围盒中心的世界矩阵（行向量约定）
+     * @param halfExtents 半尺寸
+     */
+    void Box(const Matrix4& transform, const Vector3& halfExtents, uint32_t color);
+
+    /**
+     * @brief 球体（三个轴向的大圆）
+     * @param segments 每个圆的线段数
+     */
+    void Sphere(const Vector3& center, float radius, uint32_t color, uint32_t segments = 24);
+
+    /**
+     * @brief 坐标轴（X红、Y绿、Z蓝）
+     * @param transform 世界矩阵（行向量约定）
+     * @param size 轴长度
+     */
+    void Axes(const Matrix4& transform, float size);
+
+    /**
+     * @brief 文字，只支持ASCII，小写字母按大写绘制
+     * @param position 第一个字符左下角的位置
+     * @param text 文字，'\n'换行
+     * @param height 字符高度（世界单位）
+     */
+    void Text(const Vector3& position, const std::string& text, uint32_t color, float height);
+
+    /**
+     * @brief 设置文字平面的右方向和上方向（单位向量）
+     */
+    void SetTextBasis(const Vector3& right, const Vector3& up);
+
+    /**
+     * @brief 合并所有线程的线段并以一次绘制提交，然后清空，需要在渲染系统的BeginFrame和EndFrame之间调用
+     * @param renderSystem 渲染系统
+     * @param material 线段材质，着色器按DebugVertex的布局读取顶点
+     * @return 提交的线段数量
+     */
+    uint32_t Flush(RenderSystem& renderSystem, std::shared_ptr<Material> material);
+
+    /**
+     * @brief 丢弃所有线程缓冲区中的线段
+     */
+    void Clear();
+
+private:
+    /**
+     * @brief 单个线程的线段缓冲区
+     */
+    struct ThreadBuffer {
+        std::mutex mutex;
+        std::vector<DebugVertex> vertices;
+    };
+
+    DebugDraw() = default;
+
+    ThreadBuffer& GetThreadBuffer();
+    void AddLines(const DebugVertex* vertices, size_t count);
+
+    std::atomic<bool> m_Enabled{ true };
+    std::mutex m_Mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_Buffers;   // 线程退出后缓冲区仍保留，线程数量有限
+    std::vector<DebugVertex> m_Merged;
+    Vector3 m_TextRight = Vector3(1.0f, 0.0f, 0.0f);
+    Vector3 m_TextUp = Vector3(0.0f, 1.0f, 0.0f);
+#else
+    void SetEnabled(bool) {}
+    bool IsEnabled() const { return false; }
+    void Line(const Vector3&, const Vector3&, uint32_t) {}
+    void Box(const Vector3&, const Vector3&, uint32_t) {}
+    void Box(const Matrix4&, const Vector3&, uint32_t) {}
+    void Sphere(const Vector3&, float, uint32_t, uint32_t = 24) {}
+    void Axes(const Matrix4&, float) {}
+    void Text(const Vector3&, const std::string&, uint32_t, float) {}
+    void SetTextBasis(const Vector3&, const Vector3&) {}
+    uint32_t Flush(RenderSystem&, std::shared_ptr<Material>) { return 0; }
+    void Clear() {}
+
+private:
+    DebugDraw() = default;
+#endif
+};
+
+} // namespace PLE
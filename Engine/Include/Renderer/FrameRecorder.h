@@ -0,0 +1,211 @@
+/**
+ * @file FrameRecorder.h
+ * @brief 异步截图与帧序列编码
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+
+namespace PLE {
+
+// 前向声明
+class RenderSystem;
+class ReadbackBuffer;
+struct PngRowBlock;
+
+/**
+ * @brief 帧输出格式
+ */
+enum class FrameOutputFormat {
+    PNG = 0,        // 每帧一个RGBA PNG文件
+    Y4M,            // YUV4MPEG2视频流（BT.601有限范围，4:2:0），写入文件或管道
+};
+
+/**
+ * @brief 帧录制配置
+ */
+struct FrameRecorderConfig {
+    FrameOutputFormat format = FrameOutputFormat::PNG;
+    // PNG：文件名模板，其中的printf格式（如%06u）替换为帧序号；
+    // Y4M：文件路径，以'|'开头时作为命令启动并写入它的标准输入，
+    // 例如"|ffmpeg -y -f yuv4mpegpipe -i - -c:v libx264 out.mp4"
+    std::string output = "frame_%06u.png";
+    uint32_t frameRate = 30;            // Y4M流头中的帧率
+    uint32_t workerCount = 0;           // 编码线程数，0表示硬件线程数 - 1（至少1个）
+    uint32_t maxBuffers = 8;            // 读回缓冲区数量上限（等待GPU和正在编码的帧）
+    bool dropWhenBusy = false;          // 缓冲区全部占用时丢弃新帧，否则渲染线程等待最早的帧编码完成
+    uint32_t pngBlockBytes = 256 * 1024;    // PNG分段并行压缩时每段的原始字节数
+};
+
+/**
+ * @brief 帧录制统计
+ */
+struct FrameRecorderStats {
+    uint64_t captured = 0;              // 发出读回的帧
+    uint64_t written = 0;               // 已写出的帧
+    uint64_t dropped = 0;               // 缓冲区耗尽而丢弃的帧
+    uint64_t failed = 0;                // 读回、编码或写出失败的帧
+    uint64_t bytesWritten = 0;
+    double stallMilliseconds = 0.0;     // 渲染线程等待空闲缓冲区的累计时间
+};
+
+/**
+ * @brief 帧录制器：异步读回渲染目标并在后台线程编码
+ *
+ * Capture通过RenderSystem::ReadPixelsAsync把像素复制到缓冲区池中的一个读回缓冲区后立即返回，
+ * 渲染线程不等待GPU，也不复制像素；读回完成的帧按截取顺序交给编码线程，
+ * 编码线程直接读取映射的缓冲区，写出后把缓冲区还给池。
+ * - PNG：每帧按行切成若干段，各段由不同的编码线程独立滤波和压缩
+ *   （每段以前32KB数据为字典，与pigz相同），单张截图也能用满所有编码线程；
+ * - Y4M：每帧由一个编码线程转换为YUV 4:2:0，按截取顺序写入同一个流，
+ *   所有帧的尺寸必须相同；写入管道时可以直接交给ffmpeg等编码器。
+ *
+ * 编码线程是录制器自己的线程，不占用任务系统，不会与渲染线程的并行任务争抢。
+ * Capture和Update只能在渲染线程调用（OpenGL后端只能在那里查询读回状态）。
+ *
+ * 用法：
+ * @code
+ * FrameRecorder recorder(renderSystem, config);
+ * recorder.Initialize();
+ * renderSystem.BeginFrame();
+ * recorder.Update();
+ * // 绘制之后
+ * recorder.Capture(0, 0, width, height);
+ * renderSystem.EndFrame();
+ * // 结束时
+ * recorder.Shutdown();
+ * @endcode
+ */
+class PLE_API FrameRecorder {
+public:
+    /**
+     * @brief 构造函数
+     * @param renderSystem 已初始化的渲染系统，生命周期必须长于录制器
+     * @param config 配置
+     */
+    explicit FrameRecorder(RenderSystem& renderSystem, const FrameRecorderConfig& config = FrameRecorderConfig());
+    ~FrameRecorder();
+
+    FrameRecorder(const FrameRecorder&) = delete;
+    FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+    /**
+     * @brief 打开输出（Y4M）并启动编码线程
+     * @return 是否成功
+     */
+    bool Initialize();
+
+    /**
+     * @brief 等待所有已截取的帧写出，然后停止编码线程并关闭输出
+     */
+    void Shutdown();
+
+    /**
+     * @brief 异步截取当前渲染目标的一块区域
+     * @param x 区域左下角X坐标
+     * @param y 区域左下角Y坐标
+     * @param width 区域宽度
+     * @param height 区域高度
+     * @param path PNG格式下这一帧的文件名，为空时按模板生成；Y4M格式忽略
+     * @return 是否发出读回，缓冲区耗尽而丢帧或读回失败时返回false
+     */
+    bool Capture(int x, int y, int width, int height, const std::string& path = "");
+
+    /**
+     * @brief 把读回已完成的帧交给编码线程，每帧在BeginFrame之后调用一次
+     */
+    void Update();
+
+    /**
+     * @brief 阻塞等待所有已截取的帧写出
+     */
+    void Flush();
+
+    /**
+     * @brief 获取统计
+     */
+    FrameRecorderStats GetStats() const;
+
+private:
+    /**
+     * @brief 缓冲区池中的一帧
+     */
+    struct Frame {
+        std::shared_ptr<ReadbackBuffer> buffer;
+        bool busy = false;                      // 正在读回或编码，编码线程释放时修改，受m_Mutex保护
+        uint64_t generation = 0;                // 截取时的Update次数
+        uint64_t ticket = 0;                    // Y4M写出顺序
+        std::string path;
+        std::vector<const uint8_t*> rows;       // 从上到下
+        std::vector<PngRowBlock> blocks;
+        uint32_t blockRows = 0;
+        std::atomic<uint32_t> remainingBlocks{ 0 };
+    };
+
+    /**
+     * @brief 编码任务：PNG的一段，或Y4M的一整帧
+     */
+    struct Task {
+        Frame* frame;
+        uint32_t block;
+    };
+
+    Frame* AcquireFrame(int width, int height);
+    Frame* FindFreeFrame(int width, int height);
+    bool WaitOldest();
+    void DispatchReady();
+    void Dispatch(Frame* frame);
+    void ReleaseFrame(Frame* frame);
+    void FinishFrame(bool success, uint64_t bytes);
+    void WorkerLoop();
+    void EncodePngBlock(Frame* frame, uint32_t block);
+    void EncodeY4mFrame(Frame* frame);
+    std::string FormatPath(uint64_t index) const;
+
+    RenderSystem& m_RenderSystem;
+    FrameRecorderConfig m_Config;
+    bool m_Initialized = false;
+
+    // 渲染线程独占
+    std::vector<std::unique_ptr<Frame>> m_Frames;
+    std::deque<Frame*> m_Reading;                   // 等待GPU的帧，按截取顺序
+    uint64_t m_Generation = 0;
+    uint64_t m_NextIndex = 0;
+    uint64_t m_NextTicket = 0;
+    int m_StreamWidth = 0;
+    int m_StreamHeight = 0;
+
+    // 编码线程共享
+    std::vector<std::thread> m_Workers;
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_TaskCondition;
+    std::condition_variable m_DoneCondition;        // 有帧释放缓冲区或写出完成
+    std::deque<Task> m_Tasks;
+    uint32_t m_Encoding = 0;                        // 已交给编码线程、还没有释放缓冲区的帧
+    uint32_t m_Pending = 0;                         // 已交给编码线程、还没有写出的帧
+    FrameRecorderStats m_Stats;
+    bool m_Running = false;
+
+    // Y4M输出，按写出顺序串行
+    std::mutex m_StreamMutex;
+    std::condition_variable m_StreamCondition;
+    FILE* m_Stream = nullptr;
+    bool m_StreamIsPipe = false;
+    bool m_StreamHeaderWritten = false;
+    bool m_StreamFailed = false;                    // 写入失败后不再写入（例如管道另一端已经退出）
+    uint64_t m_NextWrite = 0;
+};
+
+} // namespace PLE
@@ -0,0 +1,318 @@
+/**
+ * @file LightBaker.h
+ * @brief 光照贴图和光照探针的CPU路径追踪烘焙
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Vector.h"
+#include "../Math/Matrix4.h"
+#include "ClusteredLighting.h"
+#include "RenderResources.h"
+
+namespace PLE {
+
+// 前向声明
+class BakeBVH;
+class Light;
+
+/**
+ * @brief 参与烘焙的网格
+ *
+ * 所有网格都遮挡光线并反射间接光；lightmapIndex不小于0的网格还接收光照贴图，
+ * 顶点的texCoord作为光照贴图UV（需要在[0, 1]内且不重叠），
+ * 经lightmapScaleOffset变换到图集中的位置：uv * (x, y) + (z, w)。
+ */
+struct LightBakeMesh {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;              // 三角形列表
+    Matrix4 transform = Matrix4::Identity();
+    Vector3 albedo = Vector3(0.8f, 0.8f, 0.8f); // 漫反射率（线性空间）
+    Vector3 emission = Vector3(0.0f, 0.0f, 0.0f);   // 自发光辐亮度，只通过光线命中计入
+    int lightmapIndex = -1;
+    Vector4 lightmapScaleOffset = Vector4(1.0f, 1.0f, 0.0f, 0.0f);
+};
+
+/**
+ * @brief 烘焙配置
+ */
+struct LightBakerConfig {
+    int lightmapWidth = 512;
+    int lightmapHeight = 512;
+    uint32_t samplesPerTexel = 256;     // 每个纹素的半球采样数
+    uint32_t samplesPerProbe = 1024;    // 每个探针的球面采样数
+    uint32_t maxBounces = 3;            // 间接光的反弹次数，0表示只烘焙直接光和天空光
+    float rayBias = 1.0e-3f;            // 光线起点沿法线的偏移（世界单位）
+    float backfaceTolerance = 0.5f;     // 半球采样命中背面的比例超过此值的纹素视为在几何体内部，由周围纹素填充
+    bool denoise = true;                // 对间接光做以位置和法线为引导的滤波，直接光（含阴影边缘）不滤波
+    int denoiseRadius = 3;              // 滤波半径（纹素）
+    int dilation = 2;                   // 向无效纹素扩展的圈数，避免双线性过滤在接缝处采到黑色
+    float dirtyMargin = 2.0f;           // 增量烘焙时变化区域向外扩展的距离，超出此距离的间接光变化被忽略
+};
+
+/**
+ * @brief 烘焙得到的光照贴图（线性空间RGB浮点，行从上到下，v = 0在第一行）
+ *
+ * 数值与运行时光源的约定一致：漫反射颜色 = albedo * 光照贴图。
+ */
+struct LightmapData {
+    int width = 0;
+    int height = 0;
+    std::vector<float> pixels;          // 每个纹素3个分量
+};
+
+/**
+ * @brief 二阶球谐光照探针：入射辐亮度在9个基函数上的投影（RGB）
+ */
+struct LightProbeSH {
+    float coefficients[9][3] = {};
+};
+
+/**
+ * @brief 烘焙统计
+ */
+struct LightBakerStats {
+    uint32_t triangles = 0;
+    uint32_t bvhNodes = 0;
+    uint32_t texels = 0;                // 光照贴图中被几何体覆盖的纹素数量
+    uint32_t bakedTexels = 0;           // 最近一次烘焙追踪的纹素数量
+    uint32_t bakedProbes = 0;
+    uint32_t rejectedTexels = 0;        // 因命中背面过多被丢弃的纹素
+    uint64_t rays = 0;                  // 最近一次烘焙的光线数（包括阴影光线）
+    double buildMilliseconds = 0.0;     // BVH构建耗时
+    double bakeMilliseconds = 0.0;      // 追踪、降噪和扩展的耗时
+};
+
+/**
+ * @brief 光照烘焙器
+ *
+ * 在CPU上为静态几何体烘焙光照贴图和球谐光照探针，取代运行时对静态物体的逐光源计算。
+ * 场景三角形构建为四叉BVH（SSE2一次测试4个包围盒或4个三角形），
+ * 纹素和探针按批次分给任务系统在所有核心上并行追踪：
+ * - 纹素：在光照贴图UV空间光栅化得到世界位置和法线，按余弦分布在半球上采样路径，
+ *   每个路径顶点对所有光源做带阴影光线的直接光照（光源有半径时为软阴影），
+ *   超过两次反弹后以俄罗斯轮盘赌终止；
+ * - 探针：在球面上均匀采样入射辐亮度并投影到二阶球谐。
+ *
+ * 场景变化（网格变换或材质、光源、天空光）会记录变化的世界空间区域，
+ * BakeChanges只重新追踪位于这些区域附近（dirtyMargin以内）的纹素和探针，
+ * 以及到某个光源的线段穿过几何体变化区域（阴影可能变化）的纹素和探针。
+ * 更远处的间接光变化会被忽略，修改完成后应再做一次完整烘焙。
+ *
+ * 点光源和聚光灯的距离衰减为 saturate(1 - (d / range)^4)^2 / d^2，
+ * 聚光灯的角度衰减与ClusterLightData相同。
+ *
+ * 用法：
+ * @code
+ * LightBaker baker(config);
+ * baker.AddMesh(mesh);
+ * baker.AddLight(light);
+ * baker.AddProbe(position);
+ * baker.Bake();
+ * TextureData lightmap = baker.ExportLightmapRGBM(0);
+ * @endcode
+ */
+class PLE_API LightBaker {
+public:
+    explicit LightBaker(const LightBakerConfig& config = LightBakerConfig());
+    ~LightBaker();
+
+    LightBaker(const LightBaker&) = delete;
+    LightBaker& operator=(const LightBaker&) = delete;
+
+    /**
+     * @brief 添加网格
+     * @return 网格序号
+     */
+    uint32_t AddMesh(const LightBakeMesh& mesh);
+
+    /**
+     * @brief 修改网格的模型矩阵
+     */
+    void SetMeshTransform(uint32_t mesh, const Matrix4& transform);
+
+    /**
+     * @brief 修改网格的材质
+     */
+    void SetMeshMaterial(uint32_t mesh, const Vector3& albedo, const Vector3& emission);
+
+    /**
+     * @brief 添加光源
+     * @param light 光源数据（与分簇光照相同的格式）
+     * @param radius 光源半径，点光源和聚光灯为世界单位，方向光为角半径（弧度），0为硬阴影
+     * @return 光源序号
+     */
+    uint32_t AddLight(const ClusterLightData& light, float radius = 0.0f);
+
+    /**
+     * @brief 添加场景中的光源组件
+     */
+    uint32_t AddLight(const Light& light, float radius = 0.0f);
+
+    /**
+     * @brief 修改光源
+     */
+    void SetLight(uint32_t index, const ClusterLightData& light, float radius = 0.0f);
+
+    /**
+     * @brief 启用或禁用光源
+     */
+    void SetLightEnabled(uint32_t index, bool enabled);
+
+    /**
+     * @brief 设置天空光（所有未命中几何体的光线的辐亮度）
+     */
+    void SetSkyColor(const Vector3& color);
+
+    /**
+     * @brief 添加光照探针
+     * @return 探针序号
+     */
+    uint32_t AddProbe(const Vector3& position);
+
+    /**
+     * @brief 把一个世界空间区域标记为需要重新烘焙
+     */
+    void Invalidate(const Vector3& min, const Vector3& max);
+
+    /**
+     * @brief 完整烘焙所有光照贴图和探针
+     * @return 是否成功（没有几何体时返回false）
+     */
+    bool Bake();
+
+    /**
+     * @brief 增量烘焙：只重新追踪变化区域附近的纹素和探针，还没有完整烘焙过时执行完整烘焙
+     * @return 是否成功
+     */
+    bool BakeChanges();
+
+    /**
+     * @brief 上次烘焙后是否有变化
+     */
+    bool HasChanges() const;
+
+    /**
+     * @brief 光照贴图数量（最大的lightmapIndex加1）
+     */
+    uint32_t GetLightmapCount() const { return static_cast<uint32_t>(m_Lightmaps.size()); }
+
+    /**
+     * @brief 获取光照贴图，引用在下一次烘焙前有效
+     */
+    const LightmapData& GetLightmap(uint32_t index) const { return m_Lightmaps[index].output; }
+
+    /**
+     * @brief 把光照贴图编码为RGBM（RGBA8）：颜色 = rgb * a * range
+     * @param index 光照贴图序号
+     * @param range 可表示的最大值
+     */
+    TextureData ExportLightmapRGBM(uint32_t index, float range = 8.0f) const;
+
+    /**
+     * @brief 探针数量
+     */
+    uint32_t GetProbeCount() const { return static_cast<uint32_t>(m_Probes.size()); }
+
+    /**
+     * @brief 获取探针
+     */
+    const LightProbeSH& GetProbe(uint32_t index) const { return m_Probes[index].sh; }
+
+    /**
+     * @brief 计算探针在某个法线方向上的漫反射光照，约定与光照贴图相同
+     * @param probe 探针
+     * @param normal 世界空间单位法线
+     */
+    static Vector3 EvaluateProbe(const LightProbeSH& probe, const Vector3& normal);
+
+    /**
+     * @brief 获取统计
+     */
+    const LightBakerStats& GetStats() const { return m_Stats; }
+
+private:
+    struct BakeLight {
+        ClusterLightData data;
+        float radius = 0.0f;
+        bool enabled = true;
+    };
+
+    /**
+     * @brief 世界空间三角形，顶点法线用于插值着色法线
+     */
+    struct BakeTriangle {
+        Vector3 normals[3];
+        Vector3 geometricNormal;
+        uint32_t mesh = 0;
+    };
+
+    /**
+     * @brief 光照贴图纹素的几何信息
+     */
+    struct Texel {
+        Vector3 position;
+        Vector3 normal;
+        float size = 0.0f;          // 纹素在世界空间的边长，降噪时用于位置权重
+        uint32_t mesh = 0xFFFFFFFFu;    // 0xFFFFFFFF表示没有被覆盖
+    };
+
+    struct Lightmap {
+        std::vector<Texel> texels;
+        std::vector<float> direct;      // 追踪结果（RGB）：直接光，硬阴影没有噪声
+        std::vector<float> indirect;    // 间接光和天空光，降噪只作用于这一部分
+        std::vector<uint8_t> valid;     // 追踪结果是否有效（被覆盖且没有因命中背面被丢弃）
+        LightmapData output;
+    };
+
+    struct Probe {
+        Vector3 position;
+        LightProbeSH sh;
+        bool baked = false;
+    };
+
+    struct DirtyRegion {
+        Vector3 min;
+        Vector3 max;
+        bool occluder;              // 区域内的遮挡体有变化，穿过区域的阴影光线也需要重新追踪
+    };
+
+    struct Sampler;
+
+    void BuildScene();
+    void RasterizeLightmaps();
+    void MarkMeshDirty(uint32_t mesh, bool occluder);
+    void MarkLightDirty(const BakeLight& light);
+    bool IsDirty(const Vector3& position) const;
+    bool Run(bool incremental);
+    void TraceTexel(Lightmap& lightmap, uint32_t texel, Sampler& sampler) const;
+    void TraceProbe(Probe& probe, Sampler& sampler) const;
+    Vector3 TraceRadiance(const Vector3& origin, const Vector3& direction, Sampler& sampler, bool* backface) const;
+    bool SampleLight(const BakeLight& light, const Vector3& position, Sampler& sampler, Vector3& toLight, Vector3& intensity) const;
+    Vector3 DirectLight(const Vector3& position, const Vector3& normal, Sampler& sampler) const;
+    void Denoise(Lightmap& lightmap) const;
+    void Dilate(Lightmap& lightmap) const;
+
+    LightBakerConfig m_Config;
+    std::vector<LightBakeMesh> m_Meshes;
+    std::vector<BakeLight> m_Lights;
+    std::vector<Probe> m_Probes;
+    Vector3 m_SkyColor = Vector3(0.0f, 0.0f, 0.0f);
+
+    std::unique_ptr<BakeBVH> m_BVH;
+    std::vector<BakeTriangle> m_Triangles;
+    std::vector<Lightmap> m_Lightmaps;
+
+    bool m_SceneDirty = true;           // 几何体变化，需要重建BVH和纹素
+    bool m_Baked = false;               // 是否完整烘焙过
+    bool m_AllDirty = true;             // 变化影响整个场景（方向光或天空光）
+    std::vector<DirtyRegion> m_DirtyRegions;
+    LightBakerStats m_Stats;
+};
+
+} // namespace PLE
@@ -0,0 +1,135 @@
+/**
+ * @file MeshCompression.h
+ * @brief 量化顶点格式和无损的顶点/索引缓冲编解码
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Vector.h"
+
+namespace PLE {
+
+struct Vertex;
+struct VertexLayout;
+
+/**
+ * @brief 量化顶点（16字节，标准Vertex为32字节）
+ *
+ * 位置相对网格包围盒量化为16位无符号归一化整数，解码（乘以缩放、加上偏移）由
+ * QuantizeVertices返回的VertexLayout合并到模型矩阵中，着色器无需改动；缩放在三个轴上
+ * 相同，所以法线不受解码矩阵影响。法线为八面体编码，着色器需要解码：
+ *
+ * @code
+ * layout(location = 1) in vec2 a_Normal;
+ * vec3 DecodeOctahedral(vec2 e) {
+ *     vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+ *     float t = max(-n.z, 0.0);
+ *     n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+ *     return normalize(n);
+ * }
+ * @endcode
+ */
+struct QuantizedVertex {
+    uint16_t position[4];   // Unorm16x4，w固定为65535（解码为1）
+    int16_t normal[2];      // Snorm16x2，八面体编码
+    uint16_t texCoord[2];   // Half2
+};
+
+/**
+ * @brief 网格压缩
+ *
+ * 量化在导入时完成，量化后的顶点可以直接传给RenderSystem::CreateMesh。
+ * 磁盘存储时再用无损编解码压缩顶点和索引缓冲：
+ * - 顶点缓冲按字节通道编码：每个字节与上一个顶点的同一字节做差并zigzag，
+ *   每16个值一组按最大值选择0/2/4/8位存储。加载时用SSE2解码（解包、反zigzag、前缀和），
+ *   网格先经MeshOptimizer::OptimizeVertexFetch重排时相邻顶点更相似，压缩率更高；
+ * - 索引缓冲存储与上一个索引之差的zigzag变长整数，经顶点缓存优化后差值通常只需一个字节。
+ */
+class PLE_API MeshCompression {
+public:
+    /**
+     * @brief 量化顶点
+     * @param vertices 标准顶点
+     * @param vertexCount 顶点数量
+     * @param output 输出量化顶点
+     * @return 量化顶点的布局，包含位置解码参数
+     */
+    static VertexLayout QuantizeVertices(const Vertex* vertices, uint32_t vertexCount, std::vector<QuantizedVertex>& output);
+
+    /**
+     * @brief 还原量化顶点（用于工具和校验）
+     * @param vertices 量化顶点
+     * @param vertexCount 顶点数量
+     * @param layout QuantizeVertices返回的布局
+     * @param output 输出标准顶点
+     */
+    static void DequantizeVertices(const QuantizedVertex* vertices, uint32_t vertexCount, const VertexLayout& layout,
+                                   std::vector<Vertex>& output);
+
+    /**
+     * @brief 八面体编码单位向量（法线、切线；切线的手性符号需另外存储）
+     * @param direction 单位向量
+     * @param encoded 输出两个Snorm16分量
+     */
+    static void EncodeOctahedral(const Vector3& direction, int16_t encoded[2]);
+
+    /**
+     * @brief 八面体解码
+     */
+    static Vector3 DecodeOctahedral(const int16_t encoded[2]);
+
+    /**
+     * @brief 32位浮点转半精度（就近舍入，超出范围时饱和为无穷大）
+     */
+    static uint16_t FloatToHalf(float value);
+
+    /**
+     * @brief 半精度转32位浮点
+     */
+    static float HalfToFloat(uint16_t value);
+
+    /**
+     * @brief 无损编码顶点缓冲
+     * @param vertices 顶点数据
+     * @param vertexCount 顶点数量
+     * @param vertexSize 每个顶点的字节数（不超过256）
+     * @return 编码结果，参数无效时为空
+     */
+    static std::vector<uint8_t> EncodeVertexBuffer(const void* vertices, uint32_t vertexCount, uint32_t vertexSize);
+
+    /**
+     * @brief 解码顶点缓冲
+     * @param data 编码数据
+     * @param size 编码数据字节数
+     * @param vertices 输出顶点数据
+     * @param vertexCount 输出顶点数量
+     * @param vertexSize 输出每个顶点的字节数
+     * @return 数据是否完整有效
+     */
+    static bool DecodeVertexBuffer(const uint8_t* data, size_t size, std::vector<uint8_t>& vertices,
+                                   uint32_t& vertexCount, uint32_t& vertexSize);
+
+    /**
+     * @brief 无损编码索引缓冲
+     * @param indices 索引
+     * @param indexCount 索引数量
+     * @return 编码结果
+     */
+    static std::vector<uint8_t> EncodeIndexBuffer(const uint32_t* indices, uint32_t indexCount);
+
+    /**
+     * @brief 解码索引缓冲
+     * @param data 编码数据
+     * @param size 编码数据字节数
+     * @param indices 输出索引
+     * @return 数据是否完整有效
+     */
+    static bool DecodeIndexBuffer(const uint8_t* data, size_t size, std::vector<uint32_t>& indices);
+};
+
+} // namespace PLE
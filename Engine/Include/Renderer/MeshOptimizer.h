@@ -0,0 +1,153 @@
+/**
+ * @file MeshOptimizer.h
+ * @brief 导入时的网格优化：顶点缓存、过度绘制、顶点读取顺序和网格簇划分
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Vector.h"
+
+namespace PLE {
+
+struct Vertex;
+
+/**
+ * @brief 网格簇（meshlet）
+ *
+ * 顶点和三角形分别引用MeshletData中的顶点索引表和局部三角形表，
+ * 包围球和法线锥用于按簇剔除（模型空间）。
+ */
+struct Meshlet {
+    uint32_t vertexOffset = 0;      // 在MeshletData::vertices中的起始位置
+    uint32_t triangleOffset = 0;    // 在MeshletData::triangles中的起始位置（以字节计，每个三角形3字节）
+    uint32_t vertexCount = 0;
+    uint32_t triangleCount = 0;
+    Vector3 center;                 // 包围球
+    float radius = 0.0f;
+    Vector3 coneApex;               // 法线锥顶点
+    Vector3 coneAxis;               // 法线锥轴
+    float coneCutoff = 1.0f;        // dot(normalize(coneApex - camera), coneAxis) >= coneCutoff 时整簇背向相机
+};
+
+/**
+ * @brief 网格簇划分结果
+ */
+struct MeshletData {
+    std::vector<Meshlet> meshlets;
+    std::vector<uint32_t> vertices;     // 网格簇的局部顶点到网格顶点的映射
+    std::vector<uint8_t> triangles;     // 每个三角形3个局部顶点序号
+};
+
+/**
+ * @brief 顶点缓存模拟结果
+ */
+struct VertexCacheStats {
+    uint32_t transformedVertices = 0;   // 缓存未命中（需要执行顶点着色器）的次数
+    float acmr = 0.0f;                  // 平均每个三角形的缓存未命中次数，理想值约为0.5
+    float atvr = 0.0f;                  // 缓存未命中次数与顶点数之比，理想值为1
+};
+
+/**
+ * @brief 网格优化配置
+ */
+struct MeshOptimizerConfig {
+    uint32_t cacheSize = 16;            // 顶点缓存优化假设的缓存大小
+    bool optimizeOverdraw = true;       // 是否按外法线排序三角形簇以减少过度绘制
+    bool buildMeshlets = true;          // 是否划分网格簇
+    uint32_t maxMeshletVertices = 64;   // 每个网格簇的最大顶点数（不超过256）
+    uint32_t maxMeshletTriangles = 124; // 每个网格簇的最大三角形数
+};
+
+/**
+ * @brief 网格优化
+ *
+ * 在网格导入时、调用RenderSystem::CreateMesh之前运行，推荐顺序为：
+ * 1. OptimizeVertexCache：Tipsify算法重排三角形，使相邻三角形共用刚变换过的顶点；
+ * 2. OptimizeOverdraw：以顶点缓存优化在缓存清空处划出的三角形簇为单位，
+ *    朝外且远离网格中心的簇先绘制，提前深度测试能剔除更多被遮挡的片元，簇内顺序不变；
+ * 3. OptimizeVertexFetch：按首次使用顺序重排顶点并去掉未使用的顶点，提高顶点读取的内存局部性；
+ * 4. BuildMeshlets：按最终的三角形顺序贪心划分网格簇，计算包围球和法线锥。
+ *
+ * Optimize按上述顺序执行全部步骤。所有函数只处理三角形列表。
+ */
+class PLE_API MeshOptimizer {
+public:
+    /**
+     * @brief 按配置执行全部优化
+     * @param vertices 顶点，原地重排，未使用的顶点被删除
+     * @param indices 索引，原地重排
+     * @param config 配置
+     * @param meshlets 输出网格簇，为nullptr或配置关闭时不划分
+     * @return 是否成功（索引数量不是3的倍数或索引越界时返回false）
+     */
+    static bool Optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+                         const MeshOptimizerConfig& config = MeshOptimizerConfig(), MeshletData* meshlets = nullptr);
+
+    /**
+     * @brief 顶点缓存优化（Tipsify）
+     * @param indices 索引，原地重排
+     * @param indexCount 索引数量
+     * @param vertexCount 顶点数量
+     * @param cacheSize 假设的缓存大小
+     * @param clusters 输出缓存清空处的三角形序号（每个簇的第一个三角形），可为nullptr
+     */
+    static void OptimizeVertexCache(uint32_t* indices, uint32_t indexCount, uint32_t vertexCount,
+                                    uint32_t cacheSize = 16, std::vector<uint32_t>* clusters = nullptr);
+
+    /**
+     * @brief 过度绘制优化：按簇的外法线方向排序
+     * @param indices 索引，原地重排
+     * @param indexCount 索引数量
+     * @param vertices 顶点
+     * @param vertexCount 顶点数量
+     * @param clusters OptimizeVertexCache输出的簇起始三角形序号
+     */
+    static void OptimizeOverdraw(uint32_t* indices, uint32_t indexCount, const Vertex* vertices, uint32_t vertexCount,
+                                 const std::vector<uint32_t>& clusters);
+
+    /**
+     * @brief 顶点读取优化：按首次使用顺序重排顶点
+     * @param vertices 顶点，原地重排
+     * @param vertexCount 顶点数量
+     * @param indices 索引，改写为新的顶点序号
+     * @param indexCount 索引数量
+     * @return 重排后使用到的顶点数量，其后的顶点可以丢弃
+     */
+    static uint32_t OptimizeVertexFetch(Vertex* vertices, uint32_t vertexCount, uint32_t* indices, uint32_t indexCount);
+
+    /**
+     * @brief 划分网格簇
+     * @param vertices 顶点
+     * @param vertexCount 顶点数量
+     * @param indices 索引
+     * @param indexCount 索引数量
+     * @param maxVertices 每个网格簇的最大顶点数（3到256）
+     * @param maxTriangles 每个网格簇的最大三角形数
+     * @param meshlets 输出
+     */
+    static void BuildMeshlets(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount,
+                              uint32_t maxVertices, uint32_t maxTriangles, MeshletData& meshlets);
+
+    /**
+     * @brief 网格簇是否整体背向相机（法线锥测试）
+     * @param meshlet 网格簇
+     * @param cameraPosition 模型空间中的相机位置
+     */
+    static bool IsMeshletBackfacing(const Meshlet& meshlet, const Vector3& cameraPosition);
+
+    /**
+     * @brief 模拟FIFO顶点缓存，评估三角形顺序
+     * @param indices 索引
+     * @param indexCount 索引数量
+     * @param vertexCount 顶点数量
+     * @param cacheSize 缓存大小
+     */
+    static VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount,
+                                               uint32_t cacheSize = 16);
+};
+
+} // namespace PLE
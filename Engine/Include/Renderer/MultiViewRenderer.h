@@ -0,0 +1,216 @@
+/**
+ * @file MultiViewRenderer.h
+ * @brief 多视图渲染：共享场景提取，各视图并行剔除和排序
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Vector.h"
+#include "../Math/Matrix4.h"
+
+namespace PLE {
+
+// 前向声明
+class RenderSystem;
+class RenderTarget;
+class Mesh;
+class Material;
+class Camera;
+
+/**
+ * @brief 可渲染物体
+ */
+struct RenderObject {
+    Vector3 boundsMin;                      // 世界空间包围盒
+    Vector3 boundsMax;
+    std::shared_ptr<Mesh> mesh;
+    std::shared_ptr<Material> material;
+    Matrix4 transform;
+    uint32_t layers = 1;                    // 所属的层（位掩码），与RenderView::layerMask相交才会被该视图绘制
+};
+
+/**
+ * @brief 视图内的绘制顺序
+ */
+enum class ViewSortMode {
+    None = 0,           // 保持物体顺序
+    FrontToBack,        // 由近到远（不透明物体，减少过度绘制）
+    BackToFront,        // 由远到近（半透明物体）
+    State,              // 按材质和网格分组，组内由近到远（减少状态切换）
+};
+
+/**
+ * @brief 一个视图：相机、输出区域和绘制规则
+ */
+struct RenderView {
+    std::string name;
+    Matrix4 view;                           // 视图矩阵（行向量约定）
+    Matrix4 projection;                     // 投影矩阵，深度范围[0, 1]
+    std::shared_ptr<RenderTarget> target;   // nullptr表示默认帧缓冲
+    int viewportX = 0;                      // 视口，宽度为0时使用整个渲染目标
+    int viewportY = 0;
+    int viewportWidth = 0;
+    int viewportHeight = 0;
+    bool clear = true;                      // 绘制前清除整个渲染目标；与上一个视图共用目标时忽略（分屏由第一个视图清除）
+    Vector4 clearColor = Vector4(0.0f, 0.0f, 0.0f, 1.0f);
+    uint32_t layerMask = 0xFFFFFFFFu;
+    std::shared_ptr<Material> overrideMaterial;     // 不为nullptr时所有物体使用该材质（阴影、深度等视图）
+    ViewSortMode sortMode = ViewSortMode::FrontToBack;
+
+    /**
+     * @brief 使用相机组件的视图和投影矩阵创建视图
+     */
+    static RenderView FromCamera(const Camera& camera, const std::string& name = "View");
+};
+
+/**
+ * @brief 多视图渲染统计（每次Cull重置）
+ */
+struct MultiViewStats {
+    uint32_t objects = 0;                   // 提取的物体数量
+    uint32_t views = 0;
+    uint32_t tested = 0;                    // 所有视图中层掩码匹配、参与剔除的物体数量之和
+    uint32_t visible = 0;                   // 所有视图中可见物体数量之和
+    double extractMilliseconds = 0.0;
+    double cullMilliseconds = 0.0;          // 剔除和排序（并行）
+    double submitMilliseconds = 0.0;        // 提交给渲染系统（渲染线程）
+};
+
+/**
+ * @brief 多视图渲染器
+ *
+ * 分屏、小地图、阴影视图、反射探针、服务端观战缩略图等多个视图每帧看到的是同一组物体，
+ * 逐个视图完整渲染会重复提取场景数据，CPU时间也完全串行。这里把一帧分成三步：
+ * - Extract：物体数据复制一次，同时整理出所有视图共享的包围盒中心和半尺寸；
+ * - Cull：所有视图一起剔除，按（视图, 物体块）切分给任务系统并行执行，
+ *   之后每个视图在自己的任务中压缩可见列表并排序；
+ * - Submit：在渲染线程上按视图顺序设置渲染目标、视口和视图投影并提交绘制。
+ *
+ * Extract和Cull不调用渲染系统，可以在游戏线程上与上一帧的提交重叠执行；
+ * Submit只做DrawMesh这类轻量的记录，Vulkan后端在EndFrame中把所有视图的渲染通道
+ * 一起切块并行录制到二级命令缓冲。
+ *
+ * 剔除使用视图投影矩阵提取的6个平面测试包围盒，深度约定与Matrix4::Perspective一致。
+ * 与剔除结果一起计入RenderSystem::ReportCulling。
+ *
+ * 用法：
+ * @code
+ * renderer.Extract(objects.data(), objectCount);
+ * renderer.Cull(views.data(), viewCount);
+ * renderSystem.BeginFrame();
+ * renderer.Submit(renderSystem);
+ * renderSystem.EndFrame();
+ * @endcode
+ */
+class PLE_API MultiViewRenderer {
+public:
+    MultiViewRenderer();
+    ~MultiViewRenderer();
+
+    /**
+     * @brief 提取本帧的物体，所有视图共享
+     * @param objects 物体数组
+     * @param count 物体数量
+     */
+    void Extract(const RenderObject* objects, uint32_t count);
+
+    /**
+     * @brief 提取本帧的物体
+     */
+    void Extract(const std::vector<RenderObject>& objects);
+
+    /**
+     * @brief 并行剔除和排序所有视图
+     * @param views 视图数组，按提交顺序排列
+     * @param count 视图数量
+     */
+    void Cull(const RenderView* views, uint32_t count);
+
+    /**
+     * @brief 并行剔除和排序所有视图
+     */
+    void Cull(const std::vector<RenderView>& views);
+
+    /**
+     * @brief 按视图顺序提交绘制，需要在渲染系统的BeginFrame和EndFrame之间调用
+     *
+     * 提交结束后当前渲染目标重置为默认帧缓冲。
+     * @param renderSystem 渲染系统
+     */
+    void Submit(RenderSystem& renderSystem);
+
+    /**
+     * @brief 剔除并提交（Cull + Submit）
+     */
+    void Render(RenderSystem& renderSystem, const RenderView* views, uint32_t count);
+
+    /**
+     * @brief 获取视图数量
+     */
+    uint32_t GetViewCount() const { return static_cast<uint32_t>(m_Views.size()); }
+
+    /**
+     * @brief 获取视图中可见物体的索引（按绘制顺序）
+     * @param view 视图索引
+     */
+    const std::vector<uint32_t>& GetVisibleObjects(uint32_t view) const { return m_Views[view].visible; }
+
+    /**
+     * @brief 获取统计
+     */
+    const MultiViewStats& GetStats() const { return m_Stats; }
+
+private:
+    /**
+     * @brief 剔除平面：dot(normal, p) + distance >= 0为内侧
+     */
+    struct Plane {
+        float normal[3];
+        float distance;
+    };
+
+    /**
+     * @brief 排序项：按键排序，键相同时按物体索引，结果与线程调度无关
+     */
+    struct SortItem {
+        uint64_t key;
+        uint32_t object;
+
+        bool operator<(const SortItem& other) const {
+            return key != other.key ? key < other.key : object < other.object;
+        }
+    };
+
+    /**
+     * @brief 一个视图的剔除状态和结果
+     */
+    struct ViewState {
+        RenderView desc;
+        Plane planes[6];
+        float depthAxis[4];                 // 视图空间深度 = dot(depthAxis.xyz, p) + depthAxis.w
+        std::vector<uint8_t> flags;         // 每个物体：0不匹配层掩码，1被剔除，2可见
+        std::vector<float> depths;          // 可见物体的视图空间深度
+        std::vector<SortItem> items;
+        std::vector<uint32_t> visible;
+        uint32_t tested = 0;
+    };
+
+    void CullBlock(ViewState& view, uint32_t begin, uint32_t end) const;
+    void SortView(ViewState& view);
+
+    std::vector<RenderObject> m_Objects;
+    std::vector<float> m_Centers;           // 每个物体3个分量
+    std::vector<float> m_Extents;
+    std::vector<uint32_t> m_Layers;
+    std::vector<uint64_t> m_StateKeys;      // 材质和网格的排序键
+    std::vector<ViewState> m_Views;
+    MultiViewStats m_Stats;
+};
+
+} // namespace PLE
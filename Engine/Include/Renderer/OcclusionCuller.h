@@ -0,0 +1,162 @@
+/**
+ * @file OcclusionCuller.h
+ * @brief 软件层次深度遮挡剔除定义
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Vector.h"
+#include "../Math/Matrix4.h"
+
+namespace PLE {
+
+struct Vertex;
+
+/**
+ * @brief 轴对齐包围盒（世界空间）
+ */
+struct OcclusionBounds {
+    Vector3 min;
+    Vector3 max;
+};
+
+/**
+ * @brief 遮挡剔除配置
+ */
+struct OcclusionCullerConfig {
+    int width = 256;                // 深度缓冲宽度
+    int height = 128;               // 深度缓冲高度
+    uint32_t bandHeight = 16;       // 并行光栅化时每个任务负责的行数
+};
+
+/**
+ * @brief 遮挡剔除统计（每帧重置）
+ */
+struct OcclusionCullerStats {
+    uint32_t occluderTriangles = 0;     // 提交的遮挡体三角形数量
+    uint32_t rasterizedTriangles = 0;   // 近平面裁剪后实际光栅化的三角形数量
+    uint32_t testedObjects = 0;         // 测试的包围盒数量
+    uint32_t occludedObjects = 0;       // 被判定为不可见的包围盒数量
+};
+
+/**
+ * @brief 软件层次深度（Hi-Z）遮挡剔除
+ *
+ * 每帧把选定的遮挡体网格（墙体、建筑等大而简单的几何体）在CPU上光栅化到
+ * 低分辨率深度缓冲（SSE2一次处理4个像素，按行带分给任务系统并行），
+ * 再逐级取2x2中的最远深度构建深度金字塔。测试包围盒时选择投影矩形
+ * 只覆盖少量纹素的层级，包围盒最近深度比这些纹素的最远深度还远即被遮挡。
+ *
+ * 深度约定与Matrix4::Perspective一致：近平面为0、远平面为1。
+ * 与近平面相交或在相机后方的包围盒总是判定为可见；完全在屏幕外或远平面之外的判定为不可见。
+ * 遮挡体按像素中心采样，只覆盖像素一部分的边缘也会写入深度，
+ * 因此亚像素大小的物体可能被误剔除，分辨率应与目标画面的比例相近。
+ *
+ * 用法：
+ * @code
+ * culler.BeginFrame(view * projection);
+ * culler.AddOccluder(wallVertices, wallVertexCount, wallIndices, wallIndexCount, wallTransform);
+ * culler.Finish();
+ * culler.TestVisibility(bounds.data(), count, visible.data());
+ * @endcode
+ */
+class PLE_API OcclusionCuller {
+public:
+    explicit OcclusionCuller(const OcclusionCullerConfig& config = OcclusionCullerConfig());
+    ~OcclusionCuller();
+
+    /**
+     * @brief 开始新的一帧：清空遮挡体和深度缓冲
+     * @param viewProjection 视图投影矩阵（行向量约定）
+     */
+    void BeginFrame(const Matrix4& viewProjection);
+
+    /**
+     * @brief 添加遮挡体网格
+     * @param vertices 顶点数据
+     * @param vertexCount 顶点数量
+     * @param indices 索引数据，为nullptr时按每3个顶点一个三角形
+     * @param indexCount 索引数量
+     * @param transform 模型矩阵
+     */
+    void AddOccluder(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount,
+                     const Matrix4& transform);
+
+    /**
+     * @brief 光栅化所有遮挡体并构建深度金字塔，之后才能进行可见性测试
+     */
+    void Finish();
+
+    /**
+     * @brief 测试单个包围盒是否可能可见（不计入统计）
+     */
+    bool IsVisible(const OcclusionBounds& bounds) const;
+
+    /**
+     * @brief 批量测试包围盒，数量较多时使用任务系统并行
+     * @param bounds 包围盒数组
+     * @param count 包围盒数量
+     * @param visible 输出，1表示可能可见，0表示被遮挡
+     */
+    void TestVisibility(const OcclusionBounds* bounds, uint32_t count, uint8_t* visible);
+
+    /**
+     * @brief 获取深度金字塔层数
+     */
+    uint32_t GetLevelCount() const { return static_cast<uint32_t>(m_Levels.size()); }
+
+    /**
+     * @brief 获取某一层的深度（只读，调试可视化用）
+     * @param level 层级，0为光栅化的原始分辨率
+     * @param width 输出宽度
+     * @param height 输出高度
+     * @param stride 输出每行的元素数量
+     */
+    const float* GetDepth(uint32_t level, int& width, int& height, int& stride) const;
+
+    /**
+     * @brief 获取本帧统计
+     */
+    const OcclusionCullerStats& GetStats() const { return m_Stats; }
+
+private:
+    /**
+     * @brief 完成建立的屏幕空间三角形：边函数和深度平面
+     */
+    struct Triangle {
+        float edgeA[3];
+        float edgeB[3];
+        float edgeC[3];
+        float depthA;
+        float depthB;
+        float depthC;
+        int minX;
+        int minY;
+        int maxX;
+        int maxY;
+    };
+
+    struct Level {
+        int width = 0;
+        int height = 0;
+        int stride = 0;
+        std::vector<float> depth;
+    };
+
+    void SetupTriangle(const Vector4& a, const Vector4& b, const Vector4& c);
+    void RasterizeBand(int beginY, int endY);
+    void BuildHierarchy();
+    bool TestBounds(const OcclusionBounds& bounds) const;
+
+    OcclusionCullerConfig m_Config;
+    Matrix4 m_ViewProjection;
+    std::vector<Triangle> m_Triangles;
+    std::vector<Level> m_Levels;
+    OcclusionCullerStats m_Stats;
+};
+
+} // namespace PLE
@@ -0,0 +1,218 @@
+/**
+ * @file RenderCapture.h
+ * @brief 渲染命令捕获和回放
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "RenderSystem.h"
+
+namespace PLE {
+
+// 前向声明
+class CaptureWriter;
+enum class RenderCaptureOp : uint8_t;
+
+/**
+ * @brief 可捕获的渲染系统
+ *
+ * 包装按配置创建的后端，所有调用原样转发，后端返回的资源对象直接交给调用方。
+ * BeginCapture之后的若干帧内，RenderSystem的调用序列连同被引用资源的内容
+ * （着色器源码、纹理和网格数据、材质参数）一起写入捕获文件，供RenderReplay在
+ * 任意后端上重新执行。
+ *
+ * 为了在捕获开始前创建的资源也能写入文件，包装器保留每个存活资源的创建数据副本，
+ * 会额外占用与网格和纹理数据相当的内存，只应在需要捕获的构建或会话中使用。
+ * 直接在Material上设置的参数在绘制时按版本号检测变化后记录。
+ * 通过CreateShaderFromBinary创建的着色器只记录二进制，只能在相同的后端和驱动上回放。
+ */
+class PLE_API RenderCaptureSystem : public RenderSystem {
+public:
+    /**
+     * @brief 构造函数
+     * @param config 被包装后端的配置
+     */
+    explicit RenderCaptureSystem(const RenderSystemConfig& config = RenderSystemConfig());
+    ~RenderCaptureSystem() override;
+
+    /**
+     * @brief 被包装的后端是否创建成功
+     */
+    bool IsValid() const { return m_Inner != nullptr; }
+
+    /**
+     * @brief 从下一次BeginFrame开始捕获
+     * @param path 捕获文件路径
+     * @param frameCount 捕获的帧数
+     * @return 是否成功打开文件
+     */
+    bool BeginCapture(const std::string& path, uint32_t frameCount = 1);
+
+    /**
+     * @brief 提前结束捕获并写完文件
+     */
+    void EndCapture();
+
+    /**
+     * @brief 是否正在捕获（包括等待下一次BeginFrame）
+     */
+    bool IsCapturing() const { return m_Capturing; }
+
+    bool Initialize(std::shared_ptr<Window> window) override;
+    void Shutdown() override;
+    void BeginFrame() override;
+    void EndFrame() override;
+    void Clear(const Vector4& color, bool depth = true, bool stencil = true) override;
+    void SetViewport(int x, int y, int width, int height) override;
+    std::shared_ptr<Shader> CreateShader(const std::string& vertexShaderSource, const std::string& fragmentShaderSource) override;
+    std::vector<uint8_t> GetShaderBinary(const std::shared_ptr<Shader>& shader) override;
+    std::shared_ptr<Shader> CreateShaderFromBinary(const std::vector<uint8_t>& binary) override;
+    bool AttachWorkerThread() override;
+    void DetachWorkerThread() override;
+    std::shared_ptr<Texture> CreateTexture(int width, int height, const void* data) override;
+    std::shared_ptr<Texture> CreateTexture(const TextureData& data) override;
+    bool IsTextureFormatSupported(TextureFormat format) const override;
+    std::shared_ptr<Mesh> CreateMesh(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) override;
+    std::shared_ptr<Mesh> CreateMesh(const void* vertices, uint32_t vertexCount, const VertexLayout& layout,
+                                     const uint32_t* indices, uint32_t indexCount) override;
+    std::shared_ptr<Mesh> CreateTransientMesh(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) override;
+    std::shared_ptr<Mesh> CreateTransientMesh(const void* vertices, uint32_t vertexCount, const VertexLayout& layout,
+                                              const uint32_t* indices, uint32_t indexCount) override;
+    std::shared_ptr<Material> CreateMaterial(std::shared_ptr<Shader> shader) override;
+    std::shared_ptr<Material> CreateMaterialInstance(std::shared_ptr<Material> parent) override;
+    std::shared_ptr<RenderTarget> CreateRenderTarget(int width, int height) override;
+    void SetRenderTarget(std::shared_ptr<RenderTarget> renderTarget) override;
+    void DrawMesh(std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material, const Matrix4& transform) override;
+    void SetCamera(std::shared_ptr<Camera> camera) override;
+    void SetViewProjection(const Matrix4& view, const Matrix4& projection) override;
+    bool ReadPixels(int x, int y, int width, int height, void* rgba8) override;
+    std::shared_ptr<ReadbackBuffer> CreateReadbackBuffer(int width, int height) override;
+    bool ReadPixelsAsync(int x, int y, const std::shared_ptr<ReadbackBuffer>& buffer) override;
+    uint32_t GetFramesInFlight() const override;
+    RenderAPI GetAPI() const override;
+    std::string GetGPUInfo() const override;
+    std::string GetAPIVersion() const override;
+
+    const RenderStats& GetFrameStats() const override;
+    void ReportCulling(uint32_t submitted, uint32_t culled) override;
+    void BeginStatsPass(const std::string& name) override;
+    void EndStatsPass() override;
+
+private:
+    /**
+     * @brief 存活资源的记录
+     */
+    struct Resource {
+        uint32_t id = 0;
+        std::weak_ptr<void> object;
+        std::vector<uint8_t> creation;      // 完整的创建命令
+        std::vector<const void*> dependencies;  // 创建前必须先写入的资源
+        bool written = false;               // 本次捕获是否已写入
+        uint32_t paramsVersion = 0;         // 已写入的材质参数版本
+        uint64_t blockVersion = 0;          // 已写入的参数块版本
+        bool paramsWritten = false;
+        bool blockWritten = false;
+    };
+
+    void Track(const std::shared_ptr<void>& object, RenderCaptureOp op, CaptureWriter& payload,
+               std::vector<const void*> dependencies = {});
+    uint32_t Reference(const void* object);
+    void RecordMaterialState(Material* material);
+    void Record(RenderCaptureOp op, CaptureWriter& payload);
+    void Record(RenderCaptureOp op);
+    void FinishCapture();
+
+    RenderSystemConfig m_Config;
+    std::unique_ptr<RenderSystem> m_Inner;
+
+    mutable std::mutex m_Mutex;             // 着色器可能在后台线程上创建
+    std::unordered_map<const void*, Resource> m_Resources;
+    uint32_t m_NextId = 1;
+
+    Matrix4 m_View;                         // 最近设置的视图投影，每个捕获帧开始时写入
+    Matrix4 m_Projection;
+    bool m_HasViewProjection = false;
+
+    std::ofstream m_File;
+    std::vector<uint8_t> m_Stream;          // 本帧的命令，帧结束时写入文件
+    bool m_Capturing = false;
+    bool m_Recording = false;               // 当前帧是否在捕获范围内
+    uint32_t m_FramesRemaining = 0;
+    uint32_t m_FramesWritten = 0;
+};
+
+/**
+ * @brief 回放设置
+ */
+struct RenderReplaySettings {
+    uint32_t iterations = 1;        // 重复回放的次数，资源只在第一次创建
+    bool waitForGPU = false;        // 每帧结束后回读一个像素，等待GPU完成，计时包含GPU时间
+};
+
+/**
+ * @brief 一帧回放的结果
+ */
+struct RenderReplayFrame {
+    uint32_t iteration = 0;
+    uint32_t frame = 0;
+    double cpuMilliseconds = 0.0;   // 从BeginFrame到EndFrame（等待GPU时到回读完成）的耗时
+    RenderStats stats;
+};
+
+/**
+ * @brief 捕获文件回放
+ *
+ * 在任意渲染系统上重新执行捕获的命令序列并逐帧计时。
+ * 第一次回放时按捕获中的顺序创建资源，之后的重复回放复用这些资源，
+ * 因此第一轮包含资源创建的开销，基准测试应丢弃它（预热）。
+ */
+class PLE_API RenderReplay {
+public:
+    /**
+     * @brief 加载捕获文件
+     * @param path 文件路径
+     * @return 是否成功
+     */
+    bool Load(const std::string& path);
+
+    /**
+     * @brief 捕获的帧数
+     */
+    uint32_t GetFrameCount() const { return m_FrameCount; }
+
+    /**
+     * @brief 捕获时默认帧缓冲的宽度
+     */
+    int GetWidth() const { return m_Width; }
+
+    /**
+     * @brief 捕获时默认帧缓冲的高度
+     */
+    int GetHeight() const { return m_Height; }
+
+    /**
+     * @brief 回放
+     * @param renderSystem 已初始化的渲染系统
+     * @param settings 回放设置
+     * @param frames 输出每帧的结果
+     * @return 是否完整回放（命令损坏时返回false，已回放的帧仍然输出）
+     */
+    bool Replay(RenderSystem& renderSystem, const RenderReplaySettings& settings, std::vector<RenderReplayFrame>& frames);
+
+private:
+    std::vector<uint8_t> m_Data;
+    uint32_t m_FrameCount = 0;
+    int m_Width = 0;
+    int m_Height = 0;
+};
+
+} // namespace PLE
@@ -0,0 +1,251 @@
+/**
+ * @file RenderGraph.h
+ * @brief 渲染图定义
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+
+namespace PLE {
+
+// 前向声明
+class RenderSystem;
+class RenderTarget;
+class Texture;
+class RenderGraph;
+
+/**
+ * @brief 渲染图资源句柄
+ */
+using RenderGraphResource = uint32_t;
+
+/**
+ * @brief 无效的渲染图资源句柄
+ */
+constexpr RenderGraphResource INVALID_RENDER_GRAPH_RESOURCE = UINT32_MAX;
+
+/**
+ * @brief 瞬态渲染目标描述
+ */
+struct RenderGraphTargetDesc {
+    int width = 0;
+    int height = 0;
+
+    bool operator==(const RenderGraphTargetDesc& other) const {
+        return width == other.width && height == other.height;
+    }
+};
+
+/**
+ * @brief 渲染图统计
+ */
+struct RenderGraphStats {
+    uint32_t passCount = 0;             // 声明的Pass数量
+    uint32_t culledPassCount = 0;       // 被剔除的Pass数量
+    uint32_t transientCount = 0;        // 存活的瞬态资源数量
+    uint32_t physicalTargetCount = 0;   // 别名后实际使用的渲染目标数量
+    uint64_t transientBytes = 0;        // 不做别名时瞬态资源需要的显存估计
+    uint64_t physicalBytes = 0;         // 别名后实际占用的显存估计
+};
+
+/**
+ * @brief Pass声明阶段的资源构建器
+ */
+class PLE_API RenderGraphBuilder {
+public:
+    /**
+     * @brief 创建瞬态渲染目标
+     * @param name 资源名称（用于调试输出）
+     * @param desc 渲染目标描述
+     * @return 资源句柄，本Pass对其写入
+     */
+    RenderGraphResource Create(const std::string& name, const RenderGraphTargetDesc& desc);
+
+    /**
+     * @brief 声明读取资源（作为纹理采样）
+     * @param resource 资源句柄
+     * @return 传入的资源句柄
+     */
+    RenderGraphResource Read(RenderGraphResource resource);
+
+    /**
+     * @brief 声明写入资源（作为渲染目标），每个Pass最多写入一个资源
+     * @param resource 资源句柄
+     * @return 传入的资源句柄
+     */
+    RenderGraphResource Write(RenderGraphResource resource);
+
+    /**
+     * @brief 标记Pass有外部副作用（例如回读像素），此类Pass不会被剔除
+     */
+    void SetSideEffect();
+
+private:
+    friend class RenderGraph;
+    RenderGraphBuilder(RenderGraph& graph, uint32_t passIndex) : m_Graph(graph), m_PassIndex(passIndex) {}
+
+    RenderGraph& m_Graph;
+    uint32_t m_PassIndex;
+};
+
+/**
+ * @brief Pass执行阶段的上下文
+ */
+class PLE_API RenderGraphContext {
+public:
+    /**
+     * @brief 获取渲染系统
+     */
+    RenderSystem& GetRenderSystem() const { return m_RenderSystem; }
+
+    /**
+     * @brief 获取资源对应的渲染目标，默认帧缓冲返回nullptr
+     */
+    std::shared_ptr<RenderTarget> GetRenderTarget(RenderGraphResource resource) const;
+
+    /**
+     * @brief 获取资源的颜色纹理，用于采样之前Pass的输出
+     */
+    std::shared_ptr<Texture> GetTexture(RenderGraphResource resource) const;
+
+private:
+    friend class RenderGraph;
+    RenderGraphContext(const RenderGraph& graph, RenderSystem& renderSystem) : m_Graph(graph), m_RenderSystem(renderSystem) {}
+
+    const RenderGraph& m_Graph;
+    RenderSystem& m_RenderSystem;
+};
+
+/**
+ * @brief 渲染图
+ *
+ * 每帧重新声明Pass：AddPass的setup回调立即执行，声明读写的资源；
+ * Compile从默认帧缓冲、导入资源和有副作用的Pass出发反向引用计数，
+ * 剔除输出没有被使用的Pass，再按存活Pass的顺序计算每个瞬态资源的生命周期，
+ * 让生命周期不重叠且尺寸相同的瞬态资源共用同一个渲染目标。
+ * Execute按声明顺序执行存活的Pass，执行前绑定该Pass写入的渲染目标，
+ * 并以Pass名称计入RenderSystem的每通道统计。
+ *
+ * 实际的渲染目标在多帧之间保留在池中，连续多帧未被使用才释放。
+ * 别名后的渲染目标在第一次写入时内容未定义，写入方需要先Clear。
+ * 布局转换和同步由后端在渲染通道边界处理：写入结束后颜色附件即可采样。
+ */
+class PLE_API RenderGraph {
+public:
+    using SetupFunc = std::function<void(RenderGraphBuilder&)>;
+    using ExecuteFunc = std::function<void(const RenderGraphContext&)>;
+
+    RenderGraph();
+    ~RenderGraph();
+
+    /**
+     * @brief 导入外部渲染目标，写入它的Pass不会被剔除
+     * @param name 资源名称
+     * @param renderTarget 渲染目标，nullptr表示默认帧缓冲
+     * @return 资源句柄
+     */
+    RenderGraphResource ImportRenderTarget(const std::string& name, std::shared_ptr<RenderTarget> renderTarget);
+
+    /**
+     * @brief 获取默认帧缓冲的资源句柄
+     */
+    RenderGraphResource GetBackBuffer();
+
+    /**
+     * @brief 添加Pass
+     * @param name Pass名称
+     * @param setup 声明资源读写的回调，立即执行
+     * @param execute 执行回调，在Execute中调用
+     */
+    void AddPass(const std::string& name, const SetupFunc& setup, ExecuteFunc execute);
+
+    /**
+     * @brief 编译：剔除无用Pass并为瞬态资源分配渲染目标
+     * @return 是否成功（声明错误时返回false）
+     */
+    bool Compile();
+
+    /**
+     * @brief 执行存活的Pass，未编译时会先编译
+     * @param renderSystem 渲染系统
+     */
+    void Execute(RenderSystem& renderSystem);
+
+    /**
+     * @brief 清空本帧声明的Pass和资源，保留渲染目标池
+     */
+    void Reset();
+
+    /**
+     * @brief 释放渲染目标池中的所有渲染目标
+     */
+    void ReleaseTargets();
+
+    /**
+     * @brief 获取最近一次编译的统计
+     */
+    const RenderGraphStats& GetStats() const { return m_Stats; }
+
+    /**
+     * @brief Pass是否被剔除（仅在Compile之后有效）
+     * @param name Pass名称
+     */
+    bool IsPassCulled(const std::string& name) const;
+
+private:
+    friend class RenderGraphBuilder;
+    friend class RenderGraphContext;
+
+    // 池中的渲染目标连续多少次Execute未被使用后释放
+    static constexpr uint32_t RELEASE_AFTER_UNUSED_FRAMES = 8;
+
+    struct Resource {
+        std::string name;
+        RenderGraphTargetDesc desc;
+        bool imported = false;
+        std::shared_ptr<RenderTarget> importedTarget;
+        std::vector<uint32_t> writers;
+        uint32_t refCount = 0;
+        uint32_t firstPass = UINT32_MAX;
+        uint32_t lastPass = 0;
+        uint32_t physical = UINT32_MAX;
+    };
+
+    struct Pass {
+        std::string name;
+        ExecuteFunc execute;
+        std::vector<RenderGraphResource> reads;
+        RenderGraphResource write = INVALID_RENDER_GRAPH_RESOURCE;
+        bool sideEffect = false;
+        bool culled = false;
+        uint32_t refCount = 0;
+    };
+
+    struct PhysicalTarget {
+        RenderGraphTargetDesc desc;
+        std::shared_ptr<RenderTarget> target;
+        uint32_t availableAfter = 0;    // 本帧最后使用它的Pass序号加一
+        bool used = false;
+        uint32_t unusedFrames = 0;
+    };
+
+    bool IsValid(RenderGraphResource resource) const { return resource < m_Resources.size(); }
+    std::shared_ptr<RenderTarget> ResolveTarget(RenderGraphResource resource) const;
+
+    std::vector<Resource> m_Resources;
+    std::vector<Pass> m_Passes;
+    std::vector<PhysicalTarget> m_Physical;
+    RenderGraphResource m_BackBuffer = INVALID_RENDER_GRAPH_RESOURCE;
+    bool m_Compiled = false;
+    bool m_Valid = true;
+    RenderGraphStats m_Stats;
+};
+
+} // namespace PLE
@@ -0,0 +1,482 @@
+/**
+ * @file RenderResources.h
+ * @brief 渲染资源接口定义
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Vector.h"
+#include "../Math/Matrix4.h"
+
+namespace PLE {
+
+/**
+ * @brief 标准顶点格式
+ *
+ * RenderSystem::CreateMesh的顶点数据按此布局解释。
+ * 着色器中的属性位置：0 = position，1 = normal，2 = texCoord。
+ */
+struct Vertex {
+    Vector3 position;
+    Vector3 normal;
+    Vector2 texCoord;
+};
+
+/**
+ * @brief 顶点属性格式
+ *
+ * 归一化格式在着色器中读到的是浮点数：Unorm映射到[0, 1]，Snorm映射到[-1, 1]。
+ */
+enum class VertexAttributeFormat {
+    Float2 = 0,
+    Float3,
+    Float4,
+    Half2,          // 16位浮点
+    Half4,
+    Unorm16x4,
+    Snorm16x2,
+    Snorm16x4,
+    Unorm8x4,
+    Snorm8x4
+};
+
+/**
+ * @brief 图元类型
+ */
+enum class PrimitiveTopology {
+    Triangles = 0,  // 三角形列表
+    Lines           // 线段列表，每两个顶点（或索引）一条线段
+};
+
+/**
+ * @brief 顶点属性
+ */
+struct VertexAttribute {
+    uint32_t location;              // 着色器中的属性位置
+    VertexAttributeFormat format;
+    uint32_t offset;                // 在顶点内的字节偏移
+};
+
+/**
+ * @brief 顶点布局描述
+ *
+ * 所有属性来自同一个交错的顶点缓冲，图元类型与顶点格式一起决定管线状态。位置经过量化时，渲染系统在绘制前把
+ * 解码变换（position = positionOffset + attribute * positionScale）合并到模型矩阵，
+ * 着色器不需要区分量化和未量化的位置。缩放在三个轴上相同，法线变换不受影响。
+ */
+struct VertexLayout {
+    std::vector<VertexAttribute> attributes;
+    uint32_t stride = 0;
+    PrimitiveTopology topology = PrimitiveTopology::Triangles;
+    Vector3 positionOffset = Vector3(0.0f, 0.0f, 0.0f);
+    float positionScale = 1.0f;
+
+    /**
+     * @brief 标准Vertex结构的布局
+     */
+    static const VertexLayout& Standard();
+
+    /**
+     * @brief 获取格式的字节数
+     */
+    static uint32_t GetFormatSize(VertexAttributeFormat format);
+
+    /**
+     * @brief 属性、步长和图元类型的哈希，解码参数不参与（不影响管线状态）
+     */
+    uint64_t GetFormatHash() const;
+
+    /**
+     * @brief 位置是否需要解码
+     */
+    bool HasPositionDecode() const;
+
+    /**
+     * @brief 获取位置解码矩阵（行向量约定，在模型矩阵之前应用）
+     */
+    Matrix4 GetPositionDecodeMatrix() const;
+
+    /**
+     * @brief 检查属性是否都在步长之内且位置不重复
+     */
+    bool IsValid() const;
+};
+
+/**
+ * @brief 材质参数类型
+ */
+enum class MaterialParameterType {
+    Float = 0,
+    Vector4,
+    Matrix4,
+    Texture
+};
+
+/**
+ * @brief 材质参数块成员
+ */
+struct MaterialBlockMember {
+    std::string name;
+    MaterialParameterType type = MaterialParameterType::Float;
+    uint32_t offset = 0;
+};
+
+/**
+ * @brief 材质参数块布局，由后端反射着色器中的PLE_Material块得到
+ */
+struct MaterialBlockLayout {
+    std::vector<MaterialBlockMember> members;
+    uint32_t size = 0;      // 块大小（字节），0表示着色器没有材质块
+
+    /**
+     * @brief 按名称查找成员，不存在时返回-1
+     */
+    int Find(const std::string& name) const;
+};
+
+/**
+ * @brief 着色器接口
+ *
+ * 引擎在uniform块PLE_PerDraw（绑定点0）中提供每次绘制的数据：
+ * mat4 u_Model、mat4 u_ViewProjection、mat4 u_ModelViewProjection。
+ * 矩阵按行优先上传，在GLSL中以 matrix * vector 的形式使用。
+ * 材质参数可以声明在std140的uniform块PLE_Material中（OpenGL绑定点1，
+ * Vulkan的set 1、binding 0），块中的float、vec4、mat4成员通过反射映射到材质参数。
+ */
+class PLE_API Shader {
+public:
+    virtual ~Shader() = default;
+
+    /**
+     * @brief 着色器是否编译链接成功
+     */
+    virtual bool IsValid() const = 0;
+
+    /**
+     * @brief 获取材质参数块布局
+     */
+    const MaterialBlockLayout& GetMaterialLayout() const { return m_MaterialLayout; }
+
+protected:
+    MaterialBlockLayout m_MaterialLayout;
+};
+
+/**
+ * @brief 纹理像素格式
+ *
+ * 块压缩格式以4x4像素为一块，尺寸不是4的倍数时最后一列/行的块只使用其中一部分。
+ */
+enum class TextureFormat {
+    RGBA8 = 0,
+    BC1,        // RGB加1位透明，每块8字节
+    BC3,        // RGBA，每块16字节
+    BC5,        // 两个通道（法线贴图的XY），每块16字节
+    BC7         // 高质量RGBA，每块16字节
+};
+
+/**
+ * @brief 纹理的一级Mip在TextureData::pixels中的位置
+ */
+struct TextureMipLevel {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    size_t offset = 0;
+    size_t size = 0;
+};
+
+/**
+ * @brief 预处理好的纹理数据：所有Mip级别按从大到小的顺序连续存放，行从上到下
+ */
+struct TextureData {
+    TextureFormat format = TextureFormat::RGBA8;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<TextureMipLevel> mips;
+    std::vector<uint8_t> pixels;
+
+    /**
+     * @brief 是否为块压缩格式
+     */
+    static bool IsCompressed(TextureFormat format) { return format != TextureFormat::RGBA8; }
+
+    /**
+     * @brief 一级Mip的字节数
+     */
+    static size_t GetLevelSize(TextureFormat format, uint32_t width, uint32_t height);
+
+    /**
+     * @brief 检查Mip链的尺寸、偏移和大小是否一致
+     */
+    bool IsValid() const;
+};
+
+/**
+ * @brief 纹理接口
+ */
+class PLE_API Texture {
+public:
+    Texture(int width, int height, TextureFormat format = TextureFormat::RGBA8)
+        : m_Width(width), m_Height(height), m_Format(format) {}
+    virtual ~Texture() = default;
+
+    /**
+     * @brief 获取纹理宽度
+     */
+    int GetWidth() const { return m_Width; }
+
+    /**
+     * @brief 获取纹理高度
+     */
+    int GetHeight() const { return m_Height; }
+
+    /**
+     * @brief 获取像素格式
+     */
+    TextureFormat GetFormat() const { return m_Format; }
+
+protected:
+    int m_Width;
+    int m_Height;
+    TextureFormat m_Format;
+};
+
+/**
+ * @brief 网格接口
+ */
+class PLE_API Mesh {
+public:
+    Mesh(uint32_t vertexCount, uint32_t indexCount, const VertexLayout& layout = VertexLayout::Standard())
+        : m_VertexCount(vertexCount), m_IndexCount(indexCount), m_VertexLayout(layout) {}
+    virtual ~Mesh() = default;
+
+    /**
+     * @brief 获取顶点数量
+     */
+    uint32_t GetVertexCount() const { return m_VertexCount; }
+
+    /**
+     * @brief 获取索引数量，0表示非索引绘制
+     */
+    uint32_t GetIndexCount() const { return m_IndexCount; }
+
+    /**
+     * @brief 获取顶点布局
+     */
+    const VertexLayout& GetVertexLayout() const { return m_VertexLayout; }
+
+    /**
+     * @brief 绘制一次的三角形数量，线段网格为0
+     */
+    uint32_t GetTriangleCount() const {
+        return m_VertexLayout.topology == PrimitiveTopology::Triangles ? (m_IndexCount > 0 ? m_IndexCount : m_VertexCount) / 3 : 0;
+    }
+
+    /**
+     * @brief 把位置解码合并到模型矩阵
+     */
+    Matrix4 GetModelMatrix(const Matrix4& transform) const {
+        return m_VertexLayout.HasPositionDecode() ? m_VertexLayout.GetPositionDecodeMatrix() * transform : transform;
+    }
+
+protected:
+    uint32_t m_VertexCount;
+    uint32_t m_IndexCount;
+    VertexLayout m_VertexLayout;
+};
+
+/**
+ * @brief 材质参数
+ */
+struct MaterialParameter {
+    std::string name;
+    MaterialParameterType type = MaterialParameterType::Float;
+    std::array<float, 16> value = {};
+    std::shared_ptr<Texture> texture;
+};
+
+/**
+ * @brief 材质
+ *
+ * 保存着色器和具名参数。着色器PLE_Material块中的参数按反射得到的std140布局
+ * 打包在参数块中，修改时记录脏区间，后端只上传变化的部分；
+ * 其余参数（纹理和块外的uniform）保存在参数列表中，每次修改都会递增版本号。
+ *
+ * 材质实例在覆盖任何块参数之前直接使用父材质的参数块（后端共享同一个GPU缓冲），
+ * 第一次覆盖时复制一份，之后父材质的修改只合并到未被覆盖的成员。
+ * 纹理和块外参数在创建实例时从父材质复制。
+ */
+class PLE_API Material {
+public:
+    /**
+     * @brief 构造函数
+     * @param shader 着色器指针
+     * @param parent 父材质，非空时创建材质实例（着色器须与父材质相同）
+     */
+    explicit Material(std::shared_ptr<Shader> shader, std::shared_ptr<Material> parent = nullptr);
+    virtual ~Material() = default;
+
+    /**
+     * @brief 获取着色器
+     */
+    std::shared_ptr<Shader> GetShader() const { return m_Shader; }
+
+    /**
+     * @brief 获取父材质，非实例时为nullptr
+     */
+    std::shared_ptr<Material> GetParent() const { return m_Parent; }
+
+    /**
+     * @brief 设置浮点参数
+     */
+    void SetFloat(const std::string& name, float value);
+
+    /**
+     * @brief 设置四维向量参数
+     */
+    void SetVector4(const std::string& name, const Vector4& value);
+
+    /**
+     * @brief 设置矩阵参数
+     */
+    void SetMatrix4(const std::string& name, const Matrix4& value);
+
+    /**
+     * @brief 设置纹理参数
+     */
+    void SetTexture(const std::string& name, std::shared_ptr<Texture> texture);
+
+    /**
+     * @brief 获取参数块之外的参数
+     */
+    const std::vector<MaterialParameter>& GetParameters() const { return m_Parameters; }
+
+    /**
+     * @brief 获取参数版本号（不包括参数块）
+     */
+    uint32_t GetVersion() const { return m_Version; }
+
+    /**
+     * @brief 获取实际使用的参数块所属的材质
+     *
+     * 未覆盖块参数的实例返回父材质（递归）；拥有自己参数块的实例
+     * 会先合并父材质的修改。只应在渲染线程上调用。
+     */
+    Material* ResolveBlock();
+
+    /**
+     * @brief 获取参数块数据，只对ResolveBlock返回的材质有意义
+     */
+    const std::vector<uint8_t>& GetBlockData() const { return m_Block; }
+
+    /**
+     * @brief 获取参数块版本，全局唯一，参数块每次变化都会更新
+     */
+    uint64_t GetBlockVersion() const { return m_BlockVersion; }
+
+    /**
+     * @brief 取出并清空自上次调用以来的脏区间
+     * @param begin 输出起始偏移
+     * @param end 输出结束偏移（不含）
+     * @return 是否有脏数据
+     */
+    bool TakeDirtyRange(uint32_t& begin, uint32_t& end);
+
+protected:
+    MaterialParameter& FindOrAddParameter(const std::string& name, MaterialParameterType type);
+    bool WriteBlock(const std::string& name, MaterialParameterType type, const float* value, uint32_t size);
+    void MarkDirty(uint32_t begin, uint32_t end);
+
+    std::shared_ptr<Shader> m_Shader;
+    std::shared_ptr<Material> m_Parent;
+    std::vector<MaterialParameter> m_Parameters;
+    uint32_t m_Version = 0;
+
+    std::vector<uint8_t> m_Block;
+    std::vector<bool> m_Overridden;         // 实例覆盖了哪些块成员
+    bool m_OwnsBlock = true;
+    uint64_t m_BlockVersion = 0;
+    uint64_t m_ParentBlockVersion = 0;      // 最近一次合并时父参数块的版本
+    uint32_t m_DirtyBegin = 0;
+    uint32_t m_DirtyEnd = 0;
+};
+
+/**
+ * @brief 渲染目标接口
+ */
+class PLE_API RenderTarget {
+public:
+    RenderTarget(int width, int height) : m_Width(width), m_Height(height) {}
+    virtual ~RenderTarget() = default;
+
+    /**
+     * @brief 获取宽度
+     */
+    int GetWidth() const { return m_Width; }
+
+    /**
+     * @brief 获取高度
+     */
+    int GetHeight() const { return m_Height; }
+
+    /**
+     * @brief 获取颜色附件纹理，可作为后续绘制的输入
+     */
+    virtual std::shared_ptr<Texture> GetColorTexture() const = 0;
+
+protected:
+    int m_Width;
+    int m_Height;
+};
+
+/**
+ * @brief 像素读回缓冲区接口
+ *
+ * RenderSystem::ReadPixelsAsync把渲染目标的一块区域复制到缓冲区后立即返回，
+ * 复制排在此前提交的绘制之后由GPU完成。缓冲区在创建时持久映射，
+ * 完成后像素直接从映射的内存读取，可以交给其他线程编码而不必在渲染线程上复制；
+ * 下一次ReadPixelsAsync之前内容保持不变。
+ */
+class PLE_API ReadbackBuffer {
+public:
+    ReadbackBuffer(int width, int height) : m_Width(width), m_Height(height) {}
+    virtual ~ReadbackBuffer() = default;
+
+    /**
+     * @brief 获取宽度
+     */
+    int GetWidth() const { return m_Width; }
+
+    /**
+     * @brief 获取高度
+     */
+    int GetHeight() const { return m_Height; }
+
+    /**
+     * @brief 最近一次读取是否已经完成，不阻塞（OpenGL后端只能在渲染线程调用）
+     */
+    virtual bool IsReady() = 0;
+
+    /**
+     * @brief 阻塞等待最近一次读取完成（OpenGL后端只能在渲染线程调用）
+     * @return 是否完成，没有发出过读取或读取所在的帧没有提交时返回false
+     */
+    virtual bool Wait() = 0;
+
+    /**
+     * @brief 获取一行像素（RGBA8），行号与ReadPixels相同，0为最下面一行；IsReady返回true之后可以在任意线程读取
+     */
+    virtual const uint8_t* GetRow(int row) const = 0;
+
+protected:
+    int m_Width;
+    int m_Height;
+};
+
+} // namespace PLE
@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -22,7 +25,11 @@ class Texture;
 class Mesh;
 class Material;
 class RenderTarget;
+class ReadbackBuffer;
 class Camera;
+struct VertexLayout;
+struct TextureData;
+enum class TextureFormat;
 
 /**
  * @brief 渲染API类型
@@ -45,6 +52,41 @@ struct RenderSystemConfig {
     bool enableMSAA = true;
     int msaaSamples = 4;
     bool enableDebugMode = false;
+    int width = 1280;                   // 无窗口（离屏）渲染时默认帧缓冲的宽度
+    int height = 720;                   // 无窗口（离屏）渲染时默认帧缓冲的高度
+    std::string pipelineCachePath = "PipelineCache.bin";  // 管线缓存文件（Vulkan），为空时不持久化
+};
+
+/**
+ * @brief 一个渲染通道的统计
+ */
+struct RenderPassStats {
+    std::string name;
+    double cpuMilliseconds = 0.0;   // 通道回调在CPU上的耗时（Vulkan的命令录制在EndFrame中统一进行，不计入）
+    uint32_t drawCalls = 0;
+    uint64_t triangles = 0;
+};
+
+/**
+ * @brief 一帧的渲染统计
+ *
+ * 计数从上一次EndFrame之后开始累计，包括帧之间创建资源产生的上传。
+ * 绑定次数只统计实际发生的切换（状态缓存或命令录制去除的重复绑定不计入）。
+ */
+struct RenderStats {
+    uint64_t frame = 0;             // 帧序号，从1开始
+    uint32_t drawCalls = 0;
+    uint32_t instances = 0;         // 绘制的实例总数
+    uint64_t triangles = 0;
+    uint32_t shaderBinds = 0;       // 着色器程序（管线）切换次数
+    uint32_t materialBinds = 0;     // 相邻绘制之间材质的切换次数
+    uint32_t textureBinds = 0;      // 纹理绑定次数
+    uint32_t stateChanges = 0;      // 提交给驱动的状态切换总数（OpenGL）
+    uint32_t objectsSubmitted = 0;  // 通过ReportCulling报告的参与剔除的物体数量
+    uint32_t objectsCulled = 0;     // 其中被剔除的数量
+    uint64_t uploadBytes = 0;       // CPU写给GPU的字节数（每次绘制的uniform、材质参数、瞬态几何、纹理和网格）
+    double frameCpuMilliseconds = 0.0;  // BeginFrame到EndFrame结束的CPU耗时
+    std::vector<RenderPassStats> passes;
 };
 
 /**
@@ -63,7 +105,7 @@ public:
 
     /**
      * @brief 初始化渲染系统
-     * @param window 窗口指针
+     * @param window 窗口指针，为nullptr时创建离屏默认帧缓冲（无窗口运行）
      * @return 是否成功初始化
      */
     virtual bool Initialize(std::shared_ptr<Window> window) = 0;
@@ -108,6 +150,33 @@ public:
      */
     virtual std::shared_ptr<Shader> CreateShader(const std::string& vertexShaderSource, const std::string& fragmentShaderSource) = 0;
 
+    /**
+     * @brief 获取着色器的二进制表示，用于磁盘缓存
+     * @param shader 着色器指针
+     * @return 二进制数据，后端或驱动不支持时为空
+     */
+    virtual std::vector<uint8_t> GetShaderBinary(const std::shared_ptr<Shader>& shader) = 0;
+
+    /**
+     * @brief 从GetShaderBinary的结果创建着色器
+     * @param binary 二进制数据
+     * @return 着色器指针，驱动不再接受该数据（例如驱动更新后）时返回nullptr
+     */
+    virtual std::shared_ptr<Shader> CreateShaderFromBinary(const std::vector<uint8_t>& binary) = 0;
+
+    /**
+     * @brief 允许调用线程创建着色器，用于后台编译
+     *
+     * 成功后该线程可以调用CreateShader和CreateShaderFromBinary，线程结束前需调用DetachWorkerThread。
+     * @return 后端是否支持在渲染线程以外创建着色器
+     */
+    virtual bool AttachWorkerThread() = 0;
+
+    /**
+     * @brief 撤销AttachWorkerThread
+     */
+    virtual void DetachWorkerThread() = 0;
+
     /**
      * @brief 创建纹理
      * @param width 纹理宽度
@@ -117,6 +186,18 @@ public:
      */
     virtual std::shared_ptr<Texture> CreateTexture(int width, int height, const void* data) = 0;
 
+    /**
+     * @brief 从预处理好的数据创建纹理（包括完整的Mip链和块压缩格式）
+     * @param data 纹理数据
+     * @return 纹理指针，数据无效时返回nullptr；格式不受支持时在CPU上解码为RGBA8
+     */
+    virtual std::shared_ptr<Texture> CreateTexture(const TextureData& data) = 0;
+
+    /**
+     * @brief 后端是否支持该纹理格式
+     */
+    virtual bool IsTextureFormatSupported(TextureFormat format) const = 0;
+
     /**
      * @brief 创建网格
      * @param vertices 顶点数据
@@ -125,6 +206,43 @@ public:
      */
     virtual std::shared_ptr<Mesh> CreateMesh(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) = 0;
 
+    /**
+     * @brief 按指定顶点布局创建网格（例如量化顶点）
+     * @param vertices 顶点数据，每个顶点layout.stride字节
+     * @param vertexCount 顶点数量
+     * @param layout 顶点布局
+     * @param indices 索引数据，可为nullptr
+     * @param indexCount 索引数量
+     * @return 网格指针，布局无效时返回nullptr
+     */
+    virtual std::shared_ptr<Mesh> CreateMesh(const void* vertices, uint32_t vertexCount, const VertexLayout& layout,
+                                             const uint32_t* indices, uint32_t indexCount) = 0;
+
+    /**
+     * @brief 创建瞬态网格
+     *
+     * 数据直接写入每帧的上传环形缓冲区，不分配新的GPU缓冲，
+     * 适合每帧都会变化的几何体（粒子、UI、调试线框等）。只在当前帧内有效。
+     * @param vertices 顶点数据（Vertex数组）
+     * @param vertexCount 顶点数量
+     * @param indices 索引数据，可为nullptr
+     * @param indexCount 索引数量
+     * @return 网格指针，本帧的上传区域耗尽时返回nullptr
+     */
+    virtual std::shared_ptr<Mesh> CreateTransientMesh(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) = 0;
+
+    /**
+     * @brief 按指定顶点布局创建瞬态网格（例如精灵使用的紧凑顶点）
+     * @param vertices 顶点数据，每个顶点layout.stride字节
+     * @param vertexCount 顶点数量
+     * @param layout 顶点布局
+     * @param indices 索引数据，可为nullptr
+     * @param indexCount 索引数量
+     * @return 网格指针，布局无效或本帧的上传区域耗尽时返回nullptr
+     */
+    virtual std::shared_ptr<Mesh> CreateTransientMesh(const void* vertices, uint32_t vertexCount, const VertexLayout& layout,
+                                                      const uint32_t* indices, uint32_t indexCount) = 0;
+
     /**
      * @brief 创建材质
      * @param shader 着色器指针
@@ -132,6 +250,15 @@ public:
      */
     virtual std::shared_ptr<Material> CreateMaterial(std::shared_ptr<Shader> shader) = 0;
 
+    /**
+     * @brief 创建材质实例
+     *
+     * 实例在覆盖参数块中的参数之前共享父材质的参数块和GPU缓冲。
+     * @param parent 父材质
+     * @return 材质指针
+     */
+    virtual std::shared_ptr<Material> CreateMaterialInstance(std::shared_ptr<Material> parent) = 0;
+
     /**
      * @brief 创建渲染目标
      * @param width 宽度
@@ -160,6 +287,49 @@ public:
      */
     virtual void SetCamera(std::shared_ptr<Camera> camera) = 0;
 
+    /**
+     * @brief 直接设置视图和投影矩阵（不依赖相机组件）
+     * @param view 视图矩阵
+     * @param projection 投影矩阵
+     */
+    virtual void SetViewProjection(const Matrix4& view, const Matrix4& projection) = 0;
+
+    /**
+     * @brief 同步读取当前渲染目标的像素
+     * @param x 区域左下角X坐标
+     * @param y 区域左下角Y坐标
+     * @param width 区域宽度
+     * @param height 区域高度
+     * @param rgba8 输出缓冲区，大小至少为width * height * 4字节，行从下到上排列
+     * @return 是否成功读取
+     */
+    virtual bool ReadPixels(int x, int y, int width, int height, void* rgba8) = 0;
+
+    /**
+     * @brief 创建像素读回缓冲区，可以反复用于ReadPixelsAsync
+     * @param width 宽度
+     * @param height 高度
+     * @return 读回缓冲区指针，失败时返回nullptr
+     */
+    virtual std::shared_ptr<ReadbackBuffer> CreateReadbackBuffer(int width, int height) = 0;
+
+    /**
+     * @brief 异步读取当前渲染目标的像素，不等待GPU
+     *
+     * 区域大小与缓冲区相同。帧内调用时复制随本帧提交，完成情况用ReadbackBuffer::IsReady查询。
+     * 缓冲区原有的内容随之失效，调用者需要保证此时没有其他线程还在读取它。
+     * @param x 区域左下角X坐标
+     * @param y 区域左下角Y坐标
+     * @param buffer 读回缓冲区
+     * @return 是否成功发出读取
+     */
+    virtual bool ReadPixelsAsync(int x, int y, const std::shared_ptr<ReadbackBuffer>& buffer) = 0;
+
+    /**
+     * @brief 获取同时在途的帧数，CPU写入的资源至少要隔这么多帧才能安全复用
+     */
+    virtual uint32_t GetFramesInFlight() const = 0;
+
     /**
      * @brief 获取当前渲染API
      * @return 渲染API类型
@@ -177,6 +347,77 @@ public:
      * @return API版本信息字符串
      */
     virtual std::string GetAPIVersion() const = 0;
+
+    /**
+     * @brief 获取上一个完整帧的统计
+     */
+    virtual const RenderStats& GetFrameStats() const { return m_FrameStats; }
+
+    /**
+     * @brief 报告剔除结果，计入本帧统计，可以在多个线程上同时调用
+     * @param submitted 参与剔除的物体数量
+     * @param culled 其中被剔除的数量
+     */
+    virtual void ReportCulling(uint32_t submitted, uint32_t culled) {
+        m_ObjectsSubmitted.fetch_add(submitted, std::memory_order_relaxed);
+        m_ObjectsCulled.fetch_add(culled, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 开始统计一个渲染通道（RenderGraph在执行每个Pass时自动调用），不支持嵌套
+     * @param name 通道名称
+     */
+    virtual void BeginStatsPass(const std::string& name);
+
+    /**
+     * @brief 结束当前渲染通道的统计
+     */
+    virtual void EndStatsPass();
+
+protected:
+    /**
+     * @brief 记录一次绘制，由后端在渲染线程上调用
+     * @param material 材质，用于统计材质切换
+     * @param triangleCount 每个实例的三角形数量（Mesh::GetTriangleCount）
+     * @param instanceCount 实例数量
+     */
+    void CountDraw(const Material* material, uint32_t triangleCount, uint32_t instanceCount = 1) {
+        ++m_Stats.drawCalls;
+        m_Stats.instances += instanceCount;
+        m_Stats.triangles += static_cast<uint64_t>(triangleCount) * instanceCount;
+        if (material != m_LastMaterial) {
+            ++m_Stats.materialBinds;
+            m_LastMaterial = material;
+        }
+    }
+
+    /**
+     * @brief 记录CPU写给GPU的数据量
+     */
+    void CountUpload(uint64_t bytes) { m_Stats.uploadBytes += bytes; }
+
+    /**
+     * @brief 在BeginFrame开始时调用
+     */
+    void BeginFrameStats();
+
+    /**
+     * @brief 在EndFrame结束时调用：本帧统计成为GetFrameStats的结果，开始累计下一帧
+     */
+    void EndFrameStats();
+
+    RenderStats m_Stats;            // 正在累计的统计
+    RenderStats m_FrameStats;       // 上一个完整帧的统计
+    const Material* m_LastMaterial = nullptr;
+
+private:
+    std::atomic<uint32_t> m_ObjectsSubmitted{ 0 };
+    std::atomic<uint32_t> m_ObjectsCulled{ 0 };
+    std::chrono::steady_clock::time_point m_FrameStart;
+    std::chrono::steady_clock::time_point m_PassStart;
+    uint32_t m_PassDrawCalls = 0;
+    uint64_t m_PassTriangles = 0;
+    bool m_PassActive = false;
 };
 
 } // namespace PLE
\ No newline at end of file
@@ -0,0 +1,94 @@
+/**
+ * @file RenderTargetPool.h
+ * @brief 渲染目标池定义
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+
+namespace PLE {
+
+// 前向声明
+class RenderSystem;
+class RenderTarget;
+
+/**
+ * @brief 渲染目标池
+ *
+ * 按尺寸缓存渲染目标，供后处理等每帧都要申请临时目标的代码复用，
+ * 避免每帧创建和销毁GPU资源。Acquire得到的目标在本帧内独占，
+ * 可以用Release提前归还，其余的在NextFrame时统一归还。
+ * 同一队列上的GPU命令按提交顺序执行，归还的目标可以立即被后续绘制复用；
+ * 空闲的目标至少保留GetFramesInFlight帧（默认8帧）才销毁，
+ * 不会在GPU仍可能引用它时释放，也避免尺寸来回变化时反复创建。
+ */
+class PLE_API RenderTargetPool {
+public:
+    /**
+     * @brief 构造函数
+     * @param renderSystem 用于创建渲染目标的渲染系统
+     * @param releaseAfterFrames 空闲目标保留的帧数，不少于渲染系统的在途帧数
+     */
+    explicit RenderTargetPool(RenderSystem& renderSystem, uint32_t releaseAfterFrames = 8);
+    ~RenderTargetPool();
+
+    /**
+     * @brief 获取一个指定尺寸的临时渲染目标，内容未定义
+     * @param width 宽度
+     * @param height 高度
+     * @return 渲染目标指针，创建失败时返回nullptr
+     */
+    std::shared_ptr<RenderTarget> Acquire(int width, int height);
+
+    /**
+     * @brief 提前归还渲染目标，同一帧内的后续Acquire可以复用它
+     * @param renderTarget 由Acquire获得的渲染目标
+     */
+    void Release(const std::shared_ptr<RenderTarget>& renderTarget);
+
+    /**
+     * @brief 进入下一帧：归还本帧所有目标，并销毁长时间空闲的目标
+     */
+    void NextFrame();
+
+    /**
+     * @brief 销毁池中的所有渲染目标
+     */
+    void Clear();
+
+    /**
+     * @brief 获取池中渲染目标的总数
+     */
+    uint32_t GetTargetCount() const { return static_cast<uint32_t>(m_Entries.size()); }
+
+    /**
+     * @brief 获取当前被占用的渲染目标数量
+     */
+    uint32_t GetInUseCount() const;
+
+    /**
+     * @brief 获取池中渲染目标占用显存的估计值（字节）
+     */
+    uint64_t GetMemoryBytes() const;
+
+private:
+    struct Entry {
+        std::shared_ptr<RenderTarget> target;
+        int width = 0;
+        int height = 0;
+        bool inUse = false;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    RenderSystem& m_RenderSystem;
+    uint32_t m_ReleaseAfterFrames;
+    uint64_t m_Frame = 0;
+    std::vector<Entry> m_Entries;
+};
+
+} // namespace PLE
@@ -0,0 +1,206 @@
+/**
+ * @file ShaderLibrary.h
+ * @brief 着色器变体库定义
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+
+namespace PLE {
+
+// 前向声明
+class RenderSystem;
+class Shader;
+
+/**
+ * @brief 着色器变体键：源码和宏定义的64位哈希
+ */
+using ShaderVariantKey = uint64_t;
+
+/**
+ * @brief 着色器宏定义（名称 -> 值），按名称排序保证键稳定
+ */
+using ShaderDefines = std::map<std::string, std::string>;
+
+/**
+ * @brief 着色器变体描述
+ */
+struct ShaderVariantDesc {
+    std::string vertexSource;
+    std::string fragmentSource;
+    ShaderDefines defines;      // 插入到#version行之后；SPIR-V源码不支持宏定义
+};
+
+/**
+ * @brief 着色器库配置
+ */
+struct ShaderLibraryConfig {
+    std::string cacheDirectory = "ShaderCache";    // 磁盘缓存目录，为空时不使用磁盘缓存
+    uint32_t workerCount = 2;                      // 后台编译线程数，0表示只在Update中编译
+};
+
+/**
+ * @brief 着色器库统计
+ */
+struct ShaderLibraryStats {
+    uint64_t requests = 0;          // Request调用次数
+    uint64_t deduplicated = 0;      // 命中已有变体（包括仍在编译的）的次数
+    uint64_t diskHits = 0;          // 从磁盘缓存加载的变体数量
+    uint64_t compiled = 0;          // 从源码编译的变体数量
+    uint64_t failed = 0;            // 编译失败的变体数量
+};
+
+/**
+ * @brief 着色器变体：可能仍在后台编译
+ */
+class PLE_API ShaderVariant {
+public:
+    explicit ShaderVariant(ShaderVariantKey key) : m_Key(key) {}
+
+    /**
+     * @brief 获取变体键
+     */
+    ShaderVariantKey GetKey() const { return m_Key; }
+
+    /**
+     * @brief 是否已处理完毕（成功或失败）
+     */
+    bool IsReady() const { return m_Ready.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 是否编译失败
+     */
+    bool IsFailed() const { return IsReady() && !m_Shader; }
+
+    /**
+     * @brief 获取着色器，未就绪或失败时返回nullptr
+     */
+    std::shared_ptr<Shader> GetShader() const { return IsReady() ? m_Shader : nullptr; }
+
+    /**
+     * @brief 阻塞等待处理完毕
+     */
+    void Wait() const;
+
+private:
+    friend class ShaderLibrary;
+
+    void Complete(std::shared_ptr<Shader> shader);
+
+    ShaderVariantKey m_Key;
+    std::shared_ptr<Shader> m_Shader;
+    std::atomic<bool> m_Ready{ false };
+    mutable std::mutex m_Mutex;
+    mutable std::condition_variable m_Condition;
+};
+
+/**
+ * @brief 着色器变体库
+ *
+ * 把源码和宏定义哈希为变体键，相同的请求只编译一次。
+ * Request立即返回变体句柄，编译在后台线程进行（渲染系统通过AttachWorkerThread
+ * 允许这些线程创建着色器）；后端不支持时排队到渲染线程的Update中逐帧编译。
+ * 编译结果的二进制（OpenGL程序二进制、Vulkan的SPIR-V）按变体键写入磁盘缓存，
+ * 文件头记录渲染API和设备信息的哈希，驱动或设备变化后自动重新编译。
+ */
+class PLE_API ShaderLibrary {
+public:
+    /**
+     * @brief 构造函数
+     * @param renderSystem 已初始化的渲染系统，生命周期必须长于着色器库
+     * @param config 配置
+     */
+    explicit ShaderLibrary(RenderSystem& renderSystem, const ShaderLibraryConfig& config = ShaderLibraryConfig());
+    ~ShaderLibrary();
+
+    /**
+     * @brief 启动后台编译线程
+     * @return 是否成功（后端不支持后台编译时仍返回true，退回到Update中编译）
+     */
+    bool Initialize();
+
+    /**
+     * @brief 停止后台线程，未开始的请求标记为失败
+     */
+    void Shutdown();
+
+    /**
+     * @brief 计算变体键
+     */
+    static ShaderVariantKey ComputeKey(const ShaderVariantDesc& desc);
+
+    /**
+     * @brief 把宏定义插入到源码的#version行之后
+     */
+    static std::string ApplyDefines(const std::string& source, const ShaderDefines& defines);
+
+    /**
+     * @brief 异步请求变体，相同的请求返回同一个句柄
+     * @param desc 变体描述
+     * @return 变体句柄
+     */
+    std::shared_ptr<ShaderVariant> Request(const ShaderVariantDesc& desc);
+
+    /**
+     * @brief 同步获取变体，尚未开始编译时直接在调用线程上编译
+     * @param desc 变体描述
+     * @return 着色器指针，失败时返回nullptr
+     */
+    std::shared_ptr<Shader> Get(const ShaderVariantDesc& desc);
+
+    /**
+     * @brief 在渲染线程上编译排队的变体（仅在没有后台线程时需要）
+     * @param maxVariants 本次最多处理的变体数量
+     */
+    void Update(uint32_t maxVariants = 1);
+
+    /**
+     * @brief 是否在后台线程编译
+     */
+    bool IsBackgroundCompilation() const { return !m_Workers.empty(); }
+
+    /**
+     * @brief 获取统计
+     */
+    ShaderLibraryStats GetStats() const;
+
+private:
+    struct Job {
+        ShaderVariantDesc desc;
+        std::shared_ptr<ShaderVariant> variant;
+    };
+
+    void WorkerLoop();
+    void Process(Job& job);
+    bool TakeJob(ShaderVariantKey key, Job& job);
+    std::string GetCachePath(ShaderVariantKey key) const;
+    bool LoadBinary(ShaderVariantKey key, std::vector<uint8_t>& binary) const;
+    void SaveBinary(ShaderVariantKey key, const std::vector<uint8_t>& binary) const;
+
+    RenderSystem& m_RenderSystem;
+    ShaderLibraryConfig m_Config;
+    uint64_t m_DeviceHash = 0;
+
+    std::vector<std::thread> m_Workers;
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    std::deque<Job> m_Queue;
+    std::unordered_map<ShaderVariantKey, std::shared_ptr<ShaderVariant>> m_Variants;
+    ShaderLibraryStats m_Stats;
+    bool m_Running = false;
+};
+
+} // namespace PLE
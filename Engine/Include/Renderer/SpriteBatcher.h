@@ -0,0 +1,177 @@
+/**
+ * @file SpriteBatcher.h
+ * @brief 2D精灵批量渲染
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Vector.h"
+#include "../Math/Matrix4.h"
+#include "RenderResources.h"
+
+namespace PLE {
+
+// 前向声明
+class RenderSystem;
+class TextureAtlas;
+struct AtlasRegion;
+
+/**
+ * @brief 精灵
+ */
+struct Sprite {
+    Vector2 position = Vector2(0.0f, 0.0f);     // 枢轴点的位置
+    Vector2 size = Vector2(1.0f, 1.0f);
+    Vector2 pivot = Vector2(0.5f, 0.5f);        // 枢轴在精灵内的相对位置，(0, 0)为左下角
+    float rotation = 0.0f;                      // 绕枢轴逆时针旋转（弧度）
+    Vector4 uvRect = Vector4(0.0f, 0.0f, 1.0f, 1.0f);   // u0, v0, u1, v1，(u0, v0)对应左上角
+    uint32_t color = 0xFFFFFFFFu;               // RGBA8颜色，R在最低字节
+    uint32_t page = 0;                          // 图集页面
+    int16_t layer = 0;                          // 层越大越晚绘制
+
+    /**
+     * @brief 使用图集中的图像（页面和UV）
+     */
+    void SetRegion(const AtlasRegion& region);
+};
+
+/**
+ * @brief 精灵顶点（16字节）
+ *
+ * 属性位置：0 = position（vec2），1 = color（vec4，Unorm8x4），2 = texCoord（vec2，Snorm16x2）。
+ */
+struct SpriteVertex {
+    float x;
+    float y;
+    uint32_t color;
+    int16_t u;
+    int16_t v;
+};
+
+/**
+ * @brief 精灵批次统计（最近一次End）
+ */
+struct SpriteBatchStats {
+    uint32_t sprites = 0;
+    uint32_t drawCalls = 0;
+    uint32_t droppedSprites = 0;    // 瞬态几何缓冲区耗尽而没有绘制的精灵
+    double buildMilliseconds = 0.0; // 排序和生成顶点的耗时
+};
+
+/**
+ * @brief 精灵批量渲染器
+ *
+ * 一帧内提交的精灵先按（层，图集页面）排序（基数排序，同一层同一页面内保持提交顺序），
+ * 再由任务系统并行生成16字节的紧凑顶点，每个（层，页面）组合写成一个瞬态网格、
+ * 一次绘制，所有精灵在同一层时每个图集页面只有一次绘制。
+ * 索引是固定的四边形模式，只生成一次。
+ *
+ * 着色器由调用者提供（与CascadedShadowMap的投射体材质相同的做法），
+ * 顶点属性见SpriteVertex，页面纹理绑定到名为textureParameter的材质参数，
+ * 批量渲染器为每个页面创建一个材质实例。精灵位于z = 0平面，
+ * 经过End传入的变换和渲染系统当前的视图投影矩阵，屏幕空间UI使用正交投影即可。
+ *
+ * 用法：
+ * @code
+ * SpriteBatcher batcher(spriteMaterial);
+ * batcher.SetAtlas(atlas);
+ * batcher.Begin();
+ * batcher.Draw(sprite);
+ * batcher.End(renderSystem);
+ * @endcode
+ */
+class PLE_API SpriteBatcher {
+public:
+    /**
+     * @brief 构造函数
+     * @param material 精灵材质，着色器按SpriteVertex的布局读取顶点
+     * @param textureParameter 页面纹理的材质参数名
+     */
+    explicit SpriteBatcher(std::shared_ptr<Material> material, const std::string& textureParameter = "u_Texture");
+    ~SpriteBatcher();
+
+    SpriteBatcher(const SpriteBatcher&) = delete;
+    SpriteBatcher& operator=(const SpriteBatcher&) = delete;
+
+    /**
+     * @brief 设置页面纹理
+     */
+    void SetPageTexture(uint32_t page, std::shared_ptr<Texture> texture);
+
+    /**
+     * @brief 使用图集的所有页面纹理，图集重新上传页面后需要再次调用
+     */
+    void SetAtlas(const TextureAtlas& atlas);
+
+    /**
+     * @brief 开始一帧的精灵提交，清空上一次的精灵
+     */
+    void Begin();
+
+    /**
+     * @brief 提交精灵
+     */
+    void Draw(const Sprite& sprite) { m_Sprites.push_back(sprite); }
+
+    /**
+     * @brief 批量提交精灵
+     */
+    void Draw(const Sprite* sprites, uint32_t count);
+
+    /**
+     * @brief 已提交的精灵数量
+     */
+    uint32_t GetSpriteCount() const { return static_cast<uint32_t>(m_Sprites.size()); }
+
+    /**
+     * @brief 排序、生成顶点并绘制本帧提交的精灵，需要在渲染系统的BeginFrame和EndFrame之间调用
+     * @param renderSystem 渲染系统
+     * @param transform 精灵平面的模型矩阵
+     * @return 绘制次数
+     */
+    uint32_t End(RenderSystem& renderSystem, const Matrix4& transform = Matrix4::Identity());
+
+    /**
+     * @brief 获取最近一次End的统计
+     */
+    const SpriteBatchStats& GetStats() const { return m_Stats; }
+
+    /**
+     * @brief SpriteVertex的顶点布局
+     */
+    static const VertexLayout& GetVertexLayout();
+
+private:
+    struct Batch {
+        uint32_t first;             // 排序后第一个精灵的序号
+        uint32_t count;
+        uint32_t page;
+    };
+
+    void SortSprites();
+    void BuildVertices();
+    std::shared_ptr<Material> GetPageMaterial(RenderSystem& renderSystem, uint32_t page);
+
+    std::shared_ptr<Material> m_Material;
+    std::string m_TextureParameter;
+    std::vector<std::shared_ptr<Texture>> m_PageTextures;
+    std::vector<std::shared_ptr<Material>> m_PageMaterials;
+
+    std::vector<Sprite> m_Sprites;
+    std::vector<uint32_t> m_Keys;           // 排序键：层（偏移到无符号）在高16位，页面在低16位
+    std::vector<uint32_t> m_Order;          // 排序后的精灵序号
+    std::vector<uint32_t> m_KeyScratch;
+    std::vector<uint32_t> m_OrderScratch;
+    std::vector<Batch> m_Batches;
+    std::vector<SpriteVertex> m_Vertices;
+    std::vector<uint32_t> m_Indices;        // 四边形索引模式，按需增长
+    SpriteBatchStats m_Stats;
+};
+
+} // namespace PLE
@@ -0,0 +1,191 @@
+/**
+ * @file TextureAtlas.h
+ * @brief 纹理图集：把大量小图打包到少数几张大纹理（MaxRects）
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Vector.h"
+#include "RenderResources.h"
+
+namespace PLE {
+
+// 前向声明
+class RenderSystem;
+
+/**
+ * @brief 图集配置
+ */
+struct TextureAtlasConfig {
+    int pageWidth = 2048;
+    int pageHeight = 2048;
+    int padding = 2;                // 图像之间的间距（像素），用图像边缘像素填充，避免双线性过滤采到相邻图像
+    uint32_t maxPages = 16;
+};
+
+/**
+ * @brief 图像在图集中的位置
+ */
+struct AtlasRegion {
+    static constexpr uint32_t INVALID_PAGE = 0xFFFFFFFFu;
+
+    uint32_t page = INVALID_PAGE;   // 还没有打包或打包失败时为INVALID_PAGE
+    int x = 0;                      // 图像在页面中的像素位置（不含间距）
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    Vector4 uvRect = Vector4(0.0f, 0.0f, 0.0f, 0.0f);   // u0, v0, u1, v1（v = 0为第一行）
+};
+
+/**
+ * @brief 单个页面的MaxRects装箱
+ *
+ * 维护页面中所有极大空闲矩形（可以互相重叠），每次放入一个矩形后
+ * 切分与之相交的空闲矩形并删除被其他空闲矩形包含的部分。
+ * 放置位置按最短边适配（Best Short Side Fit）选择：剩余短边最小的空闲矩形，
+ * 这一启发式在随机尺寸的精灵上通常能达到90%以上的占用率。
+ */
+class PLE_API MaxRectsPacker {
+public:
+    MaxRectsPacker(int width, int height);
+
+    /**
+     * @brief 放入一个矩形
+     * @param width 宽度
+     * @param height 高度
+     * @param x 输出左上角X坐标
+     * @param y 输出左上角Y坐标
+     * @return 是否放得下
+     */
+    bool Insert(int width, int height, int& x, int& y);
+
+    /**
+     * @brief 已占用面积的比例
+     */
+    float GetOccupancy() const;
+
+private:
+    struct Rect {
+        int x;
+        int y;
+        int width;
+        int height;
+    };
+
+    void SplitFreeRects(const Rect& used);
+    void PruneFreeRects();
+
+    int m_Width;
+    int m_Height;
+    int64_t m_UsedArea = 0;
+    std::vector<Rect> m_FreeRects;
+};
+
+/**
+ * @brief 纹理图集
+ *
+ * 离线和运行时使用同一套接口：Add把RGBA8图像加入待打包列表，Pack把所有待打包的
+ * 图像按长边从大到小放入已有页面（放不下时新建页面）。离线时一次添加全部图像再调用
+ * Pack得到最好的排列；运行时每次Add后调用Pack，新图像放入已有页面的空闲区域，
+ * 已打包图像的位置不变。页面像素保存在CPU上，UploadPages把变化的页面上传为纹理。
+ *
+ * 用法：
+ * @code
+ * TextureAtlas atlas;
+ * uint32_t icon = atlas.Add(32, 32, pixels);
+ * atlas.Pack();
+ * atlas.UploadPages(renderSystem);
+ * const AtlasRegion& region = atlas.GetRegion(icon);
+ * @endcode
+ */
+class PLE_API TextureAtlas {
+public:
+    explicit TextureAtlas(const TextureAtlasConfig& config = TextureAtlasConfig());
+    ~TextureAtlas();
+
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    /**
+     * @brief 添加图像，在下一次Pack时打包
+     * @param width 宽度
+     * @param height 高度
+     * @param rgba8 像素数据（行从上到下），数据会被复制
+     * @return 图像序号
+     */
+    uint32_t Add(int width, int height, const void* rgba8);
+
+    /**
+     * @brief 打包所有待打包的图像
+     * @return 是否全部打包成功（图像超过页面尺寸或页面数达到上限时失败，失败的图像page为INVALID_PAGE）
+     */
+    bool Pack();
+
+    /**
+     * @brief 获取图像的位置
+     */
+    const AtlasRegion& GetRegion(uint32_t image) const { return m_Images[image].region; }
+
+    /**
+     * @brief 图像数量
+     */
+    uint32_t GetImageCount() const { return static_cast<uint32_t>(m_Images.size()); }
+
+    /**
+     * @brief 页面数量
+     */
+    uint32_t GetPageCount() const { return static_cast<uint32_t>(m_Pages.size()); }
+
+    /**
+     * @brief 页面的占用率
+     */
+    float GetOccupancy(uint32_t page) const { return m_Pages[page].packer.GetOccupancy(); }
+
+    /**
+     * @brief 获取页面像素（单级Mip的RGBA8），可用于离线保存图集
+     */
+    TextureData GetPageData(uint32_t page) const;
+
+    /**
+     * @brief 把上次上传后变化的页面重新创建为纹理
+     * @return 是否全部上传成功
+     */
+    bool UploadPages(RenderSystem& renderSystem);
+
+    /**
+     * @brief 获取页面纹理，还没有上传时返回nullptr
+     */
+    std::shared_ptr<Texture> GetPageTexture(uint32_t page) const { return m_Pages[page].texture; }
+
+private:
+    struct Image {
+        int width = 0;
+        int height = 0;
+        std::vector<uint8_t> pixels;    // 打包后释放
+        AtlasRegion region;
+        bool pending = true;
+    };
+
+    struct Page {
+        explicit Page(int width, int height) : packer(width, height) {}
+
+        MaxRectsPacker packer;
+        std::vector<uint8_t> pixels;
+        std::shared_ptr<Texture> texture;
+        bool dirty = true;
+    };
+
+    bool Place(Image& image);
+    void Blit(Page& page, const Image& image);
+
+    TextureAtlasConfig m_Config;
+    std::vector<Image> m_Images;
+    std::vector<Page> m_Pages;
+};
+
+} // namespace PLE
@@ -0,0 +1,116 @@
+/**
+ * @file TextureImporter.h
+ * @brief 纹理导入：图像解码、Mip生成、块压缩和磁盘缓存
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "RenderResources.h"
+
+namespace PLE {
+
+/**
+ * @brief Mip降采样滤波器
+ */
+enum class TextureMipFilter {
+    Box = 0,    // 按覆盖面积加权，最快
+    Kaiser      // Kaiser窗sinc（宽度3），更锐利，远处细节不易糊
+};
+
+/**
+ * @brief 纹理导入设置
+ */
+struct TextureImportSettings {
+    TextureFormat format = TextureFormat::BC7;
+    bool generateMips = true;
+    TextureMipFilter mipFilter = TextureMipFilter::Kaiser;
+    bool srgb = true;           // RGB为sRGB编码：转换到线性空间过滤，再编码回sRGB存储
+    bool normalMap = false;     // 法线贴图：RGB为[0,1]映射的单位向量，每级Mip重新归一化，忽略srgb
+};
+
+/**
+ * @brief 纹理导入器配置
+ */
+struct TextureImporterConfig {
+    std::string cacheDirectory = "TextureCache";    // 导入结果的磁盘缓存目录，为空时不使用磁盘缓存
+};
+
+/**
+ * @brief 纹理导入统计
+ */
+struct TextureImporterStats {
+    uint64_t imported = 0;      // 成功导入的纹理数量
+    uint64_t cacheHits = 0;     // 其中从磁盘缓存加载的数量
+    uint64_t failed = 0;        // 失败的数量
+};
+
+/**
+ * @brief 纹理导入器
+ *
+ * 把PNG/TGA/JPEG文件处理成可以直接传给RenderSystem::CreateTexture的TextureData：
+ * 1. 解码为RGBA8；
+ * 2. 生成完整的Mip链：在线性空间（sRGB颜色先解码）用SSE2按float4分离地做横向和纵向降采样，
+ *    行分配到JobSystem的工作线程；
+ * 3. 按块行并行地编码为BC1/BC3/BC5/BC7。
+ *
+ * 引擎的纹理和交换链都是UNORM格式，着色在gamma空间进行，所以结果仍按sRGB编码存储。
+ * 结果按文件内容和导入设置的哈希缓存到磁盘，源文件或设置变化后自动重新处理。
+ * ImportBatch在工作线程上并行导入多个文件；所有函数都可以在多个线程上同时调用。
+ */
+class PLE_API TextureImporter {
+public:
+    explicit TextureImporter(const TextureImporterConfig& config = TextureImporterConfig());
+
+    /**
+     * @brief 导入一个图像文件
+     * @param path 文件路径
+     * @param settings 导入设置
+     * @param output 输出纹理数据
+     * @return 是否成功
+     */
+    bool Import(const std::string& path, const TextureImportSettings& settings, TextureData& output);
+
+    /**
+     * @brief 并行导入多个图像文件
+     * @param paths 文件路径
+     * @param settings 导入设置
+     * @param outputs 输出纹理数据，与paths一一对应，失败的项为空
+     * @return 是否全部成功
+     */
+    bool ImportBatch(const std::vector<std::string>& paths, const TextureImportSettings& settings,
+                     std::vector<TextureData>& outputs);
+
+    /**
+     * @brief 处理已解码的图像（生成Mip并压缩），不经过磁盘缓存
+     * @param rgba RGBA8像素，行从上到下
+     * @param width 宽度
+     * @param height 高度
+     * @param settings 导入设置
+     * @param output 输出纹理数据
+     * @return 是否成功
+     */
+    static bool Cook(const uint8_t* rgba, uint32_t width, uint32_t height, const TextureImportSettings& settings,
+                     TextureData& output);
+
+    /**
+     * @brief 获取统计
+     */
+    TextureImporterStats GetStats() const;
+
+private:
+    std::string GetCachePath(uint64_t key) const;
+    bool LoadCooked(uint64_t key, TextureData& output) const;
+    void SaveCooked(uint64_t key, const TextureData& data) const;
+
+    TextureImporterConfig m_Config;
+    mutable std::mutex m_Mutex;
+    TextureImporterStats m_Stats;
+};
+
+} // namespace PLE
@@ -0,0 +1,236 @@
+/**
+ * @file TextureStreamer.h
+ * @brief 纹理Mip流式加载定义
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Matrix4.h"
+#include "RenderResources.h"
+
+namespace PLE {
+
+// 前向声明
+class RenderSystem;
+
+/**
+ * @brief 流式纹理句柄
+ */
+using StreamedTextureHandle = uint32_t;
+
+/**
+ * @brief 无效的流式纹理句柄
+ */
+constexpr StreamedTextureHandle InvalidStreamedTexture = 0;
+
+/**
+ * @brief Mip加载函数：加载从firstMip到最小一级的所有Mip
+ *
+ * 输出的TextureData以firstMip为第0级，在JobSystem的工作线程上调用。
+ */
+using TextureMipLoader = std::function<bool(uint32_t firstMip, TextureData& output)>;
+
+/**
+ * @brief 流式纹理描述
+ */
+struct StreamedTextureDesc {
+    TextureFormat format = TextureFormat::RGBA8;
+    uint32_t width = 0;             // 第0级的宽度
+    uint32_t height = 0;            // 第0级的高度
+    uint32_t mipCount = 1;          // 完整Mip链的级数
+    float priority = 1.0f;          // 优先级系数，预算不足时优先降低系数小的纹理
+    TextureMipLoader loader;
+};
+
+/**
+ * @brief 纹理流式加载配置
+ */
+struct TextureStreamerConfig {
+    uint64_t memoryBudget = 256ull * 1024 * 1024;   // 流式纹理的显存预算（字节）
+    uint64_t uploadBytesPerUpdate = 16ull * 1024 * 1024;    // 每次Update最多上传的字节数（至少上传一张）
+    uint32_t maxPendingLoads = 8;   // 同时在后台加载的纹理数
+    uint32_t residentTailSize = 64; // 宽高都不超过该值的Mip始终驻留
+    uint32_t dropDelayFrames = 30;  // 不再需要的Mip保留的帧数，避免来回加载
+    float mipBias = 0.0f;           // 加到计算出的Mip级别上，正值降低清晰度
+};
+
+/**
+ * @brief 纹理流式加载统计
+ */
+struct TextureStreamerStats {
+    uint32_t textureCount = 0;      // 注册的纹理数量
+    uint32_t pendingLoads = 0;      // 正在加载的纹理数量
+    uint64_t residentBytes = 0;     // 驻留的显存（字节）
+    uint64_t requestedBytes = 0;    // 按请求的Mip全部驻留需要的显存（字节）
+    uint64_t loadedMips = 0;        // 累计加载的Mip级数
+    uint64_t droppedMips = 0;       // 累计丢弃的Mip级数
+    uint64_t failedLoads = 0;       // 累计失败的加载次数
+};
+
+/**
+ * @brief 纹理Mip流式加载器
+ *
+ * 每张纹理只驻留从某一级到最小一级的Mip。渲染器每帧按屏幕上一个UV单位覆盖的像素数
+ * 报告每张纹理需要的Mip（ReportUsage，可以从并行的可见性遍历中调用），Update时：
+ * 1. 取最近dropDelayFrames帧内需要的最清晰的一级作为目标；
+ * 2. 目标总大小超过预算时，按优先级（屏幕覆盖乘优先级系数）从代价最小的纹理开始逐级降低，
+ *    离请求越远的一级代价越高，所以预算由所有纹理分担，重要的纹理保留更多细节；
+ * 3. 需要提高清晰度的纹理按优先级在工作线程上调用加载函数，不超过预算和并发上限；
+ *    需要降低的纹理立即重新加载较小的Mip链并释放原来的显存；
+ * 4. 加载完成的数据在渲染线程上创建新纹理（受每帧上传量限制），替换到绑定的材质参数中。
+ *
+ * 替换下来的纹理保留GetFramesInFlight帧后再释放，GPU仍可能在使用它。
+ * 宽高都不超过residentTailSize的Mip在注册时同步加载并始终驻留，材质总有纹理可用。
+ * 除ReportUsage外的函数都只应在渲染线程上调用。
+ */
+class PLE_API TextureStreamer {
+public:
+    /**
+     * @brief 构造函数
+     * @param renderSystem 已初始化的渲染系统，生命周期必须长于流式加载器
+     * @param config 配置
+     */
+    explicit TextureStreamer(RenderSystem& renderSystem, const TextureStreamerConfig& config = TextureStreamerConfig());
+    ~TextureStreamer();
+
+    /**
+     * @brief 注册流式纹理，同步加载常驻的小Mip
+     * @param desc 纹理描述
+     * @return 句柄，描述无效或加载失败时返回InvalidStreamedTexture
+     */
+    StreamedTextureHandle Register(const StreamedTextureDesc& desc);
+
+    /**
+     * @brief 注册内存中已有完整Mip链的纹理（例如TextureImporter的结果）
+     * @param data 纹理数据，由加载函数共享持有
+     * @param priority 优先级系数
+     * @return 句柄，失败时返回InvalidStreamedTexture
+     */
+    StreamedTextureHandle Register(std::shared_ptr<const TextureData> data, float priority = 1.0f);
+
+    /**
+     * @brief 注销纹理，等待正在进行的加载结束，已绑定的材质保留当前纹理
+     */
+    void Unregister(StreamedTextureHandle handle);
+
+    /**
+     * @brief 把纹理绑定到材质参数，之后每次替换纹理都会更新该参数
+     * @param handle 句柄
+     * @param material 材质
+     * @param name 纹理参数名
+     */
+    void Bind(StreamedTextureHandle handle, const std::shared_ptr<Material>& material, const std::string& name);
+
+    /**
+     * @brief 报告本帧使用了纹理，可以在多个线程上同时调用
+     * @param handle 句柄
+     * @param pixelsPerUV 屏幕上一个UV单位对应的像素数，见ComputePixelsPerUV
+     */
+    void ReportUsage(StreamedTextureHandle handle, float pixelsPerUV);
+
+    /**
+     * @brief 处理加载结果、分配预算并发起新的加载，每帧调用一次
+     */
+    void Update();
+
+    /**
+     * @brief 获取当前驻留的纹理
+     */
+    std::shared_ptr<Texture> GetTexture(StreamedTextureHandle handle) const;
+
+    /**
+     * @brief 获取驻留的最清晰一级Mip（相对完整Mip链）
+     */
+    uint32_t GetResidentMip(StreamedTextureHandle handle) const;
+
+    /**
+     * @brief 获取最近一次Update分配的目标Mip
+     */
+    uint32_t GetTargetMip(StreamedTextureHandle handle) const;
+
+    /**
+     * @brief 获取统计
+     */
+    TextureStreamerStats GetStats() const;
+
+    /**
+     * @brief 计算网格的UV密度：一个UV单位对应的世界长度（模型空间，需乘以物体缩放）
+     * @param vertices 顶点数据
+     * @param vertexCount 顶点数量
+     * @param indices 索引数据，为nullptr时按顶点顺序每三个组成三角形
+     * @param indexCount 索引数量
+     * @return 三角形总面积与UV总面积之比的平方根，UV退化时返回0
+     */
+    static float ComputeUVDensity(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount);
+
+    /**
+     * @brief 计算屏幕上一个UV单位对应的像素数
+     * @param uvDensity 一个UV单位对应的世界长度
+     * @param distance 到相机的距离（通常为到包围球表面的距离）
+     * @param projection 透视投影矩阵
+     * @param viewportHeight 视口高度（像素）
+     */
+    static float ComputePixelsPerUV(float uvDensity, float distance, const Matrix4& projection, float viewportHeight);
+
+private:
+    struct Binding {
+        std::weak_ptr<Material> material;
+        std::string name;
+    };
+
+    struct PendingLoad {
+        uint32_t firstMip = 0;
+        std::shared_ptr<TextureData> data;
+        std::shared_ptr<bool> succeeded;
+        std::future<void> future;
+    };
+
+    struct Entry {
+        StreamedTextureDesc desc;
+        uint32_t tailMip = 0;               // 始终驻留的第一级
+        uint32_t residentMip = 0;
+        uint32_t targetMip = 0;
+        uint32_t recentMip = 0;             // 最近dropDelayFrames帧内需要的最清晰一级
+        uint64_t recentFrame = 0;
+        float priority = 0.0f;              // 最近一次报告的优先级
+        std::shared_ptr<Texture> texture;
+        std::vector<Binding> bindings;
+        std::unique_ptr<PendingLoad> pending;
+        std::atomic<uint32_t> reportedMip{ UINT32_MAX };    // 本帧报告的最清晰一级
+        std::atomic<uint32_t> reportedPixels{ 0 };          // 本帧报告的最大像素数（浮点位模式）
+    };
+
+    struct RetiredTexture {
+        std::shared_ptr<Texture> texture;
+        uint64_t frame;
+    };
+
+    Entry* Find(StreamedTextureHandle handle) const;
+    uint64_t GetMipChainSize(const Entry& entry, uint32_t firstMip) const;
+    void CollectReports();
+    void AssignTargets();
+    void FinishLoads();
+    void StartLoads();
+    void StartLoad(Entry& entry, uint32_t firstMip);
+    bool Install(Entry& entry, const TextureData& data, uint32_t firstMip);
+    static void WaitPending(Entry& entry);
+
+    RenderSystem& m_RenderSystem;
+    TextureStreamerConfig m_Config;
+    std::vector<std::unique_ptr<Entry>> m_Entries;      // 句柄减一为下标
+    std::vector<uint32_t> m_FreeSlots;
+    std::vector<RetiredTexture> m_Retired;
+    uint64_t m_Frame = 0;
+    TextureStreamerStats m_Stats;
+};
+
+} // namespace PLE
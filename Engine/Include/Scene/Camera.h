@@ -0,0 +1,113 @@
+/**
+ * @file Camera.h
+ * @brief 相机组件定义
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Matrix4.h"
+#include "Scene.h"
+
+namespace PLE {
+
+/**
+ * @brief 相机投影类型
+ */
+enum class CameraProjection {
+    Perspective = 0,
+    Orthographic
+};
+
+/**
+ * @brief 相机组件
+ *
+ * 视图矩阵由所属实体的世界变换求逆得到，相机沿自身-Z方向观察。
+ * 矩阵约定与Matrix4一致（行向量，深度范围[0, 1]）。
+ */
+class PLE_API Camera : public Component {
+public:
+    /**
+     * @brief 构造函数
+     * @param entity 所属实体
+     */
+    Camera(std::shared_ptr<Entity> entity);
+
+    /**
+     * @brief 设置透视投影
+     * @param fovY 垂直视场角（弧度）
+     * @param nearZ 近裁剪面
+     * @param farZ 远裁剪面
+     */
+    void SetPerspective(float fovY, float nearZ, float farZ);
+
+    /**
+     * @brief 设置正交投影
+     * @param height 视口对应的世界高度
+     * @param nearZ 近裁剪面
+     * @param farZ 远裁剪面
+     */
+    void SetOrthographic(float height, float nearZ, float farZ);
+
+    /**
+     * @brief 设置宽高比
+     */
+    void SetAspectRatio(float aspectRatio) { m_AspectRatio = aspectRatio; }
+
+    /**
+     * @brief 获取宽高比
+     */
+    float GetAspectRatio() const { return m_AspectRatio; }
+
+    /**
+     * @brief 获取投影类型
+     */
+    CameraProjection GetProjection() const { return m_Projection; }
+
+    /**
+     * @brief 获取垂直视场角（弧度）
+     */
+    float GetFieldOfView() const { return m_FieldOfView; }
+
+    /**
+     * @brief 获取近裁剪面
+     */
+    float GetNearClip() const { return m_NearClip; }
+
+    /**
+     * @brief 获取远裁剪面
+     */
+    float GetFarClip() const { return m_FarClip; }
+
+    /**
+     * @brief 获取相机世界位置
+     */
+    Vector3 GetPosition() const;
+
+    /**
+     * @brief 获取视图矩阵
+     */
+    Matrix4 GetViewMatrix() const;
+
+    /**
+     * @brief 获取投影矩阵
+     */
+    Matrix4 GetProjectionMatrix() const;
+
+    /**
+     * @brief 获取视图投影矩阵
+     */
+    Matrix4 GetViewProjectionMatrix() const { return GetViewMatrix() * GetProjectionMatrix(); }
+
+private:
+    CameraProjection m_Projection = CameraProjection::Perspective;
+    float m_FieldOfView = 1.0471976f;   // 60度
+    float m_OrthographicHeight = 10.0f;
+    float m_AspectRatio = 16.0f / 9.0f;
+    float m_NearClip = 0.1f;
+    float m_FarClip = 1000.0f;
+};
+
+} // namespace PLE
@@ -0,0 +1,127 @@
+/**
+ * @file Light.h
+ * @brief 光源组件定义
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Vector.h"
+#include "Scene.h"
+
+namespace PLE {
+
+/**
+ * @brief 光源类型
+ */
+enum class LightType {
+    Directional = 0,
+    Point,
+    Spot
+};
+
+/**
+ * @brief 光源组件
+ *
+ * 位置和方向取自所属实体的世界变换，方向光和聚光灯沿实体的前方向照射。
+ * 点光源和聚光灯的影响范围由range限定，衰减在range处降为0，
+ * 分簇光照剔除按这一范围把光源分配到视锥体簇中。
+ */
+class PLE_API Light : public Component {
+public:
+    /**
+     * @brief 构造函数
+     * @param entity 所属实体
+     */
+    Light(std::shared_ptr<Entity> entity);
+
+    /**
+     * @brief 设置光源类型
+     */
+    void SetType(LightType type) { m_Type = type; }
+
+    /**
+     * @brief 获取光源类型
+     */
+    LightType GetType() const { return m_Type; }
+
+    /**
+     * @brief 设置颜色（线性空间）
+     */
+    void SetColor(const Vector3& color) { m_Color = color; }
+
+    /**
+     * @brief 获取颜色（线性空间）
+     */
+    const Vector3& GetColor() const { return m_Color; }
+
+    /**
+     * @brief 设置强度
+     */
+    void SetIntensity(float intensity) { m_Intensity = intensity; }
+
+    /**
+     * @brief 获取强度
+     */
+    float GetIntensity() const { return m_Intensity; }
+
+    /**
+     * @brief 设置影响范围（点光源和聚光灯）
+     */
+    void SetRange(float range) { m_Range = range; }
+
+    /**
+     * @brief 获取影响范围
+     */
+    float GetRange() const { return m_Range; }
+
+    /**
+     * @brief 设置聚光灯锥角
+     * @param innerAngle 内锥半角（弧度），其内为全亮
+     * @param outerAngle 外锥半角（弧度），其外不受光照
+     */
+    void SetSpotAngles(float innerAngle, float outerAngle);
+
+    /**
+     * @brief 获取聚光灯内锥半角（弧度）
+     */
+    float GetInnerSpotAngle() const { return m_InnerSpotAngle; }
+
+    /**
+     * @brief 获取聚光灯外锥半角（弧度）
+     */
+    float GetOuterSpotAngle() const { return m_OuterSpotAngle; }
+
+    /**
+     * @brief 设置是否启用
+     */
+    void SetEnabled(bool enabled) { m_Enabled = enabled; }
+
+    /**
+     * @brief 是否启用
+     */
+    bool IsEnabled() const { return m_Enabled; }
+
+    /**
+     * @brief 获取光源世界位置
+     */
+    Vector3 GetPosition() const;
+
+    /**
+     * @brief 获取光源照射方向（世界空间，单位向量）
+     */
+    Vector3 GetDirection() const;
+
+private:
+    LightType m_Type = LightType::Point;
+    Vector3 m_Color = Vector3(1.0f, 1.0f, 1.0f);
+    float m_Intensity = 1.0f;
+    float m_Range = 10.0f;
+    float m_InnerSpotAngle = 0.3490659f;    // 20度
+    float m_OuterSpotAngle = 0.5235988f;    // 30度
+    bool m_Enabled = true;
+};
+
+} // namespace PLE
@@ -0,0 +1,192 @@
+/**
+ * @file SpatialHashGrid.h
+ * @brief 空间哈希网格定义
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "../PhantomLightEngine.h"
+#include "../Math/Vector.h"
+
+namespace PLE {
+
+/**
+ * @brief 空间哈希网格
+ *
+ * 面向大量移动点的邻近查询结构。每帧调用Build重建：并行计算每个点的格子，
+ * 再用并行计数排序把点按格子连续存放（位置也一并复制，查询时顺序访问内存）。
+ * 格子坐标经哈希映射到大小约为点数两倍的桶表，桶内同时保存格子键，
+ * 因此哈希冲突不会产生重复或错误的结果。
+ * 对尺寸小且分布均匀的对象，重建和查询都远快于树结构。
+ * 查询返回的是传入Build时的点索引。Build期间不能并发查询。
+ */
+class PLE_API SpatialHashGrid {
+public:
+    /**
+     * @brief 构造函数
+     * @param cellSize 格子尺寸，通常取最常用的查询半径
+     * @param planar 是否只在XZ平面上划分和计算距离（忽略Y轴）
+     */
+    SpatialHashGrid(float cellSize = 1.0f, bool planar = false);
+
+    /**
+     * @brief 设置格子尺寸，下次Build时生效
+     */
+    void SetCellSize(float cellSize);
+
+    /**
+     * @brief 获取格子尺寸
+     */
+    float GetCellSize() const { return m_CellSize; }
+
+    /**
+     * @brief 是否为XZ平面网格
+     */
+    bool IsPlanar() const { return m_Planar; }
+
+    /**
+     * @brief 重建网格
+     * @param positions 点坐标数组
+     * @param count 点数量
+     */
+    void Build(const Vector3* positions, uint32_t count);
+
+    /**
+     * @brief 重建网格
+     * @param positions 点坐标列表
+     */
+    void Build(const std::vector<Vector3>& positions) { Build(positions.data(), static_cast<uint32_t>(positions.size())); }
+
+    /**
+     * @brief 清空网格
+     */
+    void Clear();
+
+    /**
+     * @brief 获取点数量
+     */
+    uint32_t GetCount() const { return static_cast<uint32_t>(m_SortedIndices.size()); }
+
+    /**
+     * @brief 遍历半径内的所有点
+     * @param center 查询中心
+     * @param radius 查询半径
+     * @param func 回调，签名为void(uint32_t index, float distanceSquared)
+     */
+    template<typename Func>
+    void ForEachInRadius(const Vector3& center, float radius, Func&& func) const;
+
+    /**
+     * @brief 查询半径内的所有点
+     * @param center 查询中心
+     * @param radius 查询半径
+     * @param results 输出点索引（会先清空），顺序不保证
+     * @return 找到的点数量
+     */
+    uint32_t QueryRadius(const Vector3& center, float radius, std::vector<uint32_t>& results) const;
+
+    /**
+     * @brief 查询最近的k个点
+     *
+     * 从中心格子开始逐圈向外搜索，已找到k个点且下一圈不可能更近时停止。
+     * @param center 查询中心
+     * @param k 最多返回的点数量
+     * @param results 输出点索引（会先清空），按距离从近到远排列
+     * @param maxRadius 最大搜索半径
+     * @return 找到的点数量
+     */
+    uint32_t QueryKNearest(const Vector3& center, uint32_t k, std::vector<uint32_t>& results, float maxRadius = INFINITY) const;
+
+private:
+    // 每个轴的格子坐标用21位有符号整数保存
+    static constexpr int32_t CELL_LIMIT = (1 << 20) - 1;
+    static constexpr uint64_t CELL_MASK = (1ull << 21) - 1;
+
+    int32_t ToCell(float value) const {
+        float cell = std::floor(value * m_InvCellSize);
+        cell = cell < static_cast<float>(CELL_LIMIT) ? cell : static_cast<float>(CELL_LIMIT);
+        cell = cell > static_cast<float>(-CELL_LIMIT) ? cell : static_cast<float>(-CELL_LIMIT);
+        return static_cast<int32_t>(cell);
+    }
+
+    void ComputeCell(const Vector3& position, int32_t& cellX, int32_t& cellY, int32_t& cellZ) const {
+        cellX = ToCell(position.x);
+        cellY = m_Planar ? 0 : ToCell(position.y);
+        cellZ = ToCell(position.z);
+    }
+
+    static uint64_t PackCell(int32_t cellX, int32_t cellY, int32_t cellZ) {
+        return ((static_cast<uint64_t>(cellX) & CELL_MASK) << 42) |
+               ((static_cast<uint64_t>(cellY) & CELL_MASK) << 21) |
+               (static_cast<uint64_t>(cellZ) & CELL_MASK);
+    }
+
+    uint32_t HashKey(uint64_t key) const {
+        // 64位混合函数，保证相邻格子分散到不同的桶
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdull;
+        key ^= key >> 33;
+        return static_cast<uint32_t>(key) & m_HashMask;
+    }
+
+    float m_CellSize;
+    float m_InvCellSize;
+    bool m_Planar;
+
+    uint32_t m_HashMask = 0;
+    std::vector<uint32_t> m_BucketStart;        // 每个桶在排序数组中的起始位置（多一个尾元素）
+    std::vector<uint32_t> m_SortedIndices;      // 按桶排序的原始点索引
+    std::vector<Vector3> m_SortedPositions;     // 按桶排序的点坐标
+    std::vector<uint64_t> m_SortedKeys;         // 按桶排序的格子键，用于排除哈希冲突
+
+    // 构建用临时数据
+    std::vector<uint64_t> m_Keys;
+    std::vector<uint32_t> m_Buckets;
+    std::vector<uint32_t> m_ChunkHistograms;
+
+    // 点所在格子的范围，用于限制k近邻的搜索圈数
+    int32_t m_MinCell[3] = { 0, 0, 0 };
+    int32_t m_MaxCell[3] = { 0, 0, 0 };
+};
+
+// 模板方法实现
+template<typename Func>
+void SpatialHashGrid::ForEachInRadius(const Vector3& center, float radius, Func&& func) const {
+    if (m_SortedIndices.empty() || radius < 0.0f) {
+        return;
+    }
+
+    const Vector3 query(center.x, m_Planar ? 0.0f : center.y, center.z);
+    const float radiusSq = radius * radius;
+    int32_t minX, minY, minZ, maxX, maxY, maxZ;
+    ComputeCell(Vector3(query.x - radius, query.y - radius, query.z - radius), minX, minY, minZ);
+    ComputeCell(Vector3(query.x + radius, query.y + radius, query.z + radius), maxX, maxY, maxZ);
+
+    for (int32_t cellY = minY; cellY <= maxY; ++cellY) {
+        for (int32_t cellZ = minZ; cellZ <= maxZ; ++cellZ) {
+            for (int32_t cellX = minX; cellX <= maxX; ++cellX) {
+                const uint64_t key = PackCell(cellX, cellY, cellZ);
+                const uint32_t bucket = HashKey(key);
+                for (uint32_t i = m_BucketStart[bucket]; i < m_BucketStart[bucket + 1]; ++i) {
+                    if (m_SortedKeys[i] != key) {
+                        continue;
+                    }
+                    const Vector3& position = m_SortedPositions[i];
+                    const float dx = position.x - query.x;
+                    const float dy = position.y - query.y;
+                    const float dz = position.z - query.z;
+                    const float distSq = dx * dx + dy * dy + dz * dz;
+                    if (distSq <= radiusSq) {
+                        func(m_SortedIndices[i], distSq);
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace PLE
@@ -5,6 +5,7 @@
 
 // 修改包含路径，使用更明确的路径
 #include "Core/Engine.h"  // 使用项目相对路径而不是文件相对路径
+#include "Core/JobSystem.h"
 #include <chrono>
 #include <thread>
 #include <iostream>
@@ -45,6 +46,12 @@ bool Engine::Initialize(const EngineConfig& config) {
     }
 
     m_Config = config;
+
+    // 初始化任务系统
+    if (!JobSystem::GetInstance().Initialize()) {
+        std::cerr << "初始化任务系统失败！" << std::endl;
+        return false;
+    }
     
     // 创建窗口（这里需要实现Window类）
     // m_Window = Window::Create(config.applicationName, config.windowWidth, config.windowHeight, config.fullscreen);
@@ -144,6 +151,9 @@ void Engine::Shutdown() {
         m_Window = nullptr;
     }
 
+    // 关闭任务系统
+    JobSystem::GetInstance().Shutdown();
+
     m_Initialized = false;
     std::cout << "引擎已关闭！" << std::endl;
 }
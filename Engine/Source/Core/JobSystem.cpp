@@ -0,0 +1,155 @@
+/**
+ * @file JobSystem.cpp
+ * @brief 任务系统实现
+ */
+
+#include "Core/JobSystem.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace PLE {
+
+JobSystem& JobSystem::GetInstance() {
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::~JobSystem() {
+    Shutdown();
+}
+
+bool JobSystem::Initialize(uint32_t workerCount) {
+    if (m_Initialized) {
+        std::cerr << "任务系统已经初始化！" << std::endl;
+        return false;
+    }
+
+    if (workerCount == 0) {
+        uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    m_Stopping = false;
+    m_Workers.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        m_Workers.emplace_back(&JobSystem::WorkerLoop, this);
+    }
+
+    m_Initialized = true;
+    return true;
+}
+
+void JobSystem::Shutdown() {
+    if (!m_Initialized) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
+        m_Stopping = true;
+    }
+    m_QueueCondition.notify_all();
+
+    for (auto& worker : m_Workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_Workers.clear();
+    m_Initialized = false;
+}
+
+std::future<void> JobSystem::Submit(std::function<void()> job) {
+    auto task = std::make_shared<std::packaged_task<void()>>(std::move(job));
+    std::future<void> future = task->get_future();
+
+    if (!m_Initialized) {
+        (*task)();
+        return future;
+    }
+
+    Enqueue([task]() { (*task)(); });
+    return future;
+}
+
+void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, const std::function<void(uint32_t begin, uint32_t end)>& func) {
+    if (count == 0) {
+        return;
+    }
+
+    batchSize = std::max(batchSize, 1u);
+    uint32_t batchCount = (count + batchSize - 1) / batchSize;
+
+    if (!m_Initialized || batchCount == 1) {
+        func(0, count);
+        return;
+    }
+
+    // 批次状态由共享指针持有，晚到的辅助任务取不到批次即直接返回
+    struct BatchState {
+        std::atomic<uint32_t> nextBatch{0};
+        std::atomic<uint32_t> finishedBatches{0};
+        std::mutex doneMutex;
+        std::condition_variable doneCondition;
+    };
+
+    auto state = std::make_shared<BatchState>();
+    const std::function<void(uint32_t, uint32_t)>* funcPtr = &func;
+
+    auto runBatches = [state, funcPtr, count, batchSize, batchCount]() {
+        for (;;) {
+            uint32_t batch = state->nextBatch.fetch_add(1, std::memory_order_relaxed);
+            if (batch >= batchCount) {
+                return;
+            }
+            uint32_t begin = batch * batchSize;
+            uint32_t end = std::min(begin + batchSize, count);
+            (*funcPtr)(begin, end);
+
+            if (state->finishedBatches.fetch_add(1, std::memory_order_acq_rel) + 1 == batchCount) {
+                std::lock_guard<std::mutex> lock(state->doneMutex);
+                state->doneCondition.notify_all();
+            }
+        }
+    };
+
+    uint32_t helperCount = std::min(GetWorkerCount(), batchCount - 1);
+    for (uint32_t i = 0; i < helperCount; ++i) {
+        Enqueue(runBatches);
+    }
+
+    // 调用线程同样参与执行
+    runBatches();
+
+    std::unique_lock<std::mutex> lock(state->doneMutex);
+    state->doneCondition.wait(lock, [&state, batchCount]() {
+        return state->finishedBatches.load(std::memory_order_acquire) == batchCount;
+    });
+}
+
+void JobSystem::WorkerLoop() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_QueueMutex);
+            m_QueueCondition.wait(lock, [this]() { return m_Stopping || !m_Queue.empty(); });
+            if (m_Queue.empty()) {
+                return;
+            }
+            job = std::move(m_Queue.front());
+            m_Queue.pop_front();
+        }
+        job();
+    }
+}
+
+void JobSystem::Enqueue(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
+        m_Queue.push_back(std::move(job));
+    }
+    m_QueueCondition.notify_one();
+}
+
+} // namespace PLE
@@ -0,0 +1,399 @@
+/**
+ * @file Crowd.cpp
+ * @brief 人群模拟（ORCA局部避让）实现
+ */
+
+#include "Navigation/Crowd.h"
+#include "Core/JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace PLE {
+
+namespace {
+
+constexpr float RVO_EPSILON = 0.00001f;
+
+float Det(const Vector2& a, const Vector2& b) {
+    return a.x * b.y - a.y * b.x;
+}
+
+Vector2 ToPlane(const Vector3& v) {
+    return Vector2(v.x, v.z);
+}
+
+} // namespace
+
+Crowd::Crowd(const CrowdConfig& config)
+    : m_Config(config)
+    , m_Grid(1.0f, true) {
+    m_Config.batchSize = std::max<uint32_t>(m_Config.batchSize, 1);
+}
+
+CrowdAgentId Crowd::AddAgent(const Vector3& position, const CrowdAgentParams& params) {
+    CrowdAgentId id;
+    if (!m_FreeIds.empty()) {
+        id = m_FreeIds.back();
+        m_FreeIds.pop_back();
+    } else {
+        id = static_cast<CrowdAgentId>(m_IdToIndex.size());
+        m_IdToIndex.push_back(0);
+    }
+
+    m_IdToIndex[id] = static_cast<uint32_t>(m_Positions.size());
+    m_Positions.push_back(position);
+    m_Velocities.push_back(Vector2::Zero());
+    m_NewVelocities.push_back(Vector2::Zero());
+    m_PreferredVelocities.push_back(Vector2::Zero());
+    m_Targets.push_back(position);
+    m_Steering.push_back(SteeringMode::None);
+    m_Params.push_back(params);
+    m_IndexToId.push_back(id);
+    return id;
+}
+
+void Crowd::RemoveAgent(CrowdAgentId id) {
+    if (!IsValidAgent(id)) {
+        return;
+    }
+
+    uint32_t index = m_IdToIndex[id];
+    uint32_t last = static_cast<uint32_t>(m_Positions.size() - 1);
+    if (index != last) {
+        m_Positions[index] = m_Positions[last];
+        m_Velocities[index] = m_Velocities[last];
+        m_NewVelocities[index] = m_NewVelocities[last];
+        m_PreferredVelocities[index] = m_PreferredVelocities[last];
+        m_Targets[index] = m_Targets[last];
+        m_Steering[index] = m_Steering[last];
+        m_Params[index] = m_Params[last];
+        m_IndexToId[index] = m_IndexToId[last];
+        m_IdToIndex[m_IndexToId[index]] = index;
+    }
+
+    m_Positions.pop_back();
+    m_Velocities.pop_back();
+    m_NewVelocities.pop_back();
+    m_PreferredVelocities.pop_back();
+    m_Targets.pop_back();
+    m_Steering.pop_back();
+    m_Params.pop_back();
+    m_IndexToId.pop_back();
+    m_IdToIndex[id] = CROWD_INVALID_AGENT;
+    m_FreeIds.push_back(id);
+}
+
+void Crowd::SetAgentTarget(CrowdAgentId id, const Vector3& target) {
+    if (IsValidAgent(id)) {
+        uint32_t index = m_IdToIndex[id];
+        m_Targets[index] = target;
+        m_Steering[index] = SteeringMode::Target;
+    }
+}
+
+void Crowd::SetAgentPreferredVelocity(CrowdAgentId id, const Vector2& velocity) {
+    if (IsValidAgent(id)) {
+        uint32_t index = m_IdToIndex[id];
+        m_PreferredVelocities[index] = velocity;
+        m_Steering[index] = SteeringMode::Velocity;
+    }
+}
+
+void Crowd::StopAgent(CrowdAgentId id) {
+    if (IsValidAgent(id)) {
+        m_Steering[m_IdToIndex[id]] = SteeringMode::None;
+    }
+}
+
+void Crowd::SetAgentParams(CrowdAgentId id, const CrowdAgentParams& params) {
+    if (IsValidAgent(id)) {
+        m_Params[m_IdToIndex[id]] = params;
+    }
+}
+
+void Crowd::SetAgentPosition(CrowdAgentId id, const Vector3& position) {
+    if (IsValidAgent(id)) {
+        m_Positions[m_IdToIndex[id]] = position;
+    }
+}
+
+Vector3 Crowd::GetAgentPosition(CrowdAgentId id) const {
+    return IsValidAgent(id) ? m_Positions[m_IdToIndex[id]] : Vector3::Zero();
+}
+
+Vector3 Crowd::GetAgentVelocity(CrowdAgentId id) const {
+    if (!IsValidAgent(id)) {
+        return Vector3::Zero();
+    }
+    const Vector2& velocity = m_Velocities[m_IdToIndex[id]];
+    return Vector3(velocity.x, 0.0f, velocity.y);
+}
+
+bool Crowd::IsValidAgent(CrowdAgentId id) const {
+    return id < m_IdToIndex.size() && m_IdToIndex[id] != CROWD_INVALID_AGENT;
+}
+
+void Crowd::Update(float deltaTime) {
+    const uint32_t count = GetAgentCount();
+    if (count == 0 || deltaTime <= 0.0f) {
+        return;
+    }
+
+    BuildSpatialHash();
+
+    JobSystem::GetInstance().ParallelFor(count, m_Config.batchSize, [this, deltaTime](uint32_t begin, uint32_t end) {
+        thread_local std::vector<std::pair<float, uint32_t>> neighbors;
+        thread_local std::vector<OrcaLine> lines;
+        for (uint32_t i = begin; i < end; ++i) {
+            ComputePreferredVelocity(i, deltaTime);
+            ComputeNewVelocity(i, deltaTime, neighbors, lines);
+        }
+    });
+
+    // 所有代理求解完成后统一积分，保证求解阶段读取的是同一帧的状态
+    JobSystem::GetInstance().ParallelFor(count, m_Config.batchSize * 4, [this, deltaTime](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            m_Velocities[i] = m_NewVelocities[i];
+            m_Positions[i].x += m_Velocities[i].x * deltaTime;
+            m_Positions[i].z += m_Velocities[i].y * deltaTime;
+        }
+    });
+}
+
+void Crowd::BuildSpatialHash() {
+    // 格子尺寸取最大邻居搜索距离，查询时最多覆盖3x3个格子
+    float maxNeighborDist = 0.0f;
+    for (const CrowdAgentParams& params : m_Params) {
+        maxNeighborDist = std::max(maxNeighborDist, params.neighborDist);
+    }
+    m_Grid.SetCellSize(std::max(maxNeighborDist, 0.01f));
+    m_Grid.Build(m_Positions);
+}
+
+void Crowd::ComputePreferredVelocity(uint32_t index, float deltaTime) {
+    if (m_Steering[index] == SteeringMode::Velocity) {
+        return;
+    }
+    if (m_Steering[index] == SteeringMode::None) {
+        m_PreferredVelocities[index] = Vector2::Zero();
+        return;
+    }
+
+    Vector2 toTarget = ToPlane(m_Targets[index]) - ToPlane(m_Positions[index]);
+    float distance = toTarget.Length();
+    if (distance <= m_Config.arrivalDistance) {
+        m_PreferredVelocities[index] = Vector2::Zero();
+        return;
+    }
+    // 接近目标时减速，避免一帧越过目标
+    float speed = std::min(m_Params[index].maxSpeed, distance / deltaTime);
+    m_PreferredVelocities[index] = toTarget * (speed / distance);
+
+    // 按代理ID施加极小的固定扰动，打破完全对称场景下的相互僵持
+    uint32_t hash = m_IndexToId[index] * 2654435761u;
+    float angle = static_cast<float>(hash >> 8) * (6.2831853f / 16777216.0f);
+    m_PreferredVelocities[index] += Vector2(std::cos(angle), std::sin(angle)) * 0.001f;
+}
+
+void Crowd::FindNeighbors(uint32_t index, std::vector<std::pair<float, uint32_t>>& neighbors) const {
+    neighbors.clear();
+    const CrowdAgentParams& params = m_Params[index];
+    if (params.maxNeighbors == 0) {
+        return;
+    }
+
+    float rangeSq = params.neighborDist * params.neighborDist;
+    m_Grid.ForEachInRadius(m_Positions[index], params.neighborDist, [&](uint32_t other, float distSq) {
+        if (other == index || distSq >= rangeSq) {
+            return;
+        }
+
+        // 按距离有序插入，满员后收缩搜索范围
+        if (neighbors.size() < params.maxNeighbors) {
+            neighbors.emplace_back(distSq, other);
+        }
+        size_t i = neighbors.size() - 1;
+        while (i != 0 && distSq < neighbors[i - 1].first) {
+            neighbors[i] = neighbors[i - 1];
+            --i;
+        }
+        neighbors[i] = std::make_pair(distSq, other);
+        if (neighbors.size() == params.maxNeighbors) {
+            rangeSq = neighbors.back().first;
+        }
+    });
+}
+
+void Crowd::ComputeNewVelocity(uint32_t index, float deltaTime, std::vector<std::pair<float, uint32_t>>& neighbors, std::vector<OrcaLine>& lines) {
+    FindNeighbors(index, neighbors);
+    lines.clear();
+
+    const CrowdAgentParams& params = m_Params[index];
+    const Vector2 position = ToPlane(m_Positions[index]);
+    const Vector2 velocity = m_Velocities[index];
+    const float invTimeHorizon = 1.0f / params.timeHorizon;
+
+    for (const auto& neighbor : neighbors) {
+        uint32_t other = neighbor.second;
+        const Vector2 relativePosition = ToPlane(m_Positions[other]) - position;
+        const Vector2 relativeVelocity = velocity - m_Velocities[other];
+        const float distSq = relativePosition.LengthSquared();
+        const float combinedRadius = params.radius + m_Params[other].radius;
+        const float combinedRadiusSq = combinedRadius * combinedRadius;
+
+        OrcaLine line;
+        Vector2 u;
+
+        if (distSq > combinedRadiusSq) {
+            // 尚未碰撞：w为相对速度到截断圆心的向量
+            const Vector2 w = relativeVelocity - relativePosition * invTimeHorizon;
+            const float wLengthSq = w.LengthSquared();
+            const float dotProduct1 = w.Dot(relativePosition);
+
+            if (dotProduct1 < 0.0f && dotProduct1 * dotProduct1 > combinedRadiusSq * wLengthSq) {
+                // 投影到截断圆
+                const float wLength = std::sqrt(wLengthSq);
+                const Vector2 unitW = w / wLength;
+                line.direction = Vector2(unitW.y, -unitW.x);
+                u = unitW * (combinedRadius * invTimeHorizon - wLength);
+            } else {
+                // 投影到速度障碍锥的两条腿之一
+                const float leg = std::sqrt(distSq - combinedRadiusSq);
+                if (Det(relativePosition, w) > 0.0f) {
+                    line.direction = Vector2(relativePosition.x * leg - relativePosition.y * combinedRadius,
+                                             relativePosition.x * combinedRadius + relativePosition.y * leg) / distSq;
+                } else {
+                    line.direction = Vector2(-(relativePosition.x * leg + relativePosition.y * combinedRadius),
+                                             -(-relativePosition.x * combinedRadius + relativePosition.y * leg)) / distSq;
+                }
+                const float dotProduct2 = relativeVelocity.Dot(line.direction);
+                u = line.direction * dotProduct2 - relativeVelocity;
+            }
+        } else {
+            // 已经重叠：在本帧内分离
+            const float invTimeStep = 1.0f / deltaTime;
+            const Vector2 w = relativeVelocity - relativePosition * invTimeStep;
+            const float wLength = w.Length();
+            const Vector2 unitW = wLength > RVO_EPSILON ? w / wLength : Vector2(1.0f, 0.0f);
+            line.direction = Vector2(unitW.y, -unitW.x);
+            u = unitW * (combinedRadius * invTimeStep - wLength);
+        }
+
+        // 双方各承担一半的避让责任
+        line.point = velocity + u * 0.5f;
+        lines.push_back(line);
+    }
+
+    Vector2 newVelocity;
+    size_t lineFail = LinearProgram2(lines, params.maxSpeed, m_PreferredVelocities[index], false, newVelocity);
+    if (lineFail < lines.size()) {
+        LinearProgram3(lines, lineFail, params.maxSpeed, newVelocity);
+    }
+    m_NewVelocities[index] = newVelocity;
+}
+
+bool Crowd::LinearProgram1(const std::vector<OrcaLine>& lines, size_t lineNo, float radius, const Vector2& optVelocity, bool directionOpt, Vector2& result) {
+    const OrcaLine& line = lines[lineNo];
+    const float dotProduct = line.point.Dot(line.direction);
+    const float discriminant = dotProduct * dotProduct + radius * radius - line.point.LengthSquared();
+    if (discriminant < 0.0f) {
+        // 最大速度圆完全不满足该约束
+        return false;
+    }
+
+    const float sqrtDiscriminant = std::sqrt(discriminant);
+    float tLeft = -dotProduct - sqrtDiscriminant;
+    float tRight = -dotProduct + sqrtDiscriminant;
+
+    for (size_t i = 0; i < lineNo; ++i) {
+        const float denominator = Det(line.direction, lines[i].direction);
+        const float numerator = Det(lines[i].direction, line.point - lines[i].point);
+
+        if (std::fabs(denominator) <= RVO_EPSILON) {
+            // 两条线（近似）平行
+            if (numerator < 0.0f) {
+                return false;
+            }
+            continue;
+        }
+
+        const float t = numerator / denominator;
+        if (denominator >= 0.0f) {
+            tRight = std::min(tRight, t);
+        } else {
+            tLeft = std::max(tLeft, t);
+        }
+        if (tLeft > tRight) {
+            return false;
+        }
+    }
+
+    if (directionOpt) {
+        result = optVelocity.Dot(line.direction) > 0.0f ? line.point + line.direction * tRight : line.point + line.direction * tLeft;
+    } else {
+        const float t = std::clamp(line.direction.Dot(optVelocity - line.point), tLeft, tRight);
+        result = line.point + line.direction * t;
+    }
+    return true;
+}
+
+size_t Crowd::LinearProgram2(const std::vector<OrcaLine>& lines, float radius, const Vector2& optVelocity, bool directionOpt, Vector2& result) {
+    if (directionOpt) {
+        result = optVelocity * radius;
+    } else if (optVelocity.LengthSquared() > radius * radius) {
+        result = optVelocity.Normalized() * radius;
+    } else {
+        result = optVelocity;
+    }
+
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (Det(lines[i].direction, lines[i].point - result) > 0.0f) {
+            // 当前结果违反约束i，在线i上重新求解
+            const Vector2 tempResult = result;
+            if (!LinearProgram1(lines, i, radius, optVelocity, directionOpt, result)) {
+                result = tempResult;
+                return i;
+            }
+        }
+    }
+    return lines.size();
+}
+
+void Crowd::LinearProgram3(const std::vector<OrcaLine>& lines, size_t beginLine, float radius, Vector2& result) {
+    // 不可行时求使最大违反距离最小的速度
+    float distance = 0.0f;
+    std::vector<OrcaLine> projectedLines;
+
+    for (size_t i = beginLine; i < lines.size(); ++i) {
+        if (Det(lines[i].direction, lines[i].point - result) <= distance) {
+            continue;
+        }
+
+        projectedLines.clear();
+        for (size_t j = 0; j < i; ++j) {
+            OrcaLine line;
+            const float determinant = Det(lines[i].direction, lines[j].direction);
+            if (std::fabs(determinant) <= RVO_EPSILON) {
+                if (lines[i].direction.Dot(lines[j].direction) > 0.0f) {
+                    // 同向平行
+                    continue;
+                }
+                line.point = (lines[i].point + lines[j].point) * 0.5f;
+            } else {
+                line.point = lines[i].point + lines[i].direction * (Det(lines[j].direction, lines[i].point - lines[j].point) / determinant);
+            }
+            line.direction = (lines[j].direction - lines[i].direction).Normalized();
+            projectedLines.push_back(line);
+        }
+
+        const Vector2 tempResult = result;
+        if (LinearProgram2(projectedLines, radius, Vector2(-lines[i].direction.y, lines[i].direction.x), true, result) < projectedLines.size()) {
+            // 理论上不会发生，数值误差时保留原结果
+            result = tempResult;
+        }
+        distance = Det(lines[i].direction, lines[i].point - result);
+    }
+}
+
+} // namespace PLE
@@ -0,0 +1,62 @@
+/**
+ * @file CrowdAgent.cpp
+ * @brief 人群代理组件实现
+ */
+
+#include "Navigation/CrowdAgent.h"
+
+namespace PLE {
+
+CrowdAgent::CrowdAgent(std::shared_ptr<Entity> entity, std::shared_ptr<Crowd> crowd, const CrowdAgentParams& params)
+    : Component(entity)
+    , m_Crowd(crowd)
+    , m_Params(params) {
+}
+
+void CrowdAgent::Initialize() {
+    auto entity = GetEntity();
+    if (!m_Crowd || !entity) {
+        return;
+    }
+    m_AgentId = m_Crowd->AddAgent(entity->GetTransform()->GetWorldPosition(), m_Params);
+}
+
+void CrowdAgent::Update(float deltaTime) {
+    (void)deltaTime;
+    auto entity = GetEntity();
+    if (!m_Crowd || !entity || !m_Crowd->IsValidAgent(m_AgentId)) {
+        return;
+    }
+    entity->GetTransform()->SetWorldPosition(m_Crowd->GetAgentPosition(m_AgentId));
+}
+
+void CrowdAgent::Destroy() {
+    if (m_Crowd) {
+        m_Crowd->RemoveAgent(m_AgentId);
+    }
+    m_AgentId = CROWD_INVALID_AGENT;
+}
+
+void CrowdAgent::SetTarget(const Vector3& target) {
+    if (m_Crowd) {
+        m_Crowd->SetAgentTarget(m_AgentId, target);
+    }
+}
+
+void CrowdAgent::SetPreferredVelocity(const Vector2& velocity) {
+    if (m_Crowd) {
+        m_Crowd->SetAgentPreferredVelocity(m_AgentId, velocity);
+    }
+}
+
+void CrowdAgent::Stop() {
+    if (m_Crowd) {
+        m_Crowd->StopAgent(m_AgentId);
+    }
+}
+
+Vector3 CrowdAgent::GetVelocity() const {
+    return m_Crowd ? m_Crowd->GetAgentVelocity(m_AgentId) : Vector3::Zero();
+}
+
+} // namespace PLE
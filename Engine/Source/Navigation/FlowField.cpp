@@ -0,0 +1,385 @@
+/**
+ * @file FlowField.cpp
+ * @brief 流场导航实现
+ */
+
+#include "Navigation/FlowField.h"
+#include "Navigation/NavMesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+
+#ifdef PLE_SIMD_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace PLE {
+
+namespace {
+
+constexpr float INF = std::numeric_limits<float>::infinity();
+constexpr float DIAGONAL = 1.41421356f;
+constexpr uint8_t NO_DIRECTION = 0xFF;
+
+// 8邻域偏移，偶数为轴向，奇数为对角
+const int DIR_X[8] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+const int DIR_Z[8] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+
+const Vector2 DIR_VECTORS[8] = {
+    Vector2(1.0f, 0.0f), Vector2(0.70710678f, 0.70710678f),
+    Vector2(0.0f, 1.0f), Vector2(-0.70710678f, 0.70710678f),
+    Vector2(-1.0f, 0.0f), Vector2(-0.70710678f, -0.70710678f),
+    Vector2(0.0f, -1.0f), Vector2(0.70710678f, -0.70710678f)
+};
+
+float ToStepCost(uint8_t cost) {
+    if (cost == FlowField::BLOCKED_COST) {
+        return INF;
+    }
+    return static_cast<float>(std::max<uint8_t>(cost, 1));
+}
+
+/**
+ * @brief 从相邻行传播到当前行（轴向加两个对角方向），返回是否有值变小
+ */
+bool RelaxRowFromNeighborRow(float* current, const float* source, const float* costs, const float* sourceCosts, int width) {
+    bool changed = false;
+    int x = 1;
+
+#ifdef PLE_SIMD_SSE2
+    const __m128 infinity = _mm_set1_ps(INF);
+    const __m128 diagonal = _mm_set1_ps(DIAGONAL);
+    __m128 changedMask = _mm_setzero_ps();
+    for (; x <= width; x += 4) {
+        __m128 value = _mm_loadu_ps(current + x);
+        __m128 cost = _mm_loadu_ps(costs + x);
+        __m128 diagonalCost = _mm_mul_ps(cost, diagonal);
+
+        __m128 straight = _mm_add_ps(_mm_loadu_ps(source + x), cost);
+        __m128 left = _mm_add_ps(_mm_loadu_ps(source + x - 1), diagonalCost);
+        __m128 right = _mm_add_ps(_mm_loadu_ps(source + x + 1), diagonalCost);
+
+        // 禁止对角线穿过不可通行格子的拐角
+        __m128 sourceCost = _mm_loadu_ps(sourceCosts + x);
+        __m128 leftBlocked = _mm_cmpeq_ps(_mm_max_ps(_mm_loadu_ps(costs + x - 1), sourceCost), infinity);
+        __m128 rightBlocked = _mm_cmpeq_ps(_mm_max_ps(_mm_loadu_ps(costs + x + 1), sourceCost), infinity);
+        left = _mm_max_ps(left, _mm_and_ps(leftBlocked, infinity));
+        right = _mm_max_ps(right, _mm_and_ps(rightBlocked, infinity));
+
+        __m128 best = _mm_min_ps(value, _mm_min_ps(straight, _mm_min_ps(left, right)));
+        changedMask = _mm_or_ps(changedMask, _mm_cmplt_ps(best, value));
+        _mm_storeu_ps(current + x, best);
+    }
+    changed = _mm_movemask_ps(changedMask) != 0;
+#endif
+
+    for (; x <= width; ++x) {
+        float cost = costs[x];
+        float best = std::min(current[x], source[x] + cost);
+        if (costs[x - 1] != INF && sourceCosts[x] != INF) {
+            best = std::min(best, source[x - 1] + cost * DIAGONAL);
+        }
+        if (costs[x + 1] != INF && sourceCosts[x] != INF) {
+            best = std::min(best, source[x + 1] + cost * DIAGONAL);
+        }
+        if (best < current[x]) {
+            current[x] = best;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+} // namespace
+
+FlowField::FlowField(int width, int height, float cellSize, const Vector3& origin)
+    : m_Width(std::max(width, 1))
+    , m_Height(std::max(height, 1))
+    , m_CellSize(cellSize)
+    , m_Origin(origin) {
+    // 左右各一列边界，再补齐到4的倍数并留出SIMD越界读取的余量
+    m_Stride = ((static_cast<size_t>(m_Width) + 2 + 3) & ~static_cast<size_t>(3)) + 4;
+    const size_t paddedSize = m_Stride * static_cast<size_t>(m_Height + 2);
+
+    m_Costs.assign(static_cast<size_t>(m_Width) * m_Height, 1);
+    m_StepCosts.assign(paddedSize, INF);
+    m_Integration.assign(paddedSize, INF);
+    m_Directions.assign(static_cast<size_t>(m_Width) * m_Height, NO_DIRECTION);
+    for (int z = 0; z < m_Height; ++z) {
+        for (int x = 0; x < m_Width; ++x) {
+            m_StepCosts[PaddedIndex(x, z)] = 1.0f;
+        }
+    }
+}
+
+void FlowField::SetCost(int x, int z, uint8_t cost) {
+    if (x < 0 || z < 0 || x >= m_Width || z >= m_Height) {
+        return;
+    }
+
+    uint8_t& current = m_Costs[static_cast<size_t>(z) * m_Width + x];
+    if (current == cost) {
+        return;
+    }
+    if (m_Computed) {
+        if (cost > current) {
+            m_ChangedCells.push_back(z * m_Width + x);
+        } else {
+            m_CostsDecreased = true;
+        }
+    }
+    current = cost;
+    m_StepCosts[PaddedIndex(x, z)] = ToStepCost(cost);
+}
+
+void FlowField::FillCostsFromNavMesh(const NavMesh& navMesh) {
+    std::fill(m_Costs.begin(), m_Costs.end(), BLOCKED_COST);
+    for (uint32_t t = 0; t < navMesh.GetTileCount(); ++t) {
+        for (const NavPoly& poly : navMesh.GetTile(t).polys) {
+            // 格子中心落在多边形内即视为可通行
+            int x0 = static_cast<int>(std::ceil((poly.vertices[0].x - m_Origin.x) / m_CellSize - 0.5f));
+            int x1 = static_cast<int>(std::floor((poly.vertices[2].x - m_Origin.x) / m_CellSize - 0.5f));
+            int z0 = static_cast<int>(std::ceil((poly.vertices[0].z - m_Origin.z) / m_CellSize - 0.5f));
+            int z1 = static_cast<int>(std::floor((poly.vertices[2].z - m_Origin.z) / m_CellSize - 0.5f));
+            x0 = std::max(x0, 0);
+            z0 = std::max(z0, 0);
+            x1 = std::min(x1, m_Width - 1);
+            z1 = std::min(z1, m_Height - 1);
+            for (int z = z0; z <= z1; ++z) {
+                std::fill(m_Costs.begin() + z * m_Width + x0, m_Costs.begin() + z * m_Width + x1 + 1, static_cast<uint8_t>(1));
+            }
+        }
+    }
+
+    for (int z = 0; z < m_Height; ++z) {
+        for (int x = 0; x < m_Width; ++x) {
+            m_StepCosts[PaddedIndex(x, z)] = ToStepCost(m_Costs[static_cast<size_t>(z) * m_Width + x]);
+        }
+    }
+    m_Computed = false;
+}
+
+void FlowField::SetGoal(const Vector3& goal) {
+    SetGoals({ goal });
+}
+
+void FlowField::SetGoals(const std::vector<Vector3>& goals) {
+    m_GoalCells.clear();
+    for (const Vector3& goal : goals) {
+        int x, z;
+        if (WorldToCell(goal, x, z)) {
+            m_GoalCells.push_back(z * m_Width + x);
+        }
+    }
+    m_GoalsDirty = true;
+}
+
+void FlowField::Compute() {
+    ResetIntegration();
+    Propagate();
+    BuildDirections();
+    m_ChangedCells.clear();
+    m_CostsDecreased = false;
+    m_GoalsDirty = false;
+    m_Computed = true;
+}
+
+void FlowField::Update() {
+    if (!m_Computed || m_GoalsDirty) {
+        Compute();
+        return;
+    }
+    if (m_ChangedCells.empty() && !m_CostsDecreased) {
+        return;
+    }
+
+    // 代价上升：先重置经过这些格子的下游，再从现有值继续收敛；代价下降可直接收敛
+    InvalidateDownstream();
+    Propagate();
+    BuildDirections();
+    m_ChangedCells.clear();
+    m_CostsDecreased = false;
+}
+
+Vector2 FlowField::Sample(const Vector3& position) const {
+    int x, z;
+    if (!WorldToCell(position, x, z)) {
+        return Vector2::Zero();
+    }
+    uint8_t direction = m_Directions[static_cast<size_t>(z) * m_Width + x];
+    return direction == NO_DIRECTION ? Vector2::Zero() : DIR_VECTORS[direction];
+}
+
+float FlowField::GetIntegration(int x, int z) const {
+    if (x < 0 || z < 0 || x >= m_Width || z >= m_Height) {
+        return INF;
+    }
+    return m_Integration[PaddedIndex(x, z)];
+}
+
+bool FlowField::WorldToCell(const Vector3& position, int& x, int& z) const {
+    x = static_cast<int>(std::floor((position.x - m_Origin.x) / m_CellSize));
+    z = static_cast<int>(std::floor((position.z - m_Origin.z) / m_CellSize));
+    return x >= 0 && z >= 0 && x < m_Width && z < m_Height;
+}
+
+void FlowField::ResetIntegration() {
+    std::fill(m_Integration.begin(), m_Integration.end(), INF);
+    for (int cell : m_GoalCells) {
+        size_t index = PaddedIndex(cell % m_Width, cell / m_Width);
+        if (m_StepCosts[index] != INF) {
+            m_Integration[index] = 0.0f;
+        }
+    }
+}
+
+void FlowField::Propagate() {
+    // 前向与后向扫描交替进行，直到没有任何格子变小
+    bool changed = true;
+    while (changed) {
+        changed = SweepRows(true);
+        changed = SweepRows(false) || changed;
+    }
+}
+
+bool FlowField::SweepRows(bool forward) {
+    bool changed = false;
+    for (int i = 0; i < m_Height; ++i) {
+        int z = forward ? i : m_Height - 1 - i;
+        int source = forward ? z - 1 : z + 1;
+        if (source >= 0 && source < m_Height) {
+            changed = RelaxRowFromNeighborRow(&m_Integration[PaddedIndex(-1, z)], &m_Integration[PaddedIndex(-1, source)],
+                                              &m_StepCosts[PaddedIndex(-1, z)], &m_StepCosts[PaddedIndex(-1, source)],
+                                              m_Width) || changed;
+        }
+        changed = SweepColumns(z) || changed;
+    }
+    return changed;
+}
+
+bool FlowField::SweepColumns(int z) {
+    float* row = &m_Integration[PaddedIndex(-1, z)];
+    const float* costs = &m_StepCosts[PaddedIndex(-1, z)];
+    bool changed = false;
+
+    for (int x = 2; x <= m_Width; ++x) {
+        float candidate = row[x - 1] + costs[x];
+        if (candidate < row[x]) {
+            row[x] = candidate;
+            changed = true;
+        }
+    }
+    for (int x = m_Width - 1; x >= 1; --x) {
+        float candidate = row[x + 1] + costs[x];
+        if (candidate < row[x]) {
+            row[x] = candidate;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+void FlowField::InvalidateDownstream() {
+    std::vector<uint8_t> isGoal(m_Costs.size(), 0);
+    for (int cell : m_GoalCells) {
+        isGoal[static_cast<size_t>(cell)] = 1;
+    }
+
+    std::vector<uint8_t> visited(m_Costs.size(), 0);
+    std::deque<int> queue;
+    auto enqueue = [&](int cell) {
+        if (!visited[static_cast<size_t>(cell)]) {
+            visited[static_cast<size_t>(cell)] = 1;
+            queue.push_back(cell);
+        }
+    };
+    for (int cell : m_ChangedCells) {
+        enqueue(cell);
+
+        // 变为不可通行的格子还会阻断相邻格子贴着其拐角的对角移动
+        int x = cell % m_Width;
+        int z = cell / m_Width;
+        for (int d = 0; d < 8; d += 2) {
+            int nx = x + DIR_X[d];
+            int nz = z + DIR_Z[d];
+            if (nx < 0 || nz < 0 || nx >= m_Width || nz >= m_Height) {
+                continue;
+            }
+            uint8_t direction = m_Directions[static_cast<size_t>(nz) * m_Width + nx];
+            if (direction == NO_DIRECTION || !(direction & 1)) {
+                continue;
+            }
+            if (nx + DIR_X[direction] == x || nz + DIR_Z[direction] == z) {
+                enqueue(nz * m_Width + nx);
+            }
+        }
+    }
+
+    // 沿方向场反向遍历：所有流经变化格子的格子都需要重新计算
+    while (!queue.empty()) {
+        int cell = queue.front();
+        queue.pop_front();
+        int x = cell % m_Width;
+        int z = cell / m_Width;
+        if (!isGoal[static_cast<size_t>(cell)]) {
+            m_Integration[PaddedIndex(x, z)] = INF;
+        }
+
+        for (int d = 0; d < 8; ++d) {
+            int nx = x + DIR_X[d];
+            int nz = z + DIR_Z[d];
+            if (nx < 0 || nz < 0 || nx >= m_Width || nz >= m_Height) {
+                continue;
+            }
+            int neighbor = nz * m_Width + nx;
+            uint8_t direction = m_Directions[static_cast<size_t>(neighbor)];
+            if (visited[static_cast<size_t>(neighbor)] || direction == NO_DIRECTION) {
+                continue;
+            }
+            // 邻居的方向指回当前格子
+            if (DIR_X[direction] == -DIR_X[d] && DIR_Z[direction] == -DIR_Z[d]) {
+                visited[static_cast<size_t>(neighbor)] = 1;
+                queue.push_back(neighbor);
+            }
+        }
+    }
+
+    // 被重置的格子若重新变为目标需保持为0
+    for (int cell : m_GoalCells) {
+        size_t index = PaddedIndex(cell % m_Width, cell / m_Width);
+        m_Integration[index] = m_StepCosts[index] != INF ? 0.0f : INF;
+    }
+}
+
+void FlowField::BuildDirections() {
+    for (int z = 0; z < m_Height; ++z) {
+        for (int x = 0; x < m_Width; ++x) {
+            const size_t index = PaddedIndex(x, z);
+            const float value = m_Integration[index];
+            uint8_t bestDirection = NO_DIRECTION;
+            if (value != INF && value > 0.0f) {
+                // 选择积分值来源的邻居（邻居积分加上进入本格的步进代价最小），
+                // 这样方向场同时也是增量更新时回溯下游所用的前驱树
+                const float cost = m_StepCosts[index];
+                float best = INF;
+                for (int d = 0; d < 8; ++d) {
+                    int nx = x + DIR_X[d];
+                    int nz = z + DIR_Z[d];
+                    if ((d & 1) && (m_StepCosts[PaddedIndex(nx, z)] == INF || m_StepCosts[PaddedIndex(x, nz)] == INF)) {
+                        continue;
+                    }
+                    float candidate = m_Integration[PaddedIndex(nx, nz)] + ((d & 1) ? cost * DIAGONAL : cost);
+                    if (candidate < best) {
+                        best = candidate;
+                        bestDirection = static_cast<uint8_t>(d);
+                    }
+                }
+            }
+            m_Directions[static_cast<size_t>(z) * m_Width + x] = bestDirection;
+        }
+    }
+}
+
+} // namespace PLE
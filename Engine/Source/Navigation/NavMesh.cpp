@@ -0,0 +1,116 @@
+/**
+ * @file NavMesh.cpp
+ * @brief 导航网格实现
+ */
+
+#include "Navigation/NavMesh.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace PLE {
+
+NavMesh::NavMesh(const NavMeshConfig& config)
+    : m_Config(config) {
+    const float tileWorldSize = config.cellSize * static_cast<float>(config.tileSize);
+    m_TileCountX = std::max(1, static_cast<int>(std::ceil((config.boundsMax.x - config.boundsMin.x) / tileWorldSize)));
+    m_TileCountZ = std::max(1, static_cast<int>(std::ceil((config.boundsMax.z - config.boundsMin.z) / tileWorldSize)));
+
+    m_Tiles.resize(static_cast<size_t>(m_TileCountX) * static_cast<size_t>(m_TileCountZ));
+    for (int z = 0; z < m_TileCountZ; ++z) {
+        for (int x = 0; x < m_TileCountX; ++x) {
+            NavMeshTile& tile = m_Tiles[GetTileIndex(x, z)];
+            tile.x = x;
+            tile.z = z;
+            tile.boundsMin = Vector3(config.boundsMin.x + x * tileWorldSize, config.boundsMin.y, config.boundsMin.z + z * tileWorldSize);
+            tile.boundsMax = Vector3(tile.boundsMin.x + tileWorldSize, config.boundsMax.y, tile.boundsMin.z + tileWorldSize);
+        }
+    }
+}
+
+uint32_t NavMesh::GetTileIndex(int x, int z) const {
+    if (x < 0 || z < 0 || x >= m_TileCountX || z >= m_TileCountZ) {
+        return UINT32_MAX;
+    }
+    return static_cast<uint32_t>(z * m_TileCountX + x);
+}
+
+bool NavMesh::WorldToTile(const Vector3& position, int& tileX, int& tileZ) const {
+    const float tileWorldSize = m_Config.cellSize * static_cast<float>(m_Config.tileSize);
+    tileX = static_cast<int>(std::floor((position.x - m_Config.boundsMin.x) / tileWorldSize));
+    tileZ = static_cast<int>(std::floor((position.z - m_Config.boundsMin.z) / tileWorldSize));
+    return tileX >= 0 && tileZ >= 0 && tileX < m_TileCountX && tileZ < m_TileCountZ;
+}
+
+const NavPoly* NavMesh::GetPoly(NavPolyRef ref) const {
+    if (ref == NAV_INVALID_POLY_REF) {
+        return nullptr;
+    }
+    uint32_t tileIndex = GetNavPolyTile(ref);
+    uint32_t polyIndex = GetNavPolyIndex(ref);
+    if (tileIndex >= m_Tiles.size() || polyIndex >= m_Tiles[tileIndex].polys.size()) {
+        return nullptr;
+    }
+    return &m_Tiles[tileIndex].polys[polyIndex];
+}
+
+Vector3 NavMesh::ClosestPointOnPoly(const NavPoly& poly, const Vector3& position) {
+    const Vector3& v0 = poly.vertices[0];
+    const Vector3& v1 = poly.vertices[1];
+    const Vector3& v2 = poly.vertices[2];
+    const Vector3& v3 = poly.vertices[3];
+
+    float x = std::min(std::max(position.x, v0.x), v2.x);
+    float z = std::min(std::max(position.z, v0.z), v2.z);
+
+    // 四个角点高度的双线性插值
+    float u = v2.x > v0.x ? (x - v0.x) / (v2.x - v0.x) : 0.0f;
+    float w = v2.z > v0.z ? (z - v0.z) / (v2.z - v0.z) : 0.0f;
+    float yNear = v0.y + (v3.y - v0.y) * u;
+    float yFar = v1.y + (v2.y - v1.y) * u;
+    return Vector3(x, yNear + (yFar - yNear) * w, z);
+}
+
+NavPolyRef NavMesh::FindNearestPoly(const Vector3& position, const Vector3& extents, Vector3* nearestPoint) const {
+    int minTileX, minTileZ, maxTileX, maxTileZ;
+    WorldToTile(position - extents, minTileX, minTileZ);
+    WorldToTile(position + extents, maxTileX, maxTileZ);
+    minTileX = std::max(minTileX, 0);
+    minTileZ = std::max(minTileZ, 0);
+    maxTileX = std::min(maxTileX, m_TileCountX - 1);
+    maxTileZ = std::min(maxTileZ, m_TileCountZ - 1);
+
+    NavPolyRef best = NAV_INVALID_POLY_REF;
+    float bestDistance = FLT_MAX;
+    for (int tz = minTileZ; tz <= maxTileZ; ++tz) {
+        for (int tx = minTileX; tx <= maxTileX; ++tx) {
+            uint32_t tileIndex = GetTileIndex(tx, tz);
+            const NavMeshTile& tile = m_Tiles[tileIndex];
+            for (uint32_t i = 0; i < tile.polys.size(); ++i) {
+                const NavPoly& poly = tile.polys[i];
+                if (poly.vertices[2].x < position.x - extents.x || poly.vertices[0].x > position.x + extents.x ||
+                    poly.vertices[2].z < position.z - extents.z || poly.vertices[0].z > position.z + extents.z) {
+                    continue;
+                }
+
+                Vector3 closest = ClosestPointOnPoly(poly, position);
+                if (std::abs(closest.y - position.y) > extents.y) {
+                    continue;
+                }
+
+                float distance = (closest - position).LengthSquared();
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = MakeNavPolyRef(tileIndex, i);
+                    if (nearestPoint) {
+                        *nearestPoint = closest;
+                    }
+                }
+            }
+        }
+    }
+    return best;
+}
+
+} // namespace PLE
@@ -0,0 +1,999 @@
+/**
+ * @file NavMeshBuilder.cpp
+ * @brief 导航网格构建器实现
+ */
+
+#include "Navigation/NavMeshBuilder.h"
+#include "Core/JobSystem.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <iostream>
+
+namespace PLE {
+
+namespace {
+
+constexpr uint32_t NOT_CONNECTED = 0xffffffffu;
+constexpr uint32_t UNASSIGNED = 0xffffffffu;
+constexpr int SPAN_MAX_HEIGHT = 0xffff;
+constexpr float PI = 3.14159265358979f;
+
+// 方向：0(-X) 1(+Z) 2(+X) 3(-Z)
+const int DIR_OFFSET_X[4] = { -1, 0, 1, 0 };
+const int DIR_OFFSET_Z[4] = { 0, 1, 0, -1 };
+
+/**
+ * @brief 高度场中的实心体素跨度
+ */
+struct HeightSpan {
+    uint16_t smin;
+    uint16_t smax;
+    bool walkable;
+};
+
+/**
+ * @brief 单个tile（含边界）的高度场
+ */
+struct Heightfield {
+    int width = 0;
+    int height = 0;
+    float originX = 0.0f;
+    float originZ = 0.0f;
+    std::vector<std::vector<HeightSpan>> columns;
+};
+
+/**
+ * @brief 紧凑高度场中的开放空间
+ */
+struct CompactSpan {
+    uint16_t y;
+    uint16_t h;
+    uint32_t con[4];
+    uint32_t region;
+    bool walkable;
+};
+
+struct CompactCell {
+    uint32_t index;
+    uint32_t count;
+};
+
+struct CompactHeightfield {
+    int width = 0;
+    int height = 0;
+    std::vector<CompactCell> cells;
+    std::vector<CompactSpan> spans;
+};
+
+/**
+ * @brief 体素单位下的构建参数
+ */
+struct VoxelParams {
+    int walkableHeight;
+    int walkableClimb;
+    int walkableRadius;
+    int border;
+};
+
+/**
+ * @brief 小型定长多边形，用于三角形裁剪
+ */
+struct ClipPolygon {
+    Vector3 points[12];
+    int count = 0;
+};
+
+VoxelParams ComputeVoxelParams(const NavMeshConfig& config) {
+    VoxelParams params;
+    params.walkableHeight = static_cast<int>(std::ceil(config.walkableHeight / config.cellHeight));
+    params.walkableClimb = static_cast<int>(std::floor(config.walkableClimb / config.cellHeight));
+    params.walkableRadius = static_cast<int>(std::ceil(config.walkableRadius / config.cellSize));
+    params.border = params.walkableRadius + 3;
+    return params;
+}
+
+float AxisValue(const Vector3& v, int axis) {
+    return axis == 0 ? v.x : v.z;
+}
+
+/**
+ * @brief 用轴对齐平面裁剪多边形，保留 sign * (p[axis] - value) >= 0 的部分
+ */
+void ClipByAxis(const ClipPolygon& in, ClipPolygon& out, int axis, float value, float sign) {
+    out.count = 0;
+    for (int i = 0, j = in.count - 1; i < in.count; j = i, ++i) {
+        const Vector3& a = in.points[j];
+        const Vector3& b = in.points[i];
+        float da = sign * (AxisValue(a, axis) - value);
+        float db = sign * (AxisValue(b, axis) - value);
+        if ((da >= 0.0f) != (db >= 0.0f)) {
+            float t = da / (da - db);
+            out.points[out.count++] = a + (b - a) * t;
+        }
+        if (db >= 0.0f) {
+            out.points[out.count++] = b;
+        }
+    }
+}
+
+/**
+ * @brief 向柱中添加跨度，与重叠跨度合并
+ */
+void AddSpan(std::vector<HeightSpan>& column, HeightSpan span, int mergeThreshold) {
+    auto it = column.begin();
+    while (it != column.end()) {
+        if (it->smin > span.smax) {
+            break;
+        }
+        if (it->smax < span.smin) {
+            ++it;
+            continue;
+        }
+
+        // 可行走标记取决于合并后顶面属于哪个跨度
+        if (std::abs(static_cast<int>(span.smax) - static_cast<int>(it->smax)) <= mergeThreshold) {
+            span.walkable = span.walkable || it->walkable;
+        } else if (it->smax > span.smax) {
+            span.walkable = it->walkable;
+        }
+        span.smin = std::min(span.smin, it->smin);
+        span.smax = std::max(span.smax, it->smax);
+        it = column.erase(it);
+    }
+    column.insert(it, span);
+}
+
+void RasterizeTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2, bool walkable,
+                       Heightfield& hf, const NavMeshConfig& config, int mergeThreshold) {
+    const float cs = config.cellSize;
+    const float ch = config.cellHeight;
+
+    float minZ = std::min(v0.z, std::min(v1.z, v2.z));
+    float maxZ = std::max(v0.z, std::max(v1.z, v2.z));
+
+    int z0 = static_cast<int>(std::floor((minZ - hf.originZ) / cs));
+    int z1 = static_cast<int>(std::floor((maxZ - hf.originZ) / cs));
+    if (z1 < 0 || z0 >= hf.height) {
+        return;
+    }
+    z0 = std::max(z0, 0);
+    z1 = std::min(z1, hf.height - 1);
+
+    const float heightRange = config.boundsMax.y - config.boundsMin.y;
+
+    ClipPolygon triangle;
+    triangle.points[0] = v0;
+    triangle.points[1] = v1;
+    triangle.points[2] = v2;
+    triangle.count = 3;
+
+    ClipPolygon temp, row, cell;
+    for (int z = z0; z <= z1; ++z) {
+        float cellZ = hf.originZ + z * cs;
+        ClipByAxis(triangle, temp, 2, cellZ, 1.0f);
+        ClipByAxis(temp, row, 2, cellZ + cs, -1.0f);
+        if (row.count < 3) {
+            continue;
+        }
+
+        float rowMinX = row.points[0].x;
+        float rowMaxX = row.points[0].x;
+        for (int i = 1; i < row.count; ++i) {
+            rowMinX = std::min(rowMinX, row.points[i].x);
+            rowMaxX = std::max(rowMaxX, row.points[i].x);
+        }
+        int x0 = std::max(static_cast<int>(std::floor((rowMinX - hf.originX) / cs)), 0);
+        int x1 = std::min(static_cast<int>(std::floor((rowMaxX - hf.originX) / cs)), hf.width - 1);
+
+        for (int x = x0; x <= x1; ++x) {
+            float cellX = hf.originX + x * cs;
+            ClipByAxis(row, temp, 0, cellX, 1.0f);
+            ClipByAxis(temp, cell, 0, cellX + cs, -1.0f);
+            if (cell.count < 3) {
+                continue;
+            }
+
+            float spanMin = cell.points[0].y;
+            float spanMax = cell.points[0].y;
+            for (int i = 1; i < cell.count; ++i) {
+                spanMin = std::min(spanMin, cell.points[i].y);
+                spanMax = std::max(spanMax, cell.points[i].y);
+            }
+            spanMin -= config.boundsMin.y;
+            spanMax -= config.boundsMin.y;
+            if (spanMax < 0.0f || spanMin > heightRange) {
+                continue;
+            }
+            spanMin = std::max(spanMin, 0.0f);
+            spanMax = std::min(spanMax, heightRange);
+
+            HeightSpan span;
+            span.smin = static_cast<uint16_t>(std::min(static_cast<int>(std::floor(spanMin / ch)), SPAN_MAX_HEIGHT - 1));
+            span.smax = static_cast<uint16_t>(std::min(std::max(static_cast<int>(std::ceil(spanMax / ch)), span.smin + 1), SPAN_MAX_HEIGHT));
+            span.walkable = walkable;
+            AddSpan(hf.columns[static_cast<size_t>(x + z * hf.width)], span, mergeThreshold);
+        }
+    }
+}
+
+/**
+ * @brief 允许跨上低矮障碍（台阶、路沿）
+ */
+void FilterLowHangingObstacles(Heightfield& hf, int walkableClimb) {
+    for (auto& column : hf.columns) {
+        bool previousWalkable = false;
+        int previousTop = 0;
+        for (auto& span : column) {
+            bool walkable = span.walkable;
+            if (!walkable && previousWalkable && static_cast<int>(span.smax) - previousTop <= walkableClimb) {
+                span.walkable = true;
+            }
+            previousWalkable = walkable;
+            previousTop = span.smax;
+        }
+    }
+}
+
+/**
+ * @brief 移除悬崖边缘的跨度
+ */
+void FilterLedgeSpans(Heightfield& hf, int walkableHeight, int walkableClimb) {
+    for (int z = 0; z < hf.height; ++z) {
+        for (int x = 0; x < hf.width; ++x) {
+            auto& column = hf.columns[static_cast<size_t>(x + z * hf.width)];
+            for (size_t i = 0; i < column.size(); ++i) {
+                HeightSpan& span = column[i];
+                if (!span.walkable) {
+                    continue;
+                }
+
+                int bottom = span.smax;
+                int top = i + 1 < column.size() ? column[i + 1].smin : SPAN_MAX_HEIGHT;
+                int minDrop = SPAN_MAX_HEIGHT;
+
+                for (int dir = 0; dir < 4; ++dir) {
+                    int nx = x + DIR_OFFSET_X[dir];
+                    int nz = z + DIR_OFFSET_Z[dir];
+                    if (nx < 0 || nz < 0 || nx >= hf.width || nz >= hf.height) {
+                        minDrop = std::min(minDrop, -walkableClimb - bottom);
+                        continue;
+                    }
+
+                    const auto& neighbor = hf.columns[static_cast<size_t>(nx + nz * hf.width)];
+                    int neighborBottom = -walkableClimb;
+                    int neighborTop = neighbor.empty() ? SPAN_MAX_HEIGHT : neighbor[0].smin;
+                    if (std::min(top, neighborTop) - std::max(bottom, neighborBottom) > walkableHeight) {
+                        minDrop = std::min(minDrop, neighborBottom - bottom);
+                    }
+
+                    for (size_t j = 0; j < neighbor.size(); ++j) {
+                        neighborBottom = neighbor[j].smax;
+                        neighborTop = j + 1 < neighbor.size() ? neighbor[j + 1].smin : SPAN_MAX_HEIGHT;
+                        if (std::min(top, neighborTop) - std::max(bottom, neighborBottom) > walkableHeight) {
+                            minDrop = std::min(minDrop, neighborBottom - bottom);
+                        }
+                    }
+                }
+
+                if (minDrop < -walkableClimb) {
+                    span.walkable = false;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 移除头顶空间不足的跨度
+ */
+void FilterLowHeightSpans(Heightfield& hf, int walkableHeight) {
+    for (auto& column : hf.columns) {
+        for (size_t i = 0; i < column.size(); ++i) {
+            int ceiling = i + 1 < column.size() ? column[i + 1].smin : SPAN_MAX_HEIGHT;
+            if (ceiling - static_cast<int>(column[i].smax) < walkableHeight) {
+                column[i].walkable = false;
+            }
+        }
+    }
+}
+
+void BuildCompactHeightfield(const Heightfield& hf, const VoxelParams& params, CompactHeightfield& chf) {
+    chf.width = hf.width;
+    chf.height = hf.height;
+    chf.cells.resize(hf.columns.size());
+    chf.spans.clear();
+
+    for (size_t c = 0; c < hf.columns.size(); ++c) {
+        const auto& column = hf.columns[c];
+        chf.cells[c].index = static_cast<uint32_t>(chf.spans.size());
+        for (size_t i = 0; i < column.size(); ++i) {
+            if (!column[i].walkable) {
+                continue;
+            }
+            int floor = column[i].smax;
+            int ceiling = i + 1 < column.size() ? column[i + 1].smin : SPAN_MAX_HEIGHT;
+
+            CompactSpan span;
+            span.y = static_cast<uint16_t>(floor);
+            span.h = static_cast<uint16_t>(std::min(std::max(ceiling - floor, 0), SPAN_MAX_HEIGHT));
+            span.con[0] = span.con[1] = span.con[2] = span.con[3] = NOT_CONNECTED;
+            span.region = 0;
+            span.walkable = true;
+            chf.spans.push_back(span);
+        }
+        chf.cells[c].count = static_cast<uint32_t>(chf.spans.size()) - chf.cells[c].index;
+    }
+
+    for (int z = 0; z < chf.height; ++z) {
+        for (int x = 0; x < chf.width; ++x) {
+            const CompactCell& cell = chf.cells[static_cast<size_t>(x + z * chf.width)];
+            for (uint32_t i = cell.index; i < cell.index + cell.count; ++i) {
+                CompactSpan& span = chf.spans[i];
+                for (int dir = 0; dir < 4; ++dir) {
+                    int nx = x + DIR_OFFSET_X[dir];
+                    int nz = z + DIR_OFFSET_Z[dir];
+                    if (nx < 0 || nz < 0 || nx >= chf.width || nz >= chf.height) {
+                        continue;
+                    }
+                    const CompactCell& neighborCell = chf.cells[static_cast<size_t>(nx + nz * chf.width)];
+                    for (uint32_t k = neighborCell.index; k < neighborCell.index + neighborCell.count; ++k) {
+                        const CompactSpan& neighbor = chf.spans[k];
+                        int bottom = std::max(span.y, neighbor.y);
+                        int top = std::min(span.y + span.h, neighbor.y + neighbor.h);
+                        if (top - bottom >= params.walkableHeight &&
+                            std::abs(static_cast<int>(neighbor.y) - static_cast<int>(span.y)) <= params.walkableClimb) {
+                            span.con[dir] = k;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 按智能体半径腐蚀可行走区域
+ */
+void ErodeWalkableArea(CompactHeightfield& chf, int radius) {
+    if (radius <= 0) {
+        return;
+    }
+
+    std::vector<uint16_t> distance(chf.spans.size(), 0xffff);
+    std::deque<uint32_t> queue;
+    for (uint32_t i = 0; i < chf.spans.size(); ++i) {
+        const CompactSpan& span = chf.spans[i];
+        if (span.con[0] == NOT_CONNECTED || span.con[1] == NOT_CONNECTED ||
+            span.con[2] == NOT_CONNECTED || span.con[3] == NOT_CONNECTED) {
+            distance[i] = 0;
+            queue.push_back(i);
+        }
+    }
+
+    while (!queue.empty()) {
+        uint32_t current = queue.front();
+        queue.pop_front();
+        if (distance[current] + 1 >= radius) {
+            continue;
+        }
+        for (int dir = 0; dir < 4; ++dir) {
+            uint32_t neighbor = chf.spans[current].con[dir];
+            if (neighbor != NOT_CONNECTED && distance[neighbor] > distance[current] + 1) {
+                distance[neighbor] = static_cast<uint16_t>(distance[current] + 1);
+                queue.push_back(neighbor);
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < chf.spans.size(); ++i) {
+        if (distance[i] < radius) {
+            chf.spans[i].walkable = false;
+        }
+    }
+
+    // 断开指向已腐蚀跨度的连接
+    for (auto& span : chf.spans) {
+        for (int dir = 0; dir < 4; ++dir) {
+            if (span.con[dir] != NOT_CONNECTED && !chf.spans[span.con[dir]].walkable) {
+                span.con[dir] = NOT_CONNECTED;
+            }
+        }
+    }
+}
+
+bool InCore(int x, int z, int border, int tileSize) {
+    return x >= border && z >= border && x < border + tileSize && z < border + tileSize;
+}
+
+/**
+ * @brief 对tile核心区域内的连通跨度进行泛洪，生成区域
+ * @return 区域数量
+ */
+uint32_t BuildRegions(CompactHeightfield& chf, int border, int tileSize) {
+    uint32_t regionCount = 0;
+    std::vector<std::pair<int, uint32_t>> stack;
+
+    for (int z = border; z < border + tileSize && z < chf.height; ++z) {
+        for (int x = border; x < border + tileSize && x < chf.width; ++x) {
+            const CompactCell& cell = chf.cells[static_cast<size_t>(x + z * chf.width)];
+            for (uint32_t i = cell.index; i < cell.index + cell.count; ++i) {
+                if (!chf.spans[i].walkable || chf.spans[i].region != 0) {
+                    continue;
+                }
+
+                uint32_t region = ++regionCount;
+                chf.spans[i].region = region;
+                stack.clear();
+                stack.emplace_back(x + z * chf.width, i);
+                while (!stack.empty()) {
+                    auto [cellIndex, spanIndex] = stack.back();
+                    stack.pop_back();
+                    int cx = cellIndex % chf.width;
+                    int cz = cellIndex / chf.width;
+                    for (int dir = 0; dir < 4; ++dir) {
+                        uint32_t neighbor = chf.spans[spanIndex].con[dir];
+                        int nx = cx + DIR_OFFSET_X[dir];
+                        int nz = cz + DIR_OFFSET_Z[dir];
+                        if (neighbor == NOT_CONNECTED || !InCore(nx, nz, border, tileSize) ||
+                            chf.spans[neighbor].region != 0) {
+                            continue;
+                        }
+                        chf.spans[neighbor].region = region;
+                        stack.emplace_back(nx + nz * chf.width, neighbor);
+                    }
+                }
+            }
+        }
+    }
+    return regionCount;
+}
+
+struct ContourPoint {
+    int x;
+    int y;
+    int z;
+};
+
+float DistancePointSegmentSquared(const ContourPoint& p, const ContourPoint& a, const ContourPoint& b) {
+    float abx = static_cast<float>(b.x - a.x);
+    float abz = static_cast<float>(b.z - a.z);
+    float apx = static_cast<float>(p.x - a.x);
+    float apz = static_cast<float>(p.z - a.z);
+    float lengthSquared = abx * abx + abz * abz;
+    float t = lengthSquared > 0.0f ? std::min(std::max((apx * abx + apz * abz) / lengthSquared, 0.0f), 1.0f) : 0.0f;
+    float dx = apx - abx * t;
+    float dz = apz - abz * t;
+    return dx * dx + dz * dz;
+}
+
+/**
+ * @brief Douglas-Peucker简化闭合轮廓
+ */
+std::vector<ContourPoint> SimplifyContour(const std::vector<ContourPoint>& raw, float maxError) {
+    // 以左下和右上两个端点作为初始折线
+    size_t lowerLeft = 0;
+    size_t upperRight = 0;
+    for (size_t i = 1; i < raw.size(); ++i) {
+        if (raw[i].x < raw[lowerLeft].x || (raw[i].x == raw[lowerLeft].x && raw[i].z < raw[lowerLeft].z)) {
+            lowerLeft = i;
+        }
+        if (raw[i].x > raw[upperRight].x || (raw[i].x == raw[upperRight].x && raw[i].z > raw[upperRight].z)) {
+            upperRight = i;
+        }
+    }
+
+    std::vector<size_t> simplified = { lowerLeft, upperRight };
+    const float maxErrorSquared = maxError * maxError;
+    const size_t rawCount = raw.size();
+
+    for (size_t i = 0; i < simplified.size();) {
+        size_t next = (i + 1) % simplified.size();
+        size_t a = simplified[i];
+        size_t b = simplified[next];
+
+        float worstDistance = 0.0f;
+        size_t worst = rawCount;
+        for (size_t k = (a + 1) % rawCount; k != b; k = (k + 1) % rawCount) {
+            float distance = DistancePointSegmentSquared(raw[k], raw[a], raw[b]);
+            if (distance > worstDistance) {
+                worstDistance = distance;
+                worst = k;
+            }
+        }
+
+        if (worst != rawCount && worstDistance > maxErrorSquared) {
+            simplified.insert(simplified.begin() + static_cast<std::ptrdiff_t>(i + 1), worst);
+        } else {
+            ++i;
+        }
+    }
+
+    std::vector<ContourPoint> result;
+    result.reserve(simplified.size());
+    for (size_t index : simplified) {
+        result.push_back(raw[index]);
+    }
+    return result;
+}
+
+/**
+ * @brief 沿区域边界行走，生成每个区域的轮廓
+ */
+void BuildContours(const CompactHeightfield& chf, int border, int tileSize, float maxError,
+                   const std::function<void(uint32_t, const std::vector<ContourPoint>&)>& emit) {
+    auto isBoundary = [&](int x, int z, uint32_t spanIndex, int dir) {
+        uint32_t neighbor = chf.spans[spanIndex].con[dir];
+        if (neighbor == NOT_CONNECTED || !InCore(x + DIR_OFFSET_X[dir], z + DIR_OFFSET_Z[dir], border, tileSize)) {
+            return true;
+        }
+        return chf.spans[neighbor].region != chf.spans[spanIndex].region;
+    };
+
+    std::vector<uint8_t> visited(chf.spans.size(), 0);
+    std::vector<ContourPoint> raw;
+
+    for (int z = border; z < border + tileSize && z < chf.height; ++z) {
+        for (int x = border; x < border + tileSize && x < chf.width; ++x) {
+            const CompactCell& cell = chf.cells[static_cast<size_t>(x + z * chf.width)];
+            for (uint32_t i = cell.index; i < cell.index + cell.count; ++i) {
+                const CompactSpan& span = chf.spans[i];
+                if (span.region == 0) {
+                    continue;
+                }
+                for (int startDir = 0; startDir < 4; ++startDir) {
+                    if ((visited[i] & (1 << startDir)) || !isBoundary(x, z, i, startDir)) {
+                        continue;
+                    }
+
+                    raw.clear();
+                    int cx = x;
+                    int cz = z;
+                    uint32_t current = i;
+                    int dir = startDir;
+                    size_t guard = chf.spans.size() * 4 + 4;
+                    do {
+                        if (isBoundary(cx, cz, current, dir)) {
+                            ContourPoint point = { cx, chf.spans[current].y, cz };
+                            if (dir == 0) {
+                                point.z++;
+                            } else if (dir == 1) {
+                                point.x++;
+                                point.z++;
+                            } else if (dir == 2) {
+                                point.x++;
+                            }
+                            raw.push_back(point);
+                            visited[current] |= static_cast<uint8_t>(1 << dir);
+                            dir = (dir + 1) & 3;
+                        } else {
+                            current = chf.spans[current].con[dir];
+                            cx += DIR_OFFSET_X[dir];
+                            cz += DIR_OFFSET_Z[dir];
+                            dir = (dir + 3) & 3;
+                        }
+                    } while ((current != i || dir != startDir) && --guard > 0);
+
+                    if (raw.size() >= 3) {
+                        emit(span.region, SimplifyContour(raw, maxError));
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 贪心合并同一区域内的跨度为轴对齐凸四边形
+ */
+void BuildPolygons(const CompactHeightfield& chf, const VoxelParams& params, int tileSize,
+                   int tileX, int tileZ, const NavMeshConfig& config, std::vector<NavPoly>& polys) {
+    const int border = params.border;
+    std::vector<uint32_t> owner(chf.spans.size(), UNASSIGNED);
+    std::vector<std::vector<uint32_t>> rows;
+
+    auto spanWorldY = [&](uint32_t spanIndex) {
+        return config.boundsMin.y + static_cast<float>(chf.spans[spanIndex].y) * config.cellHeight;
+    };
+
+    for (int z = border; z < border + tileSize && z < chf.height; ++z) {
+        for (int x = border; x < border + tileSize && x < chf.width; ++x) {
+            const CompactCell& cell = chf.cells[static_cast<size_t>(x + z * chf.width)];
+            for (uint32_t seed = cell.index; seed < cell.index + cell.count; ++seed) {
+                const CompactSpan& seedSpan = chf.spans[seed];
+                if (seedSpan.region == 0 || owner[seed] != UNASSIGNED) {
+                    continue;
+                }
+
+                auto eligible = [&](uint32_t spanIndex) {
+                    return spanIndex != NOT_CONNECTED &&
+                           chf.spans[spanIndex].region == seedSpan.region &&
+                           owner[spanIndex] == UNASSIGNED &&
+                           std::abs(static_cast<int>(chf.spans[spanIndex].y) - static_cast<int>(seedSpan.y)) <= params.walkableClimb;
+                };
+
+                // 沿+X扩展第一行
+                rows.clear();
+                rows.emplace_back(1, seed);
+                for (int cx = x + 1; cx < border + tileSize && cx < chf.width; ++cx) {
+                    uint32_t next = chf.spans[rows[0].back()].con[2];
+                    if (!eligible(next)) {
+                        break;
+                    }
+                    rows[0].push_back(next);
+                }
+                const size_t width = rows[0].size();
+
+                // 沿+Z逐行扩展，整行都可合并时才接受
+                for (int cz = z + 1; cz < border + tileSize && cz < chf.height; ++cz) {
+                    std::vector<uint32_t> next(width);
+                    bool accepted = true;
+                    for (size_t k = 0; k < width && accepted; ++k) {
+                        uint32_t candidate = chf.spans[rows.back()[k]].con[1];
+                        if (!eligible(candidate) || (k > 0 && chf.spans[next[k - 1]].con[2] != candidate)) {
+                            accepted = false;
+                            break;
+                        }
+                        next[k] = candidate;
+                    }
+                    if (!accepted) {
+                        break;
+                    }
+                    rows.push_back(std::move(next));
+                }
+
+                const uint32_t polyIndex = static_cast<uint32_t>(polys.size());
+                for (const auto& row : rows) {
+                    for (uint32_t spanIndex : row) {
+                        owner[spanIndex] = polyIndex;
+                    }
+                }
+
+                NavPoly poly;
+                poly.minX = tileX * tileSize + (x - border);
+                poly.minZ = tileZ * tileSize + (z - border);
+                poly.maxX = poly.minX + static_cast<int32_t>(width);
+                poly.maxZ = poly.minZ + static_cast<int32_t>(rows.size());
+                poly.region = seedSpan.region;
+
+                const float x0 = config.boundsMin.x + poly.minX * config.cellSize;
+                const float x1 = config.boundsMin.x + poly.maxX * config.cellSize;
+                const float z0 = config.boundsMin.z + poly.minZ * config.cellSize;
+                const float z1 = config.boundsMin.z + poly.maxZ * config.cellSize;
+                poly.vertices[0] = Vector3(x0, spanWorldY(rows.front().front()), z0);
+                poly.vertices[1] = Vector3(x0, spanWorldY(rows.back().front()), z1);
+                poly.vertices[2] = Vector3(x1, spanWorldY(rows.back().back()), z1);
+                poly.vertices[3] = Vector3(x1, spanWorldY(rows.front().back()), z0);
+                poly.center = (poly.vertices[0] + poly.vertices[1] + poly.vertices[2] + poly.vertices[3]) * 0.25f;
+                polys.push_back(std::move(poly));
+            }
+        }
+    }
+}
+
+/**
+ * @brief 若两个多边形共享一条边，则在a中添加指向b的连接
+ */
+void TryLinkPolys(NavPoly& a, NavPolyRef bRef, const NavPoly& b, float walkableClimb, const NavMeshConfig& config) {
+    int dir = -1;
+    int low = 0;
+    int high = 0;
+    if (a.maxX == b.minX || a.minX == b.maxX) {
+        low = std::max(a.minZ, b.minZ);
+        high = std::min(a.maxZ, b.maxZ);
+        dir = a.maxX == b.minX ? 2 : 0;
+    } else if (a.maxZ == b.minZ || a.minZ == b.maxZ) {
+        low = std::max(a.minX, b.minX);
+        high = std::min(a.maxX, b.maxX);
+        dir = a.maxZ == b.minZ ? 1 : 3;
+    }
+    if (dir < 0 || high <= low) {
+        return;
+    }
+
+    Vector3 p0, p1;
+    if (dir == 0 || dir == 2) {
+        float edgeX = config.boundsMin.x + (dir == 2 ? a.maxX : a.minX) * config.cellSize;
+        p0 = Vector3(edgeX, 0.0f, config.boundsMin.z + low * config.cellSize);
+        p1 = Vector3(edgeX, 0.0f, config.boundsMin.z + high * config.cellSize);
+    } else {
+        float edgeZ = config.boundsMin.z + (dir == 1 ? a.maxZ : a.minZ) * config.cellSize;
+        p0 = Vector3(config.boundsMin.x + low * config.cellSize, 0.0f, edgeZ);
+        p1 = Vector3(config.boundsMin.x + high * config.cellSize, 0.0f, edgeZ);
+    }
+
+    // 共享边两端在两个多边形上的高度差都必须可跨越
+    Vector3 a0 = NavMesh::ClosestPointOnPoly(a, p0);
+    Vector3 a1 = NavMesh::ClosestPointOnPoly(a, p1);
+    Vector3 b0 = NavMesh::ClosestPointOnPoly(b, p0);
+    Vector3 b1 = NavMesh::ClosestPointOnPoly(b, p1);
+    if (std::abs(a0.y - b0.y) > walkableClimb || std::abs(a1.y - b1.y) > walkableClimb) {
+        return;
+    }
+    p0.y = (a0.y + b0.y) * 0.5f;
+    p1.y = (a1.y + b1.y) * 0.5f;
+
+    // 沿离开方向看，叉积为正的端点在左侧
+    Vector3 mid = (p0 + p1) * 0.5f;
+    float cross = static_cast<float>(DIR_OFFSET_X[dir]) * (p0.z - mid.z) - static_cast<float>(DIR_OFFSET_Z[dir]) * (p0.x - mid.x);
+
+    NavPolyLink link;
+    link.neighbor = bRef;
+    link.edge = static_cast<uint8_t>(dir);
+    link.portalLeft = cross > 0.0f ? p0 : p1;
+    link.portalRight = cross > 0.0f ? p1 : p0;
+    a.links.push_back(link);
+}
+
+} // namespace
+
+NavMeshBuilder::NavMeshBuilder(const NavMeshConfig& config)
+    : m_Config(config) {
+    const float tileWorldSize = config.cellSize * static_cast<float>(config.tileSize);
+    m_TileCountX = std::max(1, static_cast<int>(std::ceil((config.boundsMax.x - config.boundsMin.x) / tileWorldSize)));
+    m_TileCountZ = std::max(1, static_cast<int>(std::ceil((config.boundsMax.z - config.boundsMin.z) / tileWorldSize)));
+    m_DirtyFlags.assign(static_cast<size_t>(m_TileCountX) * static_cast<size_t>(m_TileCountZ), 0);
+}
+
+void NavMeshBuilder::ComputeBounds(Geometry& geometry) {
+    geometry.boundsMin = Vector3(FLT_MAX, FLT_MAX, FLT_MAX);
+    geometry.boundsMax = Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (const Vector3& v : geometry.vertices) {
+        geometry.boundsMin = Vector3(std::min(geometry.boundsMin.x, v.x), std::min(geometry.boundsMin.y, v.y), std::min(geometry.boundsMin.z, v.z));
+        geometry.boundsMax = Vector3(std::max(geometry.boundsMax.x, v.x), std::max(geometry.boundsMax.y, v.y), std::max(geometry.boundsMax.z, v.z));
+    }
+}
+
+NavGeometryHandle NavMeshBuilder::AddGeometry(const std::vector<Vector3>& vertices, const std::vector<uint32_t>& indices) {
+    if (vertices.empty() || indices.size() < 3) {
+        std::cerr << "导航几何体为空！" << std::endl;
+        return NAV_INVALID_GEOMETRY;
+    }
+
+    NavGeometryHandle handle;
+    if (!m_FreeHandles.empty()) {
+        handle = m_FreeHandles.back();
+        m_FreeHandles.pop_back();
+    } else {
+        handle = static_cast<NavGeometryHandle>(m_Geometries.size());
+        m_Geometries.emplace_back();
+    }
+
+    Geometry& geometry = m_Geometries[handle];
+    geometry.vertices = vertices;
+    geometry.indices = indices;
+    geometry.alive = true;
+    ComputeBounds(geometry);
+    MarkDirty(geometry.boundsMin, geometry.boundsMax);
+    return handle;
+}
+
+bool NavMeshBuilder::UpdateGeometry(NavGeometryHandle handle, const std::vector<Vector3>& vertices, const std::vector<uint32_t>& indices) {
+    if (handle >= m_Geometries.size() || !m_Geometries[handle].alive) {
+        return false;
+    }
+
+    Geometry& geometry = m_Geometries[handle];
+    MarkDirty(geometry.boundsMin, geometry.boundsMax);
+    geometry.vertices = vertices;
+    geometry.indices = indices;
+    ComputeBounds(geometry);
+    MarkDirty(geometry.boundsMin, geometry.boundsMax);
+    return true;
+}
+
+bool NavMeshBuilder::RemoveGeometry(NavGeometryHandle handle) {
+    if (handle >= m_Geometries.size() || !m_Geometries[handle].alive) {
+        return false;
+    }
+
+    Geometry& geometry = m_Geometries[handle];
+    MarkDirty(geometry.boundsMin, geometry.boundsMax);
+    geometry.vertices.clear();
+    geometry.indices.clear();
+    geometry.alive = false;
+    m_FreeHandles.push_back(handle);
+    return true;
+}
+
+void NavMeshBuilder::MarkDirty(const Vector3& boundsMin, const Vector3& boundsMax) {
+    // tile边界区域同样会读取该几何体，因此按边界宽度扩展
+    const VoxelParams params = ComputeVoxelParams(m_Config);
+    const float tileWorldSize = m_Config.cellSize * static_cast<float>(m_Config.tileSize);
+    const float borderSize = m_Config.cellSize * static_cast<float>(params.border);
+
+    int minX = static_cast<int>(std::floor((boundsMin.x - borderSize - m_Config.boundsMin.x) / tileWorldSize));
+    int minZ = static_cast<int>(std::floor((boundsMin.z - borderSize - m_Config.boundsMin.z) / tileWorldSize));
+    int maxX = static_cast<int>(std::floor((boundsMax.x + borderSize - m_Config.boundsMin.x) / tileWorldSize));
+    int maxZ = static_cast<int>(std::floor((boundsMax.z + borderSize - m_Config.boundsMin.z) / tileWorldSize));
+    minX = std::max(minX, 0);
+    minZ = std::max(minZ, 0);
+    maxX = std::min(maxX, m_TileCountX - 1);
+    maxZ = std::min(maxZ, m_TileCountZ - 1);
+
+    for (int z = minZ; z <= maxZ; ++z) {
+        for (int x = minX; x <= maxX; ++x) {
+            uint32_t index = static_cast<uint32_t>(z * m_TileCountX + x);
+            if (!m_DirtyFlags[index]) {
+                m_DirtyFlags[index] = 1;
+                m_DirtyTiles.push_back(index);
+            }
+        }
+    }
+}
+
+std::shared_ptr<NavMesh> NavMeshBuilder::Build() {
+    m_NavMesh = std::make_shared<NavMesh>(m_Config);
+
+    std::vector<uint32_t> tileIndices(m_NavMesh->GetTileCount());
+    for (uint32_t i = 0; i < tileIndices.size(); ++i) {
+        tileIndices[i] = i;
+    }
+    BuildTiles(tileIndices);
+
+    std::fill(m_DirtyFlags.begin(), m_DirtyFlags.end(), 0);
+    m_DirtyTiles.clear();
+    return m_NavMesh;
+}
+
+std::vector<uint32_t> NavMeshBuilder::Rebuild() {
+    if (!m_NavMesh) {
+        Build();
+        std::vector<uint32_t> all(m_NavMesh->GetTileCount());
+        for (uint32_t i = 0; i < all.size(); ++i) {
+            all[i] = i;
+        }
+        return all;
+    }
+
+    std::vector<uint32_t> tileIndices;
+    tileIndices.swap(m_DirtyTiles);
+    for (uint32_t index : tileIndices) {
+        m_DirtyFlags[index] = 0;
+    }
+    if (!tileIndices.empty()) {
+        BuildTiles(tileIndices);
+    }
+    return tileIndices;
+}
+
+void NavMeshBuilder::BuildTiles(const std::vector<uint32_t>& tileIndices) {
+    std::vector<NavMeshTile> results(tileIndices.size());
+
+    JobSystem::GetInstance().ParallelFor(static_cast<uint32_t>(tileIndices.size()), 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const NavMeshTile& previous = m_NavMesh->m_Tiles[tileIndices[i]];
+            results[i].x = previous.x;
+            results[i].z = previous.z;
+            results[i].boundsMin = previous.boundsMin;
+            results[i].boundsMax = previous.boundsMax;
+            results[i].revision = previous.revision + 1;
+            BuildTile(previous.x, previous.z, results[i]);
+        }
+    });
+
+    for (size_t i = 0; i < tileIndices.size(); ++i) {
+        m_NavMesh->m_Tiles[tileIndices[i]] = std::move(results[i]);
+    }
+    ConnectTiles(tileIndices);
+}
+
+void NavMeshBuilder::BuildTile(int tileX, int tileZ, NavMeshTile& tile) const {
+    const VoxelParams params = ComputeVoxelParams(m_Config);
+    const int tileSize = m_Config.tileSize;
+    const float cs = m_Config.cellSize;
+
+    Heightfield hf;
+    hf.width = tileSize + params.border * 2;
+    hf.height = tileSize + params.border * 2;
+    hf.originX = tile.boundsMin.x - params.border * cs;
+    hf.originZ = tile.boundsMin.z - params.border * cs;
+    hf.columns.resize(static_cast<size_t>(hf.width) * static_cast<size_t>(hf.height));
+
+    const float maxX = hf.originX + hf.width * cs;
+    const float maxZ = hf.originZ + hf.height * cs;
+    const float walkableThreshold = std::cos(m_Config.walkableSlopeAngle / 180.0f * PI);
+
+    // 体素化与tile（含边界）相交的三角形
+    for (const Geometry& geometry : m_Geometries) {
+        if (!geometry.alive || geometry.boundsMax.x < hf.originX || geometry.boundsMin.x > maxX ||
+            geometry.boundsMax.z < hf.originZ || geometry.boundsMin.z > maxZ) {
+            continue;
+        }
+
+        for (size_t i = 0; i + 2 < geometry.indices.size(); i += 3) {
+            const Vector3& v0 = geometry.vertices[geometry.indices[i]];
+            const Vector3& v1 = geometry.vertices[geometry.indices[i + 1]];
+            const Vector3& v2 = geometry.vertices[geometry.indices[i + 2]];
+            if (std::max(v0.x, std::max(v1.x, v2.x)) < hf.originX || std::min(v0.x, std::min(v1.x, v2.x)) > maxX ||
+                std::max(v0.z, std::max(v1.z, v2.z)) < hf.originZ || std::min(v0.z, std::min(v1.z, v2.z)) > maxZ) {
+                continue;
+            }
+
+            Vector3 normal = (v1 - v0).Cross(v2 - v0).Normalized();
+            RasterizeTriangle(v0, v1, v2, normal.y > walkableThreshold, hf, m_Config, params.walkableClimb);
+        }
+    }
+
+    FilterLowHangingObstacles(hf, params.walkableClimb);
+    FilterLedgeSpans(hf, params.walkableHeight, params.walkableClimb);
+    FilterLowHeightSpans(hf, params.walkableHeight);
+
+    CompactHeightfield chf;
+    BuildCompactHeightfield(hf, params, chf);
+    hf.columns.clear();
+    ErodeWalkableArea(chf, params.walkableRadius);
+    BuildRegions(chf, params.border, tileSize);
+
+    const float ch = m_Config.cellHeight;
+    const Vector3 gridOrigin(hf.originX, m_Config.boundsMin.y, hf.originZ);
+    BuildContours(chf, params.border, tileSize, m_Config.maxContourError / cs,
+        [&](uint32_t region, const std::vector<ContourPoint>& points) {
+            NavContour contour;
+            contour.region = region;
+            contour.vertices.reserve(points.size());
+            for (const ContourPoint& point : points) {
+                contour.vertices.emplace_back(gridOrigin.x + point.x * cs, gridOrigin.y + point.y * ch, gridOrigin.z + point.z * cs);
+            }
+            tile.contours.push_back(std::move(contour));
+        });
+
+    BuildPolygons(chf, params, tileSize, tileX, tileZ, m_Config, tile.polys);
+}
+
+void NavMeshBuilder::ConnectTiles(const std::vector<uint32_t>& tileIndices) {
+    std::vector<NavMeshTile>& tiles = m_NavMesh->m_Tiles;
+    std::vector<uint8_t> rebuilt(tiles.size(), 0);
+    for (uint32_t index : tileIndices) {
+        rebuilt[index] = 1;
+    }
+
+    auto linkTile = [&](uint32_t fromIndex, uint32_t toIndex) {
+        NavMeshTile& from = tiles[fromIndex];
+        const NavMeshTile& to = tiles[toIndex];
+        for (NavPoly& poly : from.polys) {
+            for (uint32_t i = 0; i < to.polys.size(); ++i) {
+                if (&poly != &to.polys[i]) {
+                    TryLinkPolys(poly, MakeNavPolyRef(toIndex, i), to.polys[i], m_Config.walkableClimb, m_Config);
+                }
+            }
+        }
+    };
+
+    for (uint32_t index : tileIndices) {
+        const NavMeshTile& tile = tiles[index];
+        for (int dir = 0; dir < 4; ++dir) {
+            uint32_t neighborIndex = m_NavMesh->GetTileIndex(tile.x + DIR_OFFSET_X[dir], tile.z + DIR_OFFSET_Z[dir]);
+            if (neighborIndex == UINT32_MAX || rebuilt[neighborIndex]) {
+                continue;
+            }
+            // 移除未重建邻居中指向旧数据的连接
+            for (NavPoly& poly : tiles[neighborIndex].polys) {
+                poly.links.erase(std::remove_if(poly.links.begin(), poly.links.end(), [index](const NavPolyLink& link) {
+                    return GetNavPolyTile(link.neighbor) == index;
+                }), poly.links.end());
+            }
+        }
+    }
+
+    for (uint32_t index : tileIndices) {
+        const NavMeshTile& tile = tiles[index];
+        linkTile(index, index);
+        for (int dir = 0; dir < 4; ++dir) {
+            uint32_t neighborIndex = m_NavMesh->GetTileIndex(tile.x + DIR_OFFSET_X[dir], tile.z + DIR_OFFSET_Z[dir]);
+            if (neighborIndex == UINT32_MAX) {
+                continue;
+            }
+            linkTile(index, neighborIndex);
+            if (!rebuilt[neighborIndex]) {
+                linkTile(neighborIndex, index);
+            }
+        }
+    }
+}
+
+} // namespace PLE
@@ -0,0 +1,698 @@
+/**
+ * @file PathfindingService.cpp
+ * @brief 批量寻路服务实现
+ */
+
+#include "Navigation/PathfindingService.h"
+#include "Navigation/NavMeshBuilder.h"
+#include "Core/JobSystem.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <iostream>
+
+namespace PLE {
+
+namespace {
+
+constexpr uint32_t NO_PARENT = 0xffffffffu;
+constexpr NavPolyRef START_KEY = NAV_INVALID_POLY_REF - 1;
+constexpr NavPolyRef GOAL_KEY = NAV_INVALID_POLY_REF - 2;
+
+struct AbstractState {
+    float g;
+    NavPolyRef parent;
+};
+
+/**
+ * @brief XZ平面上三角形面积的两倍，符号表示c相对于ab的方向
+ */
+float TriArea2(const Vector3& a, const Vector3& b, const Vector3& c) {
+    float abx = b.x - a.x;
+    float abz = b.z - a.z;
+    float acx = c.x - a.x;
+    float acz = c.z - a.z;
+    return acx * abz - abx * acz;
+}
+
+bool NearlyEqual(const Vector3& a, const Vector3& b) {
+    const float epsilon = 1e-6f;
+    return (a - b).LengthSquared() < epsilon * epsilon;
+}
+
+uint64_t MakeCacheKey(NavPolyRef startRef, NavPolyRef goalRef) {
+    uint64_t hash = startRef * 0x9E3779B97F4A7C15ull;
+    hash ^= goalRef + 0x7F4A7C159E3779B9ull + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+} // namespace
+
+/**
+ * @brief 每个搜索线程独占的临时数据
+ */
+struct PathfindingService::SearchContext {
+    std::vector<float> g;
+    std::vector<uint32_t> parent;
+    std::vector<uint32_t> stamp;
+    uint32_t generation = 0;
+    std::vector<std::pair<float, uint32_t>> heap;
+
+    std::unordered_map<NavPolyRef, AbstractState> abstractStates;
+    std::vector<std::pair<float, NavPolyRef>> abstractHeap;
+    std::vector<float> startCosts;
+    std::vector<float> goalCosts;
+    std::vector<NavPolyRef> abstractPath;
+
+    void Reset(size_t count) {
+        if (stamp.size() < count) {
+            g.resize(count);
+            parent.resize(count);
+            stamp.resize(count, 0);
+        }
+        if (++generation == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            generation = 1;
+        }
+    }
+
+    float GetG(uint32_t index) const {
+        return stamp[index] == generation ? g[index] : FLT_MAX;
+    }
+
+    void SetG(uint32_t index, float value, uint32_t from) {
+        stamp[index] = generation;
+        g[index] = value;
+        parent[index] = from;
+    }
+};
+
+PathfindingService::PathfindingService(std::shared_ptr<NavMesh> navMesh, const PathfindingConfig& config)
+    : m_NavMesh(navMesh)
+    , m_Config(config) {
+}
+
+PathfindingService::~PathfindingService() {
+    Shutdown();
+}
+
+bool PathfindingService::Initialize() {
+    if (m_Initialized) {
+        std::cerr << "寻路服务已经初始化！" << std::endl;
+        return false;
+    }
+    if (!m_NavMesh) {
+        std::cerr << "寻路服务缺少导航网格！" << std::endl;
+        return false;
+    }
+
+    // 并行预计算所有簇的入口代价
+    m_Clusters.assign(m_NavMesh->GetTileCount(), Cluster());
+    JobSystem::GetInstance().ParallelFor(m_NavMesh->GetTileCount(), 4, [this](uint32_t begin, uint32_t end) {
+        SearchContext context;
+        for (uint32_t i = begin; i < end; ++i) {
+            BuildCluster(i, context);
+        }
+    });
+
+    uint32_t workerCount = m_Config.workerCount;
+    if (workerCount == 0) {
+        uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    m_Stopping = false;
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        m_Workers.emplace_back(&PathfindingService::WorkerLoop, this);
+    }
+
+    m_Initialized = true;
+    return true;
+}
+
+void PathfindingService::Shutdown() {
+    if (!m_Initialized) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
+        m_Stopping = true;
+    }
+    m_QueueCondition.notify_all();
+    for (auto& worker : m_Workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_Workers.clear();
+
+    // 取消尚未处理的请求
+    std::deque<Request> remaining;
+    {
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
+        remaining.swap(m_Queue);
+    }
+    for (Request& request : remaining) {
+        PathResult result;
+        result.status = PathStatus::Cancelled;
+        if (request.promise) {
+            request.promise->set_value(result);
+        }
+        if (request.callback) {
+            std::lock_guard<std::mutex> lock(m_CompletedMutex);
+            m_Completed.push_back({ request.id, std::move(request.callback), std::move(result) });
+        }
+    }
+
+    m_Initialized = false;
+}
+
+PathRequestId PathfindingService::RequestPath(const Vector3& start, const Vector3& goal, PathCallback callback) {
+    Request request;
+    request.id = m_NextRequestId.fetch_add(1, std::memory_order_relaxed);
+    request.start = start;
+    request.goal = goal;
+    request.callback = std::move(callback);
+    PathRequestId id = request.id;
+
+    m_RequestCount.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
+        m_Queue.push_back(std::move(request));
+    }
+    m_QueueCondition.notify_one();
+    return id;
+}
+
+std::future<PathResult> PathfindingService::RequestPathAsync(const Vector3& start, const Vector3& goal) {
+    Request request;
+    request.id = m_NextRequestId.fetch_add(1, std::memory_order_relaxed);
+    request.start = start;
+    request.goal = goal;
+    request.promise = std::make_shared<std::promise<PathResult>>();
+    std::future<PathResult> future = request.promise->get_future();
+
+    m_RequestCount.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
+        m_Queue.push_back(std::move(request));
+    }
+    m_QueueCondition.notify_one();
+    return future;
+}
+
+PathResult PathfindingService::FindPath(const Vector3& start, const Vector3& goal) {
+    SearchContext context;
+    m_RequestCount.fetch_add(1, std::memory_order_relaxed);
+    std::shared_lock<std::shared_mutex> lock(m_GraphMutex);
+    return Solve(start, goal, context);
+}
+
+uint32_t PathfindingService::Update() {
+    std::vector<Completed> completed;
+    {
+        std::lock_guard<std::mutex> lock(m_CompletedMutex);
+        completed.swap(m_Completed);
+    }
+    for (Completed& entry : completed) {
+        entry.callback(entry.id, entry.result);
+    }
+    return static_cast<uint32_t>(completed.size());
+}
+
+void PathfindingService::RebuildNavMesh(NavMeshBuilder& builder) {
+    if (builder.GetNavMesh() != m_NavMesh) {
+        std::cerr << "构建器的导航网格与寻路服务不一致！" << std::endl;
+        return;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_GraphMutex);
+    std::vector<uint32_t> rebuilt = builder.Rebuild();
+    if (rebuilt.empty()) {
+        return;
+    }
+
+    // 重建tile的邻居入口集合也会变化
+    std::vector<uint8_t> affected(m_NavMesh->GetTileCount(), 0);
+    for (uint32_t index : rebuilt) {
+        const NavMeshTile& tile = m_NavMesh->GetTile(index);
+        affected[index] = 1;
+        const int offsets[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+        for (const auto& offset : offsets) {
+            uint32_t neighbor = m_NavMesh->GetTileIndex(tile.x + offset[0], tile.z + offset[1]);
+            if (neighbor != UINT32_MAX) {
+                affected[neighbor] = 1;
+            }
+        }
+    }
+
+    std::vector<uint32_t> clusters;
+    for (uint32_t i = 0; i < affected.size(); ++i) {
+        if (affected[i]) {
+            clusters.push_back(i);
+        }
+    }
+    JobSystem::GetInstance().ParallelFor(static_cast<uint32_t>(clusters.size()), 1, [this, &clusters](uint32_t begin, uint32_t end) {
+        SearchContext context;
+        for (uint32_t i = begin; i < end; ++i) {
+            BuildCluster(clusters[i], context);
+        }
+    });
+
+    for (CacheShard& shard : m_CacheShards) {
+        std::lock_guard<std::mutex> shardLock(shard.mutex);
+        shard.lru.clear();
+        shard.entries.clear();
+    }
+}
+
+size_t PathfindingService::GetPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_QueueMutex);
+    return m_Queue.size();
+}
+
+PathfindingStats PathfindingService::GetStats() const {
+    PathfindingStats stats;
+    stats.requests = m_RequestCount.load(std::memory_order_relaxed);
+    stats.solved = m_SolvedCount.load(std::memory_order_relaxed);
+    stats.cacheHits = m_CacheHitCount.load(std::memory_order_relaxed);
+    stats.failed = m_FailedCount.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void PathfindingService::WorkerLoop() {
+    SearchContext context;
+    std::vector<Request> batch;
+    std::vector<Completed> completed;
+
+    for (;;) {
+        batch.clear();
+        {
+            std::unique_lock<std::mutex> lock(m_QueueMutex);
+            m_QueueCondition.wait(lock, [this]() { return m_Stopping || !m_Queue.empty(); });
+            if (m_Stopping) {
+                return;
+            }
+            // 一次取出一批请求，减少队列锁竞争
+            uint32_t count = std::min<uint32_t>(static_cast<uint32_t>(m_Queue.size()), std::max(m_Config.batchSize, 1u));
+            for (uint32_t i = 0; i < count; ++i) {
+                batch.push_back(std::move(m_Queue.front()));
+                m_Queue.pop_front();
+            }
+        }
+
+        completed.clear();
+        {
+            std::shared_lock<std::shared_mutex> lock(m_GraphMutex);
+            for (Request& request : batch) {
+                PathResult result = Solve(request.start, request.goal, context);
+                if (request.promise) {
+                    request.promise->set_value(result);
+                }
+                if (request.callback) {
+                    completed.push_back({ request.id, std::move(request.callback), std::move(result) });
+                }
+            }
+        }
+
+        if (!completed.empty()) {
+            std::lock_guard<std::mutex> lock(m_CompletedMutex);
+            for (Completed& entry : completed) {
+                m_Completed.push_back(std::move(entry));
+            }
+        }
+    }
+}
+
+PathResult PathfindingService::Solve(const Vector3& start, const Vector3& goal, SearchContext& context) {
+    PathResult result;
+
+    Vector3 startPoint, goalPoint;
+    NavPolyRef startRef = m_NavMesh->FindNearestPoly(start, m_Config.queryExtents, &startPoint);
+    if (startRef == NAV_INVALID_POLY_REF) {
+        result.status = PathStatus::InvalidStart;
+        m_FailedCount.fetch_add(1, std::memory_order_relaxed);
+        return result;
+    }
+    NavPolyRef goalRef = m_NavMesh->FindNearestPoly(goal, m_Config.queryExtents, &goalPoint);
+    if (goalRef == NAV_INVALID_POLY_REF) {
+        result.status = PathStatus::InvalidGoal;
+        m_FailedCount.fetch_add(1, std::memory_order_relaxed);
+        return result;
+    }
+
+    if (LookupCache(startRef, goalRef, result.corridor)) {
+        result.fromCache = true;
+        m_CacheHitCount.fetch_add(1, std::memory_order_relaxed);
+    } else if (FindCorridor(startRef, goalRef, context, result.corridor)) {
+        StoreCache(startRef, goalRef, result.corridor);
+    } else {
+        result.status = PathStatus::NoPath;
+        m_FailedCount.fetch_add(1, std::memory_order_relaxed);
+        return result;
+    }
+
+    StringPull(startPoint, goalPoint, result.corridor, result.waypoints);
+    result.status = PathStatus::Success;
+    m_SolvedCount.fetch_add(1, std::memory_order_relaxed);
+    return result;
+}
+
+bool PathfindingService::ClusterSearch(uint32_t tileIndex, uint32_t startPoly, uint32_t goalPoly, SearchContext& context) const {
+    const NavMeshTile& tile = m_NavMesh->GetTile(tileIndex);
+    context.Reset(tile.polys.size());
+    context.heap.clear();
+
+    // goalPoly为NO_PARENT时退化为Dijkstra，计算到簇内所有多边形的代价
+    const bool hasGoal = goalPoly != NO_PARENT;
+    const Vector3 goalCenter = hasGoal ? tile.polys[goalPoly].center : Vector3();
+    auto heuristic = [&](uint32_t poly) {
+        return hasGoal ? (tile.polys[poly].center - goalCenter).Length() : 0.0f;
+    };
+    auto compare = [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) {
+        return a.first > b.first;
+    };
+
+    context.SetG(startPoly, 0.0f, NO_PARENT);
+    context.heap.emplace_back(heuristic(startPoly), startPoly);
+
+    while (!context.heap.empty()) {
+        std::pop_heap(context.heap.begin(), context.heap.end(), compare);
+        auto [f, current] = context.heap.back();
+        context.heap.pop_back();
+
+        float currentG = context.GetG(current);
+        if (f > currentG + heuristic(current) + 1e-4f) {
+            continue;   // 过期条目
+        }
+        if (current == goalPoly) {
+            return true;
+        }
+
+        const NavPoly& poly = tile.polys[current];
+        for (const NavPolyLink& link : poly.links) {
+            if (GetNavPolyTile(link.neighbor) != tileIndex) {
+                continue;
+            }
+            uint32_t neighbor = GetNavPolyIndex(link.neighbor);
+            float g = currentG + (tile.polys[neighbor].center - poly.center).Length();
+            if (g < context.GetG(neighbor)) {
+                context.SetG(neighbor, g, current);
+                context.heap.emplace_back(g + heuristic(neighbor), neighbor);
+                std::push_heap(context.heap.begin(), context.heap.end(), compare);
+            }
+        }
+    }
+    return !hasGoal;
+}
+
+void PathfindingService::AppendClusterPath(uint32_t tileIndex, uint32_t goalPoly, const SearchContext& context, std::vector<NavPolyRef>& corridor) const {
+    size_t first = corridor.size();
+    for (uint32_t poly = goalPoly; poly != NO_PARENT; poly = context.parent[poly]) {
+        corridor.push_back(MakeNavPolyRef(tileIndex, poly));
+    }
+    std::reverse(corridor.begin() + static_cast<std::ptrdiff_t>(first), corridor.end());
+
+    // 与上一段路径首尾相接的多边形只保留一份
+    if (first > 0 && corridor.size() > first && corridor[first - 1] == corridor[first]) {
+        corridor.erase(corridor.begin() + static_cast<std::ptrdiff_t>(first));
+    }
+}
+
+void PathfindingService::BuildCluster(uint32_t tileIndex, SearchContext& context) {
+    const NavMeshTile& tile = m_NavMesh->GetTile(tileIndex);
+    Cluster& cluster = m_Clusters[tileIndex];
+    cluster.entrances.clear();
+    cluster.entranceOfPoly.assign(tile.polys.size(), -1);
+
+    for (uint32_t i = 0; i < tile.polys.size(); ++i) {
+        for (const NavPolyLink& link : tile.polys[i].links) {
+            if (GetNavPolyTile(link.neighbor) != tileIndex) {
+                cluster.entranceOfPoly[i] = static_cast<int32_t>(cluster.entrances.size());
+                cluster.entrances.push_back(i);
+                break;
+            }
+        }
+    }
+
+    const size_t count = cluster.entrances.size();
+    cluster.costs.assign(count * count, FLT_MAX);
+    for (size_t i = 0; i < count; ++i) {
+        ClusterSearch(tileIndex, cluster.entrances[i], NO_PARENT, context);
+        for (size_t j = 0; j < count; ++j) {
+            cluster.costs[i * count + j] = context.GetG(cluster.entrances[j]);
+        }
+    }
+}
+
+bool PathfindingService::FindCorridor(NavPolyRef startRef, NavPolyRef goalRef, SearchContext& context, std::vector<NavPolyRef>& corridor) const {
+    const uint32_t startTile = GetNavPolyTile(startRef);
+    const uint32_t goalTile = GetNavPolyTile(goalRef);
+    const uint32_t startPoly = GetNavPolyIndex(startRef);
+    const uint32_t goalPoly = GetNavPolyIndex(goalRef);
+    corridor.clear();
+
+    // 同一簇内优先尝试局部搜索
+    if (startTile == goalTile && ClusterSearch(startTile, startPoly, goalPoly, context)) {
+        AppendClusterPath(startTile, goalPoly, context, corridor);
+        return true;
+    }
+
+    // 将起点和终点接入抽象图
+    const Cluster& startCluster = m_Clusters[startTile];
+    const Cluster& goalCluster = m_Clusters[goalTile];
+    ClusterSearch(startTile, startPoly, NO_PARENT, context);
+    context.startCosts.resize(startCluster.entrances.size());
+    for (size_t i = 0; i < startCluster.entrances.size(); ++i) {
+        context.startCosts[i] = context.GetG(startCluster.entrances[i]);
+    }
+    ClusterSearch(goalTile, goalPoly, NO_PARENT, context);
+    context.goalCosts.resize(goalCluster.entrances.size());
+    for (size_t i = 0; i < goalCluster.entrances.size(); ++i) {
+        context.goalCosts[i] = context.GetG(goalCluster.entrances[i]);
+    }
+
+    // 抽象图A*
+    const Vector3 goalCenter = m_NavMesh->GetPoly(goalRef)->center;
+    auto compare = [](const std::pair<float, NavPolyRef>& a, const std::pair<float, NavPolyRef>& b) {
+        return a.first > b.first;
+    };
+    auto& states = context.abstractStates;
+    auto& heap = context.abstractHeap;
+    states.clear();
+    heap.clear();
+
+    auto relax = [&](NavPolyRef node, float g, NavPolyRef parent) {
+        auto it = states.find(node);
+        if (it != states.end() && it->second.g <= g) {
+            return;
+        }
+        states[node] = { g, parent };
+        float h = node == GOAL_KEY ? 0.0f : (m_NavMesh->GetPoly(node)->center - goalCenter).Length();
+        heap.emplace_back(g + h, node);
+        std::push_heap(heap.begin(), heap.end(), compare);
+    };
+
+    states[START_KEY] = { 0.0f, NAV_INVALID_POLY_REF };
+    heap.emplace_back(0.0f, START_KEY);
+    bool found = false;
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), compare);
+        auto [f, node] = heap.back();
+        heap.pop_back();
+
+        if (node == GOAL_KEY) {
+            found = true;
+            break;
+        }
+
+        const float g = states[node].g;
+        const NavPolyRef polyRef = node == START_KEY ? startRef : node;
+        const uint32_t tileIndex = GetNavPolyTile(polyRef);
+        const NavPoly* poly = m_NavMesh->GetPoly(polyRef);
+        if (node != START_KEY && f > g + (poly->center - goalCenter).Length() + 1e-4f) {
+            continue;   // 过期条目
+        }
+
+        const Cluster& cluster = m_Clusters[tileIndex];
+        const int32_t entrance = cluster.entranceOfPoly[GetNavPolyIndex(polyRef)];
+        const size_t count = cluster.entrances.size();
+
+        if (node == START_KEY) {
+            for (size_t j = 0; j < count; ++j) {
+                if (context.startCosts[j] < FLT_MAX) {
+                    relax(MakeNavPolyRef(tileIndex, cluster.entrances[j]), context.startCosts[j], START_KEY);
+                }
+            }
+        } else if (entrance >= 0) {
+            for (size_t j = 0; j < count; ++j) {
+                float cost = cluster.costs[static_cast<size_t>(entrance) * count + j];
+                if (static_cast<int32_t>(j) != entrance && cost < FLT_MAX) {
+                    relax(MakeNavPolyRef(tileIndex, cluster.entrances[j]), g + cost, node);
+                }
+            }
+        }
+
+        // 跨簇连接
+        for (const NavPolyLink& link : poly->links) {
+            if (GetNavPolyTile(link.neighbor) != tileIndex) {
+                relax(link.neighbor, g + (m_NavMesh->GetPoly(link.neighbor)->center - poly->center).Length(), node);
+            }
+        }
+
+        // 接入终点
+        if (tileIndex == goalTile && entrance >= 0 && context.goalCosts[static_cast<size_t>(entrance)] < FLT_MAX) {
+            relax(GOAL_KEY, g + context.goalCosts[static_cast<size_t>(entrance)], node);
+        }
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    // 回溯抽象路径（不含起点和终点哨兵）
+    context.abstractPath.clear();
+    for (NavPolyRef node = states[GOAL_KEY].parent; node != START_KEY; node = states[node].parent) {
+        context.abstractPath.push_back(node);
+    }
+    std::reverse(context.abstractPath.begin(), context.abstractPath.end());
+
+    // 逐段细化为多边形走廊
+    NavPolyRef previous = startRef;
+    corridor.push_back(startRef);
+    for (NavPolyRef node : context.abstractPath) {
+        if (node == previous) {
+            continue;
+        }
+        uint32_t tileIndex = GetNavPolyTile(node);
+        if (tileIndex == GetNavPolyTile(previous)) {
+            if (!ClusterSearch(tileIndex, GetNavPolyIndex(previous), GetNavPolyIndex(node), context)) {
+                return false;
+            }
+            AppendClusterPath(tileIndex, GetNavPolyIndex(node), context, corridor);
+        } else {
+            corridor.push_back(node);
+        }
+        previous = node;
+    }
+    if (previous != goalRef) {
+        if (!ClusterSearch(goalTile, GetNavPolyIndex(previous), goalPoly, context)) {
+            return false;
+        }
+        AppendClusterPath(goalTile, goalPoly, context, corridor);
+    }
+    return true;
+}
+
+void PathfindingService::StringPull(const Vector3& start, const Vector3& goal, const std::vector<NavPolyRef>& corridor, std::vector<Vector3>& waypoints) const {
+    waypoints.clear();
+
+    // 收集走廊上的入口线段
+    std::vector<std::pair<Vector3, Vector3>> portals;
+    portals.reserve(corridor.size() + 1);
+    portals.emplace_back(start, start);
+    for (size_t i = 0; i + 1 < corridor.size(); ++i) {
+        const NavPoly* poly = m_NavMesh->GetPoly(corridor[i]);
+        for (const NavPolyLink& link : poly->links) {
+            if (link.neighbor == corridor[i + 1]) {
+                portals.emplace_back(link.portalLeft, link.portalRight);
+                break;
+            }
+        }
+    }
+    portals.emplace_back(goal, goal);
+
+    // 简单漏斗算法
+    Vector3 apex = start;
+    Vector3 left = start;
+    Vector3 right = start;
+    size_t apexIndex = 0;
+    size_t leftIndex = 0;
+    size_t rightIndex = 0;
+    waypoints.push_back(start);
+
+    for (size_t i = 1; i < portals.size(); ++i) {
+        const Vector3& portalLeft = portals[i].first;
+        const Vector3& portalRight = portals[i].second;
+
+        // 收紧右边界
+        if (TriArea2(apex, right, portalRight) <= 0.0f) {
+            if (NearlyEqual(apex, right) || TriArea2(apex, left, portalRight) > 0.0f) {
+                right = portalRight;
+                rightIndex = i;
+            } else {
+                // 右边界越过左边界，左端点成为新的拐点
+                waypoints.push_back(left);
+                apex = left;
+                apexIndex = leftIndex;
+                right = apex;
+                rightIndex = apexIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+
+        // 收紧左边界
+        if (TriArea2(apex, left, portalLeft) >= 0.0f) {
+            if (NearlyEqual(apex, left) || TriArea2(apex, right, portalLeft) < 0.0f) {
+                left = portalLeft;
+                leftIndex = i;
+            } else {
+                waypoints.push_back(right);
+                apex = right;
+                apexIndex = rightIndex;
+                left = apex;
+                leftIndex = apexIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+    }
+
+    if (!NearlyEqual(waypoints.back(), goal)) {
+        waypoints.push_back(goal);
+    }
+}
+
+bool PathfindingService::LookupCache(NavPolyRef startRef, NavPolyRef goalRef, std::vector<NavPolyRef>& corridor) {
+    const uint64_t key = MakeCacheKey(startRef, goalRef);
+    CacheShard& shard = m_CacheShards[key % CACHE_SHARD_COUNT];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.entries.find(key);
+    if (it == shard.entries.end() || it->second->second.startRef != startRef || it->second->second.goalRef != goalRef) {
+        return false;
+    }
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    corridor = it->second->second.corridor;
+    return true;
+}
+
+void PathfindingService::StoreCache(NavPolyRef startRef, NavPolyRef goalRef, const std::vector<NavPolyRef>& corridor) {
+    const size_t shardCapacity = std::max<size_t>(m_Config.cacheCapacity / CACHE_SHARD_COUNT, 1);
+    if (m_Config.cacheCapacity == 0) {
+        return;
+    }
+
+    const uint64_t key = MakeCacheKey(startRef, goalRef);
+    CacheShard& shard = m_CacheShards[key % CACHE_SHARD_COUNT];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.entries.find(key);
+    if (it != shard.entries.end()) {
+        it->second->second = { startRef, goalRef, corridor };
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return;
+    }
+
+    shard.lru.emplace_front(key, CacheEntry{ startRef, goalRef, corridor });
+    shard.entries[key] = shard.lru.begin();
+    if (shard.lru.size() > shardCapacity) {
+        shard.entries.erase(shard.lru.back().first);
+        shard.lru.pop_back();
+    }
+}
+
+} // namespace PLE
@@ -0,0 +1,492 @@
+/**
+ * @file BakeBVH.cpp
+ * @brief 烘焙用的四叉层次包围盒实现
+ */
+
+#include "BakeBVH.h"
+#include "PhantomLightEngine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef PLE_SIMD_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace PLE {
+
+namespace {
+
+constexpr uint32_t LEAF_FLAG = 0x80000000u;
+constexpr uint32_t EMPTY_CHILD = 0xFFFFFFFFu;
+constexpr uint32_t MAX_LEAF_TRIANGLES = 4;
+constexpr uint32_t BIN_COUNT = 16;
+constexpr uint32_t MAX_SAH_DEPTH = 48;      // 超过此深度改为按中位数划分，限制树高和遍历栈
+constexpr uint32_t STACK_SIZE = 256;
+
+struct Bounds {
+    float min[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+    float max[3] = { -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
+
+    void Grow(const float point[3]) {
+        for (int axis = 0; axis < 3; ++axis) {
+            min[axis] = std::min(min[axis], point[axis]);
+            max[axis] = std::max(max[axis], point[axis]);
+        }
+    }
+
+    void Grow(const Bounds& other) {
+        for (int axis = 0; axis < 3; ++axis) {
+            min[axis] = std::min(min[axis], other.min[axis]);
+            max[axis] = std::max(max[axis], other.max[axis]);
+        }
+    }
+
+    float Area() const {
+        const float dx = max[0] - min[0];
+        const float dy = max[1] - min[1];
+        const float dz = max[2] - min[2];
+        if (dx < 0.0f || dy < 0.0f || dz < 0.0f) {
+            return 0.0f;
+        }
+        return 2.0f * (dx * dy + dy * dz + dz * dx);
+    }
+};
+
+/**
+ * @brief 构建用的二叉节点
+ */
+struct BinaryNode {
+    Bounds bounds;
+    uint32_t left = 0;
+    uint32_t right = 0;
+    uint32_t first = 0;         // 叶节点的三角形在排序数组中的范围
+    uint32_t count = 0;         // 大于0表示叶节点
+};
+
+struct BuildContext {
+    std::vector<Bounds> triangleBounds;
+    std::vector<float> centroids;       // 每个三角形3个分量
+    std::vector<uint32_t> order;
+    std::vector<BinaryNode> nodes;
+};
+
+uint32_t BuildBinary(BuildContext& context, uint32_t first, uint32_t count, uint32_t depth) {
+    const uint32_t index = static_cast<uint32_t>(context.nodes.size());
+    context.nodes.emplace_back();
+
+    Bounds bounds;
+    Bounds centroidBounds;
+    for (uint32_t i = first; i < first + count; ++i) {
+        const uint32_t triangle = context.order[i];
+        bounds.Grow(context.triangleBounds[triangle]);
+        centroidBounds.Grow(&context.centroids[triangle * 3]);
+    }
+    context.nodes[index].bounds = bounds;
+
+    if (count <= MAX_LEAF_TRIANGLES) {
+        context.nodes[index].first = first;
+        context.nodes[index].count = count;
+        return index;
+    }
+
+    int axis = 0;
+    for (int i = 1; i < 3; ++i) {
+        if (centroidBounds.max[i] - centroidBounds.min[i] > centroidBounds.max[axis] - centroidBounds.min[axis]) {
+            axis = i;
+        }
+    }
+    const float extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+    uint32_t* begin = context.order.data() + first;
+    uint32_t* end = begin + count;
+    uint32_t split = count / 2;
+
+    if (extent > 0.0f && depth < MAX_SAH_DEPTH) {
+        // 分箱SAH：在BIN_COUNT-1个候选平面中选代价最小的
+        Bounds binBounds[BIN_COUNT];
+        uint32_t binCounts[BIN_COUNT] = {};
+        const float scale = static_cast<float>(BIN_COUNT) / extent;
+        auto binOf = [&](uint32_t triangle) {
+            const float offset = (context.centroids[triangle * 3 + axis] - centroidBounds.min[axis]) * scale;
+            return std::min(static_cast<uint32_t>(offset), BIN_COUNT - 1);
+        };
+        for (uint32_t* it = begin; it != end; ++it) {
+            const uint32_t bin = binOf(*it);
+            binBounds[bin].Grow(context.triangleBounds[*it]);
+            ++binCounts[bin];
+        }
+
+        float rightArea[BIN_COUNT] = {};
+        uint32_t rightCount[BIN_COUNT] = {};
+        Bounds accumulated;
+        uint32_t accumulatedCount = 0;
+        for (uint32_t bin = BIN_COUNT - 1; bin > 0; --bin) {
+            accumulated.Grow(binBounds[bin]);
+            accumulatedCount += binCounts[bin];
+            rightArea[bin] = accumulated.Area();
+            rightCount[bin] = accumulatedCount;
+        }
+
+        float bestCost = std::numeric_limits<float>::max();
+        uint32_t bestBin = 0;
+        accumulated = Bounds();
+        accumulatedCount = 0;
+        for (uint32_t bin = 1; bin < BIN_COUNT; ++bin) {
+            accumulated.Grow(binBounds[bin - 1]);
+            accumulatedCount += binCounts[bin - 1];
+            if (accumulatedCount == 0 || rightCount[bin] == 0) {
+                continue;
+            }
+            const float cost = accumulated.Area() * static_cast<float>(accumulatedCount) + rightArea[bin] * static_cast<float>(rightCount[bin]);
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestBin = bin;
+            }
+        }
+
+        if (bestBin > 0) {
+            uint32_t* middle = std::partition(begin, end, [&](uint32_t triangle) { return binOf(triangle) < bestBin; });
+            split = static_cast<uint32_t>(middle - begin);
+        }
+    }
+
+    if (split == 0 || split == count || depth >= MAX_SAH_DEPTH || extent <= 0.0f) {
+        split = count / 2;
+        std::nth_element(begin, begin + split, end, [&](uint32_t a, uint32_t b) {
+            return context.centroids[a * 3 + axis] < context.centroids[b * 3 + axis];
+        });
+    }
+
+    const uint32_t left = BuildBinary(context, first, split, depth + 1);
+    const uint32_t right = BuildBinary(context, first + split, count - split, depth + 1);
+    context.nodes[index].left = left;
+    context.nodes[index].right = right;
+    return index;
+}
+
+#ifdef PLE_SIMD_SSE2
+inline __m128 Cross(const __m128 ax, const __m128 ay, const __m128 az, const __m128 bx, const __m128 by, const __m128 bz, __m128& y, __m128& z) {
+    y = _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz));
+    z = _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx));
+    return _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by));
+}
+
+inline __m128 Dot(const __m128 ax, const __m128 ay, const __m128 az, const __m128 bx, const __m128 by, const __m128 bz) {
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+}
+#endif
+
+/**
+ * @brief 方向分量为0时替换为极小值，避免包围盒求交中出现0乘无穷
+ */
+float SafeInverse(float value) {
+    const float epsilon = 1.0e-20f;
+    if (std::fabs(value) < epsilon) {
+        value = value < 0.0f ? -epsilon : epsilon;
+    }
+    return 1.0f / value;
+}
+
+} // namespace
+
+void BakeBVH::Build(const std::vector<Vector3>& positions) {
+    m_Nodes.clear();
+    m_Packets.clear();
+    const uint32_t triangleCount = static_cast<uint32_t>(positions.size() / 3);
+    if (triangleCount == 0) {
+        return;
+    }
+
+    BuildContext context;
+    context.triangleBounds.resize(triangleCount);
+    context.centroids.resize(static_cast<size_t>(triangleCount) * 3);
+    context.order.resize(triangleCount);
+    context.nodes.reserve(static_cast<size_t>(triangleCount) * 2);
+    for (uint32_t i = 0; i < triangleCount; ++i) {
+        Bounds& bounds = context.triangleBounds[i];
+        for (uint32_t k = 0; k < 3; ++k) {
+            const Vector3& p = positions[i * 3 + k];
+            const float point[3] = { p.x, p.y, p.z };
+            bounds.Grow(point);
+        }
+        for (int axis = 0; axis < 3; ++axis) {
+            context.centroids[i * 3 + axis] = (bounds.min[axis] + bounds.max[axis]) * 0.5f;
+        }
+        context.order[i] = i;
+    }
+    BuildBinary(context, 0, triangleCount, 0);
+
+    auto makePacket = [&](const BinaryNode& leaf) {
+        TrianglePacket packet = {};
+        for (uint32_t lane = 0; lane < 4; ++lane) {
+            if (lane >= leaf.count) {
+                packet.id[lane] = EMPTY_CHILD;
+                continue;
+            }
+            const uint32_t triangle = context.order[leaf.first + lane];
+            const Vector3& v0 = positions[triangle * 3];
+            const Vector3 e1 = positions[triangle * 3 + 1] - v0;
+            const Vector3 e2 = positions[triangle * 3 + 2] - v0;
+            packet.v0x[lane] = v0.x;
+            packet.v0y[lane] = v0.y;
+            packet.v0z[lane] = v0.z;
+            packet.e1x[lane] = e1.x;
+            packet.e1y[lane] = e1.y;
+            packet.e1z[lane] = e1.z;
+            packet.e2x[lane] = e2.x;
+            packet.e2y[lane] = e2.y;
+            packet.e2z[lane] = e2.z;
+            packet.id[lane] = triangle;
+        }
+        m_Packets.push_back(packet);
+        return LEAF_FLAG | static_cast<uint32_t>(m_Packets.size() - 1);
+    };
+
+    // 折叠为四叉树：反复展开面积最大的内部子节点，直到有4个子节点或全是叶节点
+    struct Collapser {
+        BakeBVH& bvh;
+        const BuildContext& context;
+        const decltype(makePacket)& packetOf;
+
+        uint32_t Collapse(uint32_t binaryIndex) {
+            uint32_t children[4];
+            uint32_t childCount = 0;
+            const BinaryNode& binary = context.nodes[binaryIndex];
+            if (binary.count > 0) {
+                children[childCount++] = binaryIndex;
+            } else {
+                children[childCount++] = binary.left;
+                children[childCount++] = binary.right;
+            }
+            while (childCount < 4) {
+                int best = -1;
+                float bestArea = -1.0f;
+                for (uint32_t i = 0; i < childCount; ++i) {
+                    const BinaryNode& child = context.nodes[children[i]];
+                    if (child.count == 0 && child.bounds.Area() > bestArea) {
+                        bestArea = child.bounds.Area();
+                        best = static_cast<int>(i);
+                    }
+                }
+                if (best < 0) {
+                    break;
+                }
+                const BinaryNode& expanded = context.nodes[children[best]];
+                children[best] = expanded.left;
+                children[childCount++] = expanded.right;
+            }
+
+            const uint32_t index = static_cast<uint32_t>(bvh.m_Nodes.size());
+            bvh.m_Nodes.emplace_back();
+            for (uint32_t slot = 0; slot < 4; ++slot) {
+                uint32_t child = EMPTY_CHILD;
+                Bounds bounds;
+                if (slot < childCount) {
+                    const BinaryNode& binaryChild = context.nodes[children[slot]];
+                    bounds = binaryChild.bounds;
+                    child = binaryChild.count > 0 ? packetOf(binaryChild) : Collapse(children[slot]);
+                }
+                // 递归可能使m_Nodes重新分配，按序号写回
+                Node& node = bvh.m_Nodes[index];
+                node.minX[slot] = bounds.min[0];
+                node.minY[slot] = bounds.min[1];
+                node.minZ[slot] = bounds.min[2];
+                node.maxX[slot] = bounds.max[0];
+                node.maxY[slot] = bounds.max[1];
+                node.maxZ[slot] = bounds.max[2];
+                node.child[slot] = child;
+            }
+            return index;
+        }
+    };
+    Collapser collapser{ *this, context, makePacket };
+    collapser.Collapse(0);
+}
+
+bool BakeBVH::Intersect(const Vector3& origin, const Vector3& direction, float tMax, BakeHit& hit) const {
+    return Traverse<false>(origin, direction, tMax, &hit);
+}
+
+bool BakeBVH::Occluded(const Vector3& origin, const Vector3& direction, float tMax) const {
+    return Traverse<true>(origin, direction, tMax, nullptr);
+}
+
+template <bool AnyHit>
+bool BakeBVH::Traverse(const Vector3& origin, const Vector3& direction, float tMax, BakeHit* hit) const {
+    if (m_Nodes.empty()) {
+        return false;
+    }
+
+    const float inverse[3] = { SafeInverse(direction.x), SafeInverse(direction.y), SafeInverse(direction.z) };
+    float tBest = tMax;
+    bool found = false;
+
+    struct StackEntry {
+        uint32_t child;
+        float distance;
+    };
+    StackEntry stack[STACK_SIZE];
+    uint32_t stackSize = 0;
+    stack[stackSize++] = { 0, 0.0f };
+
+#ifdef PLE_SIMD_SSE2
+    const __m128 ox = _mm_set1_ps(origin.x);
+    const __m128 oy = _mm_set1_ps(origin.y);
+    const __m128 oz = _mm_set1_ps(origin.z);
+    const __m128 dx = _mm_set1_ps(direction.x);
+    const __m128 dy = _mm_set1_ps(direction.y);
+    const __m128 dz = _mm_set1_ps(direction.z);
+    const __m128 ix = _mm_set1_ps(inverse[0]);
+    const __m128 iy = _mm_set1_ps(inverse[1]);
+    const __m128 iz = _mm_set1_ps(inverse[2]);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 epsilon = _mm_set1_ps(1.0e-12f);
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+#endif
+
+    while (stackSize > 0) {
+        const StackEntry entry = stack[--stackSize];
+        if (entry.distance > tBest) {
+            continue;
+        }
+
+        if (entry.child & LEAF_FLAG) {
+            const TrianglePacket& packet = m_Packets[entry.child & ~LEAF_FLAG];
+            float t[4];
+            float u[4];
+            float v[4];
+            int mask = 0;
+
+#ifdef PLE_SIMD_SSE2
+            // Möller-Trumbore，4个三角形同时计算，双面
+            const __m128 e1x = _mm_load_ps(packet.e1x);
+            const __m128 e1y = _mm_load_ps(packet.e1y);
+            const __m128 e1z = _mm_load_ps(packet.e1z);
+            const __m128 e2x = _mm_load_ps(packet.e2x);
+            const __m128 e2y = _mm_load_ps(packet.e2y);
+            const __m128 e2z = _mm_load_ps(packet.e2z);
+            __m128 py;
+            __m128 pz;
+            const __m128 px = Cross(dx, dy, dz, e2x, e2y, e2z, py, pz);
+            const __m128 det = Dot(e1x, e1y, e1z, px, py, pz);
+            const __m128 inverseDet = _mm_div_ps(one, det);
+            const __m128 tx = _mm_sub_ps(ox, _mm_load_ps(packet.v0x));
+            const __m128 ty = _mm_sub_ps(oy, _mm_load_ps(packet.v0y));
+            const __m128 tz = _mm_sub_ps(oz, _mm_load_ps(packet.v0z));
+            const __m128 uu = _mm_mul_ps(Dot(tx, ty, tz, px, py, pz), inverseDet);
+            __m128 qy;
+            __m128 qz;
+            const __m128 qx = Cross(tx, ty, tz, e1x, e1y, e1z, qy, qz);
+            const __m128 vv = _mm_mul_ps(Dot(dx, dy, dz, qx, qy, qz), inverseDet);
+            const __m128 tt = _mm_mul_ps(Dot(e2x, e2y, e2z, qx, qy, qz), inverseDet);
+            __m128 valid = _mm_cmpgt_ps(_mm_and_ps(det, signMask), epsilon);
+            valid = _mm_and_ps(valid, _mm_cmpge_ps(uu, zero));
+            valid = _mm_and_ps(valid, _mm_cmpge_ps(vv, zero));
+            valid = _mm_and_ps(valid, _mm_cmple_ps(_mm_add_ps(uu, vv), one));
+            valid = _mm_and_ps(valid, _mm_cmpgt_ps(tt, zero));
+            valid = _mm_and_ps(valid, _mm_cmplt_ps(tt, _mm_set1_ps(tBest)));
+            mask = _mm_movemask_ps(valid);
+            _mm_storeu_ps(t, tt);
+            _mm_storeu_ps(u, uu);
+            _mm_storeu_ps(v, vv);
+#else
+            for (int lane = 0; lane < 4; ++lane) {
+                const Vector3 e1(packet.e1x[lane], packet.e1y[lane], packet.e1z[lane]);
+                const Vector3 e2(packet.e2x[lane], packet.e2y[lane], packet.e2z[lane]);
+                const Vector3 p = direction.Cross(e2);
+                const float det = e1.Dot(p);
+                if (std::fabs(det) <= 1.0e-12f) {
+                    continue;
+                }
+                const float inverseDet = 1.0f / det;
+                const Vector3 s = origin - Vector3(packet.v0x[lane], packet.v0y[lane], packet.v0z[lane]);
+                const Vector3 q = s.Cross(e1);
+                u[lane] = s.Dot(p) * inverseDet;
+                v[lane] = direction.Dot(q) * inverseDet;
+                t[lane] = e2.Dot(q) * inverseDet;
+                if (u[lane] >= 0.0f && v[lane] >= 0.0f && u[lane] + v[lane] <= 1.0f && t[lane] > 0.0f && t[lane] < tBest) {
+                    mask |= 1 << lane;
+                }
+            }
+#endif
+
+            if (mask != 0) {
+                if (AnyHit) {
+                    return true;
+                }
+                for (int lane = 0; lane < 4; ++lane) {
+                    if ((mask & (1 << lane)) && t[lane] < tBest) {
+                        tBest = t[lane];
+                        hit->t = t[lane];
+                        hit->u = u[lane];
+                        hit->v = v[lane];
+                        hit->triangle = packet.id[lane];
+                        found = true;
+                    }
+                }
+            }
+            continue;
+        }
+
+        const Node& node = m_Nodes[entry.child];
+        float distances[4];
+        int mask = 0;
+
+#ifdef PLE_SIMD_SSE2
+        const __m128 x0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minX), ox), ix);
+        const __m128 x1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxX), ox), ix);
+        const __m128 y0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minY), oy), iy);
+        const __m128 y1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxY), oy), iy);
+        const __m128 z0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minZ), oz), iz);
+        const __m128 z1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxZ), oz), iz);
+        const __m128 tNear = _mm_max_ps(_mm_max_ps(_mm_min_ps(x0, x1), _mm_min_ps(y0, y1)), _mm_max_ps(_mm_min_ps(z0, z1), zero));
+        const __m128 tFar = _mm_min_ps(_mm_min_ps(_mm_max_ps(x0, x1), _mm_max_ps(y0, y1)), _mm_min_ps(_mm_max_ps(z0, z1), _mm_set1_ps(tBest)));
+        mask = _mm_movemask_ps(_mm_cmple_ps(tNear, tFar));
+        _mm_storeu_ps(distances, tNear);
+#else
+        const float* minimum[3] = { node.minX, node.minY, node.minZ };
+        const float* maximum[3] = { node.maxX, node.maxY, node.maxZ };
+        const float start[3] = { origin.x, origin.y, origin.z };
+        for (int lane = 0; lane < 4; ++lane) {
+            float tNear = 0.0f;
+            float tFar = tBest;
+            for (int axis = 0; axis < 3; ++axis) {
+                const float t0 = (minimum[axis][lane] - start[axis]) * inverse[axis];
+                const float t1 = (maximum[axis][lane] - start[axis]) * inverse[axis];
+                tNear = std::max(tNear, std::min(t0, t1));
+                tFar = std::min(tFar, std::max(t0, t1));
+            }
+            distances[lane] = tNear;
+            if (tNear <= tFar) {
+                mask |= 1 << lane;
+            }
+        }
+#endif
+
+        // 空槽位的包围盒为空（min > max），也可能通过测试，按子节点排除
+        uint32_t hitChildren[4];
+        float hitDistances[4];
+        uint32_t hitCount = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+            if ((mask & (1 << lane)) && node.child[lane] != EMPTY_CHILD) {
+                // 按距离插入排序，最近的最后入栈、最先遍历
+                uint32_t position = hitCount++;
+                while (position > 0 && hitDistances[position - 1] < distances[lane]) {
+                    hitChildren[position] = hitChildren[position - 1];
+                    hitDistances[position] = hitDistances[position - 1];
+                    --position;
+                }
+                hitChildren[position] = node.child[lane];
+                hitDistances[position] = distances[lane];
+            }
+        }
+        for (uint32_t i = 0; i < hitCount && stackSize < STACK_SIZE; ++i) {
+            stack[stackSize++] = { hitChildren[i], hitDistances[i] };
+        }
+    }
+    return found;
+}
+
+} // namespace PLE
@@ -0,0 +1,104 @@
+/**
+ * @file BakeBVH.h
+ * @brief 烘焙用的四叉层次包围盒（光线求交）
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Math/Vector.h"
+
+namespace PLE {
+
+/**
+ * @brief 光线与三角形的最近交点
+ */
+struct BakeHit {
+    float t = 0.0f;
+    float u = 0.0f;                 // 重心坐标，交点 = v0 * (1 - u - v) + v1 * u + v2 * v
+    float v = 0.0f;
+    uint32_t triangle = 0;          // Build时的三角形序号
+};
+
+/**
+ * @brief 四叉BVH
+ *
+ * 先按分箱SAH构建二叉树，再把每个节点与其面积最大的内部子节点合并，折叠为四叉树。
+ * 节点以SoA存放4个子节点的包围盒，一条光线一次与4个包围盒求交；叶节点最多4个三角形，
+ * 同样以SoA存放，一次与4个三角形求交（SSE2，不可用时退化为逐个计算）。
+ * 烘焙的光线在第一次反弹后就失去了相干性，光线包在这种情况下几乎没有收益，
+ * 宽节点的单光线遍历对不相干光线同样有效。
+ */
+class BakeBVH {
+public:
+    /**
+     * @brief 构建
+     * @param positions 三角形顶点，每3个一个三角形（世界空间）
+     */
+    void Build(const std::vector<Vector3>& positions);
+
+    /**
+     * @brief 最近交点
+     * @param origin 光线起点
+     * @param direction 光线方向（不要求单位长度，t以direction为单位）
+     * @param tMax 最大距离
+     * @param hit 输出交点
+     * @return 是否相交
+     */
+    bool Intersect(const Vector3& origin, const Vector3& direction, float tMax, BakeHit& hit) const;
+
+    /**
+     * @brief 任意交点（阴影光线），找到第一个交点即返回
+     */
+    bool Occluded(const Vector3& origin, const Vector3& direction, float tMax) const;
+
+    /**
+     * @brief 节点数量
+     */
+    uint32_t GetNodeCount() const { return static_cast<uint32_t>(m_Nodes.size()); }
+
+    /**
+     * @brief 是否为空
+     */
+    bool IsEmpty() const { return m_Nodes.empty(); }
+
+private:
+    /**
+     * @brief 四叉节点，child的最高位表示叶节点（低位为三角形包序号），空槽位的包围盒为空
+     */
+    struct alignas(16) Node {
+        float minX[4];
+        float minY[4];
+        float minZ[4];
+        float maxX[4];
+        float maxY[4];
+        float maxZ[4];
+        uint32_t child[4];
+    };
+
+    /**
+     * @brief 4个三角形（SoA），不足4个时用退化三角形补齐
+     */
+    struct alignas(16) TrianglePacket {
+        float v0x[4];
+        float v0y[4];
+        float v0z[4];
+        float e1x[4];
+        float e1y[4];
+        float e1z[4];
+        float e2x[4];
+        float e2y[4];
+        float e2z[4];
+        uint32_t id[4];
+    };
+
+    template <bool AnyHit>
+    bool Traverse(const Vector3& origin, const Vector3& direction, float tMax, BakeHit* hit) const;
+
+    std::vector<Node> m_Nodes;
+    std::vector<TrianglePacket> m_Packets;
+};
+
+} // namespace PLE
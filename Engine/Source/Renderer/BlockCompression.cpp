@@ -0,0 +1,739 @@
+/**
+ * @file BlockCompression.cpp
+ * @brief BC1/BC3/BC5/BC7块压缩实现
+ */
+
+#include "BlockCompression.h"
+#include "Renderer/RenderResources.h"
+#include "Core/JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace PLE {
+
+namespace {
+
+/**
+ * @brief 求点集的均值和主成分方向（协方差矩阵的幂迭代）
+ */
+template <int Channels>
+void ComputePrincipalAxis(const float (*points)[4], const bool* active, float mean[4], float axis[4]) {
+    uint32_t count = 0;
+    float sum[4] = {};
+    for (int i = 0; i < 16; ++i) {
+        if (!active[i]) {
+            continue;
+        }
+        ++count;
+        for (int c = 0; c < Channels; ++c) {
+            sum[c] += points[i][c];
+        }
+    }
+    for (int c = 0; c < 4; ++c) {
+        mean[c] = count > 0 && c < Channels ? sum[c] / count : 0.0f;
+        axis[c] = 0.0f;
+    }
+    if (count == 0) {
+        return;
+    }
+
+    float covariance[Channels][Channels] = {};
+    for (int i = 0; i < 16; ++i) {
+        if (!active[i]) {
+            continue;
+        }
+        float d[Channels];
+        for (int c = 0; c < Channels; ++c) {
+            d[c] = points[i][c] - mean[c];
+        }
+        for (int r = 0; r < Channels; ++r) {
+            for (int c = 0; c < Channels; ++c) {
+                covariance[r][c] += d[r] * d[c];
+            }
+        }
+    }
+
+    // 从方差最大的通道对应的协方差行出发迭代，收敛到最大特征值对应的方向。
+    // 不能用包围盒对角线：各分量都非负，通道负相关（如红绿两色）时它与主轴正交，迭代结果为零
+    int dominant = 0;
+    for (int c = 1; c < Channels; ++c) {
+        if (covariance[c][c] > covariance[dominant][dominant]) {
+            dominant = c;
+        }
+    }
+    if (covariance[dominant][dominant] <= 0.0f) {
+        return;
+    }
+    float vector[Channels];
+    for (int c = 0; c < Channels; ++c) {
+        vector[c] = covariance[dominant][c];
+    }
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float next[Channels] = {};
+        float length = 0.0f;
+        for (int r = 0; r < Channels; ++r) {
+            for (int c = 0; c < Channels; ++c) {
+                next[r] += covariance[r][c] * vector[c];
+            }
+            length = std::max(length, std::abs(next[r]));
+        }
+        if (length <= 0.0f) {
+            break;
+        }
+        for (int c = 0; c < Channels; ++c) {
+            vector[c] = next[c] / length;
+        }
+    }
+    float length = 0.0f;
+    for (int c = 0; c < Channels; ++c) {
+        length += vector[c] * vector[c];
+    }
+    if (length <= 0.0f) {
+        return;
+    }
+    length = 1.0f / std::sqrt(length);
+    for (int c = 0; c < Channels; ++c) {
+        axis[c] = vector[c] * length;
+    }
+}
+
+/**
+ * @brief 沿主成分方向取投影的两端作为初始端点
+ */
+template <int Channels>
+void ComputeEndpoints(const float (*points)[4], const bool* active, float start[4], float end[4]) {
+    float mean[4];
+    float axis[4];
+    ComputePrincipalAxis<Channels>(points, active, mean, axis);
+    float minimum = std::numeric_limits<float>::max();
+    float maximum = -std::numeric_limits<float>::max();
+    for (int i = 0; i < 16; ++i) {
+        if (!active[i]) {
+            continue;
+        }
+        float t = 0.0f;
+        for (int c = 0; c < Channels; ++c) {
+            t += (points[i][c] - mean[c]) * axis[c];
+        }
+        minimum = std::min(minimum, t);
+        maximum = std::max(maximum, t);
+    }
+    if (minimum > maximum) {
+        minimum = maximum = 0.0f;
+    }
+    for (int c = 0; c < 4; ++c) {
+        start[c] = std::min(std::max(mean[c] + axis[c] * minimum, 0.0f), 255.0f);
+        end[c] = std::min(std::max(mean[c] + axis[c] * maximum, 0.0f), 255.0f);
+    }
+}
+
+/**
+ * @brief 给定每个点的权重（端点0占比），最小二乘求两个端点
+ * @return 方程是否可解
+ */
+template <int Channels>
+bool SolveEndpoints(const float (*points)[4], const bool* active, const float* weights, float endpoint0[4], float endpoint1[4]) {
+    float aa = 0.0f;
+    float ab = 0.0f;
+    float bb = 0.0f;
+    float ax[4] = {};
+    float bx[4] = {};
+    for (int i = 0; i < 16; ++i) {
+        if (!active[i]) {
+            continue;
+        }
+        const float a = weights[i];
+        const float b = 1.0f - a;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (int c = 0; c < Channels; ++c) {
+            ax[c] += a * points[i][c];
+            bx[c] += b * points[i][c];
+        }
+    }
+    const float determinant = aa * bb - ab * ab;
+    if (std::abs(determinant) < 1e-6f) {
+        return false;
+    }
+    const float inverse = 1.0f / determinant;
+    for (int c = 0; c < Channels; ++c) {
+        endpoint0[c] = std::min(std::max((ax[c] * bb - bx[c] * ab) * inverse, 0.0f), 255.0f);
+        endpoint1[c] = std::min(std::max((bx[c] * aa - ax[c] * ab) * inverse, 0.0f), 255.0f);
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// BC1
+// ---------------------------------------------------------------------------
+
+uint16_t PackRgb565(const float color[4]) {
+    const uint32_t r = static_cast<uint32_t>(std::lround(color[0] * 31.0f / 255.0f));
+    const uint32_t g = static_cast<uint32_t>(std::lround(color[1] * 63.0f / 255.0f));
+    const uint32_t b = static_cast<uint32_t>(std::lround(color[2] * 31.0f / 255.0f));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void UnpackRgb565(uint16_t value, int color[3]) {
+    const int r = (value >> 11) & 31;
+    const int g = (value >> 5) & 63;
+    const int b = value & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+/**
+ * @brief BC1调色板（与解码一致），threeColor为三色加透明模式
+ */
+void BuildBC1Palette(uint16_t color0, uint16_t color1, bool threeColor, int palette[4][4]) {
+    UnpackRgb565(color0, palette[0]);
+    UnpackRgb565(color1, palette[1]);
+    for (int c = 0; c < 3; ++c) {
+        if (threeColor) {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        } else {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+    }
+    palette[0][3] = palette[1][3] = palette[2][3] = 255;
+    palette[3][3] = threeColor ? 0 : 255;
+}
+
+/**
+ * @brief 为每个像素选择最近的调色板项，返回平方误差
+ */
+float FitBC1Indices(const float (*points)[4], const bool* active, uint16_t color0, uint16_t color1, bool threeColor,
+                    uint8_t indices[16]) {
+    int palette[4][4];
+    BuildBC1Palette(color0, color1, threeColor, palette);
+    const int candidates = threeColor ? 3 : 4;
+    float total = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        if (!active[i]) {
+            indices[i] = 3;
+            continue;
+        }
+        float best = std::numeric_limits<float>::max();
+        for (int j = 0; j < candidates; ++j) {
+            float error = 0.0f;
+            for (int c = 0; c < 3; ++c) {
+                const float d = points[i][c] - static_cast<float>(palette[j][c]);
+                error += d * d;
+            }
+            if (error < best) {
+                best = error;
+                indices[i] = static_cast<uint8_t>(j);
+            }
+        }
+        total += best;
+    }
+    return total;
+}
+
+/**
+ * @brief 编码BC1颜色块
+ * @param points 像素颜色
+ * @param active 参与颜色拟合的像素（三色模式下透明像素为false）
+ * @param threeColor 是否使用三色加透明模式
+ */
+void EncodeColorBlock(const float (*points)[4], const bool* active, bool threeColor, uint8_t output[8]) {
+    uint16_t color0 = 0;
+    uint16_t color1 = 0;
+    uint8_t indices[16];
+    std::fill(indices, indices + 16, static_cast<uint8_t>(3));
+
+    if (std::any_of(active, active + 16, [](bool value) { return value; })) {
+        float start[4];
+        float end[4];
+        ComputeEndpoints<3>(points, active, start, end);
+        color0 = PackRgb565(end);
+        color1 = PackRgb565(start);
+        float error = FitBC1Indices(points, active, color0, color1, threeColor, indices);
+
+        // 按当前索引做一次最小二乘优化，误差更小时采用
+        static const float fourColorWeights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+        static const float threeColorWeights[4] = { 1.0f, 0.0f, 0.5f, 0.0f };
+        float weights[16];
+        for (int i = 0; i < 16; ++i) {
+            weights[i] = (threeColor ? threeColorWeights : fourColorWeights)[indices[i]];
+        }
+        float endpoint0[4] = {};
+        float endpoint1[4] = {};
+        if (SolveEndpoints<3>(points, active, weights, endpoint0, endpoint1)) {
+            const uint16_t refined0 = PackRgb565(endpoint0);
+            const uint16_t refined1 = PackRgb565(endpoint1);
+            uint8_t refinedIndices[16];
+            const float refinedError = FitBC1Indices(points, active, refined0, refined1, threeColor, refinedIndices);
+            if (refinedError < error) {
+                color0 = refined0;
+                color1 = refined1;
+                std::memcpy(indices, refinedIndices, 16);
+            }
+        }
+
+        // 四色模式要求color0 > color1，三色模式要求color0 <= color1，交换端点并重映射索引
+        if (color0 == color1) {
+            for (int i = 0; i < 16; ++i) {
+                if (active[i]) {
+                    indices[i] = 0;
+                }
+            }
+        } else if ((color0 < color1) != threeColor) {
+            std::swap(color0, color1);
+            for (int i = 0; i < 16; ++i) {
+                if (!threeColor || indices[i] < 2) {
+                    indices[i] ^= 1;
+                }
+            }
+        }
+    }
+
+    uint32_t bits = 0;
+    for (int i = 0; i < 16; ++i) {
+        bits |= static_cast<uint32_t>(indices[i]) << (i * 2);
+    }
+    output[0] = static_cast<uint8_t>(color0);
+    output[1] = static_cast<uint8_t>(color0 >> 8);
+    output[2] = static_cast<uint8_t>(color1);
+    output[3] = static_cast<uint8_t>(color1 >> 8);
+    for (int i = 0; i < 4; ++i) {
+        output[4 + i] = static_cast<uint8_t>(bits >> (i * 8));
+    }
+}
+
+void LoadBlock(const uint8_t rgba[64], float points[16][4]) {
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            points[i][c] = rgba[i * 4 + c];
+        }
+    }
+}
+
+void DecodeColorBlock(const uint8_t* block, bool forceFourColor, uint8_t rgba[64]) {
+    const uint16_t color0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+    const uint16_t color1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+    int palette[4][4];
+    BuildBC1Palette(color0, color1, !forceFourColor && color0 <= color1, palette);
+    for (int i = 0; i < 16; ++i) {
+        const int index = (block[4 + i / 4] >> ((i % 4) * 2)) & 3;
+        for (int c = 0; c < 4; ++c) {
+            rgba[i * 4 + c] = static_cast<uint8_t>(palette[index][c]);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// BC4（BC3的alpha和BC5的两个通道）
+// ---------------------------------------------------------------------------
+
+void BuildBC4Palette(int endpoint0, int endpoint1, int palette[8]) {
+    palette[0] = endpoint0;
+    palette[1] = endpoint1;
+    if (endpoint0 > endpoint1) {
+        for (int i = 2; i < 8; ++i) {
+            palette[i] = ((8 - i) * endpoint0 + (i - 1) * endpoint1) / 7;
+        }
+    } else {
+        for (int i = 2; i < 6; ++i) {
+            palette[i] = ((6 - i) * endpoint0 + (i - 1) * endpoint1) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+void EncodeSingleChannelBlock(const uint8_t* values, uint32_t stride, uint8_t output[8]) {
+    int minimum = 255;
+    int maximum = 0;
+    for (int i = 0; i < 16; ++i) {
+        minimum = std::min(minimum, static_cast<int>(values[i * stride]));
+        maximum = std::max(maximum, static_cast<int>(values[i * stride]));
+    }
+    // 八值模式：endpoint0 > endpoint1；相等时所有索引为0
+    int palette[8];
+    BuildBC4Palette(maximum, minimum, palette);
+    uint64_t bits = 0;
+    for (int i = 0; i < 16; ++i) {
+        const int value = values[i * stride];
+        int best = 0;
+        int bestError = std::abs(value - palette[0]);
+        for (int j = 1; j < 8 && maximum > minimum; ++j) {
+            const int error = std::abs(value - palette[j]);
+            if (error < bestError) {
+                bestError = error;
+                best = j;
+            }
+        }
+        bits |= static_cast<uint64_t>(best) << (i * 3);
+    }
+    output[0] = static_cast<uint8_t>(maximum);
+    output[1] = static_cast<uint8_t>(minimum);
+    for (int i = 0; i < 6; ++i) {
+        output[2 + i] = static_cast<uint8_t>(bits >> (i * 8));
+    }
+}
+
+void DecodeSingleChannelBlock(const uint8_t* block, uint8_t* values, uint32_t stride) {
+    int palette[8];
+    BuildBC4Palette(block[0], block[1], palette);
+    uint64_t bits = 0;
+    for (int i = 0; i < 6; ++i) {
+        bits |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+    }
+    for (int i = 0; i < 16; ++i) {
+        values[i * stride] = static_cast<uint8_t>(palette[(bits >> (i * 3)) & 7]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// BC7模式6
+// ---------------------------------------------------------------------------
+
+const int BC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+/**
+ * @brief 模式6的一种端点量化（7位加共享p位）及对应的索引
+ */
+struct BC7Candidate {
+    int endpoints[2][4];    // 7位分量
+    int pbits[2];
+    uint8_t indices[16];
+    float error = std::numeric_limits<float>::max();
+};
+
+void ExpandBC7Endpoint(const int endpoint[4], int pbit, int color[4]) {
+    for (int c = 0; c < 4; ++c) {
+        color[c] = (endpoint[c] << 1) | pbit;
+    }
+}
+
+float FitBC7Indices(const float (*points)[4], const int color0[4], const int color1[4], uint8_t indices[16]) {
+    int palette[16][4];
+    for (int j = 0; j < 16; ++j) {
+        for (int c = 0; c < 4; ++c) {
+            palette[j][c] = ((64 - BC7Weights[j]) * color0[c] + BC7Weights[j] * color1[c] + 32) >> 6;
+        }
+    }
+    // 投影到端点连线上估计索引，只比较相邻的三个调色板项
+    float direction[4];
+    float lengthSquared = 0.0f;
+    for (int c = 0; c < 4; ++c) {
+        direction[c] = static_cast<float>(color1[c] - color0[c]);
+        lengthSquared += direction[c] * direction[c];
+    }
+    const float scale = lengthSquared > 0.0f ? 64.0f / lengthSquared : 0.0f;
+    float total = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float t = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+            t += (points[i][c] - color0[c]) * direction[c];
+        }
+        const float weight = t * scale;
+        int estimate = 0;
+        while (estimate < 15 && BC7Weights[estimate + 1] <= weight) {
+            ++estimate;
+        }
+        float best = std::numeric_limits<float>::max();
+        for (int j = std::max(estimate - 1, 0); j <= std::min(estimate + 1, 15); ++j) {
+            float error = 0.0f;
+            for (int c = 0; c < 4; ++c) {
+                const float d = points[i][c] - static_cast<float>(palette[j][c]);
+                error += d * d;
+            }
+            if (error < best) {
+                best = error;
+                indices[i] = static_cast<uint8_t>(j);
+            }
+        }
+        total += best;
+    }
+    return total;
+}
+
+/**
+ * @brief 尝试四种p位组合量化端点，保留误差最小的
+ */
+void QuantizeBC7Endpoints(const float (*points)[4], const float endpoint0[4], const float endpoint1[4], BC7Candidate& best) {
+    for (int p = 0; p < 4; ++p) {
+        BC7Candidate candidate;
+        candidate.pbits[0] = p & 1;
+        candidate.pbits[1] = p >> 1;
+        const float* source[2] = { endpoint0, endpoint1 };
+        int colors[2][4];
+        for (int e = 0; e < 2; ++e) {
+            for (int c = 0; c < 4; ++c) {
+                const long value = std::lround((source[e][c] - candidate.pbits[e]) * 0.5f);
+                candidate.endpoints[e][c] = static_cast<int>(std::min(std::max(value, 0l), 127l));
+            }
+            ExpandBC7Endpoint(candidate.endpoints[e], candidate.pbits[e], colors[e]);
+        }
+        candidate.error = FitBC7Indices(points, colors[0], colors[1], candidate.indices);
+        if (candidate.error < best.error) {
+            best = candidate;
+        }
+    }
+}
+
+/**
+ * @brief 128位小端位流写入
+ */
+class BlockBitWriter {
+public:
+    explicit BlockBitWriter(uint8_t* output) : m_Output(output) { std::memset(output, 0, 16); }
+
+    void Write(uint32_t value, uint32_t count) {
+        for (uint32_t i = 0; i < count; ++i, ++m_Position) {
+            if ((value >> i) & 1) {
+                m_Output[m_Position / 8] = static_cast<uint8_t>(m_Output[m_Position / 8] | (1u << (m_Position % 8)));
+            }
+        }
+    }
+
+private:
+    uint8_t* m_Output;
+    uint32_t m_Position = 0;
+};
+
+class BlockBitReader {
+public:
+    explicit BlockBitReader(const uint8_t* data) : m_Data(data) {}
+
+    uint32_t Read(uint32_t count) {
+        uint32_t value = 0;
+        for (uint32_t i = 0; i < count; ++i, ++m_Position) {
+            value |= static_cast<uint32_t>((m_Data[m_Position / 8] >> (m_Position % 8)) & 1) << i;
+        }
+        return value;
+    }
+
+private:
+    const uint8_t* m_Data;
+    uint32_t m_Position = 0;
+};
+
+} // namespace
+
+size_t BlockCompression::GetBlockSize(TextureFormat format) {
+    switch (format) {
+    case TextureFormat::BC1:
+        return 8;
+    case TextureFormat::BC3:
+    case TextureFormat::BC5:
+    case TextureFormat::BC7:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+void BlockCompression::CompressBC1(const uint8_t rgba[64], uint8_t output[8]) {
+    float points[16][4];
+    LoadBlock(rgba, points);
+    bool active[16];
+    bool transparent = false;
+    for (int i = 0; i < 16; ++i) {
+        active[i] = rgba[i * 4 + 3] >= 128;
+        transparent = transparent || !active[i];
+    }
+    EncodeColorBlock(points, active, transparent, output);
+}
+
+void BlockCompression::CompressBC3(const uint8_t rgba[64], uint8_t output[16]) {
+    EncodeSingleChannelBlock(rgba + 3, 4, output);
+    float points[16][4];
+    LoadBlock(rgba, points);
+    bool active[16];
+    std::fill(active, active + 16, true);
+    EncodeColorBlock(points, active, false, output + 8);
+}
+
+void BlockCompression::CompressBC5(const uint8_t rgba[64], uint8_t output[16]) {
+    EncodeSingleChannelBlock(rgba, 4, output);
+    EncodeSingleChannelBlock(rgba + 1, 4, output + 8);
+}
+
+void BlockCompression::CompressBC7(const uint8_t rgba[64], uint8_t output[16]) {
+    float points[16][4];
+    LoadBlock(rgba, points);
+    bool active[16];
+    std::fill(active, active + 16, true);
+
+    float start[4];
+    float end[4];
+    ComputeEndpoints<4>(points, active, start, end);
+    BC7Candidate best;
+    QuantizeBC7Endpoints(points, start, end, best);
+
+    // 按当前索引做一次最小二乘优化
+    float weights[16];
+    for (int i = 0; i < 16; ++i) {
+        weights[i] = 1.0f - BC7Weights[best.indices[i]] / 64.0f;
+    }
+    float endpoint0[4];
+    float endpoint1[4];
+    if (best.error > 0.0f && SolveEndpoints<4>(points, active, weights, endpoint0, endpoint1)) {
+        QuantizeBC7Endpoints(points, endpoint0, endpoint1, best);
+    }
+
+    // 第一个像素的索引最高位隐含为0，否则交换端点并翻转索引
+    if (best.indices[0] & 8) {
+        for (int c = 0; c < 4; ++c) {
+            std::swap(best.endpoints[0][c], best.endpoints[1][c]);
+        }
+        std::swap(best.pbits[0], best.pbits[1]);
+        for (int i = 0; i < 16; ++i) {
+            best.indices[i] = static_cast<uint8_t>(15 - best.indices[i]);
+        }
+    }
+
+    BlockBitWriter writer(output);
+    writer.Write(1u << 6, 7);
+    for (int c = 0; c < 4; ++c) {
+        writer.Write(static_cast<uint32_t>(best.endpoints[0][c]), 7);
+        writer.Write(static_cast<uint32_t>(best.endpoints[1][c]), 7);
+    }
+    writer.Write(static_cast<uint32_t>(best.pbits[0]), 1);
+    writer.Write(static_cast<uint32_t>(best.pbits[1]), 1);
+    writer.Write(best.indices[0], 3);
+    for (int i = 1; i < 16; ++i) {
+        writer.Write(best.indices[i], 4);
+    }
+}
+
+bool BlockCompression::CompressImage(TextureFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* output) {
+    const size_t blockSize = GetBlockSize(format);
+    if (blockSize == 0) {
+        return false;
+    }
+    const uint32_t blocksX = (width + 3) / 4;
+    const uint32_t blocksY = (height + 3) / 4;
+    JobSystem::GetInstance().ParallelFor(blocksY, 1, [&](uint32_t begin, uint32_t end) {
+        uint8_t block[64];
+        for (uint32_t by = begin; by < end; ++by) {
+            for (uint32_t bx = 0; bx < blocksX; ++bx) {
+                // 边缘不足4x4的块复制最后一行/列
+                for (uint32_t y = 0; y < 4; ++y) {
+                    const uint32_t sy = std::min(by * 4 + y, height - 1);
+                    for (uint32_t x = 0; x < 4; ++x) {
+                        const uint32_t sx = std::min(bx * 4 + x, width - 1);
+                        std::memcpy(block + (y * 4 + x) * 4, rgba + (static_cast<size_t>(sy) * width + sx) * 4, 4);
+                    }
+                }
+                uint8_t* destination = output + (static_cast<size_t>(by) * blocksX + bx) * blockSize;
+                switch (format) {
+                case TextureFormat::BC1:
+                    CompressBC1(block, destination);
+                    break;
+                case TextureFormat::BC3:
+                    CompressBC3(block, destination);
+                    break;
+                case TextureFormat::BC5:
+                    CompressBC5(block, destination);
+                    break;
+                default:
+                    CompressBC7(block, destination);
+                    break;
+                }
+            }
+        }
+    });
+    return true;
+}
+
+bool BlockCompression::DecompressBlock(TextureFormat format, const uint8_t* block, uint8_t rgba[64]) {
+    switch (format) {
+    case TextureFormat::BC1:
+        DecodeColorBlock(block, false, rgba);
+        return true;
+    case TextureFormat::BC3:
+        DecodeColorBlock(block + 8, true, rgba);
+        DecodeSingleChannelBlock(block, rgba + 3, 4);
+        return true;
+    case TextureFormat::BC5:
+        DecodeSingleChannelBlock(block, rgba, 4);
+        DecodeSingleChannelBlock(block + 8, rgba + 1, 4);
+        for (int i = 0; i < 16; ++i) {
+            rgba[i * 4 + 2] = 0;
+            rgba[i * 4 + 3] = 255;
+        }
+        return true;
+    case TextureFormat::BC7: {
+        BlockBitReader reader(block);
+        if (reader.Read(7) != (1u << 6)) {
+            return false;
+        }
+        int endpoints[2][4];
+        for (int c = 0; c < 4; ++c) {
+            endpoints[0][c] = static_cast<int>(reader.Read(7));
+            endpoints[1][c] = static_cast<int>(reader.Read(7));
+        }
+        int colors[2][4];
+        ExpandBC7Endpoint(endpoints[0], static_cast<int>(reader.Read(1)), colors[0]);
+        ExpandBC7Endpoint(endpoints[1], static_cast<int>(reader.Read(1)), colors[1]);
+        for (int i = 0; i < 16; ++i) {
+            const int weight = BC7Weights[reader.Read(i == 0 ? 3 : 4)];
+            for (int c = 0; c < 4; ++c) {
+                rgba[i * 4 + c] = static_cast<uint8_t>(((64 - weight) * colors[0][c] + weight * colors[1][c] + 32) >> 6);
+            }
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+bool BlockCompression::DecompressImage(TextureFormat format, const uint8_t* data, uint32_t width, uint32_t height, uint8_t* rgba) {
+    const size_t blockSize = GetBlockSize(format);
+    if (blockSize == 0) {
+        return false;
+    }
+    const uint32_t blocksX = (width + 3) / 4;
+    const uint32_t blocksY = (height + 3) / 4;
+    uint8_t block[64];
+    for (uint32_t by = 0; by < blocksY; ++by) {
+        for (uint32_t bx = 0; bx < blocksX; ++bx) {
+            if (!DecompressBlock(format, data + (static_cast<size_t>(by) * blocksX + bx) * blockSize, block)) {
+                return false;
+            }
+            for (uint32_t y = 0; y < 4 && by * 4 + y < height; ++y) {
+                for (uint32_t x = 0; x < 4 && bx * 4 + x < width; ++x) {
+                    std::memcpy(rgba + ((static_cast<size_t>(by) * 4 + y) * width + bx * 4 + x) * 4, block + (y * 4 + x) * 4, 4);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool BlockCompression::DecompressTexture(const TextureData& data, TextureData& output) {
+    output = TextureData();
+    output.width = data.width;
+    output.height = data.height;
+    size_t totalSize = 0;
+    for (const TextureMipLevel& mip : data.mips) {
+        TextureMipLevel level = mip;
+        level.offset = totalSize;
+        level.size = TextureData::GetLevelSize(TextureFormat::RGBA8, mip.width, mip.height);
+        totalSize += level.size;
+        output.mips.push_back(level);
+    }
+    output.pixels.resize(totalSize);
+    for (size_t i = 0; i < data.mips.size(); ++i) {
+        const TextureMipLevel& mip = data.mips[i];
+        if (!DecompressImage(data.format, data.pixels.data() + mip.offset, mip.width, mip.height,
+                             output.pixels.data() + output.mips[i].offset)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace PLE
@@ -0,0 +1,80 @@
+/**
+ * @file BlockCompression.h
+ * @brief BC1/BC3/BC5/BC7块压缩编码和解码
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace PLE {
+
+enum class TextureFormat;
+struct TextureData;
+
+/**
+ * @brief 块压缩
+ *
+ * 每个块为4x4像素的RGBA8（64字节，行从上到下）。编码器面向导入时使用，在质量和速度之间取折中：
+ * - BC1：主成分方向求端点，再做一次最小二乘优化；含透明像素（alpha < 128）时使用三色加透明模式；
+ * - BC3：alpha按BC4编码，颜色按BC1四色模式编码；
+ * - BC5：R和G两个通道分别按BC4编码（法线贴图）；
+ * - BC7：只使用模式6（单子集、RGBA各7位加p位、4位索引），对平滑的颜色和alpha质量很好，
+ *   边缘分明的多色块不如多子集模式。
+ */
+class BlockCompression {
+public:
+    /**
+     * @brief 每个块的字节数，非压缩格式返回0
+     */
+    static size_t GetBlockSize(TextureFormat format);
+
+    static void CompressBC1(const uint8_t rgba[64], uint8_t output[8]);
+    static void CompressBC3(const uint8_t rgba[64], uint8_t output[16]);
+    static void CompressBC5(const uint8_t rgba[64], uint8_t output[16]);
+    static void CompressBC7(const uint8_t rgba[64], uint8_t output[16]);
+
+    /**
+     * @brief 压缩整张图像，按块行分配到JobSystem的工作线程
+     * @param format 压缩格式
+     * @param rgba RGBA8像素
+     * @param width 宽度
+     * @param height 高度
+     * @param output 输出，大小为TextureData::GetLevelSize(format, width, height)
+     * @return 格式是否为块压缩格式
+     */
+    static bool CompressImage(TextureFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* output);
+
+    /**
+     * @brief 解码一个块
+     *
+     * BC7只支持模式6（即本编码器的输出），其他模式返回false。
+     * @param format 压缩格式
+     * @param block 块数据
+     * @param rgba 输出4x4像素
+     * @return 是否成功
+     */
+    static bool DecompressBlock(TextureFormat format, const uint8_t* block, uint8_t rgba[64]);
+
+    /**
+     * @brief 解码整张图像，用于后端不支持该压缩格式时回退到RGBA8
+     * @param format 压缩格式
+     * @param data 压缩数据
+     * @param width 宽度
+     * @param height 高度
+     * @param rgba 输出，大小为width * height * 4
+     * @return 是否成功
+     */
+    static bool DecompressImage(TextureFormat format, const uint8_t* data, uint32_t width, uint32_t height, uint8_t* rgba);
+
+    /**
+     * @brief 把整条Mip链解码为RGBA8
+     * @param data 块压缩的纹理数据
+     * @param output 输出RGBA8纹理数据
+     * @return 是否成功
+     */
+    static bool DecompressTexture(const TextureData& data, TextureData& output);
+};
+
+} // namespace PLE
@@ -0,0 +1,234 @@
+/**
+ * @file CascadedShadowMap.cpp
+ * @brief 方向光级联阴影贴图实现
+ */
+
+#include "Renderer/CascadedShadowMap.h"
+#include "Renderer/RenderResources.h"
+#include "Renderer/RenderSystem.h"
+#include "Scene/Camera.h"
+#include "Scene/Light.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace PLE {
+
+namespace {
+
+constexpr uint64_t FnvOffsetBasis = 14695981039346656037ull;
+constexpr uint64_t FnvPrime = 1099511628211ull;
+
+void HashBytes(uint64_t& hash, const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FnvPrime;
+    }
+}
+
+/**
+ * @brief 按行向量约定变换点：(p, 1) * M
+ */
+Vector3 TransformPoint(const Vector3& p, const Matrix4& matrix) {
+    const auto& m = matrix.m;
+    return Vector3(p.x * m[0] + p.y * m[4] + p.z * m[8] + m[12],
+                   p.x * m[1] + p.y * m[5] + p.z * m[9] + m[13],
+                   p.x * m[2] + p.y * m[6] + p.z * m[10] + m[14]);
+}
+
+} // namespace
+
+CascadedShadowMap::CascadedShadowMap(const CascadedShadowConfig& config)
+    : m_Config(config) {
+    m_Config.cascadeCount = std::min(std::max(m_Config.cascadeCount, 1u), MaxCascades);
+    m_Config.resolution = std::max(m_Config.resolution, 1);
+    m_Cascades.resize(m_Config.cascadeCount);
+    m_CascadeHashes.assign(m_Config.cascadeCount, 0);
+    m_RenderedHashes.assign(m_Config.cascadeCount, 0);
+    m_Targets.resize(m_Config.cascadeCount);
+}
+
+CascadedShadowMap::~CascadedShadowMap() = default;
+
+void CascadedShadowMap::Update(const Camera& camera, const Light& light, const std::vector<ShadowCaster>& casters) {
+    Update(camera.GetViewMatrix(), camera.GetFieldOfView(), camera.GetAspectRatio(), camera.GetNearClip(),
+           camera.GetFarClip(), light.GetDirection(), casters.data(), static_cast<uint32_t>(casters.size()));
+}
+
+void CascadedShadowMap::Update(const Matrix4& cameraView, float fovY, float aspectRatio, float nearZ, float farZ,
+                               const Vector3& lightDirection, const ShadowCaster* casters, uint32_t count) {
+    m_Stats = CascadedShadowStats();
+    m_Stats.casters = count;
+    m_Casters.assign(casters, casters + count);
+
+    // 相机的世界位置和观察方向：视图矩阵的旋转部分是世界矩阵旋转的转置
+    Matrix4 cameraWorld = cameraView.Inverse();
+    Vector3 cameraPosition(cameraWorld(3, 0), cameraWorld(3, 1), cameraWorld(3, 2));
+    Vector3 cameraForward = Vector3(-cameraView(0, 2), -cameraView(1, 2), -cameraView(2, 2)).Normalized();
+
+    // 光源视图只有旋转，级联之间、帧与帧之间的纹素网格保持一致
+    Vector3 direction = lightDirection.Normalized();
+    Vector3 up = std::fabs(direction.y) > 0.99f ? Vector3(0.0f, 0.0f, 1.0f) : Vector3(0.0f, 1.0f, 0.0f);
+    Matrix4 lightView = Matrix4::LookAt(Vector3::Zero(), direction, up);
+
+    // 投射体包围盒变换到光源空间，所有级联共用
+    m_CasterBounds.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const ShadowCaster& caster = m_Casters[i];
+        CasterBounds& bounds = m_CasterBounds[i];
+        for (int axis = 0; axis < 3; ++axis) {
+            bounds.min[axis] = std::numeric_limits<float>::max();
+            bounds.max[axis] = std::numeric_limits<float>::lowest();
+        }
+        for (int corner = 0; corner < 8; ++corner) {
+            Vector3 point((corner & 1) ? caster.boundsMax.x : caster.boundsMin.x,
+                          (corner & 2) ? caster.boundsMax.y : caster.boundsMin.y,
+                          (corner & 4) ? caster.boundsMax.z : caster.boundsMin.z);
+            Vector3 light = TransformPoint(point, lightView);
+            const float values[3] = { light.x, light.y, light.z };
+            for (int axis = 0; axis < 3; ++axis) {
+                bounds.min[axis] = std::min(bounds.min[axis], values[axis]);
+                bounds.max[axis] = std::max(bounds.max[axis], values[axis]);
+            }
+        }
+    }
+
+    // 实用分割方案：对数分割和均匀分割按lambda混合
+    const uint32_t cascadeCount = m_Config.cascadeCount;
+    const float shadowFar = std::max(std::min(farZ, m_Config.shadowDistance), nearZ * 1.001f);
+    const float tanHalfFovY = std::tan(fovY * 0.5f);
+    const float diagonal = tanHalfFovY * std::sqrt(1.0f + aspectRatio * aspectRatio);
+    float splitNear = nearZ;
+
+    for (uint32_t c = 0; c < cascadeCount; ++c) {
+        ShadowCascade& cascade = m_Cascades[c];
+        float t = static_cast<float>(c + 1) / cascadeCount;
+        float logSplit = nearZ * std::pow(shadowFar / nearZ, t);
+        float uniformSplit = nearZ + (shadowFar - nearZ) * t;
+        float splitFar = m_Config.splitLambda * logSplit + (1.0f - m_Config.splitLambda) * uniformSplit;
+        cascade.splitNear = splitNear;
+        cascade.splitFar = splitFar;
+        splitNear = splitFar;
+
+        // 视锥体切片的最小包围球，球心在观察轴上，半径只取决于视场角和分割距离
+        float centerDistance = std::min((cascade.splitNear + cascade.splitFar) * 0.5f * (1.0f + diagonal * diagonal),
+                                        cascade.splitFar);
+        float farOffset = cascade.splitFar - centerDistance;
+        float radius = std::sqrt(farOffset * farOffset + cascade.splitFar * diagonal * cascade.splitFar * diagonal);
+        radius = std::ceil(radius * 16.0f) / 16.0f;
+
+        // 球心对齐到纹素网格
+        float texelSize = 2.0f * radius / static_cast<float>(m_Config.resolution);
+        Vector3 center = TransformPoint(cameraPosition + cameraForward * centerDistance, lightView);
+        float centerX = std::floor(center.x / texelSize) * texelSize;
+        float centerY = std::floor(center.y / texelSize) * texelSize;
+
+        // 光源空间中沿-Z照射，深度 = -z；接收范围为包围球，近平面向光源方向推到投射体为止
+        float nearDepth = -center.z - radius;
+        float farDepth = -center.z + radius;
+        cascade.casters.clear();
+        for (uint32_t i = 0; i < count; ++i) {
+            const CasterBounds& bounds = m_CasterBounds[i];
+            if (bounds.max[0] < centerX - radius || bounds.min[0] > centerX + radius ||
+                bounds.max[1] < centerY - radius || bounds.min[1] > centerY + radius ||
+                -bounds.max[2] > farDepth) {
+                continue;
+            }
+            nearDepth = std::min(nearDepth, -bounds.max[2]);
+            cascade.casters.push_back(i);
+        }
+
+        float depthStep = radius * 0.125f;
+        nearDepth = std::floor(nearDepth / depthStep) * depthStep;
+        farDepth = std::ceil(farDepth / depthStep) * depthStep;
+
+        // 与Camera的正交投影相同的行向量和[0, 1]深度约定，再平移到级联中心
+        Matrix4 projection = Matrix4::Identity();
+        projection(0, 0) = 1.0f / radius;
+        projection(1, 1) = 1.0f / radius;
+        projection(2, 2) = 1.0f / (nearDepth - farDepth);
+        projection(3, 0) = -centerX / radius;
+        projection(3, 1) = -centerY / radius;
+        projection(3, 2) = nearDepth / (nearDepth - farDepth);
+
+        cascade.view = lightView;
+        cascade.projection = projection;
+        cascade.viewProjection = lightView * projection;
+        cascade.texelSize = texelSize;
+
+        m_CascadeHashes[c] = ComputeCascadeHash(cascade);
+        cascade.needsRender = !m_Config.cacheCascades || !m_Targets[c] || m_CascadeHashes[c] != m_RenderedHashes[c];
+        if (cascade.needsRender) {
+            ++m_Stats.renderedCascades;
+            m_Stats.casterDraws += static_cast<uint32_t>(cascade.casters.size());
+        } else {
+            ++m_Stats.cachedCascades;
+        }
+    }
+}
+
+uint64_t CascadedShadowMap::ComputeCascadeHash(const ShadowCascade& cascade) const {
+    uint64_t hash = FnvOffsetBasis;
+    HashBytes(hash, cascade.viewProjection.m.data(), sizeof(float) * 16);
+    for (uint32_t index : cascade.casters) {
+        const ShadowCaster& caster = m_Casters[index];
+        HashBytes(hash, &caster.id, sizeof(caster.id));
+        HashBytes(hash, caster.transform.m.data(), sizeof(float) * 16);
+    }
+    return hash;
+}
+
+bool CascadedShadowMap::Render(RenderSystem& renderSystem, std::shared_ptr<Material> casterMaterial) {
+    bool rendered = false;
+    for (uint32_t c = 0; c < m_Config.cascadeCount; ++c) {
+        ShadowCascade& cascade = m_Cascades[c];
+        if (!cascade.needsRender) {
+            continue;
+        }
+        if (!m_Targets[c]) {
+            m_Targets[c] = renderSystem.CreateRenderTarget(m_Config.resolution, m_Config.resolution);
+            if (!m_Targets[c]) {
+                std::cerr << "创建级联阴影贴图失败" << std::endl;
+                renderSystem.SetRenderTarget(nullptr);
+                return false;
+            }
+        }
+
+        renderSystem.SetRenderTarget(m_Targets[c]);
+        renderSystem.SetViewport(0, 0, m_Config.resolution, m_Config.resolution);
+        renderSystem.Clear(Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+        renderSystem.SetViewProjection(cascade.view, cascade.projection);
+        for (uint32_t index : cascade.casters) {
+            const ShadowCaster& caster = m_Casters[index];
+            std::shared_ptr<Material> material = caster.material ? caster.material : casterMaterial;
+            if (caster.mesh && material) {
+                renderSystem.DrawMesh(caster.mesh, material, caster.transform);
+            }
+        }
+
+        m_RenderedHashes[c] = m_CascadeHashes[c];
+        cascade.needsRender = false;
+        rendered = true;
+    }
+
+    if (rendered) {
+        renderSystem.SetRenderTarget(nullptr);
+    }
+    return true;
+}
+
+void CascadedShadowMap::Invalidate() {
+    std::fill(m_RenderedHashes.begin(), m_RenderedHashes.end(), 0);
+    for (ShadowCascade& cascade : m_Cascades) {
+        cascade.needsRender = true;
+    }
+}
+
+std::shared_ptr<RenderTarget> CascadedShadowMap::GetShadowTarget(uint32_t index) const {
+    return index < m_Targets.size() ? m_Targets[index] : nullptr;
+}
+
+} // namespace PLE
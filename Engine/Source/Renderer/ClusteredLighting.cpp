@@ -0,0 +1,341 @@
+/**
+ * @file ClusteredLighting.cpp
+ * @brief 分簇前向渲染的CPU光源剔除实现
+ */
+
+#include "Renderer/ClusteredLighting.h"
+#include "Scene/Camera.h"
+#include "Scene/Light.h"
+#include "Core/JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#ifdef PLE_SIMD_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace PLE {
+
+namespace {
+
+// 补齐到4的倍数的簇使用的空包围盒，与任何球的距离都是无穷大
+constexpr float EmptyBoundsExtent = 1.0e30f;
+
+/**
+ * @brief 按行向量约定变换点：(p, 1) * M
+ */
+void TransformPoint(const float p[3], const Matrix4& matrix, float out[3]) {
+    const auto& m = matrix.m;
+    out[0] = p[0] * m[0] + p[1] * m[4] + p[2] * m[8] + m[12];
+    out[1] = p[0] * m[1] + p[1] * m[5] + p[2] * m[9] + m[13];
+    out[2] = p[0] * m[2] + p[1] * m[6] + p[2] * m[10] + m[14];
+}
+
+/**
+ * @brief 计算光源影响范围的世界空间包围球
+ *
+ * 聚光灯取锥体（顶点在光源处、母线长为range）的最小包围球：
+ * 半角大于45度时球心在底面圆心，否则顶点和底面圆周都在球面上。
+ */
+void ComputeBoundingSphere(const ClusterLightData& light, float center[3], float& radius) {
+    center[0] = light.position[0];
+    center[1] = light.position[1];
+    center[2] = light.position[2];
+    radius = light.range;
+
+    if (light.type != static_cast<uint32_t>(LightType::Spot) || light.spotScale <= 0.0f) {
+        return;
+    }
+
+    float cosAngle = std::min(std::max(-light.spotOffset / light.spotScale, 0.0f), 1.0f);
+    float distance;
+    if (cosAngle < 0.70710678f) {
+        distance = light.range * cosAngle;
+        radius = light.range * std::sqrt(1.0f - cosAngle * cosAngle);
+    } else {
+        distance = light.range / (2.0f * cosAngle);
+        radius = distance;
+    }
+    center[0] += light.direction[0] * distance;
+    center[1] += light.direction[1] * distance;
+    center[2] += light.direction[2] * distance;
+}
+
+} // namespace
+
+ClusteredLightCuller::ClusteredLightCuller(const ClusteredLightingConfig& config)
+    : m_Config(config) {
+    m_Config.clustersX = std::max(m_Config.clustersX, 1u);
+    m_Config.clustersY = std::max(m_Config.clustersY, 1u);
+    m_Config.clustersZ = std::max(m_Config.clustersZ, 1u);
+    m_TilesPerSlice = m_Config.clustersX * m_Config.clustersY;
+    m_PaddedTiles = (m_TilesPerSlice + 3) & ~3u;
+    m_Slices.resize(m_Config.clustersZ);
+    for (Slice& slice : m_Slices) {
+        slice.minX.assign(m_PaddedTiles, EmptyBoundsExtent);
+        slice.maxX.assign(m_PaddedTiles, -EmptyBoundsExtent);
+        slice.minY.assign(m_PaddedTiles, EmptyBoundsExtent);
+        slice.maxY.assign(m_PaddedTiles, -EmptyBoundsExtent);
+        slice.ranges.resize(m_TilesPerSlice);
+    }
+    m_BoundsProjection = Matrix4::Zero();
+}
+
+ClusteredLightCuller::~ClusteredLightCuller() = default;
+
+ClusterLightData ClusteredLightCuller::PackLight(const Light& light) {
+    ClusterLightData data = {};
+    Vector3 position = light.GetPosition();
+    Vector3 direction = light.GetDirection();
+    const Vector3& color = light.GetColor();
+    data.position[0] = position.x;
+    data.position[1] = position.y;
+    data.position[2] = position.z;
+    data.range = light.GetRange();
+    data.color[0] = color.x;
+    data.color[1] = color.y;
+    data.color[2] = color.z;
+    data.intensity = light.GetIntensity();
+    data.direction[0] = direction.x;
+    data.direction[1] = direction.y;
+    data.direction[2] = direction.z;
+    data.type = static_cast<uint32_t>(light.GetType());
+
+    if (light.GetType() == LightType::Spot) {
+        float cosOuter = std::cos(light.GetOuterSpotAngle());
+        float cosInner = std::cos(light.GetInnerSpotAngle());
+        data.spotScale = 1.0f / std::max(cosInner - cosOuter, 1.0e-4f);
+        data.spotOffset = -cosOuter * data.spotScale;
+    } else {
+        data.spotScale = 0.0f;
+        data.spotOffset = 1.0f;
+    }
+    return data;
+}
+
+void ClusteredLightCuller::Build(const Camera& camera, const std::vector<std::shared_ptr<Light>>& lights) {
+    std::vector<ClusterLightData> packed;
+    packed.reserve(lights.size());
+    for (const auto& light : lights) {
+        if (light && light->IsEnabled()) {
+            packed.push_back(PackLight(*light));
+        }
+    }
+    Build(camera.GetViewMatrix(), camera.GetProjectionMatrix(), camera.GetNearClip(), camera.GetFarClip(),
+          packed.data(), static_cast<uint32_t>(packed.size()));
+}
+
+uint32_t ClusteredLightCuller::GetSliceForDepth(float viewDepth) const {
+    if (viewDepth <= m_BoundsNear) {
+        return 0;
+    }
+    float slice = std::log(viewDepth) * m_SliceScale + m_SliceBias;
+    if (slice >= static_cast<float>(m_Config.clustersZ)) {
+        return m_Config.clustersZ;
+    }
+    return static_cast<uint32_t>(std::max(slice, 0.0f));
+}
+
+void ClusteredLightCuller::UpdateClusterBounds(const Matrix4& projection, float nearZ, float farZ) {
+    if (projection == m_BoundsProjection && nearZ == m_BoundsNear && farZ == m_BoundsFar) {
+        return;
+    }
+    m_BoundsProjection = projection;
+    m_BoundsNear = nearZ;
+    m_BoundsFar = farZ;
+
+    const uint32_t countX = m_Config.clustersX;
+    const uint32_t countY = m_Config.clustersY;
+    const uint32_t countZ = m_Config.clustersZ;
+    float logRatio = std::log(farZ / nearZ);
+    m_SliceScale = static_cast<float>(countZ) / logRatio;
+    m_SliceBias = -static_cast<float>(countZ) * std::log(nearZ) / logRatio;
+
+    // 透视投影的w = -z_view，NDC坐标乘以深度还原视图空间坐标；正交投影与深度无关
+    const bool perspective = projection(2, 3) != 0.0f;
+    const float scaleX = projection(0, 0);
+    const float scaleY = projection(1, 1);
+    const float offsetX = perspective ? projection(2, 0) : -projection(3, 0);
+    const float offsetY = perspective ? projection(2, 1) : -projection(3, 1);
+    auto toView = [perspective](float ndc, float offset, float scale, float depth) {
+        return (ndc + offset) / scale * (perspective ? depth : 1.0f);
+    };
+
+    for (uint32_t z = 0; z < countZ; ++z) {
+        Slice& slice = m_Slices[z];
+        slice.nearDepth = nearZ * std::pow(farZ / nearZ, static_cast<float>(z) / countZ);
+        slice.farDepth = nearZ * std::pow(farZ / nearZ, static_cast<float>(z + 1) / countZ);
+
+        for (uint32_t y = 0; y < countY; ++y) {
+            float ndcY0 = -1.0f + 2.0f * y / countY;
+            float ndcY1 = -1.0f + 2.0f * (y + 1) / countY;
+            float cornersY[4] = {
+                toView(ndcY0, offsetY, scaleY, slice.nearDepth), toView(ndcY0, offsetY, scaleY, slice.farDepth),
+                toView(ndcY1, offsetY, scaleY, slice.nearDepth), toView(ndcY1, offsetY, scaleY, slice.farDepth)
+            };
+            float minY = std::min(std::min(cornersY[0], cornersY[1]), std::min(cornersY[2], cornersY[3]));
+            float maxY = std::max(std::max(cornersY[0], cornersY[1]), std::max(cornersY[2], cornersY[3]));
+
+            for (uint32_t x = 0; x < countX; ++x) {
+                float ndcX0 = -1.0f + 2.0f * x / countX;
+                float ndcX1 = -1.0f + 2.0f * (x + 1) / countX;
+                float cornersX[4] = {
+                    toView(ndcX0, offsetX, scaleX, slice.nearDepth), toView(ndcX0, offsetX, scaleX, slice.farDepth),
+                    toView(ndcX1, offsetX, scaleX, slice.nearDepth), toView(ndcX1, offsetX, scaleX, slice.farDepth)
+                };
+                uint32_t tile = y * countX + x;
+                slice.minX[tile] = std::min(std::min(cornersX[0], cornersX[1]), std::min(cornersX[2], cornersX[3]));
+                slice.maxX[tile] = std::max(std::max(cornersX[0], cornersX[1]), std::max(cornersX[2], cornersX[3]));
+                slice.minY[tile] = minY;
+                slice.maxY[tile] = maxY;
+            }
+        }
+    }
+}
+
+void ClusteredLightCuller::Build(const Matrix4& view, const Matrix4& projection, float nearZ, float farZ,
+                                 const ClusterLightData* lights, uint32_t count) {
+    m_Stats = ClusteredLightingStats();
+    m_Stats.lights = count;
+    m_Lights.assign(lights, lights + count);
+    m_Spheres.clear();
+    m_DirectionalIndices.clear();
+    m_LightIndices.clear();
+    m_Clusters.assign(GetClusterCount(), LightClusterRange{ 0, 0 });
+
+    if (nearZ <= 0.0f || farZ <= nearZ) {
+        std::cerr << "分簇光照的近裁剪面必须大于0且小于远裁剪面" << std::endl;
+        return;
+    }
+    UpdateClusterBounds(projection, nearZ, farZ);
+
+    // 光源包围球变换到视图空间，并按深度确定覆盖的切片范围
+    for (uint32_t i = 0; i < count; ++i) {
+        const ClusterLightData& light = m_Lights[i];
+        if (light.type == static_cast<uint32_t>(LightType::Directional)) {
+            m_DirectionalIndices.push_back(i);
+            continue;
+        }
+        if (light.range <= 0.0f) {
+            continue;
+        }
+
+        LightSphere sphere;
+        float worldCenter[3];
+        ComputeBoundingSphere(light, worldCenter, sphere.radius);
+        TransformPoint(worldCenter, view, sphere.center);
+        float depth = -sphere.center[2];
+        if (depth + sphere.radius < nearZ || depth - sphere.radius > farZ) {
+            continue;
+        }
+        sphere.index = i;
+        sphere.firstSlice = GetSliceForDepth(depth - sphere.radius);
+        sphere.lastSlice = std::min(GetSliceForDepth(depth + sphere.radius), m_Config.clustersZ - 1);
+        m_Spheres.push_back(sphere);
+    }
+    m_Stats.directionalLights = static_cast<uint32_t>(m_DirectionalIndices.size());
+
+    JobSystem::GetInstance().ParallelFor(m_Config.clustersZ, 1, [this](uint32_t begin, uint32_t end) {
+        for (uint32_t z = begin; z < end; ++z) {
+            AssignSlice(z);
+        }
+    });
+
+    // 按切片顺序拼接成紧凑列表
+    std::vector<uint8_t> visible(count, 0);
+    for (uint32_t z = 0; z < m_Config.clustersZ; ++z) {
+        const Slice& slice = m_Slices[z];
+        uint32_t base = static_cast<uint32_t>(m_LightIndices.size());
+        m_LightIndices.insert(m_LightIndices.end(), slice.indices.begin(), slice.indices.end());
+        LightClusterRange* clusters = m_Clusters.data() + static_cast<size_t>(z) * m_TilesPerSlice;
+        for (uint32_t tile = 0; tile < m_TilesPerSlice; ++tile) {
+            clusters[tile].offset = base + slice.ranges[tile].offset;
+            clusters[tile].count = slice.ranges[tile].count;
+            m_Stats.maxLightsPerCluster = std::max(m_Stats.maxLightsPerCluster, slice.ranges[tile].count);
+        }
+        for (uint32_t index : slice.indices) {
+            visible[index] = 1;
+        }
+    }
+    m_Stats.lightIndices = static_cast<uint32_t>(m_LightIndices.size());
+    m_Stats.visibleLights = static_cast<uint32_t>(std::count(visible.begin(), visible.end(), 1));
+}
+
+void ClusteredLightCuller::AssignSlice(uint32_t z) {
+    Slice& slice = m_Slices[z];
+    slice.hitClusters.clear();
+    slice.hitLights.clear();
+
+    for (const LightSphere& sphere : m_Spheres) {
+        if (z < sphere.firstSlice || z > sphere.lastSlice) {
+            continue;
+        }
+
+        // 切片内所有簇的深度范围相同，深度方向的距离只需计算一次
+        float depth = -sphere.center[2];
+        float distanceZ = std::max(slice.nearDepth - depth, 0.0f) + std::max(depth - slice.farDepth, 0.0f);
+        float remaining = sphere.radius * sphere.radius - distanceZ * distanceZ;
+        if (remaining < 0.0f) {
+            continue;
+        }
+
+        const float cx = sphere.center[0];
+        const float cy = sphere.center[1];
+#ifdef PLE_SIMD_SSE2
+        const __m128 centerX = _mm_set1_ps(cx);
+        const __m128 centerY = _mm_set1_ps(cy);
+        const __m128 limit = _mm_set1_ps(remaining);
+        const __m128 zero = _mm_setzero_ps();
+        for (uint32_t tile = 0; tile < m_PaddedTiles; tile += 4) {
+            __m128 dx = _mm_add_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&slice.minX[tile]), centerX), zero),
+                                   _mm_max_ps(_mm_sub_ps(centerX, _mm_loadu_ps(&slice.maxX[tile])), zero));
+            __m128 dy = _mm_add_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&slice.minY[tile]), centerY), zero),
+                                   _mm_max_ps(_mm_sub_ps(centerY, _mm_loadu_ps(&slice.maxY[tile])), zero));
+            __m128 distance = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            int mask = _mm_movemask_ps(_mm_cmple_ps(distance, limit));
+            while (mask) {
+                uint32_t lane = 0;
+                while (!(mask & (1 << lane))) {
+                    ++lane;
+                }
+                mask &= ~(1 << lane);
+                slice.hitClusters.push_back(tile + lane);
+                slice.hitLights.push_back(sphere.index);
+            }
+        }
+#else
+        for (uint32_t tile = 0; tile < m_TilesPerSlice; ++tile) {
+            float dx = std::max(slice.minX[tile] - cx, 0.0f) + std::max(cx - slice.maxX[tile], 0.0f);
+            float dy = std::max(slice.minY[tile] - cy, 0.0f) + std::max(cy - slice.maxY[tile], 0.0f);
+            if (dx * dx + dy * dy <= remaining) {
+                slice.hitClusters.push_back(tile);
+                slice.hitLights.push_back(sphere.index);
+            }
+        }
+#endif
+    }
+
+    // 计数排序：按簇分组，同一个簇内保持光源的输入顺序
+    for (LightClusterRange& range : slice.ranges) {
+        range.offset = 0;
+        range.count = 0;
+    }
+    for (uint32_t tile : slice.hitClusters) {
+        ++slice.ranges[tile].count;
+    }
+    uint32_t offset = 0;
+    for (LightClusterRange& range : slice.ranges) {
+        range.offset = offset;
+        offset += range.count;
+        range.count = 0;
+    }
+    slice.indices.resize(slice.hitClusters.size());
+    for (size_t i = 0; i < slice.hitClusters.size(); ++i) {
+        LightClusterRange& range = slice.ranges[slice.hitClusters[i]];
+        slice.indices[range.offset + range.count++] = slice.hitLights[i];
+    }
+}
+
+} // namespace PLE
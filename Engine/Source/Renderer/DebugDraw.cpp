@@ -0,0 +1,311 @@
+/**
+ * @file DebugDraw.cpp
+ * @brief 调试绘制实现
+ */
+
+#include "Renderer/DebugDraw.h"
+#include "Renderer/RenderSystem.h"
+
+#include <cmath>
+#include <cstddef>
+
+namespace PLE {
+
+DebugDraw& DebugDraw::GetInstance() {
+    static DebugDraw instance;
+    return instance;
+}
+
+const VertexLayout& DebugDraw::GetVertexLayout() {
+    static const VertexLayout layout = [] {
+        VertexLayout result;
+        result.attributes = {
+            { 0, VertexAttributeFormat::Float3, static_cast<uint32_t>(offsetof(DebugVertex, x)) },
+            { 1, VertexAttributeFormat::Unorm8x4, static_cast<uint32_t>(offsetof(DebugVertex, color)) },
+        };
+        result.stride = sizeof(DebugVertex);
+        result.topology = PrimitiveTopology::Lines;
+        return result;
+    }();
+    return layout;
+}
+
+#ifdef PLE_DEBUG_DRAW_ENABLED
+
+namespace {
+
+constexpr float TWO_PI = 6.28318530718f;
+
+/**
+ * @brief 笔画字体：字符在4x6的网格上，每4个数字是一条线段的两个端点(x0, y0, x1, y1)，y向上
+ */
+const char* GetGlyph(char character) {
+    switch (character) {
+    case '0': return "0040 4046 4606 0600 0046";
+    case '1': return "2026 2615 1030";
+    case '2': return "0646 4643 4303 0300 0040";
+    case '3': return "0646 4640 4000 1343";
+    case '4': return "0603 0343 4640";
+    case '5': return "4606 0603 0333 3342 4241 4130 3000";
+    case '6': return "4606 0600 0040 4043 4303";
+    case '7': return "0646 4620";
+    case '8': return "0040 4046 4606 0600 0343";
+    case '9': return "4303 0306 0646 4640 4000";
+    case 'A': return "0004 0426 2644 4440 0343";
+    case 'B': return "0006 0636 3645 4544 4433 0333 3342 4241 4130 3000";
+    case 'C': return "4606 0600 0040";
+    case 'D': return "0006 0626 2644 4442 4220 2000";
+    case 'E': return "4606 0600 0040 0333";
+    case 'F': return "4606 0600 0333";
+    case 'G': return "4606 0600 0040 4043 4323";
+    case 'H': return "0006 4046 0343";
+    case 'I': return "0646 2026 0040";
+    case 'J': return "0646 3630 3010 1001";
+    case 'K': return "0006 0346 0340";
+    case 'L': return "0600 0040";
+    case 'M': return "0006 0623 2346 4640";
+    case 'N': return "0006 0640 4046";
+    case 'O': return "0040 4046 4606 0600";
+    case 'P': return "0006 0646 4643 4303";
+    case 'Q': return "0040 4046 4606 0600 2240";
+    case 'R': return "0006 0646 4643 4303 2340";
+    case 'S': return "4606 0603 0343 4340 4000";
+    case 'T': return "0646 2620";
+    case 'U': return "0600 0040 4046";
+    case 'V': return "0620 2046";
+    case 'W': return "0610 1023 2330 3046";
+    case 'X': return "0046 0640";
+    case 'Y': return "0623 2346 2320";
+    case 'Z': return "0646 4600 0040";
+    case '.': return "2021";
+    case ',': return "2110";
+    case ':': return "2122 2425";
+    case '-': return "1333";
+    case '+': return "1333 2224";
+    case '=': return "1232 1434";
+    case '/': return "0046";
+    case '(': return "3624 2422 2230";
+    case ')': return "1624 2422 2210";
+    case '[': return "3616 1610 1030";
+    case ']': return "1636 3630 3010";
+    case '<': return "4623 2340";
+    case '>': return "0643 4300";
+    case '_': return "0040";
+    case '%': return "0046 0616 3040";
+    case '!': return "2622 2021";
+    case '\'': return "2625";
+    case '"': return "1615 3635";
+    case '|': return "2620";
+    case '#': return "1115 3135 0242 0444";
+    case '*': return "1335 1533 2224";
+    case ' ': return "";
+    default: return "0646 4643 4323 2322 2021";   // 不支持的字符显示为'?'
+    }
+}
+
+DebugVertex MakeVertex(const Vector3& position, uint32_t color) {
+    return { position.x, position.y, position.z, color };
+}
+
+Vector3 TransformPoint(const Matrix4& transform, float x, float y, float z) {
+    const auto& m = transform.m;
+    return Vector3(x * m[0] + y * m[4] + z * m[8] + m[12],
+                   x * m[1] + y * m[5] + z * m[9] + m[13],
+                   x * m[2] + y * m[6] + z * m[10] + m[14]);
+}
+
+/**
+ * @brief 包围盒的12条棱，corners按(x, y, z)的位组合排列
+ */
+void AppendBoxEdges(const Vector3 corners[8], uint32_t color, std::vector<DebugVertex>& output) {
+    static const int edges[12][2] = {
+        { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 },     // 沿X
+        { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },     // 沿Y
+        { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }      // 沿Z
+    };
+    for (const auto& edge : edges) {
+        output.push_back(MakeVertex(corners[edge[0]], color));
+        output.push_back(MakeVertex(corners[edge[1]], color));
+    }
+}
+
+} // namespace
+
+DebugDraw::ThreadBuffer& DebugDraw::GetThreadBuffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Buffers.push_back(std::make_unique<ThreadBuffer>());
+        buffer = m_Buffers.back().get();
+    }
+    return *buffer;
+}
+
+void DebugDraw::AddLines(const DebugVertex* vertices, size_t count) {
+    ThreadBuffer& buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.vertices.insert(buffer.vertices.end(), vertices, vertices + count);
+}
+
+void DebugDraw::Line(const Vector3& from, const Vector3& to, uint32_t color) {
+    if (!IsEnabled()) {
+        return;
+    }
+    const DebugVertex vertices[2] = { MakeVertex(from, color), MakeVertex(to, color) };
+    AddLines(vertices, 2);
+}
+
+void DebugDraw::Box(const Vector3& min, const Vector3& max, uint32_t color) {
+    if (!IsEnabled()) {
+        return;
+    }
+    Vector3 corners[8];
+    for (int i = 0; i < 8; ++i) {
+        corners[i] = Vector3((i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z);
+    }
+    std::vector<DebugVertex> vertices;
+    vertices.reserve(24);
+    AppendBoxEdges(corners, color, vertices);
+    AddLines(vertices.data(), vertices.size());
+}
+
+void DebugDraw::Box(const Matrix4& transform, const Vector3& halfExtents, uint32_t color) {
+    if (!IsEnabled()) {
+        return;
+    }
+    Vector3 corners[8];
+    for (int i = 0; i < 8; ++i) {
+        corners[i] = TransformPoint(transform, (i & 1) ? halfExtents.x : -halfExtents.x, (i & 2) ? halfExtents.y : -halfExtents.y,
+                                    (i & 4) ? halfExtents.z : -halfExtents.z);
+    }
+    std::vector<DebugVertex> vertices;
+    vertices.reserve(24);
+    AppendBoxEdges(corners, color, vertices);
+    AddLines(vertices.data(), vertices.size());
+}
+
+void DebugDraw::Sphere(const Vector3& center, float radius, uint32_t color, uint32_t segments) {
+    if (!IsEnabled() || segments < 3) {
+        return;
+    }
+    std::vector<DebugVertex> vertices;
+    vertices.reserve(static_cast<size_t>(segments) * 6);
+    float previousCos = 1.0f;
+    float previousSin = 0.0f;
+    for (uint32_t i = 1; i <= segments; ++i) {
+        const float angle = TWO_PI * static_cast<float>(i) / static_cast<float>(segments);
+        const float cosine = std::cos(angle);
+        const float sine = std::sin(angle);
+        const float a0 = previousCos * radius;
+        const float b0 = previousSin * radius;
+        const float a1 = cosine * radius;
+        const float b1 = sine * radius;
+        // XY、YZ、ZX平面上的圆
+        vertices.push_back({ center.x + a0, center.y + b0, center.z, color });
+        vertices.push_back({ center.x + a1, center.y + b1, center.z, color });
+        vertices.push_back({ center.x, center.y + a0, center.z + b0, color });
+        vertices.push_back({ center.x, center.y + a1, center.z + b1, color });
+        vertices.push_back({ center.x + b0, center.y, center.z + a0, color });
+        vertices.push_back({ center.x + b1, center.y, center.z + a1, color });
+        previousCos = cosine;
+        previousSin = sine;
+    }
+    AddLines(vertices.data(), vertices.size());
+}
+
+void DebugDraw::Axes(const Matrix4& transform, float size) {
+    if (!IsEnabled()) {
+        return;
+    }
+    const Vector3 origin = TransformPoint(transform, 0.0f, 0.0f, 0.0f);
+    const DebugVertex vertices[6] = {
+        MakeVertex(origin, 0xFF0000FFu), MakeVertex(TransformPoint(transform, size, 0.0f, 0.0f), 0xFF0000FFu),
+        MakeVertex(origin, 0xFF00FF00u), MakeVertex(TransformPoint(transform, 0.0f, size, 0.0f), 0xFF00FF00u),
+        MakeVertex(origin, 0xFFFF0000u), MakeVertex(TransformPoint(transform, 0.0f, 0.0f, size), 0xFFFF0000u),
+    };
+    AddLines(vertices, 6);
+}
+
+void DebugDraw::Text(const Vector3& position, const std::string& text, uint32_t color, float height) {
+    if (!IsEnabled() || text.empty()) {
+        return;
+    }
+    Vector3 right;
+    Vector3 up;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        right = m_TextRight;
+        up = m_TextUp;
+    }
+
+    // 网格单位：字符高6、宽4，字符间距2，行距3
+    const float unit = height / 6.0f;
+    std::vector<DebugVertex> vertices;
+    float column = 0.0f;
+    float row = 0.0f;
+    for (char character : text) {
+        if (character == '\n') {
+            column = 0.0f;
+            row -= 9.0f;
+            continue;
+        }
+        if (character >= 'a' && character <= 'z') {
+            character = static_cast<char>(character - 'a' + 'A');
+        }
+        const char* stroke = GetGlyph(character);
+        while (stroke[0] != '\0') {
+            for (int point = 0; point < 2; ++point) {
+                const float x = (column + static_cast<float>(stroke[point * 2] - '0')) * unit;
+                const float y = (row + static_cast<float>(stroke[point * 2 + 1] - '0')) * unit;
+                vertices.push_back({ position.x + right.x * x + up.x * y, position.y + right.y * x + up.y * y,
+                                     position.z + right.z * x + up.z * y, color });
+            }
+            stroke += stroke[4] == ' ' ? 5 : 4;
+        }
+        column += 6.0f;
+    }
+    if (!vertices.empty()) {
+        AddLines(vertices.data(), vertices.size());
+    }
+}
+
+void DebugDraw::SetTextBasis(const Vector3& right, const Vector3& up) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_TextRight = right;
+    m_TextUp = up;
+}
+
+uint32_t DebugDraw::Flush(RenderSystem& renderSystem, std::shared_ptr<Material> material) {
+    m_Merged.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for (const std::unique_ptr<ThreadBuffer>& buffer : m_Buffers) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            m_Merged.insert(m_Merged.end(), buffer->vertices.begin(), buffer->vertices.end());
+            buffer->vertices.clear();
+        }
+    }
+    if (m_Merged.empty() || !material) {
+        return 0;
+    }
+
+    std::shared_ptr<Mesh> mesh = renderSystem.CreateTransientMesh(m_Merged.data(), static_cast<uint32_t>(m_Merged.size()),
+                                                                  GetVertexLayout(), nullptr, 0);
+    if (!mesh) {
+        return 0;
+    }
+    renderSystem.DrawMesh(mesh, material, Matrix4::Identity());
+    return static_cast<uint32_t>(m_Merged.size() / 2);
+}
+
+void DebugDraw::Clear() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (const std::unique_ptr<ThreadBuffer>& buffer : m_Buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->vertices.clear();
+    }
+}
+
+#endif // PLE_DEBUG_DRAW_ENABLED
+
+} // namespace PLE
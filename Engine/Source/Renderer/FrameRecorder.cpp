@@ -0,0 +1,517 @@
+/**
+ * @file FrameRecorder.cpp
+ * @brief 帧录制器实现
+ */
+
+#include "Renderer/FrameRecorder.h"
+#include "Renderer/RenderSystem.h"
+#include "Renderer/RenderResources.h"
+#include "ImageEncoder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+#ifndef PLE_PLATFORM_WINDOWS
+#include <csignal>
+#include <ctime>
+#include <pthread.h>
+#endif
+
+namespace PLE {
+
+namespace {
+
+// BT.601有限范围（Y 16~235，UV 16~240）
+inline uint8_t LumaFromRgb(int r, int g, int b) {
+    return static_cast<uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+}
+
+inline uint8_t ChromaBlueFromRgb(int r, int g, int b) {
+    return static_cast<uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+}
+
+inline uint8_t ChromaRedFromRgb(int r, int g, int b) {
+    return static_cast<uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+}
+
+FILE* OpenPipe(const char* command) {
+#ifdef PLE_PLATFORM_WINDOWS
+    return _popen(command, "wb");
+#else
+    return popen(command, "w");
+#endif
+}
+
+void ClosePipe(FILE* pipe) {
+#ifdef PLE_PLATFORM_WINDOWS
+    _pclose(pipe);
+#else
+    // 读取端已经退出时，关闭前冲刷剩余数据会产生SIGPIPE：关闭期间屏蔽它，并丢弃由此产生的信号
+    sigset_t pipeSignal;
+    sigset_t previous;
+    sigemptyset(&pipeSignal);
+    sigaddset(&pipeSignal, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipeSignal, &previous);
+    pclose(pipe);
+    sigset_t pending;
+    sigpending(&pending);
+    if (sigismember(&pending, SIGPIPE) && !sigismember(&previous, SIGPIPE)) {
+        const timespec zero = { 0, 0 };
+        sigtimedwait(&pipeSignal, nullptr, &zero);
+    }
+    pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+#endif
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// FrameRecorder
+// ---------------------------------------------------------------------------
+
+FrameRecorder::FrameRecorder(RenderSystem& renderSystem, const FrameRecorderConfig& config)
+    : m_RenderSystem(renderSystem), m_Config(config) {
+}
+
+FrameRecorder::~FrameRecorder() {
+    Shutdown();
+}
+
+bool FrameRecorder::Initialize() {
+    if (m_Initialized) {
+        return true;
+    }
+    if (m_Config.output.empty()) {
+        std::cerr << "帧输出路径为空！" << std::endl;
+        return false;
+    }
+
+    if (m_Config.format == FrameOutputFormat::Y4M) {
+        m_StreamIsPipe = m_Config.output[0] == '|';
+        m_Stream = m_StreamIsPipe ? OpenPipe(m_Config.output.c_str() + 1) : std::fopen(m_Config.output.c_str(), "wb");
+        if (!m_Stream) {
+            std::cerr << "无法打开帧输出：" << m_Config.output << std::endl;
+            return false;
+        }
+        m_StreamHeaderWritten = false;
+        m_StreamFailed = false;
+        m_StreamWidth = 0;
+        m_StreamHeight = 0;
+        m_NextTicket = 0;
+        m_NextWrite = 0;
+    }
+
+    uint32_t workerCount = m_Config.workerCount;
+    if (workerCount == 0) {
+        uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    m_Running = true;
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        m_Workers.emplace_back(&FrameRecorder::WorkerLoop, this);
+    }
+
+    m_Initialized = true;
+    return true;
+}
+
+void FrameRecorder::Shutdown() {
+    if (!m_Initialized) {
+        return;
+    }
+
+    Flush();
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Running = false;
+    }
+    m_TaskCondition.notify_all();
+    for (std::thread& worker : m_Workers) {
+        worker.join();
+    }
+    m_Workers.clear();
+
+    // 所在的帧一直没有提交的读取只能放弃
+    if (!m_Reading.empty()) {
+        m_Stats.failed += m_Reading.size();
+        m_Reading.clear();
+    }
+    m_Frames.clear();
+
+    if (m_Stream) {
+        if (m_StreamIsPipe) {
+            ClosePipe(m_Stream);
+        } else {
+            std::fclose(m_Stream);
+        }
+        m_Stream = nullptr;
+    }
+    m_Initialized = false;
+}
+
+bool FrameRecorder::Capture(int x, int y, int width, int height, const std::string& path) {
+    if (!m_Initialized || width <= 0 || height <= 0) {
+        return false;
+    }
+    if (m_Config.format == FrameOutputFormat::Y4M && m_StreamWidth != 0 &&
+        (width != m_StreamWidth || height != m_StreamHeight)) {
+        std::cerr << "视频流中所有帧的尺寸必须相同！" << std::endl;
+        return false;
+    }
+
+    DispatchReady();
+    Frame* frame = AcquireFrame(width, height);
+    if (!frame) {
+        return false;
+    }
+
+    if (!m_RenderSystem.ReadPixelsAsync(x, y, frame->buffer)) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        frame->busy = false;
+        ++m_Stats.failed;
+        return false;
+    }
+
+    frame->generation = m_Generation;
+    if (m_Config.format == FrameOutputFormat::PNG) {
+        frame->path = path.empty() ? FormatPath(m_NextIndex) : path;
+    } else {
+        m_StreamWidth = width;
+        m_StreamHeight = height;
+    }
+    ++m_NextIndex;
+    m_Reading.push_back(frame);
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    ++m_Stats.captured;
+    return true;
+}
+
+void FrameRecorder::Update() {
+    if (!m_Initialized) {
+        return;
+    }
+    ++m_Generation;
+    DispatchReady();
+}
+
+void FrameRecorder::Flush() {
+    if (!m_Initialized) {
+        return;
+    }
+
+    DispatchReady();
+    while (!m_Reading.empty()) {
+        if (!WaitOldest()) {
+            std::cerr << "截图所在的帧还没有提交，无法等待读取完成！" << std::endl;
+            break;
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_DoneCondition.wait(lock, [this]() { return m_Pending == 0; });
+}
+
+FrameRecorderStats FrameRecorder::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Stats;
+}
+
+FrameRecorder::Frame* FrameRecorder::AcquireFrame(int width, int height) {
+    Frame* frame = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        frame = FindFreeFrame(width, height);
+    }
+
+    if (!frame && m_Frames.size() < std::max<uint32_t>(m_Config.maxBuffers, 1)) {
+        m_Frames.push_back(std::make_unique<Frame>());
+        frame = m_Frames.back().get();
+        frame->busy = true;
+    }
+
+    if (!frame && !m_Config.dropWhenBusy) {
+        // 等待编码中的帧释放缓冲区；没有帧在编码时先等最早的读取完成并交给编码线程
+        const auto start = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        while (!(frame = FindFreeFrame(width, height))) {
+            if (m_Encoding > 0) {
+                m_DoneCondition.wait(lock);
+                continue;
+            }
+            lock.unlock();
+            const bool progressed = WaitOldest();
+            lock.lock();
+            if (!progressed) {
+                // 所有缓冲区都在本帧读取，要等EndFrame提交后才能完成
+                break;
+            }
+        }
+        m_Stats.stallMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    if (!frame) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ++m_Stats.dropped;
+        return nullptr;
+    }
+
+    if (!frame->buffer || frame->buffer->GetWidth() != width || frame->buffer->GetHeight() != height) {
+        frame->buffer = m_RenderSystem.CreateReadbackBuffer(width, height);
+        if (!frame->buffer) {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            frame->busy = false;
+            ++m_Stats.failed;
+            return nullptr;
+        }
+    }
+    return frame;
+}
+
+FrameRecorder::Frame* FrameRecorder::FindFreeFrame(int width, int height) {
+    // 优先复用尺寸相同的缓冲区，其次是任意空闲的缓冲区（重新创建）
+    Frame* fallback = nullptr;
+    for (const std::unique_ptr<Frame>& frame : m_Frames) {
+        if (frame->busy) {
+            continue;
+        }
+        if (frame->buffer && frame->buffer->GetWidth() == width && frame->buffer->GetHeight() == height) {
+            frame->busy = true;
+            return frame.get();
+        }
+        if (!fallback) {
+            fallback = frame.get();
+        }
+    }
+    if (fallback) {
+        fallback->busy = true;
+    }
+    return fallback;
+}
+
+bool FrameRecorder::WaitOldest() {
+    if (m_Reading.empty()) {
+        return false;
+    }
+
+    Frame* oldest = m_Reading.front();
+    if (oldest->buffer->Wait()) {
+        DispatchReady();
+        return true;
+    }
+    if (oldest->generation == m_Generation) {
+        return false;
+    }
+
+    // 所在的帧已经结束仍然没有完成，说明提交失败
+    m_Reading.pop_front();
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    oldest->busy = false;
+    ++m_Stats.failed;
+    return true;
+}
+
+void FrameRecorder::DispatchReady() {
+    // 按截取顺序交出，Y4M的写出顺序在这里确定
+    while (!m_Reading.empty() && m_Reading.front()->buffer->IsReady()) {
+        Frame* frame = m_Reading.front();
+        m_Reading.pop_front();
+        Dispatch(frame);
+    }
+}
+
+void FrameRecorder::Dispatch(Frame* frame) {
+    const int width = frame->buffer->GetWidth();
+    const int height = frame->buffer->GetHeight();
+    frame->rows.resize(height);
+    for (int row = 0; row < height; ++row) {
+        frame->rows[row] = frame->buffer->GetRow(height - 1 - row);
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    ++m_Encoding;
+    ++m_Pending;
+    if (m_Config.format == FrameOutputFormat::PNG) {
+        const uint32_t rowBytes = static_cast<uint32_t>(width) * 4;
+        frame->blockRows = std::max<uint32_t>(m_Config.pngBlockBytes / rowBytes, 1);
+        const uint32_t blockCount = (static_cast<uint32_t>(height) + frame->blockRows - 1) / frame->blockRows;
+        frame->blocks.resize(blockCount);
+        frame->remainingBlocks.store(blockCount, std::memory_order_relaxed);
+        for (uint32_t block = 0; block < blockCount; ++block) {
+            m_Tasks.push_back({ frame, block });
+        }
+    } else {
+        frame->ticket = m_NextTicket++;
+        m_Tasks.push_back({ frame, 0 });
+    }
+    m_TaskCondition.notify_all();
+}
+
+void FrameRecorder::ReleaseFrame(Frame* frame) {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        frame->busy = false;
+        --m_Encoding;
+    }
+    m_DoneCondition.notify_all();
+}
+
+void FrameRecorder::FinishFrame(bool success, uint64_t bytes) {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (success) {
+            ++m_Stats.written;
+        } else {
+            ++m_Stats.failed;
+        }
+        m_Stats.bytesWritten += bytes;
+        --m_Pending;
+    }
+    m_DoneCondition.notify_all();
+}
+
+void FrameRecorder::WorkerLoop() {
+#ifndef PLE_PLATFORM_WINDOWS
+    // 管道读取端退出后写入会产生SIGPIPE，默认处理是结束整个进程；
+    // 编码线程屏蔽它，fwrite返回EPIPE错误，由m_StreamFailed停止后续写入
+    sigset_t pipeSignal;
+    sigemptyset(&pipeSignal);
+    sigaddset(&pipeSignal, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipeSignal, nullptr);
+#endif
+
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_TaskCondition.wait(lock, [this]() { return !m_Running || !m_Tasks.empty(); });
+            if (m_Tasks.empty()) {
+                return;
+            }
+            task = m_Tasks.front();
+            m_Tasks.pop_front();
+        }
+
+        if (m_Config.format == FrameOutputFormat::PNG) {
+            EncodePngBlock(task.frame, task.block);
+        } else {
+            EncodeY4mFrame(task.frame);
+        }
+    }
+}
+
+void FrameRecorder::EncodePngBlock(Frame* frame, uint32_t block) {
+    const uint32_t width = static_cast<uint32_t>(frame->buffer->GetWidth());
+    const uint32_t height = static_cast<uint32_t>(frame->buffer->GetHeight());
+    const uint32_t firstRow = block * frame->blockRows;
+    const uint32_t rowCount = std::min(frame->blockRows, height - firstRow);
+    ImageEncoder::EncodePngRows(frame->rows.data(), width, firstRow, rowCount, height, frame->blocks[block]);
+
+    // 最后完成的一段负责拼接和写出
+    if (frame->remainingBlocks.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+
+    std::vector<uint8_t> png;
+    ImageEncoder::AssemblePng(width, height, frame->blocks.data(), frame->blocks.size(), png);
+    const std::string path = frame->path;
+    ReleaseFrame(frame);
+
+    std::ofstream file(path, std::ios::binary);
+    const bool success = file && file.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+    if (!success) {
+        std::cerr << "写入截图失败：" << path << std::endl;
+    }
+    FinishFrame(success, success ? png.size() : 0);
+}
+
+void FrameRecorder::EncodeY4mFrame(Frame* frame) {
+    const int width = frame->buffer->GetWidth();
+    const int height = frame->buffer->GetHeight();
+    const int chromaWidth = (width + 1) / 2;
+    const int chromaHeight = (height + 1) / 2;
+    const size_t lumaSize = static_cast<size_t>(width) * height;
+    const size_t chromaSize = static_cast<size_t>(chromaWidth) * chromaHeight;
+
+    std::vector<uint8_t> planes(lumaSize + chromaSize * 2);
+    uint8_t* luma = planes.data();
+    uint8_t* chromaBlue = luma + lumaSize;
+    uint8_t* chromaRed = chromaBlue + chromaSize;
+
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row = frame->rows[y];
+        uint8_t* output = luma + static_cast<size_t>(y) * width;
+        for (int x = 0; x < width; ++x) {
+            output[x] = LumaFromRgb(row[x * 4], row[x * 4 + 1], row[x * 4 + 2]);
+        }
+    }
+
+    // 色度取2x2像素的平均值，居中采样（C420jpeg）；奇数尺寸时最后一列/行重复使用
+    for (int y = 0; y < chromaHeight; ++y) {
+        const uint8_t* top = frame->rows[y * 2];
+        const uint8_t* bottom = frame->rows[std::min(y * 2 + 1, height - 1)];
+        for (int x = 0; x < chromaWidth; ++x) {
+            const int left = x * 8;
+            const int right = std::min(x * 2 + 1, width - 1) * 4;
+            const int r = (top[left] + top[right] + bottom[left] + bottom[right] + 2) >> 2;
+            const int g = (top[left + 1] + top[right + 1] + bottom[left + 1] + bottom[right + 1] + 2) >> 2;
+            const int b = (top[left + 2] + top[right + 2] + bottom[left + 2] + bottom[right + 2] + 2) >> 2;
+            const size_t index = static_cast<size_t>(y) * chromaWidth + x;
+            chromaBlue[index] = ChromaBlueFromRgb(r, g, b);
+            chromaRed[index] = ChromaRedFromRgb(r, g, b);
+        }
+    }
+
+    // 转换完成后缓冲区就可以复用，写出要等前面的帧
+    const uint64_t ticket = frame->ticket;
+    ReleaseFrame(frame);
+
+    bool success = false;
+    uint64_t bytes = 0;
+    {
+        std::unique_lock<std::mutex> lock(m_StreamMutex);
+        m_StreamCondition.wait(lock, [this, ticket]() { return m_NextWrite == ticket; });
+        if (!m_StreamFailed) {
+            success = true;
+            if (!m_StreamHeaderWritten) {
+                char header[128];
+                const int length = std::snprintf(header, sizeof(header), "YUV4MPEG2 W%d H%d F%u:1 Ip A1:1 C420jpeg XCOLORRANGE=LIMITED\n",
+                                                 width, height, std::max<uint32_t>(m_Config.frameRate, 1));
+                success = std::fwrite(header, 1, length, m_Stream) == static_cast<size_t>(length);
+                bytes += success ? length : 0;
+                m_StreamHeaderWritten = true;
+            }
+            static const char frameHeader[] = "FRAME\n";
+            success = success && std::fwrite(frameHeader, 1, sizeof(frameHeader) - 1, m_Stream) == sizeof(frameHeader) - 1;
+            success = success && std::fwrite(planes.data(), 1, planes.size(), m_Stream) == planes.size();
+            // 在编码线程上冲刷，写入错误（以及SIGPIPE）都发生在屏蔽了SIGPIPE的线程上
+            success = success && std::fflush(m_Stream) == 0;
+            if (success) {
+                bytes += sizeof(frameHeader) - 1 + planes.size();
+            } else {
+                std::cerr << "写入视频流失败：" << m_Config.output << std::endl;
+                m_StreamFailed = true;
+            }
+        }
+        ++m_NextWrite;
+    }
+    m_StreamCondition.notify_all();
+    FinishFrame(success, bytes);
+}
+
+std::string FrameRecorder::FormatPath(uint64_t index) const {
+    const unsigned int number = static_cast<unsigned int>(index);
+    const int length = std::snprintf(nullptr, 0, m_Config.output.c_str(), number);
+    if (length <= 0) {
+        return m_Config.output;
+    }
+    std::string path(static_cast<size_t>(length) + 1, '\0');
+    std::snprintf(&path[0], path.size(), m_Config.output.c_str(), number);
+    path.resize(length);
+    return path;
+}
+
+} // namespace PLE
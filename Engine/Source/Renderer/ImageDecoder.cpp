@@ -0,0 +1,1348 @@
+/**
+ * @file ImageDecoder.cpp
+ * @brief PNG/TGA/JPEG图像解码实现
+ */
+
+#include "ImageDecoder.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+namespace PLE {
+
+namespace {
+
+// 单边最大尺寸，同时保证width * height * 4不会溢出
+constexpr uint32_t MaxImageDimension = 16384;
+
+bool IsValidDimension(uint32_t width, uint32_t height) {
+    return width > 0 && height > 0 && width <= MaxImageDimension && height <= MaxImageDimension;
+}
+
+uint32_t ReadBigEndian32(const uint8_t* data) {
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+           (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+}
+
+uint32_t ReadBigEndian16(const uint8_t* data) {
+    return (static_cast<uint32_t>(data[0]) << 8) | static_cast<uint32_t>(data[1]);
+}
+
+uint32_t ReadLittleEndian16(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8);
+}
+
+// ---------------------------------------------------------------------------
+// Inflate
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief 低位在前的位读取器，越过数据末尾时补0并记录
+ */
+class LsbBitReader {
+public:
+    LsbBitReader(const uint8_t* data, size_t size) : m_Data(data), m_Size(size) {}
+
+    uint32_t Peek(uint32_t count) {
+        if (m_Count < count) {
+            Refill();
+        }
+        return static_cast<uint32_t>(m_Buffer & ((1ull << count) - 1));
+    }
+
+    void Consume(uint32_t count) {
+        m_Buffer >>= count;
+        m_Count -= count;
+    }
+
+    uint32_t Read(uint32_t count) {
+        const uint32_t value = Peek(count);
+        Consume(count);
+        return value;
+    }
+
+    void AlignToByte() {
+        Consume(m_Count % 8);
+    }
+
+    /**
+     * @brief 是否读取了超出数据末尾的位
+     */
+    bool IsOverrun() const { return m_Padding * 8 > m_Count; }
+
+private:
+    void Refill() {
+        while (m_Count <= 56) {
+            uint64_t byte = 0;
+            if (m_Position < m_Size) {
+                byte = m_Data[m_Position++];
+            } else {
+                ++m_Padding;
+            }
+            m_Buffer |= byte << m_Count;
+            m_Count += 8;
+        }
+    }
+
+    const uint8_t* m_Data;
+    size_t m_Size;
+    size_t m_Position = 0;
+    uint64_t m_Buffer = 0;
+    uint32_t m_Count = 0;
+    uint32_t m_Padding = 0;
+};
+
+/**
+ * @brief 规范霍夫曼码表：9位快速查找表加逐位解码的慢速路径
+ */
+struct InflateTable {
+    static constexpr uint32_t FastBits = 9;
+
+    std::array<uint16_t, 1u << FastBits> fast;  // 符号 << 4 | 码长，0表示码长超过FastBits
+    std::array<uint16_t, 16> counts;
+    std::array<uint16_t, 320> symbols;
+
+    bool Build(const uint8_t* lengths, uint32_t count) {
+        fast.fill(0);
+        counts.fill(0);
+        for (uint32_t i = 0; i < count; ++i) {
+            ++counts[lengths[i]];
+        }
+        counts[0] = 0;
+
+        // 码字不能超额分配（允许不完整，例如只有一个距离码）
+        int32_t left = 1;
+        for (uint32_t length = 1; length < 16; ++length) {
+            left = (left << 1) - counts[length];
+            if (left < 0) {
+                return false;
+            }
+        }
+
+        std::array<uint16_t, 16> offsets;
+        offsets[1] = 0;
+        for (uint32_t length = 1; length < 15; ++length) {
+            offsets[length + 1] = static_cast<uint16_t>(offsets[length] + counts[length]);
+        }
+        std::array<uint32_t, 16> nextCode;
+        uint32_t code = 0;
+        for (uint32_t length = 1; length < 16; ++length) {
+            nextCode[length] = code;
+            code = (code + counts[length]) << 1;
+        }
+
+        for (uint32_t symbol = 0; symbol < count; ++symbol) {
+            const uint32_t length = lengths[symbol];
+            if (length == 0) {
+                continue;
+            }
+            symbols[offsets[length]++] = static_cast<uint16_t>(symbol);
+            if (length <= FastBits) {
+                // 码字高位先出现在位流中，查找表按位反转后的值索引
+                const uint32_t codeword = nextCode[length];
+                uint32_t reversed = 0;
+                for (uint32_t bit = 0; bit < length; ++bit) {
+                    reversed |= ((codeword >> bit) & 1) << (length - 1 - bit);
+                }
+                for (uint32_t fill = reversed; fill < (1u << FastBits); fill += 1u << length) {
+                    fast[fill] = static_cast<uint16_t>((symbol << 4) | length);
+                }
+            }
+            ++nextCode[length];
+        }
+        return true;
+    }
+
+    int Decode(LsbBitReader& reader) const {
+        const uint32_t bits = reader.Peek(15);
+        const uint16_t entry = fast[bits & ((1u << FastBits) - 1)];
+        if (entry != 0) {
+            reader.Consume(entry & 15);
+            return entry >> 4;
+        }
+        int32_t code = 0;
+        int32_t first = 0;
+        int32_t index = 0;
+        for (uint32_t length = 1; length < 16; ++length) {
+            code |= static_cast<int32_t>((bits >> (length - 1)) & 1);
+            const int32_t count = counts[length];
+            if (code - count < first) {
+                reader.Consume(length);
+                return symbols[static_cast<size_t>(index + code - first)];
+            }
+            index += count;
+            first = (first + count) << 1;
+            code <<= 1;
+        }
+        return -1;
+    }
+};
+
+constexpr uint16_t LengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                      35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+constexpr uint8_t LengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                      3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+constexpr uint16_t DistanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+constexpr uint8_t DistanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+bool InflateBlock(LsbBitReader& reader, const InflateTable& literals, const InflateTable& distances,
+                  std::vector<uint8_t>& output, size_t start) {
+    for (;;) {
+        const int symbol = literals.Decode(reader);
+        if (symbol < 0 || reader.IsOverrun()) {
+            return false;
+        }
+        if (symbol < 256) {
+            output.push_back(static_cast<uint8_t>(symbol));
+            continue;
+        }
+        if (symbol == 256) {
+            return true;
+        }
+        const int lengthSymbol = symbol - 257;
+        if (lengthSymbol >= 29) {
+            return false;
+        }
+        const uint32_t length = LengthBase[lengthSymbol] + reader.Read(LengthExtra[lengthSymbol]);
+        const int distanceSymbol = distances.Decode(reader);
+        if (distanceSymbol < 0 || distanceSymbol >= 30) {
+            return false;
+        }
+        const size_t distance = DistanceBase[distanceSymbol] + reader.Read(DistanceExtra[distanceSymbol]);
+        if (distance > output.size() - start) {
+            return false;
+        }
+        // 距离可能小于长度（重复模式），逐字节复制
+        size_t source = output.size() - distance;
+        for (uint32_t i = 0; i < length; ++i) {
+            output.push_back(output[source++]);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// PNG
+// ---------------------------------------------------------------------------
+
+uint8_t PaethPredictor(int a, int b, int c) {
+    const int p = a + b - c;
+    const int pa = std::abs(p - a);
+    const int pb = std::abs(p - b);
+    const int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return static_cast<uint8_t>(a);
+    }
+    return static_cast<uint8_t>(pb <= pc ? b : c);
+}
+
+/**
+ * @brief 还原一行的滤波，previous为上一行（第一行时全为0）
+ */
+bool UnfilterRow(uint8_t filter, uint8_t* row, const uint8_t* previous, size_t rowBytes, size_t pixelBytes) {
+    switch (filter) {
+    case 0:
+        return true;
+    case 1:
+        for (size_t i = pixelBytes; i < rowBytes; ++i) {
+            row[i] = static_cast<uint8_t>(row[i] + row[i - pixelBytes]);
+        }
+        return true;
+    case 2:
+        for (size_t i = 0; i < rowBytes; ++i) {
+            row[i] = static_cast<uint8_t>(row[i] + previous[i]);
+        }
+        return true;
+    case 3:
+        for (size_t i = 0; i < rowBytes; ++i) {
+            const int left = i >= pixelBytes ? row[i - pixelBytes] : 0;
+            row[i] = static_cast<uint8_t>(row[i] + ((left + previous[i]) >> 1));
+        }
+        return true;
+    case 4:
+        for (size_t i = 0; i < rowBytes; ++i) {
+            const int left = i >= pixelBytes ? row[i - pixelBytes] : 0;
+            const int upperLeft = i >= pixelBytes ? previous[i - pixelBytes] : 0;
+            row[i] = static_cast<uint8_t>(row[i] + PaethPredictor(left, previous[i], upperLeft));
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+struct PngInfo {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t bitDepth = 0;
+    uint32_t colorType = 0;
+    uint32_t channels = 0;
+    std::array<uint8_t, 256 * 4> palette;
+    uint32_t paletteSize = 0;
+    bool hasColorKey = false;
+    uint32_t colorKey[3] = { 0, 0, 0 };
+};
+
+/**
+ * @brief 把一行解滤波后的数据转换为RGBA8，写入像素(x0 + i * dx, y)
+ */
+void ConvertPngRow(const PngInfo& info, const uint8_t* row, uint32_t count, uint8_t* pixels, uint32_t y,
+                   uint32_t x0, uint32_t dx) {
+    const uint32_t depth = info.bitDepth;
+    const uint32_t maximum = (1u << depth) - 1;
+    auto sample = [&](uint32_t index, uint32_t channel) -> uint32_t {
+        const uint32_t position = index * info.channels + channel;
+        if (depth == 8) {
+            return row[position];
+        }
+        if (depth == 16) {
+            return ReadBigEndian16(row + position * 2);
+        }
+        const uint32_t bit = position * depth;
+        return (row[bit / 8] >> (8 - depth - bit % 8)) & maximum;
+    };
+    auto to8 = [&](uint32_t value) -> uint8_t {
+        if (depth == 16) {
+            return static_cast<uint8_t>(value >> 8);
+        }
+        return static_cast<uint8_t>(depth == 8 ? value : value * 255 / maximum);
+    };
+
+    for (uint32_t i = 0; i < count; ++i) {
+        uint8_t* pixel = pixels + (static_cast<size_t>(y) * info.width + x0 + i * dx) * 4;
+        switch (info.colorType) {
+        case 0: {
+            const uint32_t gray = sample(i, 0);
+            pixel[0] = pixel[1] = pixel[2] = to8(gray);
+            pixel[3] = info.hasColorKey && gray == info.colorKey[0] ? 0 : 255;
+            break;
+        }
+        case 2: {
+            const uint32_t r = sample(i, 0);
+            const uint32_t g = sample(i, 1);
+            const uint32_t b = sample(i, 2);
+            pixel[0] = to8(r);
+            pixel[1] = to8(g);
+            pixel[2] = to8(b);
+            pixel[3] = info.hasColorKey && r == info.colorKey[0] && g == info.colorKey[1] && b == info.colorKey[2] ? 0 : 255;
+            break;
+        }
+        case 3: {
+            // 越界的索引按黑色处理
+            const uint32_t index = sample(i, 0);
+            if (index < info.paletteSize) {
+                std::memcpy(pixel, &info.palette[index * 4], 4);
+            } else {
+                pixel[0] = pixel[1] = pixel[2] = 0;
+                pixel[3] = 255;
+            }
+            break;
+        }
+        case 4:
+            pixel[0] = pixel[1] = pixel[2] = to8(sample(i, 0));
+            pixel[3] = to8(sample(i, 1));
+            break;
+        default:
+            pixel[0] = to8(sample(i, 0));
+            pixel[1] = to8(sample(i, 1));
+            pixel[2] = to8(sample(i, 2));
+            pixel[3] = to8(sample(i, 3));
+            break;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// TGA
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief 把一个TGA像素（或颜色表项）转换为RGBA8
+ */
+void ConvertTgaPixel(const uint8_t* source, uint32_t bits, bool gray, bool useAlphaBit, uint8_t* pixel) {
+    switch (bits) {
+    case 8:
+        pixel[0] = pixel[1] = pixel[2] = source[0];
+        pixel[3] = 255;
+        break;
+    case 15:
+    case 16: {
+        if (gray) {
+            // 16位灰度：灰度加alpha
+            pixel[0] = pixel[1] = pixel[2] = source[0];
+            pixel[3] = source[1];
+            break;
+        }
+        const uint32_t value = ReadLittleEndian16(source);
+        pixel[0] = static_cast<uint8_t>(((value >> 10) & 31) * 255 / 31);
+        pixel[1] = static_cast<uint8_t>(((value >> 5) & 31) * 255 / 31);
+        pixel[2] = static_cast<uint8_t>((value & 31) * 255 / 31);
+        pixel[3] = useAlphaBit && bits == 16 && !(value & 0x8000) ? 0 : 255;
+        break;
+    }
+    case 24:
+        pixel[0] = source[2];
+        pixel[1] = source[1];
+        pixel[2] = source[0];
+        pixel[3] = 255;
+        break;
+    default:
+        pixel[0] = source[2];
+        pixel[1] = source[1];
+        pixel[2] = source[0];
+        pixel[3] = source[3];
+        break;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// JPEG
+// ---------------------------------------------------------------------------
+
+constexpr uint8_t JpegZigZag[64] = {
+    0, 1, 8, 16, 9, 2, 3, 10, 17, 24, 32, 25, 18, 11, 4, 5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6, 7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+/**
+ * @brief 高位在前的熵编码数据读取器，处理0xFF00填充字节，遇到标记时停止并补0
+ */
+class JpegBitReader {
+public:
+    JpegBitReader(const uint8_t* data, size_t size, size_t position) : m_Data(data), m_Size(size), m_Position(position) {}
+
+    void Fill() {
+        while (m_Count <= 24) {
+            uint32_t byte = 0;
+            if (m_Marker == 0 && m_Position < m_Size) {
+                byte = m_Data[m_Position];
+                if (byte == 0xFF) {
+                    const uint32_t next = m_Position + 1 < m_Size ? m_Data[m_Position + 1] : 0xD9;
+                    if (next == 0) {
+                        m_Position += 2;
+                    } else {
+                        m_Marker = next;
+                        byte = 0;
+                    }
+                } else {
+                    ++m_Position;
+                }
+            }
+            m_Buffer |= byte << (24 - m_Count);
+            m_Count += 8;
+        }
+    }
+
+    uint32_t GetBits(uint32_t count) {
+        if (count == 0) {
+            return 0;
+        }
+        Fill();
+        const uint32_t value = m_Buffer >> (32 - count);
+        Consume(count);
+        return value;
+    }
+
+    void Consume(uint32_t count) {
+        m_Buffer <<= count;
+        m_Count -= count;
+    }
+
+    uint32_t PeekBuffer() {
+        Fill();
+        return m_Buffer;
+    }
+
+    uint32_t GetCount() const { return m_Count; }
+
+    /**
+     * @brief 处理重启标记：丢弃缓冲的位，跳过RSTn
+     */
+    bool Restart() {
+        m_Buffer = 0;
+        m_Count = 0;
+        if (m_Marker == 0) {
+            while (m_Position + 1 < m_Size && !(m_Data[m_Position] == 0xFF && m_Data[m_Position + 1] != 0 &&
+                                                 m_Data[m_Position + 1] != 0xFF)) {
+                ++m_Position;
+            }
+            if (m_Position + 1 >= m_Size) {
+                return false;
+            }
+            m_Marker = m_Data[m_Position + 1];
+        }
+        if (m_Marker < 0xD0 || m_Marker > 0xD7) {
+            return false;
+        }
+        m_Position += 2;
+        m_Marker = 0;
+        return true;
+    }
+
+    /**
+     * @brief 扫描结束后下一个标记的位置
+     */
+    size_t FindNextMarker() const {
+        size_t position = m_Position;
+        while (position + 1 < m_Size && !(m_Data[position] == 0xFF && m_Data[position + 1] != 0 &&
+                                           m_Data[position + 1] != 0xFF && (m_Data[position + 1] < 0xD0 || m_Data[position + 1] > 0xD7))) {
+            ++position;
+        }
+        return position;
+    }
+
+private:
+    const uint8_t* m_Data;
+    size_t m_Size;
+    size_t m_Position;
+    uint32_t m_Buffer = 0;
+    uint32_t m_Count = 0;
+    uint32_t m_Marker = 0;
+};
+
+struct JpegHuffman {
+    static constexpr uint32_t FastBits = 9;
+
+    std::array<uint8_t, 1u << FastBits> fast;   // 码长不超过FastBits的码字 -> 序号，255表示需要慢速路径
+    std::array<uint8_t, 256> values;
+    std::array<uint8_t, 257> sizes;
+    std::array<uint32_t, 18> maxCode;           // 左对齐到16位的每个码长的上界
+    std::array<int32_t, 17> delta;              // 码字到序号的偏移
+    bool valid = false;
+
+    bool Build(const uint8_t* counts, const uint8_t* symbols, uint32_t symbolCount) {
+        uint32_t k = 0;
+        for (uint32_t length = 1; length <= 16; ++length) {
+            for (uint32_t i = 0; i < counts[length - 1]; ++i) {
+                sizes[k++] = static_cast<uint8_t>(length);
+            }
+        }
+        sizes[k] = 0;
+        std::memcpy(values.data(), symbols, symbolCount);
+
+        std::array<uint16_t, 256> codes;
+        uint32_t code = 0;
+        k = 0;
+        for (uint32_t length = 1; length <= 16; ++length) {
+            delta[length] = static_cast<int32_t>(k) - static_cast<int32_t>(code);
+            while (sizes[k] == length) {
+                codes[k++] = static_cast<uint16_t>(code++);
+            }
+            if (code > (1u << length)) {
+                return false;
+            }
+            maxCode[length] = code << (16 - length);
+            code <<= 1;
+        }
+        maxCode[17] = 0xFFFFFFFF;
+
+        fast.fill(255);
+        for (uint32_t i = 0; i < k; ++i) {
+            const uint32_t length = sizes[i];
+            if (length <= FastBits) {
+                const uint32_t first = static_cast<uint32_t>(codes[i]) << (FastBits - length);
+                for (uint32_t j = 0; j < (1u << (FastBits - length)); ++j) {
+                    fast[first + j] = static_cast<uint8_t>(i);
+                }
+            }
+        }
+        valid = true;
+        return true;
+    }
+
+    int Decode(JpegBitReader& reader) const {
+        const uint32_t buffer = reader.PeekBuffer();
+        const uint32_t index = fast[buffer >> (32 - FastBits)];
+        if (index != 255) {
+            reader.Consume(sizes[index]);
+            return values[index];
+        }
+        const uint32_t top = buffer >> 16;
+        uint32_t length = FastBits + 1;
+        while (top >= maxCode[length]) {
+            ++length;
+        }
+        if (length == 17) {
+            return -1;
+        }
+        const int32_t code = static_cast<int32_t>(buffer >> (32 - length)) + delta[length];
+        if (code < 0 || code > 255) {
+            return -1;
+        }
+        reader.Consume(length);
+        return values[static_cast<size_t>(code)];
+    }
+};
+
+struct JpegComponent {
+    uint32_t id = 0;
+    uint32_t h = 1;
+    uint32_t v = 1;
+    uint32_t quantTable = 0;
+    uint32_t dcTable = 0;
+    uint32_t acTable = 0;
+    int32_t dcPrediction = 0;
+    uint32_t stride = 0;
+    std::vector<uint8_t> plane;
+};
+
+struct JpegDecoder {
+    std::array<std::array<uint16_t, 64>, 4> quant;
+    std::array<JpegHuffman, 4> dcTables;
+    std::array<JpegHuffman, 4> acTables;
+    std::vector<JpegComponent> components;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t maxH = 1;
+    uint32_t maxV = 1;
+    uint32_t mcuX = 0;
+    uint32_t mcuY = 0;
+    uint32_t restartInterval = 0;
+    bool hasFrame = false;
+    bool decodedScan = false;
+    int adobeTransform = -1;
+    float idct[8][8];
+
+    JpegDecoder() {
+        for (auto& table : quant) {
+            table.fill(1);
+        }
+        // idct[x][u] = C(u) / 2 * cos((2x + 1)uπ / 16)
+        const float pi = 3.14159265358979f;
+        for (int x = 0; x < 8; ++x) {
+            for (int u = 0; u < 8; ++u) {
+                const float scale = u == 0 ? 0.353553391f : 0.5f;
+                idct[x][u] = scale * std::cos((2.0f * x + 1.0f) * u * pi / 16.0f);
+            }
+        }
+    }
+
+    static int32_t Extend(uint32_t value, uint32_t bits) {
+        if (bits == 0) {
+            return 0;
+        }
+        return value < (1u << (bits - 1)) ? static_cast<int32_t>(value) - static_cast<int32_t>((1u << bits) - 1)
+                                           : static_cast<int32_t>(value);
+    }
+
+    bool DecodeBlock(JpegBitReader& reader, JpegComponent& component, uint32_t blockX, uint32_t blockY) {
+        const JpegHuffman& dc = dcTables[component.dcTable];
+        const JpegHuffman& ac = acTables[component.acTable];
+        const std::array<uint16_t, 64>& table = quant[component.quantTable];
+
+        float coefficients[64] = {};
+        const int t = dc.Decode(reader);
+        if (t < 0 || t > 16) {
+            return false;
+        }
+        component.dcPrediction += Extend(reader.GetBits(static_cast<uint32_t>(t)), static_cast<uint32_t>(t));
+        coefficients[0] = static_cast<float>(component.dcPrediction * table[0]);
+
+        for (uint32_t k = 1; k < 64;) {
+            const int rs = ac.Decode(reader);
+            if (rs < 0) {
+                return false;
+            }
+            const uint32_t run = static_cast<uint32_t>(rs) >> 4;
+            const uint32_t size = static_cast<uint32_t>(rs) & 15;
+            if (size == 0) {
+                if (run != 15) {
+                    break;
+                }
+                k += 16;
+                continue;
+            }
+            k += run;
+            if (k > 63) {
+                return false;
+            }
+            coefficients[JpegZigZag[k]] = static_cast<float>(Extend(reader.GetBits(size), size) * table[k]);
+            ++k;
+        }
+
+        // 可分离的逆DCT：先按行，再按列
+        float rows[64];
+        for (int v = 0; v < 8; ++v) {
+            for (int x = 0; x < 8; ++x) {
+                float sum = 0.0f;
+                for (int u = 0; u < 8; ++u) {
+                    sum += coefficients[v * 8 + u] * idct[x][u];
+                }
+                rows[v * 8 + x] = sum;
+            }
+        }
+        uint8_t* output = component.plane.data() + static_cast<size_t>(blockY) * 8 * component.stride + blockX * 8;
+        for (int y = 0; y < 8; ++y) {
+            for (int x = 0; x < 8; ++x) {
+                float sum = 128.0f;
+                for (int v = 0; v < 8; ++v) {
+                    sum += rows[v * 8 + x] * idct[y][v];
+                }
+                output[y * component.stride + x] = static_cast<uint8_t>(std::min(std::max(std::lround(sum), 0l), 255l));
+            }
+        }
+        return true;
+    }
+
+    bool ParseFrame(const uint8_t* segment, size_t length) {
+        if (hasFrame || length < 6 || segment[0] != 8) {
+            return false;
+        }
+        height = ReadBigEndian16(segment + 1);
+        width = ReadBigEndian16(segment + 3);
+        const uint32_t count = segment[5];
+        if (!IsValidDimension(width, height) || (count != 1 && count != 3) || length < 6 + count * 3) {
+            return false;
+        }
+        components.resize(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            JpegComponent& component = components[i];
+            component.id = segment[6 + i * 3];
+            component.h = segment[7 + i * 3] >> 4;
+            component.v = segment[7 + i * 3] & 15;
+            component.quantTable = segment[8 + i * 3];
+            if (component.h < 1 || component.h > 4 || component.v < 1 || component.v > 4 || component.quantTable > 3) {
+                return false;
+            }
+            maxH = std::max(maxH, component.h);
+            maxV = std::max(maxV, component.v);
+        }
+        mcuX = (width + 8 * maxH - 1) / (8 * maxH);
+        mcuY = (height + 8 * maxV - 1) / (8 * maxV);
+        for (JpegComponent& component : components) {
+            component.stride = mcuX * component.h * 8;
+            component.plane.assign(static_cast<size_t>(component.stride) * mcuY * component.v * 8, 0);
+        }
+        hasFrame = true;
+        return true;
+    }
+
+    bool ParseHuffman(const uint8_t* segment, size_t length) {
+        size_t position = 0;
+        while (position < length) {
+            if (length - position < 17) {
+                return false;
+            }
+            const uint32_t tableClass = segment[position] >> 4;
+            const uint32_t tableIndex = segment[position] & 15;
+            const uint8_t* counts = segment + position + 1;
+            uint32_t total = 0;
+            for (int i = 0; i < 16; ++i) {
+                total += counts[i];
+            }
+            position += 17;
+            if (tableClass > 1 || tableIndex > 3 || total > 256 || length - position < total) {
+                return false;
+            }
+            JpegHuffman& table = tableClass == 0 ? dcTables[tableIndex] : acTables[tableIndex];
+            if (!table.Build(counts, segment + position, total)) {
+                return false;
+            }
+            position += total;
+        }
+        return true;
+    }
+
+    bool ParseQuantization(const uint8_t* segment, size_t length) {
+        size_t position = 0;
+        while (position < length) {
+            const uint32_t precision = segment[position] >> 4;
+            const uint32_t tableIndex = segment[position] & 15;
+            const size_t tableSize = precision ? 128 : 64;
+            ++position;
+            if (precision > 1 || tableIndex > 3 || length - position < tableSize) {
+                return false;
+            }
+            for (uint32_t k = 0; k < 64; ++k) {
+                quant[tableIndex][k] = static_cast<uint16_t>(precision ? ReadBigEndian16(segment + position + k * 2)
+                                                                       : segment[position + k]);
+            }
+            position += tableSize;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 解码一个扫描，返回扫描之后的位置，失败时返回0
+     */
+    size_t DecodeScan(const uint8_t* data, size_t size, const uint8_t* segment, size_t length, size_t entropyStart) {
+        if (!hasFrame || length < 1) {
+            return 0;
+        }
+        const uint32_t count = segment[0];
+        if (count < 1 || count > components.size() || length < 1 + count * 2 + 3) {
+            return 0;
+        }
+        std::vector<JpegComponent*> scan;
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint32_t id = segment[1 + i * 2];
+            auto it = std::find_if(components.begin(), components.end(),
+                                   [id](const JpegComponent& component) { return component.id == id; });
+            if (it == components.end()) {
+                return 0;
+            }
+            it->dcTable = segment[2 + i * 2] >> 4;
+            it->acTable = segment[2 + i * 2] & 15;
+            if (it->dcTable > 3 || it->acTable > 3 || !dcTables[it->dcTable].valid || !acTables[it->acTable].valid) {
+                return 0;
+            }
+            it->dcPrediction = 0;
+            scan.push_back(&*it);
+        }
+        const uint8_t* selection = segment + 1 + count * 2;
+        if (selection[0] != 0 || selection[1] != 63 || selection[2] != 0) {
+            return 0;
+        }
+
+        JpegBitReader reader(data, size, entropyStart);
+        uint32_t untilRestart = restartInterval;
+        auto handleRestart = [&](bool last) {
+            if (restartInterval == 0 || last || --untilRestart > 0) {
+                return true;
+            }
+            untilRestart = restartInterval;
+            for (JpegComponent* component : scan) {
+                component->dcPrediction = 0;
+            }
+            return reader.Restart();
+        };
+
+        if (scan.size() == 1) {
+            // 非交错扫描：按分量自身的块网格逐块解码
+            JpegComponent& component = *scan[0];
+            const uint32_t blocksX = ((width * component.h + maxH - 1) / maxH + 7) / 8;
+            const uint32_t blocksY = ((height * component.v + maxV - 1) / maxV + 7) / 8;
+            for (uint32_t by = 0; by < blocksY; ++by) {
+                for (uint32_t bx = 0; bx < blocksX; ++bx) {
+                    if (!DecodeBlock(reader, component, bx, by) ||
+                        !handleRestart(by + 1 == blocksY && bx + 1 == blocksX)) {
+                        return 0;
+                    }
+                }
+            }
+        } else {
+            for (uint32_t my = 0; my < mcuY; ++my) {
+                for (uint32_t mx = 0; mx < mcuX; ++mx) {
+                    for (JpegComponent* component : scan) {
+                        for (uint32_t by = 0; by < component->v; ++by) {
+                            for (uint32_t bx = 0; bx < component->h; ++bx) {
+                                if (!DecodeBlock(reader, *component, mx * component->h + bx, my * component->v + by)) {
+                                    return 0;
+                                }
+                            }
+                        }
+                    }
+                    if (!handleRestart(my + 1 == mcuY && mx + 1 == mcuX)) {
+                        return 0;
+                    }
+                }
+            }
+        }
+        decodedScan = true;
+        return reader.FindNextMarker();
+    }
+
+    void Output(std::vector<uint8_t>& pixels) const {
+        pixels.resize(static_cast<size_t>(width) * height * 4);
+        // 色度按最近邻上采样
+        for (uint32_t y = 0; y < height; ++y) {
+            const uint8_t* rows[3] = {};
+            for (size_t c = 0; c < components.size(); ++c) {
+                const JpegComponent& component = components[c];
+                rows[c] = component.plane.data() + static_cast<size_t>(y * component.v / maxV) * component.stride;
+            }
+            uint8_t* output = pixels.data() + static_cast<size_t>(y) * width * 4;
+            for (uint32_t x = 0; x < width; ++x, output += 4) {
+                if (components.size() == 1) {
+                    output[0] = output[1] = output[2] = rows[0][x];
+                    output[3] = 255;
+                    continue;
+                }
+                const int c0 = rows[0][x * components[0].h / maxH];
+                const int c1 = rows[1][x * components[1].h / maxH];
+                const int c2 = rows[2][x * components[2].h / maxH];
+                if (adobeTransform == 0) {
+                    output[0] = static_cast<uint8_t>(c0);
+                    output[1] = static_cast<uint8_t>(c1);
+                    output[2] = static_cast<uint8_t>(c2);
+                } else {
+                    // YCbCr -> RGB（JFIF），16位定点
+                    const int cb = c1 - 128;
+                    const int cr = c2 - 128;
+                    const int r = c0 + ((91881 * cr + 32768) >> 16);
+                    const int g = c0 - ((22554 * cb + 46802 * cr - 32768) >> 16);
+                    const int b = c0 + ((116130 * cb + 32768) >> 16);
+                    output[0] = static_cast<uint8_t>(std::min(std::max(r, 0), 255));
+                    output[1] = static_cast<uint8_t>(std::min(std::max(g, 0), 255));
+                    output[2] = static_cast<uint8_t>(std::min(std::max(b, 0), 255));
+                }
+                output[3] = 255;
+            }
+        }
+    }
+};
+
+} // namespace
+
+bool ImageDecoder::Decode(const uint8_t* data, size_t size, uint32_t& width, uint32_t& height, std::vector<uint8_t>& pixels) {
+    if (!data || size < 4) {
+        std::cerr << "图像数据为空！" << std::endl;
+        return false;
+    }
+    if (data[0] == 0x89 && data[1] == 'P' && data[2] == 'N' && data[3] == 'G') {
+        return DecodePng(data, size, width, height, pixels);
+    }
+    if (data[0] == 0xFF && data[1] == 0xD8) {
+        return DecodeJpeg(data, size, width, height, pixels);
+    }
+    // TGA没有魔数，最后按TGA尝试
+    return DecodeTga(data, size, width, height, pixels);
+}
+
+bool ImageDecoder::Inflate(const uint8_t* data, size_t size, std::vector<uint8_t>& output) {
+    if (size < 2 || (data[0] & 15) != 8 || ((data[0] << 8) | data[1]) % 31 != 0 || (data[1] & 0x20)) {
+        return false;
+    }
+    LsbBitReader reader(data + 2, size - 2);
+    const size_t start = output.size();
+    InflateTable literals;
+    InflateTable distances;
+
+    bool last = false;
+    while (!last) {
+        last = reader.Read(1) != 0;
+        const uint32_t type = reader.Read(2);
+        if (type == 0) {
+            reader.AlignToByte();
+            const uint32_t length = reader.Read(16);
+            const uint32_t inverse = reader.Read(16);
+            if ((length ^ 0xFFFF) != inverse) {
+                return false;
+            }
+            for (uint32_t i = 0; i < length; ++i) {
+                output.push_back(static_cast<uint8_t>(reader.Read(8)));
+            }
+            if (reader.IsOverrun()) {
+                return false;
+            }
+        } else if (type == 1) {
+            uint8_t lengths[288 + 30];
+            std::fill(lengths, lengths + 144, 8);
+            std::fill(lengths + 144, lengths + 256, 9);
+            std::fill(lengths + 256, lengths + 280, 7);
+            std::fill(lengths + 280, lengths + 288, 8);
+            std::fill(lengths + 288, lengths + 318, 5);
+            literals.Build(lengths, 288);
+            distances.Build(lengths + 288, 30);
+            if (!InflateBlock(reader, literals, distances, output, start)) {
+                return false;
+            }
+        } else if (type == 2) {
+            const uint32_t literalCount = reader.Read(5) + 257;
+            const uint32_t distanceCount = reader.Read(5) + 1;
+            const uint32_t codeLengthCount = reader.Read(4) + 4;
+            static const uint8_t order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+            uint8_t codeLengths[19] = {};
+            for (uint32_t i = 0; i < codeLengthCount; ++i) {
+                codeLengths[order[i]] = static_cast<uint8_t>(reader.Read(3));
+            }
+            InflateTable codeLengthTable;
+            if (literalCount > 286 || distanceCount > 30 || !codeLengthTable.Build(codeLengths, 19)) {
+                return false;
+            }
+
+            uint8_t lengths[286 + 30] = {};
+            uint32_t count = 0;
+            while (count < literalCount + distanceCount) {
+                const int symbol = codeLengthTable.Decode(reader);
+                if (symbol < 0 || reader.IsOverrun()) {
+                    return false;
+                }
+                if (symbol < 16) {
+                    lengths[count++] = static_cast<uint8_t>(symbol);
+                    continue;
+                }
+                uint8_t value = 0;
+                uint32_t repeat = 0;
+                if (symbol == 16) {
+                    if (count == 0) {
+                        return false;
+                    }
+                    value = lengths[count - 1];
+                    repeat = 3 + reader.Read(2);
+                } else if (symbol == 17) {
+                    repeat = 3 + reader.Read(3);
+                } else {
+                    repeat = 11 + reader.Read(7);
+                }
+                if (count + repeat > literalCount + distanceCount) {
+                    return false;
+                }
+                std::fill(lengths + count, lengths + count + repeat, value);
+                count += repeat;
+            }
+            if (lengths[256] == 0 || !literals.Build(lengths, literalCount) ||
+                !distances.Build(lengths + literalCount, distanceCount) ||
+                !InflateBlock(reader, literals, distances, output, start)) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    return !reader.IsOverrun();
+}
+
+bool ImageDecoder::DecodePng(const uint8_t* data, size_t size, uint32_t& width, uint32_t& height, std::vector<uint8_t>& pixels) {
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+    if (size < 8 || std::memcmp(data, signature, 8) != 0) {
+        std::cerr << "不是PNG文件！" << std::endl;
+        return false;
+    }
+
+    PngInfo info;
+    uint32_t interlace = 0;
+    bool hasHeader = false;
+    std::vector<uint8_t> compressed;
+    size_t position = 8;
+    for (;;) {
+        if (size - position < 12) {
+            std::cerr << "PNG数据不完整！" << std::endl;
+            return false;
+        }
+        const uint32_t length = ReadBigEndian32(data + position);
+        const uint8_t* type = data + position + 4;
+        const uint8_t* chunk = data + position + 8;
+        if (length > size - position - 12) {
+            std::cerr << "PNG数据不完整！" << std::endl;
+            return false;
+        }
+        position += 12 + static_cast<size_t>(length);
+
+        if (std::memcmp(type, "IHDR", 4) == 0) {
+            if (length < 13) {
+                return false;
+            }
+            info.width = ReadBigEndian32(chunk);
+            info.height = ReadBigEndian32(chunk + 4);
+            info.bitDepth = chunk[8];
+            info.colorType = chunk[9];
+            interlace = chunk[12];
+            static const uint32_t channels[7] = { 1, 0, 3, 1, 2, 0, 4 };
+            info.channels = info.colorType < 7 ? channels[info.colorType] : 0;
+            const uint32_t depth = info.bitDepth;
+            const bool validDepth = depth == 8 || (depth == 16 && info.colorType != 3) ||
+                                    ((depth == 1 || depth == 2 || depth == 4) && (info.colorType == 0 || info.colorType == 3));
+            if (info.channels == 0 || !validDepth || chunk[10] != 0 || chunk[11] != 0 || interlace > 1 ||
+                !IsValidDimension(info.width, info.height)) {
+                std::cerr << "不支持的PNG格式！" << std::endl;
+                return false;
+            }
+            hasHeader = true;
+        } else if (std::memcmp(type, "PLTE", 4) == 0) {
+            info.paletteSize = std::min(length / 3, 256u);
+            for (uint32_t i = 0; i < info.paletteSize; ++i) {
+                info.palette[i * 4 + 0] = chunk[i * 3 + 0];
+                info.palette[i * 4 + 1] = chunk[i * 3 + 1];
+                info.palette[i * 4 + 2] = chunk[i * 3 + 2];
+                info.palette[i * 4 + 3] = 255;
+            }
+        } else if (std::memcmp(type, "tRNS", 4) == 0) {
+            if (info.colorType == 3) {
+                for (uint32_t i = 0; i < std::min(length, info.paletteSize); ++i) {
+                    info.palette[i * 4 + 3] = chunk[i];
+                }
+            } else if (info.colorType == 0 && length >= 2) {
+                info.hasColorKey = true;
+                info.colorKey[0] = ReadBigEndian16(chunk);
+            } else if (info.colorType == 2 && length >= 6) {
+                info.hasColorKey = true;
+                for (int i = 0; i < 3; ++i) {
+                    info.colorKey[i] = ReadBigEndian16(chunk + i * 2);
+                }
+            }
+        } else if (std::memcmp(type, "IDAT", 4) == 0) {
+            compressed.insert(compressed.end(), chunk, chunk + length);
+        } else if (std::memcmp(type, "IEND", 4) == 0) {
+            break;
+        } else if (!(type[0] & 0x20)) {
+            // 关键块（首字母大写）不认识时无法正确解码
+            std::cerr << "不支持的PNG关键块！" << std::endl;
+            return false;
+        }
+    }
+    if (!hasHeader || (info.colorType == 3 && info.paletteSize == 0)) {
+        std::cerr << "PNG数据不完整！" << std::endl;
+        return false;
+    }
+
+    const size_t bitsPerPixel = static_cast<size_t>(info.channels) * info.bitDepth;
+    const size_t pixelBytes = std::max<size_t>(bitsPerPixel / 8, 1);
+    std::vector<uint8_t> raw;
+    raw.reserve(static_cast<size_t>(info.height) * ((info.width * bitsPerPixel + 7) / 8 + 1));
+    if (!Inflate(compressed.data(), compressed.size(), raw)) {
+        std::cerr << "PNG数据解压失败！" << std::endl;
+        return false;
+    }
+
+    pixels.assign(static_cast<size_t>(info.width) * info.height * 4, 0);
+    static const uint32_t passStartX[7] = { 0, 4, 0, 2, 0, 1, 0 };
+    static const uint32_t passStartY[7] = { 0, 0, 4, 0, 2, 0, 1 };
+    static const uint32_t passStepX[7] = { 8, 8, 4, 4, 2, 2, 1 };
+    static const uint32_t passStepY[7] = { 8, 8, 8, 4, 4, 2, 2 };
+    const uint32_t passCount = interlace ? 7 : 1;
+
+    size_t offset = 0;
+    std::vector<uint8_t> previous;
+    for (uint32_t pass = 0; pass < passCount; ++pass) {
+        const uint32_t x0 = interlace ? passStartX[pass] : 0;
+        const uint32_t y0 = interlace ? passStartY[pass] : 0;
+        const uint32_t dx = interlace ? passStepX[pass] : 1;
+        const uint32_t dy = interlace ? passStepY[pass] : 1;
+        if (x0 >= info.width || y0 >= info.height) {
+            continue;
+        }
+        const uint32_t passWidth = (info.width - x0 + dx - 1) / dx;
+        const uint32_t passHeight = (info.height - y0 + dy - 1) / dy;
+        const size_t rowBytes = (passWidth * bitsPerPixel + 7) / 8;
+        if (raw.size() - offset < passHeight * (rowBytes + 1)) {
+            std::cerr << "PNG数据不完整！" << std::endl;
+            return false;
+        }
+
+        previous.assign(rowBytes, 0);
+        for (uint32_t row = 0; row < passHeight; ++row) {
+            const uint8_t filter = raw[offset];
+            uint8_t* current = raw.data() + offset + 1;
+            if (!UnfilterRow(filter, current, previous.data(), rowBytes, pixelBytes)) {
+                std::cerr << "PNG滤波类型无效！" << std::endl;
+                return false;
+            }
+            ConvertPngRow(info, current, passWidth, pixels.data(), y0 + row * dy, x0, dx);
+            std::memcpy(previous.data(), current, rowBytes);
+            offset += rowBytes + 1;
+        }
+    }
+
+    width = info.width;
+    height = info.height;
+    return true;
+}
+
+bool ImageDecoder::DecodeTga(const uint8_t* data, size_t size, uint32_t& width, uint32_t& height, std::vector<uint8_t>& pixels) {
+    if (size < 18) {
+        std::cerr << "TGA数据不完整！" << std::endl;
+        return false;
+    }
+    const uint32_t idLength = data[0];
+    const uint32_t colorMapType = data[1];
+    const uint32_t imageType = data[2];
+    const uint32_t colorMapFirst = ReadLittleEndian16(data + 3);
+    const uint32_t colorMapLength = ReadLittleEndian16(data + 5);
+    const uint32_t colorMapBits = data[7];
+    const uint32_t imageWidth = ReadLittleEndian16(data + 12);
+    const uint32_t imageHeight = ReadLittleEndian16(data + 14);
+    const uint32_t pixelBits = data[16];
+    const uint32_t descriptor = data[17];
+
+    const uint32_t baseType = imageType & 7;
+    const bool rle = (imageType & 8) != 0;
+    const bool mapped = baseType == 1;
+    const bool gray = baseType == 3;
+    const bool validType = (baseType >= 1 && baseType <= 3) && (imageType & ~11u) == 0;
+    const bool validBits = mapped ? (pixelBits == 8 || pixelBits == 16) && colorMapType == 1
+                                  : gray ? (pixelBits == 8 || pixelBits == 16)
+                                         : (pixelBits == 15 || pixelBits == 16 || pixelBits == 24 || pixelBits == 32);
+    if (!validType || !validBits || !IsValidDimension(imageWidth, imageHeight) ||
+        (mapped && colorMapBits != 15 && colorMapBits != 16 && colorMapBits != 24 && colorMapBits != 32)) {
+        std::cerr << "不支持的TGA格式！" << std::endl;
+        return false;
+    }
+    const bool useAlphaBit = (descriptor & 15) != 0;
+
+    size_t position = 18 + idLength;
+    std::vector<uint8_t> colorMap;
+    if (colorMapType == 1) {
+        const size_t entryBytes = (colorMapBits + 7) / 8;
+        const size_t mapBytes = entryBytes * colorMapLength;
+        if (position > size || size - position < mapBytes) {
+            std::cerr << "TGA数据不完整！" << std::endl;
+            return false;
+        }
+        if (mapped) {
+            colorMap.resize(static_cast<size_t>(colorMapLength) * 4);
+            for (uint32_t i = 0; i < colorMapLength; ++i) {
+                ConvertTgaPixel(data + position + i * entryBytes, colorMapBits, false, useAlphaBit, &colorMap[i * 4]);
+            }
+        }
+        position += mapBytes;
+    }
+
+    const size_t pixelBytes = (pixelBits + 7) / 8;
+    const size_t pixelCount = static_cast<size_t>(imageWidth) * imageHeight;
+    pixels.resize(pixelCount * 4);
+    auto convert = [&](const uint8_t* source, uint8_t* pixel) {
+        if (!mapped) {
+            ConvertTgaPixel(source, pixelBits, gray, useAlphaBit, pixel);
+            return;
+        }
+        const uint32_t index = (pixelBits == 8 ? source[0] : ReadLittleEndian16(source)) - colorMapFirst;
+        if (index < colorMapLength) {
+            std::memcpy(pixel, &colorMap[index * 4], 4);
+        } else {
+            pixel[0] = pixel[1] = pixel[2] = 0;
+            pixel[3] = 255;
+        }
+    };
+
+    size_t written = 0;
+    while (written < pixelCount) {
+        uint32_t count = 1;
+        bool repeat = false;
+        if (rle) {
+            if (position >= size) {
+                break;
+            }
+            const uint8_t header = data[position++];
+            count = (header & 0x7F) + 1u;
+            repeat = (header & 0x80) != 0;
+        } else {
+            count = static_cast<uint32_t>(pixelCount);
+        }
+        count = static_cast<uint32_t>(std::min<size_t>(count, pixelCount - written));
+        const size_t needed = repeat ? pixelBytes : pixelBytes * count;
+        if (position > size || size - position < needed) {
+            break;
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            convert(data + position + (repeat ? 0 : i * pixelBytes), &pixels[(written + i) * 4]);
+        }
+        position += needed;
+        written += count;
+    }
+    if (written < pixelCount) {
+        std::cerr << "TGA数据不完整！" << std::endl;
+        return false;
+    }
+
+    // 默认原点在左下角，统一输出为行从上到下
+    const bool flipY = (descriptor & 0x20) == 0;
+    const bool flipX = (descriptor & 0x10) != 0;
+    if (flipY) {
+        const size_t rowBytes = static_cast<size_t>(imageWidth) * 4;
+        for (uint32_t y = 0; y < imageHeight / 2; ++y) {
+            std::swap_ranges(pixels.begin() + y * rowBytes, pixels.begin() + (y + 1) * rowBytes,
+                             pixels.begin() + (imageHeight - 1 - y) * rowBytes);
+        }
+    }
+    if (flipX) {
+        uint32_t* pixel32 = reinterpret_cast<uint32_t*>(pixels.data());
+        for (uint32_t y = 0; y < imageHeight; ++y) {
+            std::reverse(pixel32 + static_cast<size_t>(y) * imageWidth, pixel32 + static_cast<size_t>(y + 1) * imageWidth);
+        }
+    }
+    width = imageWidth;
+    height = imageHeight;
+    return true;
+}
+
+bool ImageDecoder::DecodeJpeg(const uint8_t* data, size_t size, uint32_t& width, uint32_t& height, std::vector<uint8_t>& pixels) {
+    if (size < 4 || data[0] != 0xFF || data[1] != 0xD8) {
+        std::cerr << "不是JPEG文件！" << std::endl;
+        return false;
+    }
+    // 解码器包含几个KB的表和分量平面，放在堆上
+    auto decoder = std::make_unique<JpegDecoder>();
+    size_t position = 2;
+    while (position + 1 < size) {
+        if (data[position] != 0xFF) {
+            ++position;
+            continue;
+        }
+        const uint8_t marker = data[position + 1];
+        if (marker == 0xFF) {
+            ++position;
+            continue;
+        }
+        position += 2;
+        if (marker == 0xD9) {
+            break;
+        }
+        if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) {
+            continue;
+        }
+        if (size - position < 2) {
+            break;
+        }
+        const size_t length = ReadBigEndian16(data + position);
+        if (length < 2 || length > size - position) {
+            std::cerr << "JPEG数据不完整！" << std::endl;
+            return false;
+        }
+        const uint8_t* segment = data + position + 2;
+        const size_t segmentLength = length - 2;
+
+        bool ok = true;
+        switch (marker) {
+        case 0xC0:
+        case 0xC1:
+            ok = decoder->ParseFrame(segment, segmentLength);
+            break;
+        case 0xC4:
+            ok = decoder->ParseHuffman(segment, segmentLength);
+            break;
+        case 0xDB:
+            ok = decoder->ParseQuantization(segment, segmentLength);
+            break;
+        case 0xDD:
+            ok = segmentLength >= 2;
+            if (ok) {
+                decoder->restartInterval = ReadBigEndian16(segment);
+            }
+            break;
+        case 0xEE:
+            if (segmentLength >= 12 && std::memcmp(segment, "Adobe", 5) == 0) {
+                decoder->adobeTransform = segment[11];
+            }
+            break;
+        case 0xDA: {
+            const size_t next = decoder->DecodeScan(data, size, segment, segmentLength, position + length);
+            if (next == 0) {
+                std::cerr << "JPEG扫描数据解码失败！" << std::endl;
+                return false;
+            }
+            position = next;
+            continue;
+        }
+        default:
+            if ((marker >= 0xC2 && marker <= 0xC3) || (marker >= 0xC5 && marker <= 0xCF && marker != 0xC8 && marker != 0xCC)) {
+                std::cerr << "不支持的JPEG编码（仅支持基线和扩展顺序霍夫曼编码）！" << std::endl;
+                return false;
+            }
+            break;
+        }
+        if (!ok) {
+            std::cerr << "JPEG数据无效！" << std::endl;
+            return false;
+        }
+        position += length;
+    }
+
+    if (!decoder->decodedScan) {
+        std::cerr << "JPEG数据不完整！" << std::endl;
+        return false;
+    }
+    decoder->Output(pixels);
+    width = decoder->width;
+    height = decoder->height;
+    return true;
+}
+
+} // namespace PLE
@@ -0,0 +1,49 @@
+/**
+ * @file ImageDecoder.h
+ * @brief PNG/TGA/JPEG图像解码
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace PLE {
+
+/**
+ * @brief 图像解码器
+ *
+ * 输出统一为RGBA8，行从上到下。所有函数只读取传入的内存，可以在多个线程上同时调用。
+ * - PNG：全部颜色类型和位深，支持Adam7隔行和tRNS透明；不校验CRC；
+ * - TGA：真彩色、灰度和颜色表图像，包括RLE压缩版本；
+ * - JPEG：基线和扩展顺序（霍夫曼编码、8位精度）的灰度和YCbCr图像，不支持渐进式和算术编码。
+ */
+class ImageDecoder {
+public:
+    /**
+     * @brief 按文件头识别格式并解码
+     * @param data 文件数据
+     * @param size 文件字节数
+     * @param width 输出宽度
+     * @param height 输出高度
+     * @param pixels 输出RGBA8像素
+     * @return 是否成功
+     */
+    static bool Decode(const uint8_t* data, size_t size, uint32_t& width, uint32_t& height, std::vector<uint8_t>& pixels);
+
+    static bool DecodePng(const uint8_t* data, size_t size, uint32_t& width, uint32_t& height, std::vector<uint8_t>& pixels);
+    static bool DecodeTga(const uint8_t* data, size_t size, uint32_t& width, uint32_t& height, std::vector<uint8_t>& pixels);
+    static bool DecodeJpeg(const uint8_t* data, size_t size, uint32_t& width, uint32_t& height, std::vector<uint8_t>& pixels);
+
+    /**
+     * @brief 解压zlib数据流（RFC 1950/1951）
+     * @param data 压缩数据
+     * @param size 压缩数据字节数
+     * @param output 输出，解压后的数据追加到末尾
+     * @return 是否成功
+     */
+    static bool Inflate(const uint8_t* data, size_t size, std::vector<uint8_t>& output);
+};
+
+} // namespace PLE
@@ -0,0 +1,704 @@
+/**
+ * @file ImageEncoder.cpp
+ * @brief PNG编码与deflate压缩实现
+ */
+
+#include "ImageEncoder.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+namespace PLE {
+
+namespace {
+
+void WriteBigEndian32(uint8_t* data, uint32_t value) {
+    data[0] = static_cast<uint8_t>(value >> 24);
+    data[1] = static_cast<uint8_t>(value >> 16);
+    data[2] = static_cast<uint8_t>(value >> 8);
+    data[3] = static_cast<uint8_t>(value);
+}
+
+// ---------------------------------------------------------------------------
+// Deflate
+// ---------------------------------------------------------------------------
+
+constexpr uint32_t WINDOW_SIZE = 32768;
+constexpr uint32_t WINDOW_MASK = WINDOW_SIZE - 1;
+constexpr uint32_t HASH_BITS = 15;
+constexpr uint32_t HASH_SIZE = 1u << HASH_BITS;
+constexpr uint32_t NO_POSITION = UINT32_MAX;
+constexpr uint32_t MIN_MATCH = 4;           // 按4字节哈希，比RFC允许的3字节最短匹配更快，对图像几乎没有损失
+constexpr uint32_t MAX_MATCH = 258;
+constexpr uint32_t MAX_CHAIN = 8;           // 每个位置最多比较的候选数
+constexpr uint32_t NICE_MATCH = 64;         // 找到这么长的匹配就不再继续比较
+constexpr size_t SYMBOLS_PER_BLOCK = 1 << 15;
+
+constexpr uint32_t LITERAL_CODES = 286;
+constexpr uint32_t DISTANCE_CODES = 30;
+constexpr uint32_t CODE_LENGTH_CODES = 19;
+constexpr uint32_t END_OF_BLOCK = 256;
+
+const uint16_t LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                   35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+const uint8_t LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+const uint16_t DISTANCE_BASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                     257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+const uint8_t DISTANCE_EXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+const uint8_t CODE_LENGTH_ORDER[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+/**
+ * @brief 长度和距离到码的查找表
+ */
+struct DeflateTables {
+    std::array<uint8_t, MAX_MATCH + 1> lengthCode;
+    std::array<uint8_t, 512> distanceCode;      // 距离 - 1 < 256时直接索引，否则按(距离 - 1) >> 7索引后半部分
+
+    DeflateTables() {
+        for (uint32_t code = 0; code < 29; ++code) {
+            const uint32_t last = code == 28 ? MAX_MATCH : LENGTH_BASE[code] + (1u << LENGTH_EXTRA[code]) - 1;
+            for (uint32_t length = LENGTH_BASE[code]; length <= last; ++length) {
+                lengthCode[length] = static_cast<uint8_t>(code);
+            }
+        }
+        for (uint32_t code = 0; code < DISTANCE_CODES; ++code) {
+            const uint32_t first = DISTANCE_BASE[code] - 1u;
+            const uint32_t last = first + (1u << DISTANCE_EXTRA[code]) - 1u;
+            for (uint32_t distance = first; distance <= last; ++distance) {
+                distanceCode[distance < 256 ? distance : 256 + (distance >> 7)] = static_cast<uint8_t>(code);
+            }
+        }
+    }
+
+    uint32_t GetDistanceCode(uint32_t distance) const {
+        const uint32_t value = distance - 1;
+        return distanceCode[value < 256 ? value : 256 + (value >> 7)];
+    }
+};
+
+const DeflateTables& GetDeflateTables() {
+    static const DeflateTables tables;
+    return tables;
+}
+
+/**
+ * @brief LZ77符号：distance为0时length是字面字节
+ */
+struct DeflateSymbol {
+    uint16_t length;
+    uint16_t distance;
+};
+
+/**
+ * @brief 低位在前的位写入器
+ *
+ * 直接写入输出向量预留的空间，调用者在写入之前用Reserve保证剩余空间足够。
+ */
+class LsbBitWriter {
+public:
+    explicit LsbBitWriter(std::vector<uint8_t>& output) : m_Output(output), m_Size(output.size()) {}
+
+    ~LsbBitWriter() { m_Output.resize(m_Size); }
+
+    void Reserve(size_t bytes) {
+        if (m_Output.size() < m_Size + bytes + 8) {
+            m_Output.resize(std::max(m_Size + bytes + 8, m_Output.size() * 3 / 2));
+        }
+    }
+
+    void Write(uint32_t bits, uint32_t count) {
+        m_Buffer |= static_cast<uint64_t>(bits) << m_Count;
+        m_Count += count;
+        if (m_Count >= 32) {
+            uint8_t* destination = m_Output.data() + m_Size;
+            destination[0] = static_cast<uint8_t>(m_Buffer);
+            destination[1] = static_cast<uint8_t>(m_Buffer >> 8);
+            destination[2] = static_cast<uint8_t>(m_Buffer >> 16);
+            destination[3] = static_cast<uint8_t>(m_Buffer >> 24);
+            m_Size += 4;
+            m_Buffer >>= 32;
+            m_Count -= 32;
+        }
+    }
+
+    void AlignToByte() {
+        Reserve(8);
+        while (m_Count > 0) {
+            m_Output[m_Size++] = static_cast<uint8_t>(m_Buffer);
+            m_Buffer >>= 8;
+            m_Count = m_Count > 8 ? m_Count - 8 : 0;
+        }
+        m_Buffer = 0;
+    }
+
+private:
+    std::vector<uint8_t>& m_Output;
+    size_t m_Size;
+    uint64_t m_Buffer = 0;
+    uint32_t m_Count = 0;
+};
+
+/**
+ * @brief 由频率生成长度受限的霍夫曼码长
+ *
+ * 先按频率构造霍夫曼树（两个队列的线性合并），超过长度上限时把频率减半后重建；
+ * 至少保留两个符号，保证生成完整的前缀码。
+ */
+void BuildCodeLengths(const uint32_t* frequencies, uint32_t count, uint32_t maxBits, uint8_t* lengths) {
+    std::vector<uint32_t> weights(frequencies, frequencies + count);
+    uint32_t used = 0;
+    for (uint32_t weight : weights) {
+        used += weight > 0 ? 1 : 0;
+    }
+    for (uint32_t symbol = 0; symbol < count && used < 2; ++symbol) {
+        if (weights[symbol] == 0) {
+            weights[symbol] = 1;
+            ++used;
+        }
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> leaves;  // 权重，符号
+    std::vector<uint32_t> nodeWeights;
+    std::vector<uint32_t> parents;
+    std::vector<uint32_t> depths;
+    for (;;) {
+        leaves.clear();
+        for (uint32_t symbol = 0; symbol < count; ++symbol) {
+            if (weights[symbol] > 0) {
+                leaves.emplace_back(weights[symbol], symbol);
+            }
+        }
+        std::sort(leaves.begin(), leaves.end());
+
+        // 叶子在前，内部节点按生成顺序排在后面，生成顺序就是权重的非降序
+        const size_t leafCount = leaves.size();
+        const size_t nodeCount = leafCount * 2 - 1;
+        nodeWeights.assign(nodeCount, 0);
+        parents.assign(nodeCount, 0);
+        for (size_t i = 0; i < leafCount; ++i) {
+            nodeWeights[i] = leaves[i].first;
+        }
+        size_t nextLeaf = 0;
+        size_t nextInternal = leafCount;
+        const auto takeSmallest = [&](size_t created) {
+            if (nextLeaf < leafCount && (nextInternal >= created || nodeWeights[nextLeaf] <= nodeWeights[nextInternal])) {
+                return nextLeaf++;
+            }
+            return nextInternal++;
+        };
+        for (size_t node = leafCount; node < nodeCount; ++node) {
+            const size_t first = takeSmallest(node);
+            const size_t second = takeSmallest(node);
+            nodeWeights[node] = nodeWeights[first] + nodeWeights[second];
+            parents[first] = static_cast<uint32_t>(node);
+            parents[second] = static_cast<uint32_t>(node);
+        }
+
+        depths.assign(nodeCount, 0);
+        uint32_t maxDepth = 0;
+        for (size_t node = nodeCount - 1; node-- > 0;) {
+            depths[node] = depths[parents[node]] + 1;
+            maxDepth = std::max(maxDepth, depths[node]);
+        }
+        if (maxDepth <= maxBits) {
+            std::fill(lengths, lengths + count, static_cast<uint8_t>(0));
+            for (size_t i = 0; i < leafCount; ++i) {
+                lengths[leaves[i].second] = static_cast<uint8_t>(depths[i]);
+            }
+            return;
+        }
+        for (uint32_t& weight : weights) {
+            weight = weight > 0 ? (weight + 1) / 2 : 0;
+        }
+    }
+}
+
+/**
+ * @brief 由码长生成规范霍夫曼码，已按低位在前的写入顺序反转
+ */
+void BuildCodes(const uint8_t* lengths, uint32_t count, uint16_t* codes) {
+    uint32_t lengthCounts[16] = {};
+    for (uint32_t symbol = 0; symbol < count; ++symbol) {
+        ++lengthCounts[lengths[symbol]];
+    }
+    lengthCounts[0] = 0;
+    uint32_t nextCode[16] = {};
+    uint32_t code = 0;
+    for (uint32_t bits = 1; bits < 16; ++bits) {
+        code = (code + lengthCounts[bits - 1]) << 1;
+        nextCode[bits] = code;
+    }
+    for (uint32_t symbol = 0; symbol < count; ++symbol) {
+        const uint32_t length = lengths[symbol];
+        if (length == 0) {
+            codes[symbol] = 0;
+            continue;
+        }
+        uint32_t value = nextCode[length]++;
+        uint32_t reversed = 0;
+        for (uint32_t bit = 0; bit < length; ++bit) {
+            reversed = (reversed << 1) | (value & 1);
+            value >>= 1;
+        }
+        codes[symbol] = static_cast<uint16_t>(reversed);
+    }
+}
+
+/**
+ * @brief 以动态霍夫曼编码写出一个块
+ */
+void WriteDynamicBlock(LsbBitWriter& writer, const DeflateSymbol* symbols, size_t count, bool final) {
+    const DeflateTables& tables = GetDeflateTables();
+    uint32_t literalFrequencies[LITERAL_CODES] = {};
+    uint32_t distanceFrequencies[DISTANCE_CODES] = {};
+    for (size_t i = 0; i < count; ++i) {
+        const DeflateSymbol& symbol = symbols[i];
+        if (symbol.distance == 0) {
+            ++literalFrequencies[symbol.length];
+        } else {
+            ++literalFrequencies[257 + tables.lengthCode[symbol.length]];
+            ++distanceFrequencies[tables.GetDistanceCode(symbol.distance)];
+        }
+    }
+    ++literalFrequencies[END_OF_BLOCK];
+
+    uint8_t lengths[LITERAL_CODES + DISTANCE_CODES];
+    uint8_t* literalLengths = lengths;
+    uint8_t distanceLengths[DISTANCE_CODES];
+    BuildCodeLengths(literalFrequencies, LITERAL_CODES, 15, literalLengths);
+    BuildCodeLengths(distanceFrequencies, DISTANCE_CODES, 15, distanceLengths);
+    uint32_t literalCount = LITERAL_CODES;
+    while (literalCount > 257 && literalLengths[literalCount - 1] == 0) {
+        --literalCount;
+    }
+    uint32_t distanceCount = DISTANCE_CODES;
+    while (distanceCount > 1 && distanceLengths[distanceCount - 1] == 0) {
+        --distanceCount;
+    }
+    uint16_t literalCodes[LITERAL_CODES];
+    uint16_t distanceCodes[DISTANCE_CODES];
+    BuildCodes(literalLengths, LITERAL_CODES, literalCodes);
+    BuildCodes(distanceLengths, DISTANCE_CODES, distanceCodes);
+
+    // 两组码长连续排列后做游程编码（16：重复前一个码长3-6次，17/18：3-10/11-138个0）
+    std::memcpy(lengths + literalCount, distanceLengths, distanceCount);
+    const uint32_t total = literalCount + distanceCount;
+    std::vector<std::pair<uint8_t, uint8_t>> runs;      // 码长符号，额外位的值
+    uint32_t codeLengthFrequencies[CODE_LENGTH_CODES] = {};
+    const auto emit = [&](uint8_t symbol, uint8_t extra) {
+        runs.emplace_back(symbol, extra);
+        ++codeLengthFrequencies[symbol];
+    };
+    for (uint32_t i = 0; i < total;) {
+        const uint8_t length = lengths[i];
+        uint32_t run = 1;
+        while (i + run < total && lengths[i + run] == length) {
+            ++run;
+        }
+        i += run;
+        if (length == 0) {
+            while (run >= 11) {
+                const uint32_t repeat = std::min(run, 138u);
+                emit(18, static_cast<uint8_t>(repeat - 11));
+                run -= repeat;
+            }
+            if (run >= 3) {
+                emit(17, static_cast<uint8_t>(run - 3));
+                run = 0;
+            }
+        } else {
+            emit(length, 0);
+            --run;
+            while (run >= 3) {
+                const uint32_t repeat = std::min(run, 6u);
+                emit(16, static_cast<uint8_t>(repeat - 3));
+                run -= repeat;
+            }
+        }
+        for (; run > 0; --run) {
+            emit(length, 0);
+        }
+    }
+
+    uint8_t codeLengthLengths[CODE_LENGTH_CODES];
+    uint16_t codeLengthCodes[CODE_LENGTH_CODES];
+    BuildCodeLengths(codeLengthFrequencies, CODE_LENGTH_CODES, 7, codeLengthLengths);
+    BuildCodes(codeLengthLengths, CODE_LENGTH_CODES, codeLengthCodes);
+    uint32_t codeLengthCount = CODE_LENGTH_CODES;
+    while (codeLengthCount > 4 && codeLengthLengths[CODE_LENGTH_ORDER[codeLengthCount - 1]] == 0) {
+        --codeLengthCount;
+    }
+
+    // 每个符号最多15 + 5 + 15 + 13位，码表头部不超过(5 + 5 + 4 + 19 * 3 + 316 * 14)位
+    writer.Reserve(count * 6 + 640);
+    writer.Write(final ? 1 : 0, 1);
+    writer.Write(2, 2);
+    writer.Write(literalCount - 257, 5);
+    writer.Write(distanceCount - 1, 5);
+    writer.Write(codeLengthCount - 4, 4);
+    for (uint32_t i = 0; i < codeLengthCount; ++i) {
+        writer.Write(codeLengthLengths[CODE_LENGTH_ORDER[i]], 3);
+    }
+    for (const auto& run : runs) {
+        writer.Write(codeLengthCodes[run.first], codeLengthLengths[run.first]);
+        if (run.first == 16) {
+            writer.Write(run.second, 2);
+        } else if (run.first == 17) {
+            writer.Write(run.second, 3);
+        } else if (run.first == 18) {
+            writer.Write(run.second, 7);
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const DeflateSymbol& symbol = symbols[i];
+        if (symbol.distance == 0) {
+            writer.Write(literalCodes[symbol.length], literalLengths[symbol.length]);
+            continue;
+        }
+        const uint32_t lengthCode = tables.lengthCode[symbol.length];
+        writer.Write(literalCodes[257 + lengthCode], literalLengths[257 + lengthCode]);
+        if (LENGTH_EXTRA[lengthCode] > 0) {
+            writer.Write(symbol.length - LENGTH_BASE[lengthCode], LENGTH_EXTRA[lengthCode]);
+        }
+        const uint32_t distanceCode = tables.GetDistanceCode(symbol.distance);
+        writer.Write(distanceCodes[distanceCode], distanceLengths[distanceCode]);
+        if (DISTANCE_EXTRA[distanceCode] > 0) {
+            writer.Write(symbol.distance - DISTANCE_BASE[distanceCode], DISTANCE_EXTRA[distanceCode]);
+        }
+    }
+    writer.Write(literalCodes[END_OF_BLOCK], literalLengths[END_OF_BLOCK]);
+}
+
+uint32_t Load32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+uint32_t Hash32(uint32_t value) {
+    return (value * 2654435761u) >> (32 - HASH_BITS);
+}
+
+uint32_t MatchLength(const uint8_t* first, const uint8_t* second, uint32_t maxLength) {
+    uint32_t length = 0;
+    while (length + 8 <= maxLength) {
+        uint64_t a;
+        uint64_t b;
+        std::memcpy(&a, first + length, sizeof(a));
+        std::memcpy(&b, second + length, sizeof(b));
+        if (a != b) {
+            break;
+        }
+        length += 8;
+    }
+    while (length < maxLength && first[length] == second[length]) {
+        ++length;
+    }
+    return length;
+}
+
+// ---------------------------------------------------------------------------
+// PNG
+// ---------------------------------------------------------------------------
+
+constexpr uint32_t PNG_BYTES_PER_PIXEL = 4;
+
+int PaethPredictor(int a, int b, int c) {
+    // |p - a|、|p - b|、|p - c|，其中p = a + b - c
+    const int pa = std::abs(b - c);
+    const int pb = std::abs(a - c);
+    const int pc = std::abs(a + b - 2 * c);
+    if (pa <= pb && pa <= pc) {
+        return a;
+    }
+    return pb <= pc ? b : c;
+}
+
+uint32_t ResidualCost(int value) {
+    const int residual = static_cast<int8_t>(static_cast<uint8_t>(value));
+    return static_cast<uint32_t>(residual < 0 ? -residual : residual);
+}
+
+int ApplyFilter(int filter, int x, int a, int b, int c) {
+    switch (filter) {
+        case 1: return x - a;
+        case 2: return x - b;
+        case 3: return x - ((a + b) >> 1);
+        case 4: return x - PaethPredictor(a, b, c);
+        default: return x;
+    }
+}
+
+/**
+ * @brief 滤波一行：先统计五种滤波的残差绝对值之和（libpng的默认启发式），再只输出最小的一种
+ * @param output 1 + rowBytes字节，第一个字节是滤波类型
+ */
+void FilterRow(const uint8_t* row, const uint8_t* previous, size_t rowBytes, uint8_t* output) {
+    // 第一个像素左侧和左上方的字节都是0
+    uint32_t costs[5] = {};
+    for (size_t i = 0; i < PNG_BYTES_PER_PIXEL; ++i) {
+        const int x = row[i];
+        const int b = previous[i];
+        costs[0] += ResidualCost(x);
+        costs[1] += ResidualCost(x);
+        costs[2] += ResidualCost(x - b);
+        costs[3] += ResidualCost(x - (b >> 1));
+        costs[4] += ResidualCost(x - b);
+    }
+    for (size_t i = PNG_BYTES_PER_PIXEL; i < rowBytes; ++i) {
+        const int x = row[i];
+        const int a = row[i - PNG_BYTES_PER_PIXEL];
+        const int b = previous[i];
+        const int c = previous[i - PNG_BYTES_PER_PIXEL];
+        costs[0] += ResidualCost(x);
+        costs[1] += ResidualCost(x - a);
+        costs[2] += ResidualCost(x - b);
+        costs[3] += ResidualCost(x - ((a + b) >> 1));
+        costs[4] += ResidualCost(x - PaethPredictor(a, b, c));
+    }
+    int best = 0;
+    for (int filter = 1; filter < 5; ++filter) {
+        if (costs[filter] < costs[best]) {
+            best = filter;
+        }
+    }
+
+    output[0] = static_cast<uint8_t>(best);
+    uint8_t* filtered = output + 1;
+    for (size_t i = 0; i < PNG_BYTES_PER_PIXEL; ++i) {
+        filtered[i] = static_cast<uint8_t>(ApplyFilter(best, row[i], 0, previous[i], 0));
+    }
+    for (size_t i = PNG_BYTES_PER_PIXEL; i < rowBytes; ++i) {
+        filtered[i] = static_cast<uint8_t>(ApplyFilter(best, row[i], row[i - PNG_BYTES_PER_PIXEL], previous[i],
+                                                       previous[i - PNG_BYTES_PER_PIXEL]));
+    }
+}
+
+void AppendPngChunk(std::vector<uint8_t>& output, const char* type, const uint8_t* data, size_t size) {
+    const size_t start = output.size();
+    output.resize(start + 12 + size);
+    uint8_t* chunk = output.data() + start;
+    WriteBigEndian32(chunk, static_cast<uint32_t>(size));
+    std::memcpy(chunk + 4, type, 4);
+    if (size > 0) {
+        std::memcpy(chunk + 8, data, size);
+    }
+    WriteBigEndian32(chunk + 8 + size, ImageEncoder::Crc32(chunk + 4, size + 4));
+}
+
+} // namespace
+
+void ImageEncoder::Deflate(const uint8_t* data, size_t dictionarySize, size_t size, bool final, std::vector<uint8_t>& output) {
+    LsbBitWriter writer(output);
+    std::vector<uint32_t> head(HASH_SIZE, NO_POSITION);
+    std::vector<uint32_t> previous(WINDOW_SIZE, NO_POSITION);
+    std::vector<DeflateSymbol> symbols(SYMBOLS_PER_BLOCK);
+    size_t symbolCount = 0;
+
+    const uint32_t end = static_cast<uint32_t>(dictionarySize + size);
+    const auto insert = [&](uint32_t position) {
+        const uint32_t hash = Hash32(Load32(data + position));
+        previous[position & WINDOW_MASK] = head[hash];
+        head[hash] = position;
+    };
+
+    // 字典只用于匹配，不输出
+    const uint32_t dictionaryStart = dictionarySize > WINDOW_SIZE ? static_cast<uint32_t>(dictionarySize - WINDOW_SIZE) : 0;
+    for (uint32_t position = dictionaryStart; position < dictionarySize && position + MIN_MATCH <= end; ++position) {
+        insert(position);
+    }
+
+    uint32_t position = static_cast<uint32_t>(dictionarySize);
+    while (position < end) {
+        uint32_t bestLength = 0;
+        uint32_t bestDistance = 0;
+        if (position + MIN_MATCH <= end) {
+            const uint32_t maxLength = std::min(MAX_MATCH, end - position);
+            const uint32_t prefix = Load32(data + position);
+            uint32_t candidate = head[Hash32(prefix)];
+            for (uint32_t chain = 0; chain < MAX_CHAIN && candidate != NO_POSITION && position - candidate <= WINDOW_SIZE; ++chain) {
+                // 先比较前4字节（排除哈希冲突）和当前最佳长度处的字节，大多数候选在这里被淘汰
+                if (Load32(data + candidate) == prefix && data[candidate + bestLength] == data[position + bestLength]) {
+                    const uint32_t length = MatchLength(data + candidate, data + position, maxLength);
+                    if (length > bestLength) {
+                        bestLength = length;
+                        bestDistance = position - candidate;
+                        if (length >= std::min(NICE_MATCH, maxLength)) {
+                            break;
+                        }
+                    }
+                }
+                // 窗口回绕后链表中可能出现更新的位置，遇到时结束
+                const uint32_t next = previous[candidate & WINDOW_MASK];
+                if (next >= candidate) {
+                    break;
+                }
+                candidate = next;
+            }
+            insert(position);
+        }
+
+        if (bestLength >= MIN_MATCH) {
+            symbols[symbolCount++] = { static_cast<uint16_t>(bestLength), static_cast<uint16_t>(bestDistance) };
+            for (uint32_t skipped = position + 1; skipped < position + bestLength && skipped + MIN_MATCH <= end; ++skipped) {
+                insert(skipped);
+            }
+            position += bestLength;
+        } else {
+            symbols[symbolCount++] = { data[position], 0 };
+            ++position;
+        }
+
+        if (symbolCount == SYMBOLS_PER_BLOCK && position < end) {
+            WriteDynamicBlock(writer, symbols.data(), symbolCount, false);
+            symbolCount = 0;
+        }
+    }
+
+    if (final || symbolCount > 0) {
+        WriteDynamicBlock(writer, symbols.data(), symbolCount, final);
+    }
+    if (!final) {
+        // 空的存储块把输出对齐到字节（同步刷新）
+        writer.Write(0, 3);
+        writer.AlignToByte();
+        writer.Write(0xFFFF0000u, 32);
+    }
+    writer.AlignToByte();
+}
+
+uint32_t ImageEncoder::Adler32(const uint8_t* data, size_t size, uint32_t adler) {
+    constexpr uint32_t MOD = 65521;
+    constexpr size_t MAX_RUN = 5552;    // 保证累加不溢出32位的最大字节数
+    uint32_t a = adler & 0xFFFF;
+    uint32_t b = adler >> 16;
+    while (size > 0) {
+        const size_t run = std::min(size, MAX_RUN);
+        for (size_t i = 0; i < run; ++i) {
+            a += data[i];
+            b += a;
+        }
+        a %= MOD;
+        b %= MOD;
+        data += run;
+        size -= run;
+    }
+    return (b << 16) | a;
+}
+
+uint32_t ImageEncoder::Adler32Combine(uint32_t first, uint32_t second, size_t secondSize) {
+    constexpr uint32_t MOD = 65521;
+    const uint32_t remainder = static_cast<uint32_t>(secondSize % MOD);
+    uint32_t sum1 = first & 0xFFFF;
+    uint32_t sum2 = static_cast<uint32_t>((static_cast<uint64_t>(remainder) * sum1) % MOD);
+    sum1 += (second & 0xFFFF) + MOD - 1;
+    sum2 += (first >> 16) + (second >> 16) + MOD - remainder;
+    if (sum1 >= MOD) {
+        sum1 -= MOD;
+    }
+    if (sum1 >= MOD) {
+        sum1 -= MOD;
+    }
+    if (sum2 >= MOD * 2) {
+        sum2 -= MOD * 2;
+    }
+    if (sum2 >= MOD) {
+        sum2 -= MOD;
+    }
+    return (sum2 << 16) | sum1;
+}
+
+uint32_t ImageEncoder::Crc32(const uint8_t* data, size_t size, uint32_t crc) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> result = {};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+            }
+            result[i] = value;
+        }
+        return result;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void ImageEncoder::EncodePngRows(const uint8_t* const* rows, uint32_t width, uint32_t firstRow, uint32_t rowCount, uint32_t height,
+                                 PngRowBlock& block) {
+    const size_t rowBytes = static_cast<size_t>(width) * PNG_BYTES_PER_PIXEL;
+    const size_t filteredRowBytes = rowBytes + 1;
+
+    // 前面若干行重新滤波作为字典，覆盖完整的32KB窗口
+    const uint32_t dictionaryRows = std::min(firstRow, static_cast<uint32_t>((WINDOW_SIZE + filteredRowBytes - 1) / filteredRowBytes));
+    const uint32_t startRow = firstRow - dictionaryRows;
+    std::vector<uint8_t> filtered(filteredRowBytes * (dictionaryRows + rowCount));
+    const std::vector<uint8_t> zeroRow(startRow == 0 ? rowBytes : 0, 0);
+    for (uint32_t row = startRow; row < firstRow + rowCount; ++row) {
+        const uint8_t* previous = row == 0 ? zeroRow.data() : rows[row - 1];
+        FilterRow(rows[row], previous, rowBytes, filtered.data() + filteredRowBytes * (row - startRow));
+    }
+
+    const size_t dictionarySize = filteredRowBytes * dictionaryRows;
+    block.rawSize = filteredRowBytes * rowCount;
+    block.adler = Adler32(filtered.data() + dictionarySize, block.rawSize);
+
+    // IDAT的长度和类型先占位，压缩完成后回填
+    std::vector<uint8_t>& idat = block.idat;
+    idat.clear();
+    idat.reserve(block.rawSize / 2 + 64);
+    idat.resize(8);
+    std::memcpy(idat.data() + 4, "IDAT", 4);
+    if (firstRow == 0) {
+        idat.push_back(0x78);   // zlib头：deflate，32KB窗口，无预设字典
+        idat.push_back(0x01);
+    }
+    Deflate(filtered.data(), dictionarySize, block.rawSize, firstRow + rowCount >= height, idat);
+    const size_t dataSize = idat.size() - 8;
+    WriteBigEndian32(idat.data(), static_cast<uint32_t>(dataSize));
+    const uint32_t crc = Crc32(idat.data() + 4, dataSize + 4);
+    idat.resize(idat.size() + 4);
+    WriteBigEndian32(idat.data() + idat.size() - 4, crc);
+}
+
+void ImageEncoder::AssemblePng(uint32_t width, uint32_t height, const PngRowBlock* blocks, size_t blockCount, std::vector<uint8_t>& output) {
+    static const uint8_t SIGNATURE[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+    output.insert(output.end(), SIGNATURE, SIGNATURE + 8);
+
+    uint8_t header[13];
+    WriteBigEndian32(header, width);
+    WriteBigEndian32(header + 4, height);
+    header[8] = 8;      // 位深
+    header[9] = 6;      // RGBA
+    header[10] = 0;
+    header[11] = 0;
+    header[12] = 0;
+    AppendPngChunk(output, "IHDR", header, sizeof(header));
+
+    uint32_t adler = 1;
+    for (size_t i = 0; i < blockCount; ++i) {
+        output.insert(output.end(), blocks[i].idat.begin(), blocks[i].idat.end());
+        adler = i == 0 ? blocks[i].adler : Adler32Combine(adler, blocks[i].adler, blocks[i].rawSize);
+    }
+
+    // zlib校验和要等所有段完成后才知道，单独放在最后一个IDAT中
+    uint8_t checksum[4];
+    WriteBigEndian32(checksum, adler);
+    AppendPngChunk(output, "IDAT", checksum, sizeof(checksum));
+    AppendPngChunk(output, "IEND", nullptr, 0);
+}
+
+void ImageEncoder::EncodePng(const uint8_t* const* rows, uint32_t width, uint32_t height, std::vector<uint8_t>& output) {
+    PngRowBlock block;
+    EncodePngRows(rows, width, 0, height, height, block);
+    AssemblePng(width, height, &block, 1, output);
+}
+
+} // namespace PLE
@@ -0,0 +1,76 @@
+/**
+ * @file ImageEncoder.h
+ * @brief PNG编码与deflate压缩
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace PLE {
+
+/**
+ * @brief PNG的一段行：压缩后的数据已经包装成完整的IDAT块（长度、类型、数据、CRC）
+ *
+ * 各段彼此独立压缩，可以在不同线程上生成，按顺序拼接后由AssemblePng补上
+ * 文件头、zlib校验和和IEND（与pigz相同的分块并行压缩方式）。
+ */
+struct PngRowBlock {
+    std::vector<uint8_t> idat;
+    uint32_t adler = 1;         // 本段滤波后数据的Adler-32
+    size_t rawSize = 0;         // 本段滤波后数据的字节数
+};
+
+/**
+ * @brief 图像编码器
+ *
+ * 输入统一为RGBA8，通过行指针数组传入（行从上到下），可以直接指向读回缓冲区而不必先复制。
+ * 所有函数只读取传入的内存，可以在多个线程上同时调用。
+ */
+class ImageEncoder {
+public:
+    /**
+     * @brief 编码一段行
+     * @param rows 全部行的指针，从上到下
+     * @param width 宽度
+     * @param firstRow 本段第一行
+     * @param rowCount 本段行数
+     * @param height 图像总行数，本段包含最后一行时结束deflate流
+     * @param block 输出
+     *
+     * 本段之前最多32KB的滤波数据作为预设字典参与匹配，分段几乎不损失压缩率。
+     */
+    static void EncodePngRows(const uint8_t* const* rows, uint32_t width, uint32_t firstRow, uint32_t rowCount, uint32_t height,
+                              PngRowBlock& block);
+
+    /**
+     * @brief 拼接完整的PNG文件
+     * @param blocks 覆盖全部行的各段，按行顺序排列
+     * @param blockCount 段数
+     * @param output 输出，数据追加到末尾
+     */
+    static void AssemblePng(uint32_t width, uint32_t height, const PngRowBlock* blocks, size_t blockCount, std::vector<uint8_t>& output);
+
+    /**
+     * @brief 单线程编码整幅图像
+     */
+    static void EncodePng(const uint8_t* const* rows, uint32_t width, uint32_t height, std::vector<uint8_t>& output);
+
+    /**
+     * @brief deflate压缩（RFC 1951，动态霍夫曼编码），不带zlib头
+     * @param data 数据起点，前dictionarySize字节只作为匹配字典
+     * @param dictionarySize 字典字节数，超过32KB的部分不会被引用
+     * @param size 需要压缩的字节数
+     * @param final 是否结束deflate流；为false时以空的存储块对齐到字节，输出可以直接与后续段拼接
+     * @param output 输出，数据追加到末尾
+     */
+    static void Deflate(const uint8_t* data, size_t dictionarySize, size_t size, bool final, std::vector<uint8_t>& output);
+
+    static uint32_t Adler32(const uint8_t* data, size_t size, uint32_t adler = 1);
+    static uint32_t Adler32Combine(uint32_t first, uint32_t second, size_t secondSize);
+    static uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc = 0);
+};
+
+} // namespace PLE
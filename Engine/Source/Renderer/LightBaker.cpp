@@ -0,0 +1,997 @@
+/**
+ * @file LightBaker.cpp
+ * @brief 光照贴图和光照探针的CPU路径追踪烘焙实现
+ */
+
+#include "Renderer/LightBaker.h"
+#include "Scene/Light.h"
+#include "Core/JobSystem.h"
+#include "BakeBVH.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace PLE {
+
+namespace {
+
+constexpr float PI = 3.14159265358979f;
+constexpr uint32_t UNCOVERED = 0xFFFFFFFFu;
+
+enum TexelState : uint8_t {
+    TEXEL_PENDING = 0,      // 需要追踪
+    TEXEL_VALID,
+    TEXEL_REJECTED          // 命中背面过多，视为在几何体内部
+};
+
+Vector3 Multiply(const Vector3& a, const Vector3& b) {
+    return Vector3(a.x * b.x, a.y * b.y, a.z * b.z);
+}
+
+Vector3 TransformPoint(const Vector3& p, const Matrix4& matrix) {
+    const auto& m = matrix.m;
+    return Vector3(p.x * m[0] + p.y * m[4] + p.z * m[8] + m[12],
+                   p.x * m[1] + p.y * m[5] + p.z * m[9] + m[13],
+                   p.x * m[2] + p.y * m[6] + p.z * m[10] + m[14]);
+}
+
+/**
+ * @brief 按逆矩阵的转置变换法线（行向量约定）
+ */
+Vector3 TransformNormal(const Vector3& n, const Matrix4& inverse) {
+    const auto& m = inverse.m;
+    return Vector3(n.x * m[0] + n.y * m[1] + n.z * m[2],
+                   n.x * m[4] + n.y * m[5] + n.z * m[6],
+                   n.x * m[8] + n.y * m[9] + n.z * m[10]).Normalized();
+}
+
+/**
+ * @brief 以n为z轴的正交基（Duff等人的无分支构造）
+ */
+void OrthonormalBasis(const Vector3& n, Vector3& tangent, Vector3& bitangent) {
+    const float sign = n.z >= 0.0f ? 1.0f : -1.0f;
+    const float a = -1.0f / (sign + n.z);
+    const float b = n.x * n.y * a;
+    tangent = Vector3(1.0f + sign * n.x * n.x * a, sign * b, -sign * n.x);
+    bitangent = Vector3(b, sign + n.y * n.y * a, -n.y);
+}
+
+Vector3 FromBasis(const Vector3& n, float x, float y, float z) {
+    Vector3 tangent;
+    Vector3 bitangent;
+    OrthonormalBasis(n, tangent, bitangent);
+    return tangent * x + bitangent * y + n * z;
+}
+
+/**
+ * @brief 余弦分布的半球方向，u1、u2为[0, 1)的随机数
+ */
+Vector3 CosineHemisphere(const Vector3& n, float u1, float u2) {
+    const float r = std::sqrt(u1);
+    const float phi = 2.0f * PI * u2;
+    return FromBasis(n, r * std::cos(phi), r * std::sin(phi), std::sqrt(std::max(0.0f, 1.0f - u1)));
+}
+
+Vector3 UniformSphere(float u1, float u2) {
+    const float z = 1.0f - 2.0f * u1;
+    const float r = std::sqrt(std::max(0.0f, 1.0f - z * z));
+    const float phi = 2.0f * PI * u2;
+    return Vector3(r * std::cos(phi), r * std::sin(phi), z);
+}
+
+/**
+ * @brief 以axis为中心、半角为angle的锥体内均匀分布的方向
+ */
+Vector3 UniformCone(const Vector3& axis, float angle, float u1, float u2) {
+    const float cosTheta = 1.0f - u1 * (1.0f - std::cos(angle));
+    const float sinTheta = std::sqrt(std::max(0.0f, 1.0f - cosTheta * cosTheta));
+    const float phi = 2.0f * PI * u2;
+    return FromBasis(axis, sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta);
+}
+
+/**
+ * @brief 二阶实球谐基函数
+ */
+void EvaluateSHBasis(const Vector3& d, float basis[9]) {
+    basis[0] = 0.282095f;
+    basis[1] = 0.488603f * d.y;
+    basis[2] = 0.488603f * d.z;
+    basis[3] = 0.488603f * d.x;
+    basis[4] = 1.092548f * d.x * d.y;
+    basis[5] = 1.092548f * d.y * d.z;
+    basis[6] = 0.315392f * (3.0f * d.z * d.z - 1.0f);
+    basis[7] = 1.092548f * d.x * d.z;
+    basis[8] = 0.546274f * (d.x * d.x - d.y * d.y);
+}
+
+float Saturate(float value) {
+    return std::min(std::max(value, 0.0f), 1.0f);
+}
+
+/**
+ * @brief 线段origin + direction * t（t在[0, length]内）是否与包围盒相交
+ */
+bool SegmentHitsBox(const Vector3& origin, const Vector3& direction, float length, const Vector3& min, const Vector3& max) {
+    const float start[3] = { origin.x, origin.y, origin.z };
+    const float step[3] = { direction.x, direction.y, direction.z };
+    const float low[3] = { min.x, min.y, min.z };
+    const float high[3] = { max.x, max.y, max.z };
+    float tNear = 0.0f;
+    float tFar = length;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (std::fabs(step[axis]) < 1.0e-12f) {
+            if (start[axis] < low[axis] || start[axis] > high[axis]) {
+                return false;
+            }
+            continue;
+        }
+        float t0 = (low[axis] - start[axis]) / step[axis];
+        float t1 = (high[axis] - start[axis]) / step[axis];
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        tNear = std::max(tNear, t0);
+        tFar = std::min(tFar, t1);
+        if (tNear > tFar) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t Hash(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+} // namespace
+
+/**
+ * @brief 每个纹素或探针独立的随机数序列（PCG32），结果与线程划分无关
+ */
+struct LightBaker::Sampler {
+    uint64_t state;
+    uint64_t rays = 0;
+
+    explicit Sampler(uint64_t seed) : state(Hash(seed) | 1u) {}
+
+    float Next() {
+        const uint64_t old = state;
+        state = old * 6364136223846793005ull + 1442695040888963407ull;
+        const uint32_t shifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        const uint32_t rotation = static_cast<uint32_t>(old >> 59u);
+        const uint32_t bits = (shifted >> rotation) | (shifted << ((32u - rotation) & 31u));
+        return static_cast<float>(bits >> 8) * (1.0f / 16777216.0f);
+    }
+
+    /**
+     * @brief 第index个样本的二维随机数：前 n*n 个样本分层抖动，其余为纯随机
+     */
+    void Stratified(uint32_t index, uint32_t strata, float& u1, float& u2) {
+        if (index < strata * strata) {
+            u1 = (static_cast<float>(index % strata) + Next()) / static_cast<float>(strata);
+            u2 = (static_cast<float>(index / strata) + Next()) / static_cast<float>(strata);
+        } else {
+            u1 = Next();
+            u2 = Next();
+        }
+        u1 = std::min(u1, 0.99999994f);
+        u2 = std::min(u2, 0.99999994f);
+    }
+};
+
+LightBaker::LightBaker(const LightBakerConfig& config)
+    : m_Config(config)
+    , m_BVH(std::make_unique<BakeBVH>()) {
+    m_Config.lightmapWidth = std::max(m_Config.lightmapWidth, 1);
+    m_Config.lightmapHeight = std::max(m_Config.lightmapHeight, 1);
+    m_Config.samplesPerTexel = std::max(m_Config.samplesPerTexel, 1u);
+    m_Config.samplesPerProbe = std::max(m_Config.samplesPerProbe, 1u);
+    m_Config.denoiseRadius = std::max(m_Config.denoiseRadius, 1);
+    m_Config.dilation = std::max(m_Config.dilation, 0);
+}
+
+LightBaker::~LightBaker() = default;
+
+uint32_t LightBaker::AddMesh(const LightBakeMesh& mesh) {
+    m_Meshes.push_back(mesh);
+    const uint32_t index = static_cast<uint32_t>(m_Meshes.size() - 1);
+    m_SceneDirty = true;
+    MarkMeshDirty(index, true);
+    return index;
+}
+
+void LightBaker::SetMeshTransform(uint32_t mesh, const Matrix4& transform) {
+    if (mesh >= m_Meshes.size()) {
+        return;
+    }
+    // 旧位置和新位置附近的光照都会变化
+    MarkMeshDirty(mesh, true);
+    m_Meshes[mesh].transform = transform;
+    MarkMeshDirty(mesh, true);
+    m_SceneDirty = true;
+}
+
+void LightBaker::SetMeshMaterial(uint32_t mesh, const Vector3& albedo, const Vector3& emission) {
+    if (mesh >= m_Meshes.size()) {
+        return;
+    }
+    m_Meshes[mesh].albedo = albedo;
+    m_Meshes[mesh].emission = emission;
+    MarkMeshDirty(mesh, false);
+}
+
+uint32_t LightBaker::AddLight(const ClusterLightData& light, float radius) {
+    BakeLight bakeLight;
+    bakeLight.data = light;
+    bakeLight.radius = std::max(radius, 0.0f);
+    m_Lights.push_back(bakeLight);
+    MarkLightDirty(bakeLight);
+    return static_cast<uint32_t>(m_Lights.size() - 1);
+}
+
+uint32_t LightBaker::AddLight(const Light& light, float radius) {
+    return AddLight(ClusteredLightCuller::PackLight(light), radius);
+}
+
+void LightBaker::SetLight(uint32_t index, const ClusterLightData& light, float radius) {
+    if (index >= m_Lights.size()) {
+        return;
+    }
+    MarkLightDirty(m_Lights[index]);
+    m_Lights[index].data = light;
+    m_Lights[index].radius = std::max(radius, 0.0f);
+    MarkLightDirty(m_Lights[index]);
+}
+
+void LightBaker::SetLightEnabled(uint32_t index, bool enabled) {
+    if (index >= m_Lights.size() || m_Lights[index].enabled == enabled) {
+        return;
+    }
+    m_Lights[index].enabled = enabled;
+    MarkLightDirty(m_Lights[index]);
+}
+
+void LightBaker::SetSkyColor(const Vector3& color) {
+    m_SkyColor = color;
+    m_AllDirty = true;
+}
+
+uint32_t LightBaker::AddProbe(const Vector3& position) {
+    Probe probe;
+    probe.position = position;
+    m_Probes.push_back(probe);
+    return static_cast<uint32_t>(m_Probes.size() - 1);
+}
+
+void LightBaker::Invalidate(const Vector3& min, const Vector3& max) {
+    m_DirtyRegions.push_back({ min, max, true });
+}
+
+bool LightBaker::HasChanges() const {
+    if (m_SceneDirty || m_AllDirty || !m_DirtyRegions.empty()) {
+        return true;
+    }
+    return std::any_of(m_Probes.begin(), m_Probes.end(), [](const Probe& probe) { return !probe.baked; });
+}
+
+void LightBaker::MarkMeshDirty(uint32_t mesh, bool occluder) {
+    const LightBakeMesh& bakeMesh = m_Meshes[mesh];
+    if (bakeMesh.vertices.empty()) {
+        return;
+    }
+    const float large = std::numeric_limits<float>::max();
+    DirtyRegion region = { Vector3(large, large, large), Vector3(-large, -large, -large), occluder };
+    for (const Vertex& vertex : bakeMesh.vertices) {
+        const Vector3 p = TransformPoint(vertex.position, bakeMesh.transform);
+        region.min = Vector3(std::min(region.min.x, p.x), std::min(region.min.y, p.y), std::min(region.min.z, p.z));
+        region.max = Vector3(std::max(region.max.x, p.x), std::max(region.max.y, p.y), std::max(region.max.z, p.z));
+    }
+    m_DirtyRegions.push_back(region);
+}
+
+void LightBaker::MarkLightDirty(const BakeLight& light) {
+    if (light.data.type == static_cast<uint32_t>(LightType::Directional)) {
+        m_AllDirty = true;
+        return;
+    }
+    const Vector3 position(light.data.position[0], light.data.position[1], light.data.position[2]);
+    const float range = light.data.range + light.radius;
+    m_DirtyRegions.push_back({ position - Vector3(range, range, range), position + Vector3(range, range, range), false });
+}
+
+bool LightBaker::IsDirty(const Vector3& position) const {
+    const float margin = m_Config.dirtyMargin;
+    const Vector3 expand(margin, margin, margin);
+    for (const DirtyRegion& region : m_DirtyRegions) {
+        const Vector3 min = region.min - expand;
+        const Vector3 max = region.max + expand;
+        if (position.x >= min.x && position.x <= max.x && position.y >= min.y && position.y <= max.y &&
+            position.z >= min.z && position.z <= max.z) {
+            return true;
+        }
+        if (!region.occluder) {
+            continue;
+        }
+
+        // 遮挡体变化时，到光源的线段穿过该区域的点阴影会变化，不论离得多远
+        for (const BakeLight& light : m_Lights) {
+            if (!light.enabled) {
+                continue;
+            }
+            const ClusterLightData& data = light.data;
+            if (data.type == static_cast<uint32_t>(LightType::Directional)) {
+                const Vector3 toLight = Vector3(data.direction[0], data.direction[1], data.direction[2]).Normalized() * -1.0f;
+                if (SegmentHitsBox(position, toLight, std::numeric_limits<float>::max(), min, max)) {
+                    return true;
+                }
+                continue;
+            }
+            const Vector3 offset = Vector3(data.position[0], data.position[1], data.position[2]) - position;
+            const float distance = offset.Length();
+            const Vector3 lightExpand(light.radius, light.radius, light.radius);
+            if (distance < data.range + light.radius && distance > 0.0f &&
+                SegmentHitsBox(position, offset / distance, distance, min - lightExpand, max + lightExpand)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void LightBaker::BuildScene() {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<Vector3> positions;
+    m_Triangles.clear();
+    for (uint32_t meshIndex = 0; meshIndex < m_Meshes.size(); ++meshIndex) {
+        const LightBakeMesh& mesh = m_Meshes[meshIndex];
+        const Matrix4 inverse = mesh.transform.Inverse();
+        const uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            const uint32_t i0 = mesh.indices[i];
+            const uint32_t i1 = mesh.indices[i + 1];
+            const uint32_t i2 = mesh.indices[i + 2];
+            if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount) {
+                continue;
+            }
+            const Vector3 p0 = TransformPoint(mesh.vertices[i0].position, mesh.transform);
+            const Vector3 p1 = TransformPoint(mesh.vertices[i1].position, mesh.transform);
+            const Vector3 p2 = TransformPoint(mesh.vertices[i2].position, mesh.transform);
+            const Vector3 geometricNormal = (p1 - p0).Cross(p2 - p0);
+            if (geometricNormal.LengthSquared() <= 0.0f) {
+                continue;
+            }
+            BakeTriangle triangle;
+            triangle.normals[0] = TransformNormal(mesh.vertices[i0].normal, inverse);
+            triangle.normals[1] = TransformNormal(mesh.vertices[i1].normal, inverse);
+            triangle.normals[2] = TransformNormal(mesh.vertices[i2].normal, inverse);
+            triangle.geometricNormal = geometricNormal.Normalized();
+            triangle.mesh = meshIndex;
+            m_Triangles.push_back(triangle);
+            positions.push_back(p0);
+            positions.push_back(p1);
+            positions.push_back(p2);
+        }
+    }
+    m_BVH->Build(positions);
+
+    m_Stats.triangles = static_cast<uint32_t>(m_Triangles.size());
+    m_Stats.bvhNodes = m_BVH->GetNodeCount();
+    m_Stats.buildMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    RasterizeLightmaps();
+    m_SceneDirty = false;
+}
+
+void LightBaker::RasterizeLightmaps() {
+    int lightmapCount = 0;
+    for (const LightBakeMesh& mesh : m_Meshes) {
+        lightmapCount = std::max(lightmapCount, mesh.lightmapIndex + 1);
+    }
+
+    const int width = m_Config.lightmapWidth;
+    const int height = m_Config.lightmapHeight;
+    const size_t texelCount = static_cast<size_t>(width) * static_cast<size_t>(height);
+    std::vector<Lightmap> previous = std::move(m_Lightmaps);
+    m_Lightmaps.clear();
+    m_Lightmaps.resize(static_cast<size_t>(lightmapCount));
+
+    for (Lightmap& lightmap : m_Lightmaps) {
+        lightmap.texels.resize(texelCount);
+        lightmap.direct.assign(texelCount * 3, 0.0f);
+        lightmap.indirect.assign(texelCount * 3, 0.0f);
+        lightmap.valid.assign(texelCount, TEXEL_PENDING);
+        lightmap.output.width = width;
+        lightmap.output.height = height;
+        lightmap.output.pixels.assign(texelCount * 3, 0.0f);
+    }
+
+    // 在UV空间光栅化，纹素中心落在三角形内时记录插值后的世界位置和法线
+    for (uint32_t meshIndex = 0; meshIndex < m_Meshes.size(); ++meshIndex) {
+        const LightBakeMesh& mesh = m_Meshes[meshIndex];
+        if (mesh.lightmapIndex < 0) {
+            continue;
+        }
+        Lightmap& lightmap = m_Lightmaps[static_cast<size_t>(mesh.lightmapIndex)];
+        const Matrix4 inverse = mesh.transform.Inverse();
+        const uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+        const Vector4& scaleOffset = mesh.lightmapScaleOffset;
+
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            uint32_t index[3] = { mesh.indices[i], mesh.indices[i + 1], mesh.indices[i + 2] };
+            if (index[0] >= vertexCount || index[1] >= vertexCount || index[2] >= vertexCount) {
+                continue;
+            }
+            Vector3 position[3];
+            Vector3 normal[3];
+            float x[3];
+            float y[3];
+            for (int k = 0; k < 3; ++k) {
+                const Vertex& vertex = mesh.vertices[index[k]];
+                position[k] = TransformPoint(vertex.position, mesh.transform);
+                normal[k] = TransformNormal(vertex.normal, inverse);
+                x[k] = (vertex.texCoord.x * scaleOffset.x + scaleOffset.z) * static_cast<float>(width);
+                y[k] = (vertex.texCoord.y * scaleOffset.y + scaleOffset.w) * static_cast<float>(height);
+            }
+            const float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+            if (std::fabs(area) <= 1.0e-12f) {
+                continue;
+            }
+            const float worldArea = (position[1] - position[0]).Cross(position[2] - position[0]).Length();
+            const float texelSize = std::sqrt(worldArea / std::fabs(area));
+
+            auto write = [&](int px, int py, float w0, float w1, float w2) {
+                Texel& texel = lightmap.texels[static_cast<size_t>(py) * static_cast<size_t>(width) + static_cast<size_t>(px)];
+                if (texel.mesh != UNCOVERED) {
+                    return false;
+                }
+                texel.position = position[0] * w0 + position[1] * w1 + position[2] * w2;
+                texel.normal = (normal[0] * w0 + normal[1] * w1 + normal[2] * w2).Normalized();
+                texel.size = texelSize;
+                texel.mesh = meshIndex;
+                return true;
+            };
+
+            const int minX = std::max(0, static_cast<int>(std::floor(std::min({ x[0], x[1], x[2] }))));
+            const int maxX = std::min(width - 1, static_cast<int>(std::ceil(std::max({ x[0], x[1], x[2] }))));
+            const int minY = std::max(0, static_cast<int>(std::floor(std::min({ y[0], y[1], y[2] }))));
+            const int maxY = std::min(height - 1, static_cast<int>(std::ceil(std::max({ y[0], y[1], y[2] }))));
+            const float inverseArea = 1.0f / area;
+            bool covered = false;
+            for (int py = minY; py <= maxY; ++py) {
+                for (int px = minX; px <= maxX; ++px) {
+                    const float cx = static_cast<float>(px) + 0.5f;
+                    const float cy = static_cast<float>(py) + 0.5f;
+                    const float w0 = ((x[1] - cx) * (y[2] - cy) - (x[2] - cx) * (y[1] - cy)) * inverseArea;
+                    const float w1 = ((x[2] - cx) * (y[0] - cy) - (x[0] - cx) * (y[2] - cy)) * inverseArea;
+                    const float w2 = 1.0f - w0 - w1;
+                    if (w0 >= -1.0e-5f && w1 >= -1.0e-5f && w2 >= -1.0e-5f) {
+                        covered |= write(px, py, w0, w1, w2);
+                    }
+                }
+            }
+
+            // 没有覆盖任何纹素中心的小三角形写入其重心所在的纹素
+            if (!covered) {
+                const int px = static_cast<int>((x[0] + x[1] + x[2]) / 3.0f);
+                const int py = static_cast<int>((y[0] + y[1] + y[2]) / 3.0f);
+                if (px >= 0 && px < width && py >= 0 && py < height) {
+                    const float third = 1.0f / 3.0f;
+                    write(px, py, third, third, third);
+                }
+            }
+        }
+    }
+
+    // 几何信息没有变化的纹素保留上次的追踪结果，增量烘焙时不需要重新追踪
+    m_Stats.texels = 0;
+    for (size_t index = 0; index < m_Lightmaps.size(); ++index) {
+        Lightmap& lightmap = m_Lightmaps[index];
+        const bool comparable = index < previous.size() && previous[index].texels.size() == texelCount;
+        for (size_t i = 0; i < texelCount; ++i) {
+            const Texel& texel = lightmap.texels[i];
+            if (texel.mesh == UNCOVERED) {
+                continue;
+            }
+            ++m_Stats.texels;
+            if (!comparable) {
+                continue;
+            }
+            const Texel& old = previous[index].texels[i];
+            if (old.mesh == texel.mesh && (old.position - texel.position).LengthSquared() <= 1.0e-10f &&
+                old.normal.Dot(texel.normal) >= 0.9999f) {
+                lightmap.valid[i] = previous[index].valid[i];
+                std::copy_n(&previous[index].direct[i * 3], 3, &lightmap.direct[i * 3]);
+                std::copy_n(&previous[index].indirect[i * 3], 3, &lightmap.indirect[i * 3]);
+            }
+        }
+        if (comparable) {
+            lightmap.output.pixels = std::move(previous[index].output.pixels);
+        }
+    }
+}
+
+bool LightBaker::Bake() {
+    return Run(false);
+}
+
+bool LightBaker::BakeChanges() {
+    return Run(m_Baked);
+}
+
+bool LightBaker::Run(bool incremental) {
+    if (m_SceneDirty) {
+        BuildScene();
+    }
+    if (m_Triangles.empty()) {
+        std::cerr << "光照烘焙失败：场景中没有三角形！" << std::endl;
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const bool all = !incremental || m_AllDirty;
+
+    // 收集需要追踪的纹素和探针
+    struct WorkItem {
+        uint32_t lightmap;
+        uint32_t texel;
+    };
+    std::vector<WorkItem> texels;
+    std::vector<uint8_t> touched(m_Lightmaps.size(), 0);
+    for (uint32_t index = 0; index < m_Lightmaps.size(); ++index) {
+        Lightmap& lightmap = m_Lightmaps[index];
+        for (uint32_t i = 0; i < lightmap.texels.size(); ++i) {
+            const Texel& texel = lightmap.texels[i];
+            if (texel.mesh != UNCOVERED && (all || lightmap.valid[i] == TEXEL_PENDING || IsDirty(texel.position))) {
+                texels.push_back({ index, i });
+                touched[index] = 1;
+            }
+        }
+    }
+    std::vector<uint32_t> probes;
+    for (uint32_t i = 0; i < m_Probes.size(); ++i) {
+        if (all || !m_Probes[i].baked || IsDirty(m_Probes[i].position)) {
+            probes.push_back(i);
+        }
+    }
+
+    std::atomic<uint64_t> rays{0};
+    JobSystem& jobSystem = JobSystem::GetInstance();
+    jobSystem.ParallelFor(static_cast<uint32_t>(texels.size()), 16, [&](uint32_t begin, uint32_t end) {
+        uint64_t batchRays = 0;
+        for (uint32_t i = begin; i < end; ++i) {
+            const WorkItem& item = texels[i];
+            Sampler sampler((static_cast<uint64_t>(item.lightmap) << 32) | item.texel);
+            TraceTexel(m_Lightmaps[item.lightmap], item.texel, sampler);
+            batchRays += sampler.rays;
+        }
+        rays.fetch_add(batchRays, std::memory_order_relaxed);
+    });
+    jobSystem.ParallelFor(static_cast<uint32_t>(probes.size()), 1, [&](uint32_t begin, uint32_t end) {
+        uint64_t batchRays = 0;
+        for (uint32_t i = begin; i < end; ++i) {
+            Sampler sampler(0xB0B0000000000000ull | probes[i]);
+            TraceProbe(m_Probes[probes[i]], sampler);
+            batchRays += sampler.rays;
+        }
+        rays.fetch_add(batchRays, std::memory_order_relaxed);
+    });
+
+    m_Stats.rejectedTexels = 0;
+    for (size_t index = 0; index < m_Lightmaps.size(); ++index) {
+        Lightmap& lightmap = m_Lightmaps[index];
+        m_Stats.rejectedTexels += static_cast<uint32_t>(std::count(lightmap.valid.begin(), lightmap.valid.end(), static_cast<uint8_t>(TEXEL_REJECTED)));
+        if (touched[index]) {
+            Denoise(lightmap);
+            Dilate(lightmap);
+        }
+    }
+
+    m_Stats.bakedTexels = static_cast<uint32_t>(texels.size());
+    m_Stats.bakedProbes = static_cast<uint32_t>(probes.size());
+    m_Stats.rays = rays.load();
+    m_Stats.bakeMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    m_DirtyRegions.clear();
+    m_AllDirty = false;
+    m_Baked = true;
+    return true;
+}
+
+void LightBaker::TraceTexel(Lightmap& lightmap, uint32_t index, Sampler& sampler) const {
+    const Texel& texel = lightmap.texels[index];
+    const Vector3 origin = texel.position + texel.normal * m_Config.rayBias;
+
+    // 只有带半径的光源需要逐样本计算直接光，硬阴影算一次即可
+    const bool softLights = std::any_of(m_Lights.begin(), m_Lights.end(),
+                                        [](const BakeLight& light) { return light.enabled && light.radius > 0.0f; });
+
+    const uint32_t samples = m_Config.samplesPerTexel;
+    const uint32_t strata = static_cast<uint32_t>(std::sqrt(static_cast<float>(samples)));
+    Vector3 indirect;
+    Vector3 direct;
+    uint32_t directSamples = 0;
+    uint32_t backfaces = 0;
+    for (uint32_t s = 0; s < samples; ++s) {
+        float u1;
+        float u2;
+        sampler.Stratified(s, strata, u1, u2);
+        bool backface = false;
+        indirect += TraceRadiance(origin, CosineHemisphere(texel.normal, u1, u2), sampler, &backface);
+        backfaces += backface ? 1 : 0;
+        if (softLights || s == 0) {
+            direct += DirectLight(origin, texel.normal, sampler);
+            ++directSamples;
+        }
+    }
+
+    indirect /= static_cast<float>(samples);
+    direct /= static_cast<float>(directSamples);
+    float* directOutput = &lightmap.direct[static_cast<size_t>(index) * 3];
+    directOutput[0] = direct.x;
+    directOutput[1] = direct.y;
+    directOutput[2] = direct.z;
+    float* indirectOutput = &lightmap.indirect[static_cast<size_t>(index) * 3];
+    indirectOutput[0] = indirect.x;
+    indirectOutput[1] = indirect.y;
+    indirectOutput[2] = indirect.z;
+    lightmap.valid[index] = static_cast<float>(backfaces) > m_Config.backfaceTolerance * static_cast<float>(samples)
+                                ? TEXEL_REJECTED
+                                : TEXEL_VALID;
+}
+
+void LightBaker::TraceProbe(Probe& probe, Sampler& sampler) const {
+    const uint32_t samples = m_Config.samplesPerProbe;
+    const uint32_t strata = static_cast<uint32_t>(std::sqrt(static_cast<float>(samples)));
+    LightProbeSH sh;
+    float basis[9];
+    for (uint32_t s = 0; s < samples; ++s) {
+        float u1;
+        float u2;
+        sampler.Stratified(s, strata, u1, u2);
+        const Vector3 direction = UniformSphere(u1, u2);
+        const Vector3 radiance = TraceRadiance(probe.position, direction, sampler, nullptr);
+        EvaluateSHBasis(direction, basis);
+        for (int i = 0; i < 9; ++i) {
+            sh.coefficients[i][0] += radiance.x * basis[i];
+            sh.coefficients[i][1] += radiance.y * basis[i];
+            sh.coefficients[i][2] += radiance.z * basis[i];
+        }
+    }
+    // 均匀球面采样的概率密度为1/(4π)
+    const float weight = 4.0f * PI / static_cast<float>(samples);
+    for (auto& coefficient : sh.coefficients) {
+        coefficient[0] *= weight;
+        coefficient[1] *= weight;
+        coefficient[2] *= weight;
+    }
+
+    // 光线不会命中点光源和方向光，直接投影：强度为I的光源相当于辐亮度为π * I的delta分布，
+    // 这样EvaluateProbe得到的I * cos与光照贴图的直接光一致
+    for (const BakeLight& light : m_Lights) {
+        if (!light.enabled) {
+            continue;
+        }
+        const uint32_t lightSamples = light.radius > 0.0f ? 16 : 1;
+        for (uint32_t s = 0; s < lightSamples; ++s) {
+            Vector3 toLight;
+            Vector3 intensity;
+            if (!SampleLight(light, probe.position, sampler, toLight, intensity)) {
+                continue;
+            }
+            EvaluateSHBasis(toLight, basis);
+            const Vector3 scaled = intensity * (PI / static_cast<float>(lightSamples));
+            for (int i = 0; i < 9; ++i) {
+                sh.coefficients[i][0] += scaled.x * basis[i];
+                sh.coefficients[i][1] += scaled.y * basis[i];
+                sh.coefficients[i][2] += scaled.z * basis[i];
+            }
+        }
+    }
+    probe.sh = sh;
+    probe.baked = true;
+}
+
+Vector3 LightBaker::TraceRadiance(const Vector3& origin, const Vector3& direction, Sampler& sampler, bool* backface) const {
+    Vector3 result;
+    Vector3 throughput(1.0f, 1.0f, 1.0f);
+    Vector3 rayOrigin = origin;
+    Vector3 rayDirection = direction;
+
+    for (uint32_t bounce = 0;; ++bounce) {
+        BakeHit hit;
+        ++sampler.rays;
+        if (!m_BVH->Intersect(rayOrigin, rayDirection, std::numeric_limits<float>::max(), hit)) {
+            result += Multiply(throughput, m_SkyColor);
+            break;
+        }
+
+        const BakeTriangle& triangle = m_Triangles[hit.triangle];
+        const LightBakeMesh& mesh = m_Meshes[triangle.mesh];
+        Vector3 geometricNormal = triangle.geometricNormal;
+        Vector3 normal = (triangle.normals[0] * (1.0f - hit.u - hit.v) + triangle.normals[1] * hit.u + triangle.normals[2] * hit.v).Normalized();
+        const bool back = geometricNormal.Dot(rayDirection) > 0.0f;
+        if (bounce == 0 && backface) {
+            *backface = back;
+        }
+        // 双面着色：法线翻转到光线来的一侧
+        if (back) {
+            geometricNormal = geometricNormal * -1.0f;
+            normal = normal * -1.0f;
+        }
+        if (normal.Dot(geometricNormal) <= 0.0f) {
+            normal = geometricNormal;
+        }
+
+        result += Multiply(throughput, mesh.emission);
+        if (bounce >= m_Config.maxBounces) {
+            break;
+        }
+
+        const Vector3 position = rayOrigin + rayDirection * hit.t + geometricNormal * m_Config.rayBias;
+        throughput = Multiply(throughput, mesh.albedo);
+        result += Multiply(throughput, DirectLight(position, normal, sampler));
+
+        // 余弦采样时漫反射的BRDF、余弦项和概率密度相消，路径权重只乘反射率
+        if (bounce >= 2) {
+            const float survival = std::min(std::max(std::max(throughput.x, throughput.y), std::max(throughput.z, 0.05f)), 1.0f);
+            if (sampler.Next() >= survival) {
+                break;
+            }
+            throughput /= survival;
+        }
+        rayOrigin = position;
+        rayDirection = CosineHemisphere(normal, sampler.Next(), sampler.Next());
+    }
+    return result;
+}
+
+bool LightBaker::SampleLight(const BakeLight& light, const Vector3& position, Sampler& sampler,
+                             Vector3& toLight, Vector3& intensity) const {
+    const ClusterLightData& data = light.data;
+    const Vector3 color = Vector3(data.color[0], data.color[1], data.color[2]) * data.intensity;
+    const Vector3 lightDirection = Vector3(data.direction[0], data.direction[1], data.direction[2]).Normalized();
+
+    if (data.type == static_cast<uint32_t>(LightType::Directional)) {
+        toLight = lightDirection * -1.0f;
+        if (light.radius > 0.0f) {
+            toLight = UniformCone(toLight, light.radius, sampler.Next(), sampler.Next());
+        }
+        ++sampler.rays;
+        if (m_BVH->Occluded(position, toLight, std::numeric_limits<float>::max())) {
+            return false;
+        }
+        intensity = color;
+        return true;
+    }
+
+    Vector3 lightPosition(data.position[0], data.position[1], data.position[2]);
+    if (light.radius > 0.0f) {
+        lightPosition += UniformSphere(sampler.Next(), sampler.Next()) * (light.radius * std::cbrt(sampler.Next()));
+    }
+    const Vector3 offset = lightPosition - position;
+    const float distanceSquared = offset.LengthSquared();
+    const float distance = std::sqrt(distanceSquared);
+    if (distance >= data.range || distance <= 1.0e-6f) {
+        return false;
+    }
+    toLight = offset / distance;
+    const float ratio = distance / data.range;
+    const float window = Saturate(1.0f - ratio * ratio * ratio * ratio);
+    float attenuation = window * window / std::max(distanceSquared, 1.0e-4f);
+    if (data.type == static_cast<uint32_t>(LightType::Spot)) {
+        attenuation *= Saturate((toLight * -1.0f).Dot(lightDirection) * data.spotScale + data.spotOffset);
+    }
+    if (attenuation <= 0.0f) {
+        return false;
+    }
+    ++sampler.rays;
+    if (m_BVH->Occluded(position, toLight, distance - m_Config.rayBias)) {
+        return false;
+    }
+    intensity = color * attenuation;
+    return true;
+}
+
+Vector3 LightBaker::DirectLight(const Vector3& position, const Vector3& normal, Sampler& sampler) const {
+    Vector3 result;
+    for (const BakeLight& light : m_Lights) {
+        if (!light.enabled) {
+            continue;
+        }
+        Vector3 toLight;
+        Vector3 intensity;
+        // 先排除背向的光源，省去阴影光线（带半径的光源按中心方向粗略判断）
+        if (light.radius == 0.0f && light.data.type != static_cast<uint32_t>(LightType::Directional)) {
+            const Vector3 center(light.data.position[0], light.data.position[1], light.data.position[2]);
+            if ((center - position).Dot(normal) <= 0.0f) {
+                continue;
+            }
+        }
+        if (SampleLight(light, position, sampler, toLight, intensity)) {
+            result += intensity * std::max(normal.Dot(toLight), 0.0f);
+        }
+    }
+    return result;
+}
+
+void LightBaker::Denoise(Lightmap& lightmap) const {
+    const int width = lightmap.output.width;
+    const int height = lightmap.output.height;
+    std::vector<float>& output = lightmap.output.pixels;
+    if (!m_Config.denoise) {
+        for (size_t i = 0; i < lightmap.texels.size(); ++i) {
+            const bool valid = lightmap.valid[i] == TEXEL_VALID;
+            for (int c = 0; c < 3; ++c) {
+                output[i * 3 + c] = valid ? lightmap.direct[i * 3 + c] + lightmap.indirect[i * 3 + c] : 0.0f;
+            }
+        }
+        return;
+    }
+
+    // 噪声来自间接光的半球采样，只滤波间接光，直接光原样加回，阴影边缘保持锐利。
+    // 权重为空间高斯乘以法线相似度和到中心纹素切平面的距离权重（几何引导，没有亮度项），
+    // UV图集中相邻但世界空间不相邻的纹素（不同的UV块）被位置权重排除
+    const int radius = m_Config.denoiseRadius;
+    const float spatialSigma = std::max(0.5f * static_cast<float>(radius), 0.5f);
+    const float spatialFactor = -1.0f / (2.0f * spatialSigma * spatialSigma);
+    JobSystem::GetInstance().ParallelFor(static_cast<uint32_t>(height), 4, [&](uint32_t begin, uint32_t end) {
+        for (int y = static_cast<int>(begin); y < static_cast<int>(end); ++y) {
+            for (int x = 0; x < width; ++x) {
+                const size_t center = static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x);
+                if (lightmap.valid[center] != TEXEL_VALID) {
+                    output[center * 3] = output[center * 3 + 1] = output[center * 3 + 2] = 0.0f;
+                    continue;
+                }
+                const Texel& centerTexel = lightmap.texels[center];
+                const float size = std::max(centerTexel.size, 1.0e-6f);
+                const float maxDistance = 2.0f * static_cast<float>(radius + 1) * size;
+                float sum[3] = {};
+                float weightSum = 0.0f;
+                for (int dy = -radius; dy <= radius; ++dy) {
+                    const int sy = y + dy;
+                    if (sy < 0 || sy >= height) {
+                        continue;
+                    }
+                    for (int dx = -radius; dx <= radius; ++dx) {
+                        const int sx = x + dx;
+                        if (sx < 0 || sx >= width) {
+                            continue;
+                        }
+                        const size_t neighbor = static_cast<size_t>(sy) * static_cast<size_t>(width) + static_cast<size_t>(sx);
+                        if (lightmap.valid[neighbor] != TEXEL_VALID) {
+                            continue;
+                        }
+                        const Texel& texel = lightmap.texels[neighbor];
+                        const Vector3 offset = texel.position - centerTexel.position;
+                        if (offset.LengthSquared() > maxDistance * maxDistance) {
+                            continue;
+                        }
+                        float normalWeight = std::max(texel.normal.Dot(centerTexel.normal), 0.0f);
+                        normalWeight *= normalWeight;
+                        normalWeight *= normalWeight;
+                        normalWeight *= normalWeight;
+                        const float plane = offset.Dot(centerTexel.normal) / size;
+                        const float weight = std::exp(static_cast<float>(dx * dx + dy * dy) * spatialFactor - plane * plane) * normalWeight;
+                        sum[0] += lightmap.indirect[neighbor * 3] * weight;
+                        sum[1] += lightmap.indirect[neighbor * 3 + 1] * weight;
+                        sum[2] += lightmap.indirect[neighbor * 3 + 2] * weight;
+                        weightSum += weight;
+                    }
+                }
+                // 中心纹素自身的权重为1，weightSum不会为0
+                for (int c = 0; c < 3; ++c) {
+                    output[center * 3 + c] = lightmap.direct[center * 3 + c] + sum[c] / weightSum;
+                }
+            }
+        }
+    });
+}
+
+void LightBaker::Dilate(Lightmap& lightmap) const {
+    const int width = lightmap.output.width;
+    const int height = lightmap.output.height;
+    std::vector<float>& output = lightmap.output.pixels;
+    std::vector<uint8_t> filled(lightmap.valid.size());
+    for (size_t i = 0; i < filled.size(); ++i) {
+        filled[i] = lightmap.valid[i] == TEXEL_VALID ? 1 : 0;
+    }
+
+    // 每一圈只从上一圈已填充的纹素取值
+    std::vector<uint8_t> next;
+    for (int pass = 0; pass < m_Config.dilation; ++pass) {
+        next = filled;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                const size_t center = static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x);
+                if (filled[center]) {
+                    continue;
+                }
+                float sum[3] = {};
+                int count = 0;
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        const int sx = x + dx;
+                        const int sy = y + dy;
+                        if (sx < 0 || sx >= width || sy < 0 || sy >= height) {
+                            continue;
+                        }
+                        const size_t neighbor = static_cast<size_t>(sy) * static_cast<size_t>(width) + static_cast<size_t>(sx);
+                        if (!filled[neighbor]) {
+                            continue;
+                        }
+                        sum[0] += output[neighbor * 3];
+                        sum[1] += output[neighbor * 3 + 1];
+                        sum[2] += output[neighbor * 3 + 2];
+                        ++count;
+                    }
+                }
+                if (count > 0) {
+                    for (int c = 0; c < 3; ++c) {
+                        output[center * 3 + c] = sum[c] / static_cast<float>(count);
+                    }
+                    next[center] = 1;
+                }
+            }
+        }
+        filled.swap(next);
+    }
+}
+
+TextureData LightBaker::ExportLightmapRGBM(uint32_t index, float range) const {
+    TextureData data;
+    if (index >= m_Lightmaps.size()) {
+        return data;
+    }
+    const LightmapData& lightmap = m_Lightmaps[index].output;
+    data.format = TextureFormat::RGBA8;
+    data.width = static_cast<uint32_t>(lightmap.width);
+    data.height = static_cast<uint32_t>(lightmap.height);
+    const size_t texelCount = static_cast<size_t>(lightmap.width) * static_cast<size_t>(lightmap.height);
+    data.pixels.resize(texelCount * 4);
+    range = std::max(range, 1.0e-3f);
+    for (size_t i = 0; i < texelCount; ++i) {
+        const float* color = &lightmap.pixels[i * 3];
+        // 乘数向上取整到8位，保证rgb不超过1
+        float multiplier = Saturate(std::max(std::max(color[0], color[1]), std::max(color[2], 1.0e-6f)) / range);
+        multiplier = std::ceil(multiplier * 255.0f) / 255.0f;
+        const float scale = 1.0f / (multiplier * range);
+        for (int c = 0; c < 3; ++c) {
+            data.pixels[i * 4 + c] = static_cast<uint8_t>(Saturate(color[c] * scale) * 255.0f + 0.5f);
+        }
+        data.pixels[i * 4 + 3] = static_cast<uint8_t>(multiplier * 255.0f + 0.5f);
+    }
+    TextureMipLevel mip;
+    mip.width = data.width;
+    mip.height = data.height;
+    mip.offset = 0;
+    mip.size = data.pixels.size();
+    data.mips.push_back(mip);
+    return data;
+}
+
+Vector3 LightBaker::EvaluateProbe(const LightProbeSH& probe, const Vector3& normal) {
+    // 与余弦核卷积得到辐照度（Ramamoorthi和Hanrahan），再除以π与光照贴图的约定一致
+    static const float bandScale[9] = { 1.0f, 2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f };
+    float basis[9];
+    EvaluateSHBasis(normal, basis);
+    float result[3] = {};
+    for (int i = 0; i < 9; ++i) {
+        const float weight = basis[i] * bandScale[i];
+        result[0] += probe.coefficients[i][0] * weight;
+        result[1] += probe.coefficients[i][1] * weight;
+        result[2] += probe.coefficients[i][2] * weight;
+    }
+    return Vector3(std::max(result[0], 0.0f), std::max(result[1], 0.0f), std::max(result[2], 0.0f));
+}
+
+} // namespace PLE
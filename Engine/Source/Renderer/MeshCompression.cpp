@@ -0,0 +1,503 @@
+/**
+ * @file MeshCompression.cpp
+ * @brief 量化顶点格式和无损的顶点/索引缓冲编解码实现
+ */
+
+#include "Renderer/MeshCompression.h"
+#include "Renderer/RenderResources.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+#ifdef PLE_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace PLE {
+
+namespace {
+
+constexpr uint32_t VertexCodecMagic = 0x43564C50;   // "PLVC"
+constexpr uint32_t IndexCodecMagic = 0x43494C50;    // "PLIC"
+constexpr uint32_t CodecVersion = 1;
+constexpr size_t HeaderSize = 16;
+constexpr uint32_t MaxVertexSize = 256;
+
+// 每块的顶点数：一块的输出（最多256 * 256字节）留在缓存中，按字节通道分散写入时不会反复未命中
+constexpr uint32_t BlockVertices = 256;
+constexpr uint32_t GroupSize = 16;
+
+void WriteUint32(std::vector<uint8_t>& output, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        output.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+}
+
+uint32_t ReadUint32(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+           (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+uint8_t ZigZag8(uint8_t delta) {
+    return static_cast<uint8_t>((delta << 1) ^ static_cast<uint8_t>(static_cast<int8_t>(delta) >> 7));
+}
+
+#ifndef PLE_SIMD_SSE2
+uint8_t UnZigZag8(uint8_t value) {
+    return static_cast<uint8_t>((value >> 1) ^ static_cast<uint8_t>(-(value & 1)));
+}
+#endif
+
+/**
+ * @brief 组内所有值都能用多少位表示：0、2、4或8，对应的2位编码为0到3
+ */
+uint32_t GetGroupBitsCode(const uint8_t* values) {
+    uint8_t maximum = 0;
+    for (uint32_t i = 0; i < GroupSize; ++i) {
+        maximum = std::max(maximum, values[i]);
+    }
+    if (maximum == 0) {
+        return 0;
+    }
+    if (maximum < 4) {
+        return 1;
+    }
+    return maximum < 16 ? 2 : 3;
+}
+
+// 每种位宽一组占用的字节数
+constexpr size_t GroupPayloadSize[4] = { 0, 4, 8, 16 };
+
+void EncodeGroup(std::vector<uint8_t>& output, const uint8_t* values, uint32_t code) {
+    switch (code) {
+    case 1:
+        // 第4j + m个值在第j个字节的第2m位
+        for (uint32_t j = 0; j < 4; ++j) {
+            output.push_back(static_cast<uint8_t>(values[4 * j] | (values[4 * j + 1] << 2) |
+                                                  (values[4 * j + 2] << 4) | (values[4 * j + 3] << 6)));
+        }
+        break;
+    case 2:
+        // 第2j个值在第j个字节的低4位
+        for (uint32_t j = 0; j < 8; ++j) {
+            output.push_back(static_cast<uint8_t>(values[2 * j] | (values[2 * j + 1] << 4)));
+        }
+        break;
+    case 3:
+        output.insert(output.end(), values, values + GroupSize);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 解码一组16个值并累加到last上，写入output（步长stride），只写前count个
+ */
+void DecodeGroup(const uint8_t* payload, uint32_t code, uint8_t& last, uint8_t* output, uint32_t stride, uint32_t count) {
+#ifdef PLE_SIMD_SSE2
+    __m128i values;
+    switch (code) {
+    case 1: {
+        int32_t packed;
+        std::memcpy(&packed, payload, sizeof(packed));
+        const __m128i bytes = _mm_cvtsi32_si128(packed);
+        const __m128i mask = _mm_set1_epi8(3);
+        // 16位移位会把高字节的位移入低字节的高位，按字节掩码后去掉
+        const __m128i v0 = _mm_and_si128(bytes, mask);
+        const __m128i v1 = _mm_and_si128(_mm_srli_epi16(bytes, 2), mask);
+        const __m128i v2 = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+        const __m128i v3 = _mm_and_si128(_mm_srli_epi16(bytes, 6), mask);
+        values = _mm_unpacklo_epi16(_mm_unpacklo_epi8(v0, v1), _mm_unpacklo_epi8(v2, v3));
+        break;
+    }
+    case 2: {
+        const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(payload));
+        const __m128i mask = _mm_set1_epi8(0x0F);
+        values = _mm_unpacklo_epi8(_mm_and_si128(bytes, mask), _mm_and_si128(_mm_srli_epi16(bytes, 4), mask));
+        break;
+    }
+    case 3:
+        values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(payload));
+        break;
+    default:
+        values = _mm_setzero_si128();
+        break;
+    }
+
+    // 反zigzag：(v >> 1) ^ -(v & 1)
+    const __m128i half = _mm_and_si128(_mm_srli_epi16(values, 1), _mm_set1_epi8(0x7F));
+    const __m128i sign = _mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(values, _mm_set1_epi8(1)));
+    __m128i deltas = _mm_xor_si128(half, sign);
+
+    // 对数步前缀和，再加上前一组的最后一个值
+    deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 1));
+    deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 2));
+    deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 4));
+    deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 8));
+    deltas = _mm_add_epi8(deltas, _mm_set1_epi8(static_cast<char>(last)));
+
+    alignas(16) uint8_t decoded[GroupSize];
+    _mm_store_si128(reinterpret_cast<__m128i*>(decoded), deltas);
+    for (uint32_t i = 0; i < count; ++i) {
+        output[i * stride] = decoded[i];
+    }
+    // 补齐的值差为0，最后一个值即最后一个有效值
+    last = decoded[GroupSize - 1];
+#else
+    for (uint32_t i = 0; i < GroupSize; ++i) {
+        uint8_t value = 0;
+        switch (code) {
+        case 1:
+            value = (payload[i / 4] >> ((i % 4) * 2)) & 3;
+            break;
+        case 2:
+            value = (payload[i / 2] >> ((i % 2) * 4)) & 0x0F;
+            break;
+        case 3:
+            value = payload[i];
+            break;
+        default:
+            break;
+        }
+        last = static_cast<uint8_t>(last + UnZigZag8(value));
+        if (i < count) {
+            output[i * stride] = last;
+        }
+    }
+#endif
+}
+
+int16_t ToSnorm16(float value) {
+    value = std::min(std::max(value, -1.0f), 1.0f);
+    return static_cast<int16_t>(std::lround(value * 32767.0f));
+}
+
+} // namespace
+
+VertexLayout MeshCompression::QuantizeVertices(const Vertex* vertices, uint32_t vertexCount, std::vector<QuantizedVertex>& output) {
+    VertexLayout layout;
+    layout.attributes = {
+        { 0, VertexAttributeFormat::Unorm16x4, static_cast<uint32_t>(offsetof(QuantizedVertex, position)) },
+        { 1, VertexAttributeFormat::Snorm16x2, static_cast<uint32_t>(offsetof(QuantizedVertex, normal)) },
+        { 2, VertexAttributeFormat::Half2, static_cast<uint32_t>(offsetof(QuantizedVertex, texCoord)) }
+    };
+    layout.stride = sizeof(QuantizedVertex);
+
+    output.resize(vertexCount);
+    if (vertexCount == 0) {
+        return layout;
+    }
+
+    Vector3 boundsMin(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+    Vector3 boundsMax(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        const Vector3& p = vertices[i].position;
+        boundsMin = Vector3(std::min(boundsMin.x, p.x), std::min(boundsMin.y, p.y), std::min(boundsMin.z, p.z));
+        boundsMax = Vector3(std::max(boundsMax.x, p.x), std::max(boundsMax.y, p.y), std::max(boundsMax.z, p.z));
+    }
+
+    // 三个轴使用相同的缩放（最长边），解码矩阵保持等比，法线无需额外变换
+    float extent = std::max(std::max(boundsMax.x - boundsMin.x, boundsMax.y - boundsMin.y), boundsMax.z - boundsMin.z);
+    if (extent <= 0.0f) {
+        extent = 1.0f;
+    }
+    layout.positionOffset = boundsMin;
+    layout.positionScale = extent;
+
+    const float quantizeScale = 65535.0f / extent;
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        const Vertex& vertex = vertices[i];
+        QuantizedVertex& quantized = output[i];
+        const float position[3] = { vertex.position.x - boundsMin.x, vertex.position.y - boundsMin.y,
+                                    vertex.position.z - boundsMin.z };
+        for (int axis = 0; axis < 3; ++axis) {
+            const float value = std::min(std::max(position[axis] * quantizeScale, 0.0f), 65535.0f);
+            quantized.position[axis] = static_cast<uint16_t>(std::lround(value));
+        }
+        quantized.position[3] = 65535;
+        EncodeOctahedral(vertex.normal, quantized.normal);
+        quantized.texCoord[0] = FloatToHalf(vertex.texCoord.x);
+        quantized.texCoord[1] = FloatToHalf(vertex.texCoord.y);
+    }
+    return layout;
+}
+
+void MeshCompression::DequantizeVertices(const QuantizedVertex* vertices, uint32_t vertexCount, const VertexLayout& layout,
+                                         std::vector<Vertex>& output) {
+    output.resize(vertexCount);
+    const float scale = layout.positionScale / 65535.0f;
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        const QuantizedVertex& quantized = vertices[i];
+        Vertex& vertex = output[i];
+        vertex.position = Vector3(quantized.position[0] * scale + layout.positionOffset.x,
+                                  quantized.position[1] * scale + layout.positionOffset.y,
+                                  quantized.position[2] * scale + layout.positionOffset.z);
+        vertex.normal = DecodeOctahedral(quantized.normal);
+        vertex.texCoord = Vector2(HalfToFloat(quantized.texCoord[0]), HalfToFloat(quantized.texCoord[1]));
+    }
+}
+
+void MeshCompression::EncodeOctahedral(const Vector3& direction, int16_t encoded[2]) {
+    const float length = std::fabs(direction.x) + std::fabs(direction.y) + std::fabs(direction.z);
+    if (length <= 0.0f) {
+        encoded[0] = 0;
+        encoded[1] = 0;
+        return;
+    }
+    // 投影到八面体，下半球沿对角线折叠到上半球的外侧
+    float x = direction.x / length;
+    float y = direction.y / length;
+    if (direction.z < 0.0f) {
+        const float foldedX = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        const float foldedY = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = foldedX;
+        y = foldedY;
+    }
+    encoded[0] = ToSnorm16(x);
+    encoded[1] = ToSnorm16(y);
+}
+
+Vector3 MeshCompression::DecodeOctahedral(const int16_t encoded[2]) {
+    // 与GPU的Snorm16解码一致：-32768也映射为-1
+    const float x = std::max(encoded[0] / 32767.0f, -1.0f);
+    const float y = std::max(encoded[1] / 32767.0f, -1.0f);
+    Vector3 direction(x, y, 1.0f - std::fabs(x) - std::fabs(y));
+    const float t = std::max(-direction.z, 0.0f);
+    direction.x += direction.x >= 0.0f ? -t : t;
+    direction.y += direction.y >= 0.0f ? -t : t;
+    return direction.Normalized();
+}
+
+uint16_t MeshCompression::FloatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    const uint32_t magnitude = bits & 0x7FFFFFFF;
+
+    if (magnitude >= 0x7F800000) {
+        // 无穷大和NaN（保留一个尾数位区分NaN）
+        return static_cast<uint16_t>(sign | 0x7C00 | (magnitude > 0x7F800000 ? 0x0200 : 0));
+    }
+    if (magnitude >= 0x477FF000) {
+        // 舍入后超出半精度范围
+        return static_cast<uint16_t>(sign | 0x7C00);
+    }
+    if (magnitude < 0x38800000) {
+        // 半精度的非规格化数：按2^-24的整数倍就近舍入（偶数优先）
+        if (magnitude < 0x33000000) {
+            return sign;
+        }
+        const uint32_t exponent = magnitude >> 23;
+        const uint32_t mantissa = (magnitude & 0x007FFFFF) | 0x00800000;
+        const uint32_t shift = 126 - exponent;
+        uint32_t half = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        const uint32_t midpoint = 1u << (shift - 1);
+        if (remainder > midpoint || (remainder == midpoint && (half & 1))) {
+            ++half;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    // 规格化数：重新偏置指数，尾数就近舍入（偶数优先），进位会自然进入指数
+    const uint32_t rebased = magnitude - 0x38000000;
+    uint32_t half = rebased >> 13;
+    const uint32_t remainder = rebased & 0x1FFF;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) {
+        ++half;
+    }
+    return static_cast<uint16_t>(sign | half);
+}
+
+float MeshCompression::HalfToFloat(uint16_t value) {
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1F;
+    uint32_t mantissa = value & 0x03FF;
+    uint32_t bits;
+    if (exponent == 0x1F) {
+        bits = sign | 0x7F800000 | (mantissa << 13);
+    } else if (exponent != 0) {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    } else if (mantissa != 0) {
+        // 非规格化数：规格化尾数
+        uint32_t shift = 0;
+        while ((mantissa & 0x0400) == 0) {
+            mantissa <<= 1;
+            ++shift;
+        }
+        bits = sign | ((113 - shift) << 23) | ((mantissa & 0x03FF) << 13);
+    } else {
+        bits = sign;
+    }
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+std::vector<uint8_t> MeshCompression::EncodeVertexBuffer(const void* vertices, uint32_t vertexCount, uint32_t vertexSize) {
+    std::vector<uint8_t> output;
+    if ((!vertices && vertexCount > 0) || vertexSize == 0 || vertexSize > MaxVertexSize) {
+        std::cerr << "顶点缓冲编码参数无效！" << std::endl;
+        return output;
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(vertices);
+    output.reserve(HeaderSize + static_cast<size_t>(vertexCount) * vertexSize / 2);
+    WriteUint32(output, VertexCodecMagic);
+    WriteUint32(output, CodecVersion);
+    WriteUint32(output, vertexCount);
+    WriteUint32(output, vertexSize);
+
+    std::vector<uint8_t> last(vertexSize, 0);
+    uint8_t values[BlockVertices];
+    for (uint32_t blockBegin = 0; blockBegin < vertexCount; blockBegin += BlockVertices) {
+        const uint32_t blockCount = std::min(BlockVertices, vertexCount - blockBegin);
+        const uint32_t groupCount = (blockCount + GroupSize - 1) / GroupSize;
+
+        for (uint32_t channel = 0; channel < vertexSize; ++channel) {
+            // 与上一个顶点的同一字节做差，补齐的部分差为0
+            std::fill(values, values + groupCount * GroupSize, 0);
+            uint8_t previous = last[channel];
+            for (uint32_t i = 0; i < blockCount; ++i) {
+                const uint8_t current = bytes[static_cast<size_t>(blockBegin + i) * vertexSize + channel];
+                values[i] = ZigZag8(static_cast<uint8_t>(current - previous));
+                previous = current;
+            }
+            last[channel] = previous;
+
+            // 先写全部组的位宽编码（每字节4组），再写各组数据
+            const size_t headerOffset = output.size();
+            output.resize(headerOffset + (groupCount + 3) / 4, 0);
+            for (uint32_t group = 0; group < groupCount; ++group) {
+                const uint8_t* groupValues = values + group * GroupSize;
+                const uint32_t code = GetGroupBitsCode(groupValues);
+                output[headerOffset + group / 4] |= static_cast<uint8_t>(code << ((group % 4) * 2));
+                EncodeGroup(output, groupValues, code);
+            }
+        }
+    }
+    return output;
+}
+
+bool MeshCompression::DecodeVertexBuffer(const uint8_t* data, size_t size, std::vector<uint8_t>& vertices,
+                                         uint32_t& vertexCount, uint32_t& vertexSize) {
+    if (!data || size < HeaderSize || ReadUint32(data) != VertexCodecMagic || ReadUint32(data + 4) != CodecVersion) {
+        std::cerr << "顶点缓冲数据格式无效！" << std::endl;
+        return false;
+    }
+    vertexCount = ReadUint32(data + 8);
+    vertexSize = ReadUint32(data + 12);
+    if (vertexSize == 0 || vertexSize > MaxVertexSize) {
+        std::cerr << "顶点缓冲数据格式无效！" << std::endl;
+        return false;
+    }
+
+    // 每个块的每个通道至少有组位宽编码（每字节4组），先检查再分配，避免损坏的数据导致巨大的分配
+    const uint32_t fullBlocks = vertexCount / BlockVertices;
+    const uint32_t remainderGroups = (vertexCount % BlockVertices + GroupSize - 1) / GroupSize;
+    const size_t minimumSize = (static_cast<size_t>(fullBlocks) * ((BlockVertices / GroupSize + 3) / 4) + (remainderGroups + 3) / 4) *
+                               vertexSize;
+    if (size - HeaderSize < minimumSize) {
+        std::cerr << "顶点缓冲数据不完整！" << std::endl;
+        return false;
+    }
+
+    vertices.resize(static_cast<size_t>(vertexCount) * vertexSize);
+    std::vector<uint8_t> last(vertexSize, 0);
+    const uint8_t* cursor = data + HeaderSize;
+    const uint8_t* end = data + size;
+
+    for (uint32_t blockBegin = 0; blockBegin < vertexCount; blockBegin += BlockVertices) {
+        const uint32_t blockCount = std::min(BlockVertices, vertexCount - blockBegin);
+        const uint32_t groupCount = (blockCount + GroupSize - 1) / GroupSize;
+        const size_t headerSize = (groupCount + 3) / 4;
+        uint8_t* blockOutput = vertices.data() + static_cast<size_t>(blockBegin) * vertexSize;
+
+        for (uint32_t channel = 0; channel < vertexSize; ++channel) {
+            if (static_cast<size_t>(end - cursor) < headerSize) {
+                std::cerr << "顶点缓冲数据不完整！" << std::endl;
+                return false;
+            }
+            const uint8_t* header = cursor;
+            cursor += headerSize;
+
+            for (uint32_t group = 0; group < groupCount; ++group) {
+                const uint32_t code = (header[group / 4] >> ((group % 4) * 2)) & 3;
+                const size_t payloadSize = GroupPayloadSize[code];
+                if (static_cast<size_t>(end - cursor) < payloadSize) {
+                    std::cerr << "顶点缓冲数据不完整！" << std::endl;
+                    return false;
+                }
+                const uint32_t first = group * GroupSize;
+                DecodeGroup(cursor, code, last[channel], blockOutput + static_cast<size_t>(first) * vertexSize + channel,
+                            vertexSize, std::min(GroupSize, blockCount - first));
+                cursor += payloadSize;
+            }
+        }
+    }
+    return true;
+}
+
+std::vector<uint8_t> MeshCompression::EncodeIndexBuffer(const uint32_t* indices, uint32_t indexCount) {
+    std::vector<uint8_t> output;
+    output.reserve(HeaderSize + indexCount);
+    WriteUint32(output, IndexCodecMagic);
+    WriteUint32(output, CodecVersion);
+    WriteUint32(output, indexCount);
+    WriteUint32(output, 0);
+
+    uint32_t previous = 0;
+    for (uint32_t i = 0; i < indexCount; ++i) {
+        // 32位回绕的差值zigzag后按7位一组的变长整数存储
+        const uint32_t delta = indices[i] - previous;
+        uint32_t value = (delta << 1) ^ static_cast<uint32_t>(static_cast<int32_t>(delta) >> 31);
+        previous = indices[i];
+        while (value >= 0x80) {
+            output.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        output.push_back(static_cast<uint8_t>(value));
+    }
+    return output;
+}
+
+bool MeshCompression::DecodeIndexBuffer(const uint8_t* data, size_t size, std::vector<uint32_t>& indices) {
+    if (!data || size < HeaderSize || ReadUint32(data) != IndexCodecMagic || ReadUint32(data + 4) != CodecVersion) {
+        std::cerr << "索引缓冲数据格式无效！" << std::endl;
+        return false;
+    }
+    const uint32_t indexCount = ReadUint32(data + 8);
+    // 每个索引至少一个字节，先检查再分配，避免损坏的数据导致巨大的分配
+    if (size - HeaderSize < indexCount) {
+        std::cerr << "索引缓冲数据不完整！" << std::endl;
+        return false;
+    }
+
+    indices.resize(indexCount);
+    const uint8_t* cursor = data + HeaderSize;
+    const uint8_t* end = data + size;
+    uint32_t previous = 0;
+    for (uint32_t i = 0; i < indexCount; ++i) {
+        uint32_t value = 0;
+        uint32_t shift = 0;
+        uint8_t byte;
+        do {
+            if (cursor == end || shift > 28) {
+                std::cerr << "索引缓冲数据不完整！" << std::endl;
+                return false;
+            }
+            byte = *cursor++;
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        previous += (value >> 1) ^ static_cast<uint32_t>(-static_cast<int32_t>(value & 1));
+        indices[i] = previous;
+    }
+    return true;
+}
+
+} // namespace PLE
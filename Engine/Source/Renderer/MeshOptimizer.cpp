@@ -0,0 +1,415 @@
+/**
+ * @file MeshOptimizer.cpp
+ * @brief 导入时的网格优化实现
+ */
+
+#include "Renderer/MeshOptimizer.h"
+#include "Renderer/RenderResources.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace PLE {
+
+namespace {
+
+constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+/**
+ * @brief 三角形的面积加权法线（叉积，长度为面积的两倍）
+ */
+Vector3 TriangleNormal(const Vector3& a, const Vector3& b, const Vector3& c) {
+    return (b - a).Cross(c - a);
+}
+
+/**
+ * @brief 计算网格簇的包围球和法线锥
+ */
+void ComputeMeshletBounds(const Vertex* vertices, const MeshletData& data, Meshlet& meshlet) {
+    const uint32_t* localVertices = data.vertices.data() + meshlet.vertexOffset;
+    const uint8_t* triangles = data.triangles.data() + meshlet.triangleOffset;
+
+    // 包围球：包围盒中心加最远顶点距离
+    Vector3 minimum = vertices[localVertices[0]].position;
+    Vector3 maximum = minimum;
+    for (uint32_t i = 1; i < meshlet.vertexCount; ++i) {
+        const Vector3& p = vertices[localVertices[i]].position;
+        minimum = Vector3(std::min(minimum.x, p.x), std::min(minimum.y, p.y), std::min(minimum.z, p.z));
+        maximum = Vector3(std::max(maximum.x, p.x), std::max(maximum.y, p.y), std::max(maximum.z, p.z));
+    }
+    meshlet.center = (minimum + maximum) * 0.5f;
+    float radiusSquared = 0.0f;
+    for (uint32_t i = 0; i < meshlet.vertexCount; ++i) {
+        radiusSquared = std::max(radiusSquared, (vertices[localVertices[i]].position - meshlet.center).LengthSquared());
+    }
+    meshlet.radius = std::sqrt(radiusSquared);
+
+    // 法线锥：轴为单位法线的平均方向，张角由与轴夹角最大的法线决定
+    struct Plane {
+        Vector3 point;
+        Vector3 normal;
+    };
+    std::vector<Plane> planes;
+    planes.reserve(meshlet.triangleCount);
+    Vector3 axis = Vector3::Zero();
+    for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+        const Vector3& p0 = vertices[localVertices[triangles[t * 3 + 0]]].position;
+        Vector3 normal = TriangleNormal(p0, vertices[localVertices[triangles[t * 3 + 1]]].position,
+                                        vertices[localVertices[triangles[t * 3 + 2]]].position);
+        float length = normal.Length();
+        if (length <= 1.0e-12f) {
+            continue;
+        }
+        normal = normal * (1.0f / length);
+        planes.push_back({ p0, normal });
+        axis = axis + normal;
+    }
+
+    meshlet.coneApex = meshlet.center;
+    meshlet.coneAxis = Vector3(0.0f, 0.0f, 1.0f);
+    meshlet.coneCutoff = 1.0f;
+    float axisLength = axis.Length();
+    if (planes.empty() || axisLength <= 1.0e-6f) {
+        return;
+    }
+    axis = axis * (1.0f / axisLength);
+    meshlet.coneAxis = axis;
+
+    float minimumDot = 1.0f;
+    for (const Plane& plane : planes) {
+        minimumDot = std::min(minimumDot, plane.normal.Dot(axis));
+    }
+    // 法线张角接近或超过90度时不可能整簇背向
+    if (minimumDot <= 0.1f) {
+        return;
+    }
+
+    // 锥顶沿轴反向移动到所有三角形平面之后
+    float maxDistance = 0.0f;
+    for (const Plane& plane : planes) {
+        float distance = (meshlet.center - plane.point).Dot(plane.normal) / plane.normal.Dot(axis);
+        maxDistance = std::max(maxDistance, distance);
+    }
+    meshlet.coneApex = meshlet.center - axis * maxDistance;
+    meshlet.coneCutoff = std::sqrt(1.0f - minimumDot * minimumDot);
+}
+
+} // namespace
+
+bool MeshOptimizer::Optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+                             const MeshOptimizerConfig& config, MeshletData* meshlets) {
+    if (indices.size() % 3 != 0) {
+        std::cerr << "网格优化只支持三角形列表，索引数量必须是3的倍数" << std::endl;
+        return false;
+    }
+    const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+    const uint32_t indexCount = static_cast<uint32_t>(indices.size());
+    for (uint32_t index : indices) {
+        if (index >= vertexCount) {
+            std::cerr << "网格优化失败：索引越界" << std::endl;
+            return false;
+        }
+    }
+
+    std::vector<uint32_t> clusters;
+    OptimizeVertexCache(indices.data(), indexCount, vertexCount, config.cacheSize,
+                        config.optimizeOverdraw ? &clusters : nullptr);
+    if (config.optimizeOverdraw) {
+        OptimizeOverdraw(indices.data(), indexCount, vertices.data(), vertexCount, clusters);
+    }
+    uint32_t usedVertices = OptimizeVertexFetch(vertices.data(), vertexCount, indices.data(), indexCount);
+    vertices.resize(usedVertices);
+
+    if (meshlets && config.buildMeshlets) {
+        BuildMeshlets(vertices.data(), usedVertices, indices.data(), indexCount,
+                      config.maxMeshletVertices, config.maxMeshletTriangles, *meshlets);
+    }
+    return true;
+}
+
+void MeshOptimizer::OptimizeVertexCache(uint32_t* indices, uint32_t indexCount, uint32_t vertexCount,
+                                        uint32_t cacheSize, std::vector<uint32_t>* clusters) {
+    const uint32_t triangleCount = indexCount / 3;
+    if (clusters) {
+        clusters->clear();
+    }
+    if (triangleCount == 0 || vertexCount == 0) {
+        return;
+    }
+    cacheSize = std::max(cacheSize, 3u);
+
+    // 顶点到三角形的邻接表，liveCount为顶点尚未输出的三角形数
+    std::vector<uint32_t> liveCount(vertexCount, 0);
+    for (uint32_t i = 0; i < triangleCount * 3; ++i) {
+        ++liveCount[indices[i]];
+    }
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (uint32_t v = 0; v < vertexCount; ++v) {
+        offsets[v + 1] = offsets[v] + liveCount[v];
+    }
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    {
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (uint32_t i = 0; i < triangleCount * 3; ++i) {
+            adjacency[cursor[indices[i]]++] = i / 3;
+        }
+    }
+
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    std::vector<uint32_t> deadEnd;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> result;
+    deadEnd.reserve(triangleCount * 3);
+    result.reserve(triangleCount * 3);
+
+    uint32_t timeStamp = cacheSize + 1;
+    uint32_t scanCursor = 0;
+    uint32_t fanning = indices[0];
+    if (clusters) {
+        clusters->push_back(0);
+    }
+
+    while (fanning != InvalidIndex) {
+        // 输出当前顶点周围所有未输出的三角形
+        candidates.clear();
+        for (uint32_t a = offsets[fanning]; a < offsets[fanning + 1]; ++a) {
+            uint32_t triangle = adjacency[a];
+            if (emitted[triangle]) {
+                continue;
+            }
+            emitted[triangle] = 1;
+            for (uint32_t k = 0; k < 3; ++k) {
+                uint32_t v = indices[triangle * 3 + k];
+                result.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                --liveCount[v];
+                if (timeStamp - cacheTime[v] > cacheSize) {
+                    cacheTime[v] = timeStamp++;
+                }
+            }
+        }
+
+        // 优先选择输出其剩余三角形后仍在缓存中的、最早进入缓存的候选顶点
+        uint32_t next = InvalidIndex;
+        int64_t bestPriority = -1;
+        for (uint32_t v : candidates) {
+            if (liveCount[v] == 0) {
+                continue;
+            }
+            int64_t priority = 0;
+            uint32_t age = timeStamp - cacheTime[v];
+            if (age + 2 * liveCount[v] <= cacheSize) {
+                priority = age;
+            }
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                next = v;
+            }
+        }
+
+        // 死路：先回溯最近输出的顶点，再按顺序扫描，此处缓存视为清空，开始新的簇
+        if (next == InvalidIndex) {
+            while (!deadEnd.empty()) {
+                uint32_t v = deadEnd.back();
+                deadEnd.pop_back();
+                if (liveCount[v] > 0) {
+                    next = v;
+                    break;
+                }
+            }
+            while (next == InvalidIndex && scanCursor < vertexCount) {
+                if (liveCount[scanCursor] > 0) {
+                    next = scanCursor;
+                }
+                ++scanCursor;
+            }
+            if (next != InvalidIndex && clusters) {
+                clusters->push_back(static_cast<uint32_t>(result.size() / 3));
+            }
+        }
+        fanning = next;
+    }
+
+    std::copy(result.begin(), result.end(), indices);
+}
+
+void MeshOptimizer::OptimizeOverdraw(uint32_t* indices, uint32_t indexCount, const Vertex* vertices,
+                                     uint32_t vertexCount, const std::vector<uint32_t>& clusters) {
+    (void)vertexCount;
+    const uint32_t triangleCount = indexCount / 3;
+    if (triangleCount == 0 || clusters.size() < 2) {
+        return;
+    }
+
+    struct Cluster {
+        uint32_t begin;
+        uint32_t end;
+        Vector3 centroid;
+        Vector3 normal;
+        float area;
+        float sortKey;
+    };
+
+    // 面积加权的簇中心和法线
+    std::vector<Cluster> sorted(clusters.size());
+    Vector3 meshCentroid = Vector3::Zero();
+    float meshArea = 0.0f;
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        Cluster& cluster = sorted[c];
+        cluster.begin = clusters[c];
+        cluster.end = (c + 1 < clusters.size()) ? clusters[c + 1] : triangleCount;
+        cluster.centroid = Vector3::Zero();
+        cluster.normal = Vector3::Zero();
+        cluster.area = 0.0f;
+        for (uint32_t t = cluster.begin; t < cluster.end; ++t) {
+            const Vector3& a = vertices[indices[t * 3 + 0]].position;
+            const Vector3& b = vertices[indices[t * 3 + 1]].position;
+            const Vector3& d = vertices[indices[t * 3 + 2]].position;
+            Vector3 normal = TriangleNormal(a, b, d);
+            float area = normal.Length();
+            cluster.normal = cluster.normal + normal;
+            cluster.centroid = cluster.centroid + (a + b + d) * (area / 3.0f);
+            cluster.area += area;
+        }
+        meshCentroid = meshCentroid + cluster.centroid;
+        meshArea += cluster.area;
+        if (cluster.area > 0.0f) {
+            cluster.centroid = cluster.centroid * (1.0f / cluster.area);
+        }
+    }
+    if (meshArea <= 0.0f) {
+        return;
+    }
+    meshCentroid = meshCentroid * (1.0f / meshArea);
+
+    // 朝外且远离中心的簇更可能遮挡其他簇，先绘制
+    for (Cluster& cluster : sorted) {
+        float length = cluster.normal.Length();
+        Vector3 normal = length > 0.0f ? cluster.normal * (1.0f / length) : Vector3::Zero();
+        cluster.sortKey = (cluster.centroid - meshCentroid).Dot(normal);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster& a, const Cluster& b) {
+        return a.sortKey > b.sortKey;
+    });
+
+    std::vector<uint32_t> result;
+    result.reserve(triangleCount * 3);
+    for (const Cluster& cluster : sorted) {
+        result.insert(result.end(), indices + cluster.begin * 3, indices + cluster.end * 3);
+    }
+    std::copy(result.begin(), result.end(), indices);
+}
+
+uint32_t MeshOptimizer::OptimizeVertexFetch(Vertex* vertices, uint32_t vertexCount, uint32_t* indices, uint32_t indexCount) {
+    std::vector<uint32_t> remap(vertexCount, InvalidIndex);
+    uint32_t nextVertex = 0;
+    for (uint32_t i = 0; i < indexCount; ++i) {
+        uint32_t& newIndex = remap[indices[i]];
+        if (newIndex == InvalidIndex) {
+            newIndex = nextVertex++;
+        }
+        indices[i] = newIndex;
+    }
+
+    std::vector<Vertex> reordered(nextVertex);
+    for (uint32_t v = 0; v < vertexCount; ++v) {
+        if (remap[v] != InvalidIndex) {
+            reordered[remap[v]] = vertices[v];
+        }
+    }
+    std::copy(reordered.begin(), reordered.end(), vertices);
+    return nextVertex;
+}
+
+void MeshOptimizer::BuildMeshlets(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices,
+                                  uint32_t indexCount, uint32_t maxVertices, uint32_t maxTriangles,
+                                  MeshletData& meshlets) {
+    meshlets.meshlets.clear();
+    meshlets.vertices.clear();
+    meshlets.triangles.clear();
+    maxVertices = std::min(std::max(maxVertices, 3u), 256u);
+    maxTriangles = std::max(maxTriangles, 1u);
+
+    // 网格顶点在当前网格簇中的局部序号，结束一个网格簇时只重置用到的顶点
+    std::vector<uint32_t> localIndex(vertexCount, InvalidIndex);
+    Meshlet current;
+
+    auto finish = [&]() {
+        if (current.triangleCount == 0) {
+            return;
+        }
+        for (uint32_t i = 0; i < current.vertexCount; ++i) {
+            localIndex[meshlets.vertices[current.vertexOffset + i]] = InvalidIndex;
+        }
+        ComputeMeshletBounds(vertices, meshlets, current);
+        meshlets.meshlets.push_back(current);
+        current = Meshlet();
+        current.vertexOffset = static_cast<uint32_t>(meshlets.vertices.size());
+        current.triangleOffset = static_cast<uint32_t>(meshlets.triangles.size());
+    };
+
+    for (uint32_t i = 0; i + 2 < indexCount; i += 3) {
+        const uint32_t a = indices[i];
+        const uint32_t b = indices[i + 1];
+        const uint32_t c = indices[i + 2];
+        uint32_t newVertices = (localIndex[a] == InvalidIndex) + (localIndex[b] == InvalidIndex && b != a) +
+                               (localIndex[c] == InvalidIndex && c != a && c != b);
+        if (current.vertexCount + newVertices > maxVertices || current.triangleCount + 1 > maxTriangles) {
+            finish();
+        }
+
+        for (uint32_t v : { a, b, c }) {
+            if (localIndex[v] == InvalidIndex) {
+                localIndex[v] = current.vertexCount++;
+                meshlets.vertices.push_back(v);
+            }
+            meshlets.triangles.push_back(static_cast<uint8_t>(localIndex[v]));
+        }
+        ++current.triangleCount;
+    }
+    finish();
+}
+
+bool MeshOptimizer::IsMeshletBackfacing(const Meshlet& meshlet, const Vector3& cameraPosition) {
+    if (meshlet.coneCutoff >= 1.0f) {
+        return false;
+    }
+    Vector3 view = meshlet.coneApex - cameraPosition;
+    float length = view.Length();
+    return length > 0.0f && view.Dot(meshlet.coneAxis) >= meshlet.coneCutoff * length;
+}
+
+VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount,
+                                                   uint32_t cacheSize) {
+    VertexCacheStats stats;
+    const uint32_t triangleCount = indexCount / 3;
+    if (triangleCount == 0 || vertexCount == 0) {
+        return stats;
+    }
+
+    // FIFO缓存：未命中时写入时间戳，时间戳差超过缓存大小即已被挤出
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    std::vector<uint8_t> used(vertexCount, 0);
+    uint32_t timeStamp = cacheSize + 1;
+    uint32_t usedVertices = 0;
+    for (uint32_t i = 0; i < triangleCount * 3; ++i) {
+        uint32_t v = indices[i];
+        if (timeStamp - cacheTime[v] > cacheSize) {
+            cacheTime[v] = timeStamp++;
+            ++stats.transformedVertices;
+        }
+        if (!used[v]) {
+            used[v] = 1;
+            ++usedVertices;
+        }
+    }
+    stats.acmr = static_cast<float>(stats.transformedVertices) / triangleCount;
+    stats.atvr = static_cast<float>(stats.transformedVertices) / usedVertices;
+    return stats;
+}
+
+} // namespace PLE
@@ -0,0 +1,302 @@
+/**
+ * @file MultiViewRenderer.cpp
+ * @brief 多视图渲染器实现
+ */
+
+#include "Renderer/MultiViewRenderer.h"
+#include "Renderer/RenderResources.h"
+#include "Renderer/RenderSystem.h"
+#include "Scene/Camera.h"
+#include "Core/JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace PLE {
+
+namespace {
+
+// 剔除时每个任务处理的物体数量
+constexpr uint32_t CULL_BLOCK_SIZE = 1024;
+
+// 状态排序键的布局：材质24位、网格16位、深度24位
+constexpr uint64_t STATE_MATERIAL_MASK = 0xFFFFFF0000000000ull;
+constexpr uint64_t STATE_MESH_MASK = 0x000000FFFF000000ull;
+
+uint64_t HashPointer(const void* pointer) {
+    uint64_t x = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDull;
+    x ^= x >> 33;
+    return x;
+}
+
+/**
+ * @brief 把浮点数映射为保持大小顺序的无符号整数
+ */
+uint32_t OrderedDepth(float depth) {
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// RenderView
+// ---------------------------------------------------------------------------
+
+RenderView RenderView::FromCamera(const Camera& camera, const std::string& name) {
+    RenderView view;
+    view.name = name;
+    view.view = camera.GetViewMatrix();
+    view.projection = camera.GetProjectionMatrix();
+    return view;
+}
+
+// ---------------------------------------------------------------------------
+// MultiViewRenderer
+// ---------------------------------------------------------------------------
+
+MultiViewRenderer::MultiViewRenderer() = default;
+
+MultiViewRenderer::~MultiViewRenderer() = default;
+
+void MultiViewRenderer::Extract(const std::vector<RenderObject>& objects) {
+    Extract(objects.data(), static_cast<uint32_t>(objects.size()));
+}
+
+void MultiViewRenderer::Extract(const RenderObject* objects, uint32_t count) {
+    const auto start = std::chrono::steady_clock::now();
+
+    m_Objects.resize(count);
+    m_Centers.resize(static_cast<size_t>(count) * 3);
+    m_Extents.resize(static_cast<size_t>(count) * 3);
+    m_Layers.resize(count);
+    m_StateKeys.resize(count);
+
+    JobSystem::GetInstance().ParallelFor(count, CULL_BLOCK_SIZE, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const RenderObject& object = objects[i];
+            m_Objects[i] = object;
+            float* center = &m_Centers[static_cast<size_t>(i) * 3];
+            float* extent = &m_Extents[static_cast<size_t>(i) * 3];
+            center[0] = (object.boundsMin.x + object.boundsMax.x) * 0.5f;
+            center[1] = (object.boundsMin.y + object.boundsMax.y) * 0.5f;
+            center[2] = (object.boundsMin.z + object.boundsMax.z) * 0.5f;
+            extent[0] = (object.boundsMax.x - object.boundsMin.x) * 0.5f;
+            extent[1] = (object.boundsMax.y - object.boundsMin.y) * 0.5f;
+            extent[2] = (object.boundsMax.z - object.boundsMin.z) * 0.5f;
+            m_Layers[i] = object.layers;
+            m_StateKeys[i] = (HashPointer(object.material.get()) & STATE_MATERIAL_MASK) |
+                             ((HashPointer(object.mesh.get()) >> 24) & STATE_MESH_MASK);
+        }
+    });
+
+    m_Stats.objects = count;
+    m_Stats.extractMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void MultiViewRenderer::Cull(const std::vector<RenderView>& views) {
+    Cull(views.data(), static_cast<uint32_t>(views.size()));
+}
+
+void MultiViewRenderer::Cull(const RenderView* views, uint32_t count) {
+    const auto start = std::chrono::steady_clock::now();
+    const uint32_t objectCount = static_cast<uint32_t>(m_Objects.size());
+
+    m_Views.resize(count);
+    for (uint32_t v = 0; v < count; ++v) {
+        ViewState& state = m_Views[v];
+        state.desc = views[v];
+
+        // 行向量约定：裁剪坐标的每个分量是点与矩阵一列的点积，深度范围[0, 1]
+        const Matrix4 viewProjection = state.desc.view * state.desc.projection;
+        const auto& m = viewProjection.m;
+        const float column[4][4] = {
+            { m[0], m[4], m[8], m[12] },
+            { m[1], m[5], m[9], m[13] },
+            { m[2], m[6], m[10], m[14] },
+            { m[3], m[7], m[11], m[15] },
+        };
+        // 左右、下上为w ± x、w ± y，近平面为z，远平面为w - z
+        static const float factors[6][4] = {
+            { 1.0f, 0.0f, 0.0f, 1.0f }, { -1.0f, 0.0f, 0.0f, 1.0f },
+            { 0.0f, 1.0f, 0.0f, 1.0f }, { 0.0f, -1.0f, 0.0f, 1.0f },
+            { 0.0f, 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, -1.0f, 1.0f },
+        };
+        for (int p = 0; p < 6; ++p) {
+            float value[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            for (int c = 0; c < 4; ++c) {
+                for (int k = 0; k < 4; ++k) {
+                    value[k] += factors[p][c] * column[c][k];
+                }
+            }
+            Plane& plane = state.planes[p];
+            plane.normal[0] = value[0];
+            plane.normal[1] = value[1];
+            plane.normal[2] = value[2];
+            plane.distance = value[3];
+        }
+
+        // 相机沿-Z观察，视图空间深度为-z
+        const auto& view = state.desc.view.m;
+        state.depthAxis[0] = -view[2];
+        state.depthAxis[1] = -view[6];
+        state.depthAxis[2] = -view[10];
+        state.depthAxis[3] = -view[14];
+
+        state.flags.resize(objectCount);
+        state.depths.resize(objectCount);
+    }
+
+    // 第一步：（视图, 物体块）并行剔除；第二步：每个视图压缩可见列表并排序
+    const uint32_t blocksPerView = (objectCount + CULL_BLOCK_SIZE - 1) / CULL_BLOCK_SIZE;
+    JobSystem& jobSystem = JobSystem::GetInstance();
+    jobSystem.ParallelFor(count * blocksPerView, 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t item = begin; item < end; ++item) {
+            const uint32_t block = item % blocksPerView;
+            const uint32_t first = block * CULL_BLOCK_SIZE;
+            CullBlock(m_Views[item / blocksPerView], first, std::min(first + CULL_BLOCK_SIZE, objectCount));
+        }
+    });
+    jobSystem.ParallelFor(count, 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t v = begin; v < end; ++v) {
+            SortView(m_Views[v]);
+        }
+    });
+
+    m_Stats.views = count;
+    m_Stats.tested = 0;
+    m_Stats.visible = 0;
+    for (const ViewState& state : m_Views) {
+        m_Stats.tested += state.tested;
+        m_Stats.visible += static_cast<uint32_t>(state.visible.size());
+    }
+    m_Stats.cullMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    m_Stats.submitMilliseconds = 0.0;
+}
+
+void MultiViewRenderer::CullBlock(ViewState& view, uint32_t begin, uint32_t end) const {
+    const uint32_t layerMask = view.desc.layerMask;
+    for (uint32_t i = begin; i < end; ++i) {
+        if ((m_Layers[i] & layerMask) == 0) {
+            view.flags[i] = 0;
+            continue;
+        }
+
+        const float* center = &m_Centers[static_cast<size_t>(i) * 3];
+        const float* extent = &m_Extents[static_cast<size_t>(i) * 3];
+        bool inside = true;
+        for (const Plane& plane : view.planes) {
+            const float distance = plane.normal[0] * center[0] + plane.normal[1] * center[1] + plane.normal[2] * center[2] + plane.distance;
+            const float radius = std::fabs(plane.normal[0]) * extent[0] + std::fabs(plane.normal[1]) * extent[1] +
+                                 std::fabs(plane.normal[2]) * extent[2];
+            if (distance + radius < 0.0f) {
+                inside = false;
+                break;
+            }
+        }
+
+        view.flags[i] = inside ? 2 : 1;
+        if (inside) {
+            view.depths[i] = view.depthAxis[0] * center[0] + view.depthAxis[1] * center[1] + view.depthAxis[2] * center[2] +
+                             view.depthAxis[3];
+        }
+    }
+}
+
+void MultiViewRenderer::SortView(ViewState& view) {
+    const ViewSortMode mode = view.desc.sortMode;
+    // 覆盖材质时所有物体材质相同，只按网格分组
+    const uint64_t stateMask = view.desc.overrideMaterial ? STATE_MESH_MASK : STATE_MATERIAL_MASK | STATE_MESH_MASK;
+
+    view.items.clear();
+    view.tested = 0;
+    const uint32_t objectCount = static_cast<uint32_t>(view.flags.size());
+    for (uint32_t i = 0; i < objectCount; ++i) {
+        const uint8_t flag = view.flags[i];
+        if (flag == 0) {
+            continue;
+        }
+        ++view.tested;
+        if (flag != 2) {
+            continue;
+        }
+
+        uint64_t key = 0;
+        switch (mode) {
+            case ViewSortMode::FrontToBack:
+                key = OrderedDepth(view.depths[i]);
+                break;
+            case ViewSortMode::BackToFront:
+                key = ~OrderedDepth(view.depths[i]);
+                break;
+            case ViewSortMode::State:
+                key = (m_StateKeys[i] & stateMask) | (OrderedDepth(view.depths[i]) >> 8);
+                break;
+            case ViewSortMode::None:
+                break;
+        }
+        view.items.push_back({ key, i });
+    }
+
+    if (mode != ViewSortMode::None) {
+        std::sort(view.items.begin(), view.items.end());
+    }
+    view.visible.resize(view.items.size());
+    for (size_t i = 0; i < view.items.size(); ++i) {
+        view.visible[i] = view.items[i].object;
+    }
+}
+
+void MultiViewRenderer::Submit(RenderSystem& renderSystem) {
+    const auto start = std::chrono::steady_clock::now();
+
+    const ViewState* previous = nullptr;
+    for (const ViewState& state : m_Views) {
+        const RenderView& view = state.desc;
+        const bool sameTarget = previous && previous->desc.target == view.target;
+        const bool fullViewport = view.viewportWidth <= 0 || view.viewportHeight <= 0;
+
+        // 相邻视图共用渲染目标时不切换目标（分屏），否则Vulkan后端会拆成多个渲染通道
+        if (!sameTarget || (fullViewport && !view.target)) {
+            renderSystem.SetRenderTarget(view.target);
+        }
+        if (!fullViewport) {
+            renderSystem.SetViewport(view.viewportX, view.viewportY, view.viewportWidth, view.viewportHeight);
+        } else if (sameTarget && view.target) {
+            renderSystem.SetViewport(0, 0, view.target->GetWidth(), view.target->GetHeight());
+        }
+        // Clear清除整个渲染目标、不受视口限制，共用目标的后续视图清除会覆盖前面视图的绘制
+        if (view.clear && !sameTarget) {
+            renderSystem.Clear(view.clearColor);
+        }
+        renderSystem.SetViewProjection(view.view, view.projection);
+
+        for (uint32_t index : state.visible) {
+            const RenderObject& object = m_Objects[index];
+            const std::shared_ptr<Material>& material = view.overrideMaterial ? view.overrideMaterial : object.material;
+            if (object.mesh && material) {
+                renderSystem.DrawMesh(object.mesh, material, object.transform);
+            }
+        }
+
+        renderSystem.ReportCulling(state.tested, state.tested - static_cast<uint32_t>(state.visible.size()));
+        previous = &state;
+    }
+
+    if (previous) {
+        renderSystem.SetRenderTarget(nullptr);
+    }
+    m_Stats.submitMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void MultiViewRenderer::Render(RenderSystem& renderSystem, const RenderView* views, uint32_t count) {
+    Cull(views, count);
+    Submit(renderSystem);
+}
+
+} // namespace PLE
@@ -0,0 +1,413 @@
+/**
+ * @file OcclusionCuller.cpp
+ * @brief 软件层次深度遮挡剔除实现
+ */
+
+#include "Renderer/OcclusionCuller.h"
+#include "Renderer/RenderResources.h"
+#include "Core/JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef PLE_SIMD_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace PLE {
+
+namespace {
+
+/**
+ * @brief 按行向量约定变换点：clip = (p, 1) * M
+ */
+Vector4 TransformPoint(const Vector3& p, const Matrix4& matrix) {
+    const auto& m = matrix.m;
+    return Vector4(p.x * m[0] + p.y * m[4] + p.z * m[8] + m[12],
+                   p.x * m[1] + p.y * m[5] + p.z * m[9] + m[13],
+                   p.x * m[2] + p.y * m[6] + p.z * m[10] + m[14],
+                   p.x * m[3] + p.y * m[7] + p.z * m[11] + m[15]);
+}
+
+Vector4 Lerp(const Vector4& a, const Vector4& b, float t) {
+    return Vector4(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t);
+}
+
+} // namespace
+
+OcclusionCuller::OcclusionCuller(const OcclusionCullerConfig& config)
+    : m_Config(config) {
+    m_Config.width = std::max(m_Config.width, 1);
+    m_Config.height = std::max(m_Config.height, 1);
+    m_Config.bandHeight = std::max(m_Config.bandHeight, 1u);
+
+    // 每行补齐到4的倍数，SIMD光栅化一次处理4个像素不会越界
+    int width = m_Config.width;
+    int height = m_Config.height;
+    for (;;) {
+        Level level;
+        level.width = width;
+        level.height = height;
+        level.stride = (width + 3) & ~3;
+        level.depth.assign(static_cast<size_t>(level.stride) * static_cast<size_t>(height), 1.0f);
+        m_Levels.push_back(std::move(level));
+        if (width == 1 && height == 1) {
+            break;
+        }
+        width = std::max(1, (width + 1) / 2);
+        height = std::max(1, (height + 1) / 2);
+    }
+}
+
+OcclusionCuller::~OcclusionCuller() = default;
+
+void OcclusionCuller::BeginFrame(const Matrix4& viewProjection) {
+    m_ViewProjection = viewProjection;
+    m_Triangles.clear();
+    m_Stats = OcclusionCullerStats();
+    std::fill(m_Levels[0].depth.begin(), m_Levels[0].depth.end(), 1.0f);
+}
+
+void OcclusionCuller::AddOccluder(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount,
+                                  const Matrix4& transform) {
+    if (!vertices || vertexCount == 0) {
+        return;
+    }
+
+    const Matrix4 modelViewProjection = transform * m_ViewProjection;
+    std::vector<Vector4> clip(vertexCount);
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        clip[i] = TransformPoint(vertices[i].position, modelViewProjection);
+    }
+
+    const uint32_t count = indices ? indexCount : vertexCount;
+    for (uint32_t i = 0; i + 2 < count; i += 3) {
+        const uint32_t i0 = indices ? indices[i] : i;
+        const uint32_t i1 = indices ? indices[i + 1] : i + 1;
+        const uint32_t i2 = indices ? indices[i + 2] : i + 2;
+        if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount) {
+            continue;
+        }
+        ++m_Stats.occluderTriangles;
+
+        // 裁剪到近平面（clip.z >= 0），得到最多4个顶点的凸多边形
+        const Vector4 input[3] = { clip[i0], clip[i1], clip[i2] };
+        Vector4 polygon[4];
+        uint32_t polygonSize = 0;
+        for (uint32_t k = 0; k < 3; ++k) {
+            const Vector4& current = input[k];
+            const Vector4& next = input[(k + 1) % 3];
+            const bool currentInside = current.z >= 0.0f;
+            const bool nextInside = next.z >= 0.0f;
+            if (currentInside) {
+                polygon[polygonSize++] = current;
+            }
+            if (currentInside != nextInside) {
+                polygon[polygonSize++] = Lerp(current, next, current.z / (current.z - next.z));
+            }
+        }
+        for (uint32_t k = 2; k < polygonSize; ++k) {
+            SetupTriangle(polygon[0], polygon[k - 1], polygon[k]);
+        }
+    }
+}
+
+void OcclusionCuller::SetupTriangle(const Vector4& a, const Vector4& b, const Vector4& c) {
+    const float width = static_cast<float>(m_Config.width);
+    const float height = static_cast<float>(m_Config.height);
+    float x[3];
+    float y[3];
+    float z[3];
+    const Vector4* points[3] = { &a, &b, &c };
+    for (int i = 0; i < 3; ++i) {
+        const float inverseW = 1.0f / std::max(points[i]->w, 1e-6f);
+        x[i] = (points[i]->x * inverseW * 0.5f + 0.5f) * width;
+        y[i] = (points[i]->y * inverseW * 0.5f + 0.5f) * height;
+        z[i] = points[i]->z * inverseW;
+    }
+
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+    if (std::fabs(area) < 1e-8f) {
+        return;
+    }
+    if (area < 0.0f) {
+        // 遮挡体不做背面剔除，统一成逆时针以便边函数在内部为正
+        std::swap(x[1], x[2]);
+        std::swap(y[1], y[2]);
+        std::swap(z[1], z[2]);
+        area = -area;
+    }
+
+    Triangle triangle;
+    triangle.minX = std::max(0, static_cast<int>(std::floor(std::min({ x[0], x[1], x[2] }))));
+    triangle.minY = std::max(0, static_cast<int>(std::floor(std::min({ y[0], y[1], y[2] }))));
+    triangle.maxX = std::min(m_Config.width - 1, static_cast<int>(std::ceil(std::max({ x[0], x[1], x[2] }))));
+    triangle.maxY = std::min(m_Config.height - 1, static_cast<int>(std::ceil(std::max({ y[0], y[1], y[2] }))));
+    if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) {
+        return;
+    }
+
+    // 边i与顶点i相对，其值除以面积即为顶点i的重心坐标
+    for (int i = 0; i < 3; ++i) {
+        const int from = (i + 1) % 3;
+        const int to = (i + 2) % 3;
+        triangle.edgeA[i] = y[from] - y[to];
+        triangle.edgeB[i] = x[to] - x[from];
+        triangle.edgeC[i] = -(triangle.edgeA[i] * x[from] + triangle.edgeB[i] * y[from]);
+    }
+    const float inverseArea = 1.0f / area;
+    triangle.depthA = (triangle.edgeA[0] * z[0] + triangle.edgeA[1] * z[1] + triangle.edgeA[2] * z[2]) * inverseArea;
+    triangle.depthB = (triangle.edgeB[0] * z[0] + triangle.edgeB[1] * z[1] + triangle.edgeB[2] * z[2]) * inverseArea;
+    triangle.depthC = (triangle.edgeC[0] * z[0] + triangle.edgeC[1] * z[1] + triangle.edgeC[2] * z[2]) * inverseArea;
+    m_Triangles.push_back(triangle);
+}
+
+void OcclusionCuller::Finish() {
+    m_Stats.rasterizedTriangles = static_cast<uint32_t>(m_Triangles.size());
+
+    // 按行带并行：每个任务只写自己的行，不需要同步
+    const uint32_t bandHeight = m_Config.bandHeight;
+    const uint32_t bandCount = (static_cast<uint32_t>(m_Config.height) + bandHeight - 1) / bandHeight;
+    if (!m_Triangles.empty()) {
+        JobSystem::GetInstance().ParallelFor(bandCount, 1, [this, bandHeight](uint32_t begin, uint32_t end) {
+            for (uint32_t band = begin; band < end; ++band) {
+                const int beginY = static_cast<int>(band * bandHeight);
+                const int endY = std::min(m_Config.height, static_cast<int>((band + 1) * bandHeight));
+                RasterizeBand(beginY, endY);
+            }
+        });
+    }
+    BuildHierarchy();
+}
+
+void OcclusionCuller::RasterizeBand(int beginY, int endY) {
+    Level& target = m_Levels[0];
+    for (const Triangle& triangle : m_Triangles) {
+        const int minY = std::max(triangle.minY, beginY);
+        const int maxY = std::min(triangle.maxY, endY - 1);
+        const int startX = triangle.minX & ~3;
+
+        for (int y = minY; y <= maxY; ++y) {
+            const float py = static_cast<float>(y) + 0.5f;
+            float* row = &target.depth[static_cast<size_t>(y) * static_cast<size_t>(target.stride)];
+            const float rowEdge0 = triangle.edgeB[0] * py + triangle.edgeC[0];
+            const float rowEdge1 = triangle.edgeB[1] * py + triangle.edgeC[1];
+            const float rowEdge2 = triangle.edgeB[2] * py + triangle.edgeC[2];
+            const float rowDepth = triangle.depthB * py + triangle.depthC;
+            int x = startX;
+
+#ifdef PLE_SIMD_SSE2
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 step = _mm_set1_ps(4.0f);
+            const __m128 edgeA0 = _mm_set1_ps(triangle.edgeA[0]);
+            const __m128 edgeA1 = _mm_set1_ps(triangle.edgeA[1]);
+            const __m128 edgeA2 = _mm_set1_ps(triangle.edgeA[2]);
+            const __m128 depthA = _mm_set1_ps(triangle.depthA);
+            __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x) + 0.5f), _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f));
+            for (; x <= triangle.maxX; x += 4) {
+                const __m128 e0 = _mm_add_ps(_mm_mul_ps(edgeA0, px), _mm_set1_ps(rowEdge0));
+                const __m128 e1 = _mm_add_ps(_mm_mul_ps(edgeA1, px), _mm_set1_ps(rowEdge1));
+                const __m128 e2 = _mm_add_ps(_mm_mul_ps(edgeA2, px), _mm_set1_ps(rowEdge2));
+                const __m128 inside = _mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_and_ps(_mm_cmpge_ps(e1, zero), _mm_cmpge_ps(e2, zero)));
+                if (_mm_movemask_ps(inside) != 0) {
+                    const __m128 depth = _mm_add_ps(_mm_mul_ps(depthA, px), _mm_set1_ps(rowDepth));
+                    const __m128 stored = _mm_loadu_ps(row + x);
+                    const __m128 nearest = _mm_min_ps(stored, depth);
+                    _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, stored)));
+                }
+                px = _mm_add_ps(px, step);
+            }
+#endif
+
+            for (; x <= triangle.maxX; ++x) {
+                const float px = static_cast<float>(x) + 0.5f;
+                if (triangle.edgeA[0] * px + rowEdge0 >= 0.0f &&
+                    triangle.edgeA[1] * px + rowEdge1 >= 0.0f &&
+                    triangle.edgeA[2] * px + rowEdge2 >= 0.0f) {
+                    row[x] = std::min(row[x], triangle.depthA * px + rowDepth);
+                }
+            }
+        }
+    }
+}
+
+void OcclusionCuller::BuildHierarchy() {
+    // 每个纹素保存其覆盖区域内的最远深度，测试时只会高估可见性
+    for (size_t i = 1; i < m_Levels.size(); ++i) {
+        const Level& source = m_Levels[i - 1];
+        Level& target = m_Levels[i];
+        for (int y = 0; y < target.height; ++y) {
+            const float* row0 = &source.depth[static_cast<size_t>(std::min(y * 2, source.height - 1)) * static_cast<size_t>(source.stride)];
+            const float* row1 = &source.depth[static_cast<size_t>(std::min(y * 2 + 1, source.height - 1)) * static_cast<size_t>(source.stride)];
+            float* output = &target.depth[static_cast<size_t>(y) * static_cast<size_t>(target.stride)];
+            for (int x = 0; x < target.width; ++x) {
+                const int x0 = std::min(x * 2, source.width - 1);
+                const int x1 = std::min(x * 2 + 1, source.width - 1);
+                output[x] = std::max(std::max(row0[x0], row0[x1]), std::max(row1[x0], row1[x1]));
+            }
+        }
+    }
+}
+
+bool OcclusionCuller::IsVisible(const OcclusionBounds& bounds) const {
+    return TestBounds(bounds);
+}
+
+void OcclusionCuller::TestVisibility(const OcclusionBounds* bounds, uint32_t count, uint8_t* visible) {
+    if (!bounds || !visible || count == 0) {
+        return;
+    }
+    JobSystem::GetInstance().ParallelFor(count, 64, [this, bounds, visible](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            visible[i] = TestBounds(bounds[i]) ? 1 : 0;
+        }
+    });
+
+    m_Stats.testedObjects += count;
+    m_Stats.occludedObjects += static_cast<uint32_t>(std::count(visible, visible + count, static_cast<uint8_t>(0)));
+}
+
+bool OcclusionCuller::TestBounds(const OcclusionBounds& bounds) const {
+    const float width = static_cast<float>(m_Config.width);
+    const float height = static_cast<float>(m_Config.height);
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+    float nearestDepth;
+    uint32_t behindNear;
+
+#ifdef PLE_SIMD_SSE2
+    // 以中心加减半尺寸表示8个角点：clip = center * M ± extent.x * row0 ± extent.y * row1 ± extent.z * row2
+    const auto& m = m_ViewProjection.m;
+    const __m128 half = _mm_set1_ps(0.5f);
+    const Vector3 center((bounds.min.x + bounds.max.x) * 0.5f, (bounds.min.y + bounds.max.y) * 0.5f, (bounds.min.z + bounds.max.z) * 0.5f);
+    const Vector3 extent((bounds.max.x - bounds.min.x) * 0.5f, (bounds.max.y - bounds.min.y) * 0.5f, (bounds.max.z - bounds.min.z) * 0.5f);
+    const __m128 row0 = _mm_loadu_ps(&m[0]);
+    const __m128 row1 = _mm_loadu_ps(&m[4]);
+    const __m128 row2 = _mm_loadu_ps(&m[8]);
+    const __m128 base = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(center.x), row0), _mm_mul_ps(_mm_set1_ps(center.y), row1)),
+                                   _mm_add_ps(_mm_mul_ps(_mm_set1_ps(center.z), row2), _mm_loadu_ps(&m[12])));
+    const __m128 axisX = _mm_mul_ps(_mm_set1_ps(extent.x), row0);
+    const __m128 axisY = _mm_mul_ps(_mm_set1_ps(extent.y), row1);
+    const __m128 axisZ = _mm_mul_ps(_mm_set1_ps(extent.z), row2);
+    const __m128 front = _mm_add_ps(base, axisZ);
+    const __m128 back = _mm_sub_ps(base, axisZ);
+    const __m128 frontTop = _mm_add_ps(front, axisY);
+    const __m128 frontBottom = _mm_sub_ps(front, axisY);
+    const __m128 backTop = _mm_add_ps(back, axisY);
+    const __m128 backBottom = _mm_sub_ps(back, axisY);
+    __m128 cornerX0 = _mm_add_ps(frontTop, axisX);
+    __m128 cornerY0 = _mm_sub_ps(frontTop, axisX);
+    __m128 cornerZ0 = _mm_add_ps(frontBottom, axisX);
+    __m128 cornerW0 = _mm_sub_ps(frontBottom, axisX);
+    __m128 cornerX1 = _mm_add_ps(backTop, axisX);
+    __m128 cornerY1 = _mm_sub_ps(backTop, axisX);
+    __m128 cornerZ1 = _mm_add_ps(backBottom, axisX);
+    __m128 cornerW1 = _mm_sub_ps(backBottom, axisX);
+    // 转置为每个寄存器保存4个角点的同一分量
+    _MM_TRANSPOSE4_PS(cornerX0, cornerY0, cornerZ0, cornerW0);
+    _MM_TRANSPOSE4_PS(cornerX1, cornerY1, cornerZ1, cornerW1);
+
+    const __m128 zero = _mm_setzero_ps();
+    behindNear = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmplt_ps(cornerZ0, zero)) | (_mm_movemask_ps(_mm_cmplt_ps(cornerZ1, zero)) << 4));
+    if (behindNear != 0) {
+        // 与近平面相交时投影矩形不可靠，保守地判定为可见；全部在近平面之前则不可见
+        return behindNear != 0xFF;
+    }
+
+    const __m128 epsilon = _mm_set1_ps(1e-6f);
+    const __m128 inverseW0 = _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(cornerW0, epsilon));
+    const __m128 inverseW1 = _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(cornerW1, epsilon));
+    const __m128 scaleX = _mm_set1_ps(width);
+    const __m128 scaleY = _mm_set1_ps(height);
+    const __m128 screenX0 = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(cornerX0, inverseW0), half), half), scaleX);
+    const __m128 screenX1 = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(cornerX1, inverseW1), half), half), scaleX);
+    const __m128 screenY0 = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(cornerY0, inverseW0), half), half), scaleY);
+    const __m128 screenY1 = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(cornerY1, inverseW1), half), half), scaleY);
+    const __m128 depth = _mm_min_ps(_mm_mul_ps(cornerZ0, inverseW0), _mm_mul_ps(cornerZ1, inverseW1));
+
+    alignas(16) float lanes[4][4];
+    _mm_store_ps(lanes[0], _mm_min_ps(screenX0, screenX1));
+    _mm_store_ps(lanes[1], _mm_max_ps(screenX0, screenX1));
+    _mm_store_ps(lanes[2], _mm_min_ps(screenY0, screenY1));
+    _mm_store_ps(lanes[3], _mm_max_ps(screenY0, screenY1));
+    alignas(16) float depths[4];
+    _mm_store_ps(depths, depth);
+    minX = std::min(std::min(lanes[0][0], lanes[0][1]), std::min(lanes[0][2], lanes[0][3]));
+    maxX = std::max(std::max(lanes[1][0], lanes[1][1]), std::max(lanes[1][2], lanes[1][3]));
+    minY = std::min(std::min(lanes[2][0], lanes[2][1]), std::min(lanes[2][2], lanes[2][3]));
+    maxY = std::max(std::max(lanes[3][0], lanes[3][1]), std::max(lanes[3][2], lanes[3][3]));
+    nearestDepth = std::min(std::min(depths[0], depths[1]), std::min(depths[2], depths[3]));
+#else
+    minX = std::numeric_limits<float>::max();
+    minY = std::numeric_limits<float>::max();
+    maxX = std::numeric_limits<float>::lowest();
+    maxY = std::numeric_limits<float>::lowest();
+    nearestDepth = std::numeric_limits<float>::max();
+    behindNear = 0;
+    for (int i = 0; i < 8; ++i) {
+        const Vector3 corner((i & 1) ? bounds.max.x : bounds.min.x,
+                             (i & 2) ? bounds.max.y : bounds.min.y,
+                             (i & 4) ? bounds.max.z : bounds.min.z);
+        const Vector4 clip = TransformPoint(corner, m_ViewProjection);
+        if (clip.z < 0.0f) {
+            ++behindNear;
+            continue;
+        }
+        const float inverseW = 1.0f / std::max(clip.w, 1e-6f);
+        const float x = (clip.x * inverseW * 0.5f + 0.5f) * width;
+        const float y = (clip.y * inverseW * 0.5f + 0.5f) * height;
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        nearestDepth = std::min(nearestDepth, clip.z * inverseW);
+    }
+
+    // 与近平面相交时投影矩形不可靠，保守地判定为可见；全部在近平面之前则不可见
+    if (behindNear > 0) {
+        return behindNear != 8;
+    }
+#endif
+
+    if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height) {
+        return false;
+    }
+
+    const int x0 = std::max(0, static_cast<int>(minX));
+    const int y0 = std::max(0, static_cast<int>(minY));
+    const int x1 = std::min(m_Config.width - 1, static_cast<int>(maxX));
+    const int y1 = std::min(m_Config.height - 1, static_cast<int>(maxY));
+
+    // 选择矩形最多跨越2x2个纹素的层级
+    uint32_t level = 0;
+    while (level + 1 < m_Levels.size() && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1)) {
+        ++level;
+    }
+
+    const Level& hierarchy = m_Levels[level];
+    float farthest = 0.0f;
+    for (int y = y0 >> level; y <= (y1 >> level); ++y) {
+        const float* row = &hierarchy.depth[static_cast<size_t>(y) * static_cast<size_t>(hierarchy.stride)];
+        for (int x = x0 >> level; x <= (x1 >> level); ++x) {
+            farthest = std::max(farthest, row[x]);
+        }
+    }
+    return nearestDepth <= farthest;
+}
+
+const float* OcclusionCuller::GetDepth(uint32_t level, int& width, int& height, int& stride) const {
+    if (level >= m_Levels.size()) {
+        width = height = stride = 0;
+        return nullptr;
+    }
+    const Level& hierarchy = m_Levels[level];
+    width = hierarchy.width;
+    height = hierarchy.height;
+    stride = hierarchy.stride;
+    return hierarchy.depth.data();
+}
+
+} // namespace PLE
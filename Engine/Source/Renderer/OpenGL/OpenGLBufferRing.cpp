@@ -0,0 +1,114 @@
+/**
+ * @file OpenGLBufferRing.cpp
+ * @brief 持久映射的OpenGL环形缓冲区实现
+ */
+
+#include "OpenGLBufferRing.h"
+
+#ifdef PLE_RENDERER_OPENGL
+
+#include <iostream>
+
+namespace PLE {
+
+namespace {
+
+void WaitFence(GLsync& fence) {
+    if (!fence) {
+        return;
+    }
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    while (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED && result != GL_WAIT_FAILED) {
+        result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+} // namespace
+
+OpenGLBufferRing::~OpenGLBufferRing() {
+    Shutdown();
+}
+
+bool OpenGLBufferRing::Initialize(uint32_t frameSize, uint32_t frameCount, uint32_t alignment) {
+    m_Alignment = alignment == 0 ? 1 : alignment;
+    m_FrameSize = (frameSize + m_Alignment - 1) / m_Alignment * m_Alignment;
+    m_Fences.assign(frameCount == 0 ? 1 : frameCount, nullptr);
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    const GLsizeiptr totalSize = static_cast<GLsizeiptr>(m_FrameSize) * static_cast<GLsizeiptr>(m_Fences.size());
+    glCreateBuffers(1, &m_Buffer);
+    glNamedBufferStorage(m_Buffer, totalSize, nullptr, flags);
+    m_Mapped = static_cast<uint8_t*>(glMapNamedBufferRange(m_Buffer, 0, totalSize, flags));
+    if (!m_Mapped) {
+        std::cerr << "持久映射缓冲区失败！" << std::endl;
+        Shutdown();
+        return false;
+    }
+
+    m_FrameIndex = 0;
+    m_Head = 0;
+    return true;
+}
+
+void OpenGLBufferRing::Shutdown() {
+    for (GLsync& fence : m_Fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (m_Buffer) {
+        if (m_Mapped) {
+            glUnmapNamedBuffer(m_Buffer);
+            m_Mapped = nullptr;
+        }
+        glDeleteBuffers(1, &m_Buffer);
+        m_Buffer = 0;
+    }
+}
+
+void OpenGLBufferRing::BeginFrame() {
+    m_FrameIndex = (m_FrameIndex + 1) % static_cast<uint32_t>(m_Fences.size());
+    m_Head = 0;
+    WaitFence(m_Fences[m_FrameIndex]);
+}
+
+void OpenGLBufferRing::EndFrame() {
+    GLsync& fence = m_Fences[m_FrameIndex];
+    if (fence) {
+        glDeleteSync(fence);
+    }
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void* OpenGLBufferRing::Allocate(uint32_t size, uint32_t& offset) {
+    const uint32_t alignedSize = (size + m_Alignment - 1) / m_Alignment * m_Alignment;
+    if (alignedSize > m_FrameSize) {
+        return nullptr;
+    }
+
+    if (m_Head + alignedSize > m_FrameSize) {
+        // 本帧区域耗尽：等待已提交的命令完成后从区域开头复用
+        GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        WaitFence(fence);
+        m_Head = 0;
+    }
+    return AllocateInFrame(size, offset);
+}
+
+void* OpenGLBufferRing::AllocateInFrame(uint32_t size, uint32_t& offset) {
+    const uint32_t alignedSize = (size + m_Alignment - 1) / m_Alignment * m_Alignment;
+    if (m_Head + alignedSize > m_FrameSize) {
+        return nullptr;
+    }
+
+    offset = m_FrameIndex * m_FrameSize + m_Head;
+    m_Head += alignedSize;
+    return m_Mapped + offset;
+}
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_OPENGL
@@ -0,0 +1,86 @@
+/**
+ * @file OpenGLBufferRing.h
+ * @brief 持久映射的OpenGL环形缓冲区
+ */
+
+#pragma once
+
+#include "OpenGLCommon.h"
+
+#ifdef PLE_RENDERER_OPENGL
+
+#include <cstdint>
+#include <vector>
+
+namespace PLE {
+
+/**
+ * @brief 持久映射的环形缓冲区
+ *
+ * 用glBufferStorage创建一次、永久映射（PERSISTENT | COHERENT），
+ * 按帧划分为若干区域。每帧开始时等待该区域上一次使用的栅栏，
+ * 之后CPU直接写入映射内存，不再需要glBufferSubData或重新映射。
+ */
+class OpenGLBufferRing {
+public:
+    OpenGLBufferRing() = default;
+    ~OpenGLBufferRing();
+
+    /**
+     * @brief 创建缓冲区
+     * @param frameSize 每帧区域大小（字节）
+     * @param frameCount 区域数量（同时在途的帧数）
+     * @param alignment 每次分配的对齐要求
+     * @return 是否成功创建
+     */
+    bool Initialize(uint32_t frameSize, uint32_t frameCount, uint32_t alignment);
+
+    /**
+     * @brief 销毁缓冲区
+     */
+    void Shutdown();
+
+    /**
+     * @brief 切换到下一帧的区域，必要时等待GPU用完该区域
+     */
+    void BeginFrame();
+
+    /**
+     * @brief 在当前区域的命令之后插入栅栏
+     */
+    void EndFrame();
+
+    /**
+     * @brief 分配一段空间
+     * @param size 字节数
+     * @param offset 输出在缓冲区中的偏移
+     * @return 可写入的映射指针；当前帧区域耗尽时会等待GPU空闲后从头复用
+     */
+    void* Allocate(uint32_t size, uint32_t& offset);
+
+    /**
+     * @brief 在当前帧区域内分配一段空间，不等待GPU
+     * @param size 字节数
+     * @param offset 输出在缓冲区中的偏移
+     * @return 可写入的映射指针；当前帧区域耗尽时返回nullptr
+     */
+    void* AllocateInFrame(uint32_t size, uint32_t& offset);
+
+    /**
+     * @brief 获取GL缓冲区名
+     */
+    GLuint GetBuffer() const { return m_Buffer; }
+
+private:
+    GLuint m_Buffer = 0;
+    uint8_t* m_Mapped = nullptr;
+    uint32_t m_FrameSize = 0;
+    uint32_t m_Alignment = 256;
+    uint32_t m_FrameIndex = 0;
+    uint32_t m_Head = 0;
+    std::vector<GLsync> m_Fences;
+};
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_OPENGL
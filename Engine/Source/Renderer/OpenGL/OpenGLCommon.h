@@ -0,0 +1,18 @@
+/**
+ * @file OpenGLCommon.h
+ * @brief OpenGL后端公共头文件
+ */
+
+#pragma once
+
+#include "PhantomLightEngine.h"
+
+#ifdef PLE_RENDERER_OPENGL
+
+// 直接链接GLVND提供的OpenGL 4.5核心函数
+#ifndef GL_GLEXT_PROTOTYPES
+    #define GL_GLEXT_PROTOTYPES
+#endif
+#include <GL/glcorearb.h>
+
+#endif // PLE_RENDERER_OPENGL
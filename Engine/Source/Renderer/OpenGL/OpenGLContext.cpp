@@ -0,0 +1,155 @@
+/**
+ * @file OpenGLContext.cpp
+ * @brief 基于EGL的OpenGL上下文实现
+ */
+
+#include "OpenGLContext.h"
+
+#ifdef PLE_RENDERER_OPENGL
+
+#include <cstdint>
+#include <iostream>
+
+#include "Platform/Window.h"
+
+namespace PLE {
+
+OpenGLContext::~OpenGLContext() {
+    Shutdown();
+}
+
+bool OpenGLContext::Initialize(std::shared_ptr<Window> window, bool debug, bool vsync) {
+    if (window) {
+        m_Display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    } else {
+        // 优先使用Mesa的无表面平台，不依赖X11/Wayland
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (getPlatformDisplay) {
+            m_Display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        }
+        if (m_Display == EGL_NO_DISPLAY) {
+            m_Display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        }
+    }
+
+    if (m_Display == EGL_NO_DISPLAY || !eglInitialize(m_Display, nullptr, nullptr)) {
+        std::cerr << "初始化EGL显示失败！" << std::endl;
+        return false;
+    }
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        std::cerr << "EGL不支持桌面OpenGL！" << std::endl;
+        return false;
+    }
+
+    EGLConfig config = nullptr;
+    EGLint configCount = 0;
+    const EGLint configAttributes[] = {
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_SURFACE_TYPE, window ? EGL_WINDOW_BIT : 0,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_DEPTH_SIZE, window ? 24 : 0,
+        EGL_NONE
+    };
+    eglChooseConfig(m_Display, configAttributes, &config, 1, &configCount);
+    if (configCount == 0) {
+        if (window) {
+            std::cerr << "找不到合适的EGL配置！" << std::endl;
+            return false;
+        }
+        // 无表面平台可能不提供任何配置，此时使用无配置上下文
+        config = nullptr;
+    }
+
+    m_Config = config;
+    m_Debug = debug;
+    m_Context = CreateContext(EGL_NO_CONTEXT);
+    if (m_Context == EGL_NO_CONTEXT) {
+        std::cerr << "创建OpenGL 4.5上下文失败！错误码：0x" << std::hex << eglGetError() << std::dec << std::endl;
+        return false;
+    }
+
+    if (window) {
+        auto nativeWindow = reinterpret_cast<EGLNativeWindowType>(reinterpret_cast<uintptr_t>(window->GetNativeWindow()));
+        m_Surface = eglCreateWindowSurface(m_Display, config, nativeWindow, nullptr);
+        if (m_Surface == EGL_NO_SURFACE) {
+            std::cerr << "创建EGL窗口表面失败！" << std::endl;
+            return false;
+        }
+    }
+
+    if (!MakeCurrent()) {
+        std::cerr << "设置当前OpenGL上下文失败！" << std::endl;
+        return false;
+    }
+    if (window) {
+        eglSwapInterval(m_Display, vsync ? 1 : 0);
+    }
+    return true;
+}
+
+void OpenGLContext::Shutdown() {
+    if (m_Display == EGL_NO_DISPLAY) {
+        return;
+    }
+
+    eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (m_Surface != EGL_NO_SURFACE) {
+        eglDestroySurface(m_Display, m_Surface);
+        m_Surface = EGL_NO_SURFACE;
+    }
+    if (m_Context != EGL_NO_CONTEXT) {
+        eglDestroyContext(m_Display, m_Context);
+        m_Context = EGL_NO_CONTEXT;
+    }
+    eglTerminate(m_Display);
+    m_Display = EGL_NO_DISPLAY;
+}
+
+bool OpenGLContext::MakeCurrent() {
+    return eglMakeCurrent(m_Display, m_Surface, m_Surface, m_Context) == EGL_TRUE;
+}
+
+EGLContext OpenGLContext::CreateSharedContext() {
+    if (m_Context == EGL_NO_CONTEXT) {
+        return EGL_NO_CONTEXT;
+    }
+    // eglBindAPI是线程局部状态，工作线程默认绑定的是OpenGL ES
+    EGLContext context = eglBindAPI(EGL_OPENGL_API) ? CreateContext(m_Context) : EGL_NO_CONTEXT;
+    if (context == EGL_NO_CONTEXT) {
+        std::cerr << "创建共享OpenGL上下文失败！错误码：0x" << std::hex << eglGetError() << std::dec << std::endl;
+    }
+    return context;
+}
+
+bool OpenGLContext::MakeSharedContextCurrent(EGLContext context) {
+    return eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, context) == EGL_TRUE;
+}
+
+void OpenGLContext::DestroySharedContext(EGLContext context) {
+    if (context != EGL_NO_CONTEXT) {
+        eglDestroyContext(m_Display, context);
+    }
+}
+
+EGLContext OpenGLContext::CreateContext(EGLContext shareContext) {
+    const EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 4,
+        EGL_CONTEXT_MINOR_VERSION, 5,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_CONTEXT_OPENGL_DEBUG, m_Debug ? EGL_TRUE : EGL_FALSE,
+        EGL_NONE
+    };
+    return eglCreateContext(m_Display, m_Config, shareContext, contextAttributes);
+}
+
+void OpenGLContext::SwapBuffers() {
+    if (m_Surface != EGL_NO_SURFACE) {
+        eglSwapBuffers(m_Display, m_Surface);
+    }
+}
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_OPENGL
@@ -0,0 +1,90 @@
+/**
+ * @file OpenGLContext.h
+ * @brief 基于EGL的OpenGL上下文
+ */
+
+#pragma once
+
+#include "OpenGLCommon.h"
+
+#ifdef PLE_RENDERER_OPENGL
+
+#include <memory>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+namespace PLE {
+
+class Window;
+
+/**
+ * @brief 基于EGL的OpenGL 4.5核心上下文
+ *
+ * 传入窗口时创建窗口表面；不传入窗口时使用EGL_MESA_platform_surfaceless
+ * 创建无表面上下文，可在没有显示服务器和GPU的环境（如Mesa llvmpipe）中运行。
+ */
+class OpenGLContext {
+public:
+    OpenGLContext() = default;
+    ~OpenGLContext();
+
+    /**
+     * @brief 创建上下文并设为当前
+     * @param window 窗口指针，可为nullptr
+     * @param debug 是否创建调试上下文
+     * @param vsync 是否启用垂直同步（仅窗口模式有效）
+     * @return 是否成功创建
+     */
+    bool Initialize(std::shared_ptr<Window> window, bool debug, bool vsync);
+
+    /**
+     * @brief 销毁上下文
+     */
+    void Shutdown();
+
+    /**
+     * @brief 设为调用线程的当前上下文
+     */
+    bool MakeCurrent();
+
+    /**
+     * @brief 创建与主上下文共享对象的无表面上下文，供后台线程编译着色器
+     * @return 上下文，失败时返回EGL_NO_CONTEXT
+     */
+    EGLContext CreateSharedContext();
+
+    /**
+     * @brief 将共享上下文设为调用线程的当前上下文（无表面）
+     * @param context 共享上下文，EGL_NO_CONTEXT表示解除当前上下文
+     */
+    bool MakeSharedContextCurrent(EGLContext context);
+
+    /**
+     * @brief 销毁共享上下文
+     */
+    void DestroySharedContext(EGLContext context);
+
+    /**
+     * @brief 交换前后缓冲，无表面时不执行任何操作
+     */
+    void SwapBuffers();
+
+    /**
+     * @brief 是否为无表面（离屏）上下文
+     */
+    bool IsHeadless() const { return m_Surface == EGL_NO_SURFACE; }
+
+private:
+    EGLContext CreateContext(EGLContext shareContext);
+
+    EGLDisplay m_Display = EGL_NO_DISPLAY;
+    EGLContext m_Context = EGL_NO_CONTEXT;
+    EGLSurface m_Surface = EGL_NO_SURFACE;
+    EGLConfig m_Config = nullptr;
+    bool m_Debug = false;
+};
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_OPENGL
@@ -0,0 +1,604 @@
+/**
+ * @file OpenGLRenderSystem.cpp
+ * @brief OpenGL 4.5渲染系统实现
+ */
+
+#include "OpenGLRenderSystem.h"
+
+#ifdef PLE_RENDERER_OPENGL
+
+#include <cstring>
+#include <iostream>
+
+#include "OpenGLResources.h"
+#include "../BlockCompression.h"
+#include "Platform/Window.h"
+#include "Scene/Camera.h"
+
+namespace PLE {
+
+namespace {
+
+// 环形缓冲区：uniform每帧4MB，瞬态几何每帧16MB（足够10万个精灵），最多3帧在途
+constexpr uint32_t UNIFORM_RING_FRAME_SIZE = 4 * 1024 * 1024;
+constexpr uint32_t GEOMETRY_RING_FRAME_SIZE = 16 * 1024 * 1024;
+constexpr uint32_t RING_FRAME_COUNT = 3;
+
+void APIENTRY DebugMessageCallback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam) {
+    (void)source;
+    (void)id;
+    (void)length;
+    (void)userParam;
+    if (severity == GL_DEBUG_SEVERITY_NOTIFICATION) {
+        return;
+    }
+    std::cerr << "[OpenGL" << (type == GL_DEBUG_TYPE_ERROR ? "错误" : "") << "] " << message << std::endl;
+}
+
+} // namespace
+
+OpenGLRenderSystem::OpenGLRenderSystem(const RenderSystemConfig& config)
+    : m_Config(config) {
+}
+
+OpenGLRenderSystem::~OpenGLRenderSystem() {
+    Shutdown();
+}
+
+bool OpenGLRenderSystem::Initialize(std::shared_ptr<Window> window) {
+    if (m_Initialized) {
+        return true;
+    }
+
+    if (!m_Context.Initialize(window, m_Config.enableDebugMode, m_Config.enableVSync)) {
+        return false;
+    }
+    m_Window = window;
+
+    if (m_Config.enableDebugMode) {
+        glEnable(GL_DEBUG_OUTPUT);
+        glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+        glDebugMessageCallback(DebugMessageCallback, nullptr);
+    }
+
+    m_RenderThread = std::this_thread::get_id();
+    GLint binaryFormatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount);
+    m_ProgramBinarySupported = binaryFormatCount > 0;
+
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+    for (GLint i = 0; i < extensionCount && !m_S3TCSupported; ++i) {
+        const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+        m_S3TCSupported = extension && std::strcmp(extension, "GL_EXT_texture_compression_s3tc") == 0;
+    }
+
+    // 与Matrix4的投影约定一致：深度范围[0, 1]
+    glClipControl(GL_LOWER_LEFT, GL_ZERO_TO_ONE);
+
+    GLint uniformAlignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+    if (!m_UniformRing.Initialize(UNIFORM_RING_FRAME_SIZE, RING_FRAME_COUNT, static_cast<uint32_t>(uniformAlignment))) {
+        m_Context.Shutdown();
+        return false;
+    }
+    // 按顶点大小对齐，顶点偏移总能换算为基础顶点序号
+    if (!m_GeometryRing.Initialize(GEOMETRY_RING_FRAME_SIZE, RING_FRAME_COUNT, sizeof(Vertex))) {
+        m_UniformRing.Shutdown();
+        m_Context.Shutdown();
+        return false;
+    }
+    glCreateVertexArrays(1, &m_TransientVertexArray);
+    glVertexArrayVertexBuffer(m_TransientVertexArray, 0, m_GeometryRing.GetBuffer(), 0, sizeof(Vertex));
+    glVertexArrayElementBuffer(m_TransientVertexArray, m_GeometryRing.GetBuffer());
+    OpenGLMesh::SetupVertexFormat(m_TransientVertexArray);
+
+    if (m_Context.IsHeadless()) {
+        if (!CreateDefaultFramebuffer(m_Config.width, m_Config.height)) {
+            glDeleteVertexArrays(1, &m_TransientVertexArray);
+            m_TransientVertexArray = 0;
+            m_GeometryRing.Shutdown();
+            m_UniformRing.Shutdown();
+            m_Context.Shutdown();
+            return false;
+        }
+    } else {
+        m_DefaultWidth = static_cast<int>(window->GetWidth());
+        m_DefaultHeight = static_cast<int>(window->GetHeight());
+    }
+
+    m_StateCache.Invalidate();
+    BindDefaultFramebuffer();
+    m_StateCache.SetDepthTest(true);
+    m_StateCache.SetDepthWrite(true);
+    glDepthFunc(GL_LEQUAL);
+
+    m_Initialized = true;
+    std::cout << "OpenGL渲染系统初始化成功：" << GetGPUInfo() << "，" << GetAPIVersion() << std::endl;
+    return true;
+}
+
+void OpenGLRenderSystem::Shutdown() {
+    if (!m_Initialized) {
+        return;
+    }
+
+    glFinish();
+    {
+        std::lock_guard<std::mutex> lock(m_WorkerMutex);
+        for (auto& entry : m_WorkerContexts) {
+            m_Context.DestroySharedContext(entry.second);
+        }
+        m_WorkerContexts.clear();
+    }
+    m_CurrentTarget = nullptr;
+    m_Camera = nullptr;
+    DestroyDefaultFramebuffer();
+    glDeleteVertexArrays(1, &m_TransientVertexArray);
+    m_TransientVertexArray = 0;
+    for (auto& entry : m_TransientLayoutArrays) {
+        glDeleteVertexArrays(1, &entry.second);
+    }
+    m_TransientLayoutArrays.clear();
+    m_GeometryRing.Shutdown();
+    m_UniformRing.Shutdown();
+    m_Context.Shutdown();
+    m_Window = nullptr;
+    m_Initialized = false;
+}
+
+void OpenGLRenderSystem::BeginFrame() {
+    BeginFrameStats();
+    m_UniformRing.BeginFrame();
+    m_GeometryRing.BeginFrame();
+    ++m_FrameSerial;
+    m_CurrentTarget = nullptr;
+    BindDefaultFramebuffer();
+}
+
+void OpenGLRenderSystem::EndFrame() {
+    m_UniformRing.EndFrame();
+    m_GeometryRing.EndFrame();
+    if (m_Context.IsHeadless()) {
+        glFlush();
+    } else {
+        m_Context.SwapBuffers();
+    }
+
+    m_Stats.stateChanges = static_cast<uint32_t>(m_StateCache.GetStateChangeCount() - m_StateChangeBase);
+    m_Stats.shaderBinds = static_cast<uint32_t>(m_StateCache.GetProgramChangeCount() - m_ProgramChangeBase);
+    m_Stats.textureBinds = static_cast<uint32_t>(m_StateCache.GetTextureChangeCount() - m_TextureChangeBase);
+    m_StateChangeBase = m_StateCache.GetStateChangeCount();
+    m_ProgramChangeBase = m_StateCache.GetProgramChangeCount();
+    m_TextureChangeBase = m_StateCache.GetTextureChangeCount();
+    EndFrameStats();
+}
+
+void OpenGLRenderSystem::Clear(const Vector4& color, bool depth, bool stencil) {
+    const GLuint framebuffer = m_StateCache.GetFramebuffer();
+    const float clearColor[4] = { color.x, color.y, color.z, color.w };
+    glClearNamedFramebufferfv(framebuffer, GL_COLOR, 0, clearColor);
+
+    if (depth) {
+        // 深度写入关闭时清除无效
+        m_StateCache.SetDepthWrite(true);
+    }
+    if (depth && stencil) {
+        glClearNamedFramebufferfi(framebuffer, GL_DEPTH_STENCIL, 0, 1.0f, 0);
+    } else if (depth) {
+        const float clearDepth = 1.0f;
+        glClearNamedFramebufferfv(framebuffer, GL_DEPTH, 0, &clearDepth);
+    } else if (stencil) {
+        const GLint clearStencil = 0;
+        glClearNamedFramebufferiv(framebuffer, GL_STENCIL, 0, &clearStencil);
+    }
+}
+
+void OpenGLRenderSystem::SetViewport(int x, int y, int width, int height) {
+    m_StateCache.SetViewport(x, y, width, height);
+}
+
+std::shared_ptr<Shader> OpenGLRenderSystem::CreateShader(const std::string& vertexShaderSource, const std::string& fragmentShaderSource) {
+    auto shader = std::make_shared<OpenGLShader>(vertexShaderSource, fragmentShaderSource);
+    if (!shader->IsValid()) {
+        return nullptr;
+    }
+    if (std::this_thread::get_id() != m_RenderThread) {
+        glFinish();
+    }
+    return shader;
+}
+
+std::vector<uint8_t> OpenGLRenderSystem::GetShaderBinary(const std::shared_ptr<Shader>& shader) {
+    std::vector<uint8_t> binary;
+    auto glShader = std::static_pointer_cast<OpenGLShader>(shader);
+    if (!m_ProgramBinarySupported || !glShader || !glShader->IsValid()) {
+        return binary;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(glShader->GetProgram(), GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return binary;
+    }
+    // 前4字节保存二进制格式
+    binary.resize(sizeof(GLenum) + static_cast<size_t>(length));
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(glShader->GetProgram(), length, &written, &format, binary.data() + sizeof(GLenum));
+    std::memcpy(binary.data(), &format, sizeof(GLenum));
+    binary.resize(sizeof(GLenum) + static_cast<size_t>(written));
+    return written > 0 ? binary : std::vector<uint8_t>();
+}
+
+std::shared_ptr<Shader> OpenGLRenderSystem::CreateShaderFromBinary(const std::vector<uint8_t>& binary) {
+    if (!m_ProgramBinarySupported || binary.size() <= sizeof(GLenum)) {
+        return nullptr;
+    }
+    GLenum format = 0;
+    std::memcpy(&format, binary.data(), sizeof(GLenum));
+    auto shader = std::make_shared<OpenGLShader>(format, binary.data() + sizeof(GLenum), static_cast<GLsizei>(binary.size() - sizeof(GLenum)));
+    if (!shader->IsValid()) {
+        return nullptr;
+    }
+    if (std::this_thread::get_id() != m_RenderThread) {
+        glFinish();
+    }
+    return shader;
+}
+
+bool OpenGLRenderSystem::AttachWorkerThread() {
+    if (!m_Initialized) {
+        return false;
+    }
+    const std::thread::id thread = std::this_thread::get_id();
+    if (thread == m_RenderThread) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(m_WorkerMutex);
+    if (m_WorkerContexts.count(thread)) {
+        return true;
+    }
+    EGLContext context = m_Context.CreateSharedContext();
+    if (context == EGL_NO_CONTEXT) {
+        return false;
+    }
+    if (!m_Context.MakeSharedContextCurrent(context)) {
+        m_Context.DestroySharedContext(context);
+        return false;
+    }
+    m_WorkerContexts.emplace(thread, context);
+    return true;
+}
+
+void OpenGLRenderSystem::DetachWorkerThread() {
+    const std::thread::id thread = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(m_WorkerMutex);
+    auto it = m_WorkerContexts.find(thread);
+    if (it == m_WorkerContexts.end()) {
+        return;
+    }
+    m_Context.MakeSharedContextCurrent(EGL_NO_CONTEXT);
+    m_Context.DestroySharedContext(it->second);
+    m_WorkerContexts.erase(it);
+}
+
+std::shared_ptr<Texture> OpenGLRenderSystem::CreateTexture(int width, int height, const void* data) {
+    if (width <= 0 || height <= 0) {
+        std::cerr << "纹理尺寸无效！" << std::endl;
+        return nullptr;
+    }
+    if (data) {
+        CountUpload(static_cast<uint64_t>(width) * height * 4);
+    }
+    return std::make_shared<OpenGLTexture>(width, height, data);
+}
+
+std::shared_ptr<Texture> OpenGLRenderSystem::CreateTexture(const TextureData& data) {
+    if (!data.IsValid()) {
+        std::cerr << "纹理数据无效！" << std::endl;
+        return nullptr;
+    }
+    if (!IsTextureFormatSupported(data.format)) {
+        // 驱动不支持该压缩格式时在CPU上解码为RGBA8
+        TextureData decompressed;
+        if (!BlockCompression::DecompressTexture(data, decompressed)) {
+            std::cerr << "纹理格式不受支持且无法解码！" << std::endl;
+            return nullptr;
+        }
+        CountUpload(decompressed.pixels.size());
+        return std::make_shared<OpenGLTexture>(decompressed);
+    }
+    CountUpload(data.pixels.size());
+    return std::make_shared<OpenGLTexture>(data);
+}
+
+bool OpenGLRenderSystem::IsTextureFormatSupported(TextureFormat format) const {
+    switch (format) {
+    case TextureFormat::BC1:
+    case TextureFormat::BC3:
+        return m_S3TCSupported;
+    default:
+        return true;
+    }
+}
+
+std::shared_ptr<Mesh> OpenGLRenderSystem::CreateMesh(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) {
+    if (!vertices || vertexCount == 0) {
+        std::cerr << "网格顶点数据为空！" << std::endl;
+        return nullptr;
+    }
+    CountUpload(static_cast<uint64_t>(vertexCount) * sizeof(Vertex) + (indices ? indexCount * sizeof(uint32_t) : 0));
+    return std::make_shared<OpenGLMesh>(vertices, vertexCount, VertexLayout::Standard(), indices, indexCount);
+}
+
+std::shared_ptr<Mesh> OpenGLRenderSystem::CreateMesh(const void* vertices, uint32_t vertexCount, const VertexLayout& layout,
+                                                     const uint32_t* indices, uint32_t indexCount) {
+    if (!vertices || vertexCount == 0) {
+        std::cerr << "网格顶点数据为空！" << std::endl;
+        return nullptr;
+    }
+    if (!layout.IsValid()) {
+        std::cerr << "网格顶点布局无效！" << std::endl;
+        return nullptr;
+    }
+    CountUpload(static_cast<uint64_t>(vertexCount) * layout.stride + (indices ? indexCount * sizeof(uint32_t) : 0));
+    return std::make_shared<OpenGLMesh>(vertices, vertexCount, layout, indices, indexCount);
+}
+
+std::shared_ptr<Mesh> OpenGLRenderSystem::CreateTransientMesh(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) {
+    return CreateTransientMesh(vertices, vertexCount, VertexLayout::Standard(), indices, indexCount);
+}
+
+std::shared_ptr<Mesh> OpenGLRenderSystem::CreateTransientMesh(const void* vertices, uint32_t vertexCount, const VertexLayout& layout,
+                                                              const uint32_t* indices, uint32_t indexCount) {
+    if (!vertices || vertexCount == 0) {
+        std::cerr << "网格顶点数据为空！" << std::endl;
+        return nullptr;
+    }
+    if (!layout.IsValid()) {
+        std::cerr << "网格顶点布局无效！" << std::endl;
+        return nullptr;
+    }
+    if (!indices) {
+        indexCount = 0;
+    }
+
+    // 环形缓冲区按sizeof(Vertex)对齐，步长不能整除它时多分配一个顶点，把偏移调整到步长的整数倍
+    const uint32_t stride = layout.stride;
+    const uint32_t padding = sizeof(Vertex) % stride != 0 ? stride : 0;
+    uint32_t vertexOffset = 0;
+    uint32_t indexOffset = 0;
+    const uint32_t vertexBytes = vertexCount * stride;
+    const uint32_t indexBytes = indexCount * static_cast<uint32_t>(sizeof(uint32_t));
+    auto* vertexDestination = static_cast<uint8_t*>(m_GeometryRing.AllocateInFrame(vertexBytes + padding, vertexOffset));
+    void* indexDestination = indexCount > 0 ? m_GeometryRing.AllocateInFrame(indexBytes, indexOffset) : nullptr;
+    if (!vertexDestination || (indexCount > 0 && !indexDestination)) {
+        std::cerr << "本帧的瞬态几何缓冲区已用完！" << std::endl;
+        return nullptr;
+    }
+    const uint32_t skip = (stride - vertexOffset % stride) % stride;
+    vertexDestination += skip;
+    vertexOffset += skip;
+    std::memcpy(vertexDestination, vertices, vertexBytes);
+    if (indexCount > 0) {
+        std::memcpy(indexDestination, indices, indexBytes);
+    }
+    CountUpload(vertexBytes + indexBytes);
+
+    return std::make_shared<OpenGLMesh>(vertexCount, indexCount, layout, vertexOffset / stride,
+                                        indexOffset / static_cast<uint32_t>(sizeof(uint32_t)), m_FrameSerial);
+}
+
+std::shared_ptr<Material> OpenGLRenderSystem::CreateMaterial(std::shared_ptr<Shader> shader) {
+    if (!shader) {
+        std::cerr << "创建材质需要有效的着色器！" << std::endl;
+        return nullptr;
+    }
+    return std::make_shared<OpenGLMaterial>(shader);
+}
+
+std::shared_ptr<Material> OpenGLRenderSystem::CreateMaterialInstance(std::shared_ptr<Material> parent) {
+    if (!parent) {
+        std::cerr << "创建材质实例需要有效的父材质！" << std::endl;
+        return nullptr;
+    }
+    return std::make_shared<OpenGLMaterial>(parent);
+}
+
+std::shared_ptr<RenderTarget> OpenGLRenderSystem::CreateRenderTarget(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        std::cerr << "渲染目标尺寸无效！" << std::endl;
+        return nullptr;
+    }
+    auto renderTarget = std::make_shared<OpenGLRenderTarget>(width, height);
+    if (!renderTarget->IsComplete()) {
+        return nullptr;
+    }
+    return renderTarget;
+}
+
+void OpenGLRenderSystem::SetRenderTarget(std::shared_ptr<RenderTarget> renderTarget) {
+    m_CurrentTarget = renderTarget;
+    if (!renderTarget) {
+        BindDefaultFramebuffer();
+        return;
+    }
+
+    auto glTarget = std::static_pointer_cast<OpenGLRenderTarget>(renderTarget);
+    m_StateCache.BindFramebuffer(glTarget->GetFramebuffer());
+    m_StateCache.SetViewport(0, 0, glTarget->GetWidth(), glTarget->GetHeight());
+}
+
+void OpenGLRenderSystem::DrawMesh(std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material, const Matrix4& transform) {
+    if (!mesh || !material) {
+        return;
+    }
+
+    auto glMesh = std::static_pointer_cast<OpenGLMesh>(mesh);
+    auto glMaterial = std::static_pointer_cast<OpenGLMaterial>(material);
+    CountUpload(glMaterial->Apply(m_StateCache));
+
+    uint32_t offset = 0;
+    auto* perDraw = static_cast<PerDrawData*>(m_UniformRing.Allocate(sizeof(PerDrawData), offset));
+    if (!perDraw) {
+        return;
+    }
+    // 行向量约定：MVP = Model * View * Projection，量化位置的解码合并在模型矩阵中
+    const Matrix4 model = mesh->GetModelMatrix(transform);
+    const Matrix4 modelViewProjection = model * m_ViewProjection;
+    std::memcpy(perDraw->model, model.m.data(), sizeof(perDraw->model));
+    std::memcpy(perDraw->viewProjection, m_ViewProjection.m.data(), sizeof(perDraw->viewProjection));
+    std::memcpy(perDraw->modelViewProjection, modelViewProjection.m.data(), sizeof(perDraw->modelViewProjection));
+    m_StateCache.BindUniformBufferRange(0, m_UniformRing.GetBuffer(), offset, sizeof(PerDrawData));
+    CountUpload(sizeof(PerDrawData));
+
+    const GLenum mode = mesh->GetVertexLayout().topology == PrimitiveTopology::Lines ? GL_LINES : GL_TRIANGLES;
+    if (glMesh->IsTransient()) {
+        if (glMesh->GetFrameSerial() != m_FrameSerial) {
+            std::cerr << "瞬态网格只能在创建它的帧内绘制！" << std::endl;
+            return;
+        }
+        CountDraw(material.get(), glMesh->GetTriangleCount());
+        m_StateCache.BindVertexArray(GetTransientVertexArray(glMesh->GetVertexLayout()));
+        if (glMesh->GetIndexCount() > 0) {
+            const uintptr_t indexOffset = static_cast<uintptr_t>(glMesh->GetFirstIndex()) * sizeof(uint32_t);
+            glDrawElementsBaseVertex(mode, static_cast<GLsizei>(glMesh->GetIndexCount()), GL_UNSIGNED_INT,
+                                     reinterpret_cast<const void*>(indexOffset), static_cast<GLint>(glMesh->GetBaseVertex()));
+        } else {
+            glDrawArrays(mode, static_cast<GLint>(glMesh->GetBaseVertex()), static_cast<GLsizei>(glMesh->GetVertexCount()));
+        }
+        return;
+    }
+
+    CountDraw(material.get(), glMesh->GetTriangleCount());
+    m_StateCache.BindVertexArray(glMesh->GetVertexArray());
+    if (glMesh->GetIndexCount() > 0) {
+        glDrawElements(mode, static_cast<GLsizei>(glMesh->GetIndexCount()), GL_UNSIGNED_INT, nullptr);
+    } else {
+        glDrawArrays(mode, 0, static_cast<GLsizei>(glMesh->GetVertexCount()));
+    }
+}
+
+void OpenGLRenderSystem::SetCamera(std::shared_ptr<Camera> camera) {
+    m_Camera = camera;
+    if (camera) {
+        SetViewProjection(camera->GetViewMatrix(), camera->GetProjectionMatrix());
+    }
+}
+
+void OpenGLRenderSystem::SetViewProjection(const Matrix4& view, const Matrix4& projection) {
+    m_View = view;
+    m_Projection = projection;
+    m_ViewProjection = view * projection;
+}
+
+bool OpenGLRenderSystem::ReadPixels(int x, int y, int width, int height, void* rgba8) {
+    if (!m_Initialized || !rgba8 || width <= 0 || height <= 0) {
+        return false;
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadnPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, width * height * 4, rgba8);
+    return glGetError() == GL_NO_ERROR;
+}
+
+std::shared_ptr<ReadbackBuffer> OpenGLRenderSystem::CreateReadbackBuffer(int width, int height) {
+    if (!m_Initialized || width <= 0 || height <= 0) {
+        std::cerr << "读回缓冲区尺寸无效！" << std::endl;
+        return nullptr;
+    }
+    auto buffer = std::make_shared<OpenGLReadbackBuffer>(width, height);
+    if (!buffer->IsValid()) {
+        return nullptr;
+    }
+    return buffer;
+}
+
+bool OpenGLRenderSystem::ReadPixelsAsync(int x, int y, const std::shared_ptr<ReadbackBuffer>& buffer) {
+    if (!m_Initialized || !buffer) {
+        return false;
+    }
+
+    // 读到像素打包缓冲区时glReadPixels不等待GPU，命令按顺序执行，缓冲区上一次的读取不需要先完成
+    auto* glBuffer = static_cast<OpenGLReadbackBuffer*>(buffer.get());
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, glBuffer->GetHandle());
+    glReadPixels(x, y, buffer->GetWidth(), buffer->GetHeight(), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBuffer->Issue();
+    return glGetError() == GL_NO_ERROR;
+}
+
+uint32_t OpenGLRenderSystem::GetFramesInFlight() const {
+    return RING_FRAME_COUNT;
+}
+
+std::string OpenGLRenderSystem::GetGPUInfo() const {
+    const char* vendor = reinterpret_cast<const char*>(glGetString(GL_VENDOR));
+    const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    return std::string(vendor ? vendor : "") + " " + (renderer ? renderer : "");
+}
+
+std::string OpenGLRenderSystem::GetAPIVersion() const {
+    const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    return std::string("OpenGL ") + (version ? version : "");
+}
+
+bool OpenGLRenderSystem::CreateDefaultFramebuffer(int width, int height) {
+    m_DefaultWidth = width;
+    m_DefaultHeight = height;
+
+    glCreateTextures(GL_TEXTURE_2D, 1, &m_DefaultColor);
+    glTextureStorage2D(m_DefaultColor, 1, GL_RGBA8, width, height);
+    glCreateRenderbuffers(1, &m_DefaultDepthStencil);
+    glNamedRenderbufferStorage(m_DefaultDepthStencil, GL_DEPTH24_STENCIL8, width, height);
+
+    glCreateFramebuffers(1, &m_DefaultFramebuffer);
+    glNamedFramebufferTexture(m_DefaultFramebuffer, GL_COLOR_ATTACHMENT0, m_DefaultColor, 0);
+    glNamedFramebufferRenderbuffer(m_DefaultFramebuffer, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_DefaultDepthStencil);
+    if (glCheckNamedFramebufferStatus(m_DefaultFramebuffer, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "创建离屏默认帧缓冲失败！" << std::endl;
+        DestroyDefaultFramebuffer();
+        return false;
+    }
+    return true;
+}
+
+void OpenGLRenderSystem::DestroyDefaultFramebuffer() {
+    if (m_DefaultFramebuffer) {
+        glDeleteFramebuffers(1, &m_DefaultFramebuffer);
+        glDeleteRenderbuffers(1, &m_DefaultDepthStencil);
+        glDeleteTextures(1, &m_DefaultColor);
+        m_DefaultFramebuffer = 0;
+        m_DefaultDepthStencil = 0;
+        m_DefaultColor = 0;
+    }
+}
+
+void OpenGLRenderSystem::BindDefaultFramebuffer() {
+    m_StateCache.BindFramebuffer(m_DefaultFramebuffer);
+    m_StateCache.SetViewport(0, 0, m_DefaultWidth, m_DefaultHeight);
+}
+
+GLuint OpenGLRenderSystem::GetTransientVertexArray(const VertexLayout& layout) {
+    const uint64_t hash = layout.GetFormatHash();
+    if (hash == VertexLayout::Standard().GetFormatHash()) {
+        return m_TransientVertexArray;
+    }
+    auto it = m_TransientLayoutArrays.find(hash);
+    if (it != m_TransientLayoutArrays.end()) {
+        return it->second;
+    }
+    GLuint vertexArray = 0;
+    glCreateVertexArrays(1, &vertexArray);
+    glVertexArrayVertexBuffer(vertexArray, 0, m_GeometryRing.GetBuffer(), 0, static_cast<GLsizei>(layout.stride));
+    glVertexArrayElementBuffer(vertexArray, m_GeometryRing.GetBuffer());
+    OpenGLMesh::SetupVertexFormat(vertexArray, layout);
+    m_TransientLayoutArrays.emplace(hash, vertexArray);
+    return vertexArray;
+}
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_OPENGL
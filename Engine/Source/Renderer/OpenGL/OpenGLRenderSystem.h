@@ -0,0 +1,135 @@
+/**
+ * @file OpenGLRenderSystem.h
+ * @brief OpenGL 4.5渲染系统
+ */
+
+#pragma once
+
+#include "OpenGLCommon.h"
+
+#ifdef PLE_RENDERER_OPENGL
+
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "Renderer/RenderSystem.h"
+#include "OpenGLBufferRing.h"
+#include "OpenGLContext.h"
+#include "OpenGLStateCache.h"
+
+namespace PLE {
+
+/**
+ * @brief OpenGL 4.5渲染系统
+ *
+ * 资源全部通过DSA（直接状态访问）创建和修改，不需要为编辑而绑定；
+ * 绘制时的绑定经OpenGLStateCache过滤掉冗余调用。每次绘制的矩阵写入
+ * 持久映射的环形uniform缓冲区，再以glBindBufferRange指定偏移；
+ * 瞬态网格的几何数据写入另一个环形缓冲区，以基础顶点和索引偏移绘制。
+ * 后台线程通过AttachWorkerThread获得共享的无表面上下文，在上面编译着色器。
+ * 无窗口时渲染到离屏默认帧缓冲，可在EGL无表面上下文（Mesa llvmpipe）下运行。
+ */
+class OpenGLRenderSystem : public RenderSystem {
+public:
+    explicit OpenGLRenderSystem(const RenderSystemConfig& config);
+    ~OpenGLRenderSystem() override;
+
+    bool Initialize(std::shared_ptr<Window> window) override;
+    void Shutdown() override;
+
+    void BeginFrame() override;
+    void EndFrame() override;
+
+    void Clear(const Vector4& color, bool depth = true, bool stencil = true) override;
+    void SetViewport(int x, int y, int width, int height) override;
+
+    std::shared_ptr<Shader> CreateShader(const std::string& vertexShaderSource, const std::string& fragmentShaderSource) override;
+    std::vector<uint8_t> GetShaderBinary(const std::shared_ptr<Shader>& shader) override;
+    std::shared_ptr<Shader> CreateShaderFromBinary(const std::vector<uint8_t>& binary) override;
+    bool AttachWorkerThread() override;
+    void DetachWorkerThread() override;
+    std::shared_ptr<Texture> CreateTexture(int width, int height, const void* data) override;
+    std::shared_ptr<Texture> CreateTexture(const TextureData& data) override;
+    bool IsTextureFormatSupported(TextureFormat format) const override;
+    std::shared_ptr<Mesh> CreateMesh(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) override;
+    std::shared_ptr<Mesh> CreateMesh(const void* vertices, uint32_t vertexCount, const VertexLayout& layout,
+                                     const uint32_t* indices, uint32_t indexCount) override;
+    std::shared_ptr<Mesh> CreateTransientMesh(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) override;
+    std::shared_ptr<Mesh> CreateTransientMesh(const void* vertices, uint32_t vertexCount, const VertexLayout& layout,
+                                              const uint32_t* indices, uint32_t indexCount) override;
+    std::shared_ptr<Material> CreateMaterial(std::shared_ptr<Shader> shader) override;
+    std::shared_ptr<Material> CreateMaterialInstance(std::shared_ptr<Material> parent) override;
+    std::shared_ptr<RenderTarget> CreateRenderTarget(int width, int height) override;
+
+    void SetRenderTarget(std::shared_ptr<RenderTarget> renderTarget) override;
+    void DrawMesh(std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material, const Matrix4& transform) override;
+
+    void SetCamera(std::shared_ptr<Camera> camera) override;
+    void SetViewProjection(const Matrix4& view, const Matrix4& projection) override;
+    bool ReadPixels(int x, int y, int width, int height, void* rgba8) override;
+    std::shared_ptr<ReadbackBuffer> CreateReadbackBuffer(int width, int height) override;
+    bool ReadPixelsAsync(int x, int y, const std::shared_ptr<ReadbackBuffer>& buffer) override;
+
+    uint32_t GetFramesInFlight() const override;
+    RenderAPI GetAPI() const override { return RenderAPI::OpenGL; }
+    std::string GetGPUInfo() const override;
+    std::string GetAPIVersion() const override;
+
+private:
+    /**
+     * @brief 每次绘制的uniform块（std140）
+     */
+    struct PerDrawData {
+        float model[16];
+        float viewProjection[16];
+        float modelViewProjection[16];
+    };
+
+    bool CreateDefaultFramebuffer(int width, int height);
+    void DestroyDefaultFramebuffer();
+    void BindDefaultFramebuffer();
+
+    /**
+     * @brief 获取绑定到m_GeometryRing、按指定布局解释顶点的VAO，不存在时创建
+     */
+    GLuint GetTransientVertexArray(const VertexLayout& layout);
+
+    RenderSystemConfig m_Config;
+    OpenGLContext m_Context;
+    OpenGLStateCache m_StateCache;
+    OpenGLBufferRing m_UniformRing;
+    OpenGLBufferRing m_GeometryRing;        // 瞬态网格的顶点和索引
+    GLuint m_TransientVertexArray = 0;      // 绑定到m_GeometryRing的共享VAO（标准顶点布局）
+    std::unordered_map<uint64_t, GLuint> m_TransientLayoutArrays;  // 其他顶点布局的共享VAO，按布局哈希索引
+    uint64_t m_FrameSerial = 0;
+    uint64_t m_StateChangeBase = 0;         // 上一次EndFrame时状态缓存的计数，用于计算每帧的切换次数
+    uint64_t m_ProgramChangeBase = 0;
+    uint64_t m_TextureChangeBase = 0;
+    bool m_Initialized = false;
+    bool m_ProgramBinarySupported = false;
+    bool m_S3TCSupported = false;           // BC1/BC3需要扩展，BC5（RGTC）和BC7（BPTC）是4.5核心功能
+
+    // 后台编译线程的共享上下文；在这些线程上创建的对象需要glFinish后才对渲染线程可见
+    std::thread::id m_RenderThread;
+    std::mutex m_WorkerMutex;
+    std::unordered_map<std::thread::id, EGLContext> m_WorkerContexts;
+
+    // 无窗口时的离屏默认帧缓冲
+    GLuint m_DefaultFramebuffer = 0;
+    GLuint m_DefaultColor = 0;
+    GLuint m_DefaultDepthStencil = 0;
+    int m_DefaultWidth = 0;
+    int m_DefaultHeight = 0;
+    std::shared_ptr<Window> m_Window;
+
+    std::shared_ptr<RenderTarget> m_CurrentTarget;
+    std::shared_ptr<Camera> m_Camera;
+    Matrix4 m_View;
+    Matrix4 m_Projection;
+    Matrix4 m_ViewProjection;
+};
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_OPENGL
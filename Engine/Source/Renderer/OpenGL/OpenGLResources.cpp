@@ -0,0 +1,506 @@
+/**
+ * @file OpenGLResources.cpp
+ * @brief OpenGL渲染资源实现
+ */
+
+#include "OpenGLResources.h"
+
+#ifdef PLE_RENDERER_OPENGL
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
+#include "OpenGLStateCache.h"
+
+namespace PLE {
+
+// ---------------------------------------------------------------------------
+// OpenGLShader
+// ---------------------------------------------------------------------------
+
+OpenGLShader::OpenGLShader(const std::string& vertexSource, const std::string& fragmentSource) {
+    GLuint vertexShader = CompileStage(GL_VERTEX_SHADER, vertexSource);
+    GLuint fragmentShader = CompileStage(GL_FRAGMENT_SHADER, fragmentSource);
+    if (!vertexShader || !fragmentShader) {
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return;
+    }
+
+    GLuint program = glCreateProgram();
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glDetachShader(program, vertexShader);
+    glDetachShader(program, fragmentShader);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        GLint length = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+        std::string log(static_cast<size_t>(std::max(length, 1)), '\0');
+        glGetProgramInfoLog(program, length, nullptr, &log[0]);
+        std::cerr << "着色器链接失败：" << log << std::endl;
+        glDeleteProgram(program);
+        return;
+    }
+
+    m_Program = program;
+    BindBlocks();
+}
+
+OpenGLShader::OpenGLShader(GLenum binaryFormat, const void* binary, GLsizei length) {
+    GLuint program = glCreateProgram();
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glProgramBinary(program, binaryFormat, binary, length);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        // 驱动或硬件变化后二进制失效属于正常情况，由调用方回退到源码编译
+        glDeleteProgram(program);
+        return;
+    }
+    m_Program = program;
+    BindBlocks();
+}
+
+OpenGLShader::~OpenGLShader() {
+    if (m_Program) {
+        glDeleteProgram(m_Program);
+    }
+}
+
+void OpenGLShader::BindBlocks() {
+    // 每次绘制的数据固定在绑定点0，材质参数块在绑定点1
+    GLuint perDrawBlock = glGetUniformBlockIndex(m_Program, "PLE_PerDraw");
+    if (perDrawBlock != GL_INVALID_INDEX) {
+        glUniformBlockBinding(m_Program, perDrawBlock, 0);
+    }
+    GLuint materialBlock = glGetUniformBlockIndex(m_Program, "PLE_Material");
+    if (materialBlock != GL_INVALID_INDEX) {
+        glUniformBlockBinding(m_Program, materialBlock, OPENGL_MATERIAL_BLOCK_BINDING);
+        ReflectMaterialBlock(materialBlock);
+    }
+}
+
+void OpenGLShader::ReflectMaterialBlock(GLuint block) {
+    GLint size = 0;
+    GLint count = 0;
+    glGetActiveUniformBlockiv(m_Program, block, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+    glGetActiveUniformBlockiv(m_Program, block, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &count);
+    if (size <= 0 || count <= 0) {
+        return;
+    }
+
+    std::vector<GLint> indices(static_cast<size_t>(count));
+    glGetActiveUniformBlockiv(m_Program, block, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, indices.data());
+    std::vector<GLuint> uniforms(indices.begin(), indices.end());
+    std::vector<GLint> offsets(uniforms.size());
+    std::vector<GLint> types(uniforms.size());
+    std::vector<GLint> arraySizes(uniforms.size());
+    glGetActiveUniformsiv(m_Program, count, uniforms.data(), GL_UNIFORM_OFFSET, offsets.data());
+    glGetActiveUniformsiv(m_Program, count, uniforms.data(), GL_UNIFORM_TYPE, types.data());
+    glGetActiveUniformsiv(m_Program, count, uniforms.data(), GL_UNIFORM_SIZE, arraySizes.data());
+
+    m_MaterialLayout.size = static_cast<uint32_t>(size);
+    for (size_t i = 0; i < uniforms.size(); ++i) {
+        MaterialBlockMember member;
+        if (types[i] == GL_FLOAT) {
+            member.type = MaterialParameterType::Float;
+        } else if (types[i] == GL_FLOAT_VEC4) {
+            member.type = MaterialParameterType::Vector4;
+        } else if (types[i] == GL_FLOAT_MAT4) {
+            member.type = MaterialParameterType::Matrix4;
+        } else {
+            // 其他类型占用块空间但不能通过材质接口设置
+            continue;
+        }
+        if (arraySizes[i] != 1) {
+            continue;
+        }
+
+        char name[256];
+        GLsizei length = 0;
+        glGetActiveUniformName(m_Program, uniforms[i], sizeof(name), &length, name);
+        member.name.assign(name, static_cast<size_t>(length));
+        // 带实例名的块成员报告为"PLE_Material.name"
+        const size_t dot = member.name.rfind('.');
+        if (dot != std::string::npos) {
+            member.name.erase(0, dot + 1);
+        }
+        member.offset = static_cast<uint32_t>(offsets[i]);
+        m_MaterialLayout.members.push_back(member);
+    }
+}
+
+GLint OpenGLShader::GetUniformLocation(const std::string& name) const {
+    auto it = m_UniformLocations.find(name);
+    if (it != m_UniformLocations.end()) {
+        return it->second;
+    }
+    GLint location = glGetUniformLocation(m_Program, name.c_str());
+    m_UniformLocations.emplace(name, location);
+    return location;
+}
+
+GLuint OpenGLShader::CompileStage(GLenum stage, const std::string& source) {
+    GLuint shader = glCreateShader(stage);
+    const char* text = source.c_str();
+    glShaderSource(shader, 1, &text, nullptr);
+    glCompileShader(shader);
+
+    GLint compiled = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (!compiled) {
+        GLint length = 0;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+        std::string log(static_cast<size_t>(std::max(length, 1)), '\0');
+        glGetShaderInfoLog(shader, length, nullptr, &log[0]);
+        std::cerr << (stage == GL_VERTEX_SHADER ? "顶点" : "片段") << "着色器编译失败：" << log << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+// ---------------------------------------------------------------------------
+// OpenGLTexture
+// ---------------------------------------------------------------------------
+
+OpenGLTexture::OpenGLTexture(int width, int height, const void* data, bool generateMips)
+    : Texture(width, height) {
+    GLsizei levels = 1;
+    if (generateMips) {
+        for (int size = std::max(width, height); size > 1; size >>= 1) {
+            ++levels;
+        }
+    }
+
+    glCreateTextures(GL_TEXTURE_2D, 1, &m_Texture);
+    glTextureStorage2D(m_Texture, levels, GL_RGBA8, width, height);
+    glTextureParameteri(m_Texture, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTextureParameteri(m_Texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTextureParameteri(m_Texture, GL_TEXTURE_WRAP_S, levels > 1 ? GL_REPEAT : GL_CLAMP_TO_EDGE);
+    glTextureParameteri(m_Texture, GL_TEXTURE_WRAP_T, levels > 1 ? GL_REPEAT : GL_CLAMP_TO_EDGE);
+
+    if (data) {
+        glTextureSubImage2D(m_Texture, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        if (levels > 1) {
+            glGenerateTextureMipmap(m_Texture);
+        }
+    }
+}
+
+OpenGLTexture::OpenGLTexture(const TextureData& data)
+    : Texture(static_cast<int>(data.width), static_cast<int>(data.height), data.format) {
+    GLenum internalFormat = GL_RGBA8;
+    switch (data.format) {
+    case TextureFormat::BC1:
+        internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        break;
+    case TextureFormat::BC3:
+        internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        break;
+    case TextureFormat::BC5:
+        internalFormat = GL_COMPRESSED_RG_RGTC2;
+        break;
+    case TextureFormat::BC7:
+        internalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM;
+        break;
+    default:
+        break;
+    }
+
+    const GLsizei levels = static_cast<GLsizei>(data.mips.size());
+    glCreateTextures(GL_TEXTURE_2D, 1, &m_Texture);
+    glTextureStorage2D(m_Texture, levels, internalFormat, static_cast<GLsizei>(data.width), static_cast<GLsizei>(data.height));
+    glTextureParameteri(m_Texture, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTextureParameteri(m_Texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTextureParameteri(m_Texture, GL_TEXTURE_WRAP_S, levels > 1 ? GL_REPEAT : GL_CLAMP_TO_EDGE);
+    glTextureParameteri(m_Texture, GL_TEXTURE_WRAP_T, levels > 1 ? GL_REPEAT : GL_CLAMP_TO_EDGE);
+
+    for (GLsizei level = 0; level < levels; ++level) {
+        const TextureMipLevel& mip = data.mips[static_cast<size_t>(level)];
+        const uint8_t* pixels = data.pixels.data() + mip.offset;
+        if (TextureData::IsCompressed(data.format)) {
+            glCompressedTextureSubImage2D(m_Texture, level, 0, 0, static_cast<GLsizei>(mip.width), static_cast<GLsizei>(mip.height),
+                                          internalFormat, static_cast<GLsizei>(mip.size), pixels);
+        } else {
+            glTextureSubImage2D(m_Texture, level, 0, 0, static_cast<GLsizei>(mip.width), static_cast<GLsizei>(mip.height),
+                                GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        }
+    }
+}
+
+OpenGLTexture::~OpenGLTexture() {
+    glDeleteTextures(1, &m_Texture);
+}
+
+// ---------------------------------------------------------------------------
+// OpenGLMesh
+// ---------------------------------------------------------------------------
+
+OpenGLMesh::OpenGLMesh(const void* vertices, uint32_t vertexCount, const VertexLayout& layout, const uint32_t* indices, uint32_t indexCount)
+    : Mesh(vertexCount, indices ? indexCount : 0, layout) {
+    glCreateVertexArrays(1, &m_VertexArray);
+
+    glCreateBuffers(1, &m_VertexBuffer);
+    glNamedBufferStorage(m_VertexBuffer, static_cast<GLsizeiptr>(layout.stride) * vertexCount, vertices, 0);
+    glVertexArrayVertexBuffer(m_VertexArray, 0, m_VertexBuffer, 0, static_cast<GLsizei>(layout.stride));
+    SetupVertexFormat(m_VertexArray, layout);
+
+    if (m_IndexCount > 0) {
+        glCreateBuffers(1, &m_IndexBuffer);
+        glNamedBufferStorage(m_IndexBuffer, static_cast<GLsizeiptr>(sizeof(uint32_t)) * indexCount, indices, 0);
+        glVertexArrayElementBuffer(m_VertexArray, m_IndexBuffer);
+    }
+}
+
+OpenGLMesh::OpenGLMesh(uint32_t vertexCount, uint32_t indexCount, const VertexLayout& layout, uint32_t baseVertex, uint32_t firstIndex,
+                       uint64_t frameSerial)
+    : Mesh(vertexCount, indexCount, layout)
+    , m_BaseVertex(baseVertex)
+    , m_FirstIndex(firstIndex)
+    , m_FrameSerial(frameSerial) {
+}
+
+OpenGLMesh::~OpenGLMesh() {
+    if (m_VertexArray) {
+        glDeleteVertexArrays(1, &m_VertexArray);
+        glDeleteBuffers(1, &m_VertexBuffer);
+    }
+    if (m_IndexBuffer) {
+        glDeleteBuffers(1, &m_IndexBuffer);
+    }
+}
+
+void OpenGLMesh::SetupVertexFormat(GLuint vertexArray, const VertexLayout& layout) {
+    for (const VertexAttribute& attribute : layout.attributes) {
+        GLint size = 4;
+        GLenum type = GL_FLOAT;
+        GLboolean normalized = GL_FALSE;
+        switch (attribute.format) {
+        case VertexAttributeFormat::Float2: size = 2; break;
+        case VertexAttributeFormat::Float3: size = 3; break;
+        case VertexAttributeFormat::Float4: size = 4; break;
+        case VertexAttributeFormat::Half2: size = 2; type = GL_HALF_FLOAT; break;
+        case VertexAttributeFormat::Half4: size = 4; type = GL_HALF_FLOAT; break;
+        case VertexAttributeFormat::Unorm16x4: size = 4; type = GL_UNSIGNED_SHORT; normalized = GL_TRUE; break;
+        case VertexAttributeFormat::Snorm16x2: size = 2; type = GL_SHORT; normalized = GL_TRUE; break;
+        case VertexAttributeFormat::Snorm16x4: size = 4; type = GL_SHORT; normalized = GL_TRUE; break;
+        case VertexAttributeFormat::Unorm8x4: size = 4; type = GL_UNSIGNED_BYTE; normalized = GL_TRUE; break;
+        case VertexAttributeFormat::Snorm8x4: size = 4; type = GL_BYTE; normalized = GL_TRUE; break;
+        }
+        glEnableVertexArrayAttrib(vertexArray, attribute.location);
+        glVertexArrayAttribFormat(vertexArray, attribute.location, size, type, normalized, attribute.offset);
+        glVertexArrayAttribBinding(vertexArray, attribute.location, 0);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// OpenGLMaterial
+// ---------------------------------------------------------------------------
+
+std::atomic<uint64_t> OpenGLMaterial::s_NextId{1};
+
+OpenGLMaterial::OpenGLMaterial(std::shared_ptr<Shader> shader)
+    : Material(shader)
+    , m_Id(s_NextId.fetch_add(1, std::memory_order_relaxed)) {
+}
+
+OpenGLMaterial::OpenGLMaterial(const std::shared_ptr<Material>& parent)
+    : Material(parent->GetShader(), parent)
+    , m_Id(s_NextId.fetch_add(1, std::memory_order_relaxed)) {
+}
+
+OpenGLMaterial::~OpenGLMaterial() {
+    if (m_UniformBuffer) {
+        glDeleteBuffers(1, &m_UniformBuffer);
+    }
+}
+
+uint32_t OpenGLMaterial::UploadBlock() {
+    if (m_Block.empty()) {
+        return 0;
+    }
+    if (!m_UniformBuffer) {
+        glCreateBuffers(1, &m_UniformBuffer);
+        glNamedBufferStorage(m_UniformBuffer, static_cast<GLsizeiptr>(m_Block.size()), m_Block.data(), GL_DYNAMIC_STORAGE_BIT);
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        TakeDirtyRange(begin, end);
+        return static_cast<uint32_t>(m_Block.size());
+    }
+
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    if (TakeDirtyRange(begin, end)) {
+        glNamedBufferSubData(m_UniformBuffer, begin, end - begin, m_Block.data() + begin);
+        return end - begin;
+    }
+    return 0;
+}
+
+uint32_t OpenGLMaterial::Apply(OpenGLStateCache& stateCache) {
+    auto shader = std::static_pointer_cast<OpenGLShader>(m_Shader);
+    if (!shader || !shader->IsValid()) {
+        return 0;
+    }
+    const GLuint program = shader->GetProgram();
+    stateCache.UseProgram(program);
+
+    // 参数块只上传脏区间；未覆盖块参数的实例直接绑定父材质的缓冲
+    uint32_t uploaded = 0;
+    if (shader->GetMaterialLayout().size > 0) {
+        auto* blockOwner = static_cast<OpenGLMaterial*>(ResolveBlock());
+        uploaded += blockOwner->UploadBlock();
+        stateCache.BindUniformBufferRange(OPENGL_MATERIAL_BLOCK_BINDING, blockOwner->m_UniformBuffer, 0,
+                                          static_cast<GLsizeiptr>(blockOwner->m_Block.size()));
+    }
+
+    if (m_ResolvedVersion != m_Version) {
+        m_Resolved.clear();
+        uint32_t textureUnit = 0;
+        for (uint32_t i = 0; i < m_Parameters.size(); ++i) {
+            GLint location = shader->GetUniformLocation(m_Parameters[i].name);
+            if (location < 0) {
+                continue;
+            }
+            bool isTexture = m_Parameters[i].type == MaterialParameterType::Texture;
+            m_Resolved.push_back({ location, i, isTexture ? textureUnit++ : 0 });
+        }
+        m_ResolvedVersion = m_Version;
+    }
+
+    // uniform属于程序状态，同一材质同一版本已上传过时无需重复上传
+    const bool upload = shader->appliedMaterialId != m_Id || shader->appliedVersion != m_Version;
+    for (const ResolvedParameter& resolved : m_Resolved) {
+        const MaterialParameter& parameter = m_Parameters[resolved.parameterIndex];
+        if (parameter.type == MaterialParameterType::Texture) {
+            auto texture = std::static_pointer_cast<OpenGLTexture>(parameter.texture);
+            stateCache.BindTextureUnit(resolved.textureUnit, texture ? texture->GetHandle() : 0);
+            if (upload) {
+                glProgramUniform1i(program, resolved.location, static_cast<GLint>(resolved.textureUnit));
+            }
+            continue;
+        }
+        if (!upload) {
+            continue;
+        }
+        switch (parameter.type) {
+        case MaterialParameterType::Float:
+            glProgramUniform1f(program, resolved.location, parameter.value[0]);
+            uploaded += sizeof(float);
+            break;
+        case MaterialParameterType::Vector4:
+            glProgramUniform4fv(program, resolved.location, 1, parameter.value.data());
+            uploaded += 4 * sizeof(float);
+            break;
+        case MaterialParameterType::Matrix4:
+            glProgramUniformMatrix4fv(program, resolved.location, 1, GL_FALSE, parameter.value.data());
+            uploaded += 16 * sizeof(float);
+            break;
+        default:
+            break;
+        }
+    }
+    shader->appliedMaterialId = m_Id;
+    shader->appliedVersion = m_Version;
+    return uploaded;
+}
+
+// ---------------------------------------------------------------------------
+// OpenGLRenderTarget
+// ---------------------------------------------------------------------------
+
+OpenGLRenderTarget::OpenGLRenderTarget(int width, int height)
+    : RenderTarget(width, height) {
+    m_ColorTexture = std::make_shared<OpenGLTexture>(width, height, nullptr, false);
+
+    glCreateRenderbuffers(1, &m_DepthStencil);
+    glNamedRenderbufferStorage(m_DepthStencil, GL_DEPTH24_STENCIL8, width, height);
+
+    glCreateFramebuffers(1, &m_Framebuffer);
+    glNamedFramebufferTexture(m_Framebuffer, GL_COLOR_ATTACHMENT0, m_ColorTexture->GetHandle(), 0);
+    glNamedFramebufferRenderbuffer(m_Framebuffer, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_DepthStencil);
+
+    m_Complete = glCheckNamedFramebufferStatus(m_Framebuffer, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    if (!m_Complete) {
+        std::cerr << "渲染目标帧缓冲不完整！" << std::endl;
+    }
+}
+
+OpenGLRenderTarget::~OpenGLRenderTarget() {
+    glDeleteFramebuffers(1, &m_Framebuffer);
+    glDeleteRenderbuffers(1, &m_DepthStencil);
+}
+
+// ---------------------------------------------------------------------------
+// OpenGLReadbackBuffer
+// ---------------------------------------------------------------------------
+
+OpenGLReadbackBuffer::OpenGLReadbackBuffer(int width, int height)
+    : ReadbackBuffer(width, height) {
+    const GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    const GLsizeiptr size = static_cast<GLsizeiptr>(width) * height * 4;
+    glCreateBuffers(1, &m_Buffer);
+    glNamedBufferStorage(m_Buffer, size, nullptr, flags);
+    m_Mapped = static_cast<const uint8_t*>(glMapNamedBufferRange(m_Buffer, 0, size, flags));
+    if (!m_Mapped) {
+        std::cerr << "持久映射读回缓冲区失败！" << std::endl;
+    }
+}
+
+OpenGLReadbackBuffer::~OpenGLReadbackBuffer() {
+    if (m_Fence) {
+        glDeleteSync(m_Fence);
+    }
+    if (m_Mapped) {
+        glUnmapNamedBuffer(m_Buffer);
+    }
+    glDeleteBuffers(1, &m_Buffer);
+}
+
+void OpenGLReadbackBuffer::Issue() {
+    if (m_Fence) {
+        glDeleteSync(m_Fence);
+    }
+    m_Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_Complete = false;
+}
+
+bool OpenGLReadbackBuffer::IsReady() {
+    // 第一次查询时刷新命令，否则没有交换缓冲的离屏循环里栅栏可能一直不被提交
+    return Poll(GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+}
+
+bool OpenGLReadbackBuffer::Wait() {
+    while (m_Fence) {
+        Poll(GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+    }
+    return m_Complete;
+}
+
+bool OpenGLReadbackBuffer::Poll(GLbitfield flags, GLuint64 timeout) {
+    if (!m_Fence) {
+        return m_Complete;
+    }
+    const GLenum result = glClientWaitSync(m_Fence, flags, timeout);
+    if (result == GL_TIMEOUT_EXPIRED) {
+        return false;
+    }
+    glDeleteSync(m_Fence);
+    m_Fence = nullptr;
+    m_Complete = result != GL_WAIT_FAILED;
+    return m_Complete;
+}
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_OPENGL
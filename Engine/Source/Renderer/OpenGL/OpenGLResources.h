@@ -0,0 +1,224 @@
+/**
+ * @file OpenGLResources.h
+ * @brief OpenGL渲染资源
+ */
+
+#pragma once
+
+#include "OpenGLCommon.h"
+
+#ifdef PLE_RENDERER_OPENGL
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Renderer/RenderResources.h"
+
+namespace PLE {
+
+class OpenGLStateCache;
+
+/**
+ * @brief 材质参数块PLE_Material的uniform绑定点
+ */
+constexpr uint32_t OPENGL_MATERIAL_BLOCK_BINDING = 1;
+
+/**
+ * @brief OpenGL着色器程序
+ */
+class OpenGLShader : public Shader {
+public:
+    OpenGLShader(const std::string& vertexSource, const std::string& fragmentSource);
+
+    /**
+     * @brief 从程序二进制创建，驱动拒绝时IsValid为false
+     */
+    OpenGLShader(GLenum binaryFormat, const void* binary, GLsizei length);
+    ~OpenGLShader() override;
+
+    bool IsValid() const override { return m_Program != 0; }
+
+    GLuint GetProgram() const { return m_Program; }
+
+    /**
+     * @brief 获取uniform位置（带缓存），不存在时返回-1
+     */
+    GLint GetUniformLocation(const std::string& name) const;
+
+    // 最近一次上传到本程序的材质ID及其版本，用于跳过重复上传
+    uint64_t appliedMaterialId = 0;
+    uint32_t appliedVersion = 0;
+
+private:
+    static GLuint CompileStage(GLenum stage, const std::string& source);
+    void BindBlocks();
+    void ReflectMaterialBlock(GLuint block);
+
+    GLuint m_Program = 0;
+    mutable std::unordered_map<std::string, GLint> m_UniformLocations;
+};
+
+/**
+ * @brief OpenGL二维纹理（RGBA8或块压缩格式）
+ */
+class OpenGLTexture : public Texture {
+public:
+    /**
+     * @brief 创建纹理并上传数据，data为空时只分配存储
+     */
+    OpenGLTexture(int width, int height, const void* data, bool generateMips = true);
+
+    /**
+     * @brief 创建纹理并逐级上传预处理好的Mip链，格式需已确认受支持
+     */
+    explicit OpenGLTexture(const TextureData& data);
+    ~OpenGLTexture() override;
+
+    GLuint GetHandle() const { return m_Texture; }
+
+private:
+    GLuint m_Texture = 0;
+};
+
+/**
+ * @brief OpenGL网格（不可变顶点/索引缓冲 + VAO）
+ *
+ * 瞬态网格不拥有缓冲，数据位于渲染系统的上传环形缓冲区中，
+ * 通过基础顶点和首个索引定位，绘制时使用渲染系统为该顶点布局共享的VAO。
+ */
+class OpenGLMesh : public Mesh {
+public:
+    OpenGLMesh(const void* vertices, uint32_t vertexCount, const VertexLayout& layout, const uint32_t* indices, uint32_t indexCount);
+
+    /**
+     * @brief 创建瞬态网格
+     * @param layout 顶点布局
+     * @param baseVertex 第一个顶点在环形缓冲区中的序号（以layout.stride为单位）
+     * @param firstIndex 第一个索引在环形缓冲区中的序号
+     * @param frameSerial 创建时的帧序号
+     */
+    OpenGLMesh(uint32_t vertexCount, uint32_t indexCount, const VertexLayout& layout, uint32_t baseVertex, uint32_t firstIndex,
+               uint64_t frameSerial);
+    ~OpenGLMesh() override;
+
+    GLuint GetVertexArray() const { return m_VertexArray; }
+
+    bool IsTransient() const { return m_VertexArray == 0; }
+    uint32_t GetBaseVertex() const { return m_BaseVertex; }
+    uint32_t GetFirstIndex() const { return m_FirstIndex; }
+    uint64_t GetFrameSerial() const { return m_FrameSerial; }
+
+    /**
+     * @brief 按顶点布局设置VAO的顶点属性（绑定点0）
+     */
+    static void SetupVertexFormat(GLuint vertexArray, const VertexLayout& layout = VertexLayout::Standard());
+
+private:
+    GLuint m_VertexArray = 0;
+    GLuint m_VertexBuffer = 0;
+    GLuint m_IndexBuffer = 0;
+    uint32_t m_BaseVertex = 0;
+    uint32_t m_FirstIndex = 0;
+    uint64_t m_FrameSerial = 0;
+};
+
+/**
+ * @brief OpenGL材质
+ *
+ * 参数块保存在材质自己的uniform缓冲中，应用时只上传脏区间并绑定到
+ * OPENGL_MATERIAL_BLOCK_BINDING，共享参数块的实例绑定同一个缓冲。
+ * 块外参数的位置在材质版本变化时解析一次；只有当程序上最近一次应用的
+ * 不是同一材质的同一版本时才重新上传uniform。
+ */
+class OpenGLMaterial : public Material {
+public:
+    explicit OpenGLMaterial(std::shared_ptr<Shader> shader);
+
+    /**
+     * @brief 创建材质实例
+     * @param parent 父材质（OpenGLMaterial）
+     */
+    explicit OpenGLMaterial(const std::shared_ptr<Material>& parent);
+    ~OpenGLMaterial() override;
+
+    /**
+     * @brief 应用材质：上传变化的参数并绑定纹理
+     * @param stateCache 状态缓存
+     * @return 本次上传的参数字节数
+     */
+    uint32_t Apply(OpenGLStateCache& stateCache);
+
+private:
+    struct ResolvedParameter {
+        GLint location;
+        uint32_t parameterIndex;
+        uint32_t textureUnit;
+    };
+
+    uint32_t UploadBlock();
+
+    std::vector<ResolvedParameter> m_Resolved;
+    uint32_t m_ResolvedVersion = 0xFFFFFFFF;
+    uint64_t m_Id;
+    GLuint m_UniformBuffer = 0;
+
+    static std::atomic<uint64_t> s_NextId;
+};
+
+/**
+ * @brief OpenGL渲染目标（RGBA8颜色纹理 + 深度模板渲染缓冲）
+ */
+class OpenGLRenderTarget : public RenderTarget {
+public:
+    OpenGLRenderTarget(int width, int height);
+    ~OpenGLRenderTarget() override;
+
+    std::shared_ptr<Texture> GetColorTexture() const override { return m_ColorTexture; }
+
+    GLuint GetFramebuffer() const { return m_Framebuffer; }
+
+    bool IsComplete() const { return m_Complete; }
+
+private:
+    GLuint m_Framebuffer = 0;
+    GLuint m_DepthStencil = 0;
+    std::shared_ptr<OpenGLTexture> m_ColorTexture;
+    bool m_Complete = false;
+};
+
+/**
+ * @brief OpenGL读回缓冲区：持久映射的像素打包缓冲区，每次读取之后放置一个栅栏
+ */
+class OpenGLReadbackBuffer : public ReadbackBuffer {
+public:
+    OpenGLReadbackBuffer(int width, int height);
+    ~OpenGLReadbackBuffer() override;
+
+    bool IsReady() override;
+    bool Wait() override;
+    const uint8_t* GetRow(int row) const override { return m_Mapped + static_cast<size_t>(row) * static_cast<size_t>(m_Width) * 4; }
+
+    bool IsValid() const { return m_Mapped != nullptr; }
+
+    GLuint GetHandle() const { return m_Buffer; }
+
+    /**
+     * @brief 读取命令发出之后调用，用新的栅栏标记完成时刻
+     */
+    void Issue();
+
+private:
+    bool Poll(GLbitfield flags, GLuint64 timeout);
+
+    GLuint m_Buffer = 0;
+    const uint8_t* m_Mapped = nullptr;
+    GLsync m_Fence = nullptr;
+    bool m_Complete = false;
+};
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_OPENGL
@@ -0,0 +1,28 @@
+/**
+ * @file OpenGLStateCache.cpp
+ * @brief OpenGL状态缓存实现
+ */
+
+#include "OpenGLStateCache.h"
+
+#ifdef PLE_RENDERER_OPENGL
+
+namespace PLE {
+
+void OpenGLStateCache::Invalidate() {
+    m_Program = 0xFFFFFFFF;
+    m_VertexArray = 0xFFFFFFFF;
+    m_Framebuffer = 0xFFFFFFFF;
+    m_Viewport = { -1, -1, -1, -1 };
+    // 纹理单元用一个不可能存在的名字标记为未知
+    m_Textures.fill(0xFFFFFFFF);
+    m_UniformBuffers.fill(UniformBinding{ 0xFFFFFFFF, 0, 0 });
+    m_DepthTest = -1;
+    m_DepthWrite = -1;
+    m_CullFace = -1;
+    m_Blend = -1;
+}
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_OPENGL
@@ -0,0 +1,151 @@
+/**
+ * @file OpenGLStateCache.h
+ * @brief OpenGL状态缓存
+ */
+
+#pragma once
+
+#include "OpenGLCommon.h"
+
+#ifdef PLE_RENDERER_OPENGL
+
+#include <array>
+#include <cstdint>
+
+namespace PLE {
+
+/**
+ * @brief OpenGL状态缓存
+ *
+ * 记录已提交给驱动的绑定和开关状态，只有真正变化时才调用GL，
+ * 从而把每次绘制的状态切换降到最少。所有资源都通过DSA创建和修改，
+ * 绑定只发生在绘制需要时，因此缓存不会因为资源编辑而失效。
+ */
+class OpenGLStateCache {
+public:
+    static constexpr uint32_t MAX_TEXTURE_UNITS = 32;
+    static constexpr uint32_t MAX_UNIFORM_BUFFERS = 16;
+
+    /**
+     * @brief 丢弃所有缓存状态（外部代码直接修改了GL状态后调用）
+     */
+    void Invalidate();
+
+    void UseProgram(GLuint program) {
+        if (m_Program != program) {
+            glUseProgram(program);
+            m_Program = program;
+            ++m_StateChanges;
+            ++m_ProgramChanges;
+        }
+    }
+
+    void BindVertexArray(GLuint vertexArray) {
+        if (m_VertexArray != vertexArray) {
+            glBindVertexArray(vertexArray);
+            m_VertexArray = vertexArray;
+            ++m_StateChanges;
+        }
+    }
+
+    void BindFramebuffer(GLuint framebuffer) {
+        if (m_Framebuffer != framebuffer) {
+            glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+            m_Framebuffer = framebuffer;
+            ++m_StateChanges;
+        }
+    }
+
+    GLuint GetFramebuffer() const { return m_Framebuffer; }
+
+    void SetViewport(int x, int y, int width, int height) {
+        if (m_Viewport[0] != x || m_Viewport[1] != y || m_Viewport[2] != width || m_Viewport[3] != height) {
+            glViewport(x, y, width, height);
+            m_Viewport = { x, y, width, height };
+            ++m_StateChanges;
+        }
+    }
+
+    void BindTextureUnit(uint32_t unit, GLuint texture) {
+        if (unit < MAX_TEXTURE_UNITS && m_Textures[unit] != texture) {
+            glBindTextureUnit(unit, texture);
+            m_Textures[unit] = texture;
+            ++m_StateChanges;
+            ++m_TextureChanges;
+        }
+    }
+
+    void BindUniformBufferRange(uint32_t index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+        UniformBinding& binding = m_UniformBuffers[index];
+        if (binding.buffer != buffer || binding.offset != offset || binding.size != size) {
+            glBindBufferRange(GL_UNIFORM_BUFFER, index, buffer, offset, size);
+            binding = { buffer, offset, size };
+            ++m_StateChanges;
+        }
+    }
+
+    void SetDepthTest(bool enabled) { SetCapability(GL_DEPTH_TEST, enabled, m_DepthTest); }
+    void SetCullFace(bool enabled) { SetCapability(GL_CULL_FACE, enabled, m_CullFace); }
+    void SetBlend(bool enabled) { SetCapability(GL_BLEND, enabled, m_Blend); }
+
+    void SetDepthWrite(bool enabled) {
+        if (m_DepthWrite != static_cast<int8_t>(enabled)) {
+            glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+            m_DepthWrite = static_cast<int8_t>(enabled);
+            ++m_StateChanges;
+        }
+    }
+
+    /**
+     * @brief 获取实际提交给驱动的状态切换次数
+     */
+    uint64_t GetStateChangeCount() const { return m_StateChanges; }
+
+    /**
+     * @brief 获取实际提交的程序切换次数
+     */
+    uint64_t GetProgramChangeCount() const { return m_ProgramChanges; }
+
+    /**
+     * @brief 获取实际提交的纹理绑定次数
+     */
+    uint64_t GetTextureChangeCount() const { return m_TextureChanges; }
+
+private:
+    struct UniformBinding {
+        GLuint buffer = 0;
+        GLintptr offset = 0;
+        GLsizeiptr size = 0;
+    };
+
+    void SetCapability(GLenum capability, bool enabled, int8_t& cached) {
+        if (cached != static_cast<int8_t>(enabled)) {
+            if (enabled) {
+                glEnable(capability);
+            } else {
+                glDisable(capability);
+            }
+            cached = static_cast<int8_t>(enabled);
+            ++m_StateChanges;
+        }
+    }
+
+    // 0xFFFFFFFF / -1 表示未知状态，保证第一次设置一定提交
+    GLuint m_Program = 0xFFFFFFFF;
+    GLuint m_VertexArray = 0xFFFFFFFF;
+    GLuint m_Framebuffer = 0xFFFFFFFF;
+    std::array<int, 4> m_Viewport = { -1, -1, -1, -1 };
+    std::array<GLuint, MAX_TEXTURE_UNITS> m_Textures{};
+    std::array<UniformBinding, MAX_UNIFORM_BUFFERS> m_UniformBuffers{};
+    int8_t m_DepthTest = -1;
+    int8_t m_DepthWrite = -1;
+    int8_t m_CullFace = -1;
+    int8_t m_Blend = -1;
+    uint64_t m_StateChanges = 0;
+    uint64_t m_ProgramChanges = 0;
+    uint64_t m_TextureChanges = 0;
+};
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_OPENGL
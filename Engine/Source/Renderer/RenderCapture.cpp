@@ -0,0 +1,554 @@
+/**
+ * @file RenderCapture.cpp
+ * @brief 渲染命令捕获实现
+ */
+
+#include "Renderer/RenderCapture.h"
+#include "Renderer/RenderResources.h"
+#include "RenderCaptureFormat.h"
+#include "Scene/Camera.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace PLE {
+
+namespace {
+
+void WriteMatrix(CaptureWriter& writer, const Matrix4& matrix) {
+    writer.WriteBytes(matrix.m.data(), sizeof(float) * 16);
+}
+
+void WriteLayout(CaptureWriter& writer, const VertexLayout& layout) {
+    writer.Write(static_cast<uint32_t>(layout.attributes.size()));
+    for (const VertexAttribute& attribute : layout.attributes) {
+        writer.Write(attribute.location);
+        writer.Write(static_cast<uint32_t>(attribute.format));
+        writer.Write(attribute.offset);
+    }
+    writer.Write(layout.stride);
+    writer.Write(static_cast<uint32_t>(layout.topology));
+    const float positionOffset[3] = {layout.positionOffset.x, layout.positionOffset.y, layout.positionOffset.z};
+    writer.WriteBytes(positionOffset, sizeof(positionOffset));
+    writer.Write(layout.positionScale);
+}
+
+} // namespace
+
+RenderCaptureSystem::RenderCaptureSystem(const RenderSystemConfig& config)
+    : m_Config(config)
+    , m_Inner(RenderSystem::Create(config)) {
+}
+
+RenderCaptureSystem::~RenderCaptureSystem() {
+    FinishCapture();
+}
+
+bool RenderCaptureSystem::BeginCapture(const std::string& path, uint32_t frameCount) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_Capturing) {
+        std::cerr << "已经在捕获渲染命令！" << std::endl;
+        return false;
+    }
+    if (frameCount == 0) {
+        return false;
+    }
+
+    m_File.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_File) {
+        std::cerr << "无法创建渲染捕获文件：" << path << std::endl;
+        return false;
+    }
+    const RenderCaptureHeader header = { RENDER_CAPTURE_MAGIC, RENDER_CAPTURE_VERSION, 0, m_Config.width, m_Config.height };
+    m_File.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // 新的捕获文件需要重新写入所有被引用的资源
+    for (auto& entry : m_Resources) {
+        entry.second.written = false;
+        entry.second.paramsWritten = false;
+        entry.second.blockWritten = false;
+    }
+    m_Capturing = true;
+    m_FramesRemaining = frameCount;
+    m_FramesWritten = 0;
+    return true;
+}
+
+void RenderCaptureSystem::EndCapture() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    FinishCapture();
+}
+
+bool RenderCaptureSystem::Initialize(std::shared_ptr<Window> window) {
+    return m_Inner && m_Inner->Initialize(window);
+}
+
+void RenderCaptureSystem::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        FinishCapture();
+        m_Resources.clear();
+    }
+    if (m_Inner) {
+        m_Inner->Shutdown();
+    }
+}
+
+void RenderCaptureSystem::BeginFrame() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for (auto it = m_Resources.begin(); it != m_Resources.end();) {
+            it = it->second.object.expired() ? m_Resources.erase(it) : std::next(it);
+        }
+
+        m_Recording = m_Capturing;
+        Record(RenderCaptureOp::BeginFrame);
+        // 视图投影在帧之间保持，可能在捕获开始之前设置
+        if (m_Recording && m_HasViewProjection) {
+            CaptureWriter payload;
+            WriteMatrix(payload, m_View);
+            WriteMatrix(payload, m_Projection);
+            Record(RenderCaptureOp::SetViewProjection, payload);
+        }
+    }
+    m_Inner->BeginFrame();
+}
+
+void RenderCaptureSystem::EndFrame() {
+    m_Inner->EndFrame();
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (!m_Recording) {
+        return;
+    }
+    Record(RenderCaptureOp::EndFrame);
+    m_File.write(reinterpret_cast<const char*>(m_Stream.data()), static_cast<std::streamsize>(m_Stream.size()));
+    m_Stream.clear();
+    ++m_FramesWritten;
+    m_Recording = false;
+    if (--m_FramesRemaining == 0) {
+        FinishCapture();
+    }
+}
+
+void RenderCaptureSystem::Clear(const Vector4& color, bool depth, bool stencil) {
+    if (m_Recording) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        CaptureWriter payload;
+        const float rgba[4] = {color.x, color.y, color.z, color.w};
+        payload.WriteBytes(rgba, sizeof(rgba));
+        payload.Write(static_cast<uint8_t>(depth));
+        payload.Write(static_cast<uint8_t>(stencil));
+        Record(RenderCaptureOp::Clear, payload);
+    }
+    m_Inner->Clear(color, depth, stencil);
+}
+
+void RenderCaptureSystem::SetViewport(int x, int y, int width, int height) {
+    if (m_Recording) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        CaptureWriter payload;
+        payload.Write(static_cast<int32_t>(x));
+        payload.Write(static_cast<int32_t>(y));
+        payload.Write(static_cast<int32_t>(width));
+        payload.Write(static_cast<int32_t>(height));
+        Record(RenderCaptureOp::SetViewport, payload);
+    }
+    m_Inner->SetViewport(x, y, width, height);
+}
+
+std::shared_ptr<Shader> RenderCaptureSystem::CreateShader(const std::string& vertexShaderSource, const std::string& fragmentShaderSource) {
+    std::shared_ptr<Shader> shader = m_Inner->CreateShader(vertexShaderSource, fragmentShaderSource);
+    if (shader) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        CaptureWriter payload;
+        payload.WriteString(vertexShaderSource);
+        payload.WriteString(fragmentShaderSource);
+        Track(shader, RenderCaptureOp::CreateShader, payload);
+    }
+    return shader;
+}
+
+std::vector<uint8_t> RenderCaptureSystem::GetShaderBinary(const std::shared_ptr<Shader>& shader) {
+    return m_Inner->GetShaderBinary(shader);
+}
+
+std::shared_ptr<Shader> RenderCaptureSystem::CreateShaderFromBinary(const std::vector<uint8_t>& binary) {
+    std::shared_ptr<Shader> shader = m_Inner->CreateShaderFromBinary(binary);
+    if (shader) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        CaptureWriter payload;
+        payload.WriteBlob(binary.data(), binary.size());
+        Track(shader, RenderCaptureOp::CreateShaderFromBinary, payload);
+    }
+    return shader;
+}
+
+bool RenderCaptureSystem::AttachWorkerThread() {
+    return m_Inner->AttachWorkerThread();
+}
+
+void RenderCaptureSystem::DetachWorkerThread() {
+    m_Inner->DetachWorkerThread();
+}
+
+std::shared_ptr<Texture> RenderCaptureSystem::CreateTexture(int width, int height, const void* data) {
+    std::shared_ptr<Texture> texture = m_Inner->CreateTexture(width, height, data);
+    if (texture) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        CaptureWriter payload;
+        payload.Write(static_cast<int32_t>(width));
+        payload.Write(static_cast<int32_t>(height));
+        payload.WriteBlob(data, data ? static_cast<size_t>(width) * height * 4 : 0);
+        Track(texture, RenderCaptureOp::CreateTexture, payload);
+    }
+    return texture;
+}
+
+std::shared_ptr<Texture> RenderCaptureSystem::CreateTexture(const TextureData& data) {
+    std::shared_ptr<Texture> texture = m_Inner->CreateTexture(data);
+    if (texture) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        CaptureWriter payload;
+        payload.Write(static_cast<uint32_t>(data.format));
+        payload.Write(data.width);
+        payload.Write(data.height);
+        payload.Write(static_cast<uint32_t>(data.mips.size()));
+        for (const TextureMipLevel& mip : data.mips) {
+            payload.Write(mip.width);
+            payload.Write(mip.height);
+            payload.Write(static_cast<uint64_t>(mip.offset));
+            payload.Write(static_cast<uint64_t>(mip.size));
+        }
+        payload.WriteBlob(data.pixels.data(), data.pixels.size());
+        Track(texture, RenderCaptureOp::CreateTextureData, payload);
+    }
+    return texture;
+}
+
+bool RenderCaptureSystem::IsTextureFormatSupported(TextureFormat format) const {
+    return m_Inner->IsTextureFormatSupported(format);
+}
+
+std::shared_ptr<Mesh> RenderCaptureSystem::CreateMesh(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) {
+    return CreateMesh(vertices, vertexCount, VertexLayout::Standard(), indices, indexCount);
+}
+
+std::shared_ptr<Mesh> RenderCaptureSystem::CreateMesh(const void* vertices, uint32_t vertexCount, const VertexLayout& layout,
+                                                      const uint32_t* indices, uint32_t indexCount) {
+    std::shared_ptr<Mesh> mesh = m_Inner->CreateMesh(vertices, vertexCount, layout, indices, indexCount);
+    if (mesh) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        CaptureWriter payload;
+        WriteLayout(payload, layout);
+        payload.Write(vertexCount);
+        payload.WriteBlob(vertices, static_cast<size_t>(vertexCount) * layout.stride);
+        payload.Write(indices ? indexCount : 0u);
+        payload.WriteBlob(indices, indices ? indexCount * sizeof(uint32_t) : 0);
+        Track(mesh, RenderCaptureOp::CreateMesh, payload);
+    }
+    return mesh;
+}
+
+std::shared_ptr<Mesh> RenderCaptureSystem::CreateTransientMesh(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) {
+    return CreateTransientMesh(vertices, vertexCount, VertexLayout::Standard(), indices, indexCount);
+}
+
+std::shared_ptr<Mesh> RenderCaptureSystem::CreateTransientMesh(const void* vertices, uint32_t vertexCount, const VertexLayout& layout,
+                                                               const uint32_t* indices, uint32_t indexCount) {
+    std::shared_ptr<Mesh> mesh = m_Inner->CreateTransientMesh(vertices, vertexCount, layout, indices, indexCount);
+    // 瞬态网格只在本帧有效，不在捕获范围内的帧不需要保留数据
+    if (mesh && m_Recording) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        CaptureWriter payload;
+        WriteLayout(payload, layout);
+        payload.Write(vertexCount);
+        payload.WriteBlob(vertices, static_cast<size_t>(vertexCount) * layout.stride);
+        payload.Write(indices ? indexCount : 0u);
+        payload.WriteBlob(indices, indices ? indexCount * sizeof(uint32_t) : 0);
+        Track(mesh, RenderCaptureOp::CreateTransientMesh, payload);
+    }
+    return mesh;
+}
+
+std::shared_ptr<Material> RenderCaptureSystem::CreateMaterial(std::shared_ptr<Shader> shader) {
+    std::shared_ptr<Material> material = m_Inner->CreateMaterial(shader);
+    if (material) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = m_Resources.find(shader.get());
+        CaptureWriter payload;
+        payload.Write(it != m_Resources.end() ? it->second.id : 0u);
+        Track(material, RenderCaptureOp::CreateMaterial, payload, { shader.get() });
+    }
+    return material;
+}
+
+std::shared_ptr<Material> RenderCaptureSystem::CreateMaterialInstance(std::shared_ptr<Material> parent) {
+    std::shared_ptr<Material> material = m_Inner->CreateMaterialInstance(parent);
+    if (material) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = m_Resources.find(parent.get());
+        CaptureWriter payload;
+        payload.Write(it != m_Resources.end() ? it->second.id : 0u);
+        Track(material, RenderCaptureOp::CreateMaterialInstance, payload, { parent.get() });
+    }
+    return material;
+}
+
+std::shared_ptr<RenderTarget> RenderCaptureSystem::CreateRenderTarget(int width, int height) {
+    std::shared_ptr<RenderTarget> target = m_Inner->CreateRenderTarget(width, height);
+    if (target) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        CaptureWriter payload;
+        payload.Write(static_cast<int32_t>(width));
+        payload.Write(static_cast<int32_t>(height));
+        Track(target, RenderCaptureOp::CreateRenderTarget, payload);
+
+        // 颜色附件可以作为纹理被材质引用，回放时从对应的渲染目标取得
+        if (std::shared_ptr<Texture> color = target->GetColorTexture()) {
+            CaptureWriter colorPayload;
+            colorPayload.Write(m_Resources[target.get()].id);
+            Track(color, RenderCaptureOp::RenderTargetTexture, colorPayload, { target.get() });
+        }
+    }
+    return target;
+}
+
+void RenderCaptureSystem::SetRenderTarget(std::shared_ptr<RenderTarget> renderTarget) {
+    if (m_Recording) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        CaptureWriter payload;
+        payload.Write(Reference(renderTarget.get()));
+        Record(RenderCaptureOp::SetRenderTarget, payload);
+    }
+    m_Inner->SetRenderTarget(renderTarget);
+}
+
+void RenderCaptureSystem::DrawMesh(std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material, const Matrix4& transform) {
+    if (m_Recording && mesh && material) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        CaptureWriter payload;
+        payload.Write(Reference(mesh.get()));
+        payload.Write(Reference(material.get()));
+        WriteMatrix(payload, transform);
+        RecordMaterialState(material.get());
+        Record(RenderCaptureOp::DrawMesh, payload);
+    }
+    m_Inner->DrawMesh(mesh, material, transform);
+}
+
+void RenderCaptureSystem::SetCamera(std::shared_ptr<Camera> camera) {
+    if (camera) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_View = camera->GetViewMatrix();
+        m_Projection = camera->GetProjectionMatrix();
+        m_HasViewProjection = true;
+        CaptureWriter payload;
+        WriteMatrix(payload, m_View);
+        WriteMatrix(payload, m_Projection);
+        Record(RenderCaptureOp::SetViewProjection, payload);
+    }
+    m_Inner->SetCamera(camera);
+}
+
+void RenderCaptureSystem::SetViewProjection(const Matrix4& view, const Matrix4& projection) {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_View = view;
+        m_Projection = projection;
+        m_HasViewProjection = true;
+        CaptureWriter payload;
+        WriteMatrix(payload, view);
+        WriteMatrix(payload, projection);
+        Record(RenderCaptureOp::SetViewProjection, payload);
+    }
+    m_Inner->SetViewProjection(view, projection);
+}
+
+bool RenderCaptureSystem::ReadPixels(int x, int y, int width, int height, void* rgba8) {
+    if (m_Recording) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        CaptureWriter payload;
+        payload.Write(static_cast<int32_t>(x));
+        payload.Write(static_cast<int32_t>(y));
+        payload.Write(static_cast<int32_t>(width));
+        payload.Write(static_cast<int32_t>(height));
+        Record(RenderCaptureOp::ReadPixels, payload);
+    }
+    return m_Inner->ReadPixels(x, y, width, height, rgba8);
+}
+
+std::shared_ptr<ReadbackBuffer> RenderCaptureSystem::CreateReadbackBuffer(int width, int height) {
+    return m_Inner->CreateReadbackBuffer(width, height);
+}
+
+bool RenderCaptureSystem::ReadPixelsAsync(int x, int y, const std::shared_ptr<ReadbackBuffer>& buffer) {
+    // 异步读回不影响渲染结果，也不是同步点，不录制
+    return m_Inner->ReadPixelsAsync(x, y, buffer);
+}
+
+uint32_t RenderCaptureSystem::GetFramesInFlight() const {
+    return m_Inner->GetFramesInFlight();
+}
+
+RenderAPI RenderCaptureSystem::GetAPI() const {
+    return m_Inner ? m_Inner->GetAPI() : RenderAPI::None;
+}
+
+std::string RenderCaptureSystem::GetGPUInfo() const {
+    return m_Inner->GetGPUInfo();
+}
+
+std::string RenderCaptureSystem::GetAPIVersion() const {
+    return m_Inner->GetAPIVersion();
+}
+
+const RenderStats& RenderCaptureSystem::GetFrameStats() const {
+    return m_Inner->GetFrameStats();
+}
+
+void RenderCaptureSystem::ReportCulling(uint32_t submitted, uint32_t culled) {
+    if (m_Recording) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        CaptureWriter payload;
+        payload.Write(submitted);
+        payload.Write(culled);
+        Record(RenderCaptureOp::ReportCulling, payload);
+    }
+    m_Inner->ReportCulling(submitted, culled);
+}
+
+void RenderCaptureSystem::BeginStatsPass(const std::string& name) {
+    if (m_Recording) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        CaptureWriter payload;
+        payload.WriteString(name);
+        Record(RenderCaptureOp::BeginStatsPass, payload);
+    }
+    m_Inner->BeginStatsPass(name);
+}
+
+void RenderCaptureSystem::EndStatsPass() {
+    if (m_Recording) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        Record(RenderCaptureOp::EndStatsPass);
+    }
+    m_Inner->EndStatsPass();
+}
+
+void RenderCaptureSystem::Track(const std::shared_ptr<void>& object, RenderCaptureOp op, CaptureWriter& payload,
+                                std::vector<const void*> dependencies) {
+    Resource resource;
+    resource.id = m_NextId++;
+    resource.object = object;
+    resource.dependencies = std::move(dependencies);
+
+    const std::vector<uint8_t>& data = payload.GetData();
+    CaptureWriter creation;
+    creation.Write(op);
+    creation.Write(static_cast<uint32_t>(sizeof(uint32_t) + data.size()));
+    creation.Write(resource.id);
+    creation.WriteBytes(data.data(), data.size());
+    resource.creation = std::move(creation.GetData());
+
+    // 地址可能被已销毁对象用过，新记录直接覆盖
+    m_Resources[object.get()] = std::move(resource);
+}
+
+uint32_t RenderCaptureSystem::Reference(const void* object) {
+    if (!object) {
+        return 0;
+    }
+    auto it = m_Resources.find(object);
+    if (it == m_Resources.end()) {
+        return 0;
+    }
+
+    Resource& resource = it->second;
+    if (m_Recording && !resource.written) {
+        resource.written = true;
+        for (const void* dependency : resource.dependencies) {
+            Reference(dependency);
+        }
+        m_Stream.insert(m_Stream.end(), resource.creation.begin(), resource.creation.end());
+    }
+    return resource.id;
+}
+
+void RenderCaptureSystem::RecordMaterialState(Material* material) {
+    auto it = m_Resources.find(material);
+    if (it == m_Resources.end()) {
+        return;
+    }
+
+    Resource& resource = it->second;
+    if (!resource.paramsWritten || resource.paramsVersion != material->GetVersion()) {
+        const std::vector<MaterialParameter>& parameters = material->GetParameters();
+        CaptureWriter payload;
+        payload.Write(resource.id);
+        payload.Write(static_cast<uint32_t>(parameters.size()));
+        for (const MaterialParameter& parameter : parameters) {
+            payload.WriteString(parameter.name);
+            payload.Write(static_cast<uint32_t>(parameter.type));
+            payload.Write(parameter.value);
+            payload.Write(Reference(parameter.texture.get()));
+        }
+        Record(RenderCaptureOp::MaterialParameters, payload);
+        resource.paramsWritten = true;
+        resource.paramsVersion = material->GetVersion();
+    }
+
+    // 未覆盖块参数的实例使用父材质的参数块，记录到块的所有者上
+    Material* owner = material->ResolveBlock();
+    auto ownerIt = owner ? m_Resources.find(owner) : m_Resources.end();
+    if (ownerIt == m_Resources.end() || owner->GetBlockData().empty()) {
+        return;
+    }
+    Resource& ownerResource = ownerIt->second;
+    if (!ownerResource.blockWritten || ownerResource.blockVersion != owner->GetBlockVersion()) {
+        CaptureWriter payload;
+        payload.Write(Reference(owner));
+        payload.WriteBlob(owner->GetBlockData().data(), owner->GetBlockData().size());
+        Record(RenderCaptureOp::MaterialBlock, payload);
+        ownerResource.blockWritten = true;
+        ownerResource.blockVersion = owner->GetBlockVersion();
+    }
+}
+
+void RenderCaptureSystem::Record(RenderCaptureOp op, CaptureWriter& payload) {
+    if (!m_Recording) {
+        return;
+    }
+    const std::vector<uint8_t>& data = payload.GetData();
+    CaptureWriter command;
+    command.Write(op);
+    command.Write(static_cast<uint32_t>(data.size()));
+    m_Stream.insert(m_Stream.end(), command.GetData().begin(), command.GetData().end());
+    m_Stream.insert(m_Stream.end(), data.begin(), data.end());
+}
+
+void RenderCaptureSystem::Record(RenderCaptureOp op) {
+    CaptureWriter payload;
+    Record(op, payload);
+}
+
+void RenderCaptureSystem::FinishCapture() {
+    if (!m_Capturing) {
+        return;
+    }
+
+    // 未结束的帧不写入，文件只包含完整的帧
+    m_Stream.clear();
+    const RenderCaptureHeader header = { RENDER_CAPTURE_MAGIC, RENDER_CAPTURE_VERSION, m_FramesWritten, m_Config.width, m_Config.height };
+    m_File.seekp(0);
+    m_File.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!m_File) {
+        std::cerr << "写入渲染捕获文件失败！" << std::endl;
+    }
+    m_File.close();
+    m_Capturing = false;
+    m_Recording = false;
+    m_FramesRemaining = 0;
+}
+
+} // namespace PLE
@@ -0,0 +1,167 @@
+/**
+ * @file RenderCaptureFormat.h
+ * @brief 渲染捕获文件格式：命令编号和字节流读写
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace PLE {
+
+/**
+ * @brief 捕获文件头
+ *
+ * 文件头之后是命令流，每条命令为：uint8 操作码、uint32 负载字节数、负载。
+ * 所有数值按本机字节序存储，捕获和回放需要在相同字节序的机器上进行。
+ */
+struct RenderCaptureHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t frameCount;
+    int32_t width;          // 捕获时默认帧缓冲的宽度
+    int32_t height;
+};
+
+constexpr uint32_t RENDER_CAPTURE_MAGIC = 0x43524C50;   // "PLRC"
+constexpr uint32_t RENDER_CAPTURE_VERSION = 3;
+
+/**
+ * @brief 捕获命令
+ *
+ * 资源以捕获内的编号引用，0表示空。资源创建命令在资源第一次被引用时写入，
+ * 材质参数在变化后第一次被绘制时写入。
+ */
+enum class RenderCaptureOp : uint8_t {
+    CreateShader = 1,           // id, 顶点着色器源码, 片段着色器源码
+    CreateShaderFromBinary,     // id, 二进制
+    CreateTexture,              // id, width, height, 是否有数据, RGBA8数据
+    CreateTextureData,          // id, TextureData
+    CreateMesh,                 // id, VertexLayout, 顶点数据, 索引数据
+    CreateTransientMesh,        // id, VertexLayout, 顶点数据, 索引数据
+    CreateMaterial,             // id, 着色器id
+    CreateMaterialInstance,     // id, 父材质id
+    CreateRenderTarget,         // id, width, height
+    RenderTargetTexture,        // id, 渲染目标id
+    MaterialParameters,         // id, 参数块之外的参数
+    MaterialBlock,              // id, 参数块数据
+
+    BeginFrame = 32,
+    EndFrame,
+    Clear,                      // color, depth, stencil
+    SetViewport,                // x, y, width, height
+    SetRenderTarget,            // 渲染目标id
+    DrawMesh,                   // 网格id, 材质id, transform
+    SetViewProjection,          // view, projection
+    ReadPixels,                 // x, y, width, height
+    BeginStatsPass,             // 名称
+    EndStatsPass,
+    ReportCulling               // submitted, culled
+};
+
+/**
+ * @brief 命令负载写入
+ */
+class CaptureWriter {
+public:
+    template <typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "只能直接写入平凡类型");
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void WriteBytes(const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        m_Data.insert(m_Data.end(), bytes, bytes + size);
+    }
+
+    void WriteString(const std::string& value) {
+        Write(static_cast<uint32_t>(value.size()));
+        WriteBytes(value.data(), value.size());
+    }
+
+    void WriteBlob(const void* data, size_t size) {
+        Write(static_cast<uint64_t>(size));
+        WriteBytes(data, size);
+    }
+
+    std::vector<uint8_t>& GetData() { return m_Data; }
+
+private:
+    std::vector<uint8_t> m_Data;
+};
+
+/**
+ * @brief 命令负载读取，越界后所有读取都失败
+ */
+class CaptureReader {
+public:
+    CaptureReader(const uint8_t* data, size_t size) : m_Data(data), m_Size(size) {}
+
+    template <typename T>
+    bool Read(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "只能直接读取平凡类型");
+        return ReadBytes(&value, sizeof(T));
+    }
+
+    bool ReadBytes(void* output, size_t size) {
+        if (!m_Valid || size > m_Size - m_Offset) {
+            m_Valid = false;
+            return false;
+        }
+        std::memcpy(output, m_Data + m_Offset, size);
+        m_Offset += size;
+        return true;
+    }
+
+    bool ReadString(std::string& value) {
+        uint32_t size = 0;
+        if (!Read(size) || size > m_Size - m_Offset) {
+            m_Valid = false;
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(m_Data + m_Offset), size);
+        m_Offset += size;
+        return true;
+    }
+
+    /**
+     * @brief 跳过size字节，返回指向原缓冲区的指针（不复制）
+     */
+    const uint8_t* ReadSpan(size_t size) {
+        if (!m_Valid || size > m_Size - m_Offset) {
+            m_Valid = false;
+            return nullptr;
+        }
+        const uint8_t* data = m_Data + m_Offset;
+        m_Offset += size;
+        return data;
+    }
+
+    /**
+     * @brief 读取带长度的数据块，返回指向原缓冲区的指针（不复制）
+     */
+    const uint8_t* ReadBlob(size_t& size) {
+        uint64_t length = 0;
+        if (!Read(length) || length > m_Size - m_Offset) {
+            m_Valid = false;
+            return nullptr;
+        }
+        size = static_cast<size_t>(length);
+        return ReadSpan(size);
+    }
+
+    bool IsValid() const { return m_Valid; }
+
+private:
+    const uint8_t* m_Data;
+    size_t m_Size;
+    size_t m_Offset = 0;
+    bool m_Valid = true;
+};
+
+} // namespace PLE
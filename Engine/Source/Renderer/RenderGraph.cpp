@@ -0,0 +1,348 @@
+/**
+ * @file RenderGraph.cpp
+ * @brief 渲染图实现
+ */
+
+#include "Renderer/RenderGraph.h"
+#include "Renderer/RenderResources.h"
+#include "Renderer/RenderSystem.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace PLE {
+
+namespace {
+
+// 估算渲染目标占用的显存：RGBA8颜色加24位深度8位模板
+uint64_t EstimateTargetBytes(const RenderGraphTargetDesc& desc) {
+    return static_cast<uint64_t>(desc.width) * static_cast<uint64_t>(desc.height) * 8;
+}
+
+} // namespace
+
+RenderGraphResource RenderGraphBuilder::Create(const std::string& name, const RenderGraphTargetDesc& desc) {
+    if (desc.width <= 0 || desc.height <= 0) {
+        std::cerr << "渲染图资源尺寸无效：" << name << std::endl;
+        m_Graph.m_Valid = false;
+    }
+
+    RenderGraph::Resource resource;
+    resource.name = name;
+    resource.desc = desc;
+    m_Graph.m_Resources.push_back(std::move(resource));
+    return Write(static_cast<RenderGraphResource>(m_Graph.m_Resources.size() - 1));
+}
+
+RenderGraphResource RenderGraphBuilder::Read(RenderGraphResource resource) {
+    RenderGraph::Pass& pass = m_Graph.m_Passes[m_PassIndex];
+    if (!m_Graph.IsValid(resource)) {
+        std::cerr << "Pass读取了无效的渲染图资源：" << pass.name << std::endl;
+        m_Graph.m_Valid = false;
+        return resource;
+    }
+    if (std::find(pass.reads.begin(), pass.reads.end(), resource) == pass.reads.end()) {
+        pass.reads.push_back(resource);
+    }
+    return resource;
+}
+
+RenderGraphResource RenderGraphBuilder::Write(RenderGraphResource resource) {
+    RenderGraph::Pass& pass = m_Graph.m_Passes[m_PassIndex];
+    if (!m_Graph.IsValid(resource)) {
+        std::cerr << "Pass写入了无效的渲染图资源：" << pass.name << std::endl;
+        m_Graph.m_Valid = false;
+        return resource;
+    }
+    if (pass.write != INVALID_RENDER_GRAPH_RESOURCE && pass.write != resource) {
+        std::cerr << "Pass最多只能写入一个渲染目标：" << pass.name << std::endl;
+        m_Graph.m_Valid = false;
+        return resource;
+    }
+    if (pass.write != resource) {
+        pass.write = resource;
+        m_Graph.m_Resources[resource].writers.push_back(m_PassIndex);
+    }
+    return resource;
+}
+
+void RenderGraphBuilder::SetSideEffect() {
+    m_Graph.m_Passes[m_PassIndex].sideEffect = true;
+}
+
+std::shared_ptr<RenderTarget> RenderGraphContext::GetRenderTarget(RenderGraphResource resource) const {
+    return m_Graph.ResolveTarget(resource);
+}
+
+std::shared_ptr<Texture> RenderGraphContext::GetTexture(RenderGraphResource resource) const {
+    std::shared_ptr<RenderTarget> target = m_Graph.ResolveTarget(resource);
+    return target ? target->GetColorTexture() : nullptr;
+}
+
+RenderGraph::RenderGraph() = default;
+
+RenderGraph::~RenderGraph() = default;
+
+RenderGraphResource RenderGraph::ImportRenderTarget(const std::string& name, std::shared_ptr<RenderTarget> renderTarget) {
+    Resource resource;
+    resource.name = name;
+    resource.imported = true;
+    if (renderTarget) {
+        resource.desc.width = renderTarget->GetWidth();
+        resource.desc.height = renderTarget->GetHeight();
+    }
+    resource.importedTarget = std::move(renderTarget);
+    m_Resources.push_back(std::move(resource));
+    m_Compiled = false;
+    return static_cast<RenderGraphResource>(m_Resources.size() - 1);
+}
+
+RenderGraphResource RenderGraph::GetBackBuffer() {
+    if (m_BackBuffer == INVALID_RENDER_GRAPH_RESOURCE) {
+        m_BackBuffer = ImportRenderTarget("BackBuffer", nullptr);
+    }
+    return m_BackBuffer;
+}
+
+void RenderGraph::AddPass(const std::string& name, const SetupFunc& setup, ExecuteFunc execute) {
+    Pass pass;
+    pass.name = name;
+    pass.execute = std::move(execute);
+    m_Passes.push_back(std::move(pass));
+
+    RenderGraphBuilder builder(*this, static_cast<uint32_t>(m_Passes.size() - 1));
+    if (setup) {
+        setup(builder);
+    }
+
+    const Pass& added = m_Passes.back();
+    if (added.write != INVALID_RENDER_GRAPH_RESOURCE &&
+        std::find(added.reads.begin(), added.reads.end(), added.write) != added.reads.end()) {
+        std::cerr << "Pass不能同时读写同一个渲染目标：" << name << std::endl;
+        m_Valid = false;
+    }
+    m_Compiled = false;
+}
+
+bool RenderGraph::Compile() {
+    m_Compiled = true;
+    m_Stats = RenderGraphStats();
+    m_Stats.passCount = static_cast<uint32_t>(m_Passes.size());
+    if (!m_Valid) {
+        return false;
+    }
+
+    // 引用计数：Pass的计数为输出数量，资源的计数为读取者数量
+    for (Pass& pass : m_Passes) {
+        pass.culled = false;
+        pass.refCount = (pass.write != INVALID_RENDER_GRAPH_RESOURCE ? 1 : 0) + (pass.sideEffect ? 1 : 0);
+    }
+    for (Resource& resource : m_Resources) {
+        // 导入资源在图外被使用，视为始终有一个读取者
+        resource.refCount = resource.imported ? 1 : 0;
+        resource.firstPass = UINT32_MAX;
+        resource.lastPass = 0;
+        resource.physical = UINT32_MAX;
+    }
+    for (const Pass& pass : m_Passes) {
+        for (RenderGraphResource read : pass.reads) {
+            ++m_Resources[read].refCount;
+        }
+    }
+
+    std::vector<RenderGraphResource> unreferenced;
+    auto cullPass = [&](Pass& pass) {
+        pass.culled = true;
+        ++m_Stats.culledPassCount;
+        for (RenderGraphResource read : pass.reads) {
+            if (--m_Resources[read].refCount == 0) {
+                unreferenced.push_back(read);
+            }
+        }
+    };
+
+    for (Pass& pass : m_Passes) {
+        if (pass.refCount == 0) {
+            cullPass(pass);
+        }
+    }
+    for (RenderGraphResource i = 0; i < m_Resources.size(); ++i) {
+        if (m_Resources[i].refCount == 0) {
+            unreferenced.push_back(i);
+        }
+    }
+    while (!unreferenced.empty()) {
+        RenderGraphResource resource = unreferenced.back();
+        unreferenced.pop_back();
+        for (uint32_t writer : m_Resources[resource].writers) {
+            Pass& pass = m_Passes[writer];
+            if (!pass.culled && --pass.refCount == 0) {
+                cullPass(pass);
+            }
+        }
+    }
+
+    // 按存活Pass的顺序计算瞬态资源的生命周期
+    for (uint32_t passIndex = 0; passIndex < m_Passes.size(); ++passIndex) {
+        const Pass& pass = m_Passes[passIndex];
+        if (pass.culled) {
+            continue;
+        }
+        auto touch = [&](RenderGraphResource index) {
+            Resource& resource = m_Resources[index];
+            resource.firstPass = std::min(resource.firstPass, passIndex);
+            resource.lastPass = std::max(resource.lastPass, passIndex);
+        };
+        for (RenderGraphResource read : pass.reads) {
+            touch(read);
+        }
+        if (pass.write != INVALID_RENDER_GRAPH_RESOURCE) {
+            touch(pass.write);
+        }
+    }
+
+    std::vector<RenderGraphResource> transients;
+    for (RenderGraphResource i = 0; i < m_Resources.size(); ++i) {
+        const Resource& resource = m_Resources[i];
+        if (resource.imported || resource.firstPass == UINT32_MAX) {
+            continue;
+        }
+        if (m_Passes[resource.firstPass].write != i) {
+            std::cerr << "渲染图资源在写入之前被读取：" << resource.name << std::endl;
+            m_Valid = false;
+            return false;
+        }
+        transients.push_back(i);
+    }
+    std::sort(transients.begin(), transients.end(), [this](RenderGraphResource a, RenderGraphResource b) {
+        return m_Resources[a].firstPass < m_Resources[b].firstPass;
+    });
+
+    // 按首次使用顺序贪心分配：复用尺寸相同且生命周期已经结束的渲染目标
+    for (PhysicalTarget& physical : m_Physical) {
+        physical.availableAfter = 0;
+        physical.used = false;
+    }
+    for (RenderGraphResource index : transients) {
+        Resource& resource = m_Resources[index];
+        uint32_t chosen = UINT32_MAX;
+        for (uint32_t i = 0; i < m_Physical.size(); ++i) {
+            const PhysicalTarget& physical = m_Physical[i];
+            if (physical.desc == resource.desc && physical.availableAfter <= resource.firstPass) {
+                // 优先复用已经创建过的目标
+                if (chosen == UINT32_MAX || (!m_Physical[chosen].target && physical.target)) {
+                    chosen = i;
+                }
+            }
+        }
+        if (chosen == UINT32_MAX) {
+            PhysicalTarget physical;
+            physical.desc = resource.desc;
+            m_Physical.push_back(std::move(physical));
+            chosen = static_cast<uint32_t>(m_Physical.size() - 1);
+        }
+
+        PhysicalTarget& physical = m_Physical[chosen];
+        if (!physical.used) {
+            physical.used = true;
+            ++m_Stats.physicalTargetCount;
+            m_Stats.physicalBytes += EstimateTargetBytes(physical.desc);
+        }
+        physical.availableAfter = resource.lastPass + 1;
+        resource.physical = chosen;
+
+        ++m_Stats.transientCount;
+        m_Stats.transientBytes += EstimateTargetBytes(resource.desc);
+    }
+
+    return true;
+}
+
+void RenderGraph::Execute(RenderSystem& renderSystem) {
+    if (!m_Compiled && !Compile()) {
+        return;
+    }
+    if (!m_Valid) {
+        return;
+    }
+
+    for (PhysicalTarget& physical : m_Physical) {
+        if (!physical.used) {
+            continue;
+        }
+        if (!physical.target) {
+            physical.target = renderSystem.CreateRenderTarget(physical.desc.width, physical.desc.height);
+            if (!physical.target) {
+                std::cerr << "渲染图创建渲染目标失败：" << physical.desc.width << "x" << physical.desc.height << std::endl;
+                return;
+            }
+        }
+    }
+
+    RenderGraphContext context(*this, renderSystem);
+    for (const Pass& pass : m_Passes) {
+        if (pass.culled) {
+            continue;
+        }
+        renderSystem.BeginStatsPass(pass.name);
+        if (pass.write != INVALID_RENDER_GRAPH_RESOURCE) {
+            renderSystem.SetRenderTarget(ResolveTarget(pass.write));
+        }
+        if (pass.execute) {
+            pass.execute(context);
+        }
+        renderSystem.EndStatsPass();
+    }
+    renderSystem.SetRenderTarget(nullptr);
+
+    // 释放长时间未使用的渲染目标（例如窗口尺寸变化后的旧尺寸）
+    for (PhysicalTarget& physical : m_Physical) {
+        physical.unusedFrames = physical.used ? 0 : physical.unusedFrames + 1;
+    }
+    const auto released = std::remove_if(m_Physical.begin(), m_Physical.end(), [](const PhysicalTarget& physical) {
+        return physical.unusedFrames > RELEASE_AFTER_UNUSED_FRAMES;
+    });
+    if (released != m_Physical.end()) {
+        // 删除会移动后面的渲染目标，Compile分配的物理索引失效，下次执行前重新编译
+        m_Physical.erase(released, m_Physical.end());
+        m_Compiled = false;
+    }
+}
+
+void RenderGraph::Reset() {
+    m_Resources.clear();
+    m_Passes.clear();
+    m_BackBuffer = INVALID_RENDER_GRAPH_RESOURCE;
+    m_Compiled = false;
+    m_Valid = true;
+}
+
+void RenderGraph::ReleaseTargets() {
+    Reset();
+    m_Physical.clear();
+}
+
+bool RenderGraph::IsPassCulled(const std::string& name) const {
+    for (const Pass& pass : m_Passes) {
+        if (pass.name == name) {
+            return pass.culled;
+        }
+    }
+    return false;
+}
+
+std::shared_ptr<RenderTarget> RenderGraph::ResolveTarget(RenderGraphResource resource) const {
+    if (!IsValid(resource)) {
+        return nullptr;
+    }
+    const Resource& entry = m_Resources[resource];
+    if (entry.imported) {
+        return entry.importedTarget;
+    }
+    if (entry.physical < m_Physical.size()) {
+        return m_Physical[entry.physical].target;
+    }
+    return nullptr;
+}
+
+} // namespace PLE
@@ -0,0 +1,465 @@
+/**
+ * @file RenderReplay.cpp
+ * @brief 渲染捕获回放实现
+ */
+
+#include "Renderer/RenderCapture.h"
+#include "Renderer/RenderResources.h"
+#include "RenderCaptureFormat.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <unordered_map>
+
+namespace PLE {
+
+namespace {
+
+bool ReadMatrix(CaptureReader& reader, Matrix4& matrix) {
+    return reader.ReadBytes(matrix.m.data(), sizeof(float) * 16);
+}
+
+bool ReadLayout(CaptureReader& reader, VertexLayout& layout) {
+    uint32_t attributeCount = 0;
+    reader.Read(attributeCount);
+    for (uint32_t i = 0; i < attributeCount && reader.IsValid(); ++i) {
+        VertexAttribute attribute;
+        uint32_t format = 0;
+        reader.Read(attribute.location);
+        reader.Read(format);
+        reader.Read(attribute.offset);
+        attribute.format = static_cast<VertexAttributeFormat>(format);
+        layout.attributes.push_back(attribute);
+    }
+    float positionOffset[3] = {};
+    uint32_t topology = 0;
+    reader.Read(layout.stride);
+    reader.Read(topology);
+    layout.topology = static_cast<PrimitiveTopology>(topology);
+    reader.ReadBytes(positionOffset, sizeof(positionOffset));
+    layout.positionOffset = Vector3(positionOffset[0], positionOffset[1], positionOffset[2]);
+    return reader.Read(layout.positionScale);
+}
+
+/**
+ * @brief 回放中捕获编号到实际资源的映射，在多次回放之间保留
+ */
+struct ReplayResources {
+    std::unordered_map<uint32_t, std::shared_ptr<Shader>> shaders;
+    std::unordered_map<uint32_t, std::shared_ptr<Texture>> textures;
+    std::unordered_map<uint32_t, std::shared_ptr<Mesh>> meshes;
+    std::unordered_map<uint32_t, std::shared_ptr<Material>> materials;
+    std::unordered_map<uint32_t, std::shared_ptr<RenderTarget>> targets;
+
+    template <typename T>
+    static std::shared_ptr<T> Find(const std::unordered_map<uint32_t, std::shared_ptr<T>>& map, uint32_t id) {
+        auto it = map.find(id);
+        return it != map.end() ? it->second : nullptr;
+    }
+
+    bool Contains(uint32_t id) const {
+        return shaders.count(id) || textures.count(id) || meshes.count(id) || materials.count(id) || targets.count(id);
+    }
+};
+
+bool IsCreation(RenderCaptureOp op) {
+    return op >= RenderCaptureOp::CreateShader && op <= RenderCaptureOp::RenderTargetTexture;
+}
+
+/**
+ * @brief 按成员类型把参数块数据设置回材质
+ */
+void ApplyBlock(Material& material, const uint8_t* data, size_t size) {
+    const std::shared_ptr<Shader> shader = material.GetShader();
+    if (!shader) {
+        return;
+    }
+    for (const MaterialBlockMember& member : shader->GetMaterialLayout().members) {
+        float value[16] = {};
+        const size_t count = member.type == MaterialParameterType::Matrix4 ? 16 : member.type == MaterialParameterType::Vector4 ? 4 : 1;
+        if (member.offset + count * sizeof(float) > size) {
+            continue;
+        }
+        std::memcpy(value, data + member.offset, count * sizeof(float));
+        switch (member.type) {
+        case MaterialParameterType::Float:
+            material.SetFloat(member.name, value[0]);
+            break;
+        case MaterialParameterType::Vector4:
+            material.SetVector4(member.name, Vector4(value[0], value[1], value[2], value[3]));
+            break;
+        case MaterialParameterType::Matrix4: {
+            Matrix4 matrix;
+            std::memcpy(matrix.m.data(), value, sizeof(value));
+            material.SetMatrix4(member.name, matrix);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+} // namespace
+
+bool RenderReplay::Load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "无法打开渲染捕获文件：" << path << std::endl;
+        return false;
+    }
+    m_Data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    RenderCaptureHeader header;
+    if (m_Data.size() < sizeof(header)) {
+        std::cerr << "渲染捕获文件不完整：" << path << std::endl;
+        return false;
+    }
+    std::memcpy(&header, m_Data.data(), sizeof(header));
+    if (header.magic != RENDER_CAPTURE_MAGIC || header.version != RENDER_CAPTURE_VERSION) {
+        std::cerr << "渲染捕获文件格式或版本不匹配：" << path << std::endl;
+        m_Data.clear();
+        return false;
+    }
+    m_FrameCount = header.frameCount;
+    m_Width = header.width;
+    m_Height = header.height;
+    return true;
+}
+
+bool RenderReplay::Replay(RenderSystem& renderSystem, const RenderReplaySettings& settings, std::vector<RenderReplayFrame>& frames) {
+    if (m_Data.size() < sizeof(RenderCaptureHeader)) {
+        return false;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    ReplayResources resources;
+    std::vector<uint8_t> pixels;
+
+    for (uint32_t iteration = 0; iteration < settings.iterations; ++iteration) {
+        CaptureReader stream(m_Data.data() + sizeof(RenderCaptureHeader), m_Data.size() - sizeof(RenderCaptureHeader));
+        uint32_t frameIndex = 0;
+        Clock::time_point frameStart = Clock::now();
+        bool inFrame = false;
+
+        for (;;) {
+            RenderCaptureOp op;
+            uint32_t size = 0;
+            if (!stream.Read(op)) {
+                break;
+            }
+            const uint8_t* payloadData = stream.Read(size) ? stream.ReadSpan(size) : nullptr;
+            if (!payloadData) {
+                std::cerr << "渲染捕获命令不完整！" << std::endl;
+                if (inFrame) {
+                    renderSystem.EndFrame();
+                }
+                return false;
+            }
+            CaptureReader payload(payloadData, size);
+
+            uint32_t id = 0;
+            if (IsCreation(op)) {
+                payload.Read(id);
+                // 重复回放复用已创建的资源，瞬态网格每帧重新创建
+                if (op != RenderCaptureOp::CreateTransientMesh && resources.Contains(id)) {
+                    continue;
+                }
+            }
+
+            switch (op) {
+            case RenderCaptureOp::CreateShader: {
+                std::string vertexSource;
+                std::string fragmentSource;
+                if (payload.ReadString(vertexSource) && payload.ReadString(fragmentSource)) {
+                    resources.shaders[id] = renderSystem.CreateShader(vertexSource, fragmentSource);
+                }
+                break;
+            }
+            case RenderCaptureOp::CreateShaderFromBinary: {
+                size_t length = 0;
+                const uint8_t* binary = payload.ReadBlob(length);
+                if (binary) {
+                    resources.shaders[id] = renderSystem.CreateShaderFromBinary(std::vector<uint8_t>(binary, binary + length));
+                    if (!resources.shaders[id]) {
+                        std::cerr << "着色器二进制无法在当前后端上创建，使用它的绘制将被跳过" << std::endl;
+                    }
+                }
+                break;
+            }
+            case RenderCaptureOp::CreateTexture: {
+                int32_t width = 0;
+                int32_t height = 0;
+                size_t length = 0;
+                payload.Read(width);
+                payload.Read(height);
+                const uint8_t* data = payload.ReadBlob(length);
+                if (payload.IsValid()) {
+                    resources.textures[id] = renderSystem.CreateTexture(width, height, length > 0 ? data : nullptr);
+                }
+                break;
+            }
+            case RenderCaptureOp::CreateTextureData: {
+                TextureData data;
+                uint32_t format = 0;
+                uint32_t mipCount = 0;
+                payload.Read(format);
+                payload.Read(data.width);
+                payload.Read(data.height);
+                payload.Read(mipCount);
+                data.format = static_cast<TextureFormat>(format);
+                for (uint32_t i = 0; i < mipCount && payload.IsValid(); ++i) {
+                    TextureMipLevel mip;
+                    uint64_t offset = 0;
+                    uint64_t mipSize = 0;
+                    payload.Read(mip.width);
+                    payload.Read(mip.height);
+                    payload.Read(offset);
+                    payload.Read(mipSize);
+                    mip.offset = static_cast<size_t>(offset);
+                    mip.size = static_cast<size_t>(mipSize);
+                    data.mips.push_back(mip);
+                }
+                size_t length = 0;
+                const uint8_t* pixelData = payload.ReadBlob(length);
+                if (payload.IsValid()) {
+                    data.pixels.assign(pixelData, pixelData + length);
+                    resources.textures[id] = renderSystem.CreateTexture(data);
+                }
+                break;
+            }
+            case RenderCaptureOp::CreateMesh: {
+                VertexLayout layout;
+                uint32_t vertexCount = 0;
+                uint32_t indexCount = 0;
+                size_t vertexBytes = 0;
+                size_t indexBytes = 0;
+                ReadLayout(payload, layout);
+                payload.Read(vertexCount);
+                const uint8_t* vertices = payload.ReadBlob(vertexBytes);
+                payload.Read(indexCount);
+                const uint8_t* indices = payload.ReadBlob(indexBytes);
+                if (payload.IsValid() && vertexBytes == static_cast<size_t>(vertexCount) * layout.stride &&
+                    indexBytes == indexCount * sizeof(uint32_t)) {
+                    // 负载缓冲区没有对齐保证，索引复制到对齐的数组
+                    std::vector<uint32_t> indexData(indexCount);
+                    std::memcpy(indexData.data(), indices, indexBytes);
+                    resources.meshes[id] = renderSystem.CreateMesh(vertices, vertexCount, layout,
+                                                                   indexCount > 0 ? indexData.data() : nullptr, indexCount);
+                }
+                break;
+            }
+            case RenderCaptureOp::CreateTransientMesh: {
+                VertexLayout layout;
+                uint32_t vertexCount = 0;
+                uint32_t indexCount = 0;
+                size_t vertexBytes = 0;
+                size_t indexBytes = 0;
+                ReadLayout(payload, layout);
+                payload.Read(vertexCount);
+                const uint8_t* vertices = payload.ReadBlob(vertexBytes);
+                payload.Read(indexCount);
+                const uint8_t* indices = payload.ReadBlob(indexBytes);
+                if (payload.IsValid() && vertexBytes == static_cast<size_t>(vertexCount) * layout.stride &&
+                    indexBytes == indexCount * sizeof(uint32_t)) {
+                    std::vector<uint32_t> indexData(indexCount);
+                    std::memcpy(indexData.data(), indices, indexBytes);
+                    resources.meshes[id] = renderSystem.CreateTransientMesh(vertices, vertexCount, layout,
+                                                                            indexCount > 0 ? indexData.data() : nullptr, indexCount);
+                }
+                break;
+            }
+            case RenderCaptureOp::CreateMaterial: {
+                uint32_t shaderId = 0;
+                payload.Read(shaderId);
+                if (std::shared_ptr<Shader> shader = ReplayResources::Find(resources.shaders, shaderId)) {
+                    resources.materials[id] = renderSystem.CreateMaterial(shader);
+                } else {
+                    resources.materials[id] = nullptr;
+                }
+                break;
+            }
+            case RenderCaptureOp::CreateMaterialInstance: {
+                uint32_t parentId = 0;
+                payload.Read(parentId);
+                if (std::shared_ptr<Material> parent = ReplayResources::Find(resources.materials, parentId)) {
+                    resources.materials[id] = renderSystem.CreateMaterialInstance(parent);
+                } else {
+                    resources.materials[id] = nullptr;
+                }
+                break;
+            }
+            case RenderCaptureOp::CreateRenderTarget: {
+                int32_t width = 0;
+                int32_t height = 0;
+                payload.Read(width);
+                payload.Read(height);
+                resources.targets[id] = renderSystem.CreateRenderTarget(width, height);
+                break;
+            }
+            case RenderCaptureOp::RenderTargetTexture: {
+                uint32_t targetId = 0;
+                payload.Read(targetId);
+                std::shared_ptr<RenderTarget> target = ReplayResources::Find(resources.targets, targetId);
+                resources.textures[id] = target ? target->GetColorTexture() : nullptr;
+                break;
+            }
+            case RenderCaptureOp::MaterialParameters: {
+                uint32_t materialId = 0;
+                uint32_t count = 0;
+                payload.Read(materialId);
+                payload.Read(count);
+                std::shared_ptr<Material> material = ReplayResources::Find(resources.materials, materialId);
+                for (uint32_t i = 0; i < count && payload.IsValid(); ++i) {
+                    std::string name;
+                    uint32_t type = 0;
+                    std::array<float, 16> value;
+                    uint32_t textureId = 0;
+                    payload.ReadString(name);
+                    payload.Read(type);
+                    payload.Read(value);
+                    payload.Read(textureId);
+                    if (!material || !payload.IsValid()) {
+                        continue;
+                    }
+                    switch (static_cast<MaterialParameterType>(type)) {
+                    case MaterialParameterType::Float:
+                        material->SetFloat(name, value[0]);
+                        break;
+                    case MaterialParameterType::Vector4:
+                        material->SetVector4(name, Vector4(value[0], value[1], value[2], value[3]));
+                        break;
+                    case MaterialParameterType::Matrix4: {
+                        Matrix4 matrix;
+                        matrix.m = value;
+                        material->SetMatrix4(name, matrix);
+                        break;
+                    }
+                    case MaterialParameterType::Texture:
+                        material->SetTexture(name, ReplayResources::Find(resources.textures, textureId));
+                        break;
+                    }
+                }
+                break;
+            }
+            case RenderCaptureOp::MaterialBlock: {
+                uint32_t materialId = 0;
+                size_t length = 0;
+                payload.Read(materialId);
+                const uint8_t* data = payload.ReadBlob(length);
+                std::shared_ptr<Material> material = ReplayResources::Find(resources.materials, materialId);
+                if (material && data) {
+                    ApplyBlock(*material, data, length);
+                }
+                break;
+            }
+            case RenderCaptureOp::BeginFrame:
+                frameStart = Clock::now();
+                inFrame = true;
+                renderSystem.BeginFrame();
+                break;
+            case RenderCaptureOp::EndFrame: {
+                renderSystem.EndFrame();
+                if (settings.waitForGPU) {
+                    pixels.resize(4);
+                    renderSystem.ReadPixels(0, 0, 1, 1, pixels.data());
+                }
+                RenderReplayFrame frame;
+                frame.iteration = iteration;
+                frame.frame = frameIndex++;
+                frame.cpuMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count();
+                frame.stats = renderSystem.GetFrameStats();
+                frames.push_back(std::move(frame));
+                inFrame = false;
+                break;
+            }
+            case RenderCaptureOp::Clear: {
+                float color[4] = {};
+                uint8_t depth = 0;
+                uint8_t stencil = 0;
+                payload.ReadBytes(color, sizeof(color));
+                payload.Read(depth);
+                payload.Read(stencil);
+                renderSystem.Clear(Vector4(color[0], color[1], color[2], color[3]), depth != 0, stencil != 0);
+                break;
+            }
+            case RenderCaptureOp::SetViewport: {
+                int32_t viewport[4] = {};
+                payload.ReadBytes(viewport, sizeof(viewport));
+                renderSystem.SetViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+                break;
+            }
+            case RenderCaptureOp::SetRenderTarget: {
+                uint32_t targetId = 0;
+                payload.Read(targetId);
+                renderSystem.SetRenderTarget(ReplayResources::Find(resources.targets, targetId));
+                break;
+            }
+            case RenderCaptureOp::DrawMesh: {
+                uint32_t meshId = 0;
+                uint32_t materialId = 0;
+                Matrix4 transform;
+                payload.Read(meshId);
+                payload.Read(materialId);
+                ReadMatrix(payload, transform);
+                renderSystem.DrawMesh(ReplayResources::Find(resources.meshes, meshId),
+                                      ReplayResources::Find(resources.materials, materialId), transform);
+                break;
+            }
+            case RenderCaptureOp::SetViewProjection: {
+                Matrix4 view;
+                Matrix4 projection;
+                ReadMatrix(payload, view);
+                ReadMatrix(payload, projection);
+                renderSystem.SetViewProjection(view, projection);
+                break;
+            }
+            case RenderCaptureOp::ReadPixels: {
+                int32_t rect[4] = {};
+                payload.ReadBytes(rect, sizeof(rect));
+                if (rect[2] > 0 && rect[3] > 0) {
+                    pixels.resize(static_cast<size_t>(rect[2]) * rect[3] * 4);
+                    renderSystem.ReadPixels(rect[0], rect[1], rect[2], rect[3], pixels.data());
+                }
+                break;
+            }
+            case RenderCaptureOp::BeginStatsPass: {
+                std::string name;
+                payload.ReadString(name);
+                renderSystem.BeginStatsPass(name);
+                break;
+            }
+            case RenderCaptureOp::EndStatsPass:
+                renderSystem.EndStatsPass();
+                break;
+            case RenderCaptureOp::ReportCulling: {
+                uint32_t submitted = 0;
+                uint32_t culled = 0;
+                payload.Read(submitted);
+                payload.Read(culled);
+                renderSystem.ReportCulling(submitted, culled);
+                break;
+            }
+            default:
+                std::cerr << "未知的渲染捕获命令：" << static_cast<int>(op) << std::endl;
+                if (inFrame) {
+                    renderSystem.EndFrame();
+                }
+                return false;
+            }
+
+            if (!payload.IsValid()) {
+                std::cerr << "渲染捕获命令数据损坏：" << static_cast<int>(op) << std::endl;
+                if (inFrame) {
+                    renderSystem.EndFrame();
+                }
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace PLE
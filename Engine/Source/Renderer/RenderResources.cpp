@@ -0,0 +1,315 @@
+/**
+ * @file RenderResources.cpp
+ * @brief 渲染资源实现
+ */
+
+#include "Renderer/RenderResources.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+namespace PLE {
+
+namespace {
+
+// 参数块版本全局递增，实例切换到自己的参数块后版本也不会与父材质冲突
+std::atomic<uint64_t> s_NextBlockVersion{ 1 };
+
+uint64_t NextBlockVersion() {
+    return s_NextBlockVersion.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint32_t GetMemberSize(MaterialParameterType type) {
+    switch (type) {
+    case MaterialParameterType::Float:
+        return 4;
+    case MaterialParameterType::Vector4:
+        return 16;
+    case MaterialParameterType::Matrix4:
+        return 64;
+    default:
+        return 0;
+    }
+}
+
+} // namespace
+
+const VertexLayout& VertexLayout::Standard() {
+    static const VertexLayout layout = [] {
+        VertexLayout result;
+        result.attributes = {
+            { 0, VertexAttributeFormat::Float3, static_cast<uint32_t>(offsetof(Vertex, position)) },
+            { 1, VertexAttributeFormat::Float3, static_cast<uint32_t>(offsetof(Vertex, normal)) },
+            { 2, VertexAttributeFormat::Float2, static_cast<uint32_t>(offsetof(Vertex, texCoord)) }
+        };
+        result.stride = sizeof(Vertex);
+        return result;
+    }();
+    return layout;
+}
+
+uint32_t VertexLayout::GetFormatSize(VertexAttributeFormat format) {
+    switch (format) {
+    case VertexAttributeFormat::Float2:
+        return 8;
+    case VertexAttributeFormat::Float3:
+        return 12;
+    case VertexAttributeFormat::Float4:
+        return 16;
+    case VertexAttributeFormat::Half2:
+    case VertexAttributeFormat::Snorm16x2:
+    case VertexAttributeFormat::Unorm8x4:
+    case VertexAttributeFormat::Snorm8x4:
+        return 4;
+    case VertexAttributeFormat::Half4:
+    case VertexAttributeFormat::Unorm16x4:
+    case VertexAttributeFormat::Snorm16x4:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+uint64_t VertexLayout::GetFormatHash() const {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    };
+    mix(stride);
+    mix(static_cast<uint32_t>(topology));
+    for (const VertexAttribute& attribute : attributes) {
+        mix(attribute.location);
+        mix(static_cast<uint32_t>(attribute.format));
+        mix(attribute.offset);
+    }
+    return hash;
+}
+
+bool VertexLayout::HasPositionDecode() const {
+    return positionScale != 1.0f || positionOffset.x != 0.0f || positionOffset.y != 0.0f || positionOffset.z != 0.0f;
+}
+
+Matrix4 VertexLayout::GetPositionDecodeMatrix() const {
+    return Matrix4(positionScale, 0.0f, 0.0f, 0.0f,
+                   0.0f, positionScale, 0.0f, 0.0f,
+                   0.0f, 0.0f, positionScale, 0.0f,
+                   positionOffset.x, positionOffset.y, positionOffset.z, 1.0f);
+}
+
+bool VertexLayout::IsValid() const {
+    if (stride == 0 || attributes.empty()) {
+        return false;
+    }
+    for (size_t i = 0; i < attributes.size(); ++i) {
+        if (attributes[i].offset + GetFormatSize(attributes[i].format) > stride) {
+            return false;
+        }
+        for (size_t j = 0; j < i; ++j) {
+            if (attributes[j].location == attributes[i].location) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+size_t TextureData::GetLevelSize(TextureFormat format, uint32_t width, uint32_t height) {
+    const size_t blocks = static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4);
+    switch (format) {
+    case TextureFormat::RGBA8:
+        return static_cast<size_t>(width) * height * 4;
+    case TextureFormat::BC1:
+        return blocks * 8;
+    case TextureFormat::BC3:
+    case TextureFormat::BC5:
+    case TextureFormat::BC7:
+        return blocks * 16;
+    default:
+        return 0;
+    }
+}
+
+bool TextureData::IsValid() const {
+    if (width == 0 || height == 0 || mips.empty()) {
+        return false;
+    }
+    uint32_t levelWidth = width;
+    uint32_t levelHeight = height;
+    for (const TextureMipLevel& level : mips) {
+        if (level.width != levelWidth || level.height != levelHeight ||
+            level.size != GetLevelSize(format, levelWidth, levelHeight) ||
+            level.offset > pixels.size() || level.size > pixels.size() - level.offset) {
+            return false;
+        }
+        levelWidth = std::max(levelWidth / 2, 1u);
+        levelHeight = std::max(levelHeight / 2, 1u);
+    }
+    return true;
+}
+
+int MaterialBlockLayout::Find(const std::string& name) const {
+    for (size_t i = 0; i < members.size(); ++i) {
+        if (members[i].name == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+Material::Material(std::shared_ptr<Shader> shader, std::shared_ptr<Material> parent)
+    : m_Shader(shader)
+    , m_Parent(parent)
+    , m_BlockVersion(NextBlockVersion()) {
+    if (m_Parent) {
+        m_Parameters = m_Parent->m_Parameters;
+        m_OwnsBlock = false;
+    } else if (m_Shader) {
+        m_Block.assign(m_Shader->GetMaterialLayout().size, 0);
+        MarkDirty(0, static_cast<uint32_t>(m_Block.size()));
+    }
+}
+
+void Material::SetFloat(const std::string& name, float value) {
+    if (WriteBlock(name, MaterialParameterType::Float, &value, sizeof(value))) {
+        return;
+    }
+    MaterialParameter& parameter = FindOrAddParameter(name, MaterialParameterType::Float);
+    parameter.value[0] = value;
+}
+
+void Material::SetVector4(const std::string& name, const Vector4& value) {
+    const float data[4] = { value.x, value.y, value.z, value.w };
+    if (WriteBlock(name, MaterialParameterType::Vector4, data, sizeof(data))) {
+        return;
+    }
+    MaterialParameter& parameter = FindOrAddParameter(name, MaterialParameterType::Vector4);
+    std::copy(data, data + 4, parameter.value.begin());
+}
+
+void Material::SetMatrix4(const std::string& name, const Matrix4& value) {
+    if (WriteBlock(name, MaterialParameterType::Matrix4, value.m.data(), sizeof(value.m))) {
+        return;
+    }
+    MaterialParameter& parameter = FindOrAddParameter(name, MaterialParameterType::Matrix4);
+    parameter.value = value.m;
+}
+
+void Material::SetTexture(const std::string& name, std::shared_ptr<Texture> texture) {
+    MaterialParameter& parameter = FindOrAddParameter(name, MaterialParameterType::Texture);
+    parameter.texture = texture;
+}
+
+MaterialParameter& Material::FindOrAddParameter(const std::string& name, MaterialParameterType type) {
+    ++m_Version;
+    auto it = std::find_if(m_Parameters.begin(), m_Parameters.end(), [&name](const MaterialParameter& parameter) {
+        return parameter.name == name;
+    });
+    if (it != m_Parameters.end()) {
+        it->type = type;
+        return *it;
+    }
+
+    MaterialParameter parameter;
+    parameter.name = name;
+    parameter.type = type;
+    m_Parameters.push_back(parameter);
+    return m_Parameters.back();
+}
+
+Material* Material::ResolveBlock() {
+    if (!m_OwnsBlock) {
+        return m_Parent->ResolveBlock();
+    }
+    if (!m_Parent) {
+        return this;
+    }
+
+    Material* parentBlock = m_Parent->ResolveBlock();
+    if (parentBlock->m_BlockVersion != m_ParentBlockVersion) {
+        // 只合并未被覆盖的成员；成员通常很少，逐个复制比整块比较更便宜
+        const MaterialBlockLayout& layout = m_Shader->GetMaterialLayout();
+        for (size_t i = 0; i < layout.members.size(); ++i) {
+            if (m_Overridden[i]) {
+                continue;
+            }
+            const MaterialBlockMember& member = layout.members[i];
+            const uint32_t size = GetMemberSize(member.type);
+            if (std::memcmp(&m_Block[member.offset], &parentBlock->m_Block[member.offset], size) != 0) {
+                std::memcpy(&m_Block[member.offset], &parentBlock->m_Block[member.offset], size);
+                MarkDirty(member.offset, member.offset + size);
+            }
+        }
+        m_ParentBlockVersion = parentBlock->m_BlockVersion;
+        m_BlockVersion = NextBlockVersion();
+    }
+    return this;
+}
+
+bool Material::TakeDirtyRange(uint32_t& begin, uint32_t& end) {
+    if (m_DirtyBegin >= m_DirtyEnd) {
+        return false;
+    }
+    begin = m_DirtyBegin;
+    end = m_DirtyEnd;
+    m_DirtyBegin = 0;
+    m_DirtyEnd = 0;
+    return true;
+}
+
+bool Material::WriteBlock(const std::string& name, MaterialParameterType type, const float* value, uint32_t size) {
+    if (!m_Shader) {
+        return false;
+    }
+    const MaterialBlockLayout& layout = m_Shader->GetMaterialLayout();
+    const int index = layout.Find(name);
+    if (index < 0) {
+        return false;
+    }
+    const MaterialBlockMember& member = layout.members[static_cast<size_t>(index)];
+    if (member.type != type) {
+        std::cerr << "材质参数类型与着色器不匹配：" << name << std::endl;
+        return true;
+    }
+
+    if (!m_OwnsBlock) {
+        // 第一次覆盖：复制父材质的参数块（写时复制）
+        Material* parentBlock = m_Parent->ResolveBlock();
+        m_Block = parentBlock->m_Block;
+        m_ParentBlockVersion = parentBlock->m_BlockVersion;
+        m_Overridden.assign(layout.members.size(), false);
+        m_OwnsBlock = true;
+        MarkDirty(0, static_cast<uint32_t>(m_Block.size()));
+    }
+    if (m_Parent) {
+        m_Overridden[static_cast<size_t>(index)] = true;
+    }
+
+    if (std::memcmp(&m_Block[member.offset], value, size) != 0) {
+        std::memcpy(&m_Block[member.offset], value, size);
+        MarkDirty(member.offset, member.offset + size);
+        m_BlockVersion = NextBlockVersion();
+    }
+    return true;
+}
+
+void Material::MarkDirty(uint32_t begin, uint32_t end) {
+    if (begin >= end) {
+        return;
+    }
+    if (m_DirtyBegin >= m_DirtyEnd) {
+        m_DirtyBegin = begin;
+        m_DirtyEnd = end;
+    } else {
+        m_DirtyBegin = std::min(m_DirtyBegin, begin);
+        m_DirtyEnd = std::max(m_DirtyEnd, end);
+    }
+}
+
+} // namespace PLE
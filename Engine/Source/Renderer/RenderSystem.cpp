@@ -0,0 +1,79 @@
+/**
+ * @file RenderSystem.cpp
+ * @brief 渲染系统工厂和统计实现
+ */
+
+#include "Renderer/RenderSystem.h"
+
+#include <iostream>
+
+#ifdef PLE_RENDERER_OPENGL
+    #include "OpenGL/OpenGLRenderSystem.h"
+#endif
+#ifdef PLE_RENDERER_VULKAN
+    #include "Vulkan/VulkanRenderSystem.h"
+#endif
+
+namespace PLE {
+
+std::unique_ptr<RenderSystem> RenderSystem::Create(const RenderSystemConfig& config) {
+    switch (config.api) {
+#ifdef PLE_RENDERER_OPENGL
+    case RenderAPI::OpenGL:
+        return std::make_unique<OpenGLRenderSystem>(config);
+#endif
+#ifdef PLE_RENDERER_VULKAN
+    case RenderAPI::Vulkan:
+        return std::make_unique<VulkanRenderSystem>(config);
+#endif
+    default:
+        std::cerr << "不支持的渲染API：" << static_cast<int>(config.api) << std::endl;
+        return nullptr;
+    }
+}
+
+void RenderSystem::BeginStatsPass(const std::string& name) {
+    if (m_PassActive) {
+        EndStatsPass();
+    }
+    RenderPassStats pass;
+    pass.name = name;
+    m_Stats.passes.push_back(std::move(pass));
+    m_PassStart = std::chrono::steady_clock::now();
+    m_PassDrawCalls = m_Stats.drawCalls;
+    m_PassTriangles = m_Stats.triangles;
+    m_PassActive = true;
+}
+
+void RenderSystem::EndStatsPass() {
+    if (!m_PassActive) {
+        return;
+    }
+    RenderPassStats& pass = m_Stats.passes.back();
+    pass.cpuMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_PassStart).count();
+    pass.drawCalls = m_Stats.drawCalls - m_PassDrawCalls;
+    pass.triangles = m_Stats.triangles - m_PassTriangles;
+    m_PassActive = false;
+}
+
+void RenderSystem::BeginFrameStats() {
+    m_FrameStart = std::chrono::steady_clock::now();
+    m_LastMaterial = nullptr;
+}
+
+void RenderSystem::EndFrameStats() {
+    EndStatsPass();
+    m_Stats.frame = m_FrameStats.frame + 1;
+    m_Stats.objectsSubmitted = m_ObjectsSubmitted.exchange(0, std::memory_order_relaxed);
+    m_Stats.objectsCulled = m_ObjectsCulled.exchange(0, std::memory_order_relaxed);
+    m_Stats.frameCpuMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_FrameStart).count();
+
+    // 交换后清空，保留passes的容量，稳定运行时不再分配
+    std::swap(m_FrameStats, m_Stats);
+    std::vector<RenderPassStats> passes = std::move(m_Stats.passes);
+    passes.clear();
+    m_Stats = RenderStats();
+    m_Stats.passes = std::move(passes);
+}
+
+} // namespace PLE
@@ -0,0 +1,82 @@
+/**
+ * @file RenderTargetPool.cpp
+ * @brief 渲染目标池实现
+ */
+
+#include "Renderer/RenderTargetPool.h"
+#include "Renderer/RenderResources.h"
+#include "Renderer/RenderSystem.h"
+
+#include <algorithm>
+
+namespace PLE {
+
+RenderTargetPool::RenderTargetPool(RenderSystem& renderSystem, uint32_t releaseAfterFrames)
+    : m_RenderSystem(renderSystem)
+    , m_ReleaseAfterFrames(std::max(releaseAfterFrames, renderSystem.GetFramesInFlight())) {
+}
+
+RenderTargetPool::~RenderTargetPool() = default;
+
+std::shared_ptr<RenderTarget> RenderTargetPool::Acquire(int width, int height) {
+    for (Entry& entry : m_Entries) {
+        if (!entry.inUse && entry.width == width && entry.height == height) {
+            entry.inUse = true;
+            entry.lastUsedFrame = m_Frame;
+            return entry.target;
+        }
+    }
+
+    std::shared_ptr<RenderTarget> target = m_RenderSystem.CreateRenderTarget(width, height);
+    if (!target) {
+        return nullptr;
+    }
+    Entry entry;
+    entry.target = target;
+    entry.width = width;
+    entry.height = height;
+    entry.inUse = true;
+    entry.lastUsedFrame = m_Frame;
+    m_Entries.push_back(std::move(entry));
+    return target;
+}
+
+void RenderTargetPool::Release(const std::shared_ptr<RenderTarget>& renderTarget) {
+    for (Entry& entry : m_Entries) {
+        if (entry.target == renderTarget) {
+            entry.inUse = false;
+            return;
+        }
+    }
+}
+
+void RenderTargetPool::NextFrame() {
+    ++m_Frame;
+    for (Entry& entry : m_Entries) {
+        entry.inUse = false;
+    }
+    m_Entries.erase(std::remove_if(m_Entries.begin(), m_Entries.end(), [this](const Entry& entry) {
+        return m_Frame - entry.lastUsedFrame > m_ReleaseAfterFrames;
+    }), m_Entries.end());
+}
+
+void RenderTargetPool::Clear() {
+    m_Entries.clear();
+}
+
+uint32_t RenderTargetPool::GetInUseCount() const {
+    return static_cast<uint32_t>(std::count_if(m_Entries.begin(), m_Entries.end(), [](const Entry& entry) {
+        return entry.inUse;
+    }));
+}
+
+uint64_t RenderTargetPool::GetMemoryBytes() const {
+    // RGBA8颜色加24位深度8位模板
+    uint64_t bytes = 0;
+    for (const Entry& entry : m_Entries) {
+        bytes += static_cast<uint64_t>(entry.width) * static_cast<uint64_t>(entry.height) * 8;
+    }
+    return bytes;
+}
+
+} // namespace PLE
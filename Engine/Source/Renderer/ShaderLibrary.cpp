@@ -0,0 +1,396 @@
+/**
+ * @file ShaderLibrary.cpp
+ * @brief 着色器变体库实现
+ */
+
+#include "Renderer/ShaderLibrary.h"
+#include "Renderer/RenderResources.h"
+#include "Renderer/RenderSystem.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace PLE {
+
+namespace {
+
+constexpr uint32_t CACHE_MAGIC = 0x56534C50;    // "PLSV"
+constexpr uint32_t CACHE_VERSION = 1;
+
+/**
+ * @brief 磁盘缓存文件头
+ */
+struct CacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint64_t deviceHash;
+    uint64_t size;
+    uint64_t checksum;
+};
+
+uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+    // FNV-1a
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+uint64_t HashString(uint64_t hash, const std::string& text) {
+    // 末尾的0分隔相邻字段，避免"ab"+"c"与"a"+"bc"得到相同的哈希
+    return HashBytes(hash, text.c_str(), text.size() + 1);
+}
+
+constexpr uint64_t HASH_SEED = 0xcbf29ce484222325ull;
+
+bool IsSpirvSource(const std::string& source) {
+    const uint32_t SPIRV_MAGIC = 0x07230203;
+    uint32_t magic = 0;
+    if (source.size() < sizeof(magic)) {
+        return false;
+    }
+    std::memcpy(&magic, source.data(), sizeof(magic));
+    return magic == SPIRV_MAGIC;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// ShaderVariant
+// ---------------------------------------------------------------------------
+
+void ShaderVariant::Wait() const {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Condition.wait(lock, [this]() { return m_Ready.load(std::memory_order_acquire); });
+}
+
+void ShaderVariant::Complete(std::shared_ptr<Shader> shader) {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Shader = std::move(shader);
+        m_Ready.store(true, std::memory_order_release);
+    }
+    m_Condition.notify_all();
+}
+
+// ---------------------------------------------------------------------------
+// ShaderLibrary
+// ---------------------------------------------------------------------------
+
+ShaderLibrary::ShaderLibrary(RenderSystem& renderSystem, const ShaderLibraryConfig& config)
+    : m_RenderSystem(renderSystem)
+    , m_Config(config) {
+}
+
+ShaderLibrary::~ShaderLibrary() {
+    Shutdown();
+}
+
+bool ShaderLibrary::Initialize() {
+    if (m_Running) {
+        return true;
+    }
+
+    // 驱动或设备变化后旧的二进制全部失效
+    const uint32_t api = static_cast<uint32_t>(m_RenderSystem.GetAPI());
+    m_DeviceHash = HashBytes(HASH_SEED, &api, sizeof(api));
+    m_DeviceHash = HashString(m_DeviceHash, m_RenderSystem.GetGPUInfo());
+    m_DeviceHash = HashString(m_DeviceHash, m_RenderSystem.GetAPIVersion());
+
+    if (!m_Config.cacheDirectory.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(m_Config.cacheDirectory, error);
+        if (error) {
+            std::cerr << "创建着色器缓存目录失败：" << m_Config.cacheDirectory << std::endl;
+            m_Config.cacheDirectory.clear();
+        }
+    }
+
+    m_Running = true;
+    if (m_Config.workerCount == 0) {
+        return true;
+    }
+
+    // 每个后台线程先向渲染系统注册，任何一个失败都退回到渲染线程编译
+    std::mutex startupMutex;
+    std::condition_variable startupCondition;
+    uint32_t started = 0;
+    uint32_t failed = 0;
+    for (uint32_t i = 0; i < m_Config.workerCount; ++i) {
+        m_Workers.emplace_back([&, this]() {
+            const bool attached = m_RenderSystem.AttachWorkerThread();
+            {
+                std::lock_guard<std::mutex> lock(startupMutex);
+                ++started;
+                failed += attached ? 0 : 1;
+                startupCondition.notify_all();
+            }
+            if (attached) {
+                WorkerLoop();
+                m_RenderSystem.DetachWorkerThread();
+            }
+        });
+    }
+    {
+        std::unique_lock<std::mutex> lock(startupMutex);
+        startupCondition.wait(lock, [&]() { return started == m_Config.workerCount; });
+    }
+
+    if (failed > 0) {
+        std::cout << "渲染后端不支持后台编译着色器，改为在渲染线程上编译" << std::endl;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Running = false;
+        }
+        m_Condition.notify_all();
+        for (std::thread& worker : m_Workers) {
+            worker.join();
+        }
+        m_Workers.clear();
+        m_Running = true;
+    }
+    return true;
+}
+
+void ShaderLibrary::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!m_Running && m_Workers.empty() && m_Queue.empty() && m_Variants.empty()) {
+            return;
+        }
+        m_Running = false;
+    }
+    m_Condition.notify_all();
+    for (std::thread& worker : m_Workers) {
+        worker.join();
+    }
+    m_Workers.clear();
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (Job& job : m_Queue) {
+        job.variant->Complete(nullptr);
+    }
+    m_Queue.clear();
+    m_Variants.clear();
+}
+
+ShaderVariantKey ShaderLibrary::ComputeKey(const ShaderVariantDesc& desc) {
+    uint64_t hash = HASH_SEED;
+    hash = HashString(hash, desc.vertexSource);
+    hash = HashString(hash, desc.fragmentSource);
+    for (const auto& define : desc.defines) {
+        hash = HashString(hash, define.first);
+        hash = HashString(hash, define.second);
+    }
+    return hash;
+}
+
+std::string ShaderLibrary::ApplyDefines(const std::string& source, const ShaderDefines& defines) {
+    if (defines.empty()) {
+        return source;
+    }
+
+    std::string block;
+    for (const auto& define : defines) {
+        block += "#define " + define.first + " " + define.second + "\n";
+    }
+
+    // #version必须是第一条指令，宏定义插入到它之后
+    size_t insertAt = 0;
+    const size_t version = source.find("#version");
+    if (version != std::string::npos) {
+        const size_t lineEnd = source.find('\n', version);
+        insertAt = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+    }
+    std::string result = source.substr(0, insertAt);
+    if (insertAt > 0 && result.back() != '\n') {
+        result += '\n';
+    }
+    result += block;
+    result.append(source, insertAt, std::string::npos);
+    return result;
+}
+
+std::shared_ptr<ShaderVariant> ShaderLibrary::Request(const ShaderVariantDesc& desc) {
+    const ShaderVariantKey key = ComputeKey(desc);
+    std::shared_ptr<ShaderVariant> variant;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ++m_Stats.requests;
+        auto it = m_Variants.find(key);
+        if (it != m_Variants.end()) {
+            ++m_Stats.deduplicated;
+            return it->second;
+        }
+        variant = std::make_shared<ShaderVariant>(key);
+        m_Variants.emplace(key, variant);
+        m_Queue.push_back({ desc, variant });
+    }
+    m_Condition.notify_one();
+    return variant;
+}
+
+std::shared_ptr<Shader> ShaderLibrary::Get(const ShaderVariantDesc& desc) {
+    std::shared_ptr<ShaderVariant> variant = Request(desc);
+    if (!variant->IsReady()) {
+        // 还在队列中就直接在调用线程上编译，不必等待排在前面的请求
+        Job job;
+        if (TakeJob(variant->GetKey(), job)) {
+            Process(job);
+        } else {
+            variant->Wait();
+        }
+    }
+    return variant->GetShader();
+}
+
+void ShaderLibrary::Update(uint32_t maxVariants) {
+    if (!m_Workers.empty()) {
+        return;
+    }
+    for (uint32_t i = 0; i < maxVariants; ++i) {
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_Queue.empty()) {
+                return;
+            }
+            job = std::move(m_Queue.front());
+            m_Queue.pop_front();
+        }
+        Process(job);
+    }
+}
+
+ShaderLibraryStats ShaderLibrary::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Stats;
+}
+
+void ShaderLibrary::WorkerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Condition.wait(lock, [this]() { return !m_Running || !m_Queue.empty(); });
+            if (!m_Running) {
+                return;
+            }
+            job = std::move(m_Queue.front());
+            m_Queue.pop_front();
+        }
+        Process(job);
+    }
+}
+
+bool ShaderLibrary::TakeJob(ShaderVariantKey key, Job& job) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (auto it = m_Queue.begin(); it != m_Queue.end(); ++it) {
+        if (it->variant->GetKey() == key) {
+            job = std::move(*it);
+            m_Queue.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ShaderLibrary::Process(Job& job) {
+    const ShaderVariantKey key = job.variant->GetKey();
+    std::shared_ptr<Shader> shader;
+    bool fromDisk = false;
+
+    std::vector<uint8_t> binary;
+    if (LoadBinary(key, binary)) {
+        shader = m_RenderSystem.CreateShaderFromBinary(binary);
+        fromDisk = shader != nullptr;
+    }
+
+    if (!shader) {
+        const ShaderVariantDesc& desc = job.desc;
+        if (!desc.defines.empty() && (IsSpirvSource(desc.vertexSource) || IsSpirvSource(desc.fragmentSource))) {
+            std::cerr << "SPIR-V着色器不支持宏定义变体，请为每个变体预编译SPIR-V！" << std::endl;
+        } else {
+            shader = m_RenderSystem.CreateShader(ApplyDefines(desc.vertexSource, desc.defines),
+                                                 ApplyDefines(desc.fragmentSource, desc.defines));
+        }
+        if (shader && !m_Config.cacheDirectory.empty()) {
+            binary = m_RenderSystem.GetShaderBinary(shader);
+            if (!binary.empty()) {
+                SaveBinary(key, binary);
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!shader) {
+            ++m_Stats.failed;
+        } else if (fromDisk) {
+            ++m_Stats.diskHits;
+        } else {
+            ++m_Stats.compiled;
+        }
+    }
+    job.variant->Complete(std::move(shader));
+}
+
+std::string ShaderLibrary::GetCachePath(ShaderVariantKey key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return m_Config.cacheDirectory + "/" + name;
+}
+
+bool ShaderLibrary::LoadBinary(ShaderVariantKey key, std::vector<uint8_t>& binary) const {
+    if (m_Config.cacheDirectory.empty()) {
+        return false;
+    }
+    std::ifstream file(GetCachePath(key), std::ios::binary);
+    CacheHeader header;
+    if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return false;
+    }
+    if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.key != key ||
+        header.deviceHash != m_DeviceHash || header.size == 0 || header.size > (1ull << 30)) {
+        return false;
+    }
+    binary.resize(static_cast<size_t>(header.size));
+    if (!file.read(reinterpret_cast<char*>(binary.data()), static_cast<std::streamsize>(binary.size()))) {
+        return false;
+    }
+    return HashBytes(HASH_SEED, binary.data(), binary.size()) == header.checksum;
+}
+
+void ShaderLibrary::SaveBinary(ShaderVariantKey key, const std::vector<uint8_t>& binary) const {
+    CacheHeader header;
+    header.magic = CACHE_MAGIC;
+    header.version = CACHE_VERSION;
+    header.key = key;
+    header.deviceHash = m_DeviceHash;
+    header.size = binary.size();
+    header.checksum = HashBytes(HASH_SEED, binary.data(), binary.size());
+
+    // 先写临时文件再替换，避免进程中途退出留下损坏的缓存
+    const std::string path = GetCachePath(key);
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+            !file.write(reinterpret_cast<const char*>(binary.data()), static_cast<std::streamsize>(binary.size()))) {
+            std::cerr << "写入着色器缓存失败：" << temporaryPath << std::endl;
+            return;
+        }
+    }
+    std::remove(path.c_str());
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "保存着色器缓存失败：" << path << std::endl;
+    }
+}
+
+} // namespace PLE
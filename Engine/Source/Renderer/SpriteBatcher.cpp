@@ -0,0 +1,219 @@
+/**
+ * @file SpriteBatcher.cpp
+ * @brief 2D精灵批量渲染实现
+ */
+
+#include "Renderer/SpriteBatcher.h"
+#include "Renderer/RenderSystem.h"
+#include "Renderer/TextureAtlas.h"
+#include "Core/JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+
+namespace PLE {
+
+namespace {
+
+// 每个任务批次生成顶点的精灵数量
+constexpr uint32_t SPRITES_PER_JOB = 4096;
+
+int16_t EncodeTexCoord(float value) {
+    const float clamped = std::min(std::max(value, -1.0f), 1.0f);
+    return static_cast<int16_t>(std::lround(clamped * 32767.0f));
+}
+
+} // namespace
+
+void Sprite::SetRegion(const AtlasRegion& region) {
+    page = region.page;
+    uvRect = region.uvRect;
+}
+
+SpriteBatcher::SpriteBatcher(std::shared_ptr<Material> material, const std::string& textureParameter)
+    : m_Material(std::move(material))
+    , m_TextureParameter(textureParameter) {
+}
+
+SpriteBatcher::~SpriteBatcher() = default;
+
+const VertexLayout& SpriteBatcher::GetVertexLayout() {
+    static const VertexLayout layout = [] {
+        VertexLayout result;
+        result.attributes = {
+            { 0, VertexAttributeFormat::Float2, static_cast<uint32_t>(offsetof(SpriteVertex, x)) },
+            { 1, VertexAttributeFormat::Unorm8x4, static_cast<uint32_t>(offsetof(SpriteVertex, color)) },
+            { 2, VertexAttributeFormat::Snorm16x2, static_cast<uint32_t>(offsetof(SpriteVertex, u)) },
+        };
+        result.stride = sizeof(SpriteVertex);
+        return result;
+    }();
+    return layout;
+}
+
+void SpriteBatcher::SetPageTexture(uint32_t page, std::shared_ptr<Texture> texture) {
+    if (page >= m_PageTextures.size()) {
+        m_PageTextures.resize(page + 1);
+    }
+    m_PageTextures[page] = texture;
+    if (page < m_PageMaterials.size() && m_PageMaterials[page]) {
+        m_PageMaterials[page]->SetTexture(m_TextureParameter, texture);
+    }
+}
+
+void SpriteBatcher::SetAtlas(const TextureAtlas& atlas) {
+    for (uint32_t page = 0; page < atlas.GetPageCount(); ++page) {
+        if (atlas.GetPageTexture(page) != (page < m_PageTextures.size() ? m_PageTextures[page] : nullptr)) {
+            SetPageTexture(page, atlas.GetPageTexture(page));
+        }
+    }
+}
+
+void SpriteBatcher::Begin() {
+    m_Sprites.clear();
+}
+
+void SpriteBatcher::Draw(const Sprite* sprites, uint32_t count) {
+    m_Sprites.insert(m_Sprites.end(), sprites, sprites + count);
+}
+
+uint32_t SpriteBatcher::End(RenderSystem& renderSystem, const Matrix4& transform) {
+    const auto start = std::chrono::steady_clock::now();
+    m_Stats = SpriteBatchStats();
+    m_Stats.sprites = static_cast<uint32_t>(m_Sprites.size());
+    if (m_Sprites.empty() || !m_Material) {
+        return 0;
+    }
+
+    SortSprites();
+    BuildVertices();
+
+    // 四边形索引模式只依赖精灵数量，所有批次共用
+    uint32_t largest = 0;
+    for (const Batch& batch : m_Batches) {
+        largest = std::max(largest, batch.count);
+    }
+    for (uint32_t quad = static_cast<uint32_t>(m_Indices.size() / 6); quad < largest; ++quad) {
+        const uint32_t base = quad * 4;
+        m_Indices.insert(m_Indices.end(), { base, base + 1, base + 2, base + 2, base + 3, base });
+    }
+    m_Stats.buildMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    for (const Batch& batch : m_Batches) {
+        std::shared_ptr<Mesh> mesh = renderSystem.CreateTransientMesh(&m_Vertices[static_cast<size_t>(batch.first) * 4], batch.count * 4,
+                                                                      GetVertexLayout(), m_Indices.data(), batch.count * 6);
+        if (!mesh) {
+            m_Stats.droppedSprites += batch.count;
+            continue;
+        }
+        renderSystem.DrawMesh(mesh, GetPageMaterial(renderSystem, batch.page), transform);
+        ++m_Stats.drawCalls;
+    }
+    return m_Stats.drawCalls;
+}
+
+void SpriteBatcher::SortSprites() {
+    const uint32_t count = static_cast<uint32_t>(m_Sprites.size());
+    m_Keys.resize(count);
+    m_Order.resize(count);
+    m_KeyScratch.resize(count);
+    m_OrderScratch.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const Sprite& sprite = m_Sprites[i];
+        const uint32_t layer = static_cast<uint32_t>(static_cast<int32_t>(sprite.layer) + 32768);
+        m_Keys[i] = (layer << 16) | std::min(sprite.page, 0xFFFFu);
+        m_Order[i] = i;
+    }
+
+    // 按字节的LSD基数排序（稳定），所有键在某个字节上相同时跳过这一趟，
+    // 常见的单层单页面情况只需要统计直方图
+    for (uint32_t shift = 0; shift < 32; shift += 8) {
+        uint32_t histogram[256] = {};
+        for (uint32_t i = 0; i < count; ++i) {
+            ++histogram[(m_Keys[i] >> shift) & 0xFF];
+        }
+        if (histogram[(m_Keys[0] >> shift) & 0xFF] == count) {
+            continue;
+        }
+        uint32_t offset = 0;
+        for (uint32_t& bucket : histogram) {
+            const uint32_t size = bucket;
+            bucket = offset;
+            offset += size;
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint32_t destination = histogram[(m_Keys[i] >> shift) & 0xFF]++;
+            m_KeyScratch[destination] = m_Keys[i];
+            m_OrderScratch[destination] = m_Order[i];
+        }
+        m_Keys.swap(m_KeyScratch);
+        m_Order.swap(m_OrderScratch);
+    }
+
+    m_Batches.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        if (i == 0 || m_Keys[i] != m_Keys[i - 1]) {
+            m_Batches.push_back({ i, 0, m_Keys[i] & 0xFFFF });
+        }
+        ++m_Batches.back().count;
+    }
+}
+
+void SpriteBatcher::BuildVertices() {
+    const uint32_t count = static_cast<uint32_t>(m_Sprites.size());
+    m_Vertices.resize(static_cast<size_t>(count) * 4);
+    JobSystem::GetInstance().ParallelFor(count, SPRITES_PER_JOB, [this](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const Sprite& sprite = m_Sprites[m_Order[i]];
+            const float left = -sprite.pivot.x * sprite.size.x;
+            const float bottom = -sprite.pivot.y * sprite.size.y;
+            const float right = left + sprite.size.x;
+            const float top = bottom + sprite.size.y;
+            float cosine = 1.0f;
+            float sine = 0.0f;
+            if (sprite.rotation != 0.0f) {
+                cosine = std::cos(sprite.rotation);
+                sine = std::sin(sprite.rotation);
+            }
+            const int16_t u0 = EncodeTexCoord(sprite.uvRect.x);
+            const int16_t v0 = EncodeTexCoord(sprite.uvRect.y);
+            const int16_t u1 = EncodeTexCoord(sprite.uvRect.z);
+            const int16_t v1 = EncodeTexCoord(sprite.uvRect.w);
+
+            // 左上、左下、右下、右上（逆时针）
+            const float cornerX[4] = { left, left, right, right };
+            const float cornerY[4] = { top, bottom, bottom, top };
+            const int16_t cornerU[4] = { u0, u0, u1, u1 };
+            const int16_t cornerV[4] = { v0, v1, v1, v0 };
+            SpriteVertex* vertex = &m_Vertices[static_cast<size_t>(i) * 4];
+            for (int corner = 0; corner < 4; ++corner) {
+                vertex[corner].x = sprite.position.x + cornerX[corner] * cosine - cornerY[corner] * sine;
+                vertex[corner].y = sprite.position.y + cornerX[corner] * sine + cornerY[corner] * cosine;
+                vertex[corner].color = sprite.color;
+                vertex[corner].u = cornerU[corner];
+                vertex[corner].v = cornerV[corner];
+            }
+        }
+    });
+}
+
+std::shared_ptr<Material> SpriteBatcher::GetPageMaterial(RenderSystem& renderSystem, uint32_t page) {
+    if (page >= m_PageMaterials.size()) {
+        m_PageMaterials.resize(page + 1);
+    }
+    std::shared_ptr<Material>& material = m_PageMaterials[page];
+    if (!material) {
+        material = renderSystem.CreateMaterialInstance(m_Material);
+        if (!material) {
+            return m_Material;
+        }
+        if (page < m_PageTextures.size() && m_PageTextures[page]) {
+            material->SetTexture(m_TextureParameter, m_PageTextures[page]);
+        }
+    }
+    return material;
+}
+
+} // namespace PLE
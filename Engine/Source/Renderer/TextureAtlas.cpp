@@ -0,0 +1,270 @@
+/**
+ * @file TextureAtlas.cpp
+ * @brief 纹理图集实现
+ */
+
+#include "Renderer/TextureAtlas.h"
+#include "Renderer/RenderSystem.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace PLE {
+
+// ---------------------------------------------------------------------------
+// MaxRectsPacker
+// ---------------------------------------------------------------------------
+
+MaxRectsPacker::MaxRectsPacker(int width, int height)
+    : m_Width(width), m_Height(height) {
+    m_FreeRects.push_back({ 0, 0, width, height });
+}
+
+bool MaxRectsPacker::Insert(int width, int height, int& x, int& y) {
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+
+    // 最短边适配，短边相同时比较长边
+    int bestShort = std::numeric_limits<int>::max();
+    int bestLong = std::numeric_limits<int>::max();
+    const Rect* best = nullptr;
+    for (const Rect& free : m_FreeRects) {
+        if (free.width < width || free.height < height) {
+            continue;
+        }
+        const int leftoverX = free.width - width;
+        const int leftoverY = free.height - height;
+        const int shortSide = std::min(leftoverX, leftoverY);
+        const int longSide = std::max(leftoverX, leftoverY);
+        if (shortSide < bestShort || (shortSide == bestShort && longSide < bestLong)) {
+            bestShort = shortSide;
+            bestLong = longSide;
+            best = &free;
+        }
+    }
+    if (!best) {
+        return false;
+    }
+
+    const Rect used = { best->x, best->y, width, height };
+    SplitFreeRects(used);
+    PruneFreeRects();
+    m_UsedArea += static_cast<int64_t>(width) * height;
+    x = used.x;
+    y = used.y;
+    return true;
+}
+
+float MaxRectsPacker::GetOccupancy() const {
+    return static_cast<float>(static_cast<double>(m_UsedArea) / (static_cast<double>(m_Width) * m_Height));
+}
+
+void MaxRectsPacker::SplitFreeRects(const Rect& used) {
+    const size_t count = m_FreeRects.size();
+    for (size_t i = 0; i < count; ++i) {
+        const Rect free = m_FreeRects[i];
+        if (used.x >= free.x + free.width || used.x + used.width <= free.x ||
+            used.y >= free.y + free.height || used.y + used.height <= free.y) {
+            continue;
+        }
+
+        // 相交的空闲矩形在已占用矩形四周各留下一个极大矩形
+        if (used.x > free.x) {
+            m_FreeRects.push_back({ free.x, free.y, used.x - free.x, free.height });
+        }
+        if (used.x + used.width < free.x + free.width) {
+            m_FreeRects.push_back({ used.x + used.width, free.y, free.x + free.width - (used.x + used.width), free.height });
+        }
+        if (used.y > free.y) {
+            m_FreeRects.push_back({ free.x, free.y, free.width, used.y - free.y });
+        }
+        if (used.y + used.height < free.y + free.height) {
+            m_FreeRects.push_back({ free.x, used.y + used.height, free.width, free.y + free.height - (used.y + used.height) });
+        }
+        m_FreeRects[i].width = 0;   // 标记删除
+    }
+    m_FreeRects.erase(std::remove_if(m_FreeRects.begin(), m_FreeRects.end(), [](const Rect& rect) { return rect.width == 0; }),
+                      m_FreeRects.end());
+}
+
+void MaxRectsPacker::PruneFreeRects() {
+    const auto contains = [](const Rect& outer, const Rect& inner) {
+        return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.width <= outer.x + outer.width &&
+               inner.y + inner.height <= outer.y + outer.height;
+    };
+    for (size_t i = 0; i < m_FreeRects.size(); ++i) {
+        for (size_t j = i + 1; j < m_FreeRects.size();) {
+            if (contains(m_FreeRects[i], m_FreeRects[j])) {
+                m_FreeRects.erase(m_FreeRects.begin() + static_cast<std::ptrdiff_t>(j));
+            } else if (contains(m_FreeRects[j], m_FreeRects[i])) {
+                m_FreeRects.erase(m_FreeRects.begin() + static_cast<std::ptrdiff_t>(i));
+                --i;
+                break;
+            } else {
+                ++j;
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// TextureAtlas
+// ---------------------------------------------------------------------------
+
+TextureAtlas::TextureAtlas(const TextureAtlasConfig& config)
+    : m_Config(config) {
+    m_Config.padding = std::max(m_Config.padding, 0);
+}
+
+TextureAtlas::~TextureAtlas() = default;
+
+uint32_t TextureAtlas::Add(int width, int height, const void* rgba8) {
+    Image image;
+    image.width = std::max(width, 0);
+    image.height = std::max(height, 0);
+    if (rgba8 && width > 0 && height > 0) {
+        const auto* bytes = static_cast<const uint8_t*>(rgba8);
+        image.pixels.assign(bytes, bytes + static_cast<size_t>(width) * height * 4);
+    } else {
+        image.pixels.assign(static_cast<size_t>(image.width) * image.height * 4, 0);
+    }
+    m_Images.push_back(std::move(image));
+    return static_cast<uint32_t>(m_Images.size() - 1);
+}
+
+bool TextureAtlas::Pack() {
+    std::vector<uint32_t> pending;
+    for (uint32_t i = 0; i < m_Images.size(); ++i) {
+        if (m_Images[i].pending) {
+            pending.push_back(i);
+        }
+    }
+    // 先放大的图像，小图像填补剩下的空隙
+    std::stable_sort(pending.begin(), pending.end(), [this](uint32_t a, uint32_t b) {
+        const Image& first = m_Images[a];
+        const Image& second = m_Images[b];
+        const int longA = std::max(first.width, first.height);
+        const int longB = std::max(second.width, second.height);
+        if (longA != longB) {
+            return longA > longB;
+        }
+        return first.width * first.height > second.width * second.height;
+    });
+
+    bool success = true;
+    for (uint32_t index : pending) {
+        Image& image = m_Images[index];
+        image.pending = false;
+        if (!Place(image)) {
+            success = false;
+        }
+        image.pixels.clear();
+        image.pixels.shrink_to_fit();
+    }
+    return success;
+}
+
+bool TextureAtlas::Place(Image& image) {
+    // 每个图像占用(宽 + 间距) x (高 + 间距)的格子，图像位于格子右下角，
+    // 装箱区域比页面小一个间距，所以页面边缘和图像之间也都有间距
+    const int padding = m_Config.padding;
+    const int cellWidth = image.width + padding;
+    const int cellHeight = image.height + padding;
+    if (image.width == 0 || image.height == 0 || cellWidth > m_Config.pageWidth - padding ||
+        cellHeight > m_Config.pageHeight - padding) {
+        std::cerr << "图像尺寸超出图集页面：" << image.width << "x" << image.height << std::endl;
+        return false;
+    }
+
+    int x = 0;
+    int y = 0;
+    uint32_t page = 0;
+    for (; page < m_Pages.size(); ++page) {
+        if (m_Pages[page].packer.Insert(cellWidth, cellHeight, x, y)) {
+            break;
+        }
+    }
+    if (page == m_Pages.size()) {
+        if (m_Pages.size() >= m_Config.maxPages) {
+            std::cerr << "图集页面数已达上限：" << m_Config.maxPages << std::endl;
+            return false;
+        }
+        m_Pages.emplace_back(m_Config.pageWidth - padding, m_Config.pageHeight - padding);
+        m_Pages.back().pixels.assign(static_cast<size_t>(m_Config.pageWidth) * m_Config.pageHeight * 4, 0);
+        if (!m_Pages.back().packer.Insert(cellWidth, cellHeight, x, y)) {
+            return false;
+        }
+    }
+
+    AtlasRegion& region = image.region;
+    region.page = page;
+    region.x = x + padding;
+    region.y = y + padding;
+    region.width = image.width;
+    region.height = image.height;
+    const float inverseWidth = 1.0f / static_cast<float>(m_Config.pageWidth);
+    const float inverseHeight = 1.0f / static_cast<float>(m_Config.pageHeight);
+    region.uvRect = Vector4(region.x * inverseWidth, region.y * inverseHeight, (region.x + region.width) * inverseWidth,
+                            (region.y + region.height) * inverseHeight);
+
+    Page& target = m_Pages[page];
+    Blit(target, image);
+    target.dirty = true;
+    return true;
+}
+
+void TextureAtlas::Blit(Page& page, const Image& image) {
+    // 图像向四周各扩展半个间距，扩展的像素复制最近的边缘像素
+    const AtlasRegion& region = image.region;
+    const int extrude = m_Config.padding / 2;
+    const size_t pageStride = static_cast<size_t>(m_Config.pageWidth) * 4;
+    for (int row = -extrude; row < region.height + extrude; ++row) {
+        const int sourceRow = std::min(std::max(row, 0), region.height - 1);
+        const uint8_t* source = image.pixels.data() + static_cast<size_t>(sourceRow) * region.width * 4;
+        uint8_t* destination = page.pixels.data() + static_cast<size_t>(region.y + row) * pageStride + static_cast<size_t>(region.x) * 4;
+        std::memcpy(destination, source, static_cast<size_t>(region.width) * 4);
+        for (int column = 1; column <= extrude; ++column) {
+            std::memcpy(destination - column * 4, source, 4);
+            std::memcpy(destination + (region.width - 1 + column) * 4, source + (region.width - 1) * 4, 4);
+        }
+    }
+}
+
+TextureData TextureAtlas::GetPageData(uint32_t page) const {
+    TextureData data;
+    data.format = TextureFormat::RGBA8;
+    data.width = static_cast<uint32_t>(m_Config.pageWidth);
+    data.height = static_cast<uint32_t>(m_Config.pageHeight);
+    data.pixels = m_Pages[page].pixels;
+    TextureMipLevel level;
+    level.width = data.width;
+    level.height = data.height;
+    level.offset = 0;
+    level.size = data.pixels.size();
+    data.mips.push_back(level);
+    return data;
+}
+
+bool TextureAtlas::UploadPages(RenderSystem& renderSystem) {
+    bool success = true;
+    for (uint32_t page = 0; page < m_Pages.size(); ++page) {
+        Page& target = m_Pages[page];
+        if (!target.dirty) {
+            continue;
+        }
+        std::shared_ptr<Texture> texture = renderSystem.CreateTexture(GetPageData(page));
+        if (!texture) {
+            std::cerr << "图集页面上传失败：" << page << std::endl;
+            success = false;
+            continue;
+        }
+        target.texture = texture;
+        target.dirty = false;
+    }
+    return success;
+}
+
+} // namespace PLE
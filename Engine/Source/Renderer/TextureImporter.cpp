@@ -0,0 +1,527 @@
+/**
+ * @file TextureImporter.cpp
+ * @brief 纹理导入实现
+ */
+
+#include "Renderer/TextureImporter.h"
+#include "BlockCompression.h"
+#include "ImageDecoder.h"
+#include "Core/JobSystem.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <thread>
+
+#ifdef PLE_SIMD_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace PLE {
+
+namespace {
+
+constexpr uint32_t CACHE_MAGIC = 0x58544C50;    // "PLTX"
+constexpr uint32_t CACHE_VERSION = 1;           // 编码器或Mip生成改变时递增，使旧的缓存失效
+
+/**
+ * @brief 磁盘缓存文件头
+ */
+struct CacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint64_t size;
+    uint64_t checksum;
+};
+
+/**
+ * @brief 缓存中每级Mip的描述
+ */
+struct CachedMipLevel {
+    uint32_t width;
+    uint32_t height;
+    uint64_t offset;
+    uint64_t size;
+};
+
+uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+    // FNV-1a
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+constexpr uint64_t HASH_SEED = 0xcbf29ce484222325ull;
+
+// ---------------------------------------------------------------------------
+// sRGB转换
+// ---------------------------------------------------------------------------
+
+constexpr uint32_t LINEAR_TO_SRGB_SIZE = 16384;
+
+const float* GetSrgbToLinearTable() {
+    static const std::array<float, 256> table = []() {
+        std::array<float, 256> result;
+        for (uint32_t i = 0; i < 256; ++i) {
+            const float value = i / 255.0f;
+            result[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+        }
+        return result;
+    }();
+    return table.data();
+}
+
+const uint8_t* GetLinearToSrgbTable() {
+    static const std::vector<uint8_t> table = []() {
+        std::vector<uint8_t> result(LINEAR_TO_SRGB_SIZE);
+        for (uint32_t i = 0; i < LINEAR_TO_SRGB_SIZE; ++i) {
+            const float value = static_cast<float>(i) / (LINEAR_TO_SRGB_SIZE - 1);
+            const float encoded = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+            result[i] = static_cast<uint8_t>(std::lround(std::min(std::max(encoded, 0.0f), 1.0f) * 255.0f));
+        }
+        return result;
+    }();
+    return table.data();
+}
+
+bool IsSrgb(const TextureImportSettings& settings) {
+    return settings.srgb && !settings.normalMap;
+}
+
+void ConvertToFloat(const uint8_t* rgba, size_t pixelCount, bool srgb, float* output) {
+    const float* table = GetSrgbToLinearTable();
+    for (size_t i = 0; i < pixelCount * 4; ++i) {
+        output[i] = srgb && (i & 3) != 3 ? table[rgba[i]] : rgba[i] / 255.0f;
+    }
+}
+
+void ConvertToRgba8(const float* pixels, size_t pixelCount, bool srgb, uint8_t* output) {
+    const uint8_t* table = GetLinearToSrgbTable();
+    for (size_t i = 0; i < pixelCount * 4; ++i) {
+        if (srgb && (i & 3) != 3) {
+            output[i] = table[std::lround(pixels[i] * (LINEAR_TO_SRGB_SIZE - 1))];
+        } else {
+            output[i] = static_cast<uint8_t>(std::lround(pixels[i] * 255.0f));
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Mip降采样
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief 一维降采样核：每个目标像素固定数量的抽头（不足的用权重0补齐），源坐标已钳制到边缘
+ */
+struct FilterKernel {
+    uint32_t taps = 0;
+    std::vector<uint32_t> indices;
+    std::vector<float> weights;
+};
+
+float BesselI0(float x) {
+    // 零阶第一类修正贝塞尔函数的级数展开
+    float sum = 1.0f;
+    float term = 1.0f;
+    const float half = x * 0.5f;
+    for (int k = 1; k < 20; ++k) {
+        term *= half / k;
+        sum += term * term;
+    }
+    return sum;
+}
+
+float KaiserSinc(float t) {
+    constexpr float WIDTH = 1.5f;   // 半宽，以目标像素为单位
+    constexpr float ALPHA = 4.0f;
+    if (std::abs(t) >= WIDTH) {
+        return 0.0f;
+    }
+    const float pi = 3.14159265358979f;
+    const float sinc = std::abs(t) < 1e-5f ? 1.0f : std::sin(pi * t) / (pi * t);
+    const float x = t / WIDTH;
+    return sinc * BesselI0(ALPHA * std::sqrt(1.0f - x * x)) / BesselI0(ALPHA);
+}
+
+FilterKernel BuildKernel(uint32_t sourceSize, uint32_t destinationSize, TextureMipFilter filter) {
+    const float scale = static_cast<float>(sourceSize) / destinationSize;
+    const float radius = filter == TextureMipFilter::Box ? scale * 0.5f : scale * 1.5f;
+
+    FilterKernel kernel;
+    kernel.taps = static_cast<uint32_t>(std::ceil(radius * 2.0f)) + 2;
+    kernel.indices.assign(static_cast<size_t>(destinationSize) * kernel.taps, 0);
+    kernel.weights.assign(static_cast<size_t>(destinationSize) * kernel.taps, 0.0f);
+
+    for (uint32_t i = 0; i < destinationSize; ++i) {
+        const float center = (i + 0.5f) * scale;
+        const int first = static_cast<int>(std::floor(center - radius));
+        float total = 0.0f;
+        for (uint32_t tap = 0; tap < kernel.taps; ++tap) {
+            const int source = first + static_cast<int>(tap);
+            float weight = 0.0f;
+            if (filter == TextureMipFilter::Box) {
+                // 源像素[source, source + 1)与目标像素覆盖范围的重叠长度
+                const float overlap = std::min(source + 1.0f, center + radius) - std::max(static_cast<float>(source), center - radius);
+                weight = std::max(overlap, 0.0f);
+            } else {
+                weight = KaiserSinc((source + 0.5f - center) / scale);
+            }
+            const size_t slot = static_cast<size_t>(i) * kernel.taps + tap;
+            kernel.indices[slot] = static_cast<uint32_t>(std::min(std::max(source, 0), static_cast<int>(sourceSize) - 1));
+            kernel.weights[slot] = weight;
+            total += weight;
+        }
+        for (uint32_t tap = 0; tap < kernel.taps; ++tap) {
+            kernel.weights[static_cast<size_t>(i) * kernel.taps + tap] /= total;
+        }
+    }
+    return kernel;
+}
+
+/**
+ * @brief output += weight * input，按float4处理
+ */
+inline void AccumulateRow(const float* input, float weight, float* output, uint32_t pixelCount) {
+#ifdef PLE_SIMD_SSE2
+    const __m128 scale = _mm_set1_ps(weight);
+    for (uint32_t i = 0; i < pixelCount; ++i) {
+        _mm_storeu_ps(output + i * 4, _mm_add_ps(_mm_loadu_ps(output + i * 4), _mm_mul_ps(_mm_loadu_ps(input + i * 4), scale)));
+    }
+#else
+    for (uint32_t i = 0; i < pixelCount * 4; ++i) {
+        output[i] += input[i] * weight;
+    }
+#endif
+}
+
+/**
+ * @brief 钳制到[0, 1]，法线贴图重新归一化
+ */
+void ResolveRow(float* pixels, uint32_t pixelCount, bool normalMap) {
+#ifdef PLE_SIMD_SSE2
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (uint32_t i = 0; i < pixelCount; ++i) {
+        _mm_storeu_ps(pixels + i * 4, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(pixels + i * 4), zero), one));
+    }
+#else
+    for (uint32_t i = 0; i < pixelCount * 4; ++i) {
+        pixels[i] = std::min(std::max(pixels[i], 0.0f), 1.0f);
+    }
+#endif
+    if (!normalMap) {
+        return;
+    }
+    for (uint32_t i = 0; i < pixelCount; ++i) {
+        float* pixel = pixels + i * 4;
+        const float x = pixel[0] * 2.0f - 1.0f;
+        const float y = pixel[1] * 2.0f - 1.0f;
+        const float z = pixel[2] * 2.0f - 1.0f;
+        const float length = std::sqrt(x * x + y * y + z * z);
+        if (length > 1e-6f) {
+            pixel[0] = x / length * 0.5f + 0.5f;
+            pixel[1] = y / length * 0.5f + 0.5f;
+            pixel[2] = z / length * 0.5f + 0.5f;
+        }
+    }
+}
+
+/**
+ * @brief 把上一级Mip降采样为下一级：先横向再纵向，行分配到工作线程
+ */
+void Downsample(const std::vector<float>& source, uint32_t sourceWidth, uint32_t sourceHeight, std::vector<float>& destination,
+                uint32_t destinationWidth, uint32_t destinationHeight, const TextureImportSettings& settings) {
+    const FilterKernel horizontal = BuildKernel(sourceWidth, destinationWidth, settings.mipFilter);
+    const FilterKernel vertical = BuildKernel(sourceHeight, destinationHeight, settings.mipFilter);
+
+    std::vector<float> temporary(static_cast<size_t>(destinationWidth) * sourceHeight * 4);
+    JobSystem::GetInstance().ParallelFor(sourceHeight, 16, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t y = begin; y < end; ++y) {
+            const float* row = source.data() + static_cast<size_t>(y) * sourceWidth * 4;
+            float* output = temporary.data() + static_cast<size_t>(y) * destinationWidth * 4;
+            for (uint32_t x = 0; x < destinationWidth; ++x) {
+                const uint32_t* indices = horizontal.indices.data() + static_cast<size_t>(x) * horizontal.taps;
+                const float* weights = horizontal.weights.data() + static_cast<size_t>(x) * horizontal.taps;
+#ifdef PLE_SIMD_SSE2
+                __m128 sum = _mm_setzero_ps();
+                for (uint32_t tap = 0; tap < horizontal.taps; ++tap) {
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(row + indices[tap] * 4), _mm_set1_ps(weights[tap])));
+                }
+                _mm_storeu_ps(output + x * 4, sum);
+#else
+                float sum[4] = {};
+                for (uint32_t tap = 0; tap < horizontal.taps; ++tap) {
+                    for (int c = 0; c < 4; ++c) {
+                        sum[c] += row[indices[tap] * 4 + c] * weights[tap];
+                    }
+                }
+                std::memcpy(output + x * 4, sum, sizeof(sum));
+#endif
+            }
+        }
+    });
+
+    destination.assign(static_cast<size_t>(destinationWidth) * destinationHeight * 4, 0.0f);
+    JobSystem::GetInstance().ParallelFor(destinationHeight, 8, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t y = begin; y < end; ++y) {
+            float* output = destination.data() + static_cast<size_t>(y) * destinationWidth * 4;
+            for (uint32_t tap = 0; tap < vertical.taps; ++tap) {
+                const float weight = vertical.weights[static_cast<size_t>(y) * vertical.taps + tap];
+                if (weight != 0.0f) {
+                    const uint32_t row = vertical.indices[static_cast<size_t>(y) * vertical.taps + tap];
+                    AccumulateRow(temporary.data() + static_cast<size_t>(row) * destinationWidth * 4, weight, output, destinationWidth);
+                }
+            }
+            ResolveRow(output, destinationWidth, settings.normalMap);
+        }
+    });
+}
+
+} // namespace
+
+TextureImporter::TextureImporter(const TextureImporterConfig& config)
+    : m_Config(config) {
+    if (!m_Config.cacheDirectory.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(m_Config.cacheDirectory, error);
+        if (error) {
+            std::cerr << "创建纹理缓存目录失败：" << m_Config.cacheDirectory << std::endl;
+            m_Config.cacheDirectory.clear();
+        }
+    }
+}
+
+bool TextureImporter::Import(const std::string& path, const TextureImportSettings& settings, TextureData& output) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "打开纹理文件失败：" << path << std::endl;
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ++m_Stats.failed;
+        return false;
+    }
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    // 键包含文件内容和所有导入设置
+    const uint32_t fields[5] = { static_cast<uint32_t>(settings.format), settings.generateMips ? 1u : 0u,
+                                 static_cast<uint32_t>(settings.mipFilter), settings.srgb ? 1u : 0u,
+                                 settings.normalMap ? 1u : 0u };
+    uint64_t key = HashBytes(HASH_SEED, bytes.data(), bytes.size());
+    key = HashBytes(key, fields, sizeof(fields));
+
+    if (LoadCooked(key, output)) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ++m_Stats.imported;
+        ++m_Stats.cacheHits;
+        return true;
+    }
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixels;
+    const bool cooked = ImageDecoder::Decode(bytes.data(), bytes.size(), width, height, pixels) &&
+                        Cook(pixels.data(), width, height, settings, output);
+    if (!cooked) {
+        std::cerr << "导入纹理失败：" << path << std::endl;
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ++m_Stats.failed;
+        return false;
+    }
+    SaveCooked(key, output);
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    ++m_Stats.imported;
+    return true;
+}
+
+bool TextureImporter::ImportBatch(const std::vector<std::string>& paths, const TextureImportSettings& settings,
+                                  std::vector<TextureData>& outputs) {
+    outputs.assign(paths.size(), TextureData());
+    std::atomic<bool> succeeded{ true };
+    // 每个文件一个批次；Mip生成和压缩内部的ParallelFor嵌套执行，空闲线程会帮忙处理大纹理
+    JobSystem::GetInstance().ParallelFor(static_cast<uint32_t>(paths.size()), 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            if (!Import(paths[i], settings, outputs[i])) {
+                outputs[i] = TextureData();
+                succeeded.store(false, std::memory_order_relaxed);
+            }
+        }
+    });
+    return succeeded.load();
+}
+
+bool TextureImporter::Cook(const uint8_t* rgba, uint32_t width, uint32_t height, const TextureImportSettings& settings,
+                           TextureData& output) {
+    if (!rgba || width == 0 || height == 0) {
+        std::cerr << "纹理图像数据无效！" << std::endl;
+        return false;
+    }
+
+    uint32_t levelCount = 1;
+    if (settings.generateMips) {
+        for (uint32_t size = std::max(width, height); size > 1; size >>= 1) {
+            ++levelCount;
+        }
+    }
+
+    output = TextureData();
+    output.format = settings.format;
+    output.width = width;
+    output.height = height;
+    size_t totalSize = 0;
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        TextureMipLevel mip;
+        mip.width = std::max(width >> level, 1u);
+        mip.height = std::max(height >> level, 1u);
+        mip.offset = totalSize;
+        mip.size = TextureData::GetLevelSize(settings.format, mip.width, mip.height);
+        totalSize += mip.size;
+        output.mips.push_back(mip);
+    }
+    output.pixels.resize(totalSize);
+
+    // 第0级直接使用输入，之后每级由上一级的浮点结果降采样，避免反复量化
+    const bool srgb = IsSrgb(settings);
+    std::vector<float> current;
+    std::vector<float> next;
+    std::vector<uint8_t> levelPixels;
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        const TextureMipLevel& mip = output.mips[level];
+        const size_t pixelCount = static_cast<size_t>(mip.width) * mip.height;
+        const uint8_t* source = rgba;
+        if (level > 0) {
+            const TextureMipLevel& previous = output.mips[level - 1];
+            if (level == 1) {
+                current.resize(static_cast<size_t>(width) * height * 4);
+                ConvertToFloat(rgba, static_cast<size_t>(width) * height, srgb, current.data());
+            }
+            Downsample(current, previous.width, previous.height, next, mip.width, mip.height, settings);
+            current.swap(next);
+            levelPixels.resize(pixelCount * 4);
+            ConvertToRgba8(current.data(), pixelCount, srgb, levelPixels.data());
+            source = levelPixels.data();
+        }
+
+        uint8_t* destination = output.pixels.data() + mip.offset;
+        if (TextureData::IsCompressed(settings.format)) {
+            BlockCompression::CompressImage(settings.format, source, mip.width, mip.height, destination);
+        } else {
+            std::memcpy(destination, source, pixelCount * 4);
+        }
+    }
+    return true;
+}
+
+TextureImporterStats TextureImporter::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Stats;
+}
+
+std::string TextureImporter::GetCachePath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return m_Config.cacheDirectory + "/" + name;
+}
+
+bool TextureImporter::LoadCooked(uint64_t key, TextureData& output) const {
+    if (m_Config.cacheDirectory.empty()) {
+        return false;
+    }
+    std::ifstream file(GetCachePath(key), std::ios::binary);
+    CacheHeader header;
+    if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return false;
+    }
+    if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.key != key ||
+        header.size < sizeof(uint32_t) * 4 || header.size > (1ull << 32)) {
+        return false;
+    }
+    std::vector<uint8_t> payload(static_cast<size_t>(header.size));
+    if (!file.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payload.size())) ||
+        HashBytes(HASH_SEED, payload.data(), payload.size()) != header.checksum) {
+        return false;
+    }
+
+    uint32_t fields[4];
+    std::memcpy(fields, payload.data(), sizeof(fields));
+    const size_t mipsSize = static_cast<size_t>(fields[3]) * sizeof(CachedMipLevel);
+    if (fields[0] > static_cast<uint32_t>(TextureFormat::BC7) || fields[3] > 32 || payload.size() - sizeof(fields) < mipsSize) {
+        return false;
+    }
+    TextureData data;
+    data.format = static_cast<TextureFormat>(fields[0]);
+    data.width = fields[1];
+    data.height = fields[2];
+    for (uint32_t i = 0; i < fields[3]; ++i) {
+        CachedMipLevel cached;
+        std::memcpy(&cached, payload.data() + sizeof(fields) + i * sizeof(cached), sizeof(cached));
+        TextureMipLevel mip;
+        mip.width = cached.width;
+        mip.height = cached.height;
+        mip.offset = static_cast<size_t>(cached.offset);
+        mip.size = static_cast<size_t>(cached.size);
+        data.mips.push_back(mip);
+    }
+    data.pixels.assign(payload.begin() + static_cast<std::ptrdiff_t>(sizeof(fields) + mipsSize), payload.end());
+    if (!data.IsValid()) {
+        return false;
+    }
+    output = std::move(data);
+    return true;
+}
+
+void TextureImporter::SaveCooked(uint64_t key, const TextureData& data) const {
+    if (m_Config.cacheDirectory.empty()) {
+        return;
+    }
+    const uint32_t fields[4] = { static_cast<uint32_t>(data.format), data.width, data.height,
+                                 static_cast<uint32_t>(data.mips.size()) };
+    std::vector<uint8_t> payload(sizeof(fields) + data.mips.size() * sizeof(CachedMipLevel) + data.pixels.size());
+    std::memcpy(payload.data(), fields, sizeof(fields));
+    for (size_t i = 0; i < data.mips.size(); ++i) {
+        const CachedMipLevel cached = { data.mips[i].width, data.mips[i].height, data.mips[i].offset, data.mips[i].size };
+        std::memcpy(payload.data() + sizeof(fields) + i * sizeof(cached), &cached, sizeof(cached));
+    }
+    if (!data.pixels.empty()) {
+        std::memcpy(payload.data() + sizeof(fields) + data.mips.size() * sizeof(CachedMipLevel), data.pixels.data(), data.pixels.size());
+    }
+
+    CacheHeader header;
+    header.magic = CACHE_MAGIC;
+    header.version = CACHE_VERSION;
+    header.key = key;
+    header.size = payload.size();
+    header.checksum = HashBytes(HASH_SEED, payload.data(), payload.size());
+
+    // 先写临时文件再替换，避免进程中途退出留下损坏的缓存；同一文件被并行导入时临时文件名不能相同
+    const std::string path = GetCachePath(key);
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), ".%zx.tmp", std::hash<std::thread::id>()(std::this_thread::get_id()));
+    const std::string temporaryPath = path + suffix;
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+            !file.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()))) {
+            std::cerr << "写入纹理缓存失败：" << temporaryPath << std::endl;
+            return;
+        }
+    }
+    std::remove(path.c_str());
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "保存纹理缓存失败：" << path << std::endl;
+        std::remove(temporaryPath.c_str());
+    }
+}
+
+} // namespace PLE
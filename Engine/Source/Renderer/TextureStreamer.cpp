@@ -0,0 +1,440 @@
+/**
+ * @file TextureStreamer.cpp
+ * @brief 纹理Mip流式加载实现
+ */
+
+#include "Renderer/TextureStreamer.h"
+#include "Renderer/RenderSystem.h"
+#include "Core/JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <queue>
+
+namespace PLE {
+
+namespace {
+
+uint32_t FloatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+float BitsToFloat(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// 原子地取最小值/最大值；非负浮点数的位模式与数值同序
+void AtomicMin(std::atomic<uint32_t>& target, uint32_t value) {
+    uint32_t current = target.load(std::memory_order_relaxed);
+    while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+void AtomicMax(std::atomic<uint32_t>& target, uint32_t value) {
+    uint32_t current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+TextureStreamer::TextureStreamer(RenderSystem& renderSystem, const TextureStreamerConfig& config)
+    : m_RenderSystem(renderSystem)
+    , m_Config(config) {
+}
+
+TextureStreamer::~TextureStreamer() {
+    for (const std::unique_ptr<Entry>& entry : m_Entries) {
+        if (entry) {
+            WaitPending(*entry);
+        }
+    }
+}
+
+StreamedTextureHandle TextureStreamer::Register(const StreamedTextureDesc& desc) {
+    if (desc.width == 0 || desc.height == 0 || desc.mipCount == 0 || !desc.loader) {
+        std::cerr << "流式纹理描述无效！" << std::endl;
+        return InvalidStreamedTexture;
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->desc = desc;
+    while (entry->tailMip + 1 < desc.mipCount &&
+           std::max(desc.width >> entry->tailMip, desc.height >> entry->tailMip) > m_Config.residentTailSize) {
+        ++entry->tailMip;
+    }
+    entry->residentMip = entry->tailMip;
+    entry->targetMip = entry->tailMip;
+    entry->recentMip = entry->tailMip;
+    entry->recentFrame = m_Frame;
+
+    TextureData data;
+    if (!desc.loader(entry->tailMip, data) || !Install(*entry, data, entry->tailMip)) {
+        std::cerr << "加载流式纹理的常驻Mip失败！" << std::endl;
+        return InvalidStreamedTexture;
+    }
+
+    uint32_t slot;
+    if (!m_FreeSlots.empty()) {
+        slot = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+        m_Entries[slot] = std::move(entry);
+    } else {
+        slot = static_cast<uint32_t>(m_Entries.size());
+        m_Entries.push_back(std::move(entry));
+    }
+    return slot + 1;
+}
+
+StreamedTextureHandle TextureStreamer::Register(std::shared_ptr<const TextureData> data, float priority) {
+    if (!data || !data->IsValid()) {
+        std::cerr << "流式纹理数据无效！" << std::endl;
+        return InvalidStreamedTexture;
+    }
+
+    StreamedTextureDesc desc;
+    desc.format = data->format;
+    desc.width = data->width;
+    desc.height = data->height;
+    desc.mipCount = static_cast<uint32_t>(data->mips.size());
+    desc.priority = priority;
+    desc.loader = [data](uint32_t firstMip, TextureData& output) {
+        if (firstMip >= data->mips.size()) {
+            return false;
+        }
+        const size_t begin = data->mips[firstMip].offset;
+        output.format = data->format;
+        output.width = data->mips[firstMip].width;
+        output.height = data->mips[firstMip].height;
+        output.mips.assign(data->mips.begin() + firstMip, data->mips.end());
+        for (TextureMipLevel& mip : output.mips) {
+            mip.offset -= begin;
+        }
+        output.pixels.assign(data->pixels.begin() + begin, data->pixels.end());
+        return true;
+    };
+    return Register(desc);
+}
+
+void TextureStreamer::Unregister(StreamedTextureHandle handle) {
+    Entry* entry = Find(handle);
+    if (!entry) {
+        return;
+    }
+    WaitPending(*entry);
+    m_Retired.push_back({ entry->texture, m_Frame });
+    m_Entries[handle - 1].reset();
+    m_FreeSlots.push_back(handle - 1);
+}
+
+void TextureStreamer::Bind(StreamedTextureHandle handle, const std::shared_ptr<Material>& material, const std::string& name) {
+    Entry* entry = Find(handle);
+    if (!entry || !material) {
+        return;
+    }
+    material->SetTexture(name, entry->texture);
+    entry->bindings.push_back({ material, name });
+}
+
+void TextureStreamer::ReportUsage(StreamedTextureHandle handle, float pixelsPerUV) {
+    Entry* entry = Find(handle);
+    if (!entry) {
+        return;
+    }
+
+    uint32_t mip = entry->tailMip;
+    if (pixelsPerUV > 0.0f) {
+        const float size = static_cast<float>(std::max(entry->desc.width, entry->desc.height));
+        const float level = std::floor(std::log2(size / pixelsPerUV) + m_Config.mipBias);
+        mip = static_cast<uint32_t>(std::clamp(level, 0.0f, static_cast<float>(entry->tailMip)));
+        AtomicMax(entry->reportedPixels, FloatBits(pixelsPerUV));
+    }
+    AtomicMin(entry->reportedMip, mip);
+}
+
+void TextureStreamer::Update() {
+    ++m_Frame;
+
+    const uint64_t framesInFlight = m_RenderSystem.GetFramesInFlight();
+    m_Retired.erase(std::remove_if(m_Retired.begin(), m_Retired.end(),
+                                   [&](const RetiredTexture& retired) { return m_Frame - retired.frame > framesInFlight; }),
+                    m_Retired.end());
+
+    CollectReports();
+    AssignTargets();
+    FinishLoads();
+    StartLoads();
+}
+
+std::shared_ptr<Texture> TextureStreamer::GetTexture(StreamedTextureHandle handle) const {
+    Entry* entry = Find(handle);
+    return entry ? entry->texture : nullptr;
+}
+
+uint32_t TextureStreamer::GetResidentMip(StreamedTextureHandle handle) const {
+    Entry* entry = Find(handle);
+    return entry ? entry->residentMip : 0;
+}
+
+uint32_t TextureStreamer::GetTargetMip(StreamedTextureHandle handle) const {
+    Entry* entry = Find(handle);
+    return entry ? entry->targetMip : 0;
+}
+
+TextureStreamerStats TextureStreamer::GetStats() const {
+    TextureStreamerStats stats = m_Stats;
+    stats.textureCount = 0;
+    stats.pendingLoads = 0;
+    stats.residentBytes = 0;
+    stats.requestedBytes = 0;
+    for (const std::unique_ptr<Entry>& entry : m_Entries) {
+        if (!entry) {
+            continue;
+        }
+        ++stats.textureCount;
+        stats.pendingLoads += entry->pending ? 1 : 0;
+        stats.residentBytes += GetMipChainSize(*entry, entry->residentMip);
+        stats.requestedBytes += GetMipChainSize(*entry, entry->recentMip);
+    }
+    return stats;
+}
+
+float TextureStreamer::ComputeUVDensity(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) {
+    if (!vertices) {
+        return 0.0f;
+    }
+
+    const uint32_t count = indices ? indexCount : vertexCount;
+    double worldArea = 0.0;
+    double uvArea = 0.0;
+    for (uint32_t i = 0; i + 2 < count; i += 3) {
+        const uint32_t i0 = indices ? indices[i] : i;
+        const uint32_t i1 = indices ? indices[i + 1] : i + 1;
+        const uint32_t i2 = indices ? indices[i + 2] : i + 2;
+        if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount) {
+            continue;
+        }
+        const Vertex& a = vertices[i0];
+        const Vertex& b = vertices[i1];
+        const Vertex& c = vertices[i2];
+        worldArea += 0.5 * (b.position - a.position).Cross(c.position - a.position).Length();
+        const Vector2 uv1 = b.texCoord - a.texCoord;
+        const Vector2 uv2 = c.texCoord - a.texCoord;
+        uvArea += 0.5 * std::fabs(uv1.x * uv2.y - uv1.y * uv2.x);
+    }
+    return uvArea > 0.0 ? static_cast<float>(std::sqrt(worldArea / uvArea)) : 0.0f;
+}
+
+float TextureStreamer::ComputePixelsPerUV(float uvDensity, float distance, const Matrix4& projection, float viewportHeight) {
+    // 距离distance处一个世界单位在屏幕上占 projection(1, 1) * viewportHeight / (2 * distance) 像素
+    distance = std::max(distance, 1e-3f);
+    return uvDensity * std::fabs(projection(1, 1)) * viewportHeight * 0.5f / distance;
+}
+
+TextureStreamer::Entry* TextureStreamer::Find(StreamedTextureHandle handle) const {
+    if (handle == InvalidStreamedTexture || handle > m_Entries.size()) {
+        return nullptr;
+    }
+    return m_Entries[handle - 1].get();
+}
+
+uint64_t TextureStreamer::GetMipChainSize(const Entry& entry, uint32_t firstMip) const {
+    uint64_t size = 0;
+    for (uint32_t mip = firstMip; mip < entry.desc.mipCount; ++mip) {
+        size += TextureData::GetLevelSize(entry.desc.format, std::max(entry.desc.width >> mip, 1u),
+                                          std::max(entry.desc.height >> mip, 1u));
+    }
+    return size;
+}
+
+void TextureStreamer::CollectReports() {
+    for (const std::unique_ptr<Entry>& entry : m_Entries) {
+        if (!entry) {
+            continue;
+        }
+
+        const uint32_t reported = entry->reportedMip.exchange(UINT32_MAX, std::memory_order_relaxed);
+        const float pixels = BitsToFloat(entry->reportedPixels.exchange(0, std::memory_order_relaxed));
+        const bool expired = m_Frame - entry->recentFrame > m_Config.dropDelayFrames;
+        if (reported != UINT32_MAX) {
+            // 更清晰的请求立即生效，更模糊的请求等到之前的请求过期
+            if (reported <= entry->recentMip || expired) {
+                entry->recentMip = reported;
+                entry->recentFrame = m_Frame;
+            }
+            entry->priority = pixels * entry->desc.priority;
+        } else if (expired) {
+            entry->recentMip = entry->tailMip;
+            entry->priority = 0.0f;
+        }
+    }
+}
+
+void TextureStreamer::AssignTargets() {
+    uint64_t total = 0;
+    for (const std::unique_ptr<Entry>& entry : m_Entries) {
+        if (entry) {
+            entry->targetMip = entry->recentMip;
+            total += GetMipChainSize(*entry, entry->targetMip);
+        }
+    }
+    if (total <= m_Config.memoryBudget) {
+        return;
+    }
+
+    // 每次去掉代价最小的一级：代价为优先级乘以2的（已降低级数）次方，
+    // 同一张纹理降得越多，再降一级的代价越高
+    using Candidate = std::pair<float, uint32_t>;
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> candidates;
+    for (uint32_t i = 0; i < m_Entries.size(); ++i) {
+        const Entry* entry = m_Entries[i].get();
+        if (entry && entry->targetMip < entry->tailMip) {
+            candidates.push({ entry->priority, i });
+        }
+    }
+
+    while (total > m_Config.memoryBudget && !candidates.empty()) {
+        const Candidate candidate = candidates.top();
+        candidates.pop();
+        Entry& entry = *m_Entries[candidate.second];
+        total -= GetMipChainSize(entry, entry.targetMip) - GetMipChainSize(entry, entry.targetMip + 1);
+        ++entry.targetMip;
+        if (entry.targetMip < entry.tailMip) {
+            candidates.push({ candidate.first * 2.0f, candidate.second });
+        }
+    }
+}
+
+void TextureStreamer::FinishLoads() {
+    std::vector<Entry*> ready;
+    for (const std::unique_ptr<Entry>& entry : m_Entries) {
+        if (entry && entry->pending &&
+            entry->pending->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            ready.push_back(entry.get());
+        }
+    }
+    std::sort(ready.begin(), ready.end(), [](const Entry* a, const Entry* b) { return a->priority > b->priority; });
+
+    uint64_t uploaded = 0;
+    for (Entry* entry : ready) {
+        PendingLoad& pending = *entry->pending;
+        const uint64_t size = pending.data->pixels.size();
+        if (uploaded > 0 && uploaded + size > m_Config.uploadBytesPerUpdate) {
+            continue;
+        }
+        if (*pending.succeeded && Install(*entry, *pending.data, pending.firstMip)) {
+            uploaded += size;
+        } else {
+            ++m_Stats.failedLoads;
+        }
+        entry->pending.reset();
+    }
+}
+
+void TextureStreamer::StartLoads() {
+    uint32_t pendingCount = 0;
+    uint64_t committed = 0;
+    std::vector<Entry*> candidates;
+    for (const std::unique_ptr<Entry>& entry : m_Entries) {
+        if (!entry) {
+            continue;
+        }
+        uint64_t size = GetMipChainSize(*entry, entry->residentMip);
+        if (entry->pending) {
+            ++pendingCount;
+            size = std::max(size, GetMipChainSize(*entry, entry->pending->firstMip));
+        } else if (entry->targetMip != entry->residentMip) {
+            candidates.push_back(entry.get());
+        }
+        committed += size;
+    }
+
+    // 先降低清晰度以释放预算，再按优先级提高清晰度
+    std::sort(candidates.begin(), candidates.end(), [](const Entry* a, const Entry* b) {
+        const bool dropA = a->targetMip > a->residentMip;
+        const bool dropB = b->targetMip > b->residentMip;
+        if (dropA != dropB) {
+            return dropA;
+        }
+        return a->priority > b->priority;
+    });
+
+    for (Entry* entry : candidates) {
+        if (pendingCount >= m_Config.maxPendingLoads) {
+            break;
+        }
+        if (entry->targetMip < entry->residentMip) {
+            const uint64_t growth = GetMipChainSize(*entry, entry->targetMip) - GetMipChainSize(*entry, entry->residentMip);
+            if (committed + growth > m_Config.memoryBudget) {
+                continue;
+            }
+            committed += growth;
+        }
+        StartLoad(*entry, entry->targetMip);
+        ++pendingCount;
+    }
+}
+
+void TextureStreamer::StartLoad(Entry& entry, uint32_t firstMip) {
+    auto pending = std::make_unique<PendingLoad>();
+    pending->firstMip = firstMip;
+    pending->data = std::make_shared<TextureData>();
+    pending->succeeded = std::make_shared<bool>(false);
+
+    // 任务只持有数据和加载函数的副本，注销或析构时会等待它结束
+    std::shared_ptr<TextureData> data = pending->data;
+    std::shared_ptr<bool> succeeded = pending->succeeded;
+    TextureMipLoader loader = entry.desc.loader;
+    pending->future = JobSystem::GetInstance().Submit([loader, firstMip, data, succeeded]() {
+        *succeeded = loader(firstMip, *data);
+    });
+    entry.pending = std::move(pending);
+}
+
+bool TextureStreamer::Install(Entry& entry, const TextureData& data, uint32_t firstMip) {
+    const StreamedTextureDesc& desc = entry.desc;
+    if (!data.IsValid() || data.format != desc.format || data.mips.size() != desc.mipCount - firstMip ||
+        data.width != std::max(desc.width >> firstMip, 1u) || data.height != std::max(desc.height >> firstMip, 1u)) {
+        std::cerr << "流式纹理加载的Mip与描述不一致！" << std::endl;
+        return false;
+    }
+
+    std::shared_ptr<Texture> texture = m_RenderSystem.CreateTexture(data);
+    if (!texture) {
+        return false;
+    }
+
+    if (entry.texture) {
+        m_Retired.push_back({ entry.texture, m_Frame });
+        if (firstMip < entry.residentMip) {
+            m_Stats.loadedMips += entry.residentMip - firstMip;
+        } else {
+            m_Stats.droppedMips += firstMip - entry.residentMip;
+        }
+    }
+    entry.texture = texture;
+    entry.residentMip = firstMip;
+
+    entry.bindings.erase(std::remove_if(entry.bindings.begin(), entry.bindings.end(),
+                                        [](const Binding& binding) { return binding.material.expired(); }),
+                         entry.bindings.end());
+    for (const Binding& binding : entry.bindings) {
+        binding.material.lock()->SetTexture(binding.name, texture);
+    }
+    return true;
+}
+
+void TextureStreamer::WaitPending(Entry& entry) {
+    if (entry.pending && entry.pending->future.valid()) {
+        entry.pending->future.wait();
+    }
+    entry.pending.reset();
+}
+
+} // namespace PLE
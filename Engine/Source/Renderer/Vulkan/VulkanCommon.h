@@ -0,0 +1,66 @@
+/**
+ * @file VulkanCommon.h
+ * @brief Vulkan后端公共头文件
+ */
+
+#pragma once
+
+#include "PhantomLightEngine.h"
+
+#ifdef PLE_RENDERER_VULKAN
+
+#ifdef PLE_PLATFORM_WINDOWS
+    #ifndef VK_USE_PLATFORM_WIN32_KHR
+        #define VK_USE_PLATFORM_WIN32_KHR
+    #endif
+#endif
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <iostream>
+
+namespace PLE {
+
+// 同时在途的帧数
+constexpr uint32_t VULKAN_FRAMES_IN_FLIGHT = 2;
+
+// 材质描述符集中的纹理绑定数量（绑定1..N）
+constexpr uint32_t VULKAN_MAX_MATERIAL_TEXTURES = 8;
+
+/**
+ * @brief 检查Vulkan调用结果，失败时输出错误
+ * @param result 调用返回值
+ * @param operation 操作描述
+ * @return 是否成功
+ */
+inline bool VulkanCheck(VkResult result, const char* operation) {
+    if (result != VK_SUCCESS) {
+        std::cerr << operation << "失败！VkResult：" << static_cast<int>(result) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 录制图像布局转换屏障
+ */
+inline void VulkanImageBarrier(VkCommandBuffer commandBuffer, VkImage image, VkImageAspectFlags aspect, uint32_t baseMip, uint32_t mipCount,
+                               VkImageLayout oldLayout, VkImageLayout newLayout,
+                               VkPipelineStageFlags srcStage, VkAccessFlags srcAccess,
+                               VkPipelineStageFlags dstStage, VkAccessFlags dstAccess) {
+    VkImageMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstAccessMask = dstAccess;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange = { aspect, baseMip, mipCount, 0, 1 };
+    vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_VULKAN
@@ -0,0 +1,130 @@
+/**
+ * @file VulkanDescriptorCache.cpp
+ * @brief 按帧复用的Vulkan描述符集缓存实现
+ */
+
+#include "VulkanDescriptorCache.h"
+
+#ifdef PLE_RENDERER_VULKAN
+
+#include <functional>
+
+#include "VulkanDevice.h"
+
+namespace PLE {
+
+namespace {
+
+// 每个描述符池可分配的材质描述符集数量
+constexpr uint32_t SETS_PER_POOL = 256;
+
+} // namespace
+
+VulkanDescriptorCache::~VulkanDescriptorCache() {
+    Shutdown();
+}
+
+size_t VulkanDescriptorCache::KeyHash::operator()(const Key& key) const {
+    size_t hash = std::hash<VkBuffer>()(key.uniformBuffer) ^ (static_cast<size_t>(key.uniformSize) << 1);
+    for (VkImageView view : key.views) {
+        hash ^= std::hash<VkImageView>()(view) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+void VulkanDescriptorCache::Initialize(VulkanDevice* device, VkDescriptorSetLayout layout) {
+    m_Device = device;
+    m_Layout = layout;
+}
+
+void VulkanDescriptorCache::Shutdown() {
+    for (VkDescriptorPool pool : m_Pools) {
+        vkDestroyDescriptorPool(m_Device->GetDevice(), pool, nullptr);
+    }
+    m_Pools.clear();
+    m_Sets.clear();
+    m_CurrentPool = 0;
+}
+
+void VulkanDescriptorCache::Reset() {
+    for (VkDescriptorPool pool : m_Pools) {
+        vkResetDescriptorPool(m_Device->GetDevice(), pool, 0);
+    }
+    m_Sets.clear();
+    m_CurrentPool = 0;
+    m_AllocatedCount = 0;
+}
+
+VkDescriptorPool VulkanDescriptorCache::CreatePool() const {
+    const VkDescriptorPoolSize sizes[] = {
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, SETS_PER_POOL },
+        { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, SETS_PER_POOL * VULKAN_MAX_MATERIAL_TEXTURES }
+    };
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = SETS_PER_POOL;
+    poolInfo.poolSizeCount = 2;
+    poolInfo.pPoolSizes = sizes;
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    VulkanCheck(vkCreateDescriptorPool(m_Device->GetDevice(), &poolInfo, nullptr, &pool), "创建描述符池");
+    return pool;
+}
+
+VkDescriptorSet VulkanDescriptorCache::GetMaterialSet(const Key& key, VkSampler sampler) {
+    auto it = m_Sets.find(key);
+    if (it != m_Sets.end()) {
+        return it->second;
+    }
+
+    VkDescriptorSet set = VK_NULL_HANDLE;
+    VkDescriptorSetAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &m_Layout;
+    while (set == VK_NULL_HANDLE) {
+        if (m_CurrentPool == m_Pools.size()) {
+            VkDescriptorPool pool = CreatePool();
+            if (!pool) {
+                return VK_NULL_HANDLE;
+            }
+            m_Pools.push_back(pool);
+        }
+        allocInfo.descriptorPool = m_Pools[m_CurrentPool];
+        VkResult result = vkAllocateDescriptorSets(m_Device->GetDevice(), &allocInfo, &set);
+        if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL) {
+            set = VK_NULL_HANDLE;
+            ++m_CurrentPool;
+        } else if (!VulkanCheck(result, "分配描述符集")) {
+            return VK_NULL_HANDLE;
+        }
+    }
+
+    VkDescriptorBufferInfo bufferInfo = { key.uniformBuffer, 0, key.uniformSize };
+    VkDescriptorImageInfo imageInfos[VULKAN_MAX_MATERIAL_TEXTURES];
+    VkWriteDescriptorSet writes[VULKAN_MAX_MATERIAL_TEXTURES + 1] = {};
+    writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writes[0].dstSet = set;
+    writes[0].dstBinding = 0;
+    writes[0].descriptorCount = 1;
+    writes[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    writes[0].pBufferInfo = &bufferInfo;
+    for (uint32_t i = 0; i < VULKAN_MAX_MATERIAL_TEXTURES; ++i) {
+        imageInfos[i] = { sampler, key.views[i], VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+        VkWriteDescriptorSet& write = writes[i + 1];
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = set;
+        write.dstBinding = i + 1;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.pImageInfo = &imageInfos[i];
+    }
+    vkUpdateDescriptorSets(m_Device->GetDevice(), VULKAN_MAX_MATERIAL_TEXTURES + 1, writes, 0, nullptr);
+
+    m_Sets.emplace(key, set);
+    ++m_AllocatedCount;
+    return set;
+}
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_VULKAN
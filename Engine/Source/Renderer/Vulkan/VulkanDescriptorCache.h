@@ -0,0 +1,93 @@
+/**
+ * @file VulkanDescriptorCache.h
+ * @brief 按帧复用的Vulkan描述符集缓存
+ */
+
+#pragma once
+
+#include "VulkanCommon.h"
+
+#ifdef PLE_RENDERER_VULKAN
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+namespace PLE {
+
+class VulkanDevice;
+
+/**
+ * @brief 材质描述符集缓存
+ *
+ * 每个在途帧持有一个缓存。材质uniform块使用动态偏移，因此描述符集只取决于
+ * 缓冲区、块大小和纹理视图；内容相同的材质在同一帧内共享同一个描述符集，
+ * 避免重复分配和vkUpdateDescriptorSets。描述符池用完时追加新池，
+ * 帧开始时（GPU已用完该帧）整体重置。
+ */
+class VulkanDescriptorCache {
+public:
+    /**
+     * @brief 材质描述符集的键
+     */
+    struct Key {
+        VkBuffer uniformBuffer = VK_NULL_HANDLE;
+        uint32_t uniformSize = 0;
+        std::array<VkImageView, VULKAN_MAX_MATERIAL_TEXTURES> views = {};
+
+        bool operator==(const Key& other) const {
+            return uniformBuffer == other.uniformBuffer && uniformSize == other.uniformSize && views == other.views;
+        }
+    };
+
+    VulkanDescriptorCache() = default;
+    ~VulkanDescriptorCache();
+
+    /**
+     * @brief 初始化
+     * @param device 设备
+     * @param layout 材质描述符集布局
+     */
+    void Initialize(VulkanDevice* device, VkDescriptorSetLayout layout);
+
+    /**
+     * @brief 销毁所有描述符池
+     */
+    void Shutdown();
+
+    /**
+     * @brief 重置所有描述符池并清空缓存，调用前该帧的GPU工作必须已完成
+     */
+    void Reset();
+
+    /**
+     * @brief 获取（必要时创建）材质描述符集
+     * @param key 描述符集的内容
+     * @param sampler 所有纹理使用的采样器
+     * @return 描述符集，失败时为VK_NULL_HANDLE
+     */
+    VkDescriptorSet GetMaterialSet(const Key& key, VkSampler sampler);
+
+    /**
+     * @brief 获取本帧新分配的描述符集数量
+     */
+    uint32_t GetAllocatedCount() const { return m_AllocatedCount; }
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    VkDescriptorPool CreatePool() const;
+
+    VulkanDevice* m_Device = nullptr;
+    VkDescriptorSetLayout m_Layout = VK_NULL_HANDLE;
+    std::vector<VkDescriptorPool> m_Pools;
+    size_t m_CurrentPool = 0;
+    std::unordered_map<Key, VkDescriptorSet, KeyHash> m_Sets;
+    uint32_t m_AllocatedCount = 0;
+};
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_VULKAN
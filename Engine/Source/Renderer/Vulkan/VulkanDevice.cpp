@@ -0,0 +1,450 @@
+/**
+ * @file VulkanDevice.cpp
+ * @brief Vulkan实例与逻辑设备实现
+ */
+
+#include "VulkanDevice.h"
+
+#ifdef PLE_RENDERER_VULKAN
+
+#include <cstring>
+#include <vector>
+
+#include "Platform/Window.h"
+
+#ifdef PLE_PLATFORM_WINDOWS
+    #include <windows.h>
+#endif
+
+namespace PLE {
+
+namespace {
+
+const char* VALIDATION_LAYER = "VK_LAYER_KHRONOS_validation";
+
+VKAPI_ATTR VkBool32 VKAPI_CALL DebugMessengerCallback(VkDebugUtilsMessageSeverityFlagBitsEXT severity, VkDebugUtilsMessageTypeFlagsEXT type, const VkDebugUtilsMessengerCallbackDataEXT* callbackData, void* userData) {
+    (void)type;
+    (void)userData;
+    if (severity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) {
+        std::cerr << "[Vulkan" << (severity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT ? "错误" : "警告") << "] " << callbackData->pMessage << std::endl;
+    }
+    return VK_FALSE;
+}
+
+bool HasLayer(const char* name) {
+    uint32_t count = 0;
+    vkEnumerateInstanceLayerProperties(&count, nullptr);
+    std::vector<VkLayerProperties> layers(count);
+    vkEnumerateInstanceLayerProperties(&count, layers.data());
+    for (const VkLayerProperties& layer : layers) {
+        if (std::strcmp(layer.layerName, name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool HasInstanceExtension(const char* name) {
+    uint32_t count = 0;
+    vkEnumerateInstanceExtensionProperties(nullptr, &count, nullptr);
+    std::vector<VkExtensionProperties> extensions(count);
+    vkEnumerateInstanceExtensionProperties(nullptr, &count, extensions.data());
+    for (const VkExtensionProperties& extension : extensions) {
+        if (std::strcmp(extension.extensionName, name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int DeviceTypeScore(VkPhysicalDeviceType type) {
+    switch (type) {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:   return 4;
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return 3;
+    case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:    return 2;
+    case VK_PHYSICAL_DEVICE_TYPE_CPU:            return 1;
+    default:                                     return 0;
+    }
+}
+
+} // namespace
+
+VulkanDevice::~VulkanDevice() {
+    Shutdown();
+}
+
+bool VulkanDevice::Initialize(std::shared_ptr<Window> window, bool enableValidation) {
+    if (!CreateInstance(window != nullptr, enableValidation)) {
+        return false;
+    }
+    if (window && !CreateSurface(window)) {
+        Shutdown();
+        return false;
+    }
+    if (!PickPhysicalDevice() || !CreateLogicalDevice()) {
+        Shutdown();
+        return false;
+    }
+    return true;
+}
+
+void VulkanDevice::Shutdown() {
+    if (m_Device) {
+        vkDeviceWaitIdle(m_Device);
+        vkDestroySampler(m_Device, m_DefaultSampler, nullptr);
+        vkDestroyFence(m_Device, m_ImmediateFence, nullptr);
+        vkDestroyCommandPool(m_Device, m_ImmediatePool, nullptr);
+        vkDestroyDevice(m_Device, nullptr);
+        m_DefaultSampler = VK_NULL_HANDLE;
+        m_ImmediateFence = VK_NULL_HANDLE;
+        m_ImmediatePool = VK_NULL_HANDLE;
+        m_Device = VK_NULL_HANDLE;
+    }
+    if (m_Surface) {
+        vkDestroySurfaceKHR(m_Instance, m_Surface, nullptr);
+        m_Surface = VK_NULL_HANDLE;
+    }
+    if (m_DebugMessenger) {
+        auto destroyMessenger = reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(vkGetInstanceProcAddr(m_Instance, "vkDestroyDebugUtilsMessengerEXT"));
+        if (destroyMessenger) {
+            destroyMessenger(m_Instance, m_DebugMessenger, nullptr);
+        }
+        m_DebugMessenger = VK_NULL_HANDLE;
+    }
+    if (m_Instance) {
+        vkDestroyInstance(m_Instance, nullptr);
+        m_Instance = VK_NULL_HANDLE;
+    }
+    m_PhysicalDevice = VK_NULL_HANDLE;
+}
+
+bool VulkanDevice::CreateInstance(bool needSurface, bool enableValidation) {
+    std::vector<const char*> extensions;
+    std::vector<const char*> layers;
+    if (needSurface) {
+        extensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
+#ifdef PLE_PLATFORM_WINDOWS
+        extensions.push_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
+#endif
+    }
+    const bool useDebugUtils = enableValidation && HasInstanceExtension(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+    if (useDebugUtils) {
+        extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+    }
+    if (enableValidation) {
+        if (HasLayer(VALIDATION_LAYER)) {
+            layers.push_back(VALIDATION_LAYER);
+        } else {
+            std::cerr << "Vulkan验证层不可用，已忽略调试模式" << std::endl;
+        }
+    }
+
+    VkApplicationInfo appInfo = {};
+    appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    appInfo.pApplicationName = "PhantomLightEngine";
+    appInfo.pEngineName = "PhantomLightEngine";
+    appInfo.engineVersion = VK_MAKE_VERSION(PLE_VERSION_MAJOR, PLE_VERSION_MINOR, PLE_VERSION_PATCH);
+    // 1.1提供负高度视口（与OpenGL后端一致的Y轴朝上约定）
+    appInfo.apiVersion = VK_API_VERSION_1_1;
+
+    VkInstanceCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    createInfo.pApplicationInfo = &appInfo;
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    createInfo.ppEnabledExtensionNames = extensions.data();
+    createInfo.enabledLayerCount = static_cast<uint32_t>(layers.size());
+    createInfo.ppEnabledLayerNames = layers.data();
+    if (!VulkanCheck(vkCreateInstance(&createInfo, nullptr, &m_Instance), "创建Vulkan实例")) {
+        return false;
+    }
+
+    if (useDebugUtils) {
+        VkDebugUtilsMessengerCreateInfoEXT messengerInfo = {};
+        messengerInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+        messengerInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+        messengerInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+        messengerInfo.pfnUserCallback = DebugMessengerCallback;
+        auto createMessenger = reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(vkGetInstanceProcAddr(m_Instance, "vkCreateDebugUtilsMessengerEXT"));
+        if (createMessenger) {
+            createMessenger(m_Instance, &messengerInfo, nullptr, &m_DebugMessenger);
+        }
+    }
+    return true;
+}
+
+bool VulkanDevice::CreateSurface(std::shared_ptr<Window> window) {
+#ifdef PLE_PLATFORM_WINDOWS
+    VkWin32SurfaceCreateInfoKHR surfaceInfo = {};
+    surfaceInfo.sType = VK_STRUCTURE_TYPE_WIN32_SURFACE_CREATE_INFO_KHR;
+    surfaceInfo.hinstance = GetModuleHandle(nullptr);
+    surfaceInfo.hwnd = static_cast<HWND>(window->GetNativeWindow());
+    return VulkanCheck(vkCreateWin32SurfaceKHR(m_Instance, &surfaceInfo, nullptr, &m_Surface), "创建窗口表面");
+#else
+    (void)window;
+    std::cerr << "当前平台不支持Vulkan窗口表面！" << std::endl;
+    return false;
+#endif
+}
+
+bool VulkanDevice::PickPhysicalDevice() {
+    uint32_t count = 0;
+    vkEnumeratePhysicalDevices(m_Instance, &count, nullptr);
+    std::vector<VkPhysicalDevice> devices(count);
+    vkEnumeratePhysicalDevices(m_Instance, &count, devices.data());
+
+    int bestScore = -1;
+    for (VkPhysicalDevice device : devices) {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(device, &properties);
+        if (properties.apiVersion < VK_API_VERSION_1_1) {
+            continue;
+        }
+
+        uint32_t familyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &familyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> families(familyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &familyCount, families.data());
+
+        // 图形队列同时负责传输和呈现
+        uint32_t family = UINT32_MAX;
+        for (uint32_t i = 0; i < familyCount; ++i) {
+            if (!(families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)) {
+                continue;
+            }
+            VkBool32 presentSupported = VK_TRUE;
+            if (m_Surface) {
+                vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_Surface, &presentSupported);
+            }
+            if (presentSupported) {
+                family = i;
+                break;
+            }
+        }
+        if (family == UINT32_MAX) {
+            continue;
+        }
+
+        const int score = DeviceTypeScore(properties.deviceType);
+        if (score > bestScore) {
+            bestScore = score;
+            m_PhysicalDevice = device;
+            m_Properties = properties;
+            m_GraphicsQueueFamily = family;
+        }
+    }
+
+    if (!m_PhysicalDevice) {
+        std::cerr << "找不到支持Vulkan 1.1图形队列的设备！" << std::endl;
+        return false;
+    }
+    vkGetPhysicalDeviceMemoryProperties(m_PhysicalDevice, &m_MemoryProperties);
+
+    const VkFormat depthCandidates[] = { VK_FORMAT_D24_UNORM_S8_UINT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D16_UNORM_S8_UINT };
+    for (VkFormat format : depthCandidates) {
+        VkFormatProperties formatProperties;
+        vkGetPhysicalDeviceFormatProperties(m_PhysicalDevice, format, &formatProperties);
+        if (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT) {
+            m_DepthFormat = format;
+            break;
+        }
+    }
+    if (m_DepthFormat == VK_FORMAT_UNDEFINED) {
+        std::cerr << "设备不支持任何深度模板格式！" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool VulkanDevice::CreateLogicalDevice() {
+    const float priority = 1.0f;
+    VkDeviceQueueCreateInfo queueInfo = {};
+    queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queueInfo.queueFamilyIndex = m_GraphicsQueueFamily;
+    queueInfo.queueCount = 1;
+    queueInfo.pQueuePriorities = &priority;
+
+    std::vector<const char*> extensions;
+    if (m_Surface) {
+        extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+    }
+
+    // 只启用用到的特性；BC格式在桌面GPU上普遍支持，不支持时纹理在CPU上解码
+    VkPhysicalDeviceFeatures supportedFeatures = {};
+    vkGetPhysicalDeviceFeatures(m_PhysicalDevice, &supportedFeatures);
+    VkPhysicalDeviceFeatures features = {};
+    features.textureCompressionBC = supportedFeatures.textureCompressionBC;
+    m_BlockCompressionSupported = supportedFeatures.textureCompressionBC == VK_TRUE;
+
+    VkDeviceCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    createInfo.queueCreateInfoCount = 1;
+    createInfo.pQueueCreateInfos = &queueInfo;
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    createInfo.ppEnabledExtensionNames = extensions.data();
+    createInfo.pEnabledFeatures = &features;
+    if (!VulkanCheck(vkCreateDevice(m_PhysicalDevice, &createInfo, nullptr, &m_Device), "创建Vulkan逻辑设备")) {
+        return false;
+    }
+    vkGetDeviceQueue(m_Device, m_GraphicsQueueFamily, 0, &m_GraphicsQueue);
+
+    VkCommandPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = m_GraphicsQueueFamily;
+    VkFenceCreateInfo fenceInfo = {};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    if (!VulkanCheck(vkCreateCommandPool(m_Device, &poolInfo, nullptr, &m_ImmediatePool), "创建上传命令池") ||
+        !VulkanCheck(vkCreateFence(m_Device, &fenceInfo, nullptr, &m_ImmediateFence), "创建上传栅栏")) {
+        return false;
+    }
+
+    VkSamplerCreateInfo samplerInfo = {};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = VK_FILTER_LINEAR;
+    samplerInfo.minFilter = VK_FILTER_LINEAR;
+    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+    return VulkanCheck(vkCreateSampler(m_Device, &samplerInfo, nullptr, &m_DefaultSampler), "创建默认采样器");
+}
+
+uint32_t VulkanDevice::FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties) const {
+    for (uint32_t i = 0; i < m_MemoryProperties.memoryTypeCount; ++i) {
+        if ((typeBits & (1u << i)) && (m_MemoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            return i;
+        }
+    }
+    return UINT32_MAX;
+}
+
+bool VulkanDevice::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& memory) const {
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (!VulkanCheck(vkCreateBuffer(m_Device, &bufferInfo, nullptr, &buffer), "创建缓冲区")) {
+        return false;
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(m_Device, buffer, &requirements);
+    VkMemoryAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = requirements.size;
+    allocInfo.memoryTypeIndex = FindMemoryType(requirements.memoryTypeBits, properties);
+    if (allocInfo.memoryTypeIndex == UINT32_MAX || !VulkanCheck(vkAllocateMemory(m_Device, &allocInfo, nullptr, &memory), "分配缓冲区内存")) {
+        vkDestroyBuffer(m_Device, buffer, nullptr);
+        buffer = VK_NULL_HANDLE;
+        return false;
+    }
+    vkBindBufferMemory(m_Device, buffer, memory, 0);
+    return true;
+}
+
+bool VulkanDevice::CreateImage(uint32_t width, uint32_t height, uint32_t mipLevels, VkFormat format, VkImageUsageFlags usage, VkImage& image, VkDeviceMemory& memory) const {
+    VkImageCreateInfo imageInfo = {};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = format;
+    imageInfo.extent = { width, height, 1 };
+    imageInfo.mipLevels = mipLevels;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = usage;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    if (!VulkanCheck(vkCreateImage(m_Device, &imageInfo, nullptr, &image), "创建图像")) {
+        return false;
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetImageMemoryRequirements(m_Device, image, &requirements);
+    VkMemoryAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = requirements.size;
+    allocInfo.memoryTypeIndex = FindMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (allocInfo.memoryTypeIndex == UINT32_MAX || !VulkanCheck(vkAllocateMemory(m_Device, &allocInfo, nullptr, &memory), "分配图像内存")) {
+        vkDestroyImage(m_Device, image, nullptr);
+        image = VK_NULL_HANDLE;
+        return false;
+    }
+    vkBindImageMemory(m_Device, image, memory, 0);
+    return true;
+}
+
+VkImageView VulkanDevice::CreateImageView(VkImage image, VkFormat format, VkImageAspectFlags aspect, uint32_t mipLevels) const {
+    VkImageViewCreateInfo viewInfo = {};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = format;
+    viewInfo.subresourceRange = { aspect, 0, mipLevels, 0, 1 };
+    VkImageView view = VK_NULL_HANDLE;
+    VulkanCheck(vkCreateImageView(m_Device, &viewInfo, nullptr, &view), "创建图像视图");
+    return view;
+}
+
+bool VulkanDevice::ImmediateSubmit(const std::function<void(VkCommandBuffer)>& record) {
+    std::lock_guard<std::mutex> lock(m_ImmediateMutex);
+
+    VkCommandBufferAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = m_ImmediatePool;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = 1;
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    if (!VulkanCheck(vkAllocateCommandBuffers(m_Device, &allocInfo, &commandBuffer), "分配上传命令缓冲")) {
+        return false;
+    }
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+    record(commandBuffer);
+    vkEndCommandBuffer(commandBuffer);
+
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+    VkResult result;
+    {
+        std::lock_guard<std::mutex> queueLock(m_QueueMutex);
+        result = vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, m_ImmediateFence);
+    }
+    if (result == VK_SUCCESS) {
+        result = vkWaitForFences(m_Device, 1, &m_ImmediateFence, VK_TRUE, UINT64_MAX);
+    }
+    vkResetFences(m_Device, 1, &m_ImmediateFence);
+    vkResetCommandPool(m_Device, m_ImmediatePool, 0);
+    return VulkanCheck(result, "执行上传命令");
+}
+
+bool VulkanDevice::UploadBuffer(VkBuffer destination, const void* data, VkDeviceSize size) {
+    VkBuffer staging = VK_NULL_HANDLE;
+    VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+    if (!CreateBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, staging, stagingMemory)) {
+        return false;
+    }
+    void* mapped = nullptr;
+    vkMapMemory(m_Device, stagingMemory, 0, size, 0, &mapped);
+    std::memcpy(mapped, data, static_cast<size_t>(size));
+    vkUnmapMemory(m_Device, stagingMemory);
+
+    const bool uploaded = ImmediateSubmit([&](VkCommandBuffer commandBuffer) {
+        VkBufferCopy region = { 0, 0, size };
+        vkCmdCopyBuffer(commandBuffer, staging, destination, 1, &region);
+    });
+    vkDestroyBuffer(m_Device, staging, nullptr);
+    vkFreeMemory(m_Device, stagingMemory, nullptr);
+    return uploaded;
+}
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_VULKAN
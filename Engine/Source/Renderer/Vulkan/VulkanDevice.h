@@ -0,0 +1,135 @@
+/**
+ * @file VulkanDevice.h
+ * @brief Vulkan实例与逻辑设备
+ */
+
+#pragma once
+
+#include "VulkanCommon.h"
+
+#ifdef PLE_RENDERER_VULKAN
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace PLE {
+
+class Window;
+
+/**
+ * @brief Vulkan设备
+ *
+ * 负责实例、（可选的）窗口表面、物理设备选择、逻辑设备和图形队列，
+ * 并提供内存类型查找、缓冲区/图像创建以及资源上传用的同步一次性提交。
+ * 物理设备按独立显卡、集成显卡、虚拟GPU、CPU（lavapipe）的顺序选择，
+ * 因此在只有软件驱动的CI环境中同样可用。
+ */
+class VulkanDevice {
+public:
+    VulkanDevice() = default;
+    ~VulkanDevice();
+
+    /**
+     * @brief 创建实例和设备
+     * @param window 窗口指针，为nullptr时不创建表面和交换链扩展
+     * @param enableValidation 是否启用验证层（不可用时忽略）
+     * @return 是否成功创建
+     */
+    bool Initialize(std::shared_ptr<Window> window, bool enableValidation);
+
+    /**
+     * @brief 销毁设备和实例
+     */
+    void Shutdown();
+
+    VkInstance GetInstance() const { return m_Instance; }
+    VkPhysicalDevice GetPhysicalDevice() const { return m_PhysicalDevice; }
+    VkDevice GetDevice() const { return m_Device; }
+    VkQueue GetGraphicsQueue() const { return m_GraphicsQueue; }
+    uint32_t GetGraphicsQueueFamily() const { return m_GraphicsQueueFamily; }
+    VkSurfaceKHR GetSurface() const { return m_Surface; }
+    const VkPhysicalDeviceProperties& GetProperties() const { return m_Properties; }
+
+    /**
+     * @brief 获取设备支持的深度模板格式
+     */
+    VkFormat GetDepthFormat() const { return m_DepthFormat; }
+
+    /**
+     * @brief 是否启用了BC块压缩纹理（textureCompressionBC特性）
+     */
+    bool IsBlockCompressionSupported() const { return m_BlockCompressionSupported; }
+
+    /**
+     * @brief 获取共享的线性过滤采样器
+     */
+    VkSampler GetDefaultSampler() const { return m_DefaultSampler; }
+
+    /**
+     * @brief 队列提交锁，所有线程向图形队列提交前都要持有
+     */
+    std::mutex& GetQueueMutex() { return m_QueueMutex; }
+
+    /**
+     * @brief 查找满足要求的内存类型
+     * @return 内存类型索引，找不到时返回UINT32_MAX
+     */
+    uint32_t FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties) const;
+
+    /**
+     * @brief 创建缓冲区并分配绑定内存
+     */
+    bool CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& memory) const;
+
+    /**
+     * @brief 创建二维图像并分配绑定设备本地内存
+     */
+    bool CreateImage(uint32_t width, uint32_t height, uint32_t mipLevels, VkFormat format, VkImageUsageFlags usage, VkImage& image, VkDeviceMemory& memory) const;
+
+    /**
+     * @brief 创建二维图像视图
+     */
+    VkImageView CreateImageView(VkImage image, VkFormat format, VkImageAspectFlags aspect, uint32_t mipLevels) const;
+
+    /**
+     * @brief 录制并同步执行一次性命令（资源创建和上传用），可在任意线程调用
+     * @param record 录制函数
+     * @return 是否成功执行
+     */
+    bool ImmediateSubmit(const std::function<void(VkCommandBuffer)>& record);
+
+    /**
+     * @brief 经暂存缓冲区把数据上传到设备本地缓冲区
+     */
+    bool UploadBuffer(VkBuffer destination, const void* data, VkDeviceSize size);
+
+private:
+    bool CreateInstance(bool needSurface, bool enableValidation);
+    bool CreateSurface(std::shared_ptr<Window> window);
+    bool PickPhysicalDevice();
+    bool CreateLogicalDevice();
+
+    VkInstance m_Instance = VK_NULL_HANDLE;
+    VkDebugUtilsMessengerEXT m_DebugMessenger = VK_NULL_HANDLE;
+    VkSurfaceKHR m_Surface = VK_NULL_HANDLE;
+    VkPhysicalDevice m_PhysicalDevice = VK_NULL_HANDLE;
+    VkPhysicalDeviceProperties m_Properties = {};
+    VkPhysicalDeviceMemoryProperties m_MemoryProperties = {};
+    VkDevice m_Device = VK_NULL_HANDLE;
+    VkQueue m_GraphicsQueue = VK_NULL_HANDLE;
+    uint32_t m_GraphicsQueueFamily = 0;
+    VkFormat m_DepthFormat = VK_FORMAT_UNDEFINED;
+    bool m_BlockCompressionSupported = false;
+    VkSampler m_DefaultSampler = VK_NULL_HANDLE;
+
+    std::mutex m_QueueMutex;
+    std::mutex m_ImmediateMutex;
+    VkCommandPool m_ImmediatePool = VK_NULL_HANDLE;
+    VkFence m_ImmediateFence = VK_NULL_HANDLE;
+};
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_VULKAN
@@ -0,0 +1,233 @@
+/**
+ * @file VulkanPipelineCache.cpp
+ * @brief 持久化到磁盘的Vulkan管线缓存实现
+ */
+
+#include "VulkanPipelineCache.h"
+
+#ifdef PLE_RENDERER_VULKAN
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "Renderer/RenderResources.h"
+#include "VulkanDevice.h"
+
+namespace PLE {
+
+namespace {
+
+VkFormat GetVertexFormat(VertexAttributeFormat format) {
+    switch (format) {
+    case VertexAttributeFormat::Float2:
+        return VK_FORMAT_R32G32_SFLOAT;
+    case VertexAttributeFormat::Float3:
+        return VK_FORMAT_R32G32B32_SFLOAT;
+    case VertexAttributeFormat::Float4:
+        return VK_FORMAT_R32G32B32A32_SFLOAT;
+    case VertexAttributeFormat::Half2:
+        return VK_FORMAT_R16G16_SFLOAT;
+    case VertexAttributeFormat::Half4:
+        return VK_FORMAT_R16G16B16A16_SFLOAT;
+    case VertexAttributeFormat::Unorm16x4:
+        return VK_FORMAT_R16G16B16A16_UNORM;
+    case VertexAttributeFormat::Snorm16x2:
+        return VK_FORMAT_R16G16_SNORM;
+    case VertexAttributeFormat::Snorm16x4:
+        return VK_FORMAT_R16G16B16A16_SNORM;
+    case VertexAttributeFormat::Unorm8x4:
+        return VK_FORMAT_R8G8B8A8_UNORM;
+    case VertexAttributeFormat::Snorm8x4:
+        return VK_FORMAT_R8G8B8A8_SNORM;
+    default:
+        return VK_FORMAT_UNDEFINED;
+    }
+}
+
+} // namespace
+
+VulkanPipelineCache::~VulkanPipelineCache() {
+    Shutdown();
+}
+
+bool VulkanPipelineCache::Initialize(VulkanDevice* device, const std::string& path) {
+    m_Device = device;
+    m_Path = path;
+
+    std::string data;
+    if (!path.empty()) {
+        std::ifstream file(path, std::ios::binary);
+        if (file) {
+            data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        if (!data.empty() && !IsCompatible(data)) {
+            std::cout << "管线缓存与当前设备或驱动不匹配，已丢弃：" << path << std::endl;
+            data.clear();
+        }
+    }
+
+    VkPipelineCacheCreateInfo cacheInfo = {};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cacheInfo.initialDataSize = data.size();
+    cacheInfo.pInitialData = data.empty() ? nullptr : data.data();
+    if (vkCreatePipelineCache(device->GetDevice(), &cacheInfo, nullptr, &m_Cache) != VK_SUCCESS) {
+        // 驱动拒绝旧数据时退回空缓存
+        cacheInfo.initialDataSize = 0;
+        cacheInfo.pInitialData = nullptr;
+        if (!VulkanCheck(vkCreatePipelineCache(device->GetDevice(), &cacheInfo, nullptr, &m_Cache), "创建管线缓存")) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void VulkanPipelineCache::Shutdown() {
+    if (m_Cache) {
+        Save();
+        vkDestroyPipelineCache(m_Device->GetDevice(), m_Cache, nullptr);
+        m_Cache = VK_NULL_HANDLE;
+    }
+}
+
+bool VulkanPipelineCache::Save() const {
+    if (!m_Cache || m_Path.empty()) {
+        return false;
+    }
+
+    size_t size = 0;
+    vkGetPipelineCacheData(m_Device->GetDevice(), m_Cache, &size, nullptr);
+    std::vector<char> data(size);
+    if (size == 0 || vkGetPipelineCacheData(m_Device->GetDevice(), m_Cache, &size, data.data()) != VK_SUCCESS) {
+        return false;
+    }
+
+    // 先写临时文件再替换，避免进程中途退出留下损坏的缓存
+    const std::string temporaryPath = m_Path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file.write(data.data(), static_cast<std::streamsize>(size))) {
+            std::cerr << "写入管线缓存失败：" << temporaryPath << std::endl;
+            return false;
+        }
+    }
+    std::remove(m_Path.c_str());
+    if (std::rename(temporaryPath.c_str(), m_Path.c_str()) != 0) {
+        std::cerr << "保存管线缓存失败：" << m_Path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool VulkanPipelineCache::IsCompatible(const std::string& data) const {
+    // 缓存头：头长度、头版本、厂商ID、设备ID、管线缓存UUID
+    const size_t headerSize = 16 + VK_UUID_SIZE;
+    if (data.size() < headerSize) {
+        return false;
+    }
+    uint32_t header[4];
+    std::memcpy(header, data.data(), sizeof(header));
+    const VkPhysicalDeviceProperties& properties = m_Device->GetProperties();
+    return header[0] >= headerSize &&
+           header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header[2] == properties.vendorID &&
+           header[3] == properties.deviceID &&
+           std::memcmp(data.data() + 16, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+VkPipeline VulkanPipelineCache::CreateGraphicsPipeline(VkShaderModule vertexModule, VkShaderModule fragmentModule, VkPipelineLayout layout,
+                                                       VkRenderPass renderPass, const VertexLayout& vertexLayout) const {
+    VkPipelineShaderStageCreateInfo stages[2] = {};
+    stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    stages[0].module = vertexModule;
+    stages[0].pName = "main";
+    stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stages[1].module = fragmentModule;
+    stages[1].pName = "main";
+
+    // 标准布局与Vertex结构一致：0 = position，1 = normal，2 = texCoord
+    VkVertexInputBindingDescription binding = { 0, vertexLayout.stride, VK_VERTEX_INPUT_RATE_VERTEX };
+    std::vector<VkVertexInputAttributeDescription> attributes;
+    attributes.reserve(vertexLayout.attributes.size());
+    for (const VertexAttribute& attribute : vertexLayout.attributes) {
+        attributes.push_back({ attribute.location, 0, GetVertexFormat(attribute.format), attribute.offset });
+    }
+    VkPipelineVertexInputStateCreateInfo vertexInput = {};
+    vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInput.vertexBindingDescriptionCount = 1;
+    vertexInput.pVertexBindingDescriptions = &binding;
+    vertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributes.size());
+    vertexInput.pVertexAttributeDescriptions = attributes.data();
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly = {};
+    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = vertexLayout.topology == PrimitiveTopology::Lines ? VK_PRIMITIVE_TOPOLOGY_LINE_LIST
+                                                                               : VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    VkPipelineViewportStateCreateInfo viewportState = {};
+    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount = 1;
+
+    // 负高度视口下的朝向与OpenGL一致；与OpenGL后端的默认状态相同，不剔除背面
+    VkPipelineRasterizationStateCreateInfo rasterization = {};
+    rasterization.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterization.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterization.cullMode = VK_CULL_MODE_NONE;
+    rasterization.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    rasterization.lineWidth = 1.0f;
+
+    VkPipelineMultisampleStateCreateInfo multisample = {};
+    multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineDepthStencilStateCreateInfo depthStencil = {};
+    depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil.depthTestEnable = VK_TRUE;
+    depthStencil.depthWriteEnable = VK_TRUE;
+    depthStencil.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+
+    VkPipelineColorBlendAttachmentState blendAttachment = {};
+    blendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    VkPipelineColorBlendStateCreateInfo colorBlend = {};
+    colorBlend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlend.attachmentCount = 1;
+    colorBlend.pAttachments = &blendAttachment;
+
+    const VkDynamicState dynamicStates[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+    VkPipelineDynamicStateCreateInfo dynamicState = {};
+    dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = 2;
+    dynamicState.pDynamicStates = dynamicStates;
+
+    VkGraphicsPipelineCreateInfo pipelineInfo = {};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount = 2;
+    pipelineInfo.pStages = stages;
+    pipelineInfo.pVertexInputState = &vertexInput;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState = &viewportState;
+    pipelineInfo.pRasterizationState = &rasterization;
+    pipelineInfo.pMultisampleState = &multisample;
+    pipelineInfo.pDepthStencilState = &depthStencil;
+    pipelineInfo.pColorBlendState = &colorBlend;
+    pipelineInfo.pDynamicState = &dynamicState;
+    pipelineInfo.layout = layout;
+    pipelineInfo.renderPass = renderPass;
+    pipelineInfo.subpass = 0;
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    if (!VulkanCheck(vkCreateGraphicsPipelines(m_Device->GetDevice(), m_Cache, 1, &pipelineInfo, nullptr, &pipeline), "创建图形管线")) {
+        return VK_NULL_HANDLE;
+    }
+    return pipeline;
+}
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_VULKAN
@@ -0,0 +1,74 @@
+/**
+ * @file VulkanPipelineCache.h
+ * @brief 持久化到磁盘的Vulkan管线缓存
+ */
+
+#pragma once
+
+#include "VulkanCommon.h"
+
+#ifdef PLE_RENDERER_VULKAN
+
+#include <string>
+
+namespace PLE {
+
+class VulkanDevice;
+struct VertexLayout;
+
+/**
+ * @brief Vulkan管线缓存
+ *
+ * 启动时从磁盘加载VkPipelineCache数据，关闭时写回。加载前校验缓存头中的
+ * 厂商ID、设备ID和管线缓存UUID，驱动或设备变化时丢弃旧数据，避免把不兼容
+ * 的缓存交给驱动。命中缓存时管线创建只需反序列化，可省去着色器编译时间。
+ */
+class VulkanPipelineCache {
+public:
+    VulkanPipelineCache() = default;
+    ~VulkanPipelineCache();
+
+    /**
+     * @brief 创建管线缓存并尝试加载磁盘数据
+     * @param device 设备
+     * @param path 缓存文件路径，为空时不持久化
+     * @return 是否成功创建
+     */
+    bool Initialize(VulkanDevice* device, const std::string& path);
+
+    /**
+     * @brief 保存缓存数据并销毁缓存
+     */
+    void Shutdown();
+
+    /**
+     * @brief 把当前缓存数据写入磁盘
+     * @return 是否成功写入
+     */
+    bool Save() const;
+
+    /**
+     * @brief 创建图形管线
+     * @param vertexModule 顶点着色器模块
+     * @param fragmentModule 片段着色器模块
+     * @param layout 管线布局
+     * @param renderPass 兼容的渲染通道
+     * @param vertexLayout 顶点布局
+     * @return 管线句柄，失败时为VK_NULL_HANDLE
+     */
+    VkPipeline CreateGraphicsPipeline(VkShaderModule vertexModule, VkShaderModule fragmentModule, VkPipelineLayout layout,
+                                      VkRenderPass renderPass, const VertexLayout& vertexLayout) const;
+
+    VkPipelineCache GetCache() const { return m_Cache; }
+
+private:
+    bool IsCompatible(const std::string& data) const;
+
+    VulkanDevice* m_Device = nullptr;
+    VkPipelineCache m_Cache = VK_NULL_HANDLE;
+    std::string m_Path;
+};
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_VULKAN
@@ -0,0 +1,1230 @@
+/**
+ * @file VulkanRenderSystem.cpp
+ * @brief Vulkan渲染系统实现
+ */
+
+#include "VulkanRenderSystem.h"
+
+#ifdef PLE_RENDERER_VULKAN
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#include "Core/JobSystem.h"
+#include "Platform/Window.h"
+#include "Scene/Camera.h"
+#include "VulkanResources.h"
+#include "../BlockCompression.h"
+
+namespace PLE {
+
+namespace {
+
+// 每帧的uniform区域大小
+constexpr uint32_t UNIFORM_FRAME_SIZE = 4 * 1024 * 1024;
+
+// 每帧的瞬态几何区域大小（足够10万个精灵）
+constexpr uint32_t GEOMETRY_FRAME_SIZE = 16 * 1024 * 1024;
+
+// 每个二级命令缓冲至少录制的绘制数量，绘制较少时并行录制得不偿失
+constexpr uint32_t MIN_DRAWS_PER_CHUNK = 64;
+
+} // namespace
+
+VulkanRenderSystem::VulkanRenderSystem(const RenderSystemConfig& config)
+    : m_Config(config) {
+}
+
+VulkanRenderSystem::~VulkanRenderSystem() {
+    Shutdown();
+}
+
+bool VulkanRenderSystem::Initialize(std::shared_ptr<Window> window) {
+    if (m_Initialized) {
+        return true;
+    }
+
+    if (!m_Device.Initialize(window, m_Config.enableDebugMode)) {
+        return false;
+    }
+    m_Window = window;
+    m_Initialized = true;
+
+    const int width = window ? static_cast<int>(window->GetWidth()) : m_Config.width;
+    const int height = window ? static_cast<int>(window->GetHeight()) : m_Config.height;
+    if (!m_PipelineCache.Initialize(&m_Device, m_Config.pipelineCachePath) ||
+        !CreateRenderPasses() || !CreateLayouts() || !CreateUniformBuffer() || !CreateGeometryBuffer() || !CreateFrames() ||
+        !CreateDefaultTarget(width, height)) {
+        Shutdown();
+        return false;
+    }
+
+    const uint32_t white = 0xFFFFFFFF;
+    m_WhiteTexture = std::make_shared<VulkanTexture>(m_Device, 1, 1, &white);
+    if (!m_WhiteTexture->IsValid()) {
+        Shutdown();
+        return false;
+    }
+
+    if (window && !m_Swapchain.Initialize(&m_Device, static_cast<uint32_t>(width), static_cast<uint32_t>(height), m_Config.enableVSync)) {
+        Shutdown();
+        return false;
+    }
+
+    SetViewport(0, 0, width, height);
+    std::cout << "Vulkan渲染系统初始化成功：" << GetGPUInfo() << "，" << GetAPIVersion() << std::endl;
+    return true;
+}
+
+void VulkanRenderSystem::Shutdown() {
+    if (!m_Initialized) {
+        return;
+    }
+
+    VkDevice device = m_Device.GetDevice();
+    vkDeviceWaitIdle(device);
+    m_FrameActive = false;
+    m_Passes.clear();
+    m_Draws.clear();
+    for (const auto& readback : m_PendingReadbacks) {
+        readback->Cancel();
+    }
+    m_PendingReadbacks.clear();
+
+    for (FrameData& frame : m_Frames) {
+        frame.retained.clear();
+        frame.materialUploads.clear();
+        frame.uniformUploads.clear();
+        frame.descriptors.Shutdown();
+        for (RecordingPool& recordingPool : frame.recordingPools) {
+            vkDestroyCommandPool(device, recordingPool.pool, nullptr);
+        }
+        frame.recordingPools.clear();
+        vkDestroyCommandPool(device, frame.commandPool, nullptr);
+        vkDestroyFence(device, frame.fence, nullptr);
+        vkDestroySemaphore(device, frame.imageAvailable, nullptr);
+        frame.commandPool = VK_NULL_HANDLE;
+        frame.commandBuffer = VK_NULL_HANDLE;
+        frame.fence = VK_NULL_HANDLE;
+        frame.imageAvailable = VK_NULL_HANDLE;
+    }
+
+    m_DefaultTarget = nullptr;
+    m_WhiteTexture = nullptr;
+    m_CurrentTarget = nullptr;
+    m_Camera = nullptr;
+    m_Swapchain.Shutdown();
+
+    if (m_UniformBuffer) {
+        vkUnmapMemory(device, m_UniformMemory);
+        vkDestroyBuffer(device, m_UniformBuffer, nullptr);
+        vkFreeMemory(device, m_UniformMemory, nullptr);
+        m_UniformBuffer = VK_NULL_HANDLE;
+        m_UniformMemory = VK_NULL_HANDLE;
+        m_UniformMapped = nullptr;
+    }
+    if (m_GeometryBuffer) {
+        vkUnmapMemory(device, m_GeometryMemory);
+        vkDestroyBuffer(device, m_GeometryBuffer, nullptr);
+        vkFreeMemory(device, m_GeometryMemory, nullptr);
+        m_GeometryBuffer = VK_NULL_HANDLE;
+        m_GeometryMemory = VK_NULL_HANDLE;
+        m_GeometryMapped = nullptr;
+    }
+    vkDestroyDescriptorPool(device, m_PerDrawPool, nullptr);
+    vkDestroyPipelineLayout(device, m_PipelineLayout, nullptr);
+    vkDestroyDescriptorSetLayout(device, m_MaterialLayout, nullptr);
+    vkDestroyDescriptorSetLayout(device, m_PerDrawLayout, nullptr);
+    m_PerDrawPool = VK_NULL_HANDLE;
+    m_PerDrawSet = VK_NULL_HANDLE;
+    m_PipelineLayout = VK_NULL_HANDLE;
+    m_MaterialLayout = VK_NULL_HANDLE;
+    m_PerDrawLayout = VK_NULL_HANDLE;
+    for (VkRenderPass& renderPass : m_RenderPasses) {
+        vkDestroyRenderPass(device, renderPass, nullptr);
+        renderPass = VK_NULL_HANDLE;
+    }
+
+    m_PipelineCache.Shutdown();
+    m_Device.Shutdown();
+    m_Window = nullptr;
+    m_Initialized = false;
+}
+
+bool VulkanRenderSystem::CreateRenderPasses() {
+    for (uint32_t flags = 0; flags < m_RenderPasses.size(); ++flags) {
+        // 附件在渲染通道之外保持固定布局：颜色可被采样，深度保持附件布局
+        VkAttachmentDescription attachments[2] = {};
+        attachments[0].format = VK_FORMAT_R8G8B8A8_UNORM;
+        attachments[0].samples = VK_SAMPLE_COUNT_1_BIT;
+        attachments[0].loadOp = (flags & CLEAR_COLOR) ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD;
+        attachments[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachments[0].initialLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        attachments[0].finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        attachments[1].format = m_Device.GetDepthFormat();
+        attachments[1].samples = VK_SAMPLE_COUNT_1_BIT;
+        attachments[1].loadOp = (flags & CLEAR_DEPTH) ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD;
+        attachments[1].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        attachments[1].stencilLoadOp = (flags & CLEAR_STENCIL) ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD;
+        attachments[1].stencilStoreOp = VK_ATTACHMENT_STORE_OP_STORE;
+        attachments[1].initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        attachments[1].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        VkAttachmentReference colorReference = { 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+        VkAttachmentReference depthReference = { 1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
+        VkSubpassDescription subpass = {};
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount = 1;
+        subpass.pColorAttachments = &colorReference;
+        subpass.pDepthStencilAttachment = &depthReference;
+
+        const VkPipelineStageFlags attachmentStages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        const VkAccessFlags attachmentAccess = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                               VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        VkSubpassDependency dependencies[2] = {};
+        // 之前的附件写入、采样和传输读取完成后才能写入
+        dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+        dependencies[0].dstSubpass = 0;
+        dependencies[0].srcStageMask = attachmentStages | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+        dependencies[0].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        dependencies[0].dstStageMask = attachmentStages;
+        dependencies[0].dstAccessMask = attachmentAccess;
+        // 之后的采样和传输（读回、呈现复制）能看到本通道的写入
+        dependencies[1].srcSubpass = 0;
+        dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+        dependencies[1].srcStageMask = attachmentStages;
+        dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        dependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+        dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+
+        VkRenderPassCreateInfo renderPassInfo = {};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+        renderPassInfo.attachmentCount = 2;
+        renderPassInfo.pAttachments = attachments;
+        renderPassInfo.subpassCount = 1;
+        renderPassInfo.pSubpasses = &subpass;
+        renderPassInfo.dependencyCount = 2;
+        renderPassInfo.pDependencies = dependencies;
+        if (!VulkanCheck(vkCreateRenderPass(m_Device.GetDevice(), &renderPassInfo, nullptr, &m_RenderPasses[flags]), "创建渲染通道")) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool VulkanRenderSystem::CreateLayouts() {
+    VkDevice device = m_Device.GetDevice();
+
+    VkDescriptorSetLayoutBinding perDrawBinding = {};
+    perDrawBinding.binding = 0;
+    perDrawBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    perDrawBinding.descriptorCount = 1;
+    perDrawBinding.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = 1;
+    layoutInfo.pBindings = &perDrawBinding;
+    if (!VulkanCheck(vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &m_PerDrawLayout), "创建描述符集布局")) {
+        return false;
+    }
+
+    VkDescriptorSetLayoutBinding materialBindings[VULKAN_MAX_MATERIAL_TEXTURES + 1] = {};
+    materialBindings[0] = perDrawBinding;
+    for (uint32_t i = 1; i <= VULKAN_MAX_MATERIAL_TEXTURES; ++i) {
+        materialBindings[i].binding = i;
+        materialBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        materialBindings[i].descriptorCount = 1;
+        materialBindings[i].stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+    }
+    layoutInfo.bindingCount = VULKAN_MAX_MATERIAL_TEXTURES + 1;
+    layoutInfo.pBindings = materialBindings;
+    if (!VulkanCheck(vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &m_MaterialLayout), "创建描述符集布局")) {
+        return false;
+    }
+
+    const VkDescriptorSetLayout setLayouts[] = { m_PerDrawLayout, m_MaterialLayout };
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = 2;
+    pipelineLayoutInfo.pSetLayouts = setLayouts;
+    return VulkanCheck(vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &m_PipelineLayout), "创建管线布局");
+}
+
+bool VulkanRenderSystem::CreateUniformBuffer() {
+    VkDevice device = m_Device.GetDevice();
+    m_UniformAlignment = static_cast<uint32_t>(std::max<VkDeviceSize>(m_Device.GetProperties().limits.minUniformBufferOffsetAlignment, 16));
+    const VkDeviceSize size = static_cast<VkDeviceSize>(UNIFORM_FRAME_SIZE) * VULKAN_FRAMES_IN_FLIGHT;
+    if (!m_Device.CreateBuffer(size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_UniformBuffer, m_UniformMemory)) {
+        return false;
+    }
+    void* mapped = nullptr;
+    if (!VulkanCheck(vkMapMemory(device, m_UniformMemory, 0, size, 0, &mapped), "映射uniform缓冲区")) {
+        return false;
+    }
+    m_UniformMapped = static_cast<uint8_t*>(mapped);
+
+    // 每次绘制的描述符集只有一个，偏移在绑定时动态指定
+    VkDescriptorPoolSize poolSize = { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1 };
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+    if (!VulkanCheck(vkCreateDescriptorPool(device, &poolInfo, nullptr, &m_PerDrawPool), "创建描述符池")) {
+        return false;
+    }
+    VkDescriptorSetAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = m_PerDrawPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &m_PerDrawLayout;
+    if (!VulkanCheck(vkAllocateDescriptorSets(device, &allocInfo, &m_PerDrawSet), "分配描述符集")) {
+        return false;
+    }
+
+    VkDescriptorBufferInfo bufferInfo = { m_UniformBuffer, 0, sizeof(PerDrawData) };
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = m_PerDrawSet;
+    write.dstBinding = 0;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    write.pBufferInfo = &bufferInfo;
+    vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+    return true;
+}
+
+bool VulkanRenderSystem::CreateGeometryBuffer() {
+    const VkDeviceSize size = static_cast<VkDeviceSize>(GEOMETRY_FRAME_SIZE) * VULKAN_FRAMES_IN_FLIGHT;
+    if (!m_Device.CreateBuffer(size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_GeometryBuffer, m_GeometryMemory)) {
+        return false;
+    }
+    void* mapped = nullptr;
+    if (!VulkanCheck(vkMapMemory(m_Device.GetDevice(), m_GeometryMemory, 0, size, 0, &mapped), "映射瞬态几何缓冲区")) {
+        return false;
+    }
+    m_GeometryMapped = static_cast<uint8_t*>(mapped);
+    return true;
+}
+
+bool VulkanRenderSystem::CreateFrames() {
+    VkDevice device = m_Device.GetDevice();
+    // 录制用命令池的数量按初始化时任务系统的并行度确定
+    JobSystem& jobSystem = JobSystem::GetInstance();
+    const uint32_t recordingPoolCount = jobSystem.IsInitialized() ? jobSystem.GetConcurrency() : 1;
+
+    VkCommandPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = m_Device.GetGraphicsQueueFamily();
+    VkFenceCreateInfo fenceInfo = {};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+    VkSemaphoreCreateInfo semaphoreInfo = {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    for (FrameData& frame : m_Frames) {
+        if (!VulkanCheck(vkCreateFence(device, &fenceInfo, nullptr, &frame.fence), "创建帧栅栏") ||
+            !VulkanCheck(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &frame.imageAvailable), "创建信号量") ||
+            !VulkanCheck(vkCreateCommandPool(device, &poolInfo, nullptr, &frame.commandPool), "创建命令池")) {
+            return false;
+        }
+
+        VkCommandBufferAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = frame.commandPool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+        if (!VulkanCheck(vkAllocateCommandBuffers(device, &allocInfo, &frame.commandBuffer), "分配命令缓冲")) {
+            return false;
+        }
+
+        frame.recordingPools.resize(recordingPoolCount);
+        for (RecordingPool& recordingPool : frame.recordingPools) {
+            if (!VulkanCheck(vkCreateCommandPool(device, &poolInfo, nullptr, &recordingPool.pool), "创建命令池")) {
+                return false;
+            }
+        }
+        frame.descriptors.Initialize(&m_Device, m_MaterialLayout);
+    }
+    return true;
+}
+
+bool VulkanRenderSystem::CreateDefaultTarget(int width, int height) {
+    auto target = std::make_shared<VulkanRenderTarget>(m_Device, m_RenderPasses[0], width, height);
+    if (!target->IsComplete()) {
+        std::cerr << "创建默认渲染目标失败！" << std::endl;
+        return false;
+    }
+    m_DefaultTarget = target;
+    return true;
+}
+
+void VulkanRenderSystem::BeginCommandBuffer(FrameData& frame) {
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(frame.commandBuffer, &beginInfo);
+}
+
+void VulkanRenderSystem::BeginFrame() {
+    if (!m_Initialized || m_FrameActive) {
+        return;
+    }
+
+    BeginFrameStats();
+
+    // 等待GPU用完该帧的资源后整体回收
+    FrameData& frame = GetFrame();
+    VkDevice device = m_Device.GetDevice();
+    vkWaitForFences(device, 1, &frame.fence, VK_TRUE, UINT64_MAX);
+    frame.retained.clear();
+    frame.materialUploads.clear();
+    frame.uniformUploads.clear();
+    frame.descriptors.Reset();
+    vkResetCommandPool(device, frame.commandPool, 0);
+    for (RecordingPool& recordingPool : frame.recordingPools) {
+        vkResetCommandPool(device, recordingPool.pool, 0);
+        recordingPool.used = 0;
+    }
+    m_UniformHead = m_FrameIndex * UNIFORM_FRAME_SIZE;
+    m_UniformEnd = m_UniformHead + UNIFORM_FRAME_SIZE;
+    m_GeometryHead = m_FrameIndex * GEOMETRY_FRAME_SIZE;
+    m_GeometryEnd = m_GeometryHead + GEOMETRY_FRAME_SIZE;
+    ++m_FrameSerial;
+
+    BeginCommandBuffer(frame);
+    m_Passes.clear();
+    m_Draws.clear();
+    m_CurrentTarget = nullptr;
+    BeginPass(m_DefaultTarget.get());
+    m_FrameActive = true;
+}
+
+void VulkanRenderSystem::EndFrame() {
+    if (!m_FrameActive) {
+        return;
+    }
+
+    FrameData& frame = GetFrame();
+    bool present = false;
+    bool recreate = false;
+    uint32_t imageIndex = 0;
+    if (m_Swapchain.IsValid()) {
+        VkResult result = m_Swapchain.Acquire(frame.imageAvailable, imageIndex);
+        present = result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR;
+        recreate = result == VK_ERROR_OUT_OF_DATE_KHR;
+    }
+
+    Submit(frame, present, imageIndex, false);
+    if (present) {
+        VkResult result = m_Swapchain.Present(imageIndex);
+        recreate = result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR;
+    }
+    m_FrameActive = false;
+    m_FrameIndex = (m_FrameIndex + 1) % VULKAN_FRAMES_IN_FLIGHT;
+
+    if (recreate) {
+        RecreateSwapchain();
+    }
+    EndFrameStats();
+}
+
+void VulkanRenderSystem::RecreateSwapchain() {
+    const uint32_t width = m_Window->GetWidth();
+    const uint32_t height = m_Window->GetHeight();
+    if (width == 0 || height == 0) {
+        // 窗口最小化时保持原交换链，恢复后再重建
+        return;
+    }
+
+    vkDeviceWaitIdle(m_Device.GetDevice());
+    m_Swapchain.Initialize(&m_Device, width, height, m_Config.enableVSync);
+    if (static_cast<uint32_t>(m_DefaultTarget->GetWidth()) != width || static_cast<uint32_t>(m_DefaultTarget->GetHeight()) != height) {
+        CreateDefaultTarget(static_cast<int>(width), static_cast<int>(height));
+    }
+}
+
+void VulkanRenderSystem::Clear(const Vector4& color, bool depth, bool stencil) {
+    if (!m_FrameActive) {
+        return;
+    }
+
+    // 已有绘制时另起一个通道，用渲染通道的加载操作完成清除
+    if (m_Passes.back().drawCount > 0) {
+        int32_t viewport[4];
+        std::memcpy(viewport, m_Viewport, sizeof(viewport));
+        BeginPass(m_Passes.back().target);
+        std::memcpy(m_Viewport, viewport, sizeof(viewport));
+    }
+
+    Pass& pass = m_Passes.back();
+    pass.loadFlags |= CLEAR_COLOR | (depth ? CLEAR_DEPTH : 0u) | (stencil ? CLEAR_STENCIL : 0u);
+    pass.clearColor[0] = color.x;
+    pass.clearColor[1] = color.y;
+    pass.clearColor[2] = color.z;
+    pass.clearColor[3] = color.w;
+}
+
+void VulkanRenderSystem::SetViewport(int x, int y, int width, int height) {
+    m_Viewport[0] = x;
+    m_Viewport[1] = y;
+    m_Viewport[2] = width;
+    m_Viewport[3] = height;
+}
+
+std::shared_ptr<Shader> VulkanRenderSystem::CreateShader(const std::string& vertexShaderSource, const std::string& fragmentShaderSource) {
+    auto shader = std::make_shared<VulkanShader>(m_Device, vertexShaderSource, fragmentShaderSource);
+    if (!shader->IsValid()) {
+        return nullptr;
+    }
+    // 管线创建是首次使用时的主要开销；此时对象尚未共享，可以在调用线程上完成
+    if (!shader->GetPipeline(m_PipelineCache, m_PipelineLayout, m_RenderPasses[0])) {
+        return nullptr;
+    }
+    return shader;
+}
+
+std::vector<uint8_t> VulkanRenderSystem::GetShaderBinary(const std::shared_ptr<Shader>& shader) {
+    // SPIR-V本身就是可移植的二进制，编译后的管线由管线缓存持久化
+    std::vector<uint8_t> binary;
+    auto vulkanShader = std::static_pointer_cast<VulkanShader>(shader);
+    if (!vulkanShader || !vulkanShader->IsValid()) {
+        return binary;
+    }
+    for (const std::string* code : { &vulkanShader->GetVertexSpirv(), &vulkanShader->GetFragmentSpirv() }) {
+        const uint32_t size = static_cast<uint32_t>(code->size());
+        const size_t offset = binary.size();
+        binary.resize(offset + sizeof(size) + size);
+        std::memcpy(binary.data() + offset, &size, sizeof(size));
+        std::memcpy(binary.data() + offset + sizeof(size), code->data(), size);
+    }
+    return binary;
+}
+
+std::shared_ptr<Shader> VulkanRenderSystem::CreateShaderFromBinary(const std::vector<uint8_t>& binary) {
+    std::string stages[2];
+    size_t offset = 0;
+    for (std::string& stage : stages) {
+        uint32_t size = 0;
+        if (binary.size() - offset < sizeof(size)) {
+            return nullptr;
+        }
+        std::memcpy(&size, binary.data() + offset, sizeof(size));
+        offset += sizeof(size);
+        if (binary.size() - offset < size) {
+            return nullptr;
+        }
+        stage.assign(reinterpret_cast<const char*>(binary.data() + offset), size);
+        offset += size;
+    }
+    if (!VulkanShader::IsSpirv(stages[0]) || !VulkanShader::IsSpirv(stages[1])) {
+        return nullptr;
+    }
+    return CreateShader(stages[0], stages[1]);
+}
+
+std::shared_ptr<Texture> VulkanRenderSystem::CreateTexture(int width, int height, const void* data) {
+    if (width <= 0 || height <= 0) {
+        std::cerr << "纹理尺寸无效！" << std::endl;
+        return nullptr;
+    }
+    auto texture = std::make_shared<VulkanTexture>(m_Device, width, height, data);
+    if (!texture->IsValid()) {
+        return nullptr;
+    }
+    if (data) {
+        CountUpload(static_cast<uint64_t>(width) * height * 4);
+    }
+    return texture;
+}
+
+std::shared_ptr<Texture> VulkanRenderSystem::CreateTexture(const TextureData& data) {
+    if (!data.IsValid()) {
+        std::cerr << "纹理数据无效！" << std::endl;
+        return nullptr;
+    }
+    std::shared_ptr<VulkanTexture> texture;
+    uint64_t uploadBytes = data.pixels.size();
+    if (IsTextureFormatSupported(data.format)) {
+        texture = std::make_shared<VulkanTexture>(m_Device, data);
+    } else {
+        // 设备不支持BC格式时在CPU上解码为RGBA8
+        TextureData decompressed;
+        if (!BlockCompression::DecompressTexture(data, decompressed)) {
+            std::cerr << "纹理格式不受支持且无法解码！" << std::endl;
+            return nullptr;
+        }
+        texture = std::make_shared<VulkanTexture>(m_Device, decompressed);
+        uploadBytes = decompressed.pixels.size();
+    }
+    if (!texture->IsValid()) {
+        return nullptr;
+    }
+    CountUpload(uploadBytes);
+    return texture;
+}
+
+bool VulkanRenderSystem::IsTextureFormatSupported(TextureFormat format) const {
+    return format == TextureFormat::RGBA8 || m_Device.IsBlockCompressionSupported();
+}
+
+std::shared_ptr<Mesh> VulkanRenderSystem::CreateMesh(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) {
+    return CreateMesh(vertices, vertexCount, VertexLayout::Standard(), indices, indexCount);
+}
+
+std::shared_ptr<Mesh> VulkanRenderSystem::CreateMesh(const void* vertices, uint32_t vertexCount, const VertexLayout& layout,
+                                                     const uint32_t* indices, uint32_t indexCount) {
+    if (!vertices || vertexCount == 0) {
+        std::cerr << "网格顶点数据为空！" << std::endl;
+        return nullptr;
+    }
+    if (!layout.IsValid()) {
+        std::cerr << "网格顶点布局无效！" << std::endl;
+        return nullptr;
+    }
+    auto mesh = std::make_shared<VulkanMesh>(m_Device, vertices, vertexCount, layout, indices, indexCount);
+    if (!mesh->IsValid()) {
+        return nullptr;
+    }
+    CountUpload(static_cast<uint64_t>(vertexCount) * layout.stride + (indices ? indexCount * sizeof(uint32_t) : 0));
+    return mesh;
+}
+
+std::shared_ptr<Mesh> VulkanRenderSystem::CreateTransientMesh(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) {
+    return CreateTransientMesh(vertices, vertexCount, VertexLayout::Standard(), indices, indexCount);
+}
+
+std::shared_ptr<Mesh> VulkanRenderSystem::CreateTransientMesh(const void* vertices, uint32_t vertexCount, const VertexLayout& layout,
+                                                              const uint32_t* indices, uint32_t indexCount) {
+    if (!vertices || vertexCount == 0) {
+        std::cerr << "网格顶点数据为空！" << std::endl;
+        return nullptr;
+    }
+    if (!layout.IsValid()) {
+        std::cerr << "网格顶点布局无效！" << std::endl;
+        return nullptr;
+    }
+    if (!m_FrameActive) {
+        std::cerr << "瞬态网格只能在BeginFrame和EndFrame之间创建！" << std::endl;
+        return nullptr;
+    }
+    if (!indices) {
+        indexCount = 0;
+    }
+
+    uint32_t vertexOffset = 0;
+    uint32_t indexOffset = 0;
+    const uint32_t vertexBytes = vertexCount * layout.stride;
+    const uint32_t indexBytes = indexCount * static_cast<uint32_t>(sizeof(uint32_t));
+    void* vertexDestination = AllocateGeometry(vertexBytes, layout.stride, vertexOffset);
+    void* indexDestination = indexCount > 0 ? AllocateGeometry(indexBytes, sizeof(uint32_t), indexOffset) : nullptr;
+    if (!vertexDestination || (indexCount > 0 && !indexDestination)) {
+        std::cerr << "本帧的瞬态几何缓冲区已用完！" << std::endl;
+        return nullptr;
+    }
+    std::memcpy(vertexDestination, vertices, vertexBytes);
+    if (indexCount > 0) {
+        std::memcpy(indexDestination, indices, indexBytes);
+    }
+
+    return std::make_shared<VulkanMesh>(m_Device, vertexCount, indexCount, layout, m_GeometryBuffer, vertexOffset / layout.stride,
+                                        indexOffset / static_cast<uint32_t>(sizeof(uint32_t)), m_FrameSerial);
+}
+
+std::shared_ptr<Material> VulkanRenderSystem::CreateMaterial(std::shared_ptr<Shader> shader) {
+    if (!shader) {
+        std::cerr << "创建材质需要有效的着色器！" << std::endl;
+        return nullptr;
+    }
+    return std::make_shared<VulkanMaterial>(shader);
+}
+
+std::shared_ptr<Material> VulkanRenderSystem::CreateMaterialInstance(std::shared_ptr<Material> parent) {
+    if (!parent) {
+        std::cerr << "创建材质实例需要有效的父材质！" << std::endl;
+        return nullptr;
+    }
+    return std::make_shared<VulkanMaterial>(parent);
+}
+
+std::shared_ptr<RenderTarget> VulkanRenderSystem::CreateRenderTarget(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        std::cerr << "渲染目标尺寸无效！" << std::endl;
+        return nullptr;
+    }
+    auto renderTarget = std::make_shared<VulkanRenderTarget>(m_Device, m_RenderPasses[0], width, height);
+    if (!renderTarget->IsComplete()) {
+        return nullptr;
+    }
+    return renderTarget;
+}
+
+void VulkanRenderSystem::BeginPass(VulkanRenderTarget* target) {
+    Pass pass = {};
+    pass.target = target;
+    pass.firstDraw = static_cast<uint32_t>(m_Draws.size());
+    m_Passes.push_back(pass);
+    SetViewport(0, 0, target->GetWidth(), target->GetHeight());
+}
+
+void VulkanRenderSystem::SetRenderTarget(std::shared_ptr<RenderTarget> renderTarget) {
+    if (!m_Initialized) {
+        return;
+    }
+    m_CurrentTarget = renderTarget;
+    VulkanRenderTarget* target = renderTarget ? static_cast<VulkanRenderTarget*>(renderTarget.get()) : m_DefaultTarget.get();
+    if (!m_FrameActive) {
+        SetViewport(0, 0, target->GetWidth(), target->GetHeight());
+        return;
+    }
+
+    GetFrame().retained.push_back(renderTarget);
+    Pass& pass = m_Passes.back();
+    if (pass.drawCount == 0 && pass.loadFlags == 0) {
+        // 空通道直接改换目标，不产生多余的渲染通道
+        pass.target = target;
+        SetViewport(0, 0, target->GetWidth(), target->GetHeight());
+    } else {
+        BeginPass(target);
+    }
+}
+
+void* VulkanRenderSystem::AllocateUniform(uint32_t size, uint32_t& offset) {
+    const uint32_t aligned = (m_UniformHead + m_UniformAlignment - 1) & ~(m_UniformAlignment - 1);
+    if (aligned + size > m_UniformEnd) {
+        if (!m_UniformOverflowReported) {
+            std::cerr << "每帧uniform缓冲区已用完，后续绘制被丢弃！" << std::endl;
+            m_UniformOverflowReported = true;
+        }
+        return nullptr;
+    }
+    offset = aligned;
+    m_UniformHead = aligned + size;
+    CountUpload(size);
+    return m_UniformMapped + aligned;
+}
+
+void* VulkanRenderSystem::AllocateGeometry(uint32_t size, uint32_t alignment, uint32_t& offset) {
+    // 顶点按步长对齐，偏移总能换算为基础顶点序号
+    const uint32_t aligned = (m_GeometryHead + alignment - 1) / alignment * alignment;
+    if (aligned + size > m_GeometryEnd) {
+        return nullptr;
+    }
+    offset = aligned;
+    m_GeometryHead = aligned + size;
+    CountUpload(size);
+    return m_GeometryMapped + aligned;
+}
+
+bool VulkanRenderSystem::UploadMaterial(FrameData& frame, const std::shared_ptr<VulkanMaterial>& material, MaterialUpload& upload) {
+    VulkanMaterial* owner = material->GetUniformOwner();
+    const uint64_t uniformVersion = owner->GetUniformVersion();
+    auto it = frame.materialUploads.find(material->GetId());
+    if (it != frame.materialUploads.end() && it->second.version == material->GetVersion() &&
+        it->second.uniformVersion == uniformVersion) {
+        upload = it->second;
+        return true;
+    }
+
+    // 每帧的环形缓冲区在帧结束后回收，参数在首次使用时复制一次，
+    // 之后的绘制以及共享同一参数块的实例复用偏移
+    const uint32_t uniformSize = owner->GetUniformSize();
+    uint32_t offset = 0;
+    auto uniform = frame.uniformUploads.find(owner->GetId());
+    if (uniform != frame.uniformUploads.end() && uniform->second.version == uniformVersion) {
+        offset = uniform->second.offset;
+    } else {
+        auto* destination = static_cast<uint8_t*>(AllocateUniform(uniformSize, offset));
+        if (!destination) {
+            return false;
+        }
+        owner->PackUniforms(destination);
+        frame.uniformUploads[owner->GetId()] = { uniformVersion, offset };
+    }
+
+    VulkanDescriptorCache::Key key;
+    key.uniformBuffer = m_UniformBuffer;
+    key.uniformSize = uniformSize;
+    const std::vector<std::shared_ptr<VulkanTexture>>& textures = material->GetTextures();
+    for (uint32_t i = 0; i < VULKAN_MAX_MATERIAL_TEXTURES; ++i) {
+        const bool bound = i < textures.size() && textures[i] && textures[i]->IsValid();
+        key.views[i] = bound ? textures[i]->GetView() : m_WhiteTexture->GetView();
+        if (bound) {
+            frame.retained.push_back(textures[i]);
+        }
+    }
+    VkDescriptorSet set = frame.descriptors.GetMaterialSet(key, m_Device.GetDefaultSampler());
+    if (!set) {
+        return false;
+    }
+
+    upload = { material->GetVersion(), uniformVersion, offset, set };
+    frame.materialUploads[material->GetId()] = upload;
+    frame.retained.push_back(material);
+    return true;
+}
+
+void VulkanRenderSystem::DrawMesh(std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material, const Matrix4& transform) {
+    if (!m_FrameActive || !mesh || !material) {
+        return;
+    }
+
+    auto vulkanMesh = std::static_pointer_cast<VulkanMesh>(mesh);
+    if (vulkanMesh->IsTransient() && vulkanMesh->GetFrameSerial() != m_FrameSerial) {
+        std::cerr << "瞬态网格只能在创建它的帧内绘制！" << std::endl;
+        return;
+    }
+    auto vulkanMaterial = std::static_pointer_cast<VulkanMaterial>(material);
+    auto shader = std::static_pointer_cast<VulkanShader>(material->GetShader());
+    if (!shader || !shader->IsValid()) {
+        return;
+    }
+    VkPipeline pipeline = shader->GetPipeline(m_PipelineCache, m_PipelineLayout, m_RenderPasses[0], mesh->GetVertexLayout());
+    if (!pipeline) {
+        return;
+    }
+
+    FrameData& frame = GetFrame();
+    MaterialUpload upload;
+    if (!UploadMaterial(frame, vulkanMaterial, upload)) {
+        return;
+    }
+
+    uint32_t perDrawOffset = 0;
+    auto* perDraw = static_cast<PerDrawData*>(AllocateUniform(sizeof(PerDrawData), perDrawOffset));
+    if (!perDraw) {
+        return;
+    }
+    // 行向量约定：MVP = Model * View * Projection，量化位置的解码合并在模型矩阵中
+    const Matrix4 model = mesh->GetModelMatrix(transform);
+    const Matrix4 modelViewProjection = model * m_ViewProjection;
+    std::memcpy(perDraw->model, model.m.data(), sizeof(perDraw->model));
+    std::memcpy(perDraw->viewProjection, m_ViewProjection.m.data(), sizeof(perDraw->viewProjection));
+    std::memcpy(perDraw->modelViewProjection, modelViewProjection.m.data(), sizeof(perDraw->modelViewProjection));
+
+    // 录制时相邻绘制相同的管线不重复绑定；材质描述符集变化时重新绑定其中的纹理
+    const Pass& pass = m_Passes.back();
+    const DrawRecord* previous = pass.drawCount > 0 ? &m_Draws.back() : nullptr;
+    if (!previous || previous->pipeline != pipeline) {
+        ++m_Stats.shaderBinds;
+    }
+    if (!previous || previous->materialSet != upload.set) {
+        for (const std::shared_ptr<VulkanTexture>& texture : vulkanMaterial->GetTextures()) {
+            m_Stats.textureBinds += texture ? 1 : 0;
+        }
+    }
+    CountDraw(material.get(), mesh->GetTriangleCount());
+
+    DrawRecord record;
+    record.pipeline = pipeline;
+    record.vertexBuffer = vulkanMesh->GetVertexBuffer();
+    record.indexBuffer = vulkanMesh->GetIndexBuffer();
+    record.materialSet = upload.set;
+    record.perDrawOffset = perDrawOffset;
+    record.materialOffset = upload.offset;
+    record.count = mesh->GetIndexCount() > 0 ? mesh->GetIndexCount() : mesh->GetVertexCount();
+    record.firstIndex = vulkanMesh->GetFirstIndex();
+    record.vertexOffset = static_cast<int32_t>(vulkanMesh->GetBaseVertex());
+    std::memcpy(record.viewport, m_Viewport, sizeof(record.viewport));
+    m_Draws.push_back(record);
+    ++m_Passes.back().drawCount;
+    frame.retained.push_back(mesh);
+}
+
+VkCommandBuffer VulkanRenderSystem::RecordSecondary(RecordingPool& pool, const Pass& pass, uint32_t firstDraw, uint32_t drawCount) {
+    if (pool.used == pool.buffers.size()) {
+        VkCommandBufferAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = pool.pool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandBufferCount = 1;
+        VkCommandBuffer buffer = VK_NULL_HANDLE;
+        if (!VulkanCheck(vkAllocateCommandBuffers(m_Device.GetDevice(), &allocInfo, &buffer), "分配二级命令缓冲")) {
+            return VK_NULL_HANDLE;
+        }
+        pool.buffers.push_back(buffer);
+    }
+    VkCommandBuffer commandBuffer = pool.buffers[pool.used++];
+
+    VkCommandBufferInheritanceInfo inheritance = {};
+    inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritance.renderPass = m_RenderPasses[pass.loadFlags];
+    inheritance.subpass = 0;
+    inheritance.framebuffer = pass.target->GetFramebuffer();
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    beginInfo.pInheritanceInfo = &inheritance;
+    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+    const int32_t targetHeight = pass.target->GetHeight();
+    VkRect2D scissor = { { 0, 0 }, { static_cast<uint32_t>(pass.target->GetWidth()), static_cast<uint32_t>(targetHeight) } };
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    const int32_t* currentViewport = nullptr;
+    VkPipeline currentPipeline = VK_NULL_HANDLE;
+    VkBuffer currentVertexBuffer = VK_NULL_HANDLE;
+    VkBuffer currentIndexBuffer = VK_NULL_HANDLE;
+    for (uint32_t i = firstDraw; i < firstDraw + drawCount; ++i) {
+        const DrawRecord& draw = m_Draws[i];
+        if (!currentViewport || std::memcmp(currentViewport, draw.viewport, sizeof(draw.viewport)) != 0) {
+            // 负高度视口：原点在左下角，与OpenGL一致
+            VkViewport viewport;
+            viewport.x = static_cast<float>(draw.viewport[0]);
+            viewport.y = static_cast<float>(targetHeight - draw.viewport[1]);
+            viewport.width = static_cast<float>(draw.viewport[2]);
+            viewport.height = -static_cast<float>(draw.viewport[3]);
+            viewport.minDepth = 0.0f;
+            viewport.maxDepth = 1.0f;
+            vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+            currentViewport = draw.viewport;
+        }
+        if (draw.pipeline != currentPipeline) {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, draw.pipeline);
+            currentPipeline = draw.pipeline;
+        }
+
+        const VkDescriptorSet sets[] = { m_PerDrawSet, draw.materialSet };
+        const uint32_t dynamicOffsets[] = { draw.perDrawOffset, draw.materialOffset };
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_PipelineLayout, 0, 2, sets, 2, dynamicOffsets);
+
+        if (draw.vertexBuffer != currentVertexBuffer) {
+            const VkDeviceSize offset = 0;
+            vkCmdBindVertexBuffers(commandBuffer, 0, 1, &draw.vertexBuffer, &offset);
+            currentVertexBuffer = draw.vertexBuffer;
+        }
+        if (draw.indexBuffer) {
+            if (draw.indexBuffer != currentIndexBuffer) {
+                vkCmdBindIndexBuffer(commandBuffer, draw.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+                currentIndexBuffer = draw.indexBuffer;
+            }
+            vkCmdDrawIndexed(commandBuffer, draw.count, 1, draw.firstIndex, draw.vertexOffset, 0);
+        } else {
+            vkCmdDraw(commandBuffer, draw.count, 1, static_cast<uint32_t>(draw.vertexOffset), 0);
+        }
+    }
+
+    if (!VulkanCheck(vkEndCommandBuffer(commandBuffer), "录制二级命令缓冲")) {
+        return VK_NULL_HANDLE;
+    }
+    return commandBuffer;
+}
+
+void VulkanRenderSystem::RecordPasses(FrameData& frame) {
+    JobSystem& jobSystem = JobSystem::GetInstance();
+    const uint32_t poolCount = static_cast<uint32_t>(frame.recordingPools.size());
+
+    // 所有通道的绘制先切成块再一起录制：多视图时每个通道的绘制不多，通道之间也能并行
+    std::vector<RecordingChunk> chunks;
+    for (uint32_t passIndex = 0; passIndex < m_Passes.size(); ++passIndex) {
+        const Pass& pass = m_Passes[passIndex];
+        if (pass.drawCount == 0) {
+            continue;
+        }
+        const uint32_t chunkCount = std::min(poolCount, (pass.drawCount + MIN_DRAWS_PER_CHUNK - 1) / MIN_DRAWS_PER_CHUNK);
+        const uint32_t drawsPerChunk = (pass.drawCount + chunkCount - 1) / chunkCount;
+        for (uint32_t first = 0; first < pass.drawCount; first += drawsPerChunk) {
+            chunks.push_back({ passIndex, pass.firstDraw + first, std::min(drawsPerChunk, pass.drawCount - first), VK_NULL_HANDLE });
+        }
+    }
+
+    // 块按轮转分给命令池，每个命令池只在一个任务中使用（命令池不能跨线程共享）
+    const uint32_t chunkTotal = static_cast<uint32_t>(chunks.size());
+    const uint32_t jobCount = std::min(poolCount, chunkTotal);
+    jobSystem.ParallelFor(jobCount, 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t job = begin; job < end; ++job) {
+            for (uint32_t index = job; index < chunkTotal; index += jobCount) {
+                RecordingChunk& chunk = chunks[index];
+                chunk.buffer = RecordSecondary(frame.recordingPools[job], m_Passes[chunk.pass], chunk.firstDraw, chunk.drawCount);
+            }
+        }
+    });
+
+    std::vector<VkCommandBuffer> secondaries;
+    uint32_t nextChunk = 0;
+    for (uint32_t passIndex = 0; passIndex < m_Passes.size(); ++passIndex) {
+        const Pass& pass = m_Passes[passIndex];
+        secondaries.clear();
+        for (; nextChunk < chunkTotal && chunks[nextChunk].pass == passIndex; ++nextChunk) {
+            if (chunks[nextChunk].buffer != VK_NULL_HANDLE) {
+                secondaries.push_back(chunks[nextChunk].buffer);
+            }
+        }
+        if (pass.drawCount == 0 && pass.loadFlags == 0) {
+            continue;
+        }
+
+        VkClearValue clearValues[2];
+        std::memcpy(clearValues[0].color.float32, pass.clearColor, sizeof(pass.clearColor));
+        clearValues[1].depthStencil = { 1.0f, 0 };
+        VkRenderPassBeginInfo beginInfo = {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        beginInfo.renderPass = m_RenderPasses[pass.loadFlags];
+        beginInfo.framebuffer = pass.target->GetFramebuffer();
+        beginInfo.renderArea = { { 0, 0 }, { static_cast<uint32_t>(pass.target->GetWidth()), static_cast<uint32_t>(pass.target->GetHeight()) } };
+        beginInfo.clearValueCount = 2;
+        beginInfo.pClearValues = clearValues;
+
+        if (secondaries.empty()) {
+            vkCmdBeginRenderPass(frame.commandBuffer, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+        } else {
+            vkCmdBeginRenderPass(frame.commandBuffer, &beginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+            vkCmdExecuteCommands(frame.commandBuffer, static_cast<uint32_t>(secondaries.size()), secondaries.data());
+        }
+        vkCmdEndRenderPass(frame.commandBuffer);
+    }
+
+    // 已录制的通道清空，后续绘制继续在当前目标上加载原内容
+    VulkanRenderTarget* target = m_Passes.empty() ? m_DefaultTarget.get() : m_Passes.back().target;
+    int32_t viewport[4];
+    std::memcpy(viewport, m_Viewport, sizeof(viewport));
+    m_Passes.clear();
+    m_Draws.clear();
+    BeginPass(target);
+    std::memcpy(m_Viewport, viewport, sizeof(viewport));
+}
+
+void VulkanRenderSystem::RecordPresentBlit(FrameData& frame, uint32_t imageIndex) {
+    VkCommandBuffer commandBuffer = frame.commandBuffer;
+    VkImage source = m_DefaultTarget->GetColorImage();
+    VkImage destination = m_Swapchain.GetImage(imageIndex);
+
+    VulkanImageBarrier(commandBuffer, destination, VK_IMAGE_ASPECT_COLOR_BIT, 0, 1,
+                       VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+    VulkanImageBarrier(commandBuffer, source, VK_IMAGE_ASPECT_COLOR_BIT, 0, 1,
+                       VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                       VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+
+    // 复制时由驱动完成RGBA到交换链格式的转换
+    const VkExtent2D extent = m_Swapchain.GetExtent();
+    VkImageBlit blit = {};
+    blit.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+    blit.srcOffsets[1] = { m_DefaultTarget->GetWidth(), m_DefaultTarget->GetHeight(), 1 };
+    blit.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+    blit.dstOffsets[1] = { static_cast<int32_t>(extent.width), static_cast<int32_t>(extent.height), 1 };
+    vkCmdBlitImage(commandBuffer, source, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, destination, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+
+    VulkanImageBarrier(commandBuffer, destination, VK_IMAGE_ASPECT_COLOR_BIT, 0, 1,
+                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                       VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0);
+    VulkanImageBarrier(commandBuffer, source, VK_IMAGE_ASPECT_COLOR_BIT, 0, 1,
+                       VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                       VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0);
+}
+
+bool VulkanRenderSystem::Submit(FrameData& frame, bool present, uint32_t imageIndex, bool wait) {
+    VkDevice device = m_Device.GetDevice();
+    RecordPasses(frame);
+    if (present) {
+        RecordPresentBlit(frame, imageIndex);
+    }
+    if (!VulkanCheck(vkEndCommandBuffer(frame.commandBuffer), "录制命令缓冲")) {
+        return false;
+    }
+
+    const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    VkSemaphore renderFinished = present ? m_Swapchain.GetRenderFinishedSemaphore(imageIndex) : VK_NULL_HANDLE;
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &frame.commandBuffer;
+    if (present) {
+        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.pWaitSemaphores = &frame.imageAvailable;
+        submitInfo.pWaitDstStageMask = &waitStage;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &renderFinished;
+    }
+
+    vkResetFences(device, 1, &frame.fence);
+    VkResult result;
+    {
+        std::lock_guard<std::mutex> lock(m_Device.GetQueueMutex());
+        result = vkQueueSubmit(m_Device.GetGraphicsQueue(), 1, &submitInfo, frame.fence);
+    }
+    if (!VulkanCheck(result, "提交命令缓冲")) {
+        for (const auto& readback : m_PendingReadbacks) {
+            readback->Cancel();
+        }
+        m_PendingReadbacks.clear();
+        return false;
+    }
+
+    // 本次提交包含的异步读回：紧接着提交各自的栅栏
+    for (const auto& readback : m_PendingReadbacks) {
+        readback->Submit();
+    }
+    m_PendingReadbacks.clear();
+
+    if (wait) {
+        // 帧中途同步（读回像素）：等待完成后重新开始录制，帧内已分配的uniform和描述符集保持有效
+        vkWaitForFences(device, 1, &frame.fence, VK_TRUE, UINT64_MAX);
+        vkResetCommandPool(device, frame.commandPool, 0);
+        for (RecordingPool& recordingPool : frame.recordingPools) {
+            vkResetCommandPool(device, recordingPool.pool, 0);
+            recordingPool.used = 0;
+        }
+        BeginCommandBuffer(frame);
+    }
+    return true;
+}
+
+void VulkanRenderSystem::SetCamera(std::shared_ptr<Camera> camera) {
+    m_Camera = camera;
+    if (camera) {
+        SetViewProjection(camera->GetViewMatrix(), camera->GetProjectionMatrix());
+    }
+}
+
+void VulkanRenderSystem::SetViewProjection(const Matrix4& view, const Matrix4& projection) {
+    m_View = view;
+    m_Projection = projection;
+    m_ViewProjection = view * projection;
+}
+
+bool VulkanRenderSystem::ReadPixels(int x, int y, int width, int height, void* rgba8) {
+    if (!m_Initialized || !rgba8 || width <= 0 || height <= 0) {
+        return false;
+    }
+    VulkanRenderTarget* target = m_CurrentTarget ? static_cast<VulkanRenderTarget*>(m_CurrentTarget.get()) : m_DefaultTarget.get();
+    if (x < 0 || y < 0 || x + width > target->GetWidth() || y + height > target->GetHeight()) {
+        return false;
+    }
+
+    const VkDeviceSize rowSize = static_cast<VkDeviceSize>(width) * 4;
+    const VkDeviceSize size = rowSize * static_cast<VkDeviceSize>(height);
+    VkBuffer staging = VK_NULL_HANDLE;
+    VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+    if (!m_Device.CreateBuffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, staging, stagingMemory)) {
+        return false;
+    }
+
+    bool copied;
+    if (m_FrameActive) {
+        // 先提交本帧已记录的绘制，再在同一命令缓冲中复制
+        FrameData& frame = GetFrame();
+        RecordPasses(frame);
+        RecordReadback(frame.commandBuffer, target, x, y, width, height, staging);
+        copied = Submit(frame, false, 0, true);
+    } else {
+        copied = m_Device.ImmediateSubmit([&](VkCommandBuffer commandBuffer) {
+            RecordReadback(commandBuffer, target, x, y, width, height, staging);
+        });
+    }
+
+    if (copied) {
+        void* mapped = nullptr;
+        vkMapMemory(m_Device.GetDevice(), stagingMemory, 0, size, 0, &mapped);
+        const uint8_t* source = static_cast<const uint8_t*>(mapped);
+        uint8_t* destination = static_cast<uint8_t*>(rgba8);
+        for (int row = 0; row < height; ++row) {
+            std::memcpy(destination + rowSize * row, source + rowSize * (height - 1 - row), static_cast<size_t>(rowSize));
+        }
+        vkUnmapMemory(m_Device.GetDevice(), stagingMemory);
+    }
+    vkDestroyBuffer(m_Device.GetDevice(), staging, nullptr);
+    vkFreeMemory(m_Device.GetDevice(), stagingMemory, nullptr);
+    return copied;
+}
+
+std::shared_ptr<ReadbackBuffer> VulkanRenderSystem::CreateReadbackBuffer(int width, int height) {
+    if (!m_Initialized || width <= 0 || height <= 0) {
+        std::cerr << "读回缓冲区尺寸无效！" << std::endl;
+        return nullptr;
+    }
+    auto buffer = std::make_shared<VulkanReadbackBuffer>(m_Device, width, height);
+    if (!buffer->IsValid()) {
+        return nullptr;
+    }
+    return buffer;
+}
+
+bool VulkanRenderSystem::ReadPixelsAsync(int x, int y, const std::shared_ptr<ReadbackBuffer>& buffer) {
+    if (!m_Initialized || !buffer) {
+        return false;
+    }
+    VulkanRenderTarget* target = m_CurrentTarget ? static_cast<VulkanRenderTarget*>(m_CurrentTarget.get()) : m_DefaultTarget.get();
+    const int width = buffer->GetWidth();
+    const int height = buffer->GetHeight();
+    if (x < 0 || y < 0 || x + width > target->GetWidth() || y + height > target->GetHeight()) {
+        return false;
+    }
+
+    auto readback = std::static_pointer_cast<VulkanReadbackBuffer>(buffer);
+    const bool pending = readback->IsRecorded();
+    readback->BeginRecording();
+    if (!m_FrameActive) {
+        const bool copied = m_Device.ImmediateSubmit([&](VkCommandBuffer commandBuffer) {
+            RecordReadback(commandBuffer, target, x, y, width, height, readback->GetBuffer());
+        });
+        if (!copied) {
+            readback->Cancel();
+            return false;
+        }
+        return readback->Submit();
+    }
+
+    // 与ReadPixels相同，先录制本帧已记录的绘制，但不提交也不等待；栅栏随帧提交
+    FrameData& frame = GetFrame();
+    RecordPasses(frame);
+    RecordReadback(frame.commandBuffer, target, x, y, width, height, readback->GetBuffer());
+    frame.retained.push_back(readback);
+    if (!pending) {
+        m_PendingReadbacks.push_back(readback);
+    }
+    return true;
+}
+
+void VulkanRenderSystem::RecordReadback(VkCommandBuffer commandBuffer, VulkanRenderTarget* target, int x, int y, int width, int height,
+                                        VkBuffer buffer) {
+    VkImage image = target->GetColorImage();
+    VulkanImageBarrier(commandBuffer, image, VK_IMAGE_ASPECT_COLOR_BIT, 0, 1,
+                       VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                       VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+
+    // 图像行自上而下存放，参数中的y从底部算起
+    VkBufferImageCopy region = {};
+    region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+    region.imageOffset = { x, target->GetHeight() - y - height, 0 };
+    region.imageExtent = { static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1 };
+    vkCmdCopyImageToBuffer(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, buffer, 1, &region);
+
+    VulkanImageBarrier(commandBuffer, image, VK_IMAGE_ASPECT_COLOR_BIT, 0, 1,
+                       VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                       VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0);
+
+    VkBufferMemoryBarrier hostBarrier = {};
+    hostBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    hostBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    hostBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    hostBarrier.buffer = buffer;
+    hostBarrier.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &hostBarrier, 0, nullptr);
+}
+
+std::string VulkanRenderSystem::GetGPUInfo() const {
+    return m_Device.GetProperties().deviceName;
+}
+
+std::string VulkanRenderSystem::GetAPIVersion() const {
+    const uint32_t version = m_Device.GetProperties().apiVersion;
+    return "Vulkan " + std::to_string(VK_VERSION_MAJOR(version)) + "." + std::to_string(VK_VERSION_MINOR(version)) + "." + std::to_string(VK_VERSION_PATCH(version));
+}
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_VULKAN
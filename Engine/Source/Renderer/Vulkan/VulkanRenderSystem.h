@@ -0,0 +1,258 @@
+/**
+ * @file VulkanRenderSystem.h
+ * @brief Vulkan渲染系统
+ */
+
+#pragma once
+
+#include "VulkanCommon.h"
+
+#ifdef PLE_RENDERER_VULKAN
+
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Renderer/RenderSystem.h"
+#include "VulkanDescriptorCache.h"
+#include "VulkanDevice.h"
+#include "VulkanPipelineCache.h"
+#include "VulkanSwapchain.h"
+
+namespace PLE {
+
+class VulkanMaterial;
+class VulkanReadbackBuffer;
+class VulkanRenderTarget;
+class VulkanTexture;
+
+/**
+ * @brief Vulkan渲染系统
+ *
+ * DrawMesh只在调用线程上解析管线、写入每次绘制的uniform并查找描述符集，
+ * 生成紧凑的绘制记录；真正的命令录制推迟到渲染目标切换之后的提交阶段：
+ * 所有渲染通道的绘制记录被切成若干块，由任务系统一起并行录制到二级命令缓冲
+ * （多视图时每个通道的绘制不多，通道之间也并行），每块使用自己的命令池
+ * （命令池不能跨线程共享），主命令缓冲只负责开始渲染通道并执行这些二级命令缓冲。
+ *
+ * 着色器约定（GLSL编译为SPIR-V后传入CreateShader）：
+ * - set 0, binding 0：uniform块PLE_PerDraw（u_Model、u_ViewProjection、u_ModelViewProjection）
+ * - set 1, binding 0：材质参数uniform块（std140，按参数首次设置的顺序）
+ * - set 1, binding 1..8：材质纹理（按纹理首次设置的顺序）
+ * CreateShader会立即创建管线（可在任意线程调用），首次绘制时不再卡顿。
+ * 视口使用负高度，裁剪空间、深度范围和ReadPixels的行顺序都与OpenGL后端一致。
+ */
+class VulkanRenderSystem : public RenderSystem {
+public:
+    explicit VulkanRenderSystem(const RenderSystemConfig& config);
+    ~VulkanRenderSystem() override;
+
+    bool Initialize(std::shared_ptr<Window> window) override;
+    void Shutdown() override;
+
+    void BeginFrame() override;
+    void EndFrame() override;
+
+    void Clear(const Vector4& color, bool depth = true, bool stencil = true) override;
+    void SetViewport(int x, int y, int width, int height) override;
+
+    std::shared_ptr<Shader> CreateShader(const std::string& vertexShaderSource, const std::string& fragmentShaderSource) override;
+    std::vector<uint8_t> GetShaderBinary(const std::shared_ptr<Shader>& shader) override;
+    std::shared_ptr<Shader> CreateShaderFromBinary(const std::vector<uint8_t>& binary) override;
+    bool AttachWorkerThread() override { return m_Initialized; }
+    void DetachWorkerThread() override {}
+    std::shared_ptr<Texture> CreateTexture(int width, int height, const void* data) override;
+    std::shared_ptr<Texture> CreateTexture(const TextureData& data) override;
+    bool IsTextureFormatSupported(TextureFormat format) const override;
+    std::shared_ptr<Mesh> CreateMesh(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) override;
+    std::shared_ptr<Mesh> CreateMesh(const void* vertices, uint32_t vertexCount, const VertexLayout& layout,
+                                     const uint32_t* indices, uint32_t indexCount) override;
+    std::shared_ptr<Mesh> CreateTransientMesh(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) override;
+    std::shared_ptr<Mesh> CreateTransientMesh(const void* vertices, uint32_t vertexCount, const VertexLayout& layout,
+                                              const uint32_t* indices, uint32_t indexCount) override;
+    std::shared_ptr<Material> CreateMaterial(std::shared_ptr<Shader> shader) override;
+    std::shared_ptr<Material> CreateMaterialInstance(std::shared_ptr<Material> parent) override;
+    std::shared_ptr<RenderTarget> CreateRenderTarget(int width, int height) override;
+
+    void SetRenderTarget(std::shared_ptr<RenderTarget> renderTarget) override;
+    void DrawMesh(std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material, const Matrix4& transform) override;
+
+    void SetCamera(std::shared_ptr<Camera> camera) override;
+    void SetViewProjection(const Matrix4& view, const Matrix4& projection) override;
+    bool ReadPixels(int x, int y, int width, int height, void* rgba8) override;
+    std::shared_ptr<ReadbackBuffer> CreateReadbackBuffer(int width, int height) override;
+    bool ReadPixelsAsync(int x, int y, const std::shared_ptr<ReadbackBuffer>& buffer) override;
+
+    uint32_t GetFramesInFlight() const override { return VULKAN_FRAMES_IN_FLIGHT; }
+    RenderAPI GetAPI() const override { return RenderAPI::Vulkan; }
+    std::string GetGPUInfo() const override;
+    std::string GetAPIVersion() const override;
+
+private:
+    /**
+     * @brief 每次绘制的uniform块（std140）
+     */
+    struct PerDrawData {
+        float model[16];
+        float viewProjection[16];
+        float modelViewProjection[16];
+    };
+
+    /**
+     * @brief 已解析的绘制记录，录制线程只读
+     */
+    struct DrawRecord {
+        VkPipeline pipeline;
+        VkBuffer vertexBuffer;
+        VkBuffer indexBuffer;
+        VkDescriptorSet materialSet;
+        uint32_t perDrawOffset;
+        uint32_t materialOffset;
+        uint32_t count;
+        uint32_t firstIndex;
+        int32_t vertexOffset;
+        int32_t viewport[4];
+    };
+
+    /**
+     * @brief 一个渲染通道：同一目标上连续的绘制
+     */
+    struct Pass {
+        VulkanRenderTarget* target;
+        uint32_t loadFlags;            // 需要清除的附件（CLEAR_*位）
+        float clearColor[4];
+        uint32_t firstDraw;
+        uint32_t drawCount;
+    };
+
+    /**
+     * @brief 一个录制块：某个通道中连续的一段绘制，录制到一个二级命令缓冲
+     */
+    struct RecordingChunk {
+        uint32_t pass;
+        uint32_t firstDraw;
+        uint32_t drawCount;
+        VkCommandBuffer buffer;
+    };
+
+    /**
+     * @brief 每个录制块独占的二级命令池
+     */
+    struct RecordingPool {
+        VkCommandPool pool = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer> buffers;
+        uint32_t used = 0;
+    };
+
+    /**
+     * @brief 本帧已上传的材质参数
+     */
+    struct MaterialUpload {
+        uint32_t version;
+        uint64_t uniformVersion;
+        uint32_t offset;
+        VkDescriptorSet set;
+    };
+
+    /**
+     * @brief 本帧已上传的uniform数据，共享参数块的材质实例只上传一次
+     */
+    struct UniformUpload {
+        uint64_t version;
+        uint32_t offset;
+    };
+
+    /**
+     * @brief 在途帧的资源
+     */
+    struct FrameData {
+        VkFence fence = VK_NULL_HANDLE;
+        VkSemaphore imageAvailable = VK_NULL_HANDLE;
+        VkCommandPool commandPool = VK_NULL_HANDLE;
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        std::vector<RecordingPool> recordingPools;
+        VulkanDescriptorCache descriptors;
+        std::unordered_map<uint64_t, MaterialUpload> materialUploads;
+        std::unordered_map<uint64_t, UniformUpload> uniformUploads;
+        std::vector<std::shared_ptr<void>> retained;   // GPU用完前必须存活的资源
+    };
+
+    static constexpr uint32_t CLEAR_COLOR = 1;
+    static constexpr uint32_t CLEAR_DEPTH = 2;
+    static constexpr uint32_t CLEAR_STENCIL = 4;
+
+    bool CreateRenderPasses();
+    bool CreateLayouts();
+    bool CreateFrames();
+    bool CreateUniformBuffer();
+    bool CreateGeometryBuffer();
+    bool CreateDefaultTarget(int width, int height);
+
+    FrameData& GetFrame() { return m_Frames[m_FrameIndex]; }
+    void BeginCommandBuffer(FrameData& frame);
+    void BeginPass(VulkanRenderTarget* target);
+    void* AllocateUniform(uint32_t size, uint32_t& offset);
+    void* AllocateGeometry(uint32_t size, uint32_t alignment, uint32_t& offset);
+    bool UploadMaterial(FrameData& frame, const std::shared_ptr<VulkanMaterial>& material, MaterialUpload& upload);
+
+    void RecordPasses(FrameData& frame);
+    VkCommandBuffer RecordSecondary(RecordingPool& pool, const Pass& pass, uint32_t firstDraw, uint32_t drawCount);
+    bool Submit(FrameData& frame, bool present, uint32_t imageIndex, bool wait);
+    void RecordPresentBlit(FrameData& frame, uint32_t imageIndex);
+    void RecordReadback(VkCommandBuffer commandBuffer, VulkanRenderTarget* target, int x, int y, int width, int height, VkBuffer buffer);
+    void RecreateSwapchain();
+
+    RenderSystemConfig m_Config;
+    std::shared_ptr<Window> m_Window;
+    VulkanDevice m_Device;
+    VulkanPipelineCache m_PipelineCache;
+    VulkanSwapchain m_Swapchain;
+    bool m_Initialized = false;
+    bool m_FrameActive = false;
+
+    // 渲染通道按清除位索引，彼此兼容，共用帧缓冲和管线
+    std::array<VkRenderPass, 8> m_RenderPasses = {};
+    VkDescriptorSetLayout m_PerDrawLayout = VK_NULL_HANDLE;
+    VkDescriptorSetLayout m_MaterialLayout = VK_NULL_HANDLE;
+    VkPipelineLayout m_PipelineLayout = VK_NULL_HANDLE;
+    VkDescriptorPool m_PerDrawPool = VK_NULL_HANDLE;
+    VkDescriptorSet m_PerDrawSet = VK_NULL_HANDLE;
+
+    // 所有帧共用一个持久映射的uniform缓冲，按帧划分区域
+    VkBuffer m_UniformBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory m_UniformMemory = VK_NULL_HANDLE;
+    uint8_t* m_UniformMapped = nullptr;
+    uint32_t m_UniformAlignment = 256;
+    uint32_t m_UniformHead = 0;
+    uint32_t m_UniformEnd = 0;
+    bool m_UniformOverflowReported = false;
+
+    // 瞬态网格的顶点和索引，同样按帧划分区域
+    VkBuffer m_GeometryBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory m_GeometryMemory = VK_NULL_HANDLE;
+    uint8_t* m_GeometryMapped = nullptr;
+    uint32_t m_GeometryHead = 0;
+    uint32_t m_GeometryEnd = 0;
+    uint64_t m_FrameSerial = 0;
+
+    std::array<FrameData, VULKAN_FRAMES_IN_FLIGHT> m_Frames;
+    uint32_t m_FrameIndex = 0;
+
+    std::shared_ptr<VulkanRenderTarget> m_DefaultTarget;
+    std::shared_ptr<VulkanTexture> m_WhiteTexture;
+    std::shared_ptr<RenderTarget> m_CurrentTarget;
+    std::vector<Pass> m_Passes;
+    std::vector<DrawRecord> m_Draws;
+    std::vector<std::shared_ptr<VulkanReadbackBuffer>> m_PendingReadbacks;   // 本帧录制了复制、还没有提交的读回
+    int32_t m_Viewport[4] = { 0, 0, 0, 0 };
+
+    std::shared_ptr<Camera> m_Camera;
+    Matrix4 m_View;
+    Matrix4 m_Projection;
+    Matrix4 m_ViewProjection;
+};
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_VULKAN
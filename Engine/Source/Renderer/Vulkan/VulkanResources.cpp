@@ -0,0 +1,788 @@
+/**
+ * @file VulkanResources.cpp
+ * @brief Vulkan渲染资源实现
+ */
+
+#include "VulkanResources.h"
+
+#ifdef PLE_RENDERER_VULKAN
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include "VulkanDevice.h"
+#include "VulkanPipelineCache.h"
+
+namespace PLE {
+
+namespace {
+
+// 反射材质块需要的SPIR-V操作码、修饰和存储类
+constexpr uint32_t SPV_OP_MEMBER_NAME = 6;
+constexpr uint32_t SPV_OP_TYPE_INT = 21;
+constexpr uint32_t SPV_OP_TYPE_FLOAT = 22;
+constexpr uint32_t SPV_OP_TYPE_VECTOR = 23;
+constexpr uint32_t SPV_OP_TYPE_MATRIX = 24;
+constexpr uint32_t SPV_OP_TYPE_ARRAY = 28;
+constexpr uint32_t SPV_OP_TYPE_STRUCT = 30;
+constexpr uint32_t SPV_OP_TYPE_POINTER = 32;
+constexpr uint32_t SPV_OP_CONSTANT = 43;
+constexpr uint32_t SPV_OP_VARIABLE = 59;
+constexpr uint32_t SPV_OP_DECORATE = 71;
+constexpr uint32_t SPV_OP_MEMBER_DECORATE = 72;
+constexpr uint32_t SPV_DECORATION_ARRAY_STRIDE = 6;
+constexpr uint32_t SPV_DECORATION_MATRIX_STRIDE = 7;
+constexpr uint32_t SPV_DECORATION_BINDING = 33;
+constexpr uint32_t SPV_DECORATION_DESCRIPTOR_SET = 34;
+constexpr uint32_t SPV_DECORATION_OFFSET = 35;
+constexpr uint32_t SPV_STORAGE_CLASS_UNIFORM = 2;
+
+/**
+ * @brief 从SPIR-V中反射set 1、binding 0的材质uniform块
+ *
+ * 只解析类型、名称和布局修饰，成员名称被剥离的模块无法反射。
+ */
+class SpirvReflector {
+public:
+    bool Reflect(const std::string& code, MaterialBlockLayout& layout) {
+        std::vector<uint32_t> words(code.size() / 4);
+        std::memcpy(words.data(), code.data(), words.size() * 4);
+        if (words.size() < 5 || !Parse(words)) {
+            return false;
+        }
+
+        uint32_t blockType = 0;
+        for (const auto& variable : m_UniformVariables) {
+            if (m_Sets.count(variable.second) && m_Sets[variable.second] == 1 &&
+                m_Bindings.count(variable.second) && m_Bindings[variable.second] == 0) {
+                auto pointer = m_Types.find(variable.first);
+                if (pointer != m_Types.end() && pointer->second.operands.size() >= 2) {
+                    blockType = pointer->second.operands[1];
+                }
+                break;
+            }
+        }
+        auto block = m_Types.find(blockType);
+        if (block == m_Types.end() || block->second.opcode != SPV_OP_TYPE_STRUCT) {
+            return false;
+        }
+
+        MaterialBlockLayout result;
+        const std::vector<uint32_t>& memberTypes = block->second.operands;
+        for (uint32_t i = 0; i < memberTypes.size(); ++i) {
+            const uint64_t key = MemberKey(blockType, i);
+            const uint32_t offset = m_MemberOffsets[key];
+            result.size = std::max(result.size, offset + GetTypeSize(memberTypes[i], m_MatrixStrides[key]));
+
+            MaterialBlockMember member;
+            member.name = m_MemberNames[key];
+            member.offset = offset;
+            if (!member.name.empty() && Classify(memberTypes[i], member.type)) {
+                result.members.push_back(member);
+            }
+        }
+        result.size = (result.size + 15) & ~15u;
+        layout = std::move(result);
+        return layout.size > 0;
+    }
+
+private:
+    struct TypeInfo {
+        uint32_t opcode = 0;
+        std::vector<uint32_t> operands;     // 结果ID之后的操作数
+    };
+
+    static uint64_t MemberKey(uint32_t type, uint32_t member) {
+        return (static_cast<uint64_t>(type) << 32) | member;
+    }
+
+    bool Parse(const std::vector<uint32_t>& words) {
+        for (size_t i = 5; i < words.size();) {
+            const uint32_t count = words[i] >> 16;
+            const uint32_t opcode = words[i] & 0xFFFF;
+            if (count == 0 || i + count > words.size()) {
+                return false;
+            }
+            const uint32_t* operands = &words[i + 1];
+            const uint32_t operandCount = count - 1;
+            switch (opcode) {
+            case SPV_OP_MEMBER_NAME:
+                if (operandCount >= 3) {
+                    m_MemberNames[MemberKey(operands[0], operands[1])] = ReadString(operands + 2, operandCount - 2);
+                }
+                break;
+            case SPV_OP_DECORATE:
+                if (operandCount >= 3) {
+                    if (operands[1] == SPV_DECORATION_DESCRIPTOR_SET) {
+                        m_Sets[operands[0]] = operands[2];
+                    } else if (operands[1] == SPV_DECORATION_BINDING) {
+                        m_Bindings[operands[0]] = operands[2];
+                    } else if (operands[1] == SPV_DECORATION_ARRAY_STRIDE) {
+                        m_ArrayStrides[operands[0]] = operands[2];
+                    }
+                }
+                break;
+            case SPV_OP_MEMBER_DECORATE:
+                if (operandCount >= 4) {
+                    if (operands[2] == SPV_DECORATION_OFFSET) {
+                        m_MemberOffsets[MemberKey(operands[0], operands[1])] = operands[3];
+                    } else if (operands[2] == SPV_DECORATION_MATRIX_STRIDE) {
+                        m_MatrixStrides[MemberKey(operands[0], operands[1])] = operands[3];
+                    }
+                }
+                break;
+            case SPV_OP_TYPE_INT:
+            case SPV_OP_TYPE_FLOAT:
+            case SPV_OP_TYPE_VECTOR:
+            case SPV_OP_TYPE_MATRIX:
+            case SPV_OP_TYPE_ARRAY:
+            case SPV_OP_TYPE_STRUCT:
+            case SPV_OP_TYPE_POINTER:
+                if (operandCount >= 1) {
+                    TypeInfo& type = m_Types[operands[0]];
+                    type.opcode = opcode;
+                    type.operands.assign(operands + 1, operands + operandCount);
+                }
+                break;
+            case SPV_OP_CONSTANT:
+                if (operandCount >= 3) {
+                    m_Constants[operands[1]] = operands[2];
+                }
+                break;
+            case SPV_OP_VARIABLE:
+                if (operandCount >= 3 && operands[2] == SPV_STORAGE_CLASS_UNIFORM) {
+                    m_UniformVariables.emplace_back(operands[0], operands[1]);
+                }
+                break;
+            default:
+                break;
+            }
+            i += count;
+        }
+        return true;
+    }
+
+    static std::string ReadString(const uint32_t* words, uint32_t wordCount) {
+        // 字面字符串按小端序打包，以0结尾
+        std::string text;
+        for (uint32_t i = 0; i < wordCount; ++i) {
+            for (uint32_t byte = 0; byte < 4; ++byte) {
+                const char c = static_cast<char>((words[i] >> (byte * 8)) & 0xFF);
+                if (c == '\0') {
+                    return text;
+                }
+                text += c;
+            }
+        }
+        return text;
+    }
+
+    uint32_t GetTypeSize(uint32_t id, uint32_t matrixStride, uint32_t depth = 0) {
+        auto it = m_Types.find(id);
+        if (it == m_Types.end() || depth > 8) {
+            return 0;
+        }
+        const TypeInfo& type = it->second;
+        switch (type.opcode) {
+        case SPV_OP_TYPE_INT:
+        case SPV_OP_TYPE_FLOAT:
+            return type.operands.empty() ? 0 : type.operands[0] / 8;
+        case SPV_OP_TYPE_VECTOR:
+            return type.operands.size() < 2 ? 0 : GetTypeSize(type.operands[0], 0, depth + 1) * type.operands[1];
+        case SPV_OP_TYPE_MATRIX:
+            return type.operands.size() < 2 ? 0 : type.operands[1] * (matrixStride ? matrixStride : 16);
+        case SPV_OP_TYPE_ARRAY: {
+            if (type.operands.size() < 2) {
+                return 0;
+            }
+            const uint32_t stride = m_ArrayStrides.count(id) ? m_ArrayStrides[id] : 16;
+            return stride * m_Constants[type.operands[1]];
+        }
+        case SPV_OP_TYPE_STRUCT: {
+            uint32_t size = 0;
+            for (uint32_t i = 0; i < type.operands.size(); ++i) {
+                const uint64_t key = MemberKey(id, i);
+                size = std::max(size, m_MemberOffsets[key] + GetTypeSize(type.operands[i], m_MatrixStrides[key], depth + 1));
+            }
+            return (size + 15) & ~15u;
+        }
+        default:
+            return 0;
+        }
+    }
+
+    bool IsFloat32(uint32_t id) {
+        auto it = m_Types.find(id);
+        return it != m_Types.end() && it->second.opcode == SPV_OP_TYPE_FLOAT &&
+               !it->second.operands.empty() && it->second.operands[0] == 32;
+    }
+
+    bool IsVector4(uint32_t id) {
+        auto it = m_Types.find(id);
+        return it != m_Types.end() && it->second.opcode == SPV_OP_TYPE_VECTOR && it->second.operands.size() >= 2 &&
+               IsFloat32(it->second.operands[0]) && it->second.operands[1] == 4;
+    }
+
+    bool Classify(uint32_t id, MaterialParameterType& parameterType) {
+        if (IsFloat32(id)) {
+            parameterType = MaterialParameterType::Float;
+            return true;
+        }
+        if (IsVector4(id)) {
+            parameterType = MaterialParameterType::Vector4;
+            return true;
+        }
+        auto it = m_Types.find(id);
+        if (it != m_Types.end() && it->second.opcode == SPV_OP_TYPE_MATRIX && it->second.operands.size() >= 2 &&
+            IsVector4(it->second.operands[0]) && it->second.operands[1] == 4) {
+            parameterType = MaterialParameterType::Matrix4;
+            return true;
+        }
+        return false;
+    }
+
+    std::unordered_map<uint32_t, TypeInfo> m_Types;
+    std::unordered_map<uint32_t, uint32_t> m_Constants;
+    std::unordered_map<uint32_t, uint32_t> m_Sets;
+    std::unordered_map<uint32_t, uint32_t> m_Bindings;
+    std::unordered_map<uint32_t, uint32_t> m_ArrayStrides;
+    std::unordered_map<uint64_t, uint32_t> m_MemberOffsets;
+    std::unordered_map<uint64_t, uint32_t> m_MatrixStrides;
+    std::unordered_map<uint64_t, std::string> m_MemberNames;
+    std::vector<std::pair<uint32_t, uint32_t>> m_UniformVariables;     // (指针类型, 变量ID)
+};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// VulkanShader
+// ---------------------------------------------------------------------------
+
+VulkanShader::VulkanShader(VulkanDevice& device, const std::string& vertexSpirv, const std::string& fragmentSpirv)
+    : m_Device(device) {
+    if (!IsSpirv(vertexSpirv) || !IsSpirv(fragmentSpirv)) {
+        std::cerr << "Vulkan后端需要SPIR-V字节码作为着色器源码！" << std::endl;
+        return;
+    }
+    m_VertexSpirv = vertexSpirv;
+    m_FragmentSpirv = fragmentSpirv;
+    m_VertexModule = CreateModule(vertexSpirv);
+    m_FragmentModule = CreateModule(fragmentSpirv);
+
+    // 材质块通常在片段着色器中使用，两个阶段的声明必须一致
+    if (!SpirvReflector().Reflect(fragmentSpirv, m_MaterialLayout)) {
+        SpirvReflector().Reflect(vertexSpirv, m_MaterialLayout);
+    }
+}
+
+VulkanShader::~VulkanShader() {
+    VkDevice device = m_Device.GetDevice();
+    for (const auto& entry : m_Pipelines) {
+        vkDestroyPipeline(device, entry.second, nullptr);
+    }
+    vkDestroyShaderModule(device, m_VertexModule, nullptr);
+    vkDestroyShaderModule(device, m_FragmentModule, nullptr);
+}
+
+bool VulkanShader::IsSpirv(const std::string& code) {
+    const uint32_t SPIRV_MAGIC = 0x07230203;
+    if (code.size() < 20 || code.size() % 4 != 0) {
+        return false;
+    }
+    uint32_t magic = 0;
+    std::memcpy(&magic, code.data(), sizeof(magic));
+    return magic == SPIRV_MAGIC;
+}
+
+VkShaderModule VulkanShader::CreateModule(const std::string& code) {
+    // std::string的存储不保证4字节对齐，复制到uint32_t数组
+    std::vector<uint32_t> words(code.size() / 4);
+    std::memcpy(words.data(), code.data(), code.size());
+
+    VkShaderModuleCreateInfo moduleInfo = {};
+    moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    moduleInfo.codeSize = code.size();
+    moduleInfo.pCode = words.data();
+    VkShaderModule module = VK_NULL_HANDLE;
+    VulkanCheck(vkCreateShaderModule(m_Device.GetDevice(), &moduleInfo, nullptr, &module), "创建着色器模块");
+    return module;
+}
+
+VkPipeline VulkanShader::GetPipeline(VulkanPipelineCache& pipelineCache, VkPipelineLayout layout, VkRenderPass renderPass,
+                                     const VertexLayout& vertexLayout) {
+    const uint64_t key = vertexLayout.GetFormatHash();
+    auto it = m_Pipelines.find(key);
+    if (it != m_Pipelines.end()) {
+        return it->second;
+    }
+    if (!IsValid()) {
+        return VK_NULL_HANDLE;
+    }
+    // 失败的结果也记录下来，避免每次绘制都重新尝试
+    VkPipeline pipeline = pipelineCache.CreateGraphicsPipeline(m_VertexModule, m_FragmentModule, layout, renderPass, vertexLayout);
+    m_Pipelines.emplace(key, pipeline);
+    return pipeline;
+}
+
+// ---------------------------------------------------------------------------
+// VulkanTexture
+// ---------------------------------------------------------------------------
+
+VulkanTexture::VulkanTexture(VulkanDevice& device, int width, int height, const void* data, bool renderTarget)
+    : Texture(width, height), m_Device(device) {
+    VkImageUsageFlags usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    if (renderTarget) {
+        usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    } else if (data) {
+        m_MipLevels = 1;
+        for (int size = std::max(width, height); size > 1; size >>= 1) {
+            ++m_MipLevels;
+        }
+    }
+
+    const uint32_t imageWidth = static_cast<uint32_t>(width);
+    const uint32_t imageHeight = static_cast<uint32_t>(height);
+    if (!device.CreateImage(imageWidth, imageHeight, m_MipLevels, VK_FORMAT_R8G8B8A8_UNORM, usage, m_Image, m_Memory)) {
+        return;
+    }
+    if (!Upload(data)) {
+        return;
+    }
+    m_View = device.CreateImageView(m_Image, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_ASPECT_COLOR_BIT, m_MipLevels);
+}
+
+VulkanTexture::VulkanTexture(VulkanDevice& device, const TextureData& data)
+    : Texture(static_cast<int>(data.width), static_cast<int>(data.height), data.format), m_Device(device) {
+    VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
+    switch (data.format) {
+    case TextureFormat::BC1:
+        format = VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+        break;
+    case TextureFormat::BC3:
+        format = VK_FORMAT_BC3_UNORM_BLOCK;
+        break;
+    case TextureFormat::BC5:
+        format = VK_FORMAT_BC5_UNORM_BLOCK;
+        break;
+    case TextureFormat::BC7:
+        format = VK_FORMAT_BC7_UNORM_BLOCK;
+        break;
+    default:
+        break;
+    }
+
+    m_MipLevels = static_cast<uint32_t>(data.mips.size());
+    if (!device.CreateImage(data.width, data.height, m_MipLevels, format, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+                            m_Image, m_Memory)) {
+        return;
+    }
+    if (!UploadLevels(data)) {
+        return;
+    }
+    m_View = device.CreateImageView(m_Image, format, VK_IMAGE_ASPECT_COLOR_BIT, m_MipLevels);
+}
+
+VulkanTexture::~VulkanTexture() {
+    VkDevice device = m_Device.GetDevice();
+    vkDestroyImageView(device, m_View, nullptr);
+    vkDestroyImage(device, m_Image, nullptr);
+    vkFreeMemory(device, m_Memory, nullptr);
+}
+
+bool VulkanTexture::Upload(const void* data) {
+    const uint32_t width = static_cast<uint32_t>(m_Width);
+    const uint32_t height = static_cast<uint32_t>(m_Height);
+
+    if (!data) {
+        // 没有初始数据时只做布局转换，保证图像在渲染通道外处于只读布局
+        return m_Device.ImmediateSubmit([&](VkCommandBuffer commandBuffer) {
+            VulkanImageBarrier(commandBuffer, m_Image, VK_IMAGE_ASPECT_COLOR_BIT, 0, m_MipLevels,
+                               VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                               VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0,
+                               VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+        });
+    }
+
+    const VkDeviceSize size = static_cast<VkDeviceSize>(width) * height * 4;
+    VkBuffer staging = VK_NULL_HANDLE;
+    VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+    if (!m_Device.CreateBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, staging, stagingMemory)) {
+        return false;
+    }
+    void* mapped = nullptr;
+    vkMapMemory(m_Device.GetDevice(), stagingMemory, 0, size, 0, &mapped);
+    std::memcpy(mapped, data, static_cast<size_t>(size));
+    vkUnmapMemory(m_Device.GetDevice(), stagingMemory);
+
+    const bool uploaded = m_Device.ImmediateSubmit([&](VkCommandBuffer commandBuffer) {
+        VulkanImageBarrier(commandBuffer, m_Image, VK_IMAGE_ASPECT_COLOR_BIT, 0, m_MipLevels,
+                           VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+
+        VkBufferImageCopy region = {};
+        region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+        region.imageExtent = { width, height, 1 };
+        vkCmdCopyBufferToImage(commandBuffer, staging, m_Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+        // 逐级缩小生成Mipmap，每级先转为传输源再作为下一级的输入
+        int32_t mipWidth = static_cast<int32_t>(width);
+        int32_t mipHeight = static_cast<int32_t>(height);
+        for (uint32_t level = 1; level < m_MipLevels; ++level) {
+            VulkanImageBarrier(commandBuffer, m_Image, VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 1,
+                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                               VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                               VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+
+            const int32_t nextWidth = std::max(mipWidth / 2, 1);
+            const int32_t nextHeight = std::max(mipHeight / 2, 1);
+            VkImageBlit blit = {};
+            blit.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 0, 1 };
+            blit.srcOffsets[1] = { mipWidth, mipHeight, 1 };
+            blit.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1 };
+            blit.dstOffsets[1] = { nextWidth, nextHeight, 1 };
+            vkCmdBlitImage(commandBuffer, m_Image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, m_Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+
+            VulkanImageBarrier(commandBuffer, m_Image, VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 1,
+                               VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                               VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                               VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+            mipWidth = nextWidth;
+            mipHeight = nextHeight;
+        }
+
+        VulkanImageBarrier(commandBuffer, m_Image, VK_IMAGE_ASPECT_COLOR_BIT, m_MipLevels - 1, 1,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                           VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    });
+
+    vkDestroyBuffer(m_Device.GetDevice(), staging, nullptr);
+    vkFreeMemory(m_Device.GetDevice(), stagingMemory, nullptr);
+    return uploaded;
+}
+
+bool VulkanTexture::UploadLevels(const TextureData& data) {
+    const VkDeviceSize size = static_cast<VkDeviceSize>(data.pixels.size());
+    VkBuffer staging = VK_NULL_HANDLE;
+    VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+    if (!m_Device.CreateBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, staging, stagingMemory)) {
+        return false;
+    }
+    void* mapped = nullptr;
+    vkMapMemory(m_Device.GetDevice(), stagingMemory, 0, size, 0, &mapped);
+    std::memcpy(mapped, data.pixels.data(), data.pixels.size());
+    vkUnmapMemory(m_Device.GetDevice(), stagingMemory);
+
+    // 每级Mip一个复制区域；级别大小都是块大小的整数倍，偏移满足对齐要求
+    std::vector<VkBufferImageCopy> regions(data.mips.size());
+    for (uint32_t level = 0; level < m_MipLevels; ++level) {
+        const TextureMipLevel& mip = data.mips[level];
+        VkBufferImageCopy& region = regions[level];
+        region = {};
+        region.bufferOffset = static_cast<VkDeviceSize>(mip.offset);
+        region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1 };
+        region.imageExtent = { mip.width, mip.height, 1 };
+    }
+
+    const bool uploaded = m_Device.ImmediateSubmit([&](VkCommandBuffer commandBuffer) {
+        VulkanImageBarrier(commandBuffer, m_Image, VK_IMAGE_ASPECT_COLOR_BIT, 0, m_MipLevels,
+                           VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+        vkCmdCopyBufferToImage(commandBuffer, staging, m_Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               static_cast<uint32_t>(regions.size()), regions.data());
+        VulkanImageBarrier(commandBuffer, m_Image, VK_IMAGE_ASPECT_COLOR_BIT, 0, m_MipLevels,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                           VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    });
+
+    vkDestroyBuffer(m_Device.GetDevice(), staging, nullptr);
+    vkFreeMemory(m_Device.GetDevice(), stagingMemory, nullptr);
+    return uploaded;
+}
+
+// ---------------------------------------------------------------------------
+// VulkanMesh
+// ---------------------------------------------------------------------------
+
+VulkanMesh::VulkanMesh(VulkanDevice& device, const void* vertices, uint32_t vertexCount, const VertexLayout& layout,
+                       const uint32_t* indices, uint32_t indexCount)
+    : Mesh(vertexCount, indices ? indexCount : 0, layout), m_Device(device) {
+    const VkDeviceSize vertexSize = static_cast<VkDeviceSize>(vertexCount) * layout.stride;
+    if (!device.CreateBuffer(vertexSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_VertexBuffer, m_VertexMemory) ||
+        !device.UploadBuffer(m_VertexBuffer, vertices, vertexSize)) {
+        return;
+    }
+
+    if (m_IndexCount > 0) {
+        const VkDeviceSize indexSize = static_cast<VkDeviceSize>(indexCount) * sizeof(uint32_t);
+        if (!device.CreateBuffer(indexSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_IndexBuffer, m_IndexMemory) ||
+            !device.UploadBuffer(m_IndexBuffer, indices, indexSize)) {
+            // 索引缓冲创建失败时整个网格视为无效
+            vkDestroyBuffer(device.GetDevice(), m_VertexBuffer, nullptr);
+            vkFreeMemory(device.GetDevice(), m_VertexMemory, nullptr);
+            m_VertexBuffer = VK_NULL_HANDLE;
+            m_VertexMemory = VK_NULL_HANDLE;
+        }
+    }
+}
+
+VulkanMesh::VulkanMesh(VulkanDevice& device, uint32_t vertexCount, uint32_t indexCount, const VertexLayout& layout, VkBuffer buffer,
+                       uint32_t baseVertex, uint32_t firstIndex, uint64_t frameSerial)
+    : Mesh(vertexCount, indexCount, layout)
+    , m_Device(device)
+    , m_VertexBuffer(buffer)
+    , m_IndexBuffer(indexCount > 0 ? buffer : VK_NULL_HANDLE)
+    , m_OwnsBuffers(false)
+    , m_BaseVertex(baseVertex)
+    , m_FirstIndex(firstIndex)
+    , m_FrameSerial(frameSerial) {
+}
+
+VulkanMesh::~VulkanMesh() {
+    if (!m_OwnsBuffers) {
+        return;
+    }
+    VkDevice device = m_Device.GetDevice();
+    vkDestroyBuffer(device, m_VertexBuffer, nullptr);
+    vkFreeMemory(device, m_VertexMemory, nullptr);
+    vkDestroyBuffer(device, m_IndexBuffer, nullptr);
+    vkFreeMemory(device, m_IndexMemory, nullptr);
+}
+
+// ---------------------------------------------------------------------------
+// VulkanMaterial
+// ---------------------------------------------------------------------------
+
+std::atomic<uint64_t> VulkanMaterial::s_NextId{ 1 };
+
+VulkanMaterial::VulkanMaterial(std::shared_ptr<Shader> shader)
+    : Material(shader), m_Id(s_NextId.fetch_add(1)) {
+}
+
+VulkanMaterial::VulkanMaterial(const std::shared_ptr<Material>& parent)
+    : Material(parent->GetShader(), parent), m_Id(s_NextId.fetch_add(1)) {
+}
+
+bool VulkanMaterial::HasReflectedBlock() const {
+    return m_Shader && m_Shader->GetMaterialLayout().size > 0;
+}
+
+VulkanMaterial* VulkanMaterial::GetUniformOwner() {
+    return HasReflectedBlock() ? static_cast<VulkanMaterial*>(ResolveBlock()) : this;
+}
+
+uint64_t VulkanMaterial::GetUniformVersion() const {
+    return HasReflectedBlock() ? m_BlockVersion : m_Version;
+}
+
+uint32_t VulkanMaterial::GetUniformSize() {
+    if (HasReflectedBlock()) {
+        return static_cast<uint32_t>(m_Block.size());
+    }
+    UpdateLayout();
+    return m_UniformSize;
+}
+
+void VulkanMaterial::PackUniforms(uint8_t* destination) {
+    if (HasReflectedBlock()) {
+        // 参数块已按反射的布局打包，每帧的环形缓冲区只需整体复制
+        std::memcpy(destination, m_Block.data(), m_Block.size());
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        TakeDirtyRange(begin, end);
+        return;
+    }
+
+    UpdateLayout();
+    std::memset(destination, 0, m_UniformSize);
+    for (size_t i = 0; i < m_Parameters.size(); ++i) {
+        const MaterialParameter& parameter = m_Parameters[i];
+        switch (parameter.type) {
+        case MaterialParameterType::Float:
+            std::memcpy(destination + m_Offsets[i], parameter.value.data(), sizeof(float));
+            break;
+        case MaterialParameterType::Vector4:
+            std::memcpy(destination + m_Offsets[i], parameter.value.data(), sizeof(float) * 4);
+            break;
+        case MaterialParameterType::Matrix4:
+            std::memcpy(destination + m_Offsets[i], parameter.value.data(), sizeof(float) * 16);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+const std::vector<std::shared_ptr<VulkanTexture>>& VulkanMaterial::GetTextures() {
+    UpdateLayout();
+    return m_Textures;
+}
+
+void VulkanMaterial::UpdateLayout() {
+    if (m_LayoutVersion == m_Version) {
+        return;
+    }
+
+    // std140：float按4字节对齐，vec4和mat4按16字节对齐，块大小向上取整到16
+    uint32_t offset = 0;
+    m_Offsets.assign(m_Parameters.size(), 0);
+    m_Textures.clear();
+    for (size_t i = 0; i < m_Parameters.size(); ++i) {
+        const MaterialParameter& parameter = m_Parameters[i];
+        switch (parameter.type) {
+        case MaterialParameterType::Float:
+            m_Offsets[i] = offset;
+            offset += 4;
+            break;
+        case MaterialParameterType::Vector4:
+            offset = (offset + 15) & ~15u;
+            m_Offsets[i] = offset;
+            offset += 16;
+            break;
+        case MaterialParameterType::Matrix4:
+            offset = (offset + 15) & ~15u;
+            m_Offsets[i] = offset;
+            offset += 64;
+            break;
+        case MaterialParameterType::Texture:
+            if (m_Textures.size() < VULKAN_MAX_MATERIAL_TEXTURES) {
+                m_Textures.push_back(std::static_pointer_cast<VulkanTexture>(parameter.texture));
+            }
+            break;
+        }
+    }
+    m_UniformSize = std::max((offset + 15) & ~15u, 16u);
+    m_LayoutVersion = m_Version;
+}
+
+// ---------------------------------------------------------------------------
+// VulkanRenderTarget
+// ---------------------------------------------------------------------------
+
+VulkanRenderTarget::VulkanRenderTarget(VulkanDevice& device, VkRenderPass renderPass, int width, int height)
+    : RenderTarget(width, height), m_Device(device) {
+    m_ColorTexture = std::make_shared<VulkanTexture>(device, width, height, nullptr, true);
+    if (!m_ColorTexture->IsValid()) {
+        return;
+    }
+
+    const uint32_t imageWidth = static_cast<uint32_t>(width);
+    const uint32_t imageHeight = static_cast<uint32_t>(height);
+    const VkFormat depthFormat = device.GetDepthFormat();
+    if (!device.CreateImage(imageWidth, imageHeight, 1, depthFormat, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, m_DepthImage, m_DepthMemory)) {
+        return;
+    }
+    m_DepthView = device.CreateImageView(m_DepthImage, depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT, 1);
+    if (!m_DepthView) {
+        return;
+    }
+    device.ImmediateSubmit([&](VkCommandBuffer commandBuffer) {
+        VulkanImageBarrier(commandBuffer, m_DepthImage, VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT, 0, 1,
+                           VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                           VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0,
+                           VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+    });
+
+    const VkImageView attachments[] = { m_ColorTexture->GetView(), m_DepthView };
+    VkFramebufferCreateInfo framebufferInfo = {};
+    framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    framebufferInfo.renderPass = renderPass;
+    framebufferInfo.attachmentCount = 2;
+    framebufferInfo.pAttachments = attachments;
+    framebufferInfo.width = imageWidth;
+    framebufferInfo.height = imageHeight;
+    framebufferInfo.layers = 1;
+    if (!VulkanCheck(vkCreateFramebuffer(device.GetDevice(), &framebufferInfo, nullptr, &m_Framebuffer), "创建帧缓冲")) {
+        m_Framebuffer = VK_NULL_HANDLE;
+    }
+}
+
+VulkanRenderTarget::~VulkanRenderTarget() {
+    VkDevice device = m_Device.GetDevice();
+    vkDestroyFramebuffer(device, m_Framebuffer, nullptr);
+    vkDestroyImageView(device, m_DepthView, nullptr);
+    vkDestroyImage(device, m_DepthImage, nullptr);
+    vkFreeMemory(device, m_DepthMemory, nullptr);
+}
+
+// ---------------------------------------------------------------------------
+// VulkanReadbackBuffer
+// ---------------------------------------------------------------------------
+
+VulkanReadbackBuffer::VulkanReadbackBuffer(VulkanDevice& device, int width, int height)
+    : ReadbackBuffer(width, height), m_Device(device) {
+    // CPU要读取整幅图像，优先使用带缓存的内存，没有时退回到普通的主机可见内存
+    const VkDeviceSize size = static_cast<VkDeviceSize>(width) * static_cast<VkDeviceSize>(height) * 4;
+    const VkMemoryPropertyFlags coherent = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    if (!device.CreateBuffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, coherent | VK_MEMORY_PROPERTY_HOST_CACHED_BIT, m_Buffer, m_Memory) &&
+        !device.CreateBuffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, coherent, m_Buffer, m_Memory)) {
+        return;
+    }
+    void* mapped = nullptr;
+    if (!VulkanCheck(vkMapMemory(device.GetDevice(), m_Memory, 0, size, 0, &mapped), "映射读回缓冲区")) {
+        return;
+    }
+    m_Mapped = static_cast<const uint8_t*>(mapped);
+
+    VkFenceCreateInfo fenceInfo = {};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    VulkanCheck(vkCreateFence(device.GetDevice(), &fenceInfo, nullptr, &m_Fence), "创建读回栅栏");
+}
+
+VulkanReadbackBuffer::~VulkanReadbackBuffer() {
+    VkDevice device = m_Device.GetDevice();
+    if (m_State == State::Submitted) {
+        vkWaitForFences(device, 1, &m_Fence, VK_TRUE, UINT64_MAX);
+    }
+    vkDestroyFence(device, m_Fence, nullptr);
+    if (m_Mapped) {
+        vkUnmapMemory(device, m_Memory);
+    }
+    vkDestroyBuffer(device, m_Buffer, nullptr);
+    vkFreeMemory(device, m_Memory, nullptr);
+}
+
+bool VulkanReadbackBuffer::IsReady() {
+    if (m_State == State::Submitted && vkGetFenceStatus(m_Device.GetDevice(), m_Fence) == VK_SUCCESS) {
+        m_State = State::Complete;
+    }
+    return m_State == State::Complete;
+}
+
+bool VulkanReadbackBuffer::Wait() {
+    if (m_State == State::Submitted) {
+        vkWaitForFences(m_Device.GetDevice(), 1, &m_Fence, VK_TRUE, UINT64_MAX);
+        m_State = State::Complete;
+    }
+    return m_State == State::Complete;
+}
+
+void VulkanReadbackBuffer::BeginRecording() {
+    if (m_State == State::Submitted) {
+        vkWaitForFences(m_Device.GetDevice(), 1, &m_Fence, VK_TRUE, UINT64_MAX);
+        m_State = State::Complete;
+    }
+    if (m_State == State::Complete) {
+        vkResetFences(m_Device.GetDevice(), 1, &m_Fence);
+    }
+    m_State = State::Recorded;
+}
+
+bool VulkanReadbackBuffer::Submit() {
+    VkResult result;
+    {
+        std::lock_guard<std::mutex> lock(m_Device.GetQueueMutex());
+        result = vkQueueSubmit(m_Device.GetGraphicsQueue(), 0, nullptr, m_Fence);
+    }
+    m_State = VulkanCheck(result, "提交读回栅栏") ? State::Submitted : State::Idle;
+    return m_State == State::Submitted;
+}
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_VULKAN
@@ -0,0 +1,299 @@
+/**
+ * @file VulkanResources.h
+ * @brief Vulkan渲染资源
+ */
+
+#pragma once
+
+#include "VulkanCommon.h"
+
+#ifdef PLE_RENDERER_VULKAN
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Renderer/RenderResources.h"
+
+namespace PLE {
+
+class VulkanDevice;
+class VulkanPipelineCache;
+
+/**
+ * @brief Vulkan着色器
+ *
+ * 源码参数须为SPIR-V字节码（按字节存放在std::string中）。
+ * 图形管线按顶点布局在第一次绘制时通过管线缓存创建，之后一直复用。
+ */
+class VulkanShader : public Shader {
+public:
+    VulkanShader(VulkanDevice& device, const std::string& vertexSpirv, const std::string& fragmentSpirv);
+    ~VulkanShader() override;
+
+    bool IsValid() const override { return m_VertexModule != VK_NULL_HANDLE && m_FragmentModule != VK_NULL_HANDLE; }
+
+    /**
+     * @brief 获取（必要时创建）图形管线；着色器被共享后只能在渲染线程调用
+     * @param pipelineCache 管线缓存
+     * @param layout 管线布局
+     * @param renderPass 兼容的渲染通道
+     * @param vertexLayout 网格的顶点布局
+     * @return 管线句柄，失败时为VK_NULL_HANDLE
+     */
+    VkPipeline GetPipeline(VulkanPipelineCache& pipelineCache, VkPipelineLayout layout, VkRenderPass renderPass,
+                           const VertexLayout& vertexLayout = VertexLayout::Standard());
+
+    /**
+     * @brief 检查字符串是否为有效的SPIR-V字节码
+     */
+    static bool IsSpirv(const std::string& code);
+
+    /**
+     * @brief 获取创建时传入的SPIR-V
+     */
+    const std::string& GetVertexSpirv() const { return m_VertexSpirv; }
+    const std::string& GetFragmentSpirv() const { return m_FragmentSpirv; }
+
+private:
+    VkShaderModule CreateModule(const std::string& code);
+
+    VulkanDevice& m_Device;
+    std::string m_VertexSpirv;
+    std::string m_FragmentSpirv;
+    VkShaderModule m_VertexModule = VK_NULL_HANDLE;
+    VkShaderModule m_FragmentModule = VK_NULL_HANDLE;
+    std::unordered_map<uint64_t, VkPipeline> m_Pipelines;  // 顶点布局哈希 -> 管线，创建失败时为VK_NULL_HANDLE
+};
+
+/**
+ * @brief Vulkan二维纹理（RGBA8）
+ */
+class VulkanTexture : public Texture {
+public:
+    /**
+     * @brief 创建纹理
+     * @param device 设备
+     * @param width 宽度
+     * @param height 高度
+     * @param data 像素数据，为空时内容未定义
+     * @param renderTarget 是否用作颜色附件（不生成Mipmap）
+     */
+    VulkanTexture(VulkanDevice& device, int width, int height, const void* data, bool renderTarget = false);
+
+    /**
+     * @brief 创建纹理并上传预处理好的Mip链，格式需已确认受支持
+     */
+    VulkanTexture(VulkanDevice& device, const TextureData& data);
+    ~VulkanTexture() override;
+
+    bool IsValid() const { return m_View != VK_NULL_HANDLE; }
+
+    VkImage GetImage() const { return m_Image; }
+    VkImageView GetView() const { return m_View; }
+
+private:
+    bool Upload(const void* data);
+    bool UploadLevels(const TextureData& data);
+
+    VulkanDevice& m_Device;
+    VkImage m_Image = VK_NULL_HANDLE;
+    VkDeviceMemory m_Memory = VK_NULL_HANDLE;
+    VkImageView m_View = VK_NULL_HANDLE;
+    uint32_t m_MipLevels = 1;
+};
+
+/**
+ * @brief Vulkan网格（设备本地顶点/索引缓冲）
+ */
+class VulkanMesh : public Mesh {
+public:
+    VulkanMesh(VulkanDevice& device, const void* vertices, uint32_t vertexCount, const VertexLayout& layout,
+               const uint32_t* indices, uint32_t indexCount);
+
+    /**
+     * @brief 创建瞬态网格，数据位于渲染系统的上传环形缓冲区中，不拥有缓冲
+     * @param layout 顶点布局
+     * @param buffer 环形缓冲区
+     * @param baseVertex 第一个顶点在缓冲区中的序号（以layout.stride为单位）
+     * @param firstIndex 第一个索引在缓冲区中的序号
+     * @param frameSerial 创建时的帧序号
+     */
+    VulkanMesh(VulkanDevice& device, uint32_t vertexCount, uint32_t indexCount, const VertexLayout& layout, VkBuffer buffer,
+               uint32_t baseVertex, uint32_t firstIndex, uint64_t frameSerial);
+    ~VulkanMesh() override;
+
+    bool IsValid() const { return m_VertexBuffer != VK_NULL_HANDLE; }
+
+    VkBuffer GetVertexBuffer() const { return m_VertexBuffer; }
+    VkBuffer GetIndexBuffer() const { return m_IndexBuffer; }
+
+    bool IsTransient() const { return !m_OwnsBuffers; }
+    uint32_t GetBaseVertex() const { return m_BaseVertex; }
+    uint32_t GetFirstIndex() const { return m_FirstIndex; }
+    uint64_t GetFrameSerial() const { return m_FrameSerial; }
+
+private:
+    VulkanDevice& m_Device;
+    VkBuffer m_VertexBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory m_VertexMemory = VK_NULL_HANDLE;
+    VkBuffer m_IndexBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory m_IndexMemory = VK_NULL_HANDLE;
+    bool m_OwnsBuffers = true;
+    uint32_t m_BaseVertex = 0;
+    uint32_t m_FirstIndex = 0;
+    uint64_t m_FrameSerial = 0;
+};
+
+/**
+ * @brief Vulkan材质
+ *
+ * 着色器的材质块能从SPIR-V反射时，set 1、binding 0的uniform块直接使用
+ * 材质的参数块，共享参数块的实例使用同一份数据；否则（例如名称被剥离）
+ * 参数按首次设置的顺序以std140规则打包，布局只在参数版本变化时重新计算。
+ * 纹理按首次设置的顺序占用binding 1起的采样器。
+ */
+class VulkanMaterial : public Material {
+public:
+    explicit VulkanMaterial(std::shared_ptr<Shader> shader);
+
+    /**
+     * @brief 创建材质实例
+     * @param parent 父材质（VulkanMaterial）
+     */
+    explicit VulkanMaterial(const std::shared_ptr<Material>& parent);
+
+    /**
+     * @brief 获取材质唯一ID
+     */
+    uint64_t GetId() const { return m_Id; }
+
+    /**
+     * @brief 获取提供uniform数据的材质：共享参数块的实例返回父材质
+     */
+    VulkanMaterial* GetUniformOwner();
+
+    /**
+     * @brief 获取uniform数据的版本，用于判断本帧是否已上传
+     */
+    uint64_t GetUniformVersion() const;
+
+    /**
+     * @brief 获取打包后的uniform块大小（字节，至少16）
+     */
+    uint32_t GetUniformSize();
+
+    /**
+     * @brief 按std140规则打包参数
+     * @param destination 输出缓冲区，大小至少为GetUniformSize()
+     */
+    void PackUniforms(uint8_t* destination);
+
+    /**
+     * @brief 获取按绑定顺序排列的纹理（最多VULKAN_MAX_MATERIAL_TEXTURES个）
+     */
+    const std::vector<std::shared_ptr<VulkanTexture>>& GetTextures();
+
+private:
+    bool HasReflectedBlock() const;
+    void UpdateLayout();
+
+    std::vector<uint32_t> m_Offsets;
+    std::vector<std::shared_ptr<VulkanTexture>> m_Textures;
+    uint32_t m_UniformSize = 16;
+    uint32_t m_LayoutVersion = 0xFFFFFFFF;
+    uint64_t m_Id;
+
+    static std::atomic<uint64_t> s_NextId;
+};
+
+/**
+ * @brief Vulkan渲染目标（RGBA8颜色纹理 + 深度模板图像）
+ *
+ * 颜色图像在渲染通道之外始终处于SHADER_READ_ONLY_OPTIMAL布局，
+ * 可直接作为后续绘制的纹理输入。
+ */
+class VulkanRenderTarget : public RenderTarget {
+public:
+    VulkanRenderTarget(VulkanDevice& device, VkRenderPass renderPass, int width, int height);
+    ~VulkanRenderTarget() override;
+
+    std::shared_ptr<Texture> GetColorTexture() const override { return m_ColorTexture; }
+
+    bool IsComplete() const { return m_Framebuffer != VK_NULL_HANDLE; }
+
+    VkFramebuffer GetFramebuffer() const { return m_Framebuffer; }
+    VkImage GetColorImage() const { return m_ColorTexture->GetImage(); }
+
+private:
+    VulkanDevice& m_Device;
+    std::shared_ptr<VulkanTexture> m_ColorTexture;
+    VkImage m_DepthImage = VK_NULL_HANDLE;
+    VkDeviceMemory m_DepthMemory = VK_NULL_HANDLE;
+    VkImageView m_DepthView = VK_NULL_HANDLE;
+    VkFramebuffer m_Framebuffer = VK_NULL_HANDLE;
+};
+
+/**
+ * @brief Vulkan读回缓冲区（持久映射的主机可见缓冲区）
+ *
+ * 复制命令录制在帧命令缓冲中；帧提交之后紧接着一次不带命令缓冲的空提交，
+ * 它的栅栏在此前提交的所有命令完成后触发，因此每个缓冲区有自己的栅栏，
+ * 不依赖帧栅栏的复用周期。缓冲区中的行自上而下存放。
+ */
+class VulkanReadbackBuffer : public ReadbackBuffer {
+public:
+    VulkanReadbackBuffer(VulkanDevice& device, int width, int height);
+    ~VulkanReadbackBuffer() override;
+
+    bool IsReady() override;
+    bool Wait() override;
+    const uint8_t* GetRow(int row) const override {
+        return m_Mapped + static_cast<size_t>(m_Height - 1 - row) * static_cast<size_t>(m_Width) * 4;
+    }
+
+    bool IsValid() const { return m_Mapped != nullptr && m_Fence != VK_NULL_HANDLE; }
+
+    VkBuffer GetBuffer() const { return m_Buffer; }
+
+    /**
+     * @brief 是否已录制复制、等待随帧提交
+     */
+    bool IsRecorded() const { return m_State == State::Recorded; }
+
+    /**
+     * @brief 录制复制之前调用：等待上一次读取完成并重置栅栏
+     */
+    void BeginRecording();
+
+    /**
+     * @brief 包含复制的命令缓冲提交之后调用，提交触发栅栏的空提交
+     */
+    bool Submit();
+
+    /**
+     * @brief 包含复制的命令缓冲没有提交（提交失败或渲染系统关闭）
+     */
+    void Cancel() { m_State = State::Idle; }
+
+private:
+    enum class State {
+        Idle,
+        Recorded,
+        Submitted,
+        Complete,
+    };
+
+    VulkanDevice& m_Device;
+    VkBuffer m_Buffer = VK_NULL_HANDLE;
+    VkDeviceMemory m_Memory = VK_NULL_HANDLE;
+    const uint8_t* m_Mapped = nullptr;
+    VkFence m_Fence = VK_NULL_HANDLE;
+    State m_State = State::Idle;
+};
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_VULKAN
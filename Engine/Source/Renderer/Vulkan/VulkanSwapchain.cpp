@@ -0,0 +1,159 @@
+/**
+ * @file VulkanSwapchain.cpp
+ * @brief Vulkan交换链实现
+ */
+
+#include "VulkanSwapchain.h"
+
+#ifdef PLE_RENDERER_VULKAN
+
+#include <algorithm>
+#include <mutex>
+
+#include "VulkanDevice.h"
+
+namespace PLE {
+
+VulkanSwapchain::~VulkanSwapchain() {
+    Shutdown();
+}
+
+bool VulkanSwapchain::Initialize(VulkanDevice* device, uint32_t width, uint32_t height, bool vsync) {
+    m_Device = device;
+    VkPhysicalDevice physicalDevice = device->GetPhysicalDevice();
+    VkSurfaceKHR surface = device->GetSurface();
+
+    VkSurfaceCapabilitiesKHR capabilities;
+    if (!VulkanCheck(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, surface, &capabilities), "查询表面能力")) {
+        return false;
+    }
+    if (!(capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT)) {
+        std::cerr << "交换链图像不支持作为传输目标！" << std::endl;
+        return false;
+    }
+
+    uint32_t formatCount = 0;
+    vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &formatCount, nullptr);
+    std::vector<VkSurfaceFormatKHR> formats(formatCount);
+    vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &formatCount, formats.data());
+    if (formats.empty()) {
+        std::cerr << "表面没有可用的格式！" << std::endl;
+        return false;
+    }
+    VkSurfaceFormatKHR surfaceFormat = formats[0];
+    for (const VkSurfaceFormatKHR& format : formats) {
+        if ((format.format == VK_FORMAT_B8G8R8A8_UNORM || format.format == VK_FORMAT_R8G8B8A8_UNORM) && format.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
+            surfaceFormat = format;
+            break;
+        }
+    }
+
+    // FIFO总是可用；关闭垂直同步时优先MAILBOX，其次IMMEDIATE
+    VkPresentModeKHR presentMode = VK_PRESENT_MODE_FIFO_KHR;
+    if (!vsync) {
+        uint32_t modeCount = 0;
+        vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &modeCount, nullptr);
+        std::vector<VkPresentModeKHR> modes(modeCount);
+        vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &modeCount, modes.data());
+        for (VkPresentModeKHR mode : modes) {
+            if (mode == VK_PRESENT_MODE_MAILBOX_KHR) {
+                presentMode = mode;
+                break;
+            }
+            if (mode == VK_PRESENT_MODE_IMMEDIATE_KHR) {
+                presentMode = mode;
+            }
+        }
+    }
+
+    if (capabilities.currentExtent.width != UINT32_MAX) {
+        m_Extent = capabilities.currentExtent;
+    } else {
+        m_Extent.width = std::clamp(width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
+        m_Extent.height = std::clamp(height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
+    }
+    uint32_t imageCount = capabilities.minImageCount + 1;
+    if (capabilities.maxImageCount > 0) {
+        imageCount = std::min(imageCount, capabilities.maxImageCount);
+    }
+
+    VkSwapchainKHR oldSwapchain = m_Swapchain;
+    VkSwapchainCreateInfoKHR swapchainInfo = {};
+    swapchainInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+    swapchainInfo.surface = surface;
+    swapchainInfo.minImageCount = imageCount;
+    swapchainInfo.imageFormat = surfaceFormat.format;
+    swapchainInfo.imageColorSpace = surfaceFormat.colorSpace;
+    swapchainInfo.imageExtent = m_Extent;
+    swapchainInfo.imageArrayLayers = 1;
+    swapchainInfo.imageUsage = VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    swapchainInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    swapchainInfo.preTransform = capabilities.currentTransform;
+    swapchainInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+    swapchainInfo.presentMode = presentMode;
+    swapchainInfo.clipped = VK_TRUE;
+    swapchainInfo.oldSwapchain = oldSwapchain;
+    VkResult result = vkCreateSwapchainKHR(device->GetDevice(), &swapchainInfo, nullptr, &m_Swapchain);
+    if (oldSwapchain) {
+        vkDestroySwapchainKHR(device->GetDevice(), oldSwapchain, nullptr);
+    }
+    if (!VulkanCheck(result, "创建交换链")) {
+        m_Swapchain = VK_NULL_HANDLE;
+        return false;
+    }
+
+    uint32_t count = 0;
+    vkGetSwapchainImagesKHR(device->GetDevice(), m_Swapchain, &count, nullptr);
+    m_Images.resize(count);
+    vkGetSwapchainImagesKHR(device->GetDevice(), m_Swapchain, &count, m_Images.data());
+
+    DestroySemaphores();
+    VkSemaphoreCreateInfo semaphoreInfo = {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    m_RenderFinished.resize(count, VK_NULL_HANDLE);
+    for (VkSemaphore& semaphore : m_RenderFinished) {
+        if (!VulkanCheck(vkCreateSemaphore(device->GetDevice(), &semaphoreInfo, nullptr, &semaphore), "创建信号量")) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void VulkanSwapchain::Shutdown() {
+    if (!m_Device) {
+        return;
+    }
+    DestroySemaphores();
+    if (m_Swapchain) {
+        vkDestroySwapchainKHR(m_Device->GetDevice(), m_Swapchain, nullptr);
+        m_Swapchain = VK_NULL_HANDLE;
+    }
+    m_Images.clear();
+}
+
+void VulkanSwapchain::DestroySemaphores() {
+    for (VkSemaphore semaphore : m_RenderFinished) {
+        vkDestroySemaphore(m_Device->GetDevice(), semaphore, nullptr);
+    }
+    m_RenderFinished.clear();
+}
+
+VkResult VulkanSwapchain::Acquire(VkSemaphore signalSemaphore, uint32_t& imageIndex) {
+    return vkAcquireNextImageKHR(m_Device->GetDevice(), m_Swapchain, UINT64_MAX, signalSemaphore, VK_NULL_HANDLE, &imageIndex);
+}
+
+VkResult VulkanSwapchain::Present(uint32_t imageIndex) {
+    VkPresentInfoKHR presentInfo = {};
+    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    presentInfo.waitSemaphoreCount = 1;
+    presentInfo.pWaitSemaphores = &m_RenderFinished[imageIndex];
+    presentInfo.swapchainCount = 1;
+    presentInfo.pSwapchains = &m_Swapchain;
+    presentInfo.pImageIndices = &imageIndex;
+    std::lock_guard<std::mutex> lock(m_Device->GetQueueMutex());
+    return vkQueuePresentKHR(m_Device->GetGraphicsQueue(), &presentInfo);
+}
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_VULKAN
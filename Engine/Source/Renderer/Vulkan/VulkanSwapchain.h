@@ -0,0 +1,75 @@
+/**
+ * @file VulkanSwapchain.h
+ * @brief Vulkan交换链
+ */
+
+#pragma once
+
+#include "VulkanCommon.h"
+
+#ifdef PLE_RENDERER_VULKAN
+
+#include <vector>
+
+namespace PLE {
+
+class VulkanDevice;
+
+/**
+ * @brief Vulkan交换链
+ *
+ * 交换链图像只作为传输目标：每帧把离屏默认渲染目标复制到获取的图像后呈现，
+ * 因此渲染通道和管线与是否有窗口无关。每张图像有独立的渲染完成信号量。
+ */
+class VulkanSwapchain {
+public:
+    VulkanSwapchain() = default;
+    ~VulkanSwapchain();
+
+    /**
+     * @brief 创建（或重建）交换链
+     * @param device 设备
+     * @param width 期望宽度
+     * @param height 期望高度
+     * @param vsync 是否垂直同步
+     * @return 是否成功创建
+     */
+    bool Initialize(VulkanDevice* device, uint32_t width, uint32_t height, bool vsync);
+
+    /**
+     * @brief 销毁交换链
+     */
+    void Shutdown();
+
+    /**
+     * @brief 获取下一张图像
+     * @param signalSemaphore 图像可用时触发的信号量
+     * @param imageIndex 输出图像索引
+     * @return vkAcquireNextImageKHR的结果
+     */
+    VkResult Acquire(VkSemaphore signalSemaphore, uint32_t& imageIndex);
+
+    /**
+     * @brief 呈现图像，等待该图像的渲染完成信号量
+     * @return vkQueuePresentKHR的结果
+     */
+    VkResult Present(uint32_t imageIndex);
+
+    VkImage GetImage(uint32_t index) const { return m_Images[index]; }
+    VkSemaphore GetRenderFinishedSemaphore(uint32_t index) const { return m_RenderFinished[index]; }
+    VkExtent2D GetExtent() const { return m_Extent; }
+    bool IsValid() const { return m_Swapchain != VK_NULL_HANDLE; }
+
+private:
+    void DestroySemaphores();
+
+    VulkanDevice* m_Device = nullptr;
+    VkSwapchainKHR m_Swapchain = VK_NULL_HANDLE;
+    VkExtent2D m_Extent = { 0, 0 };
+    std::vector<VkImage> m_Images;
+    std::vector<VkSemaphore> m_RenderFinished;
+};
+
+} // namespace PLE
+
+#endif // PLE_RENDERER_VULKAN
@@ -0,0 +1,57 @@
+/**
+ * @file Camera.cpp
+ * @brief 相机组件实现
+ */
+
+#include "Scene/Camera.h"
+
+namespace PLE {
+
+Camera::Camera(std::shared_ptr<Entity> entity)
+    : Component(entity) {
+}
+
+void Camera::SetPerspective(float fovY, float nearZ, float farZ) {
+    m_Projection = CameraProjection::Perspective;
+    m_FieldOfView = fovY;
+    m_NearClip = nearZ;
+    m_FarClip = farZ;
+}
+
+void Camera::SetOrthographic(float height, float nearZ, float farZ) {
+    m_Projection = CameraProjection::Orthographic;
+    m_OrthographicHeight = height;
+    m_NearClip = nearZ;
+    m_FarClip = farZ;
+}
+
+Vector3 Camera::GetPosition() const {
+    auto entity = GetEntity();
+    return entity ? entity->GetTransform()->GetWorldPosition() : Vector3::Zero();
+}
+
+Matrix4 Camera::GetViewMatrix() const {
+    auto entity = GetEntity();
+    if (!entity) {
+        return Matrix4::Identity();
+    }
+    return entity->GetTransform()->GetWorldMatrix().Inverse();
+}
+
+Matrix4 Camera::GetProjectionMatrix() const {
+    if (m_Projection == CameraProjection::Perspective) {
+        return Matrix4::Perspective(m_FieldOfView, m_AspectRatio, m_NearClip, m_FarClip);
+    }
+
+    // 与Perspective保持相同的行向量和[0, 1]深度约定
+    float halfHeight = m_OrthographicHeight * 0.5f;
+    float halfWidth = halfHeight * m_AspectRatio;
+    Matrix4 result = Matrix4::Identity();
+    result(0, 0) = 1.0f / halfWidth;
+    result(1, 1) = 1.0f / halfHeight;
+    result(2, 2) = 1.0f / (m_NearClip - m_FarClip);
+    result(3, 2) = m_NearClip / (m_NearClip - m_FarClip);
+    return result;
+}
+
+} // namespace PLE
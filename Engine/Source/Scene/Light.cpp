@@ -0,0 +1,32 @@
+/**
+ * @file Light.cpp
+ * @brief 光源组件实现
+ */
+
+#include "Scene/Light.h"
+
+#include <algorithm>
+
+namespace PLE {
+
+Light::Light(std::shared_ptr<Entity> entity)
+    : Component(entity) {
+}
+
+void Light::SetSpotAngles(float innerAngle, float outerAngle) {
+    // 外锥限制在半球内，内锥不超过外锥
+    m_OuterSpotAngle = std::min(std::max(outerAngle, 0.0f), 1.5707963f);
+    m_InnerSpotAngle = std::min(std::max(innerAngle, 0.0f), m_OuterSpotAngle);
+}
+
+Vector3 Light::GetPosition() const {
+    auto entity = GetEntity();
+    return entity ? entity->GetTransform()->GetWorldPosition() : Vector3::Zero();
+}
+
+Vector3 Light::GetDirection() const {
+    auto entity = GetEntity();
+    return entity ? entity->GetTransform()->GetForward().Normalized() : Vector3(0.0f, 0.0f, -1.0f);
+}
+
+} // namespace PLE
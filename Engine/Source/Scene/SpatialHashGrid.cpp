@@ -0,0 +1,225 @@
+/**
+ * @file SpatialHashGrid.cpp
+ * @brief 空间哈希网格实现
+ */
+
+#include "Scene/SpatialHashGrid.h"
+#include "Core/JobSystem.h"
+
+#include <algorithm>
+#include <climits>
+#include <queue>
+
+namespace PLE {
+
+namespace {
+
+// 每个分块至少包含的点数，点数较少时并行构建得不偿失
+constexpr uint32_t MIN_POINTS_PER_CHUNK = 2048;
+constexpr uint32_t MAX_CHUNKS = 16;
+
+} // namespace
+
+SpatialHashGrid::SpatialHashGrid(float cellSize, bool planar)
+    : m_Planar(planar) {
+    SetCellSize(cellSize);
+}
+
+void SpatialHashGrid::SetCellSize(float cellSize) {
+    m_CellSize = std::max(cellSize, 0.0001f);
+    m_InvCellSize = 1.0f / m_CellSize;
+}
+
+void SpatialHashGrid::Clear() {
+    m_HashMask = 0;
+    m_BucketStart.assign(2, 0);
+    m_SortedIndices.clear();
+    m_SortedPositions.clear();
+    m_SortedKeys.clear();
+}
+
+void SpatialHashGrid::Build(const Vector3* positions, uint32_t count) {
+    if (count == 0 || positions == nullptr) {
+        Clear();
+        return;
+    }
+
+    uint32_t tableSize = 64;
+    while (tableSize < count * 2) {
+        tableSize <<= 1;
+    }
+    m_HashMask = tableSize - 1;
+
+    JobSystem& jobSystem = JobSystem::GetInstance();
+    uint32_t chunkCount = jobSystem.IsInitialized() ? jobSystem.GetConcurrency() : 1;
+    chunkCount = std::max(1u, std::min({ chunkCount, MAX_CHUNKS, count / MIN_POINTS_PER_CHUNK }));
+    const uint32_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    m_Keys.resize(count);
+    m_Buckets.resize(count);
+    m_ChunkHistograms.assign(static_cast<size_t>(chunkCount) * tableSize, 0);
+    std::vector<int32_t> chunkBounds(static_cast<size_t>(chunkCount) * 6);
+
+    // 第一步：每个分块计算格子键并统计本块的桶直方图
+    jobSystem.ParallelFor(chunkCount, 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t chunk = begin; chunk < end; ++chunk) {
+            uint32_t* histogram = &m_ChunkHistograms[static_cast<size_t>(chunk) * tableSize];
+            int32_t* bounds = &chunkBounds[static_cast<size_t>(chunk) * 6];
+            bounds[0] = bounds[1] = bounds[2] = INT_MAX;
+            bounds[3] = bounds[4] = bounds[5] = INT_MIN;
+
+            const uint32_t first = chunk * chunkSize;
+            const uint32_t last = std::min(first + chunkSize, count);
+            for (uint32_t i = first; i < last; ++i) {
+                int32_t cell[3];
+                ComputeCell(positions[i], cell[0], cell[1], cell[2]);
+                for (int axis = 0; axis < 3; ++axis) {
+                    bounds[axis] = std::min(bounds[axis], cell[axis]);
+                    bounds[axis + 3] = std::max(bounds[axis + 3], cell[axis]);
+                }
+                m_Keys[i] = PackCell(cell[0], cell[1], cell[2]);
+                m_Buckets[i] = HashKey(m_Keys[i]);
+                ++histogram[m_Buckets[i]];
+            }
+        }
+    });
+
+    for (int axis = 0; axis < 3; ++axis) {
+        m_MinCell[axis] = INT_MAX;
+        m_MaxCell[axis] = INT_MIN;
+        for (uint32_t chunk = 0; chunk < chunkCount; ++chunk) {
+            m_MinCell[axis] = std::min(m_MinCell[axis], chunkBounds[chunk * 6 + axis]);
+            m_MaxCell[axis] = std::max(m_MaxCell[axis], chunkBounds[chunk * 6 + axis + 3]);
+        }
+    }
+
+    // 第二步：把每个桶的直方图按分块顺序转换为块内偏移，并得到桶总数
+    m_BucketStart.resize(tableSize + 1);
+    jobSystem.ParallelFor(tableSize, 4096, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t bucket = begin; bucket < end; ++bucket) {
+            uint32_t sum = 0;
+            for (uint32_t chunk = 0; chunk < chunkCount; ++chunk) {
+                uint32_t& value = m_ChunkHistograms[static_cast<size_t>(chunk) * tableSize + bucket];
+                uint32_t histogramCount = value;
+                value = sum;
+                sum += histogramCount;
+            }
+            m_BucketStart[bucket] = sum;
+        }
+    });
+
+    uint32_t offset = 0;
+    for (uint32_t bucket = 0; bucket < tableSize; ++bucket) {
+        uint32_t bucketCount = m_BucketStart[bucket];
+        m_BucketStart[bucket] = offset;
+        offset += bucketCount;
+    }
+    m_BucketStart[tableSize] = offset;
+
+    // 第三步：各分块按原顺序分发，桶内顺序与线程数无关
+    m_SortedIndices.resize(count);
+    m_SortedPositions.resize(count);
+    m_SortedKeys.resize(count);
+    jobSystem.ParallelFor(chunkCount, 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t chunk = begin; chunk < end; ++chunk) {
+            uint32_t* cursor = &m_ChunkHistograms[static_cast<size_t>(chunk) * tableSize];
+            const uint32_t first = chunk * chunkSize;
+            const uint32_t last = std::min(first + chunkSize, count);
+            for (uint32_t i = first; i < last; ++i) {
+                uint32_t bucket = m_Buckets[i];
+                uint32_t destination = m_BucketStart[bucket] + cursor[bucket]++;
+                m_SortedIndices[destination] = i;
+                m_SortedPositions[destination] = Vector3(positions[i].x, m_Planar ? 0.0f : positions[i].y, positions[i].z);
+                m_SortedKeys[destination] = m_Keys[i];
+            }
+        }
+    });
+}
+
+uint32_t SpatialHashGrid::QueryRadius(const Vector3& center, float radius, std::vector<uint32_t>& results) const {
+    results.clear();
+    ForEachInRadius(center, radius, [&results](uint32_t index, float) {
+        results.push_back(index);
+    });
+    return static_cast<uint32_t>(results.size());
+}
+
+uint32_t SpatialHashGrid::QueryKNearest(const Vector3& center, uint32_t k, std::vector<uint32_t>& results, float maxRadius) const {
+    results.clear();
+    if (k == 0 || m_SortedIndices.empty() || maxRadius < 0.0f) {
+        return 0;
+    }
+
+    const Vector3 query(center.x, m_Planar ? 0.0f : center.y, center.z);
+    const float maxRadiusSq = maxRadius * maxRadius;
+    int32_t centerCell[3];
+    ComputeCell(query, centerCell[0], centerCell[1], centerCell[2]);
+
+    // 大顶堆保存当前最近的k个点
+    std::priority_queue<std::pair<float, uint32_t>> best;
+
+    auto visitCell = [&](int32_t cellX, int32_t cellY, int32_t cellZ) {
+        const uint64_t key = PackCell(cellX, cellY, cellZ);
+        const uint32_t bucket = HashKey(key);
+        for (uint32_t i = m_BucketStart[bucket]; i < m_BucketStart[bucket + 1]; ++i) {
+            if (m_SortedKeys[i] != key) {
+                continue;
+            }
+            const Vector3& position = m_SortedPositions[i];
+            const float dx = position.x - query.x;
+            const float dy = position.y - query.y;
+            const float dz = position.z - query.z;
+            const float distSq = dx * dx + dy * dy + dz * dz;
+            if (distSq > maxRadiusSq) {
+                continue;
+            }
+            if (best.size() < k) {
+                best.emplace(distSq, m_SortedIndices[i]);
+            } else if (distSq < best.top().first) {
+                best.pop();
+                best.emplace(distSq, m_SortedIndices[i]);
+            }
+        }
+    };
+
+    const int32_t yRange = m_Planar ? 0 : 1;
+    for (int32_t ring = 0;; ++ring) {
+        // 遍历切比雪夫距离恰好为ring的一圈格子
+        for (int32_t dy = -ring * yRange; dy <= ring * yRange; ++dy) {
+            for (int32_t dz = -ring; dz <= ring; ++dz) {
+                const bool onShell = std::abs(dy) == ring || std::abs(dz) == ring;
+                const int32_t step = onShell ? 1 : std::max(2 * ring, 1);
+                for (int32_t dx = -ring; dx <= ring; dx += step) {
+                    visitCell(centerCell[0] + dx, centerCell[1] + dy, centerCell[2] + dz);
+                }
+            }
+        }
+
+        // 下一圈中的点距离中心至少为ring个格子
+        const float nextRingDistance = static_cast<float>(ring) * m_CellSize;
+        if (best.size() == k && best.top().first <= nextRingDistance * nextRingDistance) {
+            break;
+        }
+        if (nextRingDistance > maxRadius) {
+            break;
+        }
+        bool coversAll = true;
+        for (int axis = 0; axis < 3; ++axis) {
+            if (centerCell[axis] - ring > m_MinCell[axis] || centerCell[axis] + ring < m_MaxCell[axis]) {
+                coversAll = false;
+            }
+        }
+        if (coversAll) {
+            break;
+        }
+    }
+
+    results.resize(best.size());
+    for (size_t i = results.size(); i > 0; --i) {
+        results[i - 1] = best.top().second;
+        best.pop();
+    }
+    return static_cast<uint32_t>(results.size());
+}
+
+} // namespace PLE
@@ -0,0 +1,177 @@
+/**
+ * @file main.cpp
+ * @brief 渲染捕获回放工具
+ *
+ * 用法：RenderReplay <捕获文件> [--api opengl|vulkan] [--iterations N] [--warmup N] [--wait-gpu] [--csv 路径]
+ *
+ * 在无窗口的渲染系统上回放RenderCaptureSystem写出的捕获文件，预热轮次不计入结果，
+ * 输出每个捕获帧的平均、最小和最大耗时以及渲染统计，可选写出逐帧的CSV。
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Core/JobSystem.h"
+#include "Renderer/RenderCapture.h"
+
+using namespace PLE;
+
+namespace {
+
+struct Options {
+    std::string path;
+    RenderAPI api = RenderAPI::OpenGL;
+    uint32_t iterations = 10;
+    uint32_t warmup = 1;
+    bool waitForGPU = false;
+    std::string csvPath;
+};
+
+void PrintUsage() {
+    std::cerr << "用法：RenderReplay <捕获文件> [--api opengl|vulkan] [--iterations N] [--warmup N] [--wait-gpu] [--csv 路径]"
+              << std::endl;
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--api" && hasValue) {
+            const std::string api = argv[++i];
+            if (api == "opengl") {
+                options.api = RenderAPI::OpenGL;
+            } else if (api == "vulkan") {
+                options.api = RenderAPI::Vulkan;
+            } else {
+                std::cerr << "不支持的渲染API：" << api << std::endl;
+                return false;
+            }
+        } else if (arg == "--iterations" && hasValue) {
+            options.iterations = static_cast<uint32_t>(std::max(1L, std::strtol(argv[++i], nullptr, 10)));
+        } else if (arg == "--warmup" && hasValue) {
+            options.warmup = static_cast<uint32_t>(std::max(0L, std::strtol(argv[++i], nullptr, 10)));
+        } else if (arg == "--wait-gpu") {
+            options.waitForGPU = true;
+        } else if (arg == "--csv" && hasValue) {
+            options.csvPath = argv[++i];
+        } else if (!arg.empty() && arg[0] != '-' && options.path.empty()) {
+            options.path = arg;
+        } else {
+            std::cerr << "无法识别的参数：" << arg << std::endl;
+            return false;
+        }
+    }
+    return !options.path.empty();
+}
+
+bool WriteCsv(const std::string& path, const std::vector<RenderReplayFrame>& frames) {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "无法写入CSV文件：" << path << std::endl;
+        return false;
+    }
+    file << "iteration,frame,ms,drawCalls,instances,triangles,shaderBinds,materialBinds,textureBinds,stateChanges,uploadBytes\n";
+    for (const RenderReplayFrame& frame : frames) {
+        const RenderStats& stats = frame.stats;
+        file << frame.iteration << ',' << frame.frame << ',' << frame.cpuMilliseconds << ',' << stats.drawCalls << ','
+             << stats.instances << ',' << stats.triangles << ',' << stats.shaderBinds << ',' << stats.materialBinds << ','
+             << stats.textureBinds << ',' << stats.stateChanges << ',' << stats.uploadBytes << '\n';
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+
+    RenderReplay replay;
+    if (!replay.Load(options.path)) {
+        return 1;
+    }
+
+    JobSystem::GetInstance().Initialize();
+
+    RenderSystemConfig config;
+    config.api = options.api;
+    config.enableVSync = false;
+    config.width = replay.GetWidth();
+    config.height = replay.GetHeight();
+    std::unique_ptr<RenderSystem> renderSystem = RenderSystem::Create(config);
+    if (!renderSystem || !renderSystem->Initialize(nullptr)) {
+        std::cerr << "渲染系统初始化失败！" << std::endl;
+        JobSystem::GetInstance().Shutdown();
+        return 1;
+    }
+    std::cout << "GPU: " << renderSystem->GetGPUInfo() << " (" << renderSystem->GetAPIVersion() << ")" << std::endl;
+    std::cout << "捕获：" << options.path << "，" << replay.GetFrameCount() << " 帧，" << replay.GetWidth() << "x"
+              << replay.GetHeight() << std::endl;
+
+    RenderReplaySettings settings;
+    settings.iterations = options.warmup + options.iterations;
+    settings.waitForGPU = options.waitForGPU;
+    std::vector<RenderReplayFrame> frames;
+    const bool complete = replay.Replay(*renderSystem, settings, frames);
+
+    renderSystem->Shutdown();
+    renderSystem.reset();
+    JobSystem::GetInstance().Shutdown();
+
+    // 丢弃预热轮次（包含资源创建）
+    frames.erase(std::remove_if(frames.begin(), frames.end(),
+                                [&](const RenderReplayFrame& frame) { return frame.iteration < options.warmup; }),
+                 frames.end());
+    if (frames.empty()) {
+        std::cerr << "没有可统计的帧！" << std::endl;
+        return 1;
+    }
+
+    uint32_t frameCount = 0;
+    for (const RenderReplayFrame& frame : frames) {
+        frameCount = std::max(frameCount, frame.frame + 1);
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "帧\t平均ms\t最小ms\t最大ms\t绘制\t三角形\t着色器切换\t纹理绑定\t上传字节" << std::endl;
+    for (uint32_t index = 0; index < frameCount; ++index) {
+        double total = 0.0;
+        double minimum = 0.0;
+        double maximum = 0.0;
+        uint32_t samples = 0;
+        const RenderReplayFrame* last = nullptr;
+        for (const RenderReplayFrame& frame : frames) {
+            if (frame.frame != index) {
+                continue;
+            }
+            minimum = samples == 0 ? frame.cpuMilliseconds : std::min(minimum, frame.cpuMilliseconds);
+            maximum = samples == 0 ? frame.cpuMilliseconds : std::max(maximum, frame.cpuMilliseconds);
+            total += frame.cpuMilliseconds;
+            ++samples;
+            last = &frame;
+        }
+        if (samples == 0) {
+            continue;
+        }
+        const RenderStats& stats = last->stats;
+        std::cout << index << '\t' << total / samples << '\t' << minimum << '\t' << maximum << '\t' << stats.drawCalls << '\t'
+                  << stats.triangles << '\t' << stats.shaderBinds << '\t' << stats.textureBinds << '\t' << stats.uploadBytes
+                  << std::endl;
+        for (const RenderPassStats& pass : stats.passes) {
+            std::cout << "  " << pass.name << ": " << pass.cpuMilliseconds << " ms, " << pass.drawCalls << " 绘制" << std::endl;
+        }
+    }
+
+    if (!options.csvPath.empty() && !WriteCsv(options.csvPath, frames)) {
+        return 1;
+    }
+    return complete ? 0 : 2;
+}